@@ -0,0 +1,103 @@
+--------------------------------------------------------------
+-- @Description : Makefile of CatDogEngine Benchmarks
+--------------------------------------------------------------
+
+project("Benchmarks")
+	kind("ConsoleApp")
+	SetLanguageAndToolset("Benchmarks")
+	dependson { "Engine" }
+
+	files {
+		path.join(BenchmarksSourcePath, "**.*"),
+	}
+
+	vpaths {
+		["Source/*"] = {
+			path.join(BenchmarksSourcePath, "**.*"),
+		},
+	}
+
+	defines {
+		"BX_CONFIG_DEBUG",
+		"CDENGINE_BUILTIN_SHADER_PATH=\""..BuiltInShaderSourcePath.."\"",
+		"CDPROJECT_RESOURCES_SHARED_PATH=\""..ProjectSharedPath.."\"",
+		"CDPROJECT_RESOURCES_ROOT_PATH=\""..ProjectResourceRootPath.."\"",
+		GetPlatformMacroName(),
+		"EDITOR_MODE", -- TODO : remove
+	}
+
+	includedirs {
+		path.join(EngineSourcePath, "Benchmarks/"),
+		path.join(EngineSourcePath, "Runtime/"),
+		path.join(ThirdPartySourcePath, "AssetPipeline/public"),
+		path.join(EnginePath, "BuiltInShaders/shaders"),
+		path.join(EnginePath, "BuiltInShaders/UniformDefines"),
+		path.join(ThirdPartySourcePath, "bgfx/include"),
+		path.join(ThirdPartySourcePath, "bimg/include"),
+		path.join(ThirdPartySourcePath, "bimg/3rdparty"),
+		path.join(ThirdPartySourcePath, "bx/include"),
+		path.join(ThirdPartySourcePath, "bx/include/compat/msvc"),
+		path.join(ThirdPartySourcePath, "imgui"),
+		ThirdPartySourcePath,
+	}
+
+	if ENABLE_SPDLOG then
+		defines {
+			-- TODO : Remove _SILENCE_STDEXT_ARR_ITERS_DEPRECATION_WARNING after spdlog updates the format to the right version.
+			"SPDLOG_ENABLE", "SPDLOG_NO_EXCEPTIONS", "FMT_USE_NONTYPE_TEMPLATE_ARGS=0", "_SILENCE_STDEXT_ARR_ITERS_DEPRECATION_WARNING",
+		}
+
+		includedirs {
+			path.join(ThirdPartySourcePath, "spdlog/include"),
+		}
+	end
+
+	if ENABLE_TRACY then
+		defines {
+			"TRACY_ENABLE",
+		}
+
+		includedirs {
+			path.join(ThirdPartySourcePath, "tracy/public"),
+		}
+	end
+
+	-- use /MT /MTd, not /MD /MDd
+	staticruntime "on"
+	filter { "configurations:Debug" }
+		runtime "Debug" -- /MTd
+		libdirs {
+			BinariesPath,
+			path.join(ThirdPartySourcePath, "AssetPipeline/build/bin/Debug"),
+		}
+	filter { "configurations:Release" }
+		runtime "Release" -- /MT
+		libdirs {
+			BinariesPath,
+			path.join(ThirdPartySourcePath, "AssetPipeline/build/bin/Release"),
+		}
+	filter {}
+
+	links {
+		"Engine",
+		"AssetPipelineCore",
+		"CDProducer",
+		"CDConsumer",
+	}
+
+	-- Disable these options can reduce the size of compiled binaries.
+	justmycode("Off")
+	editAndContinue("Off")
+	-- nlohmann json reports errors by exceptions.
+	exceptionhandling("On")
+	rtti("Off")
+
+	-- Strict.
+	warnings("Default")
+	externalwarnings("Off")
+
+	flags {
+		"MultiProcessorCompile", -- compiler uses multiple thread
+	}
+
+	CopyDllAutomatically()
@@ -5,7 +5,7 @@
 project("Engine")
 	kind(EngineBuildLibKind)
 	SetLanguageAndToolset("Engine/Runtime")
-	dependson { "bx", "bimg", "bimg_decode", "bgfx" } -- sdl is pre-built in makefile.
+	dependson { "bx", "bimg", "bimg_decode", "bimg_encode", "bgfx" } -- sdl is pre-built in makefile.
 
 	files {
 		path.join(RuntimeSourcePath, "**.*"),
@@ -148,7 +148,7 @@ project("Engine")
 		}
 		links {
 			"sdl2d", "sdl2maind",
-			"bgfxDebug", "bimgDebug", "bxDebug", "bimg_decodeDebug"
+			"bgfxDebug", "bimgDebug", "bxDebug", "bimg_decodeDebug", "bimg_encodeDebug"
 		}
 	filter { "configurations:Release" }
 		libdirs {
@@ -157,7 +157,7 @@ project("Engine")
 		}
 		links {
 			"sdl2", "sdl2main",
-			"bgfxRelease", "bimgRelease", "bxRelease", "bimg_decodeRelease"
+			"bgfxRelease", "bimgRelease", "bxRelease", "bimg_decodeRelease", "bimg_encodeRelease"
 		}
 	filter {}
 	
@@ -25,6 +25,9 @@ EditorResourceRootPath = RootPath.."/Engine/EditorResources/"
 -- Game
 GameSourcePath = path.join(EngineSourcePath, "Game")
 
+-- Benchmarks
+BenchmarksSourcePath = path.join(EngineSourcePath, "Benchmarks")
+
 -- Project
 ProjectSharedPath = RootPath.."/Projects/Shared/"
 DefaultProjectName = "Test"
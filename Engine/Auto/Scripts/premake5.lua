@@ -133,7 +133,8 @@ workspace(EngineName)
 		optimize("Off")
 	-- Full optimization.
 	filter "configurations:Release"
-		defines { "NDEBUG" }
+		-- Trace logs are stripped at compile time. See Log.h.
+		defines { "NDEBUG", "CD_LOG_ACTIVE_LEVEL=1" }
 		symbols("On")
 		optimize("Full")
 	filter {}
@@ -229,6 +230,11 @@ end
 -- game projects
 --dofile("game.lua")
 
+-- headless benchmarks which run renderers on the Noop backend
+if not IsAndroidPlatform() then
+	dofile("benchmark.lua")
+end
+
 -- regression tests for engine core modules
 dofile("test.lua")
 
@@ -6,6 +6,82 @@
 TestsPath = path.join(RootPath, "Tests")
 print("Make tests : "..TestsPath)
 
+-- Tests which call out-of-line engine code link the Engine library like Benchmarks do.
+-- They share defines with the library so that component layouts match, e.g. members under EDITOR_MODE.
+EngineLinkedTests = {
+	ECWorld = true,
+}
+
+-- Editor is an application so tests compile the editor sources which they cover.
+EditorTestSources = {
+	ECWorld = {
+		"Undo/UndoJournal.h",
+		"Undo/UndoJournal.cpp",
+	},
+}
+
+function LinkEngine()
+	dependson { "Engine" }
+
+	defines {
+		"BX_CONFIG_DEBUG",
+		GetPlatformMacroName(),
+		"EDITOR_MODE", -- TODO : remove
+	}
+
+	includedirs {
+		path.join(EnginePath, "BuiltInShaders/shaders"),
+		path.join(ThirdPartySourcePath, "bgfx/include"),
+		path.join(ThirdPartySourcePath, "bimg/include"),
+		path.join(ThirdPartySourcePath, "bimg/3rdparty"),
+		path.join(ThirdPartySourcePath, "bx/include"),
+		path.join(ThirdPartySourcePath, "bx/include/compat/msvc"),
+		path.join(ThirdPartySourcePath, "imgui"),
+	}
+
+	if ENABLE_SPDLOG then
+		defines {
+			-- TODO : Remove _SILENCE_STDEXT_ARR_ITERS_DEPRECATION_WARNING after spdlog updates the format to the right version.
+			"SPDLOG_ENABLE", "SPDLOG_NO_EXCEPTIONS", "FMT_USE_NONTYPE_TEMPLATE_ARGS=0", "_SILENCE_STDEXT_ARR_ITERS_DEPRECATION_WARNING",
+		}
+
+		includedirs {
+			path.join(ThirdPartySourcePath, "spdlog/include"),
+		}
+	end
+
+	if ENABLE_TRACY then
+		defines {
+			"TRACY_ENABLE",
+		}
+
+		includedirs {
+			path.join(ThirdPartySourcePath, "tracy/public"),
+		}
+	end
+
+	filter { "configurations:Debug" }
+		libdirs {
+			BinariesPath,
+			path.join(ThirdPartySourcePath, "AssetPipeline/build/bin/Debug"),
+		}
+	filter { "configurations:Release" }
+		libdirs {
+			BinariesPath,
+			path.join(ThirdPartySourcePath, "AssetPipeline/build/bin/Release"),
+		}
+	filter {}
+
+	links {
+		"Engine",
+		"AssetPipelineCore",
+		"CDProducer",
+		"CDConsumer",
+	}
+
+	CopyDllAutomatically()
+end
+
 function MakeTest(testName)
 	local testSourcePath = path.join(TestsPath, testName)
 
@@ -28,6 +104,26 @@ function MakeTest(testName)
 			path.join(EnginePath, "BuiltInShaders/UniformDefines"),
 		}
 
+		if EngineLinkedTests[testName] then
+			LinkEngine()
+		end
+
+		if EditorTestSources[testName] then
+			for _, editorSource in ipairs(EditorTestSources[testName]) do
+				files {
+					path.join(EngineSourcePath, "Editor", editorSource),
+				}
+			end
+
+			vpaths {
+				["Editor"] = { path.join(EngineSourcePath, "Editor/**.*") },
+			}
+
+			includedirs {
+				path.join(EngineSourcePath, "Editor/"),
+			}
+		end
+
 		-- convenient to test multiple threads
 		openmp("On")
 
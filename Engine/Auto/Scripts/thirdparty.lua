@@ -47,10 +47,10 @@ group "ThirdParty/bgfx"
 		location(bgfxProjectsPath)
 		targetdir(BinariesPath)
 
-	--externalproject("bimg_encode")
-	--	kind("StaticLib")
-	--	location(bgfxProjectsPath)
-	--	targetdir(BinariesPath)
+	externalproject("bimg_encode")
+		kind("StaticLib")
+		location(bgfxProjectsPath)
+		targetdir(BinariesPath)
 
 	externalproject("bimg_decode")
 		kind("StaticLib")
@@ -1,6 +1,8 @@
+$input v_color0
+
 #include "../common/common.sh"
 
 void main()
 {
-	gl_FragColor = vec4(1.0, 0.0, 0.0, 1.0);
+	gl_FragColor = v_color0;
 }
\ No newline at end of file
@@ -0,0 +1,887 @@
+#include "BenchmarkApp.h"
+
+#include "Core/Memory/HeapAllocationCounter.h"
+#include "Core/Memory/MemoryTracker.h"
+#include "ECWorld/SceneWorld.h"
+#include "Log/Log.h"
+#include "Math/MeshGenerator.h"
+#include "Math/Sphere.hpp"
+#include "Path/Path.h"
+#include "Physics/SceneQuery.h"
+#include "Profiling/ProfileRecorder.h"
+#include "Rendering/AABBRenderer.h"
+#include "Rendering/AnimationRenderer.h"
+#include "Rendering/BlendShapeRenderer.h"
+#include "Rendering/BlitRenderTargetPass.h"
+#include "Rendering/BloomRenderer.h"
+#include "Rendering/LightUniforms.h"
+#include "Rendering/ParticleForceFieldRenderer.h"
+#include "Rendering/ParticleRenderer.h"
+#include "Rendering/PostProcessRenderer.h"
+#include "Rendering/RenderContext.h"
+#include "Rendering/RenderSnapshot.h"
+#include "Rendering/Resources/MeshResource.h"
+#include "Rendering/Resources/ResourceContext.h"
+#include "Rendering/ShaderCollections.h"
+#include "Rendering/ShaderType.h"
+#include "Rendering/ShadowMapRenderer.h"
+#include "Rendering/SkeletonRenderer.h"
+#include "Rendering/SkyboxRenderer.h"
+#include "Rendering/TerrainRenderer.h"
+#include "Rendering/WhiteModelRenderer.h"
+#include "Rendering/WireframeRenderer.h"
+#include "Rendering/WorldRenderer.h"
+#include "Scene/SceneDatabase.h"
+#include "Utilities/MeshUtils.hpp"
+
+#include <bgfx/bgfx.h>
+#include <bx/bx.h>
+#include <json/json.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+namespace
+{
+
+constexpr const char* WorldProgram = "WorldProgram";
+constexpr const char* AnimationProgram = "AnimationProgram";
+constexpr const char* TerrainProgram = "TerrainProgram";
+constexpr const char* ParticleProgram = "ParticleProgram";
+
+constexpr float SceneHalfExtent = 300.0f;
+constexpr float QuerySceneHalfExtent = 2000.0f;
+constexpr double NanosecondsToMilliseconds = 1.0 / 1000000.0;
+
+// Header of bgfx shader binary without uniforms. Noop renderer ignores the code so the shader name is stored
+// there to keep blobs different, otherwise bgfx shares shaders which have the same memory hash.
+engine::RenderContext::ShaderBlob MakeStubShaderBlob(engine::ShaderType type, const std::string& name)
+{
+	uint32_t magic = BX_MAKEFOURCC('V', 'S', 'H', 11);
+	if (engine::ShaderType::Fragment == type)
+	{
+		magic = BX_MAKEFOURCC('F', 'S', 'H', 11);
+	}
+	else if (engine::ShaderType::Compute == type)
+	{
+		magic = BX_MAKEFOURCC('C', 'S', 'H', 11);
+	}
+
+	const uint32_t hashIn = 0U;
+	const uint32_t hashOut = 0U;
+	const uint16_t uniformCount = 0U;
+	const uint32_t codeSize = static_cast<uint32_t>(name.size());
+
+	engine::RenderContext::ShaderBlob blob(sizeof(magic) + sizeof(hashIn) + sizeof(hashOut) + sizeof(uniformCount) + sizeof(codeSize) + name.size());
+	std::byte* pWrite = blob.data();
+	auto Write = [&pWrite](const void* pData, size_t size)
+	{
+		std::memcpy(pWrite, pData, size);
+		pWrite += size;
+	};
+	Write(&magic, sizeof(magic));
+	Write(&hashIn, sizeof(hashIn));
+	Write(&hashOut, sizeof(hashOut));
+	Write(&uniformCount, sizeof(uniformCount));
+	Write(&codeSize, sizeof(codeSize));
+	Write(name.data(), name.size());
+
+	return blob;
+}
+
+double ToMilliseconds(uint64_t time)
+{
+	return static_cast<double>(time) * NanosecondsToMilliseconds;
+}
+
+}
+
+namespace benchmark
+{
+
+BenchmarkApp::BenchmarkApp(BenchmarkArgs args)
+	: m_args(cd::MoveTemp(args))
+{
+}
+
+BenchmarkApp::~BenchmarkApp() = default;
+
+void BenchmarkApp::Init()
+{
+	uint64_t beginTime = engine::ProfileRecorder::GetTimestamp();
+
+	// Harness measures systems by itself. Engine zones would only add noise.
+	engine::ProfileRecorder::Get().SetEnable(false);
+
+	// Particle simulation uses rand.
+	std::srand(m_args.seed);
+
+	if (m_args.lightCount > engine::MAX_LIGHT_COUNT)
+	{
+		CD_ENGINE_WARN("Light count {0} is clamped to {1}.", m_args.lightCount, engine::MAX_LIGHT_COUNT);
+		m_args.lightCount = engine::MAX_LIGHT_COUNT;
+	}
+
+	// Nested measures should not allocate stats in the middle of other measures.
+	m_systemStats.reserve(64U);
+
+	InitRenderContext();
+	InitMaterialType();
+	InitCameraEntity();
+	InitSkyEntity();
+	InitScene();
+	InitRenderers();
+
+	for (const auto& [programNameCrc, shaderNames] : m_pShaderCollections->GetShaderPrograms())
+	{
+		const std::set<std::string>& featureCombines = m_pShaderCollections->GetFeatureCombines(programNameCrc);
+		for (const std::string& shaderName : shaderNames)
+		{
+			engine::ShaderType type = engine::GetShaderType(shaderName);
+			m_pRenderContext->AddShaderBlob(engine::StringCrc{ shaderName }, MakeStubShaderBlob(type, shaderName));
+			if (engine::ShaderType::Fragment == type)
+			{
+				for (const std::string& featureCombine : featureCombines)
+				{
+					std::string blobName = shaderName + featureCombine;
+					m_pRenderContext->AddShaderBlob(engine::StringCrc{ blobName }, MakeStubShaderBlob(type, blobName));
+				}
+			}
+		}
+	}
+
+	for (std::unique_ptr<engine::Renderer>& pRenderer : m_pRenderers)
+	{
+		pRenderer->Warmup();
+	}
+
+	m_pRenderSnapshot = std::make_unique<engine::RenderSnapshot>();
+
+	m_initTime = engine::ProfileRecorder::GetTimestamp() - beginTime;
+	CD_ENGINE_INFO("Benchmark scene is ready in {0} ms.", ToMilliseconds(m_initTime));
+}
+
+void BenchmarkApp::InitRenderContext()
+{
+	engine::Path::SetGraphicsBackend(engine::GraphicsBackend::Noop);
+	m_pRenderContext = std::make_unique<engine::RenderContext>();
+	m_pRenderContext->Init(engine::GraphicsBackend::Noop);
+	m_pRenderContext->SetBackBufferSize(m_args.width, m_args.height);
+	engine::Renderer::SetRenderContext(m_pRenderContext.get());
+
+	m_pResourceContext = std::make_unique<engine::ResourceContext>(m_pRenderContext->GetGPUResourceRegistry());
+	m_pRenderContext->SetResourceContext(m_pResourceContext.get());
+
+	m_pShaderCollections = std::make_unique<engine::ShaderCollections>();
+	m_pRenderContext->SetShaderCollections(m_pShaderCollections.get());
+}
+
+void BenchmarkApp::InitMaterialType()
+{
+	constexpr engine::StringCrc WorldProgramCrc{ WorldProgram };
+	constexpr engine::StringCrc AnimationProgramCrc{ AnimationProgram };
+	constexpr engine::StringCrc TerrainProgramCrc{ TerrainProgram };
+	constexpr engine::StringCrc ParticleProgramCrc{ ParticleProgram };
+
+	m_pRenderContext->RegisterShaderProgram(WorldProgramCrc, { "vs_PBR", "fs_PBR" });
+	m_pRenderContext->RegisterShaderProgram(AnimationProgramCrc, { "vs_animation", "fs_animation" });
+	m_pRenderContext->RegisterShaderProgram(TerrainProgramCrc, { "vs_terrain", "fs_terrain" });
+	m_pRenderContext->RegisterShaderProgram(ParticleProgramCrc, { "vs_particle","fs_particle" });
+
+	// Atmospheric scattering needs compute shaders which are not stable across backends. Keep the benchmark scene simple.
+	m_pSceneWorld = std::make_unique<engine::SceneWorld>();
+	m_pSceneWorld->CreatePBRMaterialType(WorldProgram, false);
+	m_pSceneWorld->CreateAnimationMaterialType(AnimationProgram);
+	m_pSceneWorld->CreateTerrainMaterialType(TerrainProgram);
+	m_pSceneWorld->CreateParticleMaterialType(ParticleProgram);
+}
+
+void BenchmarkApp::InitCameraEntity()
+{
+	engine::World* pWorld = m_pSceneWorld->GetWorld();
+
+	engine::Entity cameraEntity = pWorld->CreateEntity();
+	m_pSceneWorld->SetMainCameraEntity(cameraEntity);
+	auto& nameComponent = pWorld->CreateComponent<engine::NameComponent>(cameraEntity);
+	nameComponent.SetName("MainCamera");
+
+	auto& cameraTransformComponent = pWorld->CreateComponent<engine::TransformComponent>(cameraEntity);
+	cameraTransformComponent.SetTransform(cd::Transform::Identity());
+	cameraTransformComponent.Build();
+
+	auto& cameraTransform = cameraTransformComponent.GetTransform();
+	cameraTransform.SetTranslation(cd::Point(0.0f, 0.0f, -2.0f * SceneHalfExtent));
+	engine::CameraComponent::SetLookAt(cd::Direction(0.0f, 0.0f, 1.0f), cameraTransform);
+	engine::CameraComponent::SetUp(cd::Direction(0.0f, 1.0f, 0.0f), cameraTransform);
+
+	auto& cameraComponent = pWorld->CreateComponent<engine::CameraComponent>(cameraEntity);
+	cameraComponent.SetAspect(static_cast<float>(m_args.width) / static_cast<float>(m_args.height));
+	cameraComponent.SetFov(45.0f);
+	cameraComponent.SetNearPlane(0.1f);
+	cameraComponent.SetFarPlane(2000.0f);
+	cameraComponent.SetNDCDepth(bgfx::getCaps()->homogeneousDepth ? cd::NDCDepth::MinusOneToOne : cd::NDCDepth::ZeroToOne);
+	cameraComponent.SetExposure(1.0f);
+	cameraComponent.SetGammaCorrection(0.45f);
+	cameraComponent.SetToneMappingMode(cd::ToneMappingMode::ACES);
+	cameraComponent.SetBloomDownSampleTimes(4);
+	cameraComponent.SetBloomIntensity(1.0f);
+	cameraComponent.SetLuminanceThreshold(1.0f);
+	cameraComponent.SetBlurTimes(0);
+	cameraComponent.SetBlurSize(0.0f);
+	cameraComponent.SetBlurScaling(1);
+	cameraComponent.SetBloomEnable(false);
+	cameraComponent.SetBlurEnable(false);
+	cameraComponent.BuildProjectMatrix();
+	cameraComponent.BuildViewMatrix(cameraTransform);
+}
+
+void BenchmarkApp::InitSkyEntity()
+{
+	engine::World* pWorld = m_pSceneWorld->GetWorld();
+
+	engine::Entity skyEntity = pWorld->CreateEntity();
+	m_pSceneWorld->SetSkyEntity(skyEntity);
+
+	auto& nameComponent = pWorld->CreateComponent<engine::NameComponent>(skyEntity);
+	nameComponent.SetName("Sky");
+
+	pWorld->CreateComponent<engine::SkyComponent>(skyEntity);
+
+	cd::VertexFormat vertexFormat;
+	vertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Position, cd::AttributeValueType::Float, 3);
+	m_pRenderContext->CreateVertexLayout(engine::StringCrc("PosistionOnly"), vertexFormat.GetVertexAttributeLayouts());
+
+	cd::SceneDatabase* pSceneDatabase = m_pSceneWorld->GetSceneDatabase();
+	std::optional<cd::Mesh> optMesh = cd::MeshGenerator::Generate(cd::Box(cd::Point(-1.0f), cd::Point(1.0f)), vertexFormat, false);
+	assert(optMesh.has_value());
+	optMesh->SetName("SkyboxMesh");
+	optMesh->SetID(cd::MeshID(pSceneDatabase->GetMeshCount()));
+	uint32_t meshIndex = pSceneDatabase->GetMeshCount();
+	pSceneDatabase->AddMesh(cd::MoveTemp(optMesh.value()));
+
+	auto& meshComponent = pWorld->CreateComponent<engine::StaticMeshComponent>(skyEntity);
+	constexpr engine::StringCrc skyboxMeshCrc("SkyboxMesh");
+	engine::MeshResource* pMeshResource = m_pResourceContext->AddMeshResource(skyboxMeshCrc);
+	pMeshResource->SetMeshAsset(&pSceneDatabase->GetMesh(meshIndex));
+	pMeshResource->UpdateVertexFormat(vertexFormat);
+	meshComponent.SetMeshResource(pMeshResource);
+}
+
+void BenchmarkApp::InitScene()
+{
+	engine::World* pWorld = m_pSceneWorld->GetWorld();
+	cd::SceneDatabase* pSceneDatabase = m_pSceneWorld->GetSceneDatabase();
+	engine::MaterialType* pPBRMaterialType = m_pSceneWorld->GetPBRMaterialType();
+	engine::MaterialType* pParticleMaterialType = m_pSceneWorld->GetParticleMaterialType();
+	engine::ShaderFeature skyFeature = engine::GetSkyTypeShaderFeature(m_pSceneWorld->GetSkyComponent(m_pSceneWorld->GetSkyEntity())->GetSkyType());
+
+	std::mt19937 randomEngine(m_args.seed);
+	std::uniform_real_distribution<float> positionDistribution(-SceneHalfExtent, SceneHalfExtent);
+	std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+	auto RandomPoint = [&]() { return cd::Point(positionDistribution(randomEngine), positionDistribution(randomEngine), positionDistribution(randomEngine)); };
+
+	// Shape meshes are shared by all entities as the scene is about the count of draw calls, not memory of assets.
+	const cd::VertexFormat& vertexFormat = pPBRMaterialType->GetRequiredVertexFormat();
+	std::optional<cd::Mesh> optBoxMesh = cd::MeshGenerator::Generate(cd::Box(cd::Point(-5.0f), cd::Point(5.0f)), vertexFormat);
+	std::optional<cd::Mesh> optSphereMesh = cd::MeshGenerator::Generate(cd::Sphere(cd::Point(0.0f), 5.0f), 32U, 32U, vertexFormat);
+	assert(optBoxMesh.has_value() && optSphereMesh.has_value());
+
+	uint32_t boxMeshIndex = pSceneDatabase->GetMeshCount();
+	optBoxMesh->SetName("BenchmarkBox");
+	optBoxMesh->SetID(cd::MeshID(boxMeshIndex));
+	pSceneDatabase->AddMesh(cd::MoveTemp(optBoxMesh.value()));
+
+	uint32_t sphereMeshIndex = pSceneDatabase->GetMeshCount();
+	optSphereMesh->SetName("BenchmarkSphere");
+	optSphereMesh->SetID(cd::MeshID(sphereMeshIndex));
+	pSceneDatabase->AddMesh(cd::MoveTemp(optSphereMesh.value()));
+
+	const cd::Mesh& boxMesh = pSceneDatabase->GetMesh(boxMeshIndex);
+	const cd::Mesh& sphereMesh = pSceneDatabase->GetMesh(sphereMeshIndex);
+
+	engine::MeshResource* pBoxMeshResource = m_pResourceContext->AddMeshResource(engine::StringCrc("BenchmarkBox"));
+	pBoxMeshResource->SetMeshAsset(&boxMesh);
+	pBoxMeshResource->UpdateVertexFormat(vertexFormat);
+
+	engine::MeshResource* pSphereMeshResource = m_pResourceContext->AddMeshResource(engine::StringCrc("BenchmarkSphere"));
+	pSphereMeshResource->SetMeshAsset(&sphereMesh);
+	pSphereMeshResource->UpdateVertexFormat(vertexFormat);
+
+	auto AddNamedEntity = [&pWorld](const char* pDefaultName) -> engine::Entity
+	{
+		engine::Entity entity = pWorld->CreateEntity();
+		auto& nameComponent = pWorld->CreateComponent<engine::NameComponent>(entity);
+		nameComponent.SetName(pDefaultName + std::to_string(entity));
+		return entity;
+	};
+
+	auto CreateShapeComponents = [&](engine::Entity entity, bool isSphere, const cd::Point& position)
+	{
+		auto& collisionMeshComponent = pWorld->CreateComponent<engine::CollisionMeshComponent>(entity);
+		collisionMeshComponent.SetType(engine::CollisonMeshType::AABB);
+		collisionMeshComponent.SetAABB(isSphere ? sphereMesh.GetAABB() : boxMesh.GetAABB());
+
+		auto& staticMeshComponent = pWorld->CreateComponent<engine::StaticMeshComponent>(entity);
+		staticMeshComponent.SetMeshResource(isSphere ? pSphereMeshResource : pBoxMeshResource);
+
+		auto& materialComponent = pWorld->CreateComponent<engine::MaterialComponent>(entity);
+		materialComponent.Init();
+		materialComponent.SetMaterialType(pPBRMaterialType);
+		materialComponent.ActivateShaderFeature(skyFeature);
+		materialComponent.SetFactor(cd::MaterialPropertyGroup::BaseColor, cd::Vec3f(unitDistribution(randomEngine), unitDistribution(randomEngine), unitDistribution(randomEngine)));
+
+		auto& transformComponent = pWorld->CreateComponent<engine::TransformComponent>(entity);
+		transformComponent.SetTransform(cd::Transform::Identity());
+		transformComponent.GetTransform().SetTranslation(position);
+		transformComponent.Build();
+	};
+
+	for (uint32_t meshIndex = 0U; meshIndex < m_args.meshCount; ++meshIndex)
+	{
+		engine::Entity entity = AddNamedEntity("Mesh");
+		CreateShapeComponents(entity, 1U == (meshIndex & 1U), RandomPoint());
+	}
+
+	// Skinned characters need cooked skeleton assets. Characters here are rigid spheres moved on every frame
+	// so that transforms, bounds and snapshot items of animated entities are still updated per frame.
+	m_characterEntities.reserve(m_args.characterCount);
+	for (uint32_t characterIndex = 0U; characterIndex < m_args.characterCount; ++characterIndex)
+	{
+		engine::Entity entity = AddNamedEntity("Character");
+		CreateShapeComponents(entity, true, RandomPoint());
+		m_characterEntities.push_back(entity);
+	}
+
+	for (uint32_t lightIndex = 0U; lightIndex < m_args.lightCount; ++lightIndex)
+	{
+		engine::Entity entity = AddNamedEntity("Light");
+		auto& lightComponent = pWorld->CreateComponent<engine::LightComponent>(entity);
+		lightComponent.SetColor(cd::Vec3f(unitDistribution(randomEngine), unitDistribution(randomEngine), unitDistribution(randomEngine)));
+		lightComponent.SetShadowMapSize(1024U);
+		lightComponent.SetShadowBias(0.0f);
+		lightComponent.SetShadowMapTexture(BGFX_INVALID_HANDLE);
+
+		// The first light is a directional light with cascaded shadow. Others are point and spot lights.
+		if (0U == lightIndex)
+		{
+			lightComponent.SetType(cd::LightType::Directional);
+			lightComponent.SetIntensity(4.0f);
+			lightComponent.SetIsCastShadow(true);
+			lightComponent.SetDirection(cd::Direction(0.0f, -1.0f, 1.0f).Normalize());
+			lightComponent.SetCascadeNum(4);
+			lightComponent.SetFrustumClips(cd::Vec4f(0.0f, 0.0f, 0.0f, 0.0f));
+		}
+		else if (1U == (lightIndex & 1U))
+		{
+			lightComponent.SetType(cd::LightType::Point);
+			lightComponent.SetIntensity(1024.0f);
+			lightComponent.SetIsCastShadow(false);
+			lightComponent.SetPosition(RandomPoint());
+			lightComponent.SetRange(1024.0f);
+		}
+		else
+		{
+			lightComponent.SetType(cd::LightType::Spot);
+			lightComponent.SetIntensity(1024.0f);
+			lightComponent.SetIsCastShadow(false);
+			lightComponent.SetPosition(RandomPoint());
+			lightComponent.SetDirection(cd::Direction(0.0f, 0.0f, 1.0f));
+			lightComponent.SetRange(1024.0f);
+			lightComponent.SetInnerAndOuter(24.0f, 40.0f);
+		}
+
+		auto& transformComponent = pWorld->CreateComponent<engine::TransformComponent>(entity);
+		transformComponent.SetTransform(cd::Transform::Identity());
+		transformComponent.Build();
+	}
+
+	for (uint32_t emitterIndex = 0U; emitterIndex < m_args.emitterCount; ++emitterIndex)
+	{
+		engine::Entity entity = AddNamedEntity("ParticleEmitter");
+		auto& particleEmitterComponent = pWorld->CreateComponent<engine::ParticleEmitterComponent>(entity);
+
+		auto& transformComponent = pWorld->CreateComponent<engine::TransformComponent>(entity);
+		transformComponent.SetTransform(cd::Transform::Identity());
+		transformComponent.GetTransform().SetTranslation(RandomPoint());
+		transformComponent.Build();
+
+		particleEmitterComponent.SetRequiredVertexFormat(&pParticleMaterialType->GetRequiredVertexFormat());
+		particleEmitterComponent.SetMaterialType(pParticleMaterialType);
+		particleEmitterComponent.ActivateShaderFeature(engine::ShaderFeature::PARTICLE_INSTANCE);
+		particleEmitterComponent.Build();
+	}
+
+	CD_ENGINE_INFO("Benchmark scene has {0} meshes, {1} characters, {2} lights and {3} particle emitters.",
+		m_args.meshCount, m_args.characterCount, m_args.lightCount, m_args.emitterCount);
+}
+
+void BenchmarkApp::InitRenderers()
+{
+	constexpr engine::StringCrc sceneRenderTargetName("SceneRenderTarget");
+	std::vector<engine::AttachmentDescriptor> attachmentDesc = {
+		{.textureFormat = engine::TextureFormat::RGBA32F },
+		{.textureFormat = engine::TextureFormat::RGBA32F },
+		{.textureFormat = engine::TextureFormat::D32F },
+	};
+	engine::RenderTarget* pSceneRenderTarget = m_pRenderContext->CreateRenderTarget(sceneRenderTargetName, m_args.width, m_args.height, std::move(attachmentDesc));
+
+	// Same order as the editor. ImGuiRenderer needs an ImGui context and DDGIRenderer needs the DDGI SDK so both are skipped.
+	auto pShadowMapRenderer = std::make_unique<engine::ShadowMapRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pShadowMapRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pShadowMapRenderer));
+
+	auto pSkyboxRenderer = std::make_unique<engine::SkyboxRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pSkyboxRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pSkyboxRenderer));
+
+	auto pWorldRenderer = std::make_unique<engine::WorldRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pWorldRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pWorldRenderer));
+
+	auto pBlendShapeRenderer = std::make_unique<engine::BlendShapeRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pBlendShapeRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pBlendShapeRenderer));
+
+	auto pTerrainRenderer = std::make_unique<engine::TerrainRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pTerrainRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pTerrainRenderer));
+
+	auto pSkeletonRenderer = std::make_unique<engine::SkeletonRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pSkeletonRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pSkeletonRenderer));
+
+	auto pAnimationRenderer = std::make_unique<engine::AnimationRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pAnimationRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pAnimationRenderer));
+
+	auto pWhiteModelRenderer = std::make_unique<engine::WhiteModelRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pWhiteModelRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pWhiteModelRenderer));
+
+	auto pParticleRenderer = std::make_unique<engine::ParticleRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pParticleRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pParticleRenderer));
+
+	auto pParticleForceFieldRenderer = std::make_unique<engine::ParticleForceFieldRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pParticleForceFieldRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pParticleForceFieldRenderer));
+
+	auto pAABBRenderer = std::make_unique<engine::AABBRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pAABBRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pAABBRenderer));
+
+	auto pWireframeRenderer = std::make_unique<engine::WireframeRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pWireframeRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pWireframeRenderer));
+
+	auto pBlitRenderTargetPass = std::make_unique<engine::BlitRenderTargetPass>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	AddRenderer(cd::MoveTemp(pBlitRenderTargetPass));
+
+	auto pBloomRenderer = std::make_unique<engine::BloomRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pBloomRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pBloomRenderer));
+
+	auto pPostProcessRenderer = std::make_unique<engine::PostProcessRenderer>(m_pRenderContext->CreateView(), pSceneRenderTarget);
+	pPostProcessRenderer->SetSceneWorld(m_pSceneWorld.get());
+	AddRenderer(cd::MoveTemp(pPostProcessRenderer));
+}
+
+void BenchmarkApp::AddRenderer(std::unique_ptr<engine::Renderer> pRenderer)
+{
+	// Debug renderers are enabled too so that every Render path is measured.
+	pRenderer->SetEnable(true);
+	pRenderer->Init();
+	m_pRenderers.emplace_back(cd::MoveTemp(pRenderer));
+}
+
+void BenchmarkApp::LoadStubShaders(const std::string& programName, const std::string& featuresCombine)
+{
+	for (const std::string& shaderName : m_pShaderCollections->GetShaders(engine::StringCrc{ programName }))
+	{
+		engine::ShaderType type = engine::GetShaderType(shaderName);
+		std::string blobName = engine::ShaderType::Fragment == type ? shaderName + featuresCombine : shaderName;
+		m_pRenderContext->AddShaderBlob(engine::StringCrc{ blobName }, MakeStubShaderBlob(type, blobName));
+	}
+}
+
+void BenchmarkApp::UpdateMaterials()
+{
+	for (engine::Entity entity : m_pSceneWorld->GetMaterialEntities())
+	{
+		engine::MaterialComponent* pMaterialComponent = m_pSceneWorld->GetMaterialComponent(entity);
+		if (!pMaterialComponent)
+		{
+			continue;
+		}
+
+		m_pRenderContext->CheckShaderProgram(entity, pMaterialComponent->GetShaderProgramName(), pMaterialComponent->GetFeaturesCombine());
+	}
+
+	// Editor compiles shaders here. Benchmark uploads stub shaders instead so only the engine side cost is measured.
+	for (const engine::ShaderCompileInfo& info : m_pRenderContext->GetShaderCompileInfos())
+	{
+		LoadStubShaders(info.m_programName, info.m_featuresCombine);
+		m_pRenderContext->DestroyShaderProgram(info.m_programName, info.m_featuresCombine);
+		m_pRenderContext->UploadShaderProgram(info.m_programName, info.m_featuresCombine);
+	}
+	m_pRenderContext->ClearShaderCompileInfos();
+}
+
+void BenchmarkApp::UpdateCharacters(float time)
+{
+	for (size_t characterIndex = 0U; characterIndex < m_characterEntities.size(); ++characterIndex)
+	{
+		engine::TransformComponent* pTransformComponent = m_pSceneWorld->GetTransformComponent(m_characterEntities[characterIndex]);
+		cd::Transform& transform = pTransformComponent->GetTransform();
+
+		// Every character walks on its own circle with a small bounce.
+		float phase = time + static_cast<float>(characterIndex);
+		cd::Vec3f translation = transform.GetTranslation();
+		translation.x() += std::cos(phase);
+		translation.z() += std::sin(phase);
+		translation.y() = std::abs(std::sin(phase * 4.0f)) * 2.0f;
+		transform.SetTranslation(translation);
+		pTransformComponent->Build();
+	}
+}
+
+template<typename Func>
+void BenchmarkApp::Measure(const char* pName, Func&& func)
+{
+	engine::HeapAllocationStats beginAllocation = engine::HeapAllocationCounter::GetStats();
+	uint64_t beginTime = engine::ProfileRecorder::GetTimestamp();
+
+	func();
+
+	uint64_t time = engine::ProfileRecorder::GetTimestamp() - beginTime;
+	engine::HeapAllocationStats endAllocation = engine::HeapAllocationCounter::GetStats();
+
+	// Look up after func as nested measures can add stats.
+	auto itStats = std::find_if(m_systemStats.begin(), m_systemStats.end(), [pName](const SystemStats& stats) { return stats.name == pName; });
+	if (itStats == m_systemStats.end())
+	{
+		itStats = m_systemStats.insert(m_systemStats.end(), SystemStats{ .name = pName });
+	}
+
+	SystemStats& stats = *itStats;
+	++stats.sampleCount;
+	stats.totalTime += time;
+	stats.minTime = std::min(stats.minTime, time);
+	stats.maxTime = std::max(stats.maxTime, time);
+	stats.allocationCount += endAllocation.count - beginAllocation.count;
+	stats.allocationBytes += endAllocation.bytes - beginAllocation.bytes;
+}
+
+void BenchmarkApp::Run()
+{
+	constexpr float deltaTime = 1.0f / 60.0f;
+
+	uint64_t beginTime = engine::ProfileRecorder::GetTimestamp();
+	for (uint32_t frameIndex = 0U; frameIndex < m_args.frameCount; ++frameIndex)
+	{
+		Measure("Frame", [this, frameIndex, deltaTime]()
+		{
+			Measure("UpdateCharacters", [this, frameIndex, deltaTime]() { UpdateCharacters(static_cast<float>(frameIndex) * deltaTime); });
+			Measure("SceneWorld::Update", [this, deltaTime]() { m_pSceneWorld->Update(deltaTime); });
+			Measure("RenderSnapshot::Capture", [this, frameIndex]() { m_pRenderSnapshot->Capture(*m_pSceneWorld, frameIndex + 1U); });
+			Measure("UpdateMaterials", [this]() { UpdateMaterials(); });
+			Measure("ResourceContext::Update", [this]() { m_pResourceContext->Update(); });
+
+			m_pRenderContext->SetRenderSnapshot(m_pRenderSnapshot.get());
+			m_pRenderContext->BeginFrame();
+
+			const engine::RenderSnapshotCamera& snapshotCamera = m_pRenderSnapshot->GetCamera();
+			for (std::unique_ptr<engine::Renderer>& pRenderer : m_pRenderers)
+			{
+				if (pRenderer->IsEnable())
+				{
+					Measure(pRenderer->GetName(), [&pRenderer, &snapshotCamera, deltaTime]()
+					{
+						pRenderer->UpdateView(snapshotCamera.viewMatrix.begin(), snapshotCamera.projectionMatrix.begin());
+						pRenderer->Render(deltaTime);
+					});
+				}
+			}
+
+			Measure("RenderContext::EndFrame", [this]() { m_pRenderContext->EndFrame(); });
+		});
+	}
+	m_totalTime = engine::ProfileRecorder::GetTimestamp() - beginTime;
+
+	CD_ENGINE_INFO("Benchmark runs {0} frames in {1} ms.", m_args.frameCount, ToMilliseconds(m_totalTime));
+}
+
+void BenchmarkApp::RunScenarios()
+{
+	RunSceneQueryScenario();
+	RunMeshOptimizeScenario();
+}
+
+void BenchmarkApp::RunSceneQueryScenario()
+{
+	constexpr uint32_t refitIterationCount = 4U;
+	if (0U == m_args.queryObjectCount)
+	{
+		return;
+	}
+
+	engine::MeshResource* pBoxMeshResource = m_pResourceContext->GetMeshResource(engine::StringCrc("BenchmarkBox"));
+	const cd::AABB& boxAABB = pBoxMeshResource->GetMeshAsset()->GetAABB();
+
+	std::mt19937 randomEngine(m_args.seed);
+	std::uniform_real_distribution<float> positionDistribution(-QuerySceneHalfExtent, QuerySceneHalfExtent);
+	std::uniform_real_distribution<float> offsetDistribution(-10.0f, 10.0f);
+	auto RandomPoint = [&]() { return cd::Point(positionDistribution(randomEngine), positionDistribution(randomEngine), positionDistribution(randomEngine)); };
+
+	// Entities only have components which SceneQuery reads.
+	auto pQuerySceneWorld = std::make_unique<engine::SceneWorld>();
+	engine::World* pWorld = pQuerySceneWorld->GetWorld();
+	std::vector<engine::Entity> entities;
+	entities.reserve(m_args.queryObjectCount);
+	for (uint32_t objectIndex = 0U; objectIndex < m_args.queryObjectCount; ++objectIndex)
+	{
+		engine::Entity entity = pWorld->CreateEntity();
+		auto& collisionMeshComponent = pWorld->CreateComponent<engine::CollisionMeshComponent>(entity);
+		collisionMeshComponent.SetType(engine::CollisonMeshType::AABB);
+		collisionMeshComponent.SetAABB(boxAABB);
+
+		auto& staticMeshComponent = pWorld->CreateComponent<engine::StaticMeshComponent>(entity);
+		staticMeshComponent.SetMeshResource(pBoxMeshResource);
+
+		auto& transformComponent = pWorld->CreateComponent<engine::TransformComponent>(entity);
+		transformComponent.SetTransform(cd::Transform::Identity());
+		transformComponent.GetTransform().SetTranslation(RandomPoint());
+		transformComponent.Build();
+		entities.push_back(entity);
+	}
+
+	engine::SceneQuery* pSceneQuery = pQuerySceneWorld->GetSceneQuery();
+	Measure("SceneQuery::Build", [pSceneQuery, &pQuerySceneWorld]() { pSceneQuery->Update(pQuerySceneWorld.get()); });
+
+	// Many moved objects take the full bottom-up refit and a few moved objects take the per leaf refit.
+	// Moved objects in total stay under the count which triggers a rebuild.
+	auto MoveObjects = [&](uint32_t movedCount)
+	{
+		std::uniform_int_distribution<size_t> entityDistribution(0U, entities.size() - 1U);
+		for (uint32_t movedIndex = 0U; movedIndex < movedCount; ++movedIndex)
+		{
+			engine::TransformComponent* pTransformComponent = pQuerySceneWorld->GetTransformComponent(entities[entityDistribution(randomEngine)]);
+			cd::Transform& transform = pTransformComponent->GetTransform();
+			transform.SetTranslation(transform.GetTranslation() + cd::Vec3f(offsetDistribution(randomEngine), offsetDistribution(randomEngine), offsetDistribution(randomEngine)));
+			pTransformComponent->Dirty();
+		}
+	};
+
+	for (uint32_t iteration = 0U; iteration < refitIterationCount; ++iteration)
+	{
+		MoveObjects(m_args.queryObjectCount / 16U);
+		Measure("SceneQuery::Refit", [pSceneQuery, &pQuerySceneWorld]() { pSceneQuery->Update(pQuerySceneWorld.get()); });
+
+		MoveObjects(std::min(m_args.queryObjectCount / 16U, 64U));
+		Measure("SceneQuery::RefitPrimitives", [pSceneQuery, &pQuerySceneWorld]() { pSceneQuery->Update(pQuerySceneWorld.get()); });
+	}
+
+	// Rays start inside the scene so most of them hit boxes after walking a few BVH levels.
+	std::vector<std::pair<cd::Vec3f, cd::Vec3f>> rays;
+	rays.reserve(m_args.rayCount);
+	for (uint32_t rayIndex = 0U; rayIndex < m_args.rayCount; ++rayIndex)
+	{
+		cd::Point origin = RandomPoint();
+		cd::Vec3f direction = RandomPoint() - origin;
+		rays.emplace_back(origin, direction.Normalize());
+	}
+
+	uint32_t hitCount = 0U;
+	Measure("SceneQuery::Raycast", [pSceneQuery, &rays, &hitCount]()
+	{
+		for (const auto& [origin, direction] : rays)
+		{
+			engine::RaycastHit hit;
+			if (pSceneQuery->Raycast(origin, direction, FLT_MAX, hit))
+			{
+				++hitCount;
+			}
+		}
+	});
+
+	m_sceneQueryStats.objectCount = pSceneQuery->GetEntityCount();
+	m_sceneQueryStats.nodeCount = pSceneQuery->GetEntityBVH().GetNodeCount();
+	m_sceneQueryStats.rayCount = m_args.rayCount;
+	m_sceneQueryStats.hitCount = hitCount;
+
+	CD_ENGINE_INFO("Scene query scenario hits {0} of {1} rays over {2} objects.", hitCount, m_args.rayCount, m_sceneQueryStats.objectCount);
+}
+
+void BenchmarkApp::RunMeshOptimizeScenario()
+{
+	constexpr uint32_t iterationCount = 8U;
+
+	const cd::VertexFormat& vertexFormat = m_pSceneWorld->GetPBRMaterialType()->GetRequiredVertexFormat();
+	std::optional<cd::Mesh> optDenseSphereMesh = cd::MeshGenerator::Generate(cd::Sphere(cd::Point(0.0f), 5.0f), 256U, 256U, vertexFormat);
+	assert(optDenseSphereMesh.has_value());
+	optDenseSphereMesh->SetName("BenchmarkDenseSphere");
+
+	const cd::SceneDatabase* pSceneDatabase = m_pSceneWorld->GetSceneDatabase();
+	std::vector<const cd::Mesh*> meshes;
+	for (const cd::Mesh& mesh : pSceneDatabase->GetMeshes())
+	{
+		if (mesh.GetVertexFormat().Contains(cd::VertexAttributeType::Normal))
+		{
+			meshes.push_back(&mesh);
+		}
+	}
+	meshes.push_back(&optDenseSphereMesh.value());
+
+	const engine::MeshOptimizeOptions optimizeOptions = engine::MeshOptimizeOptions::All();
+	for (const cd::Mesh* pMesh : meshes)
+	{
+		std::optional<cd::VertexBuffer> optVertexBuffer = cd::BuildVertexBufferForStaticMesh(*pMesh, vertexFormat);
+		std::vector<std::vector<std::byte>> indexBuffers;
+		for (uint32_t polygonGroupIndex = 0U; polygonGroupIndex < pMesh->GetPolygonGroupCount(); ++polygonGroupIndex)
+		{
+			std::optional<cd::IndexBuffer> optIndexBuffer = cd::BuildIndexBufferesForPolygonGroup(*pMesh, polygonGroupIndex);
+			if (optIndexBuffer.has_value())
+			{
+				indexBuffers.push_back(cd::MoveTemp(optIndexBuffer.value()));
+			}
+		}
+
+		if (!optVertexBuffer.has_value() || indexBuffers.size() != pMesh->GetPolygonGroupCount())
+		{
+			CD_ENGINE_WARN("Skip mesh {0} in optimize scenario as its buffers can't be built.", pMesh->GetName());
+			continue;
+		}
+
+		// Optimization works in place so every iteration starts from a copy of the built buffers.
+		MeshOptimizeScenarioStats& scenarioStats = m_meshOptimizeStats.emplace_back();
+		scenarioStats.meshName = pMesh->GetName();
+		scenarioStats.vertexCount = pMesh->GetVertexCount();
+		scenarioStats.triangleCount = pMesh->GetPolygonCount();
+		for (uint32_t iteration = 0U; iteration < iterationCount; ++iteration)
+		{
+			std::vector<std::byte> vertexBuffer = optVertexBuffer.value();
+			std::vector<std::vector<std::byte>> meshIndexBuffers = indexBuffers;
+			std::vector<std::vector<engine::MeshLod>> lods;
+			Measure("MeshOptimizer::Optimize", [&]()
+			{
+				scenarioStats.optimizeStats = engine::MeshOptimizer::Optimize(optimizeOptions, vertexBuffer, vertexFormat, pMesh->GetVertexCount(), meshIndexBuffers, lods);
+			});
+		}
+
+		const engine::MeshOptimizeStats& optimizeStats = scenarioStats.optimizeStats;
+		CD_ENGINE_INFO("Mesh optimize scenario {0} : vertex buffer {1} -> {2} bytes, vertex shader invocations {3} -> {4}.",
+			scenarioStats.meshName, optimizeStats.vertexBufferBytesBefore, optimizeStats.vertexBufferBytesAfter,
+			optimizeStats.vertexShaderInvocationsBefore, optimizeStats.vertexShaderInvocationsAfter);
+	}
+}
+
+void BenchmarkApp::Shutdown()
+{
+	m_pRenderers.clear();
+	m_pRenderSnapshot.reset();
+	m_pSceneWorld.reset();
+	m_pResourceContext.reset();
+	m_pRenderContext->Shutdown();
+	m_pRenderContext.reset();
+	m_pShaderCollections.reset();
+}
+
+bool BenchmarkApp::WriteReport(const char* pFilePath) const
+{
+	nlohmann::json report;
+	report["config"] = {
+		{ "backend", "Noop" },
+		{ "frames", m_args.frameCount },
+		{ "meshes", m_args.meshCount },
+		{ "lights", m_args.lightCount },
+		{ "emitters", m_args.emitterCount },
+		{ "characters", m_args.characterCount },
+		{ "queryObjects", m_args.queryObjectCount },
+		{ "rays", m_args.rayCount },
+		{ "seed", m_args.seed },
+		{ "width", m_args.width },
+		{ "height", m_args.height },
+	};
+	report["initTimeMs"] = ToMilliseconds(m_initTime);
+	report["totalTimeMs"] = ToMilliseconds(m_totalTime);
+
+	nlohmann::json systems = nlohmann::json::array();
+	for (const SystemStats& stats : m_systemStats)
+	{
+		double sampleCount = static_cast<double>(std::max(stats.sampleCount, 1U));
+		systems.push_back({
+			{ "name", stats.name },
+			{ "samples", stats.sampleCount },
+			{ "totalMs", ToMilliseconds(stats.totalTime) },
+			{ "averageMs", ToMilliseconds(stats.totalTime) / sampleCount },
+			{ "minMs", stats.sampleCount > 0U ? ToMilliseconds(stats.minTime) : 0.0 },
+			{ "maxMs", ToMilliseconds(stats.maxTime) },
+			{ "allocations", stats.allocationCount },
+			{ "allocationBytes", stats.allocationBytes },
+			{ "allocationsPerFrame", static_cast<double>(stats.allocationCount) / sampleCount },
+		});
+	}
+	report["systems"] = cd::MoveTemp(systems);
+
+	report["sceneQuery"] = {
+		{ "objects", m_sceneQueryStats.objectCount },
+		{ "bvhNodes", m_sceneQueryStats.nodeCount },
+		{ "rays", m_sceneQueryStats.rayCount },
+		{ "hits", m_sceneQueryStats.hitCount },
+	};
+
+	nlohmann::json meshOptimize = nlohmann::json::array();
+	for (const MeshOptimizeScenarioStats& scenarioStats : m_meshOptimizeStats)
+	{
+		const engine::MeshOptimizeStats& optimizeStats = scenarioStats.optimizeStats;
+		meshOptimize.push_back({
+			{ "mesh", scenarioStats.meshName },
+			{ "vertices", scenarioStats.vertexCount },
+			{ "triangles", scenarioStats.triangleCount },
+			{ "quantized", optimizeStats.quantizedMeshCount > 0U },
+			{ "vertexBufferBytesBefore", optimizeStats.vertexBufferBytesBefore },
+			{ "vertexBufferBytesAfter", optimizeStats.vertexBufferBytesAfter },
+			{ "bytesSaved", optimizeStats.vertexBufferBytesBefore - optimizeStats.vertexBufferBytesAfter },
+			{ "vertexShaderInvocationsBefore", optimizeStats.vertexShaderInvocationsBefore },
+			{ "vertexShaderInvocationsAfter", optimizeStats.vertexShaderInvocationsAfter },
+		});
+	}
+	report["meshOptimize"] = cd::MoveTemp(meshOptimize);
+
+	nlohmann::json memory = nlohmann::json::array();
+	for (uint32_t tagIndex = 0U; tagIndex < static_cast<uint32_t>(engine::MemoryTag::Count); ++tagIndex)
+	{
+		engine::MemoryTag tag = static_cast<engine::MemoryTag>(tagIndex);
+		engine::MemoryTagStats stats = engine::MemoryTracker::GetStats(tag);
+		memory.push_back({
+			{ "tag", engine::MemoryTracker::GetTagName(tag) },
+			{ "currentBytes", stats.currentBytes },
+			{ "peakBytes", stats.peakBytes },
+			{ "liveAllocations", stats.liveAllocationCount },
+			{ "totalAllocations", stats.totalAllocationCount },
+			{ "budgetBytes", stats.budgetBytes },
+			{ "overBudget", engine::MemoryTracker::IsOverBudget(tag) },
+		});
+	}
+	report["memory"] = cd::MoveTemp(memory);
+
+	std::ofstream fout(pFilePath, std::ios::out | std::ios::trunc);
+	if (!fout.is_open())
+	{
+		CD_ENGINE_ERROR("Failed to write benchmark report to {0}", pFilePath);
+		return false;
+	}
+
+	fout << report.dump(2) << std::endl;
+	fout.close();
+
+	CD_ENGINE_INFO("Write benchmark report to {0}", pFilePath);
+	return true;
+}
+
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "ECWorld/Entity.h"
+#include "Rendering/Utility/MeshOptimizer.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace engine
+{
+
+class Renderer;
+class RenderContext;
+class RenderSnapshot;
+class ResourceContext;
+class SceneWorld;
+class ShaderCollections;
+
+}
+
+namespace benchmark
+{
+
+struct BenchmarkArgs
+{
+	uint32_t frameCount = 300U;
+	uint32_t meshCount = 1024U;
+	uint32_t lightCount = 3U;
+	uint32_t emitterCount = 8U;
+	uint32_t characterCount = 32U;
+	// Scene query scenario runs on its own world so it doesn't change the rendered scene.
+	uint32_t queryObjectCount = 100000U;
+	uint32_t rayCount = 10000U;
+	uint32_t seed = 1U;
+	uint16_t width = 1280U;
+	uint16_t height = 720U;
+};
+
+// Timings are nanoseconds and allocations come from HeapAllocationCounter.
+struct SystemStats
+{
+	std::string name;
+	uint32_t sampleCount = 0U;
+	uint64_t totalTime = 0U;
+	uint64_t minTime = UINT64_MAX;
+	uint64_t maxTime = 0U;
+	uint64_t allocationCount = 0U;
+	uint64_t allocationBytes = 0U;
+};
+
+struct SceneQueryScenarioStats
+{
+	uint32_t objectCount = 0U;
+	uint32_t nodeCount = 0U;
+	uint32_t rayCount = 0U;
+	uint32_t hitCount = 0U;
+};
+
+struct MeshOptimizeScenarioStats
+{
+	std::string meshName;
+	uint32_t vertexCount = 0U;
+	uint32_t triangleCount = 0U;
+	engine::MeshOptimizeStats optimizeStats;
+};
+
+// Runs scene systems and every engine renderer on the Noop backend without a window.
+// Scenes are generated from the seed so results of two runs are comparable.
+class BenchmarkApp final
+{
+public:
+	explicit BenchmarkApp(BenchmarkArgs args);
+	BenchmarkApp(const BenchmarkApp&) = delete;
+	BenchmarkApp& operator=(const BenchmarkApp&) = delete;
+	BenchmarkApp(BenchmarkApp&&) = delete;
+	BenchmarkApp& operator=(BenchmarkApp&&) = delete;
+	~BenchmarkApp();
+
+	void Init();
+	void Run();
+	// Standalone scenarios of systems which don't run per frame in the benchmark scene.
+	void RunScenarios();
+	void Shutdown();
+
+	// Writes the report as JSON to pFilePath.
+	bool WriteReport(const char* pFilePath) const;
+
+private:
+	void InitRenderContext();
+	void InitMaterialType();
+	void InitCameraEntity();
+	void InitSkyEntity();
+	void InitScene();
+	void InitRenderers();
+	void AddRenderer(std::unique_ptr<engine::Renderer> pRenderer);
+
+	// Noop backend doesn't need shader code. Stub blobs let RenderContext create valid handles without compiled shaders.
+	void LoadStubShaders(const std::string& programName, const std::string& featuresCombine);
+	void UpdateMaterials();
+	void UpdateCharacters(float time);
+
+	// Builds, refits and raycasts a SceneQuery over queryObjectCount boxes.
+	void RunSceneQueryScenario();
+	// Optimizes and quantizes shape meshes in the same way as the scene cooker.
+	void RunMeshOptimizeScenario();
+
+	template<typename Func>
+	void Measure(const char* pName, Func&& func);
+
+private:
+	BenchmarkArgs m_args;
+
+	std::unique_ptr<engine::RenderContext> m_pRenderContext;
+	std::unique_ptr<engine::ResourceContext> m_pResourceContext;
+	std::unique_ptr<engine::ShaderCollections> m_pShaderCollections;
+	std::unique_ptr<engine::SceneWorld> m_pSceneWorld;
+	std::unique_ptr<engine::RenderSnapshot> m_pRenderSnapshot;
+	std::vector<std::unique_ptr<engine::Renderer>> m_pRenderers;
+
+	std::vector<engine::Entity> m_characterEntities;
+	std::vector<SystemStats> m_systemStats;
+	SceneQueryScenarioStats m_sceneQueryStats;
+	std::vector<MeshOptimizeScenarioStats> m_meshOptimizeStats;
+	uint64_t m_initTime = 0U;
+	uint64_t m_totalTime = 0U;
+};
+
+}
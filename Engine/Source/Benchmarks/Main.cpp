@@ -0,0 +1,148 @@
+#include "BenchmarkApp.h"
+#include "Core/Memory/MemoryTracker.h"
+#include "Log/Log.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace
+{
+
+void PrintUsage()
+{
+	std::printf("Usage : Benchmarks [--frames N] [--meshes N] [--lights N] [--emitters N] [--characters N] [--query-objects N] [--rays N] [--seed N] [--budget Tag=MB] --output report.json\n");
+}
+
+// Tag=MB, e.g. Texture=256.
+bool ParseBudget(const char* pValue)
+{
+	const char* pSeparator = std::strchr(pValue, '=');
+	if (!pSeparator)
+	{
+		return false;
+	}
+
+	std::string tagName(pValue, pSeparator);
+	engine::MemoryTag tag;
+	if (!engine::MemoryTracker::FindTag(tagName.c_str(), tag))
+	{
+		return false;
+	}
+
+	double budgetMB = std::strtod(pSeparator + 1, nullptr);
+	engine::MemoryTracker::SetBudget(tag, static_cast<uint64_t>(budgetMB * 1024.0 * 1024.0));
+	return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	using namespace benchmark;
+
+	BenchmarkArgs args;
+	const char* pOutputFilePath = nullptr;
+	for (int argIndex = 1; argIndex < argc; ++argIndex)
+	{
+		const char* pArg = argv[argIndex];
+		if (0 == std::strcmp(pArg, "--help"))
+		{
+			PrintUsage();
+			return 0;
+		}
+
+		if (argIndex + 1 >= argc)
+		{
+			PrintUsage();
+			return 1;
+		}
+
+		const char* pValue = argv[++argIndex];
+		if (0 == std::strcmp(pArg, "--budget"))
+		{
+			if (!ParseBudget(pValue))
+			{
+				PrintUsage();
+				return 1;
+			}
+			continue;
+		}
+
+		uint32_t value = static_cast<uint32_t>(std::strtoul(pValue, nullptr, 10));
+		if (0 == std::strcmp(pArg, "--frames"))
+		{
+			args.frameCount = value;
+		}
+		else if (0 == std::strcmp(pArg, "--meshes"))
+		{
+			args.meshCount = value;
+		}
+		else if (0 == std::strcmp(pArg, "--lights"))
+		{
+			args.lightCount = value;
+		}
+		else if (0 == std::strcmp(pArg, "--emitters"))
+		{
+			args.emitterCount = value;
+		}
+		else if (0 == std::strcmp(pArg, "--characters"))
+		{
+			args.characterCount = value;
+		}
+		else if (0 == std::strcmp(pArg, "--query-objects"))
+		{
+			args.queryObjectCount = value;
+		}
+		else if (0 == std::strcmp(pArg, "--rays"))
+		{
+			args.rayCount = value;
+		}
+		else if (0 == std::strcmp(pArg, "--seed"))
+		{
+			args.seed = value;
+		}
+		else if (0 == std::strcmp(pArg, "--output"))
+		{
+			pOutputFilePath = pValue;
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	// Console also gets logs so the report always goes to a file to keep it machine readable.
+	if (!pOutputFilePath)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	engine::Log::Init();
+
+	BenchmarkApp app(args);
+	app.Init();
+	app.Run();
+	app.RunScenarios();
+	bool success = app.WriteReport(pOutputFilePath);
+	app.Shutdown();
+	engine::MemoryTracker::ReportLeaks();
+
+	for (uint32_t tagIndex = 0U; tagIndex < static_cast<uint32_t>(engine::MemoryTag::Count); ++tagIndex)
+	{
+		engine::MemoryTag tag = static_cast<engine::MemoryTag>(tagIndex);
+		if (engine::MemoryTracker::IsOverBudget(tag))
+		{
+			engine::MemoryTagStats stats = engine::MemoryTracker::GetStats(tag);
+			std::printf("Memory budget exceeded : %s peak %llu bytes, budget %llu bytes\n", engine::MemoryTracker::GetTagName(tag),
+				static_cast<unsigned long long>(stats.peakBytes), static_cast<unsigned long long>(stats.budgetBytes));
+			success = false;
+		}
+	}
+
+	engine::Log::Shutdown();
+	return success ? 0 : 1;
+}
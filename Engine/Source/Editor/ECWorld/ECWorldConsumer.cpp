@@ -11,12 +11,14 @@
 #include "Rendering/Resources/ResourceContext.h"
 #include "Rendering/Resources/TextureResource.h"
 #include "Rendering/ShaderFeature.h"
+#include "Resources/CookedScene.h"
 #include "Resources/ResourceBuilder.h"
 #include "Resources/ResourceLoader.h"
 #include "Resources/ShaderBuilder.h"
 #include "Scene/SceneDatabase.h"
 
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
 
 namespace editor
@@ -34,57 +36,35 @@ void ECWorldConsumer::SetSceneDatabaseIDs(uint32_t nodeID, uint32_t meshID)
 }
 
 void ECWorldConsumer::Execute(const cd::SceneDatabase* pSceneDatabase)
+{
+	BeginExecute(pSceneDatabase);
+	ExecuteStep(UINT32_MAX);
+}
+
+void ECWorldConsumer::BeginExecute(const cd::SceneDatabase* pSceneDatabase)
 {
 	if (0U == pSceneDatabase->GetMeshCount())
 	{
 		CD_WARN("[ECWorldConsumer] No valid meshes in the consumed SceneDatabase.");
 	}
 
-	auto ParseMesh = [&](cd::MeshID meshID, const cd::Transform& tranform)
-	{
-		engine::Entity meshEntity = m_pSceneWorld->GetWorld()->CreateEntity();
-		AddTransform(meshEntity, tranform);
-
-		const auto& mesh = pSceneDatabase->GetMesh(meshID.Data());
-
-		bool hasBlendShape = mesh.GetBlendShapeIDCount() > 0U;
-		if (hasBlendShape)
-		{
-			assert(mesh.GetBlendShapeIDCount() == 1U);
-			AddBlendShape(meshEntity, &mesh, pSceneDatabase->GetBlendShape(mesh.GetBlendShapeID(0U).Data()), pSceneDatabase);
-		}
-
-		bool hasSkin = mesh.GetSkinIDCount() > 0U;
-		if (hasSkin)
-		{
-			engine::MaterialType* pMaterialType = m_pSceneWorld->GetAnimationMaterialType();
-			AddSkinMesh(meshEntity, mesh, pMaterialType->GetRequiredVertexFormat());
-
-			// TODO : Use a standalone .cdanim file to play animation.
-			// Currently, we assume that imported SkinMesh will play animation automatically for testing.
-			AddAnimation(meshEntity, pSceneDatabase->GetAnimation(0), pSceneDatabase);
-			AddMaterial(meshEntity, nullptr, pMaterialType, pSceneDatabase);
-		}
-		else
-		{
-			AddStaticMesh(meshEntity, mesh, m_pDefaultMaterialType->GetRequiredVertexFormat());
-
-			cd::MaterialID meshMaterialID = mesh.GetMaterialID(0U);
-			AddMaterial(meshEntity, meshMaterialID.IsValid() ? &pSceneDatabase->GetMaterial(meshMaterialID.Data()) : nullptr, m_pDefaultMaterialType, pSceneDatabase);
-		}
-	};
+	m_pSceneWorld->UpdateSceneDatabaseMemory();
+	m_pExecuteSceneDatabase = pSceneDatabase;
+	m_executeMeshIDs.clear();
+	m_executedMeshCount = 0U;
+	m_createdEntities.clear();
 
 	// Parse particle emitter and skip its mesh shapes.
 	std::set<cd::MeshID> parsedMeshIDs;
 	for (auto& particleEmitter : pSceneDatabase->GetParticleEmitters())
 	{
-		engine::Entity emitterEntity = m_pSceneWorld->GetWorld()->CreateEntity();
+		engine::Entity emitterEntity = CreateEntity();
 		const auto& mesh = pSceneDatabase->GetMesh(particleEmitter.GetMeshID().Data());
 		AddParticleEmitter(emitterEntity, mesh, m_pSceneWorld->GetParticleMaterialType()->GetRequiredVertexFormat(), particleEmitter);
 		parsedMeshIDs.insert(mesh.GetID());
 	}
 
-	// Parse meshes in normal usage.
+	// Collect meshes in normal usage.
 	for (const auto& mesh : pSceneDatabase->GetMeshes())
 	{
 		if (m_meshMinID > mesh.GetID().Data())
@@ -97,21 +77,177 @@ void ECWorldConsumer::Execute(const cd::SceneDatabase* pSceneDatabase)
 			continue;
 		}
 
-		ParseMesh(mesh.GetID(), cd::Transform::Identity());
+		m_executeMeshIDs.push_back(mesh.GetID());
 		parsedMeshIDs.insert(mesh.GetID().Data());
 	}
+}
+
+bool ECWorldConsumer::ExecuteStep(uint32_t maxMeshCount)
+{
+	if (!m_pExecuteSceneDatabase)
+	{
+		return true;
+	}
+
+	uint32_t meshCount = std::min(maxMeshCount, GetExecuteMeshCount() - m_executedMeshCount);
+	for (uint32_t meshIndex = 0U; meshIndex < meshCount; ++meshIndex)
+	{
+		ParseMesh(m_executeMeshIDs[m_executedMeshCount++], cd::Transform::Identity());
+	}
 
-	for (const auto& camera : pSceneDatabase->GetCameras())
+	if (m_executedMeshCount < GetExecuteMeshCount())
 	{
-		engine::Entity cameraEntity = m_pSceneWorld->GetWorld()->CreateEntity();
+		return false;
+	}
+
+	for (const auto& camera : m_pExecuteSceneDatabase->GetCameras())
+	{
+		engine::Entity cameraEntity = CreateEntity();
 		AddCamera(cameraEntity, camera);
 	}
 
-	for (const auto& light : pSceneDatabase->GetLights())
+	for (const auto& light : m_pExecuteSceneDatabase->GetLights())
 	{
-		engine::Entity lightEntity = m_pSceneWorld->GetWorld()->CreateEntity();
+		engine::Entity lightEntity = CreateEntity();
 		AddLight(lightEntity, light);
 	}
+
+	m_pExecuteSceneDatabase = nullptr;
+	return true;
+}
+
+engine::Entity ECWorldConsumer::CreateEntity()
+{
+	engine::Entity entity = m_pSceneWorld->GetWorld()->CreateEntity();
+	m_createdEntities.push_back(entity);
+	return entity;
+}
+
+void ECWorldConsumer::ParseMesh(cd::MeshID meshID, const cd::Transform& transform)
+{
+	const cd::SceneDatabase* pSceneDatabase = m_pExecuteSceneDatabase;
+	engine::Entity meshEntity = CreateEntity();
+	AddTransform(meshEntity, transform);
+
+	const auto& mesh = pSceneDatabase->GetMesh(meshID.Data());
+
+	bool hasBlendShape = mesh.GetBlendShapeIDCount() > 0U;
+	if (hasBlendShape)
+	{
+		assert(mesh.GetBlendShapeIDCount() == 1U);
+		AddBlendShape(meshEntity, &mesh, pSceneDatabase->GetBlendShape(mesh.GetBlendShapeID(0U).Data()), pSceneDatabase);
+	}
+
+	bool hasSkin = mesh.GetSkinIDCount() > 0U;
+	if (hasSkin)
+	{
+		engine::MaterialType* pMaterialType = m_pSceneWorld->GetAnimationMaterialType();
+		AddSkinMesh(meshEntity, mesh, pMaterialType->GetRequiredVertexFormat());
+
+		// TODO : Use a standalone .cdanim file to play animation.
+		// Currently, we assume that imported SkinMesh will play animation automatically for testing.
+		AddAnimation(meshEntity, pSceneDatabase->GetAnimation(0), pSceneDatabase);
+		AddMaterial(meshEntity, nullptr, pMaterialType, pSceneDatabase);
+	}
+	else
+	{
+		AddStaticMesh(meshEntity, mesh, m_pDefaultMaterialType->GetRequiredVertexFormat());
+
+		cd::MaterialID meshMaterialID = mesh.GetMaterialID(0U);
+		AddMaterial(meshEntity, meshMaterialID.IsValid() ? &pSceneDatabase->GetMaterial(meshMaterialID.Data()) : nullptr, m_pDefaultMaterialType, pSceneDatabase);
+	}
+}
+
+void ECWorldConsumer::ExecuteCookedScene(const engine::CookedScene* pCookedScene)
+{
+	m_createdEntities.clear();
+	engine::World* pWorld = m_pSceneWorld->GetWorld();
+	for (uint32_t meshIndex = 0U; meshIndex < pCookedScene->GetMeshCount(); ++meshIndex)
+	{
+		const engine::CookedSceneFormat::Mesh& cookedMesh = pCookedScene->GetMesh(meshIndex);
+		engine::Entity meshEntity = CreateEntity();
+		AddTransform(meshEntity, cd::Transform::Identity());
+
+		auto& nameComponent = pWorld->CreateComponent<engine::NameComponent>(meshEntity);
+		std::string meshName(pCookedScene->GetString(cookedMesh.nameOffset));
+		engine::StringCrc meshNameCrc(meshName);
+		nameComponent.SetName(cd::MoveTemp(meshName));
+
+		auto& collisionMeshComponent = pWorld->CreateComponent<engine::CollisionMeshComponent>(meshEntity);
+		collisionMeshComponent.SetType(engine::CollisonMeshType::AABB);
+		collisionMeshComponent.SetAABB(engine::CookedScene::GetAABB(cookedMesh));
+
+		auto& staticMeshComponent = pWorld->CreateComponent<engine::StaticMeshComponent>(meshEntity);
+		engine::MeshResource* pMeshResource = m_pResourceContext->AddMeshResource(meshNameCrc);
+		pMeshResource->SetCookedMesh(pCookedScene, meshIndex);
+		staticMeshComponent.SetMeshResource(pMeshResource);
+
+		AddCookedMaterial(meshEntity, pCookedScene, cookedMesh.materialIndex, m_pDefaultMaterialType);
+	}
+}
+
+void ECWorldConsumer::AddCookedMaterial(engine::Entity entity, const engine::CookedScene* pCookedScene, uint32_t materialIndex, engine::MaterialType* pMaterialType)
+{
+	using namespace engine::CookedSceneFormat;
+
+	engine::MaterialComponent& materialComponent = m_pSceneWorld->GetWorld()->CreateComponent<engine::MaterialComponent>(entity);
+	materialComponent.Init();
+	materialComponent.SetMaterialType(pMaterialType);
+	materialComponent.ActivateShaderFeature(engine::GetSkyTypeShaderFeature(m_pSceneWorld->GetSkyComponent(m_pSceneWorld->GetSkyEntity())->GetSkyType()));
+	if (InvalidIndex == materialIndex)
+	{
+		return;
+	}
+
+	const Material& cookedMaterial = pCookedScene->GetMaterial(materialIndex);
+	materialComponent.SetName(std::string(pCookedScene->GetString(cookedMaterial.nameOffset)));
+
+	if (cookedMaterial.flags & HasOcclusionFactor)
+	{
+		materialComponent.SetFactor(cd::MaterialPropertyGroup::Occlusion, cookedMaterial.occlusionFactor);
+	}
+	if (cookedMaterial.flags & HasRoughnessFactor)
+	{
+		materialComponent.SetFactor(cd::MaterialPropertyGroup::Roughness, cookedMaterial.roughnessFactor);
+	}
+	if (cookedMaterial.flags & HasMetallicFactor)
+	{
+		materialComponent.SetFactor(cd::MaterialPropertyGroup::Metallic, cookedMaterial.metallicFactor);
+	}
+	if (cookedMaterial.flags & HasTwoSided)
+	{
+		materialComponent.SetTwoSided(cookedMaterial.flags & TwoSided);
+	}
+	if (cookedMaterial.flags & HasBlendMode)
+	{
+		cd::BlendMode blendMode = static_cast<cd::BlendMode>(cookedMaterial.blendMode);
+		if (cd::BlendMode::Mask == blendMode)
+		{
+			materialComponent.SetAlphaCutOff(cookedMaterial.alphaCutOff);
+		}
+		materialComponent.SetBlendMode(blendMode);
+	}
+
+	// Textures are built by the cooker so only need to load dds files.
+	for (cd::MaterialTextureType optionalTextureType : pMaterialType->GetOptionalTextureTypes())
+	{
+		const Texture& cookedTexture = cookedMaterial.textures[static_cast<size_t>(optionalTextureType)];
+		if (InvalidIndex == cookedTexture.pathOffset)
+		{
+			continue;
+		}
+
+		std::string texturePath(pCookedScene->GetString(cookedTexture.pathOffset));
+		engine::TextureResource* pTextureResource = m_pResourceContext->AddTextureResource(engine::StringCrc(texturePath));
+		pTextureResource->UpdateTextureType(optionalTextureType);
+		pTextureResource->UpdateUVMapMode(static_cast<cd::TextureMapMode>(cookedTexture.uMapMode), static_cast<cd::TextureMapMode>(cookedTexture.vMapMode));
+		pTextureResource->SetDDSBuiltTexturePath(cd::MoveTemp(texturePath));
+
+		cd::Vec2f uvOffset(cookedTexture.uvOffset[0], cookedTexture.uvOffset[1]);
+		cd::Vec2f uvScale(cookedTexture.uvScale[0], cookedTexture.uvScale[1]);
+		materialComponent.SetTextureResource(optionalTextureType, uvOffset, uvScale, pTextureResource);
+		ApplyTexture(entity, optionalTextureType, pTextureResource);
+	}
 }
 
 void ECWorldConsumer::AddCamera(engine::Entity entity, const cd::Camera& camera)
@@ -176,12 +312,18 @@ void ECWorldConsumer::AddStaticMesh(engine::Entity entity, const cd::Mesh& mesh,
 	auto& collisionMeshComponent = pWorld->CreateComponent<engine::CollisionMeshComponent>(entity);
 	collisionMeshComponent.SetType(engine::CollisonMeshType::AABB);
 	collisionMeshComponent.SetAABB(mesh.GetAABB());
-	collisionMeshComponent.Build();
 
 	auto& staticMeshComponent = pWorld->CreateComponent<engine::StaticMeshComponent>(entity);
 	engine::MeshResource* pMeshResource = m_pResourceContext->AddMeshResource(meshNameCrc);
 	pMeshResource->SetMeshAsset(&mesh);
 	pMeshResource->UpdateVertexFormat(vertexFormat);
+	// Blend shape draws with its own vertex buffers and the mesh index buffer so vertex order must be kept.
+	// It also binds the index buffer as a static buffer so only pure static meshes go to the shared arena.
+	if (0U == mesh.GetBlendShapeIDCount() && 0U == mesh.GetSkinIDCount())
+	{
+		pMeshResource->SetOptimizeOptions(m_meshOptimizeOptions);
+		pMeshResource->SetMeshArena(m_pResourceContext->GetMeshArena());
+	}
 	staticMeshComponent.SetMeshResource(pMeshResource);
 }
 
@@ -206,7 +348,7 @@ void ECWorldConsumer::AddAnimation(engine::Entity entity, const cd::Animation& a
 void ECWorldConsumer::AddMaterial(engine::Entity entity, const cd::Material* pMaterial, engine::MaterialType* pMaterialType, const cd::SceneDatabase* pSceneDatabase)
 {
 	std::set<uint8_t> compiledTextureSlot;
-	std::vector<std::tuple<cd::MaterialTextureType, std::string, const cd::Texture*>> outputTypeToData;
+	std::vector<std::tuple<cd::MaterialTextureType, std::string, const cd::Texture*, std::shared_future<bool>>> outputTypeToData;
 
 	engine::MaterialComponent& materialComponent = m_pSceneWorld->GetWorld()->CreateComponent<engine::MaterialComponent>(entity);
 	materialComponent.Init();
@@ -233,13 +375,14 @@ void ECWorldConsumer::AddMaterial(engine::Entity entity, const cd::Material* pMa
 		uint8_t textureSlot = optTextureSlot.value();
 		const cd::Texture& optionalTexture = pSceneDatabase->GetTexture(textureID.Data());
 		std::string outputTexturePath = engine::Path::GetTextureOutputFilePath(optionalTexture.GetPath(), ".dds");
+		TaskHandle taskHandle = ResourceBuilder::InvalidHandle;
 		if (compiledTextureSlot.find(textureSlot) == compiledTextureSlot.end())
 		{
 			// TODO : Resource level
 			compiledTextureSlot.insert(textureSlot);
-			ResourceBuilder::Get().AddTextureBuildTask(optionalTextureType, optionalTexture.GetPath(), outputTexturePath.c_str());
+			taskHandle = ResourceBuilder::Get().AddTextureBuildTask(optionalTextureType, optionalTexture.GetPath(), outputTexturePath.c_str());
 		}
-		outputTypeToData.emplace_back(optionalTextureType, cd::MoveTemp(outputTexturePath), &optionalTexture);
+		outputTypeToData.emplace_back(optionalTextureType, cd::MoveTemp(outputTexturePath), &optionalTexture, ResourceBuilder::Get().GetTaskFuture(taskHandle));
 	}
 
 	// TODO : create material component before ResourceBuilder done.
@@ -282,16 +425,17 @@ void ECWorldConsumer::AddMaterial(engine::Entity entity, const cd::Material* pMa
 		materialComponent.SetBlendMode(blendMode);
 	}
 
-	// TODO : ResourceBuilder will move to EditorApp::Update in the future.
-	// Now let's wait all resource build tasks done here.
-	ResourceBuilder::Get().Update();
+	// In deferred mode, the caller dispatches build tasks in background and textures are applied when ready.
+	if (!m_deferTextureBuild)
+	{
+		ResourceBuilder::Get().Update();
+	}
 
 	// Textures.
-	for (const auto& [type, path, pTexture] : outputTypeToData)
+	for (auto& [type, path, pTexture, buildFuture] : outputTypeToData)
 	{
 		engine::TextureResource* pTextureResource = m_pResourceContext->AddTextureResource(engine::StringCrc(path));
 		pTextureResource->SetTextureAsset(pTexture);
-		pTextureResource->SetDDSBuiltTexturePath(path);
 		pTextureResource->UpdateTextureType(type);
 		pTextureResource->UpdateUVMapMode(pTexture->GetUMapMode(), pTexture->GetVMapMode());
 
@@ -307,14 +451,66 @@ void ECWorldConsumer::AddMaterial(engine::Entity entity, const cd::Material* pMa
 		}
 		materialComponent.SetTextureResource(type, uvOffset, uvScale, pTextureResource);
 
-		if (auto pPropertyGroup = materialComponent.GetPropertyGroup(type); pPropertyGroup)
+		if (m_deferTextureBuild)
 		{
-			pPropertyGroup->useTexture = true;
-			materialComponent.ActivateShaderFeature(engine::MaterialTextureTypeToShaderFeature.at(type));
+			// Keep the factor as a placeholder until texture is built.
+			if (auto pPropertyGroup = materialComponent.GetPropertyGroup(type); pPropertyGroup)
+			{
+				pPropertyGroup->useTexture = false;
+			}
+			m_pendingTextures.push_back(PendingTexture{ entity, type, pTextureResource, cd::MoveTemp(path), cd::MoveTemp(buildFuture) });
 		}
+		else
+		{
+			pTextureResource->SetDDSBuiltTexturePath(path);
+			ApplyTexture(entity, type, pTextureResource);
+		}
+	}
+}
+
+void ECWorldConsumer::ApplyTexture(engine::Entity entity, cd::MaterialTextureType textureType, engine::TextureResource* pTextureResource)
+{
+	engine::MaterialComponent* pMaterialComponent = m_pSceneWorld->GetMaterialComponent(entity);
+	if (!pMaterialComponent)
+	{
+		return;
+	}
+
+	if (auto pPropertyGroup = pMaterialComponent->GetPropertyGroup(textureType); pPropertyGroup)
+	{
+		pPropertyGroup->useTexture = true;
+		pMaterialComponent->ActivateShaderFeature(engine::MaterialTextureTypeToShaderFeature.at(textureType));
 	}
 }
 
+bool ECWorldConsumer::UpdatePendingTextures()
+{
+	std::erase_if(m_pendingTextures, [this](PendingTexture& pendingTexture)
+	{
+		if (pendingTexture.buildFuture.valid() &&
+			std::future_status::ready != pendingTexture.buildFuture.wait_for(std::chrono::seconds(0)))
+		{
+			return false;
+		}
+
+		if (pendingTexture.buildFuture.valid() && !pendingTexture.buildFuture.get())
+		{
+			CD_ERROR("Failed to build texture {0}.", pendingTexture.outputTexturePath);
+			return true;
+		}
+
+		// Entity may be deleted by user during the texture build.
+		if (m_pSceneWorld->GetMaterialComponent(pendingTexture.entity))
+		{
+			pendingTexture.pTextureResource->SetDDSBuiltTexturePath(pendingTexture.outputTexturePath);
+			ApplyTexture(pendingTexture.entity, pendingTexture.textureType, pendingTexture.pTextureResource);
+		}
+		return true;
+	});
+
+	return m_pendingTextures.empty();
+}
+
 void ECWorldConsumer::AddBlendShape(engine::Entity entity, const cd::Mesh* pMesh, const cd::BlendShape& blendShape, const cd::SceneDatabase* pSceneDatabase)
 {
 	engine::World* pWorld = m_pSceneWorld->GetWorld();
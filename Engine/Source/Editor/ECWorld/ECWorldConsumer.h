@@ -5,9 +5,11 @@
 #include "Framework/IConsumer.h"
 #include "Material/ShaderSchema.h"
 #include "Math/Transform.hpp"
+#include "Rendering/Utility/MeshOptimizer.h"
 #include "Scene/MaterialTextureType.h"
 #include "Scene/ObjectID.h"
 
+#include <future>
 #include <map>
 #include <memory>
 #include <set>
@@ -35,11 +37,13 @@ class VertexFormat;
 namespace engine
 {
 
+class CookedScene;
 class MaterialComponent;
 class MaterialType;
 class RenderContext;
 class ResourceContext;
 class SceneWorld;
+class TextureResource;
 
 }
 
@@ -59,8 +63,27 @@ public:
 
 	void SetDefaultMaterialType(engine::MaterialType* pMaterialType) { m_pDefaultMaterialType = pMaterialType; }
 	void SetSceneDatabaseIDs(uint32_t nodeID, uint32_t meshID);
+	void SetMeshOptimizeOptions(const engine::MeshOptimizeOptions& options) { m_meshOptimizeOptions = options; }
 	virtual void Execute(const cd::SceneDatabase* pSceneDatabase) override;
 
+	// Execute can also be split into steps so that entity creation is spread across frames.
+	// ExecuteStep returns true when all entities are created.
+	void BeginExecute(const cd::SceneDatabase* pSceneDatabase);
+	bool ExecuteStep(uint32_t maxMeshCount);
+	uint32_t GetExecuteMeshCount() const { return static_cast<uint32_t>(m_executeMeshIDs.size()); }
+	uint32_t GetExecutedMeshCount() const { return m_executedMeshCount; }
+	const std::vector<engine::Entity>& GetCreatedEntities() const { return m_createdEntities; }
+
+	// By default, AddMaterial waits until textures are built. When deferred, materials are drawn with factors
+	// as placeholders and textures are applied in UpdatePendingTextures after their build tasks finished.
+	void SetDeferTextureBuild(bool defer) { m_deferTextureBuild = defer; }
+	// Returns true when there is no pending texture.
+	bool UpdatePendingTextures();
+	uint32_t GetPendingTextureCount() const { return static_cast<uint32_t>(m_pendingTextures.size()); }
+
+	// Creates static mesh entities from a mapped cooked scene. Vertex/Index streams and textures are already built.
+	void ExecuteCookedScene(const engine::CookedScene* pCookedScene);
+
 private:
 	void AddCamera(engine::Entity entity, const cd::Camera& camera);
 	void AddLight(engine::Entity entity, const cd::Light& light);
@@ -71,14 +94,39 @@ private:
 	void AddMaterial(engine::Entity entity, const cd::Material* pMaterial, engine::MaterialType* pMaterialType, const cd::SceneDatabase* pSceneDatabase);
 	void AddBlendShape(engine::Entity entity, const cd::Mesh* pMesh, const cd::BlendShape& blendShape, const cd::SceneDatabase* pSceneDatabase);
 	void AddParticleEmitter(engine::Entity entity, const cd::Mesh& mesh, const cd::VertexFormat& vertexFormat, const cd::ParticleEmitter& emitter);
+	void AddCookedMaterial(engine::Entity entity, const engine::CookedScene* pCookedScene, uint32_t materialIndex, engine::MaterialType* pMaterialType);
+	void ParseMesh(cd::MeshID meshID, const cd::Transform& transform);
+	engine::Entity CreateEntity();
+	void ApplyTexture(engine::Entity entity, cd::MaterialTextureType textureType, engine::TextureResource* pTextureResource);
+
 private:
+	struct PendingTexture
+	{
+		engine::Entity entity;
+		cd::MaterialTextureType textureType;
+		engine::TextureResource* pTextureResource;
+		std::string outputTexturePath;
+		// Invalid when the built texture is already up to date.
+		std::shared_future<bool> buildFuture;
+	};
+
 	engine::MaterialType* m_pDefaultMaterialType = nullptr;
 	engine::SceneWorld* m_pSceneWorld = nullptr;
 	engine::RenderContext* m_pRenderContext = nullptr;
 	engine::ResourceContext* m_pResourceContext = nullptr;
 
+	engine::MeshOptimizeOptions m_meshOptimizeOptions;
+
 	uint32_t m_nodeMinID;
 	uint32_t m_meshMinID;
+
+	const cd::SceneDatabase* m_pExecuteSceneDatabase = nullptr;
+	std::vector<cd::MeshID> m_executeMeshIDs;
+	uint32_t m_executedMeshCount = 0U;
+	std::vector<engine::Entity> m_createdEntities;
+
+	bool m_deferTextureBuild = false;
+	std::vector<PendingTexture> m_pendingTextures;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "ModelImportJob.h"
+
+#include "Consumers/CDConsumer/CDConsumer.h"
+#include "ECWorld/ECWorldConsumer.h"
+#include "ECWorld/SceneWorld.h"
+#include "Framework/Processor.h"
+#include "Log/Log.h"
+#include "Producers/CDProducer/CDProducer.h"
+#include "Resources/ResourceBuilder.h"
+#include "Scene/SceneDatabase.h"
+
+#ifdef ENABLE_GENERIC_PRODUCER
+#include "Producers/GenericProducer/GenericProducer.h"
+#endif
+
+#include <filesystem>
+
+namespace editor
+{
+
+ModelImportJob::ModelImportJob(std::string filePath, std::string exportFolderPath, AssetImportOptions options) :
+	m_filePath(cd::MoveTemp(filePath)),
+	m_exportFolderPath(cd::MoveTemp(exportFolderPath)),
+	m_options(cd::MoveTemp(options))
+{
+}
+
+ModelImportJob::~ModelImportJob()
+{
+	m_cancelRequested = true;
+
+	if (m_produceThread.joinable())
+	{
+		m_produceThread.join();
+	}
+}
+
+void ModelImportJob::Start(engine::SceneWorld* pSceneWorld, engine::RenderContext* pRenderContext, engine::MaterialType* pDefaultMaterialType)
+{
+	m_pSceneWorld = pSceneWorld;
+	m_pRenderContext = pRenderContext;
+	m_pDefaultMaterialType = pDefaultMaterialType;
+
+	CD_INFO("Start to import {0}.", m_filePath);
+	m_stage = ModelImportStage::Producing;
+	m_pImportedSceneDatabase = std::make_unique<cd::SceneDatabase>();
+	m_produceThread = std::thread(&ModelImportJob::ProduceMain, this);
+}
+
+void ModelImportJob::ProduceMain()
+{
+	// Step 1 : Convert model file to cd::SceneDatabase
+	std::filesystem::path inputFileExtension = std::filesystem::path(m_filePath).extension();
+	if (0 == inputFileExtension.compare(".cdbin"))
+	{
+		cdtools::CDProducer cdProducer(m_filePath.c_str());
+		cdtools::Processor processor(&cdProducer, nullptr, m_pImportedSceneDatabase.get());
+		processor.Run();
+	}
+	else
+	{
+#ifdef ENABLE_GENERIC_PRODUCER
+		cdtools::GenericProducer genericProducer(m_filePath.c_str());
+		genericProducer.EnableOption(cdtools::GenericProducerOptions::GenerateBoundingBox);
+		genericProducer.EnableOption(cdtools::GenericProducerOptions::CleanUnusedObjects);
+		genericProducer.EnableOption(cdtools::GenericProducerOptions::GenerateTangentSpace);
+		genericProducer.EnableOption(cdtools::GenericProducerOptions::TriangulateModel);
+		if (!m_options.ImportAnimation)
+		{
+			genericProducer.EnableOption(cdtools::GenericProducerOptions::FlattenTransformHierarchy);
+		}
+
+		cdtools::Processor processor(&genericProducer, nullptr, m_pImportedSceneDatabase.get());
+		processor.EnableOption(cdtools::ProcessorOptions::Dump);
+		processor.Run();
+#else
+		CD_ERROR("Unable to import file format {0}.", inputFileExtension.generic_string());
+		m_produceFinished = true;
+		return;
+#endif
+	}
+
+	if (m_cancelRequested)
+	{
+		m_produceFinished = true;
+		return;
+	}
+
+	// Step 2 : Process generated cd::SceneDatabase
+	AssetBrowser::ProcessSceneDatabase(m_pImportedSceneDatabase.get(), m_options.ImportMesh, m_options.ImportMaterial, m_options.ImportTexture,
+		m_options.ImportCamera, m_options.ImportLight);
+
+	// Step 3 : Convert imported cd::SceneDatabase to cd asset files and save in disk
+	if (!m_cancelRequested)
+	{
+		cdtools::CDConsumer cdConsumer(m_exportFolderPath.c_str());
+		cdConsumer.SetExportMode(cdtools::ExportMode::XmlBinary);
+		cdtools::Processor processor(nullptr, &cdConsumer, m_pImportedSceneDatabase.get());
+		processor.DisableOption(cdtools::ProcessorOptions::Dump);
+		processor.Run();
+	}
+
+	m_produceSucceeded = true;
+	m_produceFinished = true;
+}
+
+void ModelImportJob::CommitSceneDatabase()
+{
+	// Merge in the main thread as resources and components refer to data inside the scene database.
+	cd::SceneDatabase* pSceneDatabase = m_pSceneWorld->GetSceneDatabase();
+	uint32_t oldNodeCount = pSceneDatabase->GetNodeCount();
+	uint32_t oldMeshCount = pSceneDatabase->GetMeshCount();
+	pSceneDatabase->Merge(cd::MoveTemp(*m_pImportedSceneDatabase));
+	m_pImportedSceneDatabase.reset();
+
+	// Step 4 : Convert cd::SceneDatabase to entities and components
+	m_pECWorldConsumer = std::make_unique<ECWorldConsumer>(m_pSceneWorld, m_pRenderContext);
+	m_pECWorldConsumer->SetDefaultMaterialType(m_pDefaultMaterialType);
+	m_pECWorldConsumer->SetSceneDatabaseIDs(oldNodeCount, oldMeshCount);
+	m_pECWorldConsumer->SetDeferTextureBuild(true);
+	if (m_options.OptimizeMesh)
+	{
+		m_pECWorldConsumer->SetMeshOptimizeOptions(engine::MeshOptimizeOptions::All());
+	}
+	m_pECWorldConsumer->BeginExecute(pSceneDatabase);
+}
+
+void ModelImportJob::RemoveCreatedEntities()
+{
+	for (engine::Entity entity : m_pECWorldConsumer->GetCreatedEntities())
+	{
+		m_pSceneWorld->DeleteEntity(entity);
+	}
+}
+
+bool ModelImportJob::Update()
+{
+	switch (m_stage)
+	{
+	case ModelImportStage::Producing:
+	{
+		if (!m_produceFinished)
+		{
+			break;
+		}
+
+		m_produceThread.join();
+		if (m_cancelRequested)
+		{
+			m_stage = ModelImportStage::Cancelled;
+			break;
+		}
+
+		if (!m_produceSucceeded)
+		{
+			m_stage = ModelImportStage::Failed;
+			break;
+		}
+
+		CommitSceneDatabase();
+		m_stage = ModelImportStage::CreatingEntities;
+		break;
+	}
+	case ModelImportStage::CreatingEntities:
+	{
+		if (m_cancelRequested)
+		{
+			RemoveCreatedEntities();
+			m_stage = ModelImportStage::Cancelled;
+			break;
+		}
+
+		if (!m_pECWorldConsumer->ExecuteStep(MeshCountPerFrame))
+		{
+			break;
+		}
+
+		// Texture build tasks are queued during entity creation. ResourceBuilder workers run them in background
+		// and pending textures are applied when their futures are ready, so cancelling doesn't wait for running builds.
+		m_textureCount = m_pECWorldConsumer->GetPendingTextureCount();
+		if (m_textureCount > 0U)
+		{
+			ResourceBuilder::Get().Dispatch();
+		}
+		m_stage = ModelImportStage::BuildingTextures;
+		break;
+	}
+	case ModelImportStage::BuildingTextures:
+	{
+		if (m_cancelRequested)
+		{
+			m_stage = ModelImportStage::Cancelled;
+			break;
+		}
+
+		if (m_pECWorldConsumer->UpdatePendingTextures())
+		{
+			CD_INFO("Finish importing {0}.", m_filePath);
+			m_stage = ModelImportStage::Finished;
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	return ModelImportStage::Finished == m_stage || ModelImportStage::Cancelled == m_stage || ModelImportStage::Failed == m_stage;
+}
+
+const char* ModelImportJob::GetStageName() const
+{
+	switch (m_stage)
+	{
+	case ModelImportStage::Producing:
+		return "Reading model file";
+	case ModelImportStage::CreatingEntities:
+		return "Creating entities";
+	case ModelImportStage::BuildingTextures:
+		return "Building textures";
+	case ModelImportStage::Finished:
+		return "Finished";
+	case ModelImportStage::Cancelled:
+		return "Cancelled";
+	default:
+		return "Failed";
+	}
+}
+
+float ModelImportJob::GetProgress() const
+{
+	// Producer doesn't report progress so the first stage is counted as a fixed part.
+	constexpr float produceWeight = 0.4f;
+	constexpr float entityWeight = 0.3f;
+	constexpr float textureWeight = 1.0f - produceWeight - entityWeight;
+
+	switch (m_stage)
+	{
+	case ModelImportStage::Producing:
+		return 0.0f;
+	case ModelImportStage::CreatingEntities:
+	{
+		uint32_t meshCount = m_pECWorldConsumer->GetExecuteMeshCount();
+		float entityProgress = meshCount > 0U ? static_cast<float>(m_pECWorldConsumer->GetExecutedMeshCount()) / static_cast<float>(meshCount) : 1.0f;
+		return produceWeight + entityWeight * entityProgress;
+	}
+	case ModelImportStage::BuildingTextures:
+	{
+		float textureProgress = m_textureCount > 0U ?
+			1.0f - static_cast<float>(m_pECWorldConsumer->GetPendingTextureCount()) / static_cast<float>(m_textureCount) : 1.0f;
+		return produceWeight + entityWeight + textureWeight * textureProgress;
+	}
+	default:
+		return 1.0f;
+	}
+}
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "UILayers/AssetBrowser.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace cd
+{
+
+class SceneDatabase;
+
+}
+
+namespace engine
+{
+
+class MaterialType;
+class RenderContext;
+class SceneWorld;
+
+}
+
+namespace editor
+{
+
+class ECWorldConsumer;
+
+enum class ModelImportStage
+{
+	Producing,
+	CreatingEntities,
+	BuildingTextures,
+	Finished,
+	Cancelled,
+	Failed,
+};
+
+// ModelImportJob imports a model file without blocking the UI thread.
+// Producing, processing and exporting the imported SceneDatabase run in a worker thread.
+// Then entities are created in the main thread in small batches per frame. Materials are drawn with
+// factors as placeholders until their textures are built in background.
+class ModelImportJob final
+{
+public:
+	static constexpr uint32_t MeshCountPerFrame = 16U;
+
+public:
+	ModelImportJob() = delete;
+	explicit ModelImportJob(std::string filePath, std::string exportFolderPath, AssetImportOptions options);
+	ModelImportJob(const ModelImportJob&) = delete;
+	ModelImportJob& operator=(const ModelImportJob&) = delete;
+	ModelImportJob(ModelImportJob&&) = delete;
+	ModelImportJob& operator=(ModelImportJob&&) = delete;
+	~ModelImportJob();
+
+	void Start(engine::SceneWorld* pSceneWorld, engine::RenderContext* pRenderContext, engine::MaterialType* pDefaultMaterialType);
+
+	// Called in the main thread every frame. Returns true when the job is finished, cancelled or failed.
+	bool Update();
+
+	// Cancellation is checked between steps. Entities which are already created are removed
+	// if entity creation is not finished. Textures which are queued keep building.
+	void Cancel() { m_cancelRequested = true; }
+	bool IsCancelRequested() const { return m_cancelRequested; }
+
+	ModelImportStage GetStage() const { return m_stage; }
+	const char* GetStageName() const;
+	float GetProgress() const;
+	const std::string& GetFilePath() const { return m_filePath; }
+
+private:
+	void ProduceMain();
+	void CommitSceneDatabase();
+	void RemoveCreatedEntities();
+
+private:
+	std::string m_filePath;
+	std::string m_exportFolderPath;
+	AssetImportOptions m_options;
+
+	engine::SceneWorld* m_pSceneWorld = nullptr;
+	engine::RenderContext* m_pRenderContext = nullptr;
+	engine::MaterialType* m_pDefaultMaterialType = nullptr;
+
+	ModelImportStage m_stage = ModelImportStage::Producing;
+	std::atomic<bool> m_cancelRequested = false;
+	std::atomic<bool> m_produceFinished = false;
+	bool m_produceSucceeded = false;
+	std::thread m_produceThread;
+
+	std::unique_ptr<cd::SceneDatabase> m_pImportedSceneDatabase;
+	std::unique_ptr<ECWorldConsumer> m_pECWorldConsumer;
+	uint32_t m_textureCount = 0U;
+};
+
+}
@@ -1,16 +1,19 @@
 ﻿#include "EditorApp.h"
 
 #include "Application/Engine.h"
+#include "Application/FramePipeline.h"
 #include "Display/CameraController.h"
 #include "ECWorld/SceneWorld.h"
 #include "ImGui/EditorImGuiViewport.h"
 #include "ImGui/ImGuiContextInstance.h"
 #include "ImGui/Localization.h"
 #include "ImGui/UILayers/DebugPanel.h"
+#include "ImGui/UILayers/MemoryPanel.h"
 #include "ImGui/UILayers/Profiler.h"
 #include "Log/Log.h"
 #include "Math/MeshGenerator.h"
 #include "Path/Path.h"
+#include "Profiling/Profiling.h"
 #include "Rendering/AABBRenderer.h"
 #include "Rendering/AnimationRenderer.h"
 #include "Rendering/BlendShapeRenderer.h"
@@ -25,6 +28,7 @@
 #include "Rendering/BloomRenderer.h"
 #include "Rendering/PostProcessRenderer.h"
 #include "Rendering/RenderContext.h"
+#include "Rendering/RenderSnapshot.h"
 #include "Rendering/Resources/MeshResource.h"
 #include "Rendering/Resources/ResourceContext.h"
 #include "Rendering/SkeletonRenderer.h"
@@ -50,6 +54,7 @@
 #include "UILayers/SkeletonView.h"
 #include "UILayers/Splash.h"
 #include "UILayers/TestNodeEditor.h"
+#include "Undo/UndoJournal.h"
 #include "Window/Input.h"
 #include "Window/Window.h"
 
@@ -103,17 +108,16 @@ void EditorApp::Init(engine::EngineInitArgs initArgs)
 	InitECWorld();
 	m_pEditorImGuiContext->SetSceneWorld(m_pSceneWorld.get());
 
+	m_pFramePipeline = std::make_unique<engine::FramePipeline>();
+	m_pFramePipeline->m_onSimulate.Bind<editor::EditorApp, &editor::EditorApp::Simulate>(this);
+
 	InitEngineRenderers();
 
-	// Add shader build tasks and create a thread to update tasks.
+	// Add shader build tasks and build them in ResourceBuilder workers.
 	InitShaderPrograms(initArgs.compileAllShaders);
 	m_pEditorImGuiContext->AddStaticLayer(std::make_unique<Splash>("Splash"));
 
-	std::thread resourceThread([]()
-	{
-		ResourceBuilder::Get().Update(false, true);
-	});
-	resourceThread.detach();
+	ResourceBuilder::Get().Dispatch(false, true);
 
 	InitFileWatcher();
 }
@@ -163,9 +167,13 @@ void EditorApp::InitEditorUILayers()
 {
 	InitEditorController();
 
+	m_pUndoJournal = std::make_unique<UndoJournal>();
+	m_pTerrainStroke = std::make_unique<TerrainStroke>();
+
 	// Add UI layers after finish imgui and rendering contexts' initialization.
 	auto pMainMenu = std::make_unique<MainMenu>("MainMenu");
 	pMainMenu->SetCameraController(m_pViewportCameraController.get());
+	pMainMenu->SetUndoJournal(m_pUndoJournal.get());
 	m_pEditorImGuiContext->AddStaticLayer(cd::MoveTemp(pMainMenu));
 
 	auto pEntityList = std::make_unique<EntityList>("EntityList");
@@ -185,7 +193,11 @@ void EditorApp::InitEditorUILayers()
 
 	m_pEditorImGuiContext->AddDynamicLayer(std::make_unique<SkeletonView>("SkeletonView"));
 	m_pEditorImGuiContext->AddDynamicLayer(std::make_unique<engine::Profiler>("Profiler"));
-	m_pEditorImGuiContext->AddDynamicLayer(std::make_unique<Inspector>("Inspector"));
+	m_pEditorImGuiContext->AddDynamicLayer(std::make_unique<engine::MemoryPanel>("MemoryPanel"));
+
+	auto pInspector = std::make_unique<Inspector>("Inspector");
+	pInspector->SetUndoJournal(m_pUndoJournal.get());
+	m_pEditorImGuiContext->AddDynamicLayer(cd::MoveTemp(pInspector));
 
 	auto pAssetBrowser = std::make_unique<AssetBrowser>("AssetBrowser");
 	pAssetBrowser->SetSceneRenderer(m_pSceneRenderer);
@@ -217,6 +229,7 @@ void EditorApp::InitEngineUILayers()
 	
 	auto pImGuizmoView = std::make_unique<editor::ImGuizmoView>("ImGuizmoView");
 	pImGuizmoView->SetSceneView(m_pSceneView);
+	pImGuizmoView->SetUndoJournal(m_pUndoJournal.get());
 	m_pEngineImGuiContext->AddDynamicLayer(cd::MoveTemp(pImGuizmoView));
 	//m_pEngineImGuiContext->AddDynamicLayer(std::make_unique<TestNodeEditor>("TestNodeEditor"));
 }
@@ -394,6 +407,7 @@ void EditorApp::OnShaderHotModifiedCallback(const char* rootDir, const char* fil
 
 void EditorApp::UpdateMaterials()
 {
+	CD_PROFILE_SCOPE("EditorApp::UpdateMaterials");
 	for (engine::Entity entity : m_pSceneWorld->GetMaterialEntities())
 	{
 		engine::MaterialComponent* pMaterialComponent = m_pSceneWorld->GetMaterialComponent(entity);
@@ -423,6 +437,7 @@ void EditorApp::UpdateMaterials()
 
 void EditorApp::CompileAndLoadShaders()
 {
+	CD_PROFILE_SCOPE("EditorApp::CompileAndLoadShaders");
 	// 1. Compile
 	TaskOutputCallbacks cb;
 	cb.onErrorOutput.Bind<editor::EditorApp, &editor::EditorApp::OnShaderCompileFailed>(this);
@@ -431,7 +446,16 @@ void EditorApp::CompileAndLoadShaders()
 	// 2. Load
 	if (!m_pRenderContext->GetShaderCompileInfos().empty())
 	{
-		ResourceBuilder::Get().Update(false, true);
+		// Only wait for shaders. Other tasks such as textures of model imports keep building in background.
+		std::vector<TaskHandle> taskHandles;
+		{
+			std::lock_guard<std::mutex> lock(m_shaderCompileFailedMutex);
+			for (const auto& info : m_pRenderContext->GetShaderCompileInfos())
+			{
+				taskHandles.insert(taskHandles.end(), info.m_taskHandles.begin(), info.m_taskHandles.end());
+			}
+		}
+		ResourceBuilder::Get().Wait(taskHandles, false, true);
 
 		for (const auto& info : m_pRenderContext->GetShaderCompileInfos())
 		{
@@ -455,6 +479,7 @@ void EditorApp::CompileAndLoadShaders()
 
 void EditorApp::OnShaderCompileFailed(uint32_t handle, std::span<const char> str)
 {
+	std::lock_guard<std::mutex> lock(m_shaderCompileFailedMutex);
 	auto& infos = m_pRenderContext->GetShaderCompileInfos();
 	auto it = infos.begin();
 
@@ -485,7 +510,7 @@ void EditorApp::InitRenderContext(engine::GraphicsBackend backend, void* hwnd)
 	m_pRenderContext->Init(backend, hwnd);
 	engine::Renderer::SetRenderContext(m_pRenderContext.get());
 
-	m_pResourceContext = std::make_unique<engine::ResourceContext>();
+	m_pResourceContext = std::make_unique<engine::ResourceContext>(m_pRenderContext->GetGPUResourceRegistry());
 	m_pRenderContext->SetResourceContext(m_pResourceContext.get());
 
 	m_pShaderCollections = std::make_unique<engine::ShaderCollections>();
@@ -705,26 +730,15 @@ bool EditorApp::Update(float deltaTime)
 	GetMainWindow()->Update();
 	m_crtInputFocus = GetMainWindow()->GetInputFocus();
 	m_pEditorImGuiContext->Update(deltaTime);
-	m_pSceneWorld->Update();
+#ifdef ENABLE_DDGI
+	m_pSceneWorld->UpdateDDGI();
+#endif
 
 	engine::CameraComponent* pMainCameraComponent = m_pSceneWorld->GetCameraComponent(m_pSceneWorld->GetMainCameraEntity());
 	engine::TerrainComponent* pTerrainComponent = m_pSceneWorld->GetTerrainComponent(m_pSceneWorld->GetSelectedEntity());
 	assert(pMainCameraComponent);
 	pMainCameraComponent->BuildProjectMatrix();
 
-	m_pResourceContext->Update();
-	m_pRenderContext->BeginFrame();
-	for (std::unique_ptr<engine::Renderer>& pRenderer : m_pEditorRenderers)
-	{
-		if (pRenderer->IsEnable())
-		{
-			const float* pViewMatrix = nullptr;
-			const float* pProjectionMatrix = nullptr;
-			pRenderer->UpdateView(pViewMatrix, pProjectionMatrix);
-			pRenderer->Render(deltaTime);
-		}
-	}
-
 	if (m_pEngineImGuiContext)
 	{
 		GetMainWindow()->SetMouseVisible(m_pSceneView->IsShowMouse(), m_pSceneView->GetMouseFixedPositionX(), m_pSceneView->GetMouseFixedPositionY());
@@ -743,8 +757,28 @@ bool EditorApp::Update(float deltaTime)
 			engine::TransformComponent* pCameraTransformComponent = m_pSceneWorld->GetTransformComponent(m_pSceneWorld->GetMainCameraEntity());
 			cd::Vec3f camPos = pCameraTransformComponent->GetTransform().GetTranslation();
 
-			pTerrainComponent->ScreenSpaceSmooth(screenSpaceX, screenSpaceY, pMainCameraComponent->GetProjectionMatrix().Inverse(),
-				pMainCameraComponent->GetViewMatrix().Inverse(), camPos);
+			// Selecting another terrain while the button is still down starts a new stroke.
+			engine::Entity terrainEntity = m_pSceneWorld->GetSelectedEntity();
+			if (m_pTerrainStroke->IsActive() && m_pTerrainStroke->GetEntity() != terrainEntity)
+			{
+				m_pTerrainStroke->Commit(*m_pUndoJournal, *m_pSceneWorld);
+			}
+
+			uint16_t posX;
+			uint16_t posZ;
+			if (pTerrainComponent->ScreenSpacePick(screenSpaceX, screenSpaceY, pMainCameraComponent->GetProjectionMatrix().Inverse(),
+				pMainCameraComponent->GetViewMatrix().Inverse(), camPos, posX, posZ))
+			{
+				if (auto optBrushRect = pTerrainComponent->GetBrushRect(posX, posZ, engine::TerrainComponent::SmoothBrushSize); optBrushRect.has_value())
+				{
+					m_pTerrainStroke->Extend(terrainEntity, *pTerrainComponent, optBrushRect.value());
+					pTerrainComponent->SmoothElevationRawDataAround(posX, posZ, engine::TerrainComponent::SmoothBrushSize, engine::TerrainComponent::SmoothBrushPower);
+				}
+			}
+		}
+		else
+		{
+			m_pTerrainStroke->Commit(*m_pUndoJournal, *m_pSceneWorld);
 		}
 
 		m_pEngineImGuiContext->SetWindowPosOffset(m_pSceneView->GetWindowPosX(), m_pSceneView->GetWindowPosY());
@@ -752,13 +786,43 @@ bool EditorApp::Update(float deltaTime)
 
 		UpdateMaterials();
 		CompileAndLoadShaders();
+	}
+
+	m_pResourceContext->Update();
+
+	// Other states of the snapshot are one frame behind, but camera of this frame is taken after camera controller
+	// so that camera input doesn't get an extra frame of latency.
+	engine::RenderSnapshot& renderSnapshot = m_pFramePipeline->GetRenderSnapshot();
+	renderSnapshot.CaptureCamera(*m_pSceneWorld);
+
+	// Simulation captures frame N from components while frame N - 1 is submitted from the previous snapshot.
+	// Components must not be edited from here until EndSimulation.
+	m_pFramePipeline->BeginSimulation(deltaTime);
+
+	m_pRenderContext->SetRenderSnapshot(&renderSnapshot);
+	m_pRenderContext->BeginFrame();
+	for (std::unique_ptr<engine::Renderer>& pRenderer : m_pEditorRenderers)
+	{
+		if (pRenderer->IsEnable())
+		{
+			CD_PROFILE_SCOPE_DYNAMIC(pRenderer->GetName());
+			const float* pViewMatrix = nullptr;
+			const float* pProjectionMatrix = nullptr;
+			pRenderer->UpdateView(pViewMatrix, pProjectionMatrix);
+			pRenderer->Render(deltaTime);
+		}
+	}
 
+	if (m_pEngineImGuiContext)
+	{
+		const engine::RenderSnapshotCamera& snapshotCamera = renderSnapshot.GetCamera();
 		for (std::unique_ptr<engine::Renderer>& pRenderer : m_pEngineRenderers)
 		{
 			if (pRenderer->IsEnable())
 			{
-				const float* pViewMatrix = pMainCameraComponent->GetViewMatrix().begin();
-				const float* pProjectionMatrix = pMainCameraComponent->GetProjectionMatrix().begin();
+				CD_PROFILE_SCOPE_DYNAMIC(pRenderer->GetName());
+				const float* pViewMatrix = snapshotCamera.viewMatrix.begin();
+				const float* pProjectionMatrix = snapshotCamera.projectionMatrix.begin();
 				pRenderer->UpdateView(pViewMatrix, pProjectionMatrix);
 				pRenderer->Render(deltaTime);
 			}
@@ -766,6 +830,7 @@ bool EditorApp::Update(float deltaTime)
 	}
 
 	m_pRenderContext->EndFrame();
+	m_pFramePipeline->EndSimulation();
 
 	engine::Input::Get().FlushInputs();
 
@@ -774,4 +839,10 @@ bool EditorApp::Update(float deltaTime)
 	return !GetMainWindow()->ShouldClose();
 }
 
+void EditorApp::Simulate(engine::RenderSnapshot& snapshot, uint64_t frameIndex, float deltaTime)
+{
+	m_pSceneWorld->Update(deltaTime);
+	snapshot.Capture(*m_pSceneWorld, frameIndex);
+}
+
 }
@@ -3,6 +3,7 @@
 #include "Application/IApplication.h"
 
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <span>
 
@@ -11,10 +12,12 @@ namespace engine
 
 class CameraController;
 class FlybyCamera;
+class FramePipeline;
 class ImGuiBaseLayer;
 class ImGuiContextInstance;
 class Window;
 class RenderContext;
+class RenderSnapshot;
 class Renderer;
 class ResourceContext;
 class AABBRenderer;
@@ -32,6 +35,8 @@ namespace editor
 class EditorImGuiViewport;
 class FileWatcher;
 class SceneView;
+class TerrainStroke;
+class UndoJournal;
 
 class EditorApp final : public engine::IApplication
 {
@@ -92,6 +97,12 @@ private:
 	void CompileAndLoadShaders();
 	void OnShaderCompileFailed(uint32_t handle, std::span<const char> str);
 
+	// Runs on the simulation thread of FramePipeline.
+	void Simulate(engine::RenderSnapshot& snapshot, uint64_t frameIndex, float deltaTime);
+
+	// Shader compile tasks report failures from ResourceBuilder worker threads.
+	std::mutex m_shaderCompileFailedMutex;
+
 	bool m_crtInputFocus = true;
 	bool m_preInputFocus = true;
 
@@ -108,6 +119,7 @@ private:
 
 	// Scene
 	std::unique_ptr<engine::SceneWorld> m_pSceneWorld;
+	std::unique_ptr<engine::FramePipeline> m_pFramePipeline;
 	editor::SceneView* m_pSceneView = nullptr;
 	engine::Renderer* m_pSceneRenderer = nullptr;
 	engine::Renderer* m_pWhiteModelRenderer = nullptr;
@@ -129,6 +141,10 @@ private:
 	// Controllers for processing input events.
 	std::unique_ptr<engine::CameraController> m_pViewportCameraController;
 
+	// Edit history shared by UI layers. Holding mouse button in terrain edit mode is one brush stroke.
+	std::unique_ptr<UndoJournal> m_pUndoJournal;
+	std::unique_ptr<TerrainStroke> m_pTerrainStroke;
+
 	std::unique_ptr<FileWatcher> m_pFileWatcher;
 };
 
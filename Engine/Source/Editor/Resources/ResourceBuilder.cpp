@@ -6,11 +6,93 @@
 #include "Process/Process.h"
 #include "Time/Clock.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <iterator>
+#include <set>
 
 namespace editor
 {
 
+namespace
+{
+
+constexpr uint64_t FNVOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t FNVPrime = 1099511628211ULL;
+
+uint64_t HashBytes(uint64_t hash, const char* pData, size_t size)
+{
+	for (size_t index = 0; index < size; ++index)
+	{
+		hash ^= static_cast<uint8_t>(pData[index]);
+		hash *= FNVPrime;
+	}
+
+	return hash;
+}
+
+uint64_t HashString(uint64_t hash, const std::string& str)
+{
+	// Hash the terminator too so that {"ab", "c"} and {"a", "bc"} are different.
+	return HashBytes(hash, str.c_str(), str.size() + 1);
+}
+
+bool ReadTextFile(const std::filesystem::path& filePath, std::string& outText)
+{
+	std::ifstream fin(filePath, std::ios::in | std::ios::binary);
+	if (!fin.is_open())
+	{
+		return false;
+	}
+
+	outText.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+	return true;
+}
+
+// Hash source file and files it includes recursively. Includes which can not be found relative to the source file
+// such as <bgfx_shader.sh> come with shaderc so only their names are hashed.
+uint64_t HashShaderSource(uint64_t hash, const std::filesystem::path& filePath, std::set<std::string>& visitedFiles)
+{
+	std::string normalizedPath = filePath.lexically_normal().generic_string();
+	if (!visitedFiles.insert(normalizedPath).second)
+	{
+		return hash;
+	}
+
+	std::string source;
+	if (!ReadTextFile(filePath, source))
+	{
+		return HashString(hash, filePath.filename().generic_string());
+	}
+	hash = HashString(hash, source);
+
+	constexpr std::string_view includeToken = "#include";
+	size_t position = source.find(includeToken);
+	while (position != std::string::npos)
+	{
+		position += includeToken.size();
+		size_t lineEnd = source.find('\n', position);
+		size_t nameBegin = source.find_first_of("\"<", position);
+		if (nameBegin != std::string::npos && nameBegin < lineEnd)
+		{
+			char closeChar = '"' == source[nameBegin] ? '"' : '>';
+			size_t nameEnd = source.find(closeChar, nameBegin + 1);
+			if (nameEnd != std::string::npos && nameEnd < lineEnd)
+			{
+				std::string includeName = source.substr(nameBegin + 1, nameEnd - nameBegin - 1);
+				hash = HashShaderSource(hash, filePath.parent_path() / includeName, visitedFiles);
+			}
+		}
+
+		position = source.find(includeToken, position);
+	}
+
+	return hash;
+}
+
+}
+
 ResourceBuilder::ResourceBuilder()
 {
 	std::string modifyCachePath = GetModifyCacheFilePath();
@@ -19,16 +101,30 @@ ResourceBuilder::ResourceBuilder()
 		ReadModifyCacheFile();
 	}
 
-	m_numActiveTask = 0;
-	for (uint32_t index = 0; index < MaxTaskCount; ++index)
-	{
-		m_handleList[index] = TaskHandle{ index };
-		m_tasks[index].reset();
-	}
+	m_maxConcurrency = std::max(1U, std::thread::hardware_concurrency());
 }
 
 ResourceBuilder::~ResourceBuilder()
 {
+	{
+		std::lock_guard<std::mutex> lock(m_taskMutex);
+		m_stop = true;
+	}
+	m_taskCondition.notify_all();
+
+	for (std::thread& workerThread : m_workerThreads)
+	{
+		workerThread.join();
+	}
+
+	// Running tasks are finished by workers before they exit. Queued ones never run so waiters get a failed result instead of a broken promise.
+	for (Task& task : m_taskQueue)
+	{
+		task.promise.set_value(false);
+	}
+	m_taskQueue.clear();
+	m_outputTaskHandles.clear();
+
 	WriteModifyCacheFile();
 }
 
@@ -62,6 +158,7 @@ void ResourceBuilder::ReadModifyCacheFile()
 
 void ResourceBuilder::WriteModifyCacheFile()
 {
+	std::lock_guard<std::mutex> lock(m_modifyTimeCacheMutex);
 	if (!HasNewModifyTimeCache())
 	{
 		return;
@@ -95,6 +192,118 @@ void ResourceBuilder::WriteModifyCacheFile()
 	outFile.close();
 }
 
+std::string ResourceBuilder::GetShaderCacheFilePath(uint64_t shaderCacheKey) const
+{
+	const auto& appDataPath = engine::Path::GetApplicationDataPath();
+	if (!appDataPath.has_value())
+	{
+		return "";
+	}
+
+	char keyString[17];
+	std::snprintf(keyString, sizeof(keyString), "%016llx", static_cast<unsigned long long>(shaderCacheKey));
+
+	// Use first two characters as sub folder to avoid too many files in one folder.
+	return (appDataPath.value() / engine::Path::EngineName / "ShaderCache" / std::string(keyString, 2) / (std::string(keyString) + ".bin")).string();
+}
+
+uint64_t ResourceBuilder::GetShaderCacheKey(const char* pInputFilePath, const char* pVaryingDefFilePath, const std::vector<std::string>& commandArguments)
+{
+	std::call_once(m_shadercHashFlag, [this]()
+	{
+		std::string shadercPath = (std::filesystem::path(CDENGINE_TOOL_PATH) / "shaderc").generic_string();
+#if CD_PLATFORM_WINDOWS
+		shadercPath += ".exe";
+#endif
+		std::string shadercBinary;
+		if (!ReadTextFile(shadercPath, shadercBinary))
+		{
+			CD_WARN("Can not read {0} to identify shaderc version.", shadercPath);
+		}
+		m_shadercHash = HashString(FNVOffsetBasis, shadercBinary);
+	});
+
+	uint64_t hash = m_shadercHash;
+
+	std::set<std::string> visitedFiles;
+	hash = HashShaderSource(hash, pInputFilePath, visitedFiles);
+	hash = HashShaderSource(hash, pVaryingDefFilePath, visitedFiles);
+
+	// File paths are not a part of the key so that the same source in different checkouts shares cache.
+	for (size_t index = 0; index < commandArguments.size(); ++index)
+	{
+		const std::string& argument = commandArguments[index];
+		if ("-f" == argument || "-o" == argument || "--varyingdef" == argument)
+		{
+			++index;
+			continue;
+		}
+
+		hash = HashString(hash, argument);
+	}
+
+	// Zero is reserved for no cache.
+	return 0U == hash ? 1U : hash;
+}
+
+bool ResourceBuilder::RestoreFromShaderCache(uint64_t shaderCacheKey, const char* pOutputFilePath)
+{
+	std::lock_guard<std::mutex> lock(m_modifyTimeCacheMutex);
+
+	auto itCache = m_modifyTimeCache.find(pOutputFilePath);
+	if (itCache != m_modifyTimeCache.end() && itCache->second == shaderCacheKey && engine::Path::FileExists(pOutputFilePath))
+	{
+		CD_TRACE("Output file path {0} is up to date.", pOutputFilePath);
+		return true;
+	}
+
+	std::string cacheFilePath = GetShaderCacheFilePath(shaderCacheKey);
+	if (cacheFilePath.empty() || !engine::Path::FileExists(cacheFilePath.c_str()))
+	{
+		return false;
+	}
+
+	std::error_code error;
+	std::filesystem::create_directories(std::filesystem::path(pOutputFilePath).parent_path(), error);
+	std::filesystem::copy_file(cacheFilePath, pOutputFilePath, std::filesystem::copy_options::overwrite_existing, error);
+	if (error)
+	{
+		CD_WARN("Restore {0} from shader cache failed : {1}", pOutputFilePath, error.message());
+		return false;
+	}
+
+	CD_INFO("Restore {0} from shader cache.", pOutputFilePath);
+	m_newModifyTimeCache[pOutputFilePath] = shaderCacheKey;
+	return true;
+}
+
+void ResourceBuilder::StoreToShaderCache(uint64_t shaderCacheKey, const std::string& outputFilePath)
+{
+	std::string cacheFilePath = GetShaderCacheFilePath(shaderCacheKey);
+	if (!cacheFilePath.empty())
+	{
+		// Copy to a temporary file first so that other editor instances never read a half written artifact.
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(cacheFilePath).parent_path(), error);
+		std::string tempFilePath = cacheFilePath + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+		std::filesystem::copy_file(outputFilePath, tempFilePath, std::filesystem::copy_options::overwrite_existing, error);
+		if (!error)
+		{
+			std::filesystem::rename(tempFilePath, cacheFilePath, error);
+		}
+
+		if (error)
+		{
+			CD_WARN("Store {0} to shader cache failed : {1}", outputFilePath, error.message());
+			std::filesystem::remove(tempFilePath, error);
+		}
+	}
+
+	// Only record key after a successful build so that a failed variant is built again next time.
+	std::lock_guard<std::mutex> lock(m_modifyTimeCacheMutex);
+	m_newModifyTimeCache[outputFilePath] = shaderCacheKey;
+}
+
 std::string ResourceBuilder::GetModifyCacheFilePath()
 {
 	const auto& appDataPath = engine::Path::GetApplicationDataPath();
@@ -119,6 +328,7 @@ ProcessStatus ResourceBuilder::CheckFileStatus(const char* pInputFilePath, const
 	
 	const char* key = pOutputFilePath;
 
+	std::lock_guard<std::mutex> lock(m_modifyTimeCacheMutex);
 	if (!engine::Path::FileExists(pInputFilePath))
 	{
 		CD_ERROR("Input file path {0} does not exist!", pInputFilePath);
@@ -160,30 +370,78 @@ ProcessStatus ResourceBuilder::CheckFileStatus(const char* pInputFilePath, const
 
 TaskHandle ResourceBuilder::AddTask(std::unique_ptr<Process> pProcess)
 {
-	if (m_numActiveTask >= MaxTaskCount)
+	return AddTask(cd::MoveTemp(pProcess), "");
+}
+
+TaskHandle ResourceBuilder::AddTask(std::unique_ptr<Process> pProcess, std::string outputFilePath, uint64_t shaderCacheKey)
+{
+	assert(pProcess);
+
+	Task task;
+	task.outputFilePath = cd::MoveTemp(outputFilePath);
+	task.shaderCacheKey = shaderCacheKey;
+	task.pProcess = cd::MoveTemp(pProcess);
+	return AddTaskImpl(cd::MoveTemp(task));
+}
+
+TaskHandle ResourceBuilder::AddTextureCookTask(std::string inputFilePath, std::string outputFilePath, const TextureCookOptions& options)
+{
+	Task task;
+	task.outputFilePath = cd::MoveTemp(outputFilePath);
+	task.shaderCacheKey = 0U;
+	task.inputFilePath = cd::MoveTemp(inputFilePath);
+	task.textureCookOptions = options;
+	return AddTaskImpl(cd::MoveTemp(task));
+}
+
+TaskHandle ResourceBuilder::AddTaskImpl(Task task)
+{
+	std::lock_guard<std::mutex> lock(m_taskMutex);
+	if (!task.outputFilePath.empty())
 	{
-		CD_ERROR("Exceeding maximum number of tasks!");
-		return INVALID_TASK_HANDLE;
+		auto itTask = m_outputTaskHandles.find(task.outputFilePath);
+		if (itTask != m_outputTaskHandles.end())
+		{
+			CD_TRACE("Output file path {0} is already in building.", task.outputFilePath);
+			return itTask->second;
+		}
 	}
 
-	assert(m_numActiveTask >= 0 && m_numActiveTask < MaxTaskCount);
-	TaskHandle handle = m_handleList[m_numActiveTask++];
-
-	assert(pProcess);
-	pProcess->SetHandle(handle);
+	// Start a new batch when the builder is idle.
+	if (m_taskQueue.empty() && 0U == m_runningTaskCount)
+	{
+		m_taskFutures.clear();
+		m_completedTaskCount = 0U;
+		m_totalTaskCount = 0U;
+	}
 
-	assert(!m_tasks[handle]);
-	m_tasks[handle] = cd::MoveTemp(pProcess);
+	TaskHandle handle = m_nextHandle++;
+	if (InvalidHandle == m_nextHandle)
+	{
+		m_nextHandle = 0U;
+	}
+	if (task.pProcess)
+	{
+		task.pProcess->SetHandle(handle);
+	}
 
-	m_taskQueue.emplace(handle);
+	task.handle = handle;
+	m_taskFutures[handle] = task.promise.get_future().share();
+	if (!task.outputFilePath.empty())
+	{
+		m_outputTaskHandles[task.outputFilePath] = handle;
+	}
+	m_taskQueue.push_back(cd::MoveTemp(task));
+	++m_totalTaskCount;
 
 	return handle;
 }
 
 TaskHandle ResourceBuilder::AddShaderBuildTask(engine::ShaderType shaderType, const char* pInputFilePath, const char* pOutputFilePath, const char* pShaderFeatures, TaskOutputCallbacks callbacks)
 {
-	if (SkipStatus & static_cast<uint8_t>(CheckFileStatus(pInputFilePath, pOutputFilePath)))
+	if (!engine::Path::FileExists(pInputFilePath))
 	{
+		CD_ERROR("Input file path {0} does not exist!", pInputFilePath);
 		return INVALID_TASK_HANDLE;
 	}
 
@@ -260,12 +518,20 @@ TaskHandle ResourceBuilder::AddShaderBuildTask(engine::ShaderType shaderType, co
 		commandArguments.push_back(shaderLanguageDefine + ";" + pShaderFeatures);
 	}
 
+	// Shaders are checked by content rather than modify time so that edits to included files are detected
+	// and unchanged variants are restored from shader cache without running shaderc.
+	uint64_t shaderCacheKey = GetShaderCacheKey(pInputFilePath, shaderSourceFolderPath.string().c_str(), commandArguments);
+	if (RestoreFromShaderCache(shaderCacheKey, pOutputFilePath))
+	{
+		return INVALID_TASK_HANDLE;
+	}
+
 	std::string shadercPath = (std::filesystem::path(CDENGINE_TOOL_PATH) / "shaderc").generic_string();
 	std::unique_ptr<Process> pProcess = std::make_unique<Process>(shadercPath.c_str());
 	pProcess->SetCommandArguments(cd::MoveTemp(commandArguments));
 	pProcess->m_onOutput = cd::MoveTemp(callbacks.onOutput);
 	pProcess->m_onErrorOutput = cd::MoveTemp(callbacks.onErrorOutput);
-	return AddTask(cd::MoveTemp(pProcess));
+	return AddTask(cd::MoveTemp(pProcess), pOutputFilePath, shaderCacheKey);
 }
 
 TaskHandle ResourceBuilder::AddIrradianceCubeMapBuildTask(const char* pInputFilePath, const char* pOutputFilePath, TaskOutputCallbacks callbacks)
@@ -286,7 +552,7 @@ TaskHandle ResourceBuilder::AddIrradianceCubeMapBuildTask(const char* pInputFile
 	pProcess->SetCommandArguments(cd::MoveTemp(irradianceCommandArguments));
 	pProcess->m_onOutput = cd::MoveTemp(callbacks.onOutput);
 	pProcess->m_onErrorOutput = cd::MoveTemp(callbacks.onErrorOutput);
-	return AddTask(cd::MoveTemp(pProcess));
+	return AddTask(cd::MoveTemp(pProcess), pOutputFilePath);
 }
 
 TaskHandle ResourceBuilder::AddRadianceCubeMapBuildTask(const char* pInputFilePath, const char* pOutputFilePath, TaskOutputCallbacks callbacks)
@@ -307,7 +573,7 @@ TaskHandle ResourceBuilder::AddRadianceCubeMapBuildTask(const char* pInputFilePa
 	pProcess->SetCommandArguments(cd::MoveTemp(radianceCommandArguments));
 	pProcess->m_onOutput = cd::MoveTemp(callbacks.onOutput);
 	pProcess->m_onErrorOutput = cd::MoveTemp(callbacks.onErrorOutput);
-	return AddTask(cd::MoveTemp(pProcess));
+	return AddTask(cd::MoveTemp(pProcess), pOutputFilePath);
 }
 
 TaskHandle ResourceBuilder::AddTextureBuildTask(cd::MaterialTextureType textureType, const char* pInputFilePath, const char* pOutputFilePath, TaskOutputCallbacks callbacks)
@@ -317,71 +583,198 @@ TaskHandle ResourceBuilder::AddTextureBuildTask(cd::MaterialTextureType textureT
 		return INVALID_TASK_HANDLE;
 	}
 
-	// Document : https://bkaradzic.github.io/bgfx/tools.html#texture-compiler-texturec
-	std::vector<std::string> commandArguments{ "-f", pInputFilePath, "-o", pOutputFilePath, "-t", "BC3", "--mips", "-q", "highest", "--max", "1024"};
-	if (cd::MaterialTextureType::Normal == textureType)
-	{
-		commandArguments.push_back("--normalmap");
-	}
-	else if (cd::MaterialTextureType::BaseColor != textureType)
+	// Same outputs as texturec with "-t BC3 --mips -q highest --max 1024" but cooked in process.
+	// Block compression is parallel inside the cooker and unchanged mips are reused from the previous output.
+	// Cooker logs directly so output callbacks are not used.
+	TextureCookOptions options;
+	options.textureType = textureType;
+	options.format = TextureCookFormat::BC3;
+	options.maxSize = 1024U;
+	options.generateMips = true;
+	return AddTextureCookTask(pInputFilePath, pOutputFilePath, options);
+}
+
+std::shared_future<bool> ResourceBuilder::GetTaskFuture(TaskHandle handle) const
+{
+	std::lock_guard<std::mutex> lock(m_taskMutex);
+	auto itFuture = m_taskFutures.find(handle);
+	if (itFuture == m_taskFutures.end())
 	{
-		commandArguments.push_back("--linear");
+		return {};
 	}
-	
-	std::string texturecPath = (std::filesystem::path(CDENGINE_TOOL_PATH) / "texturec").generic_string();
-	std::unique_ptr<Process> pProcess = std::make_unique<Process>(texturecPath.c_str());
-	pProcess->SetCommandArguments(cd::MoveTemp(commandArguments));
-	pProcess->m_onOutput = cd::MoveTemp(callbacks.onOutput);
-	pProcess->m_onErrorOutput = cd::MoveTemp(callbacks.onErrorOutput);
-	return AddTask(cd::MoveTemp(pProcess));
+
+	return itFuture->second;
 }
 
 void ResourceBuilder::Update(bool doPrintLog, bool doPrintErrorLog)
 {
-	assert(m_numActiveTask == m_taskQueue.size());
+	{
+		std::unique_lock<std::mutex> lock(m_taskMutex);
+		if (m_taskQueue.empty() && 0U == m_runningTaskCount)
+		{
+			return;
+		}
+
+		DispatchImpl(doPrintLog, doPrintErrorLog);
+		m_idleCondition.wait(lock, [this]() { return m_taskQueue.empty() && 0U == m_runningTaskCount; });
+	}
 
-	if (0 == m_numActiveTask)
+	WriteModifyCacheFile();
+}
+
+void ResourceBuilder::Dispatch(bool doPrintLog, bool doPrintErrorLog)
+{
+	std::lock_guard<std::mutex> lock(m_taskMutex);
+	if (!m_taskQueue.empty())
 	{
-		return;
+		DispatchImpl(doPrintLog, doPrintErrorLog);
 	}
+}
 
-	// It may wait until process exited which depends on process's setting.
-	while (!m_taskQueue.empty())
+void ResourceBuilder::Wait(std::span<const TaskHandle> handles, bool doPrintLog, bool doPrintErrorLog)
+{
+	std::vector<std::shared_future<bool>> futures;
+	futures.reserve(handles.size());
 	{
-		TaskHandle handle = m_taskQueue.front();
-		Process* pProcess = m_tasks[handle].get();
-		assert(pProcess);
+		std::lock_guard<std::mutex> lock(m_taskMutex);
+		if (!m_taskQueue.empty())
+		{
+			DispatchImpl(doPrintLog, doPrintErrorLog);
+		}
 
-		pProcess->SetWaitUntilFinished(1 == m_taskQueue.size());
-		pProcess->SetPrintChildProcessLog(doPrintLog);
-		pProcess->SetPrintChildProcessErrorLog(doPrintErrorLog);
-		pProcess->Run();
+		for (TaskHandle handle : handles)
+		{
+			// Futures of finished batches are released and their tasks are done already.
+			auto itFuture = m_taskFutures.find(handle);
+			if (itFuture != m_taskFutures.end())
+			{
+				futures.push_back(itFuture->second);
+			}
+		}
+	}
 
-		m_tasks[handle].reset();
-		m_taskQueue.pop();
+	for (const std::shared_future<bool>& future : futures)
+	{
+		future.wait();
+	}
+
+	WriteModifyCacheFile();
+}
 
-		m_handleList[--m_numActiveTask] = handle;
+void ResourceBuilder::DispatchImpl(bool doPrintLog, bool doPrintErrorLog)
+{
+	while (m_workerThreads.size() < m_maxConcurrency)
+	{
+		m_workerThreads.emplace_back(&ResourceBuilder::WorkerThreadMain, this);
 	}
-	assert(m_numActiveTask == m_taskQueue.size());
 
-	if (m_taskQueue.empty())
+	m_printLog = doPrintLog;
+	m_printErrorLog = doPrintErrorLog;
+	m_isDispatched = true;
+	m_taskCondition.notify_all();
+}
+
+void ResourceBuilder::WorkerThreadMain()
+{
+	while (true)
 	{
-		WriteModifyCacheFile();
+		Task task;
+		bool doPrintLog;
+		bool doPrintErrorLog;
+		{
+			std::unique_lock<std::mutex> lock(m_taskMutex);
+			m_taskCondition.wait(lock, [this]()
+			{
+				return m_stop || (m_isDispatched && !m_taskQueue.empty() && m_runningTaskCount < m_maxConcurrency);
+			});
+
+			if (m_stop)
+			{
+				return;
+			}
+
+			task = cd::MoveTemp(m_taskQueue.front());
+			m_taskQueue.pop_front();
+			++m_runningTaskCount;
+			doPrintLog = m_printLog;
+			doPrintErrorLog = m_printErrorLog;
+		}
+
+		bool succeeded;
+		if (task.pProcess)
+		{
+			// Every worker waits for its own process so that the number of child processes is bounded by concurrency.
+			task.pProcess->SetWaitUntilFinished(true);
+			task.pProcess->SetPrintChildProcessLog(doPrintLog);
+			task.pProcess->SetPrintChildProcessErrorLog(doPrintErrorLog);
+			task.pProcess->Run();
+
+			succeeded = 0 == task.pProcess->GetExitCode();
+			task.pProcess.reset();
+		}
+		else
+		{
+			assert(task.textureCookOptions.has_value());
+			succeeded = TextureCooker::Cook(task.inputFilePath.c_str(), task.outputFilePath.c_str(), task.textureCookOptions.value());
+		}
+		if (succeeded && 0U != task.shaderCacheKey)
+		{
+			StoreToShaderCache(task.shaderCacheKey, task.outputFilePath);
+		}
+		task.promise.set_value(succeeded);
+
+		{
+			std::lock_guard<std::mutex> lock(m_taskMutex);
+			if (!task.outputFilePath.empty())
+			{
+				m_outputTaskHandles.erase(task.outputFilePath);
+			}
+			--m_runningTaskCount;
+			++m_completedTaskCount;
+			if (m_taskQueue.empty() && 0U == m_runningTaskCount)
+			{
+				m_isDispatched = false;
+			}
+		}
+		m_taskCondition.notify_one();
+		m_idleCondition.notify_all();
 	}
 }
 
+void ResourceBuilder::SetMaxConcurrency(uint32_t count)
+{
+	std::lock_guard<std::mutex> lock(m_taskMutex);
+	m_maxConcurrency = std::max(1U, count);
+}
+
+uint32_t ResourceBuilder::GetMaxConcurrency() const
+{
+	std::lock_guard<std::mutex> lock(m_taskMutex);
+	return m_maxConcurrency;
+}
+
 uint32_t ResourceBuilder::GetCurrentTaskCount() const
 {
-	assert(m_numActiveTask == m_taskQueue.size());
+	std::lock_guard<std::mutex> lock(m_taskMutex);
+	return static_cast<uint32_t>(m_taskQueue.size()) + m_runningTaskCount;
+}
 
-	return m_numActiveTask;
+uint32_t ResourceBuilder::GetCompletedTaskCount() const
+{
+	std::lock_guard<std::mutex> lock(m_taskMutex);
+	return m_completedTaskCount;
 }
 
-bool ResourceBuilder::IsIdle() const
+uint32_t ResourceBuilder::GetTotalTaskCount() const
 {
-	assert(m_numActiveTask == m_taskQueue.size());
+	std::lock_guard<std::mutex> lock(m_taskMutex);
+	return m_totalTaskCount;
+}
 
-	return (0 == m_numActiveTask);
+bool ResourceBuilder::IsIdle() const
+{
+	std::lock_guard<std::mutex> lock(m_taskMutex);
+	return m_taskQueue.empty() && 0U == m_runningTaskCount;
 }
 
 bool ResourceBuilder::HasNewModifyTimeCache() const
@@ -2,16 +2,24 @@
 
 #include "Core/Delegates/Delegate.hpp"
 #include "Rendering/ShaderType.h"
+#include "Resources/TextureCooker.h"
 #include "Scene/MaterialTextureType.h"
 
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <filesystem>
 #include <fstream>
-#include <queue>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace editor
 {
@@ -38,12 +46,13 @@ using TaskHandle = uint32_t;
 
 // ResourceBuilder is used to create processes to build different resource types.
 // So it is OK to update in the main thread or work thread.
+// Queued processes are dispatched to a pool of worker threads whose size is the number of cores by default.
+// Task output callbacks are invoked from worker threads so they should be thread safe.
 // For resource build tasks which are using dll calls, it will be wrapped as a task to multithreading JobSystem.
 class ResourceBuilder final
 {
 public:
-	static constexpr uint32_t MaxTaskCount = 64;
-	static constexpr uint32_t InvalidHandle = MaxTaskCount;
+	static constexpr uint32_t InvalidHandle = UINT32_MAX;
 
 #define INVALID_TASK_HANDLE { InvalidHandle }
 
@@ -70,14 +79,60 @@ public:
 	TaskHandle AddRadianceCubeMapBuildTask(const char* pInputFilePath, const char* pOutputFilePath, TaskOutputCallbacks callbacks = {});
 	TaskHandle AddTextureBuildTask(cd::MaterialTextureType textureType, const char* pInputFilePath, const char* pOutputFilePath, TaskOutputCallbacks callbacks = {});
 
+	// The future is ready when the task finished and tells if the process exited successfully.
+	// Returns an invalid future for invalid handles. Futures are released when a new batch of tasks starts.
+	std::shared_future<bool> GetTaskFuture(TaskHandle handle) const;
+
+	// Dispatch queued tasks to worker threads and wait until all of them finished.
 	void Update(bool doPrintLog = false, bool doPrintErrorLog = true);
+
+	// Dispatch queued tasks to worker threads without waiting. Poll task futures to know when they finished.
+	void Dispatch(bool doPrintLog = false, bool doPrintErrorLog = true);
+
+	// Dispatch queued tasks and wait only for the given ones. Other tasks keep running in background.
+	void Wait(std::span<const TaskHandle> handles, bool doPrintLog = false, bool doPrintErrorLog = true);
+
+	void SetMaxConcurrency(uint32_t count);
+	uint32_t GetMaxConcurrency() const;
+
+	// Queued and running tasks.
 	uint32_t GetCurrentTaskCount() const;
+	// Task counts of current batch which starts when a task is added to an idle builder.
+	uint32_t GetCompletedTaskCount() const;
+	uint32_t GetTotalTaskCount() const;
 	bool IsIdle() const;
 
 private:
+	struct Task
+	{
+		TaskHandle handle;
+		std::string outputFilePath;
+		// Not zero when output should be stored to shader cache after a successful build.
+		uint64_t shaderCacheKey;
+		std::unique_ptr<Process> pProcess;
+		// Textures are cooked in process when there is no process to run.
+		std::string inputFilePath;
+		std::optional<TextureCookOptions> textureCookOptions;
+		std::promise<bool> promise;
+	};
+
 	ResourceBuilder();
 	~ResourceBuilder();
 
+	// Tasks writing to the same output file are merged so that two processes never write one file at the same time.
+	TaskHandle AddTask(std::unique_ptr<Process> pProcess, std::string outputFilePath, uint64_t shaderCacheKey = 0U);
+	TaskHandle AddTextureCookTask(std::string inputFilePath, std::string outputFilePath, const TextureCookOptions& options);
+	TaskHandle AddTaskImpl(Task task);
+	void DispatchImpl(bool doPrintLog, bool doPrintErrorLog);
+	void WorkerThreadMain();
+
+	// Shader cache is content addressed by the hash of source with all includes, varying def, compile arguments and shaderc binary.
+	// It lives in application data folder so that different checkouts and branches share built variants.
+	std::string GetShaderCacheFilePath(uint64_t shaderCacheKey) const;
+	uint64_t GetShaderCacheKey(const char* pInputFilePath, const char* pVaryingDefFilePath, const std::vector<std::string>& commandArguments);
+	bool RestoreFromShaderCache(uint64_t shaderCacheKey, const char* pOutputFilePath);
+	void StoreToShaderCache(uint64_t shaderCacheKey, const std::string& outputFilePath);
+
 	void ReadModifyCacheFile();
 	void WriteModifyCacheFile();
 
@@ -91,11 +146,29 @@ private:
 	ProcessStatus CheckFileStatus(const char* pInputFilePath, const char* pOutputFilePath);
 
 private:
-	uint32_t m_numActiveTask;
-	std::array<TaskHandle, MaxTaskCount> m_handleList;
-	std::array<std::unique_ptr<Process>, MaxTaskCount> m_tasks;
-	std::queue<TaskHandle> m_taskQueue;
-
+	mutable std::mutex m_taskMutex;
+	std::condition_variable m_taskCondition;
+	std::condition_variable m_idleCondition;
+	std::deque<Task> m_taskQueue;
+	std::unordered_map<TaskHandle, std::shared_future<bool>> m_taskFutures;
+	std::unordered_map<std::string, TaskHandle> m_outputTaskHandles;
+	std::vector<std::thread> m_workerThreads;
+	TaskHandle m_nextHandle = 0U;
+	uint32_t m_maxConcurrency = 1U;
+	uint32_t m_runningTaskCount = 0U;
+	uint32_t m_completedTaskCount = 0U;
+	uint32_t m_totalTaskCount = 0U;
+	// Workers only take tasks after dispatching until the queue runs out, so tasks can be added as a batch.
+	bool m_isDispatched = false;
+	bool m_printLog = false;
+	bool m_printErrorLog = true;
+	bool m_stop = false;
+
+	std::once_flag m_shadercHashFlag;
+	uint64_t m_shadercHash = 0U;
+
+	std::mutex m_modifyTimeCacheMutex;
+	// Stores file modify time for most resources and shader cache key for shaders.
 	std::unordered_map<std::string, uint64_t> m_modifyTimeCache;
 	// We always access to fragment shader multiple times by using ubre options.
 	// So we can not update fragment shader's modify time every time we found it has been modified.
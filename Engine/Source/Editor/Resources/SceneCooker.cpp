@@ -0,0 +1,301 @@
+#include "SceneCooker.h"
+
+#include "Log/Log.h"
+#include "Path/Path.h"
+#include "Rendering/Resources/MeshResource.h"
+#include "Resources/CookedScene.h"
+#include "Resources/ResourceBuilder.h"
+#include "Scene/SceneDatabase.h"
+#include "Utilities/MeshUtils.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+namespace editor
+{
+
+namespace
+{
+
+using namespace engine::CookedSceneFormat;
+
+static_assert(nameof::enum_count<cd::MaterialTextureType>() <= MaxTextureCount);
+
+uint64_t AlignUp(uint64_t value)
+{
+	return (value + Alignment - 1U) & ~(Alignment - 1U);
+}
+
+void AlignBlob(std::vector<std::byte>& blob)
+{
+	blob.resize(AlignUp(blob.size()), std::byte{ 0 });
+}
+
+template<typename T>
+void AppendBlob(std::vector<std::byte>& blob, const T* pData, size_t count)
+{
+	size_t offset = blob.size();
+	blob.resize(offset + count * sizeof(T));
+	std::memcpy(blob.data() + offset, pData, count * sizeof(T));
+}
+
+uint32_t AddString(std::vector<std::byte>& strings, std::string_view str)
+{
+	uint32_t offset = static_cast<uint32_t>(strings.size());
+	AppendBlob(strings, str.data(), str.size());
+	strings.push_back(std::byte{ 0 });
+	return offset;
+}
+
+}
+
+bool SceneCooker::Cook(const cd::SceneDatabase& sceneDatabase, const cd::VertexFormat& requiredVertexFormat, const char* pOutputFilePath,
+	const engine::MeshOptimizeOptions& optimizeOptions)
+{
+	std::vector<std::byte> strings;
+	std::vector<Mesh> meshes;
+	std::vector<PolygonGroup> polygonGroups;
+	std::vector<Material> materials;
+	std::vector<std::byte> vertexData;
+	std::vector<std::byte> indexData;
+	engine::MeshOptimizeStats totalOptimizeStats;
+
+	// Materials.
+	for (const cd::Material& material : sceneDatabase.GetMaterials())
+	{
+		Material& cookedMaterial = materials.emplace_back();
+		std::memset(&cookedMaterial, 0, sizeof(Material));
+		cookedMaterial.nameOffset = AddString(strings, material.GetName());
+
+		if (auto optOcclusion = material.GetFloatProperty(cd::MaterialPropertyGroup::Occlusion, cd::MaterialProperty::Factor); optOcclusion.has_value())
+		{
+			cookedMaterial.flags |= HasOcclusionFactor;
+			cookedMaterial.occlusionFactor = optOcclusion.value();
+		}
+		if (auto optRoughness = material.GetFloatProperty(cd::MaterialPropertyGroup::Roughness, cd::MaterialProperty::Factor); optRoughness.has_value())
+		{
+			cookedMaterial.flags |= HasRoughnessFactor;
+			cookedMaterial.roughnessFactor = optRoughness.value();
+		}
+		if (auto optMetallic = material.GetFloatProperty(cd::MaterialPropertyGroup::Metallic, cd::MaterialProperty::Factor); optMetallic.has_value())
+		{
+			cookedMaterial.flags |= HasMetallicFactor;
+			cookedMaterial.metallicFactor = optMetallic.value();
+		}
+		if (auto optTwoSided = material.GetBoolProperty(cd::MaterialPropertyGroup::General, cd::MaterialProperty::TwoSided); optTwoSided.has_value())
+		{
+			cookedMaterial.flags |= HasTwoSided;
+			cookedMaterial.flags |= optTwoSided.value() ? TwoSided : 0U;
+		}
+		if (auto optBlendMode = material.GetI32Property(cd::MaterialPropertyGroup::General, cd::MaterialProperty::BlendMode); optBlendMode.has_value())
+		{
+			cookedMaterial.flags |= HasBlendMode;
+			cookedMaterial.blendMode = optBlendMode.value();
+			if (auto optAlphaTestValue = material.GetFloatProperty(cd::MaterialPropertyGroup::General, cd::MaterialProperty::OpacityMaskClipValue); optAlphaTestValue.has_value())
+			{
+				cookedMaterial.alphaCutOff = optAlphaTestValue.value();
+			}
+		}
+
+		for (size_t textureTypeValue = 0; textureTypeValue < nameof::enum_count<cd::MaterialTextureType>(); ++textureTypeValue)
+		{
+			auto textureType = static_cast<cd::MaterialTextureType>(textureTypeValue);
+			Texture& cookedTexture = cookedMaterial.textures[textureTypeValue];
+			cookedTexture.pathOffset = InvalidIndex;
+			cookedTexture.uvScale[0] = cookedTexture.uvScale[1] = 1.0f;
+
+			cd::TextureID textureID = material.GetTextureID(textureType);
+			if (!textureID.IsValid())
+			{
+				continue;
+			}
+
+			// Runtime only loads built textures so build them here.
+			const cd::Texture& texture = sceneDatabase.GetTexture(textureID.Data());
+			std::string outputTexturePath = engine::Path::GetTextureOutputFilePath(texture.GetPath(), ".dds");
+			ResourceBuilder::Get().AddTextureBuildTask(textureType, texture.GetPath(), outputTexturePath.c_str());
+
+			cookedTexture.pathOffset = AddString(strings, outputTexturePath);
+			cookedTexture.uMapMode = static_cast<uint8_t>(texture.GetUMapMode());
+			cookedTexture.vMapMode = static_cast<uint8_t>(texture.GetVMapMode());
+			if (auto optUVOffset = material.GetVec2fProperty(textureType, cd::MaterialProperty::UVOffset); optUVOffset.has_value())
+			{
+				cookedTexture.uvOffset[0] = optUVOffset.value().x();
+				cookedTexture.uvOffset[1] = optUVOffset.value().y();
+			}
+			if (auto optUVScale = material.GetVec2fProperty(textureType, cd::MaterialProperty::UVScale); optUVScale.has_value())
+			{
+				cookedTexture.uvScale[0] = optUVScale.value().x();
+				cookedTexture.uvScale[1] = optUVScale.value().y();
+			}
+		}
+	}
+
+	// Meshes.
+	for (const cd::Mesh& mesh : sceneDatabase.GetMeshes())
+	{
+		// Skinned meshes and blend shapes still need mesh data on CPU side.
+		if (mesh.GetSkinIDCount() > 0U || mesh.GetBlendShapeIDCount() > 0U)
+		{
+			CD_WARN("Skip cooking mesh {0} which has skin or blend shape.", mesh.GetName());
+			continue;
+		}
+
+		cd::VertexFormat vertexFormat;
+		for (const auto& layout : requiredVertexFormat.GetVertexAttributeLayouts())
+		{
+			if (mesh.GetVertexFormat().Contains(layout.vertexAttributeType))
+			{
+				vertexFormat.AddVertexAttributeLayout(layout);
+			}
+		}
+		assert(vertexFormat.GetVertexAttributeLayouts().size() <= MaxVertexAttributeCount);
+
+		std::optional<cd::VertexBuffer> optVertexBuffer = cd::BuildVertexBufferForStaticMesh(mesh, vertexFormat);
+		if (!optVertexBuffer.has_value())
+		{
+			CD_ERROR("Failed to build vertex buffer of mesh {0}.", mesh.GetName());
+			return false;
+		}
+
+		std::vector<cd::IndexBuffer> meshIndexBuffers;
+		for (uint32_t polygonGroupIndex = 0U; polygonGroupIndex < mesh.GetPolygonGroupCount(); ++polygonGroupIndex)
+		{
+			std::optional<cd::IndexBuffer> optIndexBuffer = cd::BuildIndexBufferesForPolygonGroup(mesh, polygonGroupIndex);
+			if (!optIndexBuffer.has_value())
+			{
+				CD_ERROR("Failed to build index buffer of mesh {0}.", mesh.GetName());
+				return false;
+			}
+			meshIndexBuffers.push_back(cd::MoveTemp(optIndexBuffer.value()));
+		}
+
+		cd::VertexBuffer& meshVertexBuffer = optVertexBuffer.value();
+		std::vector<std::vector<engine::MeshLod>> meshLods;
+		bool isQuantized = false;
+		if (optimizeOptions.IsEnabled())
+		{
+			engine::MeshOptimizeStats optimizeStats = engine::MeshOptimizer::Optimize(optimizeOptions, meshVertexBuffer, vertexFormat, mesh.GetVertexCount(), meshIndexBuffers, meshLods);
+			isQuantized = optimizeStats.quantizedMeshCount > 0U;
+			totalOptimizeStats += optimizeStats;
+		}
+
+		Mesh& cookedMesh = meshes.emplace_back();
+		std::memset(&cookedMesh, 0, sizeof(Mesh));
+		cookedMesh.nameOffset = AddString(strings, mesh.GetName());
+		cd::MaterialID materialID = mesh.GetMaterialID(0U);
+		cookedMesh.materialIndex = materialID.IsValid() ? materialID.Data() : InvalidIndex;
+		cookedMesh.vertexCount = mesh.GetVertexCount();
+		cookedMesh.polygonCount = mesh.GetPolygonCount();
+		cookedMesh.vertexStride = static_cast<uint32_t>(meshVertexBuffer.size() / mesh.GetVertexCount());
+		cookedMesh.flags = isQuantized ? QuantizedAttributes : 0U;
+		for (const auto& layout : vertexFormat.GetVertexAttributeLayouts())
+		{
+			VertexAttribute& attribute = cookedMesh.vertexAttributes[cookedMesh.vertexAttributeCount++];
+			attribute.attributeType = static_cast<uint8_t>(layout.vertexAttributeType);
+			attribute.valueType = static_cast<uint8_t>(layout.attributeValueType);
+			attribute.count = layout.attributeCount;
+		}
+
+		const cd::AABB& aabb = mesh.GetAABB();
+		cookedMesh.aabbMin[0] = aabb.Min().x();
+		cookedMesh.aabbMin[1] = aabb.Min().y();
+		cookedMesh.aabbMin[2] = aabb.Min().z();
+		cookedMesh.aabbMax[0] = aabb.Max().x();
+		cookedMesh.aabbMax[1] = aabb.Max().y();
+		cookedMesh.aabbMax[2] = aabb.Max().z();
+
+		// Every stream starts at an aligned offset.
+		AlignBlob(vertexData);
+		cookedMesh.vertexDataOffset = vertexData.size();
+		cookedMesh.vertexDataSize = meshVertexBuffer.size();
+		AppendBlob(vertexData, meshVertexBuffer.data(), meshVertexBuffer.size());
+
+		const uint32_t indexSize = engine::MeshResource::GetIndexSize(mesh.GetVertexCount());
+		cookedMesh.firstPolygonGroup = static_cast<uint32_t>(polygonGroups.size());
+		cookedMesh.polygonGroupCount = mesh.GetPolygonGroupCount();
+		for (size_t polygonGroupIndex = 0; polygonGroupIndex < meshIndexBuffers.size(); ++polygonGroupIndex)
+		{
+			const cd::IndexBuffer& indexBuffer = meshIndexBuffers[polygonGroupIndex];
+			AlignBlob(indexData);
+			PolygonGroup& polygonGroup = polygonGroups.emplace_back();
+			std::memset(&polygonGroup, 0, sizeof(PolygonGroup));
+			polygonGroup.indexDataOffset = indexData.size();
+			polygonGroup.indexDataSize = indexBuffer.size();
+			polygonGroup.indexCount = static_cast<uint32_t>(indexBuffer.size() / indexSize);
+			polygonGroup.indexSize = indexSize;
+			if (polygonGroupIndex < meshLods.size())
+			{
+				for (const engine::MeshLod& lod : meshLods[polygonGroupIndex])
+				{
+					polygonGroup.lods[polygonGroup.lodCount++] = Lod{ lod.startIndex, lod.indexCount };
+				}
+			}
+			AppendBlob(indexData, indexBuffer.data(), indexBuffer.size());
+		}
+	}
+
+	// Layout sections after the header.
+	Header header;
+	std::memset(&header, 0, sizeof(Header));
+	header.magic = Magic;
+	header.version = Version;
+
+	uint64_t fileOffset = sizeof(Header);
+	auto PlaceSection = [&header, &fileOffset](SectionType sectionType, uint64_t size, size_t count)
+	{
+		Section& section = header.sections[static_cast<size_t>(sectionType)];
+		fileOffset = AlignUp(fileOffset);
+		section.offset = fileOffset;
+		section.size = size;
+		section.count = static_cast<uint32_t>(count);
+		fileOffset += size;
+	};
+	PlaceSection(SectionType::Strings, strings.size(), 0U);
+	PlaceSection(SectionType::Meshes, meshes.size() * sizeof(Mesh), meshes.size());
+	PlaceSection(SectionType::PolygonGroups, polygonGroups.size() * sizeof(PolygonGroup), polygonGroups.size());
+	PlaceSection(SectionType::Materials, materials.size() * sizeof(Material), materials.size());
+	PlaceSection(SectionType::VertexData, vertexData.size(), 0U);
+	PlaceSection(SectionType::IndexData, indexData.size(), 0U);
+	header.fileSize = fileOffset;
+
+	std::ofstream outputFile(pOutputFilePath, std::ios::binary | std::ios::trunc);
+	if (!outputFile.is_open())
+	{
+		CD_ERROR("Failed to open {0} to write cooked scene.", pOutputFilePath);
+		return false;
+	}
+
+	outputFile.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	auto WriteSection = [&header, &outputFile](SectionType sectionType, const void* pData)
+	{
+		const Section& section = header.sections[static_cast<size_t>(sectionType)];
+		static constexpr char padding[Alignment] = {};
+		outputFile.write(padding, static_cast<std::streamsize>(section.offset - static_cast<uint64_t>(outputFile.tellp())));
+		outputFile.write(static_cast<const char*>(pData), static_cast<std::streamsize>(section.size));
+	};
+	WriteSection(SectionType::Strings, strings.data());
+	WriteSection(SectionType::Meshes, meshes.data());
+	WriteSection(SectionType::PolygonGroups, polygonGroups.data());
+	WriteSection(SectionType::Materials, materials.data());
+	WriteSection(SectionType::VertexData, vertexData.data());
+	WriteSection(SectionType::IndexData, indexData.data());
+	outputFile.close();
+
+	// Cooked package refers to built textures so wait for them.
+	ResourceBuilder::Get().Update();
+
+	CD_INFO("Cooked {0} meshes and {1} materials to {2}.", meshes.size(), materials.size(), pOutputFilePath);
+	if (optimizeOptions.IsEnabled())
+	{
+		CD_INFO("Mesh optimization : vertex buffers {0} -> {1} bytes, vertex shader invocations {2} -> {3}.",
+			totalOptimizeStats.vertexBufferBytesBefore, totalOptimizeStats.vertexBufferBytesAfter,
+			totalOptimizeStats.vertexShaderInvocationsBefore, totalOptimizeStats.vertexShaderInvocationsAfter);
+	}
+	return true;
+}
+
+} // namespace editor
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Rendering/Utility/MeshOptimizer.h"
+
+namespace cd
+{
+
+class SceneDatabase;
+
+}
+
+namespace editor
+{
+
+// SceneCooker writes a SceneDatabase into a cooked scene package which runtime maps and uses without parsing.
+// Vertex streams are built in the required vertex format and optimized, and textures are built to dds files in advance.
+class SceneCooker
+{
+public:
+	static bool Cook(const cd::SceneDatabase& sceneDatabase, const cd::VertexFormat& requiredVertexFormat, const char* pOutputFilePath,
+		const engine::MeshOptimizeOptions& optimizeOptions = engine::MeshOptimizeOptions::All());
+};
+
+} // namespace editor
@@ -0,0 +1,468 @@
+#include "TextureCooker.h"
+
+#include "Base/Template.h"
+#include "Log/Log.h"
+#include "Resources/ResourceLoader.h"
+
+#include <bimg/bimg.h>
+#include <bimg/decode.h>
+#include <bimg/encode.h>
+#include <bx/allocator.h>
+#include <bx/file.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <latch>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace editor
+{
+
+namespace
+{
+
+constexpr uint64_t FNVOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t FNVPrime = 1099511628211ULL;
+constexpr uint32_t MipCacheMagic = 0x4D434443; // "CDCM"
+// Block rows per encoding strip. Smaller strips balance better but every strip pays encoder setup.
+constexpr uint32_t StripBlockRowCount = 16U;
+
+// Strips of all textures which ResourceBuilder cooks at the same time share these threads,
+// so encoding never runs more threads than cores however many cook tasks are in flight.
+class StripEncodePool final
+{
+public:
+	static StripEncodePool& Get()
+	{
+		static StripEncodePool s_pool;
+		return s_pool;
+	}
+
+	StripEncodePool()
+	{
+		uint32_t threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+		for (uint32_t threadIndex = 0U; threadIndex < threadCount; ++threadIndex)
+		{
+			m_threads.emplace_back(&StripEncodePool::ThreadMain, this);
+		}
+	}
+
+	StripEncodePool(const StripEncodePool&) = delete;
+	StripEncodePool& operator=(const StripEncodePool&) = delete;
+	StripEncodePool(StripEncodePool&&) = delete;
+	StripEncodePool& operator=(StripEncodePool&&) = delete;
+
+	~StripEncodePool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_condition.notify_all();
+
+		for (std::thread& thread : m_threads)
+		{
+			thread.join();
+		}
+	}
+
+	uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_threads.size()); }
+
+	void Submit(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_tasks.push_back(cd::MoveTemp(task));
+		}
+		m_condition.notify_one();
+	}
+
+private:
+	void ThreadMain()
+	{
+		while (true)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+				if (m_tasks.empty())
+				{
+					return;
+				}
+
+				task = cd::MoveTemp(m_tasks.front());
+				m_tasks.pop_front();
+			}
+
+			task();
+		}
+	}
+
+private:
+	std::vector<std::thread> m_threads;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<std::function<void()>> m_tasks;
+	bool m_stop = false;
+};
+
+bx::AllocatorI* GetCookerAllocator()
+{
+	static bx::DefaultAllocator s_allocator;
+	return &s_allocator;
+}
+
+uint64_t HashBytes(uint64_t hash, const void* pData, size_t size)
+{
+	const auto* pBytes = static_cast<const uint8_t*>(pData);
+	for (size_t index = 0; index < size; ++index)
+	{
+		hash ^= pBytes[index];
+		hash *= FNVPrime;
+	}
+
+	return hash;
+}
+
+struct MipImage
+{
+	uint32_t width;
+	uint32_t height;
+	// RGBA32F
+	std::vector<float> pixels;
+};
+
+bimg::TextureFormat::Enum GetBimgFormat(TextureCookFormat format)
+{
+	switch (format)
+	{
+	case TextureCookFormat::BC1:
+		return bimg::TextureFormat::BC1;
+	case TextureCookFormat::BC5:
+		return bimg::TextureFormat::BC5;
+	case TextureCookFormat::BC7:
+		return bimg::TextureFormat::BC7;
+	case TextureCookFormat::BC3:
+	default:
+		return bimg::TextureFormat::BC3;
+	}
+}
+
+uint32_t GetBlockBytes(TextureCookFormat format)
+{
+	return TextureCookFormat::BC1 == format ? 8U : 16U;
+}
+
+float GammaToLinear(float value)
+{
+	return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+float LinearToGamma(float value)
+{
+	return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+// Box filter 2x2 footprint. Odd sizes clamp the last row or column.
+MipImage Downsample(const MipImage& source, bool isNormalMap)
+{
+	MipImage result;
+	result.width = std::max(source.width / 2U, 1U);
+	result.height = std::max(source.height / 2U, 1U);
+	result.pixels.resize(static_cast<size_t>(result.width) * result.height * 4U);
+	for (uint32_t y = 0U; y < result.height; ++y)
+	{
+		for (uint32_t x = 0U; x < result.width; ++x)
+		{
+			float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			for (uint32_t offsetY = 0U; offsetY < 2U; ++offsetY)
+			{
+				for (uint32_t offsetX = 0U; offsetX < 2U; ++offsetX)
+				{
+					uint32_t sourceX = std::min(x * 2U + offsetX, source.width - 1U);
+					uint32_t sourceY = std::min(y * 2U + offsetY, source.height - 1U);
+					const float* pSource = &source.pixels[(static_cast<size_t>(sourceY) * source.width + sourceX) * 4U];
+					for (uint32_t channel = 0U; channel < 4U; ++channel)
+					{
+						sum[channel] += pSource[channel];
+					}
+				}
+			}
+
+			float* pResult = &result.pixels[(static_cast<size_t>(y) * result.width + x) * 4U];
+			for (uint32_t channel = 0U; channel < 4U; ++channel)
+			{
+				pResult[channel] = sum[channel] * 0.25f;
+			}
+
+			if (isNormalMap)
+			{
+				// Average normals in [-1, 1] and renormalize so that lower mips don't get shorter normals.
+				float normal[3] = { pResult[0] * 2.0f - 1.0f, pResult[1] * 2.0f - 1.0f, pResult[2] * 2.0f - 1.0f };
+				float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+				if (length > 0.0f)
+				{
+					for (uint32_t channel = 0U; channel < 3U; ++channel)
+					{
+						pResult[channel] = normal[channel] / length * 0.5f + 0.5f;
+					}
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+bool EncodeMip(const MipImage& mipImage, const TextureCookOptions& options, std::byte* pOutput)
+{
+	const bimg::TextureFormat::Enum format = GetBimgFormat(options.format);
+	const bimg::Quality::Enum quality = cd::MaterialTextureType::Normal == options.textureType ? bimg::Quality::NormalMapHighest : bimg::Quality::Highest;
+	const uint32_t blockColumnCount = (mipImage.width + 3U) / 4U;
+	const uint32_t blockRowCount = (mipImage.height + 3U) / 4U;
+	const size_t blockRowBytes = static_cast<size_t>(blockColumnCount) * GetBlockBytes(options.format);
+
+	// Blocks are stored row by row so strips of block rows encode independently and concatenate to the mip.
+	const uint32_t stripCount = (blockRowCount + StripBlockRowCount - 1U) / StripBlockRowCount;
+	std::atomic<uint32_t> nextStripIndex = 0U;
+	std::atomic<bool> succeeded = true;
+	auto EncodeStrips = [&]()
+	{
+		for (uint32_t stripIndex = nextStripIndex++; stripIndex < stripCount; stripIndex = nextStripIndex++)
+		{
+			uint32_t firstBlockRow = stripIndex * StripBlockRowCount;
+			uint32_t firstRow = firstBlockRow * 4U;
+			uint32_t rowCount = std::min(StripBlockRowCount * 4U, mipImage.height - firstRow);
+			const float* pSource = &mipImage.pixels[static_cast<size_t>(firstRow) * mipImage.width * 4U];
+			std::byte* pDestination = pOutput + firstBlockRow * blockRowBytes;
+
+			bx::Error error;
+			bimg::imageEncodeFromRgba32f(GetCookerAllocator(), pDestination, pSource, mipImage.width, rowCount, 1, format, quality, &error);
+			if (!error.isOk())
+			{
+				succeeded = false;
+			}
+		}
+	};
+
+	// Calling thread encodes strips too, so a mip finishes even when pool threads are busy with other textures.
+	StripEncodePool& pool = StripEncodePool::Get();
+	const uint32_t helperCount = std::min(stripCount - 1U, pool.GetThreadCount());
+	std::latch helpersDone(helperCount);
+	for (uint32_t helperIndex = 0U; helperIndex < helperCount; ++helperIndex)
+	{
+		pool.Submit([&EncodeStrips, &helpersDone]()
+		{
+			EncodeStrips();
+			helpersDone.count_down();
+		});
+	}
+
+	EncodeStrips();
+	helpersDone.wait();
+
+	return succeeded;
+}
+
+std::vector<uint64_t> ReadMipCache(const std::string& mipCacheFilePath, uint32_t width, uint32_t height, TextureCookFormat format)
+{
+	std::vector<uint64_t> mipHashes;
+	std::ifstream inputFile(mipCacheFilePath, std::ios::binary);
+	if (!inputFile.is_open())
+	{
+		return mipHashes;
+	}
+
+	uint32_t header[5];
+	inputFile.read(reinterpret_cast<char*>(header), sizeof(header));
+	if (!inputFile || header[0] != MipCacheMagic || header[1] != width || header[2] != height || header[3] != static_cast<uint32_t>(format))
+	{
+		return mipHashes;
+	}
+
+	mipHashes.resize(header[4]);
+	inputFile.read(reinterpret_cast<char*>(mipHashes.data()), mipHashes.size() * sizeof(uint64_t));
+	if (!inputFile)
+	{
+		mipHashes.clear();
+	}
+
+	return mipHashes;
+}
+
+void WriteMipCache(const std::string& mipCacheFilePath, uint32_t width, uint32_t height, TextureCookFormat format, const std::vector<uint64_t>& mipHashes)
+{
+	std::ofstream outputFile(mipCacheFilePath, std::ios::binary);
+	uint32_t header[5] = { MipCacheMagic, width, height, static_cast<uint32_t>(format), static_cast<uint32_t>(mipHashes.size()) };
+	outputFile.write(reinterpret_cast<const char*>(header), sizeof(header));
+	outputFile.write(reinterpret_cast<const char*>(mipHashes.data()), mipHashes.size() * sizeof(uint64_t));
+}
+
+}
+
+bool TextureCooker::Cook(const char* pInputFilePath, const char* pOutputFilePath, const TextureCookOptions& options)
+{
+	std::vector<std::byte> inputData = engine::ResourceLoader::LoadFile(pInputFilePath);
+	if (inputData.empty())
+	{
+		CD_ERROR("Failed to read texture {0}.", pInputFilePath);
+		return false;
+	}
+
+	bimg::ImageContainer* pSourceImage = bimg::imageParse(GetCookerAllocator(), inputData.data(), static_cast<uint32_t>(inputData.size()), bimg::TextureFormat::RGBA32F);
+	if (!pSourceImage)
+	{
+		CD_ERROR("Failed to decode texture {0}.", pInputFilePath);
+		return false;
+	}
+
+	std::vector<MipImage> mipImages;
+	MipImage& baseImage = mipImages.emplace_back();
+	baseImage.width = pSourceImage->m_width;
+	baseImage.height = pSourceImage->m_height;
+	baseImage.pixels.resize(static_cast<size_t>(baseImage.width) * baseImage.height * 4U);
+	std::memcpy(baseImage.pixels.data(), pSourceImage->m_data, baseImage.pixels.size() * sizeof(float));
+	bimg::imageFree(pSourceImage);
+
+	// Filter base color in linear space as texturec does for textures without --linear.
+	const bool isGamma = cd::MaterialTextureType::BaseColor == options.textureType;
+	const bool isNormalMap = cd::MaterialTextureType::Normal == options.textureType;
+	auto ToLinear = [isGamma](MipImage& mipImage)
+	{
+		for (size_t index = 0; isGamma && index < mipImage.pixels.size(); index += 4U)
+		{
+			for (size_t channel = 0; channel < 3U; ++channel)
+			{
+				mipImage.pixels[index + channel] = GammaToLinear(mipImage.pixels[index + channel]);
+			}
+		}
+	};
+	auto ToGamma = [isGamma](MipImage& mipImage)
+	{
+		for (size_t index = 0; isGamma && index < mipImage.pixels.size(); index += 4U)
+		{
+			for (size_t channel = 0; channel < 3U; ++channel)
+			{
+				mipImage.pixels[index + channel] = LinearToGamma(std::clamp(mipImage.pixels[index + channel], 0.0f, 1.0f));
+			}
+		}
+	};
+
+	ToLinear(mipImages.front());
+	while (mipImages.front().width > options.maxSize || mipImages.front().height > options.maxSize)
+	{
+		mipImages.front() = Downsample(mipImages.front(), isNormalMap);
+	}
+
+	while (options.generateMips && (mipImages.back().width > 1U || mipImages.back().height > 1U))
+	{
+		MipImage mipImage = Downsample(mipImages.back(), isNormalMap);
+		mipImages.push_back(cd::MoveTemp(mipImage));
+	}
+
+	for (MipImage& mipImage : mipImages)
+	{
+		ToGamma(mipImage);
+	}
+
+	const uint32_t width = mipImages.front().width;
+	const uint32_t height = mipImages.front().height;
+	const uint32_t mipCount = static_cast<uint32_t>(mipImages.size());
+	const bimg::TextureFormat::Enum format = GetBimgFormat(options.format);
+
+	// Unchanged mips are copied from the previous output.
+	std::string mipCacheFilePath = std::string(pOutputFilePath) + ".mipcache";
+	std::vector<uint64_t> oldMipHashes = ReadMipCache(mipCacheFilePath, width, height, options.format);
+	std::vector<std::byte> oldOutputData;
+	bimg::ImageContainer* pOldImage = nullptr;
+	if (!oldMipHashes.empty())
+	{
+		oldOutputData = engine::ResourceLoader::LoadFile(pOutputFilePath);
+		if (!oldOutputData.empty())
+		{
+			pOldImage = bimg::imageParse(GetCookerAllocator(), oldOutputData.data(), static_cast<uint32_t>(oldOutputData.size()));
+		}
+		if (pOldImage && (pOldImage->m_format != format || pOldImage->m_width != width || pOldImage->m_height != height))
+		{
+			bimg::imageFree(pOldImage);
+			pOldImage = nullptr;
+		}
+	}
+
+	bimg::ImageContainer* pOutputImage = bimg::imageAlloc(GetCookerAllocator(), format, static_cast<uint16_t>(width), static_cast<uint16_t>(height), 1, 1, false, mipCount > 1U);
+	std::vector<uint64_t> mipHashes(mipCount);
+	uint32_t reusedMipCount = 0U;
+	bool succeeded = true;
+	for (uint32_t mip = 0U; mip < mipCount && succeeded; ++mip)
+	{
+		const MipImage& mipImage = mipImages[mip];
+		// Options are hashed field by field to skip struct padding.
+		uint32_t optionValues[4] = { static_cast<uint32_t>(options.textureType), static_cast<uint32_t>(options.format), options.maxSize, options.generateMips ? 1U : 0U };
+		uint64_t mipHash = HashBytes(FNVOffsetBasis, optionValues, sizeof(optionValues));
+		mipHashes[mip] = HashBytes(mipHash, mipImage.pixels.data(), mipImage.pixels.size() * sizeof(float));
+
+		bimg::ImageMip outputMip;
+		bimg::imageGetRawData(*pOutputImage, 0, static_cast<uint8_t>(mip), pOutputImage->m_data, pOutputImage->m_size, outputMip);
+		auto* pOutputMipData = const_cast<std::byte*>(reinterpret_cast<const std::byte*>(outputMip.m_data));
+
+		bimg::ImageMip oldMip;
+		if (pOldImage && mip < oldMipHashes.size() && mip < pOldImage->m_numMips && oldMipHashes[mip] == mipHashes[mip] &&
+			bimg::imageGetRawData(*pOldImage, 0, static_cast<uint8_t>(mip), pOldImage->m_data, pOldImage->m_size, oldMip) &&
+			oldMip.m_size == outputMip.m_size)
+		{
+			std::memcpy(pOutputMipData, oldMip.m_data, oldMip.m_size);
+			++reusedMipCount;
+			continue;
+		}
+
+		succeeded = EncodeMip(mipImage, options, pOutputMipData);
+	}
+
+	if (pOldImage)
+	{
+		bimg::imageFree(pOldImage);
+	}
+
+	if (succeeded)
+	{
+		bx::FileWriter writer;
+		bx::Error error;
+		if (bx::open(&writer, bx::FilePath(pOutputFilePath), false, &error))
+		{
+			if (std::filesystem::path(pOutputFilePath).extension() == ".ktx")
+			{
+				bimg::imageWriteKtx(&writer, *pOutputImage, pOutputImage->m_data, pOutputImage->m_size, &error);
+			}
+			else
+			{
+				bimg::imageWriteDds(&writer, *pOutputImage, pOutputImage->m_data, pOutputImage->m_size, &error);
+			}
+			bx::close(&writer);
+		}
+		succeeded = error.isOk();
+	}
+	bimg::imageFree(pOutputImage);
+
+	if (!succeeded)
+	{
+		CD_ERROR("Failed to cook texture {0}.", pInputFilePath);
+		return false;
+	}
+
+	WriteMipCache(mipCacheFilePath, width, height, options.format, mipHashes);
+	CD_TRACE("Cooked texture {0} : {1}x{2}, {3} mips, {4} reused.", pOutputFilePath, width, height, mipCount, reusedMipCount);
+	return true;
+}
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Scene/MaterialTextureType.h"
+
+#include <cstdint>
+
+namespace editor
+{
+
+enum class TextureCookFormat : uint8_t
+{
+	BC1,
+	BC3,
+	BC5,
+	BC7,
+};
+
+struct TextureCookOptions
+{
+	cd::MaterialTextureType textureType = cd::MaterialTextureType::BaseColor;
+	// BC3 matches texturec outputs which runtime shaders expect.
+	TextureCookFormat format = TextureCookFormat::BC3;
+	// Mip 0 is halved until both sides fit.
+	uint32_t maxSize = 1024U;
+	bool generateMips = true;
+};
+
+// TextureCooker builds dds or ktx textures in process instead of running texturec per texture.
+// Mips are generated in float precision. Base color mips are filtered in linear space and normal map mips are renormalized.
+// Block compression of a mip is split into strips of block rows which encode in parallel.
+// Hashes of source mips are stored beside the output file so that unchanged mips are copied from the previous output.
+// It is thread safe to cook different output files at the same time.
+class TextureCooker final
+{
+public:
+	TextureCooker() = delete;
+	TextureCooker(const TextureCooker&) = delete;
+	TextureCooker& operator=(const TextureCooker&) = delete;
+	TextureCooker(TextureCooker&&) = delete;
+	TextureCooker& operator=(TextureCooker&&) = delete;
+	~TextureCooker() = delete;
+
+	// Output container is decided by the extension of output file path, ".ktx" or ".dds".
+	static bool Cook(const char* pInputFilePath, const char* pOutputFilePath, const TextureCookOptions& options);
+};
+
+}
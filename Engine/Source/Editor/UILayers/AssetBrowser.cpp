@@ -3,6 +3,7 @@
 #include "Consumers/CDConsumer/CDConsumer.h"
 #include "ECWorld/ECWorldConsumer.h"
 #include "ECWorld/MaterialComponent.h"
+#include "ECWorld/ModelImportJob.h"
 #include "ECWorld/SceneWorld.h"
 #include "ECWorld/StaticMeshComponent.h"
 #include "ECWorld/World.h"
@@ -12,16 +13,13 @@
 #include "ImGui/ImGuiUtils.hpp"
 #include "Log/Log.h"
 #include "Material/MaterialType.h"
-#include "Producers/CDProducer/CDProducer.h"
 #include "Producers/EffekseerProducer/EffekseerProducer.h"
 #include "Rendering/WorldRenderer.h"
 #include "Rendering/RenderContext.h"
+#include "Rendering/Resources/ResourceContext.h"
 #include "Resources/ResourceBuilder.h"
 #include "Resources/ResourceLoader.h"
-
-#ifdef ENABLE_GENERIC_PRODUCER
-#include "Producers/GenericProducer/GenericProducer.h"
-#endif
+#include "Resources/SceneCooker.h"
 
 #include <json/json.hpp>
 
@@ -71,7 +69,7 @@ bool IsShaderInputFile(const char* pFileExtension)
 
 bool IsModelInputFile(const char* pFileExtension)
 {
-	constexpr const char* pFileExtensions[] = { ".cdbin", ".dae", ".fbx", ".glb", ".gltf", ".md5mesh", ".obj"};
+	constexpr const char* pFileExtensions[] = { ".cdbin", ".cdscene", ".dae", ".fbx", ".glb", ".gltf", ".md5mesh", ".obj"};
 	constexpr const int fileExtensionsSize = sizeof(pFileExtensions) / sizeof(pFileExtensions[0]);
 	for (int extensionIndex = 0; extensionIndex < fileExtensionsSize; ++extensionIndex)
 	{
@@ -689,7 +687,7 @@ void AssetBrowser::UpdateAssetFileView()
 	ImGui::SliderFloat(" ", &m_gridSize, 40.0f, 160.0f, " ", ImGuiSliderFlags_AlwaysClamp | ImGuiSliderFlags_Logarithmic);
 }
 
-bool AssetBrowser::UpdateOptionDialog(const char* pTitle, bool& active, bool& importMesh, bool& importMaterial, bool& importTexture, bool& importAnimation, bool& importCamera, bool& importLight)
+bool AssetBrowser::UpdateOptionDialog(const char* pTitle, bool& active, bool& importMesh, bool& optimizeMesh, bool& importMaterial, bool& importTexture, bool& importAnimation, bool& importCamera, bool& importLight)
 {
 	if (!active)
 	{
@@ -710,6 +708,7 @@ bool AssetBrowser::UpdateOptionDialog(const char* pTitle, bool& active, bool& im
 		if (isMeshOpen)
 		{
 			ImGuiUtils::ImGuiBoolProperty("Mesh", importMesh);
+			ImGuiUtils::ImGuiBoolProperty("Optimize", optimizeMesh);
 		}
 
 		ImGui::Separator();
@@ -921,77 +920,70 @@ void AssetBrowser::ProcessSceneDatabase(cd::SceneDatabase* pSceneDatabase, bool
 }
 
 // Translate different 3D model file formats to memory data.
+// Import runs as a background job so that editor keeps responsive for large model files.
 void AssetBrowser::ImportModelFile(const char* pFilePath)
 {
-	engine::RenderContext* pCurrentRenderContext = GetRenderContext();
-	engine::SceneWorld* pSceneWorld = GetImGuiContextInstance()->GetSceneWorld();
-
-	cd::SceneDatabase* pSceneDatabase = pSceneWorld->GetSceneDatabase();
-	uint32_t oldNodeCount = pSceneDatabase->GetNodeCount();
-	uint32_t oldMeshCount = pSceneDatabase->GetMeshCount();
+	if (m_pModelImportJob)
+	{
+		CD_WARN("Importing {0} is in progress. Please wait for it to finish or cancel it.", m_pModelImportJob->GetFilePath());
+		return;
+	}
 
-	// Step 1 : Convert model file to cd::SceneDatabase
-	std::filesystem::path inputFilePath(pFilePath);
-	std::filesystem::path inputFileExtension = inputFilePath.extension();
-	if (0 == inputFileExtension.compare(".cdbin"))
+	engine::SceneWorld* pSceneWorld = GetImGuiContextInstance()->GetSceneWorld();
+	engine::MaterialType* pDefaultMaterialType = pSceneWorld->GetPBRMaterialType();
+#ifdef ENABLE_DDGI
+	if (m_importOptions.AssetType == IOAssetType::DDGIModel)
 	{
-		cdtools::CDProducer cdProducer(pFilePath);
-		cd::SceneDatabase newSceneDatabase;
-		cdtools::Processor processor(&cdProducer, nullptr, &newSceneDatabase);
-		processor.Run();
-		pSceneDatabase->Merge(cd::MoveTemp(newSceneDatabase));
+		pDefaultMaterialType = pSceneWorld->GetDDGIMaterialType();
 	}
-	else
+#endif
+
+	// Cooked scene is mapped and used in place so it is fast enough to load synchronously.
+	if (0 == std::filesystem::path(pFilePath).extension().compare(".cdscene"))
 	{
-#ifdef ENABLE_GENERIC_PRODUCER
-		cdtools::GenericProducer genericProducer(pFilePath);
-		genericProducer.EnableOption(cdtools::GenericProducerOptions::GenerateBoundingBox);
-		genericProducer.EnableOption(cdtools::GenericProducerOptions::CleanUnusedObjects);
-		genericProducer.EnableOption(cdtools::GenericProducerOptions::GenerateTangentSpace);
-		genericProducer.EnableOption(cdtools::GenericProducerOptions::TriangulateModel);
-		if (!m_importOptions.ImportAnimation)
+		engine::CookedScene* pCookedScene = GetRenderContext()->GetResourceContext()->AddCookedScene(pFilePath);
+		if (!pCookedScene)
 		{
-			genericProducer.EnableOption(cdtools::GenericProducerOptions::FlattenTransformHierarchy);
+			return;
 		}
 
-		cd::SceneDatabase newSceneDatabase;
-		cdtools::Processor processor(&genericProducer, nullptr, &newSceneDatabase);
-		processor.EnableOption(cdtools::ProcessorOptions::Dump);
-		processor.Run();
-		pSceneDatabase->Merge(cd::MoveTemp(newSceneDatabase));
-#else
-		assert("Unable to import this file format.");
-#endif
+		ECWorldConsumer ecWorldConsumer(pSceneWorld, GetRenderContext());
+		ecWorldConsumer.SetDefaultMaterialType(pDefaultMaterialType);
+		ecWorldConsumer.ExecuteCookedScene(pCookedScene);
+		return;
 	}
 
-	// Step 2 : Process generated cd::SceneDatabase
-	ProcessSceneDatabase(pSceneDatabase, m_importOptions.ImportMesh, m_importOptions.ImportMaterial, m_importOptions.ImportTexture,
-		m_importOptions.ImportCamera, m_importOptions.ImportLight);
+	m_pModelImportJob = std::make_unique<ModelImportJob>(pFilePath, m_currentDirectory->FilePath.string(), m_importOptions);
+	m_pModelImportJob->Start(pSceneWorld, GetRenderContext(), pDefaultMaterialType);
+}
 
-	// Step 3 : Convert cd::SceneDatabase to entities and components
+void AssetBrowser::UpdateModelImportJob()
+{
+	if (!m_pModelImportJob)
 	{
-		ECWorldConsumer ecConsumer(pSceneWorld, pCurrentRenderContext);
-		ecConsumer.SetDefaultMaterialType(pSceneWorld->GetPBRMaterialType());
-		ecConsumer.SetSceneDatabaseIDs(oldNodeCount, oldMeshCount);
-#ifdef ENABLE_DDGI
-		if (m_importOptions.AssetType == IOAssetType::DDGIModel)
-		{
-			ecConsumer.SetDefaultMaterialType(pSceneWorld->GetDDGIMaterialType());
-		}
-#endif
-		cdtools::Processor processor(nullptr, &ecConsumer, pSceneDatabase);
-		processor.EnableOption(cdtools::ProcessorOptions::Dump);
-		processor.Run();
+		return;
 	}
 
-	// Step 4 : Convert cd::SceneDatabase to cd asset files and save in disk
+	if (m_pModelImportJob->Update())
 	{
-		cdtools::CDConsumer cdConsumer(m_currentDirectory->FilePath.string().c_str());
-		cdConsumer.SetExportMode(cdtools::ExportMode::XmlBinary);
-		cdtools::Processor processor(nullptr, &cdConsumer, pSceneDatabase);
-		processor.DisableOption(cdtools::ProcessorOptions::Dump);
-		processor.Run();
+		m_pModelImportJob.reset();
+		return;
 	}
+
+	auto flags = ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings;
+	ImGui::Begin("Import Model", nullptr, flags);
+	ImGui::TextUnformatted(std::filesystem::path(m_pModelImportJob->GetFilePath()).filename().string().c_str());
+	ImGui::TextUnformatted(m_pModelImportJob->GetStageName());
+	ImGui::ProgressBar(m_pModelImportJob->GetProgress(), ImVec2(300.0f, 0.0f));
+	if (m_pModelImportJob->IsCancelRequested())
+	{
+		ImGui::TextUnformatted("Cancelling...");
+	}
+	else if (ImGui::Button("Cancel"))
+	{
+		m_pModelImportJob->Cancel();
+	}
+	ImGui::End();
 }
 
 void AssetBrowser::ImportJson(const char* pFilePath)
@@ -1167,6 +1159,14 @@ void AssetBrowser::ExportAssetFile(const char* pFilePath)
 		}
 
 		std::filesystem::path selectFilePath(pFilePath);
+		if (0 == selectFilePath.extension().compare(".cdscene"))
+		{
+			// Cooked scene only keeps data which runtime needs to render static meshes.
+			engine::MeshOptimizeOptions optimizeOptions = m_exportOptions.OptimizeMesh ? engine::MeshOptimizeOptions::All() : engine::MeshOptimizeOptions{};
+			SceneCooker::Cook(*pSceneDatabase, pSceneWorld->GetPBRMaterialType()->GetRequiredVertexFormat(), selectFilePath.string().c_str(), optimizeOptions);
+			return;
+		}
+
 		std::filesystem::path outputFilePath = selectFilePath.replace_extension(".cdbin");
 		cdtools::CDConsumer consumer(outputFilePath.string().c_str());
 		cdtools::Processor processor(nullptr, &consumer, pSceneDatabase);
@@ -1201,12 +1201,14 @@ void AssetBrowser::Update()
 
 	ImGui::End();
 
+	UpdateModelImportJob();
+
 	m_pImportFileBrowser->Display();
 	if (m_pImportFileBrowser->HasSelected())
 	{
 		m_importOptions.Active = true;
 	}
-	if (UpdateOptionDialog("Import Options", m_importOptions.Active, m_importOptions.ImportMesh, m_importOptions.ImportMaterial, m_importOptions.ImportTexture,
+	if (UpdateOptionDialog("Import Options", m_importOptions.Active, m_importOptions.ImportMesh, m_importOptions.OptimizeMesh, m_importOptions.ImportMaterial, m_importOptions.ImportTexture,
 		m_importOptions.ImportAnimation, m_importOptions.ImportCamera, m_importOptions.ImportLight))
 	{
 		ImportAssetFile(m_pImportFileBrowser->GetSelected().string().c_str());
@@ -1219,7 +1221,7 @@ void AssetBrowser::Update()
 		m_exportOptions.Active = true;
 	}
 
-	if (UpdateOptionDialog("Export Options", m_exportOptions.Active, m_exportOptions.ExportMesh, m_exportOptions.ExportMaterial, m_exportOptions.ExportTexture,
+	if (UpdateOptionDialog("Export Options", m_exportOptions.Active, m_exportOptions.ExportMesh, m_exportOptions.OptimizeMesh, m_exportOptions.ExportMaterial, m_exportOptions.ExportTexture,
 		m_importOptions.ImportAnimation, m_exportOptions.ExportCamera, m_exportOptions.ExportLight))
 	{
 		ExportAssetFile(m_pExportFileBrowser->GetSelected().string().c_str());
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "Base/Platform.h"
 #include "ImGui/ImGuiBaseLayer.h"
 
@@ -29,6 +31,8 @@ class Renderer;
 namespace editor
 {
 
+class ModelImportJob;
+
 enum class IOAssetType
 {
 	CubeMap,
@@ -50,6 +54,7 @@ struct AssetImportOptions
 	bool ImportLight = false;
 	bool ImportMaterial = true;
 	bool ImportMesh = true;
+	bool OptimizeMesh = false;
 	bool ImportTexture = true;
 	bool ImportAnimation = false;
 };
@@ -62,6 +67,7 @@ struct AssetExportOptions
 	bool ExportLight = true;
 	bool ExportMaterial = true;
 	bool ExportMesh = true;
+	bool OptimizeMesh = true;
 	bool ExportTexture = true;
 };
 
@@ -93,9 +99,11 @@ public:
 	void ImportAssetFile(const char* pFilePath);
 	void ExportAssetFile(const char* pFilePath);
 
+	static void ProcessSceneDatabase(cd::SceneDatabase* pSceneDatabase, bool keepMesh, bool keepMaterial, bool keepTexture, bool keepCamera, bool keepLight);
+
 private:
-	void ProcessSceneDatabase(cd::SceneDatabase* pSceneDatabase, bool keepMesh, bool keepMaterial, bool keepTexture, bool keepCamera, bool keepLight);
 	void ImportModelFile(const char* pFilePath);
+	void UpdateModelImportJob();
 	void ImportParticleEffect(const char* pFilePath);
 	void ImportJson(const char* pFilePath);
 	void DrawFolder(const std::shared_ptr<DirectoryInformation>& dirInfo, bool defaultOpen = false);
@@ -110,13 +118,14 @@ private:
 
 	void UpdateAssetFolderTree();
 	void UpdateAssetFileView();
-	bool UpdateOptionDialog(const char* pTitle, bool& active, bool& importMesh, bool& importMaterial, bool& importTexture, bool& importAnimation, bool& importCamera, bool& importLight);
+	bool UpdateOptionDialog(const char* pTitle, bool& active, bool& importMesh, bool& optimizeMesh, bool& importMaterial, bool& importTexture, bool& importAnimation, bool& importCamera, bool& importLight);
 
 private:
 	AssetImportOptions m_importOptions;
 	AssetExportOptions m_exportOptions;
 	std::unique_ptr<ImGui::FileBrowser> m_pImportFileBrowser;
 	std::unique_ptr<ImGui::FileBrowser> m_pExportFileBrowser;
+	std::unique_ptr<ModelImportJob> m_pModelImportJob;
 
 	engine::Renderer* m_pSceneRenderer = nullptr;
 
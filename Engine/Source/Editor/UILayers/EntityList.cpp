@@ -7,9 +7,11 @@
 #include "ImGui/ImGuiContextInstance.h"
 #include "Math/MeshGenerator.h"
 #include "Math/Sphere.hpp"
+#include "Path/Path.h"
 #include "Rendering/RenderContext.h"
 #include "Rendering/Resources/MeshResource.h"
 #include "Rendering/Resources/ResourceContext.h"
+#include "Terrain/TerrainTileStreamer.h"
 
 #include <bgfx/bgfx.h>
 #include <imgui/imgui_internal.h>
@@ -24,6 +26,7 @@ EntityList::~EntityList()
 
 void EntityList::Init()
 {
+    m_pTreeModel = std::make_unique<EntityTreeModel>();
 }
 
 void EntityList::AddEntity(engine::SceneWorld* pSceneWorld)
@@ -58,7 +61,6 @@ void EntityList::AddEntity(engine::SceneWorld* pSceneWorld)
         auto& collisionMeshComponent = pWorld->CreateComponent<engine::CollisionMeshComponent>(entity);
         collisionMeshComponent.SetType(engine::CollisonMeshType::AABB);
         collisionMeshComponent.SetAABB(newAddedShape.GetAABB());
-        collisionMeshComponent.Build();
 
         auto& staticMeshComponent = pWorld->CreateComponent<engine::StaticMeshComponent>(entity);
         engine::MeshResource* pMeshResource = pResourceContext->AddMeshResource(meshOriginNameCrc);
@@ -144,6 +146,52 @@ void EntityList::AddEntity(engine::SceneWorld* pSceneWorld)
         transformComponent.SetTransform(cd::Transform::Identity());
         transformComponent.Build();
     }
+    else if (ImGui::MenuItem("Add Chunked Terrain"))
+    {
+        engine::Entity entity = AddNamedEntity("ChunkedTerrain");
+
+        auto& terrainComponent = pWorld->CreateComponent<engine::TerrainComponent>(entity);
+        terrainComponent.SetChunked(true);
+        terrainComponent.SetTileDirectory(engine::Path::Join(CDPROJECT_RESOURCES_ROOT_PATH, "Terrain", "Tiles"));
+        terrainComponent.SetTileCount(2U, 2U);
+
+        // Generate demo tiles for the first time. Real projects should cook their own heightmap tiles into the directory.
+        const std::string& tileDirectory = terrainComponent.GetTileDirectory();
+        if (!engine::Path::FileExists(engine::TerrainTileStreamer::GetTileFilePath(tileDirectory, 0U, 0U).c_str()))
+        {
+            const uint16_t width = terrainComponent.GetTileCountX() * terrainComponent.GetTileSize() + 1U;
+            const uint16_t depth = terrainComponent.GetTileCountZ() * terrainComponent.GetTileSize() + 1U;
+            std::optional<std::vector<std::byte>> optElevationMap = engine::GenerateElevationMap(width, depth, 1.55f, 0.0f, 60.0f);
+            assert(optElevationMap.has_value());
+            engine::WriteElevationTiles(reinterpret_cast<const float*>(optElevationMap.value().data()), width, depth, terrainComponent.GetTileSize(), tileDirectory);
+        }
+
+        // All chunks share one grid mesh which is scaled and morphed in the vertex shader.
+        static std::optional<cd::Mesh> optMesh = engine::GenerateTerrainChunkMesh(terrainComponent.GetChunkSize(), pTerrainMaterialType->GetRequiredVertexFormat());
+        assert(optMesh.has_value());
+        cd::Mesh& mesh = optMesh.value();
+
+        auto& meshComponent = pWorld->CreateComponent<engine::StaticMeshComponent>(entity);
+        constexpr engine::StringCrc nameCrc("TerrainChunkMesh");
+        engine::MeshResource* pMeshResource = pResourceContext->AddMeshResource(nameCrc);
+        pMeshResource->SetMeshAsset(&mesh);
+        pMeshResource->UpdateVertexFormat(pTerrainMaterialType->GetRequiredVertexFormat());
+        meshComponent.SetMeshResource(pMeshResource);
+
+        mesh.SetName(pSceneWorld->GetNameComponent(entity)->GetName());
+        mesh.SetID(cd::MeshID(pSceneDatabase->GetMeshCount()));
+        pSceneDatabase->AddMesh(cd::MoveTemp(mesh));
+
+        auto& materialComponent = pWorld->CreateComponent<engine::MaterialComponent>(entity);
+        materialComponent.Init();
+        materialComponent.SetMaterialType(pTerrainMaterialType);
+        materialComponent.SetTwoSided(true);
+        materialComponent.ActivateShaderFeature(engine::GetSkyTypeShaderFeature(pSceneWorld->GetSkyComponent(pSceneWorld->GetSkyEntity())->GetSkyType()));
+
+        auto& transformComponent = pWorld->CreateComponent<engine::TransformComponent>(entity);
+        transformComponent.SetTransform(cd::Transform::Identity());
+        transformComponent.Build();
+    }
 
     // ---------------------------------------- Add Camera ---------------------------------------- //
 
@@ -265,18 +313,14 @@ void EntityList::AddEntity(engine::SceneWorld* pSceneWorld)
     }
 }
 
-void EntityList::DrawEntity(engine::SceneWorld* pSceneWorld, engine::Entity entity)
+void EntityList::DrawEntity(engine::SceneWorld* pSceneWorld, const EntityTreeRow& row)
 {
+    engine::Entity entity = row.entity;
     engine::NameComponent* pNameComponent = pSceneWorld->GetNameComponent(entity);
     if (!pNameComponent)
     {
-        // Entity list requires entity to have name component to display.
-        return;
-    }
-
-    // When you use the entity filter, it will skip drawing entites which doesn't pass the filter conditions.
-    if (m_entityFilter.IsActive() && !m_entityFilter.PassFilter(pNameComponent->GetName()))
-    {
+        // Entity was deleted by a previous row in this frame. Keep row height for the list clipper.
+        ImGui::Dummy(ImVec2(0.0f, ImGui::GetFrameHeight()));
         return;
     }
 
@@ -289,9 +333,9 @@ void EntityList::DrawEntity(engine::SceneWorld* pSceneWorld, engine::Entity enti
         nodeFlags |= ImGuiTreeNodeFlags_Selected;
     }
 
-    // TODO : hierarchy or not?
-    bool hasNoChildren = true;
-    if (hasNoChildren)
+    // Children rows are flattened by the tree model, so tree nodes don't push ids and indents.
+    nodeFlags |= ImGuiTreeNodeFlags_NoTreePushOnOpen;
+    if (!row.hasChildren)
     {
         nodeFlags |= ImGuiTreeNodeFlags_Leaf;
     }
@@ -317,13 +361,35 @@ void EntityList::DrawEntity(engine::SceneWorld* pSceneWorld, engine::Entity enti
         entityIcon = reinterpret_cast<const char*>(ICON_MDI_SHAPE);
     }
 
+    const float indent = static_cast<float>(row.depth) * ImGui::GetStyle().IndentSpacing;
+    if (indent > 0.0f)
+    {
+        ImGui::Indent(indent);
+    }
+
+    if (row.hasChildren)
+    {
+        ImGui::SetNextItemOpen(m_pTreeModel->IsExpanded(entity));
+    }
+
     ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyle().Colors[ImGuiCol_Text]);
     bool isNodeOpen = ImGui::TreeNodeEx(pNameComponent->GetName(), nodeFlags, "%s", entityIcon);
     ImGui::PopStyleColor();
 
+    if (row.hasChildren && isNodeOpen != m_pTreeModel->IsExpanded(entity))
+    {
+        // Rows are rebuilt in the next frame as this one is still iterating them.
+        m_pTreeModel->SetExpanded(entity, isNodeOpen);
+    }
+
     ImGui::SameLine();
 
     ImGui::Selectable(pNameComponent->GetName());
+
+    if (indent > 0.0f)
+    {
+        ImGui::Unindent(indent);
+    }
     
     if (!isEntityActive)
     {
@@ -334,6 +400,13 @@ void EntityList::DrawEntity(engine::SceneWorld* pSceneWorld, engine::Entity enti
     {
         if (ImGui::Selectable(CD_TEXT("Add Child")))
         {
+            engine::World* pWorld = pSceneWorld->GetWorld();
+            engine::Entity childEntity = pWorld->CreateEntity();
+            auto& nameComponent = pWorld->CreateComponent<engine::NameComponent>(childEntity);
+            nameComponent.SetName("Entity" + std::to_string(childEntity));
+            auto& hierarchyComponent = pWorld->CreateComponent<engine::HierarchyComponent>(childEntity);
+            hierarchyComponent.SetParentEntity(entity);
+            m_pTreeModel->SetExpanded(entity, true);
         }
 
         if (ImGui::Selectable(CD_TEXT("Rename")))
@@ -388,20 +461,6 @@ void EntityList::DrawEntity(engine::SceneWorld* pSceneWorld, engine::Entity enti
     //    }
     //}
 
-    if (!isNodeOpen)
-    {
-        ImGui::PopID();
-        return;
-    }
-
-    const ImColor TreeLineColor(128, 128, 128, 128);
-    constexpr float SmallOffsetX = 6.0f;
-    ImVec2 verticalLineStart = ImGui::GetCursorScreenPos();
-    verticalLineStart.x += SmallOffsetX; // to nicely line up with the arrow symbol
-    ImVec2 verticalLineEnd = verticalLineStart;
-    ImGui::GetWindowDrawList()->AddLine(verticalLineStart, verticalLineEnd, TreeLineColor);
-
-    ImGui::TreePop();
     ImGui::PopID();
 }
 
@@ -431,7 +490,10 @@ void EntityList::Update()
     ImGui::PushFont(ImGui::GetIO().Fonts->Fonts[0]);
     ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 0.0f);
     ImGui::PushStyleColor(ImGuiCol_FrameBg, IM_COL32(0, 0, 0, 0));
-    m_entityFilter.Draw("##EntityFilter", ImGui::GetContentRegionAvail().x - ImGui::GetStyle().IndentSpacing);
+    if (m_entityFilter.Draw("##EntityFilter", ImGui::GetContentRegionAvail().x - ImGui::GetStyle().IndentSpacing))
+    {
+        m_pTreeModel->SetSearchText(m_entityFilter.InputBuf);
+    }
     auto* drawList = ImGui::GetWindowDrawList();
 
     ImRect expandedRect = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
@@ -473,10 +535,24 @@ void EntityList::Update()
 
     ImGui::BeginChild("Entites");
 
-    for (engine::Entity entity : pSceneWorld->GetNameEntities())
+    m_pTreeModel->Update(pSceneWorld);
+    if (m_pTreeModel->IsSearchPending())
     {
-        DrawEntity(pSceneWorld, entity);
+        ImGui::TextDisabled("Searching...");
+    }
+
+    // Only visible rows are submitted so large scenes cost the same as small ones.
+    const std::vector<EntityTreeRow>& rows = m_pTreeModel->GetRows();
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(rows.size()));
+    while (clipper.Step())
+    {
+        for (int rowIndex = clipper.DisplayStart; rowIndex < clipper.DisplayEnd; ++rowIndex)
+        {
+            DrawEntity(pSceneWorld, rows[rowIndex]);
+        }
     }
+    clipper.End();
 
     ImGui::Indent();
 
@@ -1,6 +1,7 @@
 #include "ImGui/ImGuiBaseLayer.h"
 
 #include "ECWorld/Entity.h"
+#include "EntityTreeModel.h"
 
 #include <imgui/imgui.h>
 #include <memory>
@@ -26,13 +27,14 @@ public:
 	virtual void Update() override;
 
 	void AddEntity(engine::SceneWorld* pSceneWorld);
-	void DrawEntity(engine::SceneWorld* pSceneWorld, engine::Entity entity);
+	void DrawEntity(engine::SceneWorld* pSceneWorld, const EntityTreeRow& row);
 
 	void SetCameraController(engine::CameraController* pCameraController) { m_pCameraController = pCameraController; }
 
 
 private:
 	ImGuiTextFilter m_entityFilter;
+	std::unique_ptr<EntityTreeModel> m_pTreeModel;
 	engine::CameraController* m_pCameraController = nullptr;
 };
 
@@ -0,0 +1,391 @@
+#include "EntityTreeModel.h"
+
+#include "Base/Template.h"
+#include "ECWorld/SceneWorld.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+namespace
+{
+
+struct SearchTerm
+{
+	std::string_view text;
+	bool isExclude;
+};
+
+// Splits text into terms in the same way as ImGuiTextFilter.
+std::vector<SearchTerm> ParseSearchTerms(std::string_view text)
+{
+	std::vector<SearchTerm> terms;
+	size_t begin = 0U;
+	while (begin <= text.size())
+	{
+		size_t end = text.find(',', begin);
+		if (end == std::string_view::npos)
+		{
+			end = text.size();
+		}
+
+		std::string_view term = text.substr(begin, end - begin);
+		while (!term.empty() && std::isspace(static_cast<unsigned char>(term.front())))
+		{
+			term.remove_prefix(1U);
+		}
+		while (!term.empty() && std::isspace(static_cast<unsigned char>(term.back())))
+		{
+			term.remove_suffix(1U);
+		}
+
+		bool isExclude = !term.empty() && '-' == term.front();
+		if (isExclude)
+		{
+			term.remove_prefix(1U);
+		}
+
+		if (!term.empty())
+		{
+			terms.push_back(SearchTerm{ term, isExclude });
+		}
+
+		begin = end + 1U;
+	}
+
+	return terms;
+}
+
+bool ContainsNoCase(std::string_view text, std::string_view term)
+{
+	auto it = std::search(text.begin(), text.end(), term.begin(), term.end(), [](char lhs, char rhs)
+	{
+		return std::tolower(static_cast<unsigned char>(lhs)) == std::tolower(static_cast<unsigned char>(rhs));
+	});
+
+	return it != text.end();
+}
+
+bool PassSearchTerms(const std::vector<SearchTerm>& terms, std::string_view name)
+{
+	bool hasIncludeTerm = false;
+	bool isIncluded = false;
+	for (const SearchTerm& term : terms)
+	{
+		if (term.isExclude)
+		{
+			if (ContainsNoCase(name, term.text))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			hasIncludeTerm = true;
+			isIncluded = isIncluded || ContainsNoCase(name, term.text);
+		}
+	}
+
+	return !hasIncludeTerm || isIncluded;
+}
+
+}
+
+namespace editor
+{
+
+EntityTreeModel::EntityTreeModel()
+{
+	m_searchThread = std::thread(&EntityTreeModel::SearchMain, this);
+}
+
+EntityTreeModel::~EntityTreeModel()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_searchMutex);
+		m_isSearchThreadRunning = false;
+	}
+	m_searchGeneration.fetch_add(1U, std::memory_order_relaxed);
+	m_searchCondition.notify_one();
+
+	if (m_searchThread.joinable())
+	{
+		m_searchThread.join();
+	}
+}
+
+void EntityTreeModel::Update(const engine::SceneWorld* pSceneWorld)
+{
+	const std::vector<engine::Entity>& nameEntities = pSceneWorld->GetNameEntities();
+	uint64_t nameVersion = pSceneWorld->GetNameStorageVersion();
+	uint64_t hierarchyVersion = pSceneWorld->GetHierarchyStorageVersion();
+	if (nameVersion != m_nameVersion || hierarchyVersion != m_hierarchyVersion)
+	{
+		// Every created component increases version by one, so equal deltas mean entities were only appended.
+		bool isAppendOnly = m_nameVersion != UINT64_MAX && hierarchyVersion == m_hierarchyVersion &&
+			nameEntities.size() >= m_nameCount && nameVersion - m_nameVersion == nameEntities.size() - m_nameCount;
+		if (!isAppendOnly || !AppendEntities(pSceneWorld, m_nameCount))
+		{
+			Rebuild(pSceneWorld);
+		}
+
+		m_nameVersion = nameVersion;
+		m_hierarchyVersion = hierarchyVersion;
+		m_nameCount = nameEntities.size();
+		m_isTreeRowsDirty = true;
+		m_isSearchDirty = IsSearchActive();
+	}
+
+	if (IsSearchActive())
+	{
+		if (m_isSearchDirty)
+		{
+			RequestSearch();
+		}
+		UpdateSearchRows(pSceneWorld);
+	}
+	else if (m_isTreeRowsDirty)
+	{
+		RebuildTreeRows();
+	}
+}
+
+void EntityTreeModel::SetExpanded(engine::Entity entity, bool expanded)
+{
+	bool isChanged = expanded ? m_expandedEntities.insert(entity).second : m_expandedEntities.erase(entity) > 0U;
+	m_isTreeRowsDirty = m_isTreeRowsDirty || isChanged;
+}
+
+void EntityTreeModel::SetSearchText(const char* pText)
+{
+	if (m_searchText == pText)
+	{
+		return;
+	}
+
+	m_searchText = pText;
+	if (IsSearchActive())
+	{
+		m_isSearchDirty = true;
+	}
+	else
+	{
+		// Cancel the running query.
+		m_searchGeneration.fetch_add(1U, std::memory_order_relaxed);
+		m_searchRows.clear();
+	}
+}
+
+void EntityTreeModel::Rebuild(const engine::SceneWorld* pSceneWorld)
+{
+	m_rootEntities.clear();
+	m_childEntities.clear();
+	m_unnamedParentEntities.clear();
+	m_nameIndex.clear();
+
+	AddNames(pSceneWorld, 0U);
+	for (engine::Entity entity : pSceneWorld->GetNameEntities())
+	{
+		AddTreeEntity(pSceneWorld, entity);
+	}
+}
+
+bool EntityTreeModel::AppendEntities(const engine::SceneWorld* pSceneWorld, size_t beginIndex)
+{
+	const std::vector<engine::Entity>& nameEntities = pSceneWorld->GetNameEntities();
+	for (size_t index = beginIndex; index < nameEntities.size(); ++index)
+	{
+		if (m_unnamedParentEntities.find(nameEntities[index]) != m_unnamedParentEntities.end())
+		{
+			return false;
+		}
+	}
+
+	AddNames(pSceneWorld, beginIndex);
+	for (size_t index = beginIndex; index < nameEntities.size(); ++index)
+	{
+		AddTreeEntity(pSceneWorld, nameEntities[index]);
+	}
+
+	return true;
+}
+
+void EntityTreeModel::AddNames(const engine::SceneWorld* pSceneWorld, size_t beginIndex)
+{
+	const std::vector<engine::Entity>& nameEntities = pSceneWorld->GetNameEntities();
+	size_t index = beginIndex;
+	while (index < nameEntities.size())
+	{
+		// Published chunks may be read by the search thread, so the last one is copied before appending.
+		std::shared_ptr<NameChunk> pChunk;
+		if (!m_nameIndex.empty() && m_nameIndex.back()->size() < NameChunkSize)
+		{
+			pChunk = std::make_shared<NameChunk>(*m_nameIndex.back());
+			m_nameIndex.pop_back();
+		}
+		else
+		{
+			pChunk = std::make_shared<NameChunk>();
+			pChunk->reserve(std::min(NameChunkSize, nameEntities.size() - index));
+		}
+
+		for (; index < nameEntities.size() && pChunk->size() < NameChunkSize; ++index)
+		{
+			engine::Entity entity = nameEntities[index];
+			pChunk->push_back(NameEntry{ entity, pSceneWorld->GetNameComponent(entity)->GetName() });
+		}
+
+		m_nameIndex.push_back(cd::MoveTemp(pChunk));
+	}
+}
+
+void EntityTreeModel::AddTreeEntity(const engine::SceneWorld* pSceneWorld, engine::Entity entity)
+{
+	engine::Entity parentEntity = engine::INVALID_ENTITY;
+	if (const engine::HierarchyComponent* pHierarchyComponent = pSceneWorld->GetHierarchyComponent(entity))
+	{
+		parentEntity = pHierarchyComponent->GetParentEntity();
+	}
+
+	if (engine::INVALID_ENTITY == parentEntity || parentEntity == entity)
+	{
+		m_rootEntities.push_back(entity);
+	}
+	else if (!pSceneWorld->GetNameComponent(parentEntity))
+	{
+		m_unnamedParentEntities.insert(parentEntity);
+		m_rootEntities.push_back(entity);
+	}
+	else
+	{
+		m_childEntities[parentEntity].push_back(entity);
+	}
+}
+
+void EntityTreeModel::RebuildTreeRows()
+{
+	m_treeRows.clear();
+	m_isTreeRowsDirty = false;
+
+	// Depth first without recursion as hierarchies can be deep.
+	std::vector<std::pair<engine::Entity, uint32_t>> pendingEntities;
+	for (auto it = m_rootEntities.rbegin(); it != m_rootEntities.rend(); ++it)
+	{
+		pendingEntities.emplace_back(*it, 0U);
+	}
+
+	while (!pendingEntities.empty())
+	{
+		auto [entity, depth] = pendingEntities.back();
+		pendingEntities.pop_back();
+
+		auto itChildren = m_childEntities.find(entity);
+		bool hasChildren = itChildren != m_childEntities.end();
+		m_treeRows.push_back(EntityTreeRow{ entity, depth, hasChildren });
+
+		if (hasChildren && IsExpanded(entity))
+		{
+			const std::vector<engine::Entity>& childEntities = itChildren->second;
+			for (auto it = childEntities.rbegin(); it != childEntities.rend(); ++it)
+			{
+				pendingEntities.emplace_back(*it, depth + 1U);
+			}
+		}
+	}
+}
+
+void EntityTreeModel::RequestSearch()
+{
+	m_isSearchDirty = false;
+
+	// Bumping generation makes the search thread drop the query in progress.
+	uint64_t generation = m_searchGeneration.fetch_add(1U, std::memory_order_relaxed) + 1U;
+	{
+		std::lock_guard<std::mutex> lock(m_searchMutex);
+		m_searchRequest.generation = generation;
+		m_searchRequest.text = m_searchText;
+		m_searchRequest.nameIndex = m_nameIndex;
+	}
+	m_searchCondition.notify_one();
+}
+
+void EntityTreeModel::UpdateSearchRows(const engine::SceneWorld* pSceneWorld)
+{
+	std::vector<engine::Entity> searchResult;
+	{
+		std::lock_guard<std::mutex> lock(m_searchMutex);
+		if (m_resultGeneration == m_searchRowsGeneration || m_resultGeneration != m_searchGeneration.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		searchResult = cd::MoveTemp(m_searchResult);
+		m_searchRowsGeneration = m_resultGeneration;
+	}
+
+	m_searchRows.clear();
+	m_searchRows.reserve(searchResult.size());
+	for (engine::Entity entity : searchResult)
+	{
+		// Skip entities deleted while searching.
+		if (pSceneWorld->GetNameComponent(entity))
+		{
+			m_searchRows.push_back(EntityTreeRow{ entity, 0U, false });
+		}
+	}
+}
+
+void EntityTreeModel::SearchMain()
+{
+	uint64_t processedGeneration = 0U;
+	while (true)
+	{
+		SearchRequest request;
+		{
+			std::unique_lock<std::mutex> lock(m_searchMutex);
+			m_searchCondition.wait(lock, [this, processedGeneration]()
+			{
+				return !m_isSearchThreadRunning || m_searchRequest.generation != processedGeneration;
+			});
+
+			if (!m_isSearchThreadRunning)
+			{
+				return;
+			}
+
+			request = m_searchRequest;
+			processedGeneration = request.generation;
+		}
+
+		std::vector<SearchTerm> terms = ParseSearchTerms(request.text);
+		std::vector<engine::Entity> searchResult;
+		bool isCancelled = false;
+		for (const std::shared_ptr<const NameChunk>& pChunk : request.nameIndex)
+		{
+			if (m_searchGeneration.load(std::memory_order_relaxed) != request.generation)
+			{
+				isCancelled = true;
+				break;
+			}
+
+			for (const NameEntry& entry : *pChunk)
+			{
+				if (PassSearchTerms(terms, entry.name))
+				{
+					searchResult.push_back(entry.entity);
+				}
+			}
+		}
+
+		if (isCancelled)
+		{
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(m_searchMutex);
+		m_resultGeneration = request.generation;
+		m_searchResult = cd::MoveTemp(searchResult);
+	}
+}
+
+}
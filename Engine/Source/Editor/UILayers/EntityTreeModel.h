@@ -0,0 +1,123 @@
+#pragma once
+
+#include "ECWorld/Entity.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace engine
+{
+
+class SceneWorld;
+
+}
+
+namespace editor
+{
+
+struct EntityTreeRow
+{
+	engine::Entity entity;
+	uint32_t depth;
+	bool hasChildren;
+};
+
+// Cached hierarchy of named entities for EntityList. Parents come from HierarchyComponent and entities
+// without a named parent are roots. The tree is only rebuilt when Name or Hierarchy storages change and
+// entities which are just created are appended in place. Rows are flattened so ImGuiListClipper draws visible ones only.
+// Name search runs in a background thread over a snapshot of names and replaces rows with matches when it finishes.
+class EntityTreeModel final
+{
+public:
+	EntityTreeModel();
+	EntityTreeModel(const EntityTreeModel&) = delete;
+	EntityTreeModel& operator=(const EntityTreeModel&) = delete;
+	EntityTreeModel(EntityTreeModel&&) = delete;
+	EntityTreeModel& operator=(EntityTreeModel&&) = delete;
+	~EntityTreeModel();
+
+	// Call once per frame on the main thread before reading rows. Renaming or reparenting in place
+	// needs a MarkChanged call on the storage to be noticed.
+	void Update(const engine::SceneWorld* pSceneWorld);
+
+	bool IsExpanded(engine::Entity entity) const { return m_expandedEntities.find(entity) != m_expandedEntities.end(); }
+	void SetExpanded(engine::Entity entity, bool expanded);
+
+	// Same syntax as ImGuiTextFilter : comma separated terms and "-" excludes. Empty text shows the tree.
+	void SetSearchText(const char* pText);
+	bool IsSearchActive() const { return !m_searchText.empty(); }
+	bool IsSearchPending() const { return IsSearchActive() && m_searchRowsGeneration != m_searchGeneration.load(std::memory_order_relaxed); }
+
+	const std::vector<EntityTreeRow>& GetRows() const { return IsSearchActive() ? m_searchRows : m_treeRows; }
+
+private:
+	struct NameEntry
+	{
+		engine::Entity entity;
+		std::string name;
+	};
+
+	// Names are chunked so appending new entities copies the last chunk instead of the whole index.
+	// Chunks are immutable after publishing so the search thread reads them without locks.
+	static constexpr size_t NameChunkSize = 4096U;
+	using NameChunk = std::vector<NameEntry>;
+	using NameIndex = std::vector<std::shared_ptr<const NameChunk>>;
+
+	struct SearchRequest
+	{
+		uint64_t generation = 0U;
+		std::string text;
+		NameIndex nameIndex;
+	};
+
+	void Rebuild(const engine::SceneWorld* pSceneWorld);
+	bool AppendEntities(const engine::SceneWorld* pSceneWorld, size_t beginIndex);
+	void AddNames(const engine::SceneWorld* pSceneWorld, size_t beginIndex);
+	void AddTreeEntity(const engine::SceneWorld* pSceneWorld, engine::Entity entity);
+	void RebuildTreeRows();
+
+	void RequestSearch();
+	void UpdateSearchRows(const engine::SceneWorld* pSceneWorld);
+	void SearchMain();
+
+private:
+	// Tree
+	std::vector<engine::Entity> m_rootEntities;
+	std::unordered_map<engine::Entity, std::vector<engine::Entity>> m_childEntities;
+	// Parents without name component. Naming one of them later moves its children so the tree is rebuilt.
+	std::unordered_set<engine::Entity> m_unnamedParentEntities;
+	std::unordered_set<engine::Entity> m_expandedEntities;
+	std::vector<EntityTreeRow> m_treeRows;
+	bool m_isTreeRowsDirty = true;
+
+	uint64_t m_nameVersion = UINT64_MAX;
+	uint64_t m_hierarchyVersion = UINT64_MAX;
+	size_t m_nameCount = 0U;
+
+	// Search
+	NameIndex m_nameIndex;
+	std::string m_searchText;
+	std::vector<EntityTreeRow> m_searchRows;
+	uint64_t m_searchRowsGeneration = 0U;
+	bool m_isSearchDirty = false;
+	std::atomic<uint64_t> m_searchGeneration = 0U;
+
+	// Shared with the search thread.
+	std::mutex m_searchMutex;
+	std::condition_variable m_searchCondition;
+	SearchRequest m_searchRequest;
+	uint64_t m_resultGeneration = 0U;
+	std::vector<engine::Entity> m_searchResult;
+	bool m_isSearchThreadRunning = true;
+	std::thread m_searchThread;
+};
+
+}
@@ -5,6 +5,7 @@
 #include "ECWorld/StaticMeshComponent.h"
 #include "ECWorld/TransformComponent.h"
 #include "ImGui/ImGuiContextInstance.h"
+#include "Undo/UndoJournal.h"
 
 // TODO : can use StringCrc to access other UILayers from ImGuiContextInstance.
 #include "UILayers/SceneView.h"
@@ -31,12 +32,14 @@ void ImGuizmoView::Update()
 
 	if (engine::INVALID_ENTITY == selectedEntity)
 	{
+		SetManipulating(false);
 		return;
 	}
 
 	engine::TransformComponent* pTransformComponent = pSceneWorld->GetTransformComponent(selectedEntity);
 	if (!pTransformComponent)
 	{
+		SetManipulating(false);
 		return;
 	}
 
@@ -52,8 +55,10 @@ void ImGuizmoView::Update()
 	ImGuizmo::Manipulate(pCameraComponent->GetViewMatrix().begin(), pCameraComponent->GetProjectionMatrix().begin(),
 		operation, ImGuizmo::LOCAL, worldMatrix.begin());
 
+	SetManipulating(ImGuizmo::IsUsing());
 	if (ImGuizmo::IsUsing())
 	{
+		cd::Transform oldTransform = pTransformComponent->GetTransform();
 		if (ImGuizmo::OPERATION::TRANSLATE & operation)
 		{
 			pTransformComponent->GetTransform().SetTranslation(worldMatrix.GetTranslation());
@@ -72,8 +77,31 @@ void ImGuizmoView::Update()
 			pTransformComponent->Dirty();
 		}
 
+		if (m_pUndoJournal)
+		{
+			m_pUndoJournal->RecordValue(selectedEntity, *pTransformComponent, pTransformComponent->GetTransform(), oldTransform);
+		}
+
 		pTransformComponent->Build();
 	}
 }
 
+void ImGuizmoView::SetManipulating(bool manipulating)
+{
+	if (!m_pUndoJournal || manipulating == m_isManipulating)
+	{
+		return;
+	}
+
+	if (manipulating)
+	{
+		m_pUndoJournal->BeginEdit();
+	}
+	else
+	{
+		m_pUndoJournal->EndEdit();
+	}
+	m_isManipulating = manipulating;
+}
+
 }
\ No newline at end of file
@@ -4,6 +4,7 @@ namespace editor
 {
 
 class SceneView;
+class UndoJournal;
 
 class ImGuizmoView : public engine::ImGuiBaseLayer
 {
@@ -15,9 +16,17 @@ public:
 	virtual void Update() override;
 
 	void SetSceneView(const SceneView* pSceneView) { m_pSceneView = pSceneView; }
+	void SetUndoJournal(UndoJournal* pUndoJournal) { m_pUndoJournal = pUndoJournal; }
+
+private:
+	void SetManipulating(bool manipulating);
 
 private:
 	const SceneView* m_pSceneView = nullptr;
+
+	// A gizmo drag is one undo step.
+	UndoJournal* m_pUndoJournal = nullptr;
+	bool m_isManipulating = false;
 };
 
 }
\ No newline at end of file
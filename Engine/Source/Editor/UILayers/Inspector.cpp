@@ -9,6 +9,7 @@
 #include "Graphics/GraphicsBackend.h"
 #include "ImGui/ImGuiUtils.hpp"
 #include "Path/Path.h"
+#include "Undo/UndoJournal.h"
 
 #include "ImGui/imfilebrowser.h"
 
@@ -497,6 +498,21 @@ void UpdateComponentWidget<engine::TerrainComponent>(engine::SceneWorld* pSceneW
 
 	if (isOpen)
 	{
+		if (pTerrainComponent->IsChunked())
+		{
+			ImGuiUtils::ImGuiStringProperty("Tile Directory", pTerrainComponent->GetTileDirectory());
+			ImGuiUtils::ImGuiStringProperty("Tile Size", std::to_string(pTerrainComponent->GetTileSize()));
+			ImGuiUtils::ImGuiStringProperty("Tile Count", std::to_string(pTerrainComponent->GetTileCountX()) + " x " + std::to_string(pTerrainComponent->GetTileCountZ()));
+			ImGuiUtils::ImGuiStringProperty("Chunk Size", std::to_string(pTerrainComponent->GetChunkSize()));
+			ImGuiUtils::ImGuiFloatProperty("LOD Distance", pTerrainComponent->GetLODDistance(), cd::Unit::None, 1.0f, 1000.0f);
+			ImGuiUtils::ImGuiFloatProperty("View Distance", pTerrainComponent->GetViewDistance(), cd::Unit::None, 0.0f, 100000.0f);
+
+			int maxResidentTileCount = static_cast<int>(pTerrainComponent->GetMaxResidentTileCount());
+			if (ImGuiUtils::ImGuiIntProperty("Max Resident Tiles", maxResidentTileCount, cd::Unit::None, 1, 1024))
+			{
+				pTerrainComponent->SetMaxResidentTileCount(static_cast<uint32_t>(maxResidentTileCount));
+			}
+		}
 
 		/*// Parameters
 		ImGuiUtils::ImGuiVectorProperty("AlbedoColor", pMaterialComponent->GetAlbedoColor(), cd::Unit::None, cd::Vec3f::Zero(), cd::Vec3f::One());
@@ -592,6 +608,19 @@ void UpdateComponentWidget<engine::SkyComponent>(engine::SceneWorld* pSceneWorld
 			ImGuiUtils::ImGuiFloatProperty("Height Offset", pSkyComponent->GetHeightOffset(), cd::Unit::Kilometer, -1000.0f, 1000.0f, false, 0.1f);
 			ImGuiUtils::ImGuiFloatProperty("Shadow Length", pSkyComponent->GetShadowLength(), cd::Unit::Kilometer, 0.0f, 10.0f, false, 0.1f);
 			ImGuiUtils::ImGuiVectorProperty("Sun Direction", pSkyComponent->GetSunDirection(), cd::Unit::None, cd::Direction(-1.0f, -1.0f, -1.0f), cd::Direction::One(), true, 0.01f);
+
+			ImGuiUtils::ImGuiBoolProperty("Time Of Day", pSkyComponent->GetTimeOfDayEnable());
+			if (pSkyComponent->GetTimeOfDayEnable())
+			{
+				ImGuiUtils::ImGuiFloatProperty("Hour", pSkyComponent->GetTimeOfDay(), cd::Unit::None, 0.0f, 24.0f, false, 0.1f);
+				ImGuiUtils::ImGuiFloatProperty("Hours Per Second", pSkyComponent->GetTimeOfDaySpeed(), cd::Unit::None, -24.0f, 24.0f, false, 0.01f);
+			}
+
+			int scatteringOrders = static_cast<int>(pSkyComponent->GetScatteringOrders());
+			if (ImGuiUtils::ImGuiIntProperty("Scattering Orders", scatteringOrders, cd::Unit::None, 1, 8))
+			{
+				pSkyComponent->SetScatteringOrders(static_cast<uint16_t>(scatteringOrders));
+			}
 		}
 	}
 
@@ -663,6 +692,24 @@ void UpdateComponentWidget<engine::ParticleForceFieldComponent>(engine::SceneWor
 	ImGui::PopStyleVar();
 }
 
+// Property widgets report edits to undo journal, which records them as changes of the component.
+template<typename Component>
+void UpdateComponent(editor::UndoJournal* pUndoJournal, engine::SceneWorld* pSceneWorld, engine::Entity entity)
+{
+	Component* pComponent = pSceneWorld->GetWorld()->GetComponents<Component>()->GetComponent(entity);
+	if (pUndoJournal && pComponent)
+	{
+		pUndoJournal->SetEditTarget(entity, *pComponent);
+	}
+
+	UpdateComponentWidget<Component>(pSceneWorld, entity);
+
+	if (pUndoJournal)
+	{
+		pUndoJournal->ClearEditTarget();
+	}
+}
+
 }
 
 namespace editor
@@ -701,19 +748,26 @@ void Inspector::Update()
 		return;
 	}
 
+	if (m_pUndoJournal && !m_isEditing)
+	{
+		m_pUndoJournal->BeginEdit();
+		m_isEditing = true;
+	}
+
 	ImGui::BeginChild("Inspector");
-	details::UpdateComponentWidget<engine::NameComponent>(pSceneWorld, m_lastSelectedEntity);
-	details::UpdateComponentWidget<engine::TransformComponent>(pSceneWorld, m_lastSelectedEntity);
-	details::UpdateComponentWidget<engine::CameraComponent>(pSceneWorld, m_lastSelectedEntity);
-	details::UpdateComponentWidget<engine::LightComponent>(pSceneWorld, m_lastSelectedEntity);
-	details::UpdateComponentWidget<engine::SkyComponent>(pSceneWorld, m_lastSelectedEntity);
-	details::UpdateComponentWidget<engine::TerrainComponent>(pSceneWorld, m_lastSelectedEntity);
-	details::UpdateComponentWidget<engine::StaticMeshComponent>(pSceneWorld, m_lastSelectedEntity);
-	details::UpdateComponentWidget<engine::MaterialComponent>(pSceneWorld, m_lastSelectedEntity);
-	details::UpdateComponentWidget<engine::ParticleEmitterComponent>(pSceneWorld, m_lastSelectedEntity);
-	details::UpdateComponentWidget<engine::ParticleForceFieldComponent>(pSceneWorld, m_lastSelectedEntity);
-	details::UpdateComponentWidget<engine::CollisionMeshComponent>(pSceneWorld, m_lastSelectedEntity);
-	details::UpdateComponentWidget<engine::BlendShapeComponent>(pSceneWorld, m_lastSelectedEntity);
+	ImGuiUtils::SetPropertyEditListener(m_pUndoJournal ? &UndoJournal::OnPropertyEdit : nullptr, m_pUndoJournal);
+	details::UpdateComponent<engine::NameComponent>(m_pUndoJournal, pSceneWorld, m_lastSelectedEntity);
+	details::UpdateComponent<engine::TransformComponent>(m_pUndoJournal, pSceneWorld, m_lastSelectedEntity);
+	details::UpdateComponent<engine::CameraComponent>(m_pUndoJournal, pSceneWorld, m_lastSelectedEntity);
+	details::UpdateComponent<engine::LightComponent>(m_pUndoJournal, pSceneWorld, m_lastSelectedEntity);
+	details::UpdateComponent<engine::SkyComponent>(m_pUndoJournal, pSceneWorld, m_lastSelectedEntity);
+	details::UpdateComponent<engine::TerrainComponent>(m_pUndoJournal, pSceneWorld, m_lastSelectedEntity);
+	details::UpdateComponent<engine::StaticMeshComponent>(m_pUndoJournal, pSceneWorld, m_lastSelectedEntity);
+	details::UpdateComponent<engine::MaterialComponent>(m_pUndoJournal, pSceneWorld, m_lastSelectedEntity);
+	details::UpdateComponent<engine::ParticleEmitterComponent>(m_pUndoJournal, pSceneWorld, m_lastSelectedEntity);
+	details::UpdateComponent<engine::ParticleForceFieldComponent>(m_pUndoJournal, pSceneWorld, m_lastSelectedEntity);
+	details::UpdateComponent<engine::CollisionMeshComponent>(m_pUndoJournal, pSceneWorld, m_lastSelectedEntity);
+	details::UpdateComponent<engine::BlendShapeComponent>(m_pUndoJournal, pSceneWorld, m_lastSelectedEntity);
 
 	if (IsOpenFileBrowser())
 	{
@@ -723,13 +777,20 @@ void Inspector::Update()
 	}
 
 #ifdef ENABLE_DDGI
-	details::UpdateComponentWidget<engine::DDGIComponent>(pSceneWorld, m_lastSelectedEntity);
+	details::UpdateComponent<engine::DDGIComponent>(m_pUndoJournal, pSceneWorld, m_lastSelectedEntity);
 #endif
 
+	ImGuiUtils::SetPropertyEditListener(nullptr, nullptr);
 	ImGui::EndChild();
 
 	ImGui::End();
 
+	if (m_isEditing && !ImGui::IsAnyItemActive())
+	{
+		m_pUndoJournal->EndEdit();
+		m_isEditing = false;
+	}
+
 	m_pSelectFileBrowser->Display();
 	if (m_pSelectFileBrowser->HasSelected() && m_optSelectMaterialTextureType.has_value())
 	{
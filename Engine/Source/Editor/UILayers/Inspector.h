@@ -15,6 +15,8 @@ class FileBrowser;
 namespace editor
 {
 
+class UndoJournal;
+
 class Inspector : public engine::ImGuiBaseLayer
 {
 public:
@@ -29,9 +31,15 @@ public:
 	void SetIsOpenFileBrowser(bool flag) { m_isOpenFileBrowser = flag; }
 	bool IsOpenFileBrowser() const { return m_isOpenFileBrowser; }
 
+	void SetUndoJournal(UndoJournal* pUndoJournal) { m_pUndoJournal = pUndoJournal; }
+
 private:
 	engine::Entity m_lastSelectedEntity = engine::INVALID_ENTITY;
 
+	// Widget edits are one undo step until no item is active.
+	UndoJournal* m_pUndoJournal = nullptr;
+	bool m_isEditing = false;
+
 	// Select file
 	std::optional<cd::MaterialTextureType> m_optSelectMaterialTextureType;
 	bool m_isOpenFileBrowser = false;
@@ -2,6 +2,7 @@
 
 #include "Display/CameraController.h"
 #include "ECWorld/SceneWorld.h"
+#include "ECWorld/WorldSnapshot.h"
 #include "EditorApp.h"
 #include "ImGui/ImGuiContextInstance.h"
 #include "ImGui/Localization.h"
@@ -10,6 +11,7 @@
 #include "Path/Path.h"
 #include "Resources/ResourceBuilder.h"
 #include "Resources/ShaderBuilder.h"
+#include "Undo/UndoJournal.h"
 #include "Window/Window.h"
 #include "Window/Input.h"
 #include "Window/KeyCode.h"
@@ -69,11 +71,13 @@ void MainMenu::EditMenu()
 {
 	if (ImGui::BeginMenu(CD_TEXT("TEXT_EDIT")))
 	{
-		if (ImGui::MenuItem("Undo", "Ctrl Z"))
+		if (ImGui::MenuItem("Undo", "Ctrl Z", false, m_pUndoJournal && m_pUndoJournal->CanUndo()))
 		{
+			m_pUndoJournal->Undo(*GetSceneWorld());
 		}
-		if (ImGui::MenuItem("Redo", "Shift Ctrl Z"))
+		if (ImGui::MenuItem("Redo", "Shift Ctrl Z", false, m_pUndoJournal && m_pUndoJournal->CanRedo()))
 		{
+			m_pUndoJournal->Redo(*GetSceneWorld());
 		}
 
 		ImGui::Separator();
@@ -243,9 +247,33 @@ void MainMenu::AboutMenu()
 	}
 }
 
+void MainMenu::PlayMenu()
+{
+	if (ImGui::MenuItem(m_isPlaying ? "Stop" : "Play"))
+	{
+		engine::SceneWorld* pSceneWorld = GetSceneWorld();
+		if (m_isPlaying)
+		{
+			m_pPlayModeSnapshot->Restore(*pSceneWorld);
+		}
+		else
+		{
+			m_pPlayModeSnapshot->Capture(*pSceneWorld);
+		}
+		m_isPlaying = !m_isPlaying;
+
+		// Play mode edits are dropped by restoring so they can't be undone either.
+		if (m_pUndoJournal)
+		{
+			m_pUndoJournal->Clear();
+		}
+	}
+}
+
 void MainMenu::Init()
 {
 	m_pCreatProjectDialog = std::make_unique<ImGui::FileBrowser>();
+	m_pPlayModeSnapshot = std::make_unique<engine::WorldSnapshot>();
 }
 
 void MainMenu::Update()
@@ -258,11 +286,26 @@ void MainMenu::Update()
 		WindowMenu();
 		BuildMenu();
 		AboutMenu();
+		PlayMenu();
 		ImGui::EndMainMenuBar();
 	}
 
 	m_pCreatProjectDialog->Display();
 
+	// Text inputs handle the same keys by themselves.
+	const ImGuiIO& io = ImGui::GetIO();
+	if (m_pUndoJournal && io.KeyCtrl && !io.WantTextInput && ImGui::IsKeyPressed(ImGuiKey_Z, false))
+	{
+		if (io.KeyShift)
+		{
+			m_pUndoJournal->Redo(*GetSceneWorld());
+		}
+		else
+		{
+			m_pUndoJournal->Undo(*GetSceneWorld());
+		}
+	}
+
 	if (engine::Input::Get().ContainsModifier(engine::KeyMod::KMOD_CTRL)
 		&& engine::Input::Get().IsKeyPressed(engine::KeyCode::q))
 	{
@@ -13,12 +13,15 @@ namespace engine
 {
 
 class CameraController;
+class WorldSnapshot;
 
 }
 
 namespace editor
 {
 
+class UndoJournal;
+
 class MainMenu : public engine::ImGuiBaseLayer
 {
 public:
@@ -34,12 +37,19 @@ public:
 	void WindowMenu();
 	void BuildMenu();
 	void AboutMenu();
+	void PlayMenu();
 
 	void SetCameraController(engine::CameraController* pCameraController) { m_pCameraController = pCameraController; }
+	void SetUndoJournal(UndoJournal* pUndoJournal) { m_pUndoJournal = pUndoJournal; }
 
 private:
 	std::unique_ptr<ImGui::FileBrowser> m_pCreatProjectDialog;
 	engine::CameraController* m_pCameraController = nullptr;
+	UndoJournal* m_pUndoJournal = nullptr;
+
+	// Edited scene which is restored when play mode stops.
+	std::unique_ptr<engine::WorldSnapshot> m_pPlayModeSnapshot;
+	bool m_isPlaying = false;
 };
 
 }
\ No newline at end of file
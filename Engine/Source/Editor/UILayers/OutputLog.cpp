@@ -6,6 +6,8 @@
 
 #include <imgui/imgui.h>
 
+#include <sstream>
+
 namespace editor
 {
 
@@ -17,6 +19,28 @@ constexpr ImVec4 COLOR_BLUE =   { 0.2f, 0.2f, 0.8f, 1.0f };
 constexpr ImVec4 COLOR_YELLOW = { 0.8f, 0.8f, 0.2f, 1.0f };
 constexpr ImVec4 COLOR_RED =    { 0.8f, 0.25f, 0.25f, 1.0f };
 constexpr ImVec4 COLOR_PURPLE = { 0.75f, 0.25f, 0.8f, 1.0f };
+
+#ifdef SPDLOG_ENABLE
+LogLevel ToLogLevel(spdlog::level::level_enum level)
+{
+    switch (level)
+    {
+    case spdlog::level::trace:
+    case spdlog::level::debug:
+        return LogLevel::Trace;
+    case spdlog::level::info:
+        return LogLevel::Info;
+    case spdlog::level::warn:
+        return LogLevel::Warn;
+    case spdlog::level::err:
+        return LogLevel::Error;
+    case spdlog::level::critical:
+        return LogLevel::Fatal;
+    default:
+        return LogLevel::None;
+    }
+}
+#endif
 }
 
 OutputLog::~OutputLog()
@@ -34,7 +58,7 @@ void OutputLog::Update()
 	ImGui::Begin(GetName(), &m_isEnable, 0);
 
 #ifdef SPDLOG_ENABLE
-    AddSpdLog(engine::Log::GetSpdOutput());
+    AddLogRecords();
 #endif
     Draw();
 
@@ -45,6 +69,8 @@ void OutputLog::Clear() {
 	m_buffer.clear();
 	m_lineOffsets.clear();
 	m_lineOffsets.push_back(0);
+	m_lineLevels.clear();
+	m_lineLevels.push_back(LogLevel::Trace);
 }
 
 void OutputLog::AddLog(const char *fmt, ...) {
@@ -56,19 +82,35 @@ void OutputLog::AddLog(const char *fmt, ...) {
     for (int new_size = m_buffer.size(); old_size < new_size; old_size++) {
         if (m_buffer[old_size] == '\n') {
             m_lineOffsets.push_back(old_size + 1);
+            m_lineLevels.push_back(LogLevel::Trace);
         }
     }
 }
 
-void OutputLog::AddSpdLog(const std::ostringstream &oss, bool clearBuffer)
-{
 #ifdef SPDLOG_ENABLE
-    AddLog(oss.str().c_str());
-    if (clearBuffer) {
-        engine::Log::ClearBuffer();
+void OutputLog::AddLogRecords()
+{
+    // Only new records are appended so the cost doesn't grow with the whole log.
+    m_records.clear();
+    engine::Log::FetchRecords(m_records);
+    for (const engine::LogRecord& record : m_records)
+    {
+        LogLevel level = ToLogLevel(record.level);
+        int old_size = m_buffer.size();
+        m_buffer.append(record.text.data(), record.text.data() + record.text.size());
+        m_buffer.append("\n");
+
+        // Current last line starts with this record.
+        m_lineLevels.back() = level;
+        for (int new_size = m_buffer.size(); old_size < new_size; old_size++) {
+            if (m_buffer[old_size] == '\n') {
+                m_lineOffsets.push_back(old_size + 1);
+                m_lineLevels.push_back(level);
+            }
+        }
     }
-#endif
 }
+#endif
 
 void OutputLog::Draw() {
     // Main window.
@@ -108,7 +150,7 @@ void OutputLog::Draw() {
                 const char *line_start = buf + m_lineOffsets[line_no];
                 const char *line_end = (line_no + 1 < m_lineOffsets.Size) ? (buf + m_lineOffsets[line_no + 1] - 1) : buf_end;
                 if (m_fillter.PassFilter(line_start, line_end)) {
-                    SetOutputColor(std::string_view(line_start, line_end - line_start));
+                    PushLevelColor(m_lineLevels[line_no]);
                     ImGui::TextUnformatted(line_start, line_end);
                     ImGui::PopStyleColor();
                 }
@@ -135,7 +177,7 @@ void OutputLog::Draw() {
                     const char *line_start = buf + m_lineOffsets[line_no];
                     const char *line_end = (line_no + 1 < m_lineOffsets.Size) ? (buf + m_lineOffsets[line_no + 1] - 1) : buf_end;
 
-                    SetOutputColor(std::string_view(line_start, line_end - line_start));
+                    PushLevelColor(m_lineLevels[line_no]);
                     ImGui::TextUnformatted(line_start, line_end);
                     ImGui::PopStyleColor();
                 }
@@ -223,34 +265,9 @@ const std::string OutputLog::GetFilterStr() const {
     return ss.str();
 }
 
-void OutputLog::SetOutputColor(std::string_view str) const {
-    // TODO :
-    // Spd just output information to some specific sink after formated,
-    // whithout any extra information such as log level.
-    // I can't find a better way to determine which level is for every log,
-    // if we read buffer from spdlog to imgui.
-    // Since the log formate will always be "[%T] [%n] [%l]: %v",
-    // we can search log level start from the last "[" position.
-    static const size_t startPoint = str.find_last_of("[");
-    
-    if (str.find("trace", startPoint) != str.npos) {
-        ImGui::PushStyleColor(ImGuiCol_Text, COLOR_GREY);
-    }
-    else if (str.find("info", startPoint) != str.npos) {
-        ImGui::PushStyleColor(ImGuiCol_Text, COLOR_GREEN);
-    }
-    else if (str.find("warn", startPoint) != str.npos) {
-        ImGui::PushStyleColor(ImGuiCol_Text, COLOR_YELLOW);
-    }
-    else if (str.find("erro", startPoint) != str.npos) {
-        ImGui::PushStyleColor(ImGuiCol_Text, COLOR_RED);
-    }
-    else if (str.find("critical", startPoint) != str.npos) {
-        ImGui::PushStyleColor(ImGuiCol_Text, COLOR_PURPLE);
-    }
-    else {
-        ImGui::PushStyleColor(ImGuiCol_Text, COLOR_GREY);
-    }
+void OutputLog::PushLevelColor(LogLevel level) const {
+    // Records keep their level so lines don't need to be parsed.
+    ImGui::PushStyleColor(ImGuiCol_Text, LogLevel::None == level ? COLOR_GREY : GetLevelColor(level));
 }
 
 } // namespace editor
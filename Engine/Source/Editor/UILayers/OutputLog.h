@@ -1,8 +1,10 @@
 #include "ImGui/ImGuiBaseLayer.h"
+#include "Log/Log.h"
 
 #include "imgui.h"
 
-#include <sstream>
+#include <string>
+#include <vector>
 
 namespace editor
 {
@@ -29,7 +31,10 @@ public:
 
 	void Clear();
 	void AddLog(const char *fmt, ...);
-	void AddSpdLog(const std::ostringstream &oss, bool clearBuffer = true);
+#ifdef SPDLOG_ENABLE
+	// Appends records which Log flushed since the last frame.
+	void AddLogRecords();
+#endif
 	void Draw();
 
 private:
@@ -39,12 +44,17 @@ private:
 	const char *GetLevelIcon(LogLevel level) const;
 	const std::string GetFilterStr() const;
 
-	void SetOutputColor(std::string_view str) const;
+	void PushLevelColor(LogLevel level) const;
 
 	ImGuiTextBuffer m_buffer;
 	ImGuiTextFilter m_fillter;
 	// Index to lines offset. We maintain this with AddLog() calls.
 	ImVector<int> m_lineOffsets;
+	// Level of every line. AddLog lines are Trace.
+	ImVector<LogLevel> m_lineLevels;
+#ifdef SPDLOG_ENABLE
+	std::vector<engine::LogRecord> m_records;
+#endif
 	uint8_t m_levelFilter = static_cast<uint8_t>(LogLevel::All);
 };
 
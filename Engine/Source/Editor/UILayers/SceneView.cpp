@@ -249,42 +249,16 @@ void SceneView::PickSceneMesh(float regionWidth, float regionHeight)
 		return;
 	}
 
-	// Loop through scene's all static meshes' AABB to test intersections with Ray.
+	// Scene query walks the BVH of collision meshes and then triangles of candidate meshes.
 	engine::SceneWorld* pSceneWorld = GetSceneWorld();
 	engine::CameraComponent* pCameraComponent = pSceneWorld->GetCameraComponent(pSceneWorld->GetMainCameraEntity());
-	cd::Ray pickRay = pCameraComponent->EmitRay(screenX, screenY, screenWidth, screenHeight);
+	cd::Vec3f rayOrigin;
+	cd::Vec3f rayDirection;
+	pCameraComponent->EmitRay(screenX, screenY, screenWidth, screenHeight, rayOrigin, rayDirection);
 
-	float minRayTime = FLT_MAX;
-	engine::Entity nearestEntity = engine::INVALID_ENTITY;
-	for (engine::Entity entity : pSceneWorld->GetCollisionMeshEntities())
-	{
-		engine::TransformComponent* pTransformComponent = pSceneWorld->GetTransformComponent(entity);
-		if (!pTransformComponent)
-		{
-			continue;
-		}
-
-		auto* pCollisionMesh = pSceneWorld->GetCollisionMeshComponent(entity);
-		if (!pCollisionMesh)
-		{
-			continue;
-		}
-
-		cd::AABB collisonMeshAABB = pCollisionMesh->GetAABB();
-		collisonMeshAABB = collisonMeshAABB.Transform(pTransformComponent->GetWorldMatrix());
-
-		float rayTime;
-		if (collisonMeshAABB.Intersects(pickRay, rayTime))
-		{
-			if (rayTime < minRayTime)
-			{
-				minRayTime = rayTime;
-				nearestEntity = entity;
-			}
-		}
-	}
-
-	pSceneWorld->SetSelectedEntity(nearestEntity);
+	engine::RaycastHit hit;
+	pSceneWorld->GetSceneQuery()->Raycast(rayOrigin, rayDirection, FLT_MAX, hit);
+	pSceneWorld->SetSelectedEntity(hit.entity);
 }
 
 void SceneView::Update()
@@ -18,21 +18,20 @@ Splash::~Splash()
 void Splash::Init()
 {
 	GetRenderContext()->CreateTexture("Textures/splash_texture.png");
-
-	m_shaderBuildTaskTotalCount = ResourceBuilder::Get().GetCurrentTaskCount();
 }
 
 void Splash::Update()
 {
 	auto flags = ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse | ImGuiWindowFlags_NoTitleBar;
 
-	size_t currentBuildCount = ResourceBuilder::Get().GetCurrentTaskCount();
-	assert(currentBuildCount <= m_shaderBuildTaskTotalCount);
-
+	// Tasks are built in parallel so progress comes from completed count of current batch.
+	uint32_t completedBuildCount = ResourceBuilder::Get().GetCompletedTaskCount();
+	uint32_t totalBuildCount = ResourceBuilder::Get().GetTotalTaskCount();
+	assert(completedBuildCount <= totalBuildCount);
 
-	//std::string title = std::format("{}({}/{})", GetName(), m_shaderBuildTaskTotalCount - currentBuildCount, m_shaderBuildTaskTotalCount);
+	//std::string title = std::format("{}({}/{})", GetName(), completedBuildCount, totalBuildCount);
 	std::string title = GetName();
-	title += "(" + std::to_string(m_shaderBuildTaskTotalCount - currentBuildCount) + "/" + std::to_string(m_shaderBuildTaskTotalCount) + ")";
+	title += "(" + std::to_string(completedBuildCount) + "/" + std::to_string(totalBuildCount) + ")";
 	ImGui::Begin(title.c_str(), &m_isEnable, flags);
 
 	engine::StringCrc splashTexture("Textures/splash_texture.png");
@@ -41,6 +40,7 @@ void Splash::Update()
 	ImGui::Spacing();
 	ImGui::Separator();
 	ImGui::Text("%s", title.c_str());
+	ImGui::ProgressBar(totalBuildCount > 0U ? static_cast<float>(completedBuildCount) / static_cast<float>(totalBuildCount) : 1.0f);
 	ImGui::Separator();
 
 	ImGui::End();
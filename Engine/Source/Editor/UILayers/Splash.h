@@ -13,9 +13,6 @@ public:
 
 	virtual void Init() override;
 	virtual void Update() override;
-
-private:
-	size_t m_shaderBuildTaskTotalCount = 0;
 };
 
 }
\ No newline at end of file
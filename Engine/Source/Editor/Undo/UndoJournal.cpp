@@ -0,0 +1,333 @@
+#include "UndoJournal.h"
+
+#include "Log/Log.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+
+constexpr size_t RecordAlignment = alignof(std::max_align_t);
+
+size_t AlignRecordSize(size_t size)
+{
+	return (size + RecordAlignment - 1U) & ~(RecordAlignment - 1U);
+}
+
+}
+
+namespace editor
+{
+
+UndoJournal::UndoJournal(size_t capacity)
+	: m_buffer(capacity)
+{
+}
+
+void UndoJournal::EndEdit()
+{
+	assert(m_editDepth > 0U);
+	if (--m_editDepth == 0U)
+	{
+		m_isStepOpen = false;
+	}
+}
+
+void UndoJournal::RecordComponentBytes(engine::Entity entity, const ComponentAccessor* pAccessor, const void* pComponent, size_t componentSize,
+	const void* pValue, const void* pOldValue, size_t valueSize)
+{
+	const size_t valueOffset = reinterpret_cast<uintptr_t>(pValue) - reinterpret_cast<uintptr_t>(pComponent);
+	assert(valueOffset + valueSize <= componentSize);
+	if (0 == std::memcmp(pValue, pOldValue, valueSize))
+	{
+		return;
+	}
+
+	// A drag reports the value every frame. Only the newest value is needed as the first record keeps the old one.
+	if (m_isStepOpen)
+	{
+		for (size_t recordIndex = m_appliedCount; recordIndex > 0U; --recordIndex)
+		{
+			const RecordHeader& header = GetHeader(recordIndex - 1U);
+			if (header.step != m_step)
+			{
+				break;
+			}
+
+			if (RecordType::ComponentValue == header.type && header.entity == entity && header.pAccessor == pAccessor &&
+				header.valueOffset == valueOffset && header.dataSize == valueSize)
+			{
+				std::memcpy(GetNewData(recordIndex - 1U), pValue, valueSize);
+				return;
+			}
+		}
+	}
+
+	RecordHeader header{};
+	header.entity = entity;
+	header.type = RecordType::ComponentValue;
+	header.pAccessor = pAccessor;
+	header.valueOffset = static_cast<uint32_t>(valueOffset);
+	header.dataSize = static_cast<uint32_t>(valueSize);
+	if (std::byte* pData = AddRecord(header))
+	{
+		std::memcpy(pData, pOldValue, valueSize);
+		std::memcpy(pData + valueSize, pValue, valueSize);
+	}
+}
+
+void UndoJournal::OnPropertyEdit(void* pUserData, const void* pValue, const void* pOldValue, size_t size)
+{
+	auto* pJournal = static_cast<UndoJournal*>(pUserData);
+	if (!pJournal->m_pTargetComponent)
+	{
+		return;
+	}
+
+	// Widgets also edit values which components only refer to, such as material property groups.
+	const uintptr_t componentBegin = reinterpret_cast<uintptr_t>(pJournal->m_pTargetComponent);
+	const uintptr_t valueBegin = reinterpret_cast<uintptr_t>(pValue);
+	if (valueBegin < componentBegin || valueBegin + size > componentBegin + pJournal->m_targetComponentSize)
+	{
+		return;
+	}
+
+	pJournal->RecordComponentBytes(pJournal->m_targetEntity, pJournal->m_pTargetAccessor, pJournal->m_pTargetComponent, pJournal->m_targetComponentSize,
+		pValue, pOldValue, size);
+}
+
+void UndoJournal::RecordTerrainRect(engine::Entity entity, const engine::TerrainComponent::DirtyRect& rect, const float* pOldData, const float* pNewData)
+{
+	const size_t dataSize = static_cast<size_t>(rect.width) * rect.depth * sizeof(float);
+	if (0 == std::memcmp(pOldData, pNewData, dataSize))
+	{
+		return;
+	}
+
+	RecordHeader header{};
+	header.entity = entity;
+	header.type = RecordType::TerrainRect;
+	header.pAccessor = GetComponentAccessor<engine::TerrainComponent>();
+	header.dataSize = static_cast<uint32_t>(dataSize);
+	header.rect = rect;
+	if (std::byte* pData = AddRecord(header))
+	{
+		std::memcpy(pData, pOldData, dataSize);
+		std::memcpy(pData + dataSize, pNewData, dataSize);
+	}
+}
+
+void UndoJournal::Undo(engine::SceneWorld& sceneWorld)
+{
+	m_isStepOpen = false;
+	if (!CanUndo())
+	{
+		return;
+	}
+
+	const uint32_t step = GetHeader(m_appliedCount - 1U).step;
+	while (m_appliedCount > 0U && GetHeader(m_appliedCount - 1U).step == step)
+	{
+		--m_appliedCount;
+		Apply(sceneWorld, m_appliedCount, true);
+	}
+}
+
+void UndoJournal::Redo(engine::SceneWorld& sceneWorld)
+{
+	m_isStepOpen = false;
+	if (!CanRedo())
+	{
+		return;
+	}
+
+	const uint32_t step = GetHeader(m_appliedCount).step;
+	while (m_appliedCount < m_records.size() && GetHeader(m_appliedCount).step == step)
+	{
+		Apply(sceneWorld, m_appliedCount, false);
+		++m_appliedCount;
+	}
+}
+
+void UndoJournal::Clear()
+{
+	m_records.clear();
+	m_appliedCount = 0U;
+	m_isStepOpen = false;
+}
+
+size_t UndoJournal::GetUsedSize() const
+{
+	size_t usedSize = 0U;
+	for (size_t offset : m_records)
+	{
+		usedSize += reinterpret_cast<const RecordHeader*>(&m_buffer[offset])->size;
+	}
+
+	return usedSize;
+}
+
+std::byte* UndoJournal::AddRecord(const RecordHeader& header)
+{
+	// New edit makes redo records unreachable.
+	m_records.resize(m_appliedCount);
+
+	if (!m_isStepOpen)
+	{
+		++m_step;
+		m_isStepOpen = m_editDepth > 0U;
+	}
+
+	const size_t recordSize = AlignRecordSize(sizeof(RecordHeader) + 2U * header.dataSize);
+	size_t offset;
+	if (!Allocate(recordSize, offset))
+	{
+		// Older records may change the same data so they can't be applied without this one.
+		CD_WARN("Undo record of {0} bytes is larger than journal capacity. History is cleared.", recordSize);
+		Clear();
+		return nullptr;
+	}
+
+	auto* pHeader = reinterpret_cast<RecordHeader*>(&m_buffer[offset]);
+	*pHeader = header;
+	pHeader->size = static_cast<uint32_t>(recordSize);
+	pHeader->step = m_step;
+
+	m_records.push_back(offset);
+	m_appliedCount = m_records.size();
+	return &m_buffer[offset + sizeof(RecordHeader)];
+}
+
+bool UndoJournal::Allocate(size_t size, size_t& outOffset)
+{
+	if (size > m_buffer.size())
+	{
+		return false;
+	}
+
+	while (!m_records.empty())
+	{
+		const size_t frontOffset = m_records.front();
+		const size_t backOffset = m_records.back();
+		const size_t tailOffset = backOffset + GetHeader(m_records.size() - 1U).size;
+		if (frontOffset <= backOffset)
+		{
+			// Free space is after the newest record and before the oldest one.
+			if (tailOffset + size <= m_buffer.size())
+			{
+				outOffset = tailOffset;
+				return true;
+			}
+
+			if (size <= frontOffset)
+			{
+				outOffset = 0U;
+				return true;
+			}
+		}
+		else if (tailOffset + size <= frontOffset)
+		{
+			// Records wrapped around so free space is between the newest and the oldest one.
+			outOffset = tailOffset;
+			return true;
+		}
+
+		// Drop the oldest step as a whole as it can't be undone partially.
+		const uint32_t oldestStep = GetHeader(0U).step;
+		do
+		{
+			m_records.pop_front();
+			--m_appliedCount;
+		} while (!m_records.empty() && GetHeader(0U).step == oldestStep);
+	}
+
+	outOffset = 0U;
+	return true;
+}
+
+void UndoJournal::Apply(engine::SceneWorld& sceneWorld, size_t recordIndex, bool isUndo)
+{
+	const RecordHeader& header = GetHeader(recordIndex);
+	const std::byte* pData = isUndo ? GetOldData(recordIndex) : GetNewData(recordIndex);
+
+	// Entity or its component may be deleted after the edit.
+	void* pComponent = header.pAccessor->pfnFind(sceneWorld, header.entity);
+	if (!pComponent)
+	{
+		return;
+	}
+
+	if (RecordType::ComponentValue == header.type)
+	{
+		std::memcpy(static_cast<std::byte*>(pComponent) + header.valueOffset, pData, header.dataSize);
+		header.pAccessor->pfnRestored(pComponent);
+	}
+	else if (RecordType::TerrainRect == header.type)
+	{
+		auto* pTerrainComponent = static_cast<engine::TerrainComponent*>(pComponent);
+		const engine::TerrainComponent::DirtyRect& rect = header.rect;
+		if (rect.x + rect.width > pTerrainComponent->GetTexWidth() || rect.z + rect.depth > pTerrainComponent->GetTexDepth() ||
+			pTerrainComponent->GetElevationRawDataSize() == 0U)
+		{
+			return;
+		}
+
+		pTerrainComponent->WriteElevationRect(rect, reinterpret_cast<const float*>(pData));
+	}
+}
+
+void TerrainStroke::Extend(engine::Entity entity, const engine::TerrainComponent& terrain, const engine::TerrainComponent::DirtyRect& rect)
+{
+	if (!IsActive())
+	{
+		m_entity = entity;
+		m_rect = rect;
+		m_oldData.resize(static_cast<size_t>(rect.width) * rect.depth);
+		terrain.ReadElevationRect(rect, m_oldData.data());
+		return;
+	}
+
+	assert(entity == m_entity);
+	const uint16_t minX = std::min(m_rect.x, rect.x);
+	const uint16_t minZ = std::min(m_rect.z, rect.z);
+	const uint16_t maxX = std::max(m_rect.x + m_rect.width, rect.x + rect.width);
+	const uint16_t maxZ = std::max(m_rect.z + m_rect.depth, rect.z + rect.depth);
+	engine::TerrainComponent::DirtyRect unionRect{ minX, minZ, static_cast<uint16_t>(maxX - minX), static_cast<uint16_t>(maxZ - minZ) };
+	if (unionRect.width == m_rect.width && unionRect.depth == m_rect.depth)
+	{
+		return;
+	}
+
+	// Samples out of the saved rect are not touched by this stroke yet so their current heights are old ones.
+	m_newData.resize(static_cast<size_t>(unionRect.width) * unionRect.depth);
+	terrain.ReadElevationRect(unionRect, m_newData.data());
+	for (uint16_t row = 0U; row < m_rect.depth; ++row)
+	{
+		float* pUnionRow = &m_newData[(m_rect.z - unionRect.z + row) * unionRect.width + (m_rect.x - unionRect.x)];
+		std::memcpy(pUnionRow, &m_oldData[row * m_rect.width], m_rect.width * sizeof(float));
+	}
+
+	std::swap(m_oldData, m_newData);
+	m_rect = unionRect;
+}
+
+void TerrainStroke::Commit(UndoJournal& journal, engine::SceneWorld& sceneWorld)
+{
+	if (!IsActive())
+	{
+		return;
+	}
+
+	if (const engine::TerrainComponent* pTerrainComponent = sceneWorld.GetTerrainComponent(m_entity))
+	{
+		m_newData.resize(m_oldData.size());
+		pTerrainComponent->ReadElevationRect(m_rect, m_newData.data());
+		journal.RecordTerrainRect(m_entity, m_rect, m_oldData.data(), m_newData.data());
+	}
+
+	m_entity = engine::INVALID_ENTITY;
+}
+
+}
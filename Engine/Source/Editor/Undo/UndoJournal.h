@@ -0,0 +1,188 @@
+#pragma once
+
+#include "ECWorld/SceneWorld.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <type_traits>
+#include <vector>
+
+namespace editor
+{
+
+// Records don't keep component types. Accessor finds the component again when a record is applied
+// and rebuilds data derived from the written bytes.
+struct ComponentAccessor
+{
+	void* (*pfnFind)(engine::SceneWorld& sceneWorld, engine::Entity entity);
+	void (*pfnRestored)(void* pComponent);
+};
+
+// Rebuilds the same derived data as Inspector does after an edit. Light, sky, terrain and other components
+// are read by renderers every frame so restoring bytes is enough. Values which Inspector edits through
+// temporaries and setters, such as sky type, scattering orders, spot angles and max resident tiles, are
+// outside of the component so they are never recorded.
+template<typename Component>
+void OnComponentRestored(Component& component)
+{
+	if constexpr (std::is_same_v<Component, engine::TransformComponent>)
+	{
+		component.Dirty();
+		component.Build();
+	}
+	else if constexpr (std::is_same_v<Component, engine::CameraComponent>)
+	{
+		component.Dirty();
+		component.BuildProjectMatrix();
+	}
+	else if constexpr (std::is_same_v<Component, engine::ParticleEmitterComponent>)
+	{
+		if (component.GetInstanceState())
+		{
+			component.ActivateShaderFeature(engine::ShaderFeature::PARTICLE_INSTANCE);
+		}
+		else
+		{
+			component.DeactivateShaderFeature(engine::ShaderFeature::PARTICLE_INSTANCE);
+		}
+	}
+}
+
+template<typename Component>
+const ComponentAccessor* GetComponentAccessor()
+{
+	static constexpr ComponentAccessor accessor
+	{
+		[](engine::SceneWorld& sceneWorld, engine::Entity entity) -> void*
+		{
+			return sceneWorld.GetWorld()->GetComponents<Component>()->GetComponent(entity);
+		},
+		[](void* pComponent)
+		{
+			OnComponentRestored(*static_cast<Component*>(pComponent));
+		}
+	};
+	return &accessor;
+}
+
+// Undo history of editor edits. Records only keep changed bytes of components or changed terrain rects,
+// which are stored in a fixed size ring buffer so the oldest records are dropped when it is full.
+class UndoJournal final
+{
+public:
+	static constexpr size_t DefaultCapacity = 32U * 1024U * 1024U;
+
+public:
+	explicit UndoJournal(size_t capacity = DefaultCapacity);
+	UndoJournal(const UndoJournal&) = delete;
+	UndoJournal& operator=(const UndoJournal&) = delete;
+	UndoJournal(UndoJournal&&) = delete;
+	UndoJournal& operator=(UndoJournal&&) = delete;
+	~UndoJournal() = default;
+
+	// Records between BeginEdit and the matching EndEdit are one undo step. Records of the same value
+	// in a step are merged so that a drag only keeps values before and after it.
+	void BeginEdit() { ++m_editDepth; }
+	void EndEdit();
+
+	template<typename Component, typename Value>
+	void RecordValue(engine::Entity entity, const Component& component, const Value& value, const Value& oldValue)
+	{
+		RecordComponentBytes(entity, GetComponentAccessor<Component>(), &component, sizeof(Component), &value, &oldValue, sizeof(Value));
+	}
+
+	void RecordComponentBytes(engine::Entity entity, const ComponentAccessor* pAccessor, const void* pComponent, size_t componentSize,
+		const void* pValue, const void* pOldValue, size_t valueSize);
+
+	// Property widgets report edits without knowing components. Values outside of target component are ignored.
+	template<typename Component>
+	void SetEditTarget(engine::Entity entity, const Component& component)
+	{
+		m_targetEntity = entity;
+		m_pTargetAccessor = GetComponentAccessor<Component>();
+		m_pTargetComponent = &component;
+		m_targetComponentSize = sizeof(Component);
+	}
+	void ClearEditTarget() { m_pTargetComponent = nullptr; }
+	static void OnPropertyEdit(void* pUserData, const void* pValue, const void* pOldValue, size_t size);
+
+	// Data are heights of rect samples row by row.
+	void RecordTerrainRect(engine::Entity entity, const engine::TerrainComponent::DirtyRect& rect, const float* pOldData, const float* pNewData);
+
+	bool CanUndo() const { return m_appliedCount > 0U; }
+	bool CanRedo() const { return m_appliedCount < m_records.size(); }
+	void Undo(engine::SceneWorld& sceneWorld);
+	void Redo(engine::SceneWorld& sceneWorld);
+
+	// Entities which records refer to are not valid anymore after loading another scene.
+	void Clear();
+
+	size_t GetCapacity() const { return m_buffer.size(); }
+	size_t GetUsedSize() const;
+
+private:
+	enum class RecordType : uint8_t
+	{
+		ComponentValue,
+		TerrainRect,
+	};
+
+	// Header is followed by old data and then new data in the same size.
+	struct RecordHeader
+	{
+		uint32_t size;
+		uint32_t step;
+		engine::Entity entity;
+		RecordType type;
+		const ComponentAccessor* pAccessor;
+		uint32_t valueOffset;
+		uint32_t dataSize;
+		engine::TerrainComponent::DirtyRect rect;
+	};
+
+	RecordHeader& GetHeader(size_t recordIndex) { return *reinterpret_cast<RecordHeader*>(&m_buffer[m_records[recordIndex]]); }
+	std::byte* GetOldData(size_t recordIndex) { return &m_buffer[m_records[recordIndex] + sizeof(RecordHeader)]; }
+	std::byte* GetNewData(size_t recordIndex) { return GetOldData(recordIndex) + GetHeader(recordIndex).dataSize; }
+
+	std::byte* AddRecord(const RecordHeader& header);
+	bool Allocate(size_t size, size_t& outOffset);
+	void Apply(engine::SceneWorld& sceneWorld, size_t recordIndex, bool isUndo);
+
+private:
+	std::vector<std::byte> m_buffer;
+
+	// Offsets of records in m_buffer from the oldest one. Records after applied count are for redo.
+	std::deque<size_t> m_records;
+	size_t m_appliedCount = 0U;
+
+	uint32_t m_editDepth = 0U;
+	uint32_t m_step = 0U;
+	bool m_isStepOpen = false;
+
+	engine::Entity m_targetEntity = engine::INVALID_ENTITY;
+	const ComponentAccessor* m_pTargetAccessor = nullptr;
+	const void* m_pTargetComponent = nullptr;
+	size_t m_targetComponentSize = 0U;
+};
+
+// Brush stroke on terrain. Heights are saved before a sample is touched for the first time in the stroke,
+// so that the record only covers the union of brush rects instead of the whole heightmap.
+class TerrainStroke final
+{
+public:
+	bool IsActive() const { return m_entity != engine::INVALID_ENTITY; }
+	engine::Entity GetEntity() const { return m_entity; }
+
+	// Call it before brush modifies the rect.
+	void Extend(engine::Entity entity, const engine::TerrainComponent& terrain, const engine::TerrainComponent::DirtyRect& rect);
+	void Commit(UndoJournal& journal, engine::SceneWorld& sceneWorld);
+
+private:
+	engine::Entity m_entity = engine::INVALID_ENTITY;
+	engine::TerrainComponent::DirtyRect m_rect;
+	std::vector<float> m_oldData;
+	std::vector<float> m_newData;
+};
+
+}
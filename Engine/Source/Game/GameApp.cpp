@@ -18,6 +18,7 @@
 #include "Rendering/PBRSkyRenderer.h"
 #include "Rendering/PostProcessRenderer.h"
 #include "Rendering/RenderContext.h"
+#include "Rendering/RenderSnapshot.h"
 #include "Rendering/SkyboxRenderer.h"
 #include "Rendering/WorldRenderer.h"
 #include "Resources/ShaderLoader.h"
@@ -214,6 +215,7 @@ void GameApp::InitRenderContext(engine::GraphicsBackend backend, void* hwnd)
 	m_pRenderContext = std::make_unique<engine::RenderContext>();
 	m_pRenderContext->Init(backend, hwnd);
 	engine::Renderer::SetRenderContext(m_pRenderContext.get());
+	m_pRenderSnapshot = std::make_unique<engine::RenderSnapshot>();
 }
 
 void GameApp::InitEngineRenderers()
@@ -338,12 +340,19 @@ bool GameApp::Update(float deltaTime)
 	}
 
 	GetMainWindow()->Update();
-	m_pSceneWorld->Update();
+	m_pSceneWorld->Update(deltaTime);
+#ifdef ENABLE_DDGI
+	m_pSceneWorld->UpdateDDGI();
+#endif
 
 	engine::CameraComponent* pMainCameraComponent = m_pSceneWorld->GetCameraComponent(m_pSceneWorld->GetMainCameraEntity());
 	assert(pMainCameraComponent);
 	pMainCameraComponent->BuildProjectMatrix();
 
+	// Game has no simulation thread so it captures the snapshot of current frame directly.
+	m_pRenderSnapshot->Capture(*m_pSceneWorld, m_pRenderSnapshot->GetFrameIndex() + 1);
+	m_pRenderContext->SetRenderSnapshot(m_pRenderSnapshot.get());
+
 	m_pRenderContext->BeginFrame();
 	if (m_pEngineImGuiContext)
 	{
@@ -15,6 +15,7 @@ class ImGuiContextInstance;
 class Window;
 class RenderContext;
 class Renderer;
+class RenderSnapshot;
 class RenderTarget;
 class SceneWorld;
 
@@ -85,6 +86,7 @@ private:
 
 	// Rendering
 	std::unique_ptr<engine::RenderContext> m_pRenderContext;
+	std::unique_ptr<engine::RenderSnapshot> m_pRenderSnapshot;
 	std::vector<std::unique_ptr<engine::Renderer>> m_pEngineRenderers;
 
 	// Controllers for processing input events.
@@ -1,15 +1,11 @@
 ﻿#include "Engine.h"
+#include "Core/Memory/HeapAllocationCounter.h"
+#include "Core/Memory/MemoryTracker.h"
 #include "Log/Log.h"
+#include "Profiling/Profiling.h"
 #include "Time/Clock.h"
 #include "Window/Window.h"
 
-#ifdef TRACY_ENABLE
-#include <tracy/Tracy.hpp>
-#else
-#define ZoneScoped
-#define FrameMark
-#endif
-
 namespace engine
 {
 
@@ -35,20 +31,30 @@ void Engine::Init(EngineInitArgs args)
 void Engine::Run()
 {
 	Clock clock;
+	CD_PROFILE_THREAD("Main");
+
+	uint64_t lastHeapAllocationCount = HeapAllocationCounter::GetStats().count;
 
 	while (true)
 	{
-		ZoneScoped;
+		{
+			CD_PROFILE_SCOPE("Frame");
 
-		clock.Update();
+			clock.Update();
 
-		if (!m_pApplication->Update(clock.GetDeltaTime()))
-		{
-			// quit
-			break;
+			if (!m_pApplication->Update(clock.GetDeltaTime()))
+			{
+				// quit
+				break;
+			}
 		}
 
-		FrameMark;
+		// Render loop is expected to reach zero heap allocations in steady state.
+		uint64_t heapAllocationCount = HeapAllocationCounter::GetStats().count;
+		CD_PROFILE_COUNTER("Heap allocations", heapAllocationCount - lastHeapAllocationCount);
+		lastHeapAllocationCount = heapAllocationCount;
+
+		CD_PROFILE_FRAME();
 	}
 }
 
@@ -81,6 +87,10 @@ void Engine::Destroy(Engine* pEngine)
 		s_pEngine->Shutdown();
 		s_pEngine.reset();
 		s_pEngine = nullptr;
+
+		// Subsystems are destroyed together with the application so everything still tracked leaks.
+		MemoryTracker::ReportLeaks();
+		Log::Shutdown();
 	}
 }
 
@@ -0,0 +1,76 @@
+#include "FramePipeline.h"
+
+#include "Profiling/Profiling.h"
+
+#include <cassert>
+
+namespace engine
+{
+
+FramePipeline::FramePipeline()
+{
+	m_simulationThread = std::thread(&FramePipeline::SimulationThreadMain, this);
+}
+
+FramePipeline::~FramePipeline()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_endCondition.wait(lock, [this]() { return !m_isSimulating; });
+		m_stop = true;
+	}
+	m_beginCondition.notify_one();
+	m_simulationThread.join();
+}
+
+void FramePipeline::BeginSimulation(float deltaTime)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		assert(!m_isSimulating && "EndSimulation should be called before next BeginSimulation.");
+		++m_frameIndex;
+		m_deltaTime = deltaTime;
+		m_isSimulating = true;
+	}
+	m_beginCondition.notify_one();
+}
+
+void FramePipeline::EndSimulation()
+{
+	CD_PROFILE_SCOPE("FramePipeline::EndSimulation");
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_endCondition.wait(lock, [this]() { return !m_isSimulating; });
+	m_renderSnapshotIndex = 1U - m_renderSnapshotIndex;
+}
+
+void FramePipeline::SimulationThreadMain()
+{
+	CD_PROFILE_THREAD("Simulation");
+
+	while (true)
+	{
+		uint64_t frameIndex;
+		float deltaTime;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_beginCondition.wait(lock, [this]() { return m_stop || m_isSimulating; });
+			if (m_stop)
+			{
+				return;
+			}
+			frameIndex = m_frameIndex;
+			deltaTime = m_deltaTime;
+		}
+
+		// Renderers only read the other snapshot during simulation.
+		m_onSimulate.Invoke(m_snapshots[1U - m_renderSnapshotIndex], frameIndex, deltaTime);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_isSimulating = false;
+		}
+		m_endCondition.notify_one();
+	}
+}
+
+}
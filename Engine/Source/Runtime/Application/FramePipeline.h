@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Core/Delegates/Delegate.hpp"
+#include "Rendering/RenderSnapshot.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace engine
+{
+
+// FramePipeline overlaps simulation of frame N with rendering of frame N - 1.
+// BeginSimulation runs m_onSimulate on the simulation thread to capture a RenderSnapshot of frame N while
+// the calling thread submits frame N - 1 from the previous snapshot. EndSimulation waits for it and publishes the new snapshot.
+// Components should only be edited between EndSimulation and next BeginSimulation. Renderers read states which
+// simulation writes from the snapshot.
+// bgfx executes submitted frames on its own render thread so the GPU side is pipelined by bgfx::frame already.
+class FramePipeline final
+{
+public:
+	FramePipeline();
+	FramePipeline(const FramePipeline&) = delete;
+	FramePipeline& operator=(const FramePipeline&) = delete;
+	FramePipeline(FramePipeline&&) = delete;
+	FramePipeline& operator=(FramePipeline&&) = delete;
+	~FramePipeline();
+
+	void BeginSimulation(float deltaTime);
+	void EndSimulation();
+
+	// Snapshot of last simulated frame. The calling thread owns it between EndSimulation calls,
+	// e.g. to capture camera of the frame which is rendered.
+	RenderSnapshot& GetRenderSnapshot() { return m_snapshots[m_renderSnapshotIndex]; }
+	const RenderSnapshot& GetRenderSnapshot() const { return m_snapshots[m_renderSnapshotIndex]; }
+	uint64_t GetFrameIndex() const { return m_frameIndex; }
+
+	engine::Delegate<void(RenderSnapshot& snapshot, uint64_t frameIndex, float deltaTime)> m_onSimulate;
+
+private:
+	void SimulationThreadMain();
+
+private:
+	std::thread m_simulationThread;
+	std::mutex m_mutex;
+	std::condition_variable m_beginCondition;
+	std::condition_variable m_endCondition;
+	bool m_isSimulating = false;
+	bool m_stop = false;
+
+	uint64_t m_frameIndex = 0U;
+	float m_deltaTime = 0.0f;
+	RenderSnapshot m_snapshots[2];
+	uint32_t m_renderSnapshotIndex = 0U;
+};
+
+}
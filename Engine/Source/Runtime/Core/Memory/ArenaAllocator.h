@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Core/Memory/LinearArena.h"
+
+#include <string>
+#include <vector>
+
+namespace engine
+{
+
+// STL allocator on top of a LinearArena. Deallocation does nothing as the arena releases memory by itself,
+// so containers must not outlive the arena memory they come from.
+template<typename T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+public:
+	explicit ArenaAllocator(LinearArena& arena) noexcept : m_pArena(&arena) {}
+
+	template<typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_pArena(other.GetArena()) {}
+
+	T* allocate(size_t count) { return m_pArena->AllocateArray<T>(count); }
+	void deallocate(T*, size_t) noexcept {}
+
+	LinearArena* GetArena() const noexcept { return m_pArena; }
+
+	template<typename U>
+	bool operator==(const ArenaAllocator<U>& other) const noexcept { return m_pArena == other.GetArena(); }
+
+	template<typename U>
+	bool operator!=(const ArenaAllocator<U>& other) const noexcept { return m_pArena != other.GetArena(); }
+
+private:
+	LinearArena* m_pArena;
+};
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+}
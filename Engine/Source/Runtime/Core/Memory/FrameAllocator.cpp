@@ -0,0 +1,17 @@
+#include "FrameAllocator.h"
+
+namespace engine
+{
+
+FrameAllocator::FrameAllocator(size_t capacity)
+	: m_arenas{ LinearArena(capacity), LinearArena(capacity) }
+{
+}
+
+void FrameAllocator::BeginFrame()
+{
+	++m_frameIndex;
+	GetArena().Reset();
+}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Core/Memory/LinearArena.h"
+
+#include <cstdint>
+
+namespace engine
+{
+
+// Double-buffered linear arenas for transient data of one frame.
+// Memory allocated in frame N stays valid until BeginFrame of frame N + 2, which covers bgfx::makeRef references
+// consumed by the render thread one frame later. Used by the thread which submits rendering only.
+class FrameAllocator final
+{
+public:
+	static constexpr size_t DefaultCapacity = 1U << 20;
+
+public:
+	explicit FrameAllocator(size_t capacity = DefaultCapacity);
+	FrameAllocator(const FrameAllocator&) = delete;
+	FrameAllocator& operator=(const FrameAllocator&) = delete;
+	FrameAllocator(FrameAllocator&&) = delete;
+	FrameAllocator& operator=(FrameAllocator&&) = delete;
+	~FrameAllocator() = default;
+
+	void BeginFrame();
+
+	LinearArena& GetArena() { return m_arenas[m_frameIndex & 1U]; }
+	const LinearArena& GetArena() const { return m_arenas[m_frameIndex & 1U]; }
+
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) { return GetArena().Allocate(size, alignment); }
+
+	template<typename T>
+	T* AllocateArray(size_t count) { return GetArena().AllocateArray<T>(count); }
+
+private:
+	LinearArena m_arenas[2];
+	uint64_t m_frameIndex = 0U;
+};
+
+}
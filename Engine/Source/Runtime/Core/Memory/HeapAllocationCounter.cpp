@@ -0,0 +1,77 @@
+#include "HeapAllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::atomic<uint64_t> s_allocationCount = 0U;
+std::atomic<uint64_t> s_allocationBytes = 0U;
+
+void* CountedAllocate(std::size_t size)
+{
+	s_allocationCount.fetch_add(1U, std::memory_order_relaxed);
+	s_allocationBytes.fetch_add(size, std::memory_order_relaxed);
+
+	while (true)
+	{
+		void* pMemory = std::malloc(size > 0U ? size : 1U);
+		if (pMemory)
+		{
+			return pMemory;
+		}
+
+		// Engine is built without exceptions so out of memory aborts after new handler gives up.
+		std::new_handler newHandler = std::get_new_handler();
+		if (!newHandler)
+		{
+			std::abort();
+		}
+		newHandler();
+	}
+}
+
+}
+
+namespace engine
+{
+
+HeapAllocationStats HeapAllocationCounter::GetStats()
+{
+	return HeapAllocationStats{ s_allocationCount.load(std::memory_order_relaxed), s_allocationBytes.load(std::memory_order_relaxed) };
+}
+
+}
+
+// Over-aligned and nothrow versions are not replaced so those allocations are not counted.
+void* operator new(std::size_t size)
+{
+	return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+	return CountedAllocate(size);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, std::size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory, std::size_t) noexcept
+{
+	std::free(pMemory);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine
+{
+
+struct HeapAllocationStats
+{
+	uint64_t count;
+	uint64_t bytes;
+};
+
+// Counts calls of global operator new of the whole process. Engine replaces the global allocation functions
+// in HeapAllocationCounter.cpp, so applications should not replace them again.
+class HeapAllocationCounter final
+{
+public:
+	HeapAllocationCounter() = delete;
+
+	static HeapAllocationStats GetStats();
+};
+
+}
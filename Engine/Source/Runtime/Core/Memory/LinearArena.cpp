@@ -0,0 +1,83 @@
+#include "LinearArena.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+
+namespace
+{
+
+size_t AlignUp(size_t value, size_t alignment)
+{
+	return (value + alignment - 1U) & ~(alignment - 1U);
+}
+
+}
+
+namespace engine
+{
+
+LinearArena::LinearArena(size_t capacity)
+	: m_pBuffer(std::make_unique_for_overwrite<std::byte[]>(capacity))
+	, m_capacity(capacity)
+{
+}
+
+void* LinearArena::Allocate(size_t size, size_t alignment)
+{
+	assert(std::has_single_bit(alignment) && "Alignment should be power of two.");
+
+	// Align the address instead of the offset as the buffer itself is only aligned to max_align_t.
+	uintptr_t bufferAddress = reinterpret_cast<uintptr_t>(m_pBuffer.get());
+	size_t alignedOffset = AlignUp(bufferAddress + m_offset, alignment) - bufferAddress;
+	if (alignedOffset + size <= m_capacity)
+	{
+		m_offset = alignedOffset + size;
+		m_peakSize = std::max(m_peakSize, GetUsedSize());
+		return m_pBuffer.get() + alignedOffset;
+	}
+
+	std::byte* pBlock = m_overflowBlocks.emplace_back(OverflowBlock{ std::make_unique_for_overwrite<std::byte[]>(size + alignment), size + alignment }).pData.get();
+	m_overflowSize += size + alignment;
+	m_peakSize = std::max(m_peakSize, GetUsedSize());
+
+	uintptr_t blockAddress = reinterpret_cast<uintptr_t>(pBlock);
+	return pBlock + (AlignUp(blockAddress, alignment) - blockAddress);
+}
+
+void LinearArena::Reset()
+{
+	m_overflowBlocks.clear();
+	m_overflowSize = 0U;
+
+	// Grow once to the peak so that the same workload fits next time. Overflow may be rewound already.
+	if (m_peakSize > m_capacity)
+	{
+		m_capacity = std::bit_ceil(m_peakSize);
+		m_pBuffer = std::make_unique_for_overwrite<std::byte[]>(m_capacity);
+	}
+
+	m_offset = 0U;
+}
+
+void LinearArena::Rewind(Marker marker)
+{
+	assert(marker.offset <= m_offset && marker.overflowBlockCount <= m_overflowBlocks.size());
+
+	// Arena can only grow when nothing is alive in it.
+	if (0U == marker.offset && 0U == marker.overflowBlockCount)
+	{
+		Reset();
+		return;
+	}
+
+	while (m_overflowBlocks.size() > marker.overflowBlockCount)
+	{
+		m_overflowSize -= m_overflowBlocks.back().size;
+		m_overflowBlocks.pop_back();
+	}
+	m_offset = marker.offset;
+}
+
+}
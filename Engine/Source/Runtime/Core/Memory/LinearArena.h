@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace engine
+{
+
+// Bump allocator. Memory is released all at once by Reset or back to a marker by Rewind.
+// When a request doesn't fit, it falls back to a heap block and the next Reset grows the arena to the peak size,
+// so allocations stop touching the heap once the workload is stable. Not thread safe.
+class LinearArena final
+{
+public:
+	// Overflow blocks are part of the marker, so rewinding a nested scope never releases blocks of outer scopes.
+	struct Marker
+	{
+		size_t offset;
+		size_t overflowBlockCount;
+	};
+
+public:
+	explicit LinearArena(size_t capacity);
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+	LinearArena(LinearArena&&) = delete;
+	LinearArena& operator=(LinearArena&&) = delete;
+	~LinearArena() = default;
+
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	template<typename T>
+	T* AllocateArray(size_t count) { return static_cast<T*>(Allocate(count * sizeof(T), alignof(T))); }
+
+	void Reset();
+	Marker GetMarker() const { return Marker{ m_offset, m_overflowBlocks.size() }; }
+	void Rewind(Marker marker);
+
+	size_t GetCapacity() const { return m_capacity; }
+	size_t GetUsedSize() const { return m_offset + m_overflowSize; }
+	size_t GetPeakSize() const { return m_peakSize; }
+	// Count of live allocations which missed the arena and went to the heap.
+	uint32_t GetOverflowCount() const { return static_cast<uint32_t>(m_overflowBlocks.size()); }
+
+private:
+	struct OverflowBlock
+	{
+		std::unique_ptr<std::byte[]> pData;
+		size_t size;
+	};
+
+private:
+	std::unique_ptr<std::byte[]> m_pBuffer;
+	size_t m_capacity;
+	size_t m_offset = 0U;
+	size_t m_peakSize = 0U;
+
+	std::vector<OverflowBlock> m_overflowBlocks;
+	size_t m_overflowSize = 0U;
+};
+
+}
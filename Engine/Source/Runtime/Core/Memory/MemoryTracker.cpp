@@ -0,0 +1,204 @@
+#include "MemoryTracker.h"
+
+#include "Log/Log.h"
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+
+constexpr size_t TagCount = static_cast<size_t>(engine::MemoryTag::Count);
+
+constexpr const char* TagNames[] =
+{
+	"Mesh",
+	"Texture",
+	"Shader",
+	"Particle",
+	"Scene",
+	"ImGui",
+	"Bgfx",
+};
+static_assert(sizeof(TagNames) / sizeof(TagNames[0]) == TagCount);
+
+struct TagCounters
+{
+	std::atomic<uint64_t> currentBytes = 0U;
+	std::atomic<uint64_t> peakBytes = 0U;
+	std::atomic<uint64_t> liveAllocationCount = 0U;
+	std::atomic<uint64_t> totalAllocationCount = 0U;
+	std::atomic<uint64_t> budgetBytes = 0U;
+};
+
+// Constant initialized so allocators of static objects can report before main.
+TagCounters s_tagCounters[TagCount];
+
+TagCounters& GetCounters(engine::MemoryTag tag)
+{
+	return s_tagCounters[static_cast<size_t>(tag)];
+}
+
+}
+
+namespace engine
+{
+
+const char* MemoryTracker::GetTagName(MemoryTag tag)
+{
+	return static_cast<size_t>(tag) < TagCount ? TagNames[static_cast<size_t>(tag)] : "Unknown";
+}
+
+bool MemoryTracker::FindTag(const char* pName, MemoryTag& outTag)
+{
+	for (size_t tagIndex = 0U; tagIndex < TagCount; ++tagIndex)
+	{
+		if (0 == std::strcmp(pName, TagNames[tagIndex]))
+		{
+			outTag = static_cast<MemoryTag>(tagIndex);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void MemoryTracker::OnAllocate(MemoryTag tag, size_t size)
+{
+	TagCounters& counters = GetCounters(tag);
+	counters.liveAllocationCount.fetch_add(1U, std::memory_order_relaxed);
+	counters.totalAllocationCount.fetch_add(1U, std::memory_order_relaxed);
+
+	uint64_t currentBytes = counters.currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+	uint64_t peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+	while (currentBytes > peakBytes && !counters.peakBytes.compare_exchange_weak(peakBytes, currentBytes, std::memory_order_relaxed))
+	{
+	}
+}
+
+void MemoryTracker::OnFree(MemoryTag tag, size_t size)
+{
+	TagCounters& counters = GetCounters(tag);
+	counters.liveAllocationCount.fetch_sub(1U, std::memory_order_relaxed);
+	counters.currentBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+MemoryTagStats MemoryTracker::GetStats(MemoryTag tag)
+{
+	const TagCounters& counters = GetCounters(tag);
+	return MemoryTagStats{
+		counters.currentBytes.load(std::memory_order_relaxed),
+		counters.peakBytes.load(std::memory_order_relaxed),
+		counters.liveAllocationCount.load(std::memory_order_relaxed),
+		counters.totalAllocationCount.load(std::memory_order_relaxed),
+		counters.budgetBytes.load(std::memory_order_relaxed) };
+}
+
+void MemoryTracker::ResetPeak(MemoryTag tag)
+{
+	TagCounters& counters = GetCounters(tag);
+	counters.peakBytes.store(counters.currentBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void MemoryTracker::SetBudget(MemoryTag tag, uint64_t bytes)
+{
+	GetCounters(tag).budgetBytes.store(bytes, std::memory_order_relaxed);
+}
+
+bool MemoryTracker::IsOverBudget(MemoryTag tag)
+{
+	MemoryTagStats stats = GetStats(tag);
+	return stats.budgetBytes > 0U && stats.peakBytes > stats.budgetBytes;
+}
+
+uint32_t MemoryTracker::ReportLeaks()
+{
+	uint32_t leakTagCount = 0U;
+	for (size_t tagIndex = 0U; tagIndex < TagCount; ++tagIndex)
+	{
+		MemoryTagStats stats = GetStats(static_cast<MemoryTag>(tagIndex));
+		if (0U == stats.liveAllocationCount && 0U == stats.currentBytes)
+		{
+			continue;
+		}
+
+		CD_ENGINE_WARN("Memory leak : {0} has {1} live allocations, {2} bytes.", TagNames[tagIndex], stats.liveAllocationCount, stats.currentBytes);
+		++leakTagCount;
+	}
+
+	return leakTagCount;
+}
+
+bool MemoryTracker::WriteReport(const char* pFilePath)
+{
+	std::ofstream fout(pFilePath, std::ios::out | std::ios::trunc);
+	if (!fout.is_open())
+	{
+		CD_ENGINE_ERROR("Failed to write memory report to {0}", pFilePath);
+		return false;
+	}
+
+	fout << "{\"tags\":[\n";
+	for (size_t tagIndex = 0U; tagIndex < TagCount; ++tagIndex)
+	{
+		MemoryTag tag = static_cast<MemoryTag>(tagIndex);
+		MemoryTagStats stats = GetStats(tag);
+
+		char text[320];
+		std::snprintf(text, sizeof(text),
+			"%s{\"name\":\"%s\",\"currentBytes\":%" PRIu64 ",\"peakBytes\":%" PRIu64 ",\"liveAllocations\":%" PRIu64
+			",\"totalAllocations\":%" PRIu64 ",\"budgetBytes\":%" PRIu64 ",\"overBudget\":%s}",
+			tagIndex > 0U ? ",\n" : "", TagNames[tagIndex], stats.currentBytes, stats.peakBytes, stats.liveAllocationCount,
+			stats.totalAllocationCount, stats.budgetBytes, IsOverBudget(tag) ? "true" : "false");
+		fout << text;
+	}
+	fout << "\n]}\n";
+
+	return true;
+}
+
+TrackedMemorySize& TrackedMemorySize::operator=(const TrackedMemorySize& other)
+{
+	if (this != &other)
+	{
+		Set(0U);
+		m_tag = other.m_tag;
+		Set(other.m_size);
+	}
+	return *this;
+}
+
+TrackedMemorySize& TrackedMemorySize::operator=(TrackedMemorySize&& other) noexcept
+{
+	if (this != &other)
+	{
+		Set(0U);
+		m_tag = other.m_tag;
+		m_size = other.m_size;
+		other.m_size = 0U;
+	}
+	return *this;
+}
+
+void TrackedMemorySize::Set(size_t size)
+{
+	if (size == m_size)
+	{
+		return;
+	}
+
+	if (m_size > 0U)
+	{
+		MemoryTracker::OnFree(m_tag, m_size);
+	}
+	if (size > 0U)
+	{
+		MemoryTracker::OnAllocate(m_tag, size);
+	}
+	m_size = size;
+}
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace engine
+{
+
+// Subsystems which report their memory. Add new tags before Count and give them a name in MemoryTracker.cpp.
+enum class MemoryTag : uint8_t
+{
+	Mesh,
+	Texture,
+	Shader,
+	Particle,
+	Scene,
+	ImGui,
+	Bgfx,
+
+	Count,
+};
+
+struct MemoryTagStats
+{
+	uint64_t currentBytes;
+	uint64_t peakBytes;
+	uint64_t liveAllocationCount;
+	uint64_t totalAllocationCount;
+	// 0 means no budget.
+	uint64_t budgetBytes;
+};
+
+// Per tag totals and high-water marks. Counters are atomic so allocators of any thread can report to it.
+class MemoryTracker final
+{
+public:
+	MemoryTracker() = delete;
+
+	static const char* GetTagName(MemoryTag tag);
+	static bool FindTag(const char* pName, MemoryTag& outTag);
+
+	static void OnAllocate(MemoryTag tag, size_t size);
+	static void OnFree(MemoryTag tag, size_t size);
+
+	static MemoryTagStats GetStats(MemoryTag tag);
+	static void ResetPeak(MemoryTag tag);
+
+	static void SetBudget(MemoryTag tag, uint64_t bytes);
+	static bool IsOverBudget(MemoryTag tag);
+
+	// Logs tags which still have live allocations and returns how many tags leak.
+	// Call it after subsystems shut down.
+	static uint32_t ReportLeaks();
+
+	// JSON with one entry per tag so CI can compare them to budgets.
+	static bool WriteReport(const char* pFilePath);
+};
+
+// Accounts memory of containers which can't take a tracking allocator, e.g. buffers built by AssetPipeline.
+// Owners call Set after the size changes. Copies account the copied memory again.
+class TrackedMemorySize final
+{
+public:
+	explicit TrackedMemorySize(MemoryTag tag) : m_tag(tag) {}
+	TrackedMemorySize(const TrackedMemorySize& other) : m_tag(other.m_tag) { Set(other.m_size); }
+	TrackedMemorySize& operator=(const TrackedMemorySize& other);
+	TrackedMemorySize(TrackedMemorySize&& other) noexcept : m_tag(other.m_tag), m_size(other.m_size) { other.m_size = 0U; }
+	TrackedMemorySize& operator=(TrackedMemorySize&& other) noexcept;
+	~TrackedMemorySize() { Set(0U); }
+
+	void Set(size_t size);
+	size_t Get() const { return m_size; }
+
+private:
+	MemoryTag m_tag;
+	size_t m_size = 0U;
+};
+
+}
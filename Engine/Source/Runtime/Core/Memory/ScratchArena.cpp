@@ -0,0 +1,12 @@
+#include "ScratchArena.h"
+
+namespace engine
+{
+
+LinearArena& ScratchArena::Get()
+{
+	thread_local LinearArena t_arena(DefaultCapacity);
+	return t_arena;
+}
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Core/Memory/LinearArena.h"
+
+namespace engine
+{
+
+// Thread local arena for temporary memory which doesn't outlive a function call.
+class ScratchArena final
+{
+public:
+	static constexpr size_t DefaultCapacity = 64U << 10;
+
+public:
+	ScratchArena() = delete;
+
+	static LinearArena& Get();
+};
+
+// Rewinds the scratch arena of current thread back when it goes out of scope. Scopes can be nested.
+class ScratchScope final
+{
+public:
+	ScratchScope()
+		: m_arena(ScratchArena::Get())
+		, m_marker(m_arena.GetMarker())
+	{
+	}
+
+	ScratchScope(const ScratchScope&) = delete;
+	ScratchScope& operator=(const ScratchScope&) = delete;
+	ScratchScope(ScratchScope&&) = delete;
+	ScratchScope& operator=(ScratchScope&&) = delete;
+
+	~ScratchScope()
+	{
+		m_arena.Rewind(m_marker);
+	}
+
+	LinearArena& GetArena() { return m_arena; }
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) { return m_arena.Allocate(size, alignment); }
+
+	template<typename T>
+	T* AllocateArray(size_t count) { return m_arena.AllocateArray<T>(count); }
+
+private:
+	LinearArena& m_arena;
+	LinearArena::Marker m_marker;
+};
+
+}
@@ -0,0 +1,78 @@
+#include "TrackedBxAllocator.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+struct BlockHeader
+{
+	size_t size;
+	uint32_t headerSize;
+	uint32_t alignment;
+};
+
+// Header space is a multiple of the requested alignment so the user block stays aligned.
+constexpr size_t MinHeaderSize = 16U;
+static_assert(sizeof(BlockHeader) <= MinHeaderSize);
+
+BlockHeader* GetHeader(void* pMemory)
+{
+	return reinterpret_cast<BlockHeader*>(static_cast<std::byte*>(pMemory) - sizeof(BlockHeader));
+}
+
+}
+
+namespace engine
+{
+
+void* TrackedBxAllocator::realloc(void* pMemory, size_t size, size_t alignment, const char* pFilePath, uint32_t line)
+{
+	if (!pMemory)
+	{
+		return size > 0U ? Allocate(size, alignment, pFilePath, line) : nullptr;
+	}
+
+	if (0U == size)
+	{
+		Free(pMemory, pFilePath, line);
+		return nullptr;
+	}
+
+	void* pNewMemory = Allocate(size, alignment, pFilePath, line);
+	if (pNewMemory)
+	{
+		std::memcpy(pNewMemory, pMemory, std::min(size, GetHeader(pMemory)->size));
+		Free(pMemory, pFilePath, line);
+	}
+	return pNewMemory;
+}
+
+void* TrackedBxAllocator::Allocate(size_t size, size_t alignment, const char* pFilePath, uint32_t line)
+{
+	const size_t headerSize = std::max(alignment, MinHeaderSize);
+	auto* pBlock = static_cast<std::byte*>(m_allocator.realloc(nullptr, headerSize + size, alignment, pFilePath, line));
+	if (!pBlock)
+	{
+		return nullptr;
+	}
+
+	void* pMemory = pBlock + headerSize;
+	BlockHeader* pHeader = GetHeader(pMemory);
+	pHeader->size = size;
+	pHeader->headerSize = static_cast<uint32_t>(headerSize);
+	pHeader->alignment = static_cast<uint32_t>(alignment);
+	MemoryTracker::OnAllocate(m_tag, size);
+
+	return pMemory;
+}
+
+void TrackedBxAllocator::Free(void* pMemory, const char* pFilePath, uint32_t line)
+{
+	const BlockHeader header = *GetHeader(pMemory);
+	MemoryTracker::OnFree(m_tag, header.size);
+	m_allocator.realloc(static_cast<std::byte*>(pMemory) - header.headerSize, 0U, header.alignment, pFilePath, line);
+}
+
+}
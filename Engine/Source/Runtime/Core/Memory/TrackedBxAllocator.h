@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Core/Memory/MemoryTracker.h"
+
+#include <bx/allocator.h>
+
+namespace engine
+{
+
+// Forwards to bx::DefaultAllocator and reports sizes to MemoryTracker.
+// bx frees without a size so every block keeps a small header in front of it.
+class TrackedBxAllocator final : public bx::AllocatorI
+{
+public:
+	explicit TrackedBxAllocator(MemoryTag tag) : m_tag(tag) {}
+	TrackedBxAllocator(const TrackedBxAllocator&) = delete;
+	TrackedBxAllocator& operator=(const TrackedBxAllocator&) = delete;
+	TrackedBxAllocator(TrackedBxAllocator&&) = delete;
+	TrackedBxAllocator& operator=(TrackedBxAllocator&&) = delete;
+	virtual ~TrackedBxAllocator() = default;
+
+	virtual void* realloc(void* pMemory, size_t size, size_t alignment, const char* pFilePath, uint32_t line) override;
+
+	MemoryTag GetTag() const { return m_tag; }
+
+private:
+	void* Allocate(size_t size, size_t alignment, const char* pFilePath, uint32_t line);
+	void Free(void* pMemory, const char* pFilePath, uint32_t line);
+
+private:
+	MemoryTag m_tag;
+	bx::DefaultAllocator m_allocator;
+};
+
+}
@@ -378,10 +378,9 @@ void CameraController::CameraFocus()
 	if (TransformComponent* pTransform = m_pSceneWorld->GetTransformComponent(selectedEntity))
 	{
 		m_isMoving = true;
-		if (CollisionMeshComponent* pCollisionMesh = m_pSceneWorld->GetCollisionMeshComponent(selectedEntity))
+		cd::AABB meshAABB;
+		if (m_pSceneWorld->GetSceneQuery()->GetEntityWorldAABB(selectedEntity, meshAABB))
 		{
-			cd::AABB meshAABB = pCollisionMesh->GetAABB();
-			meshAABB = meshAABB.Transform(pTransform->GetWorldMatrix());
 			m_distanceFromLookAt = (meshAABB.Max() - meshAABB.Center()).Length() * 3.0f;
 			m_eyeDestination = meshAABB.Center() - m_lookAt * m_distanceFromLookAt;
 			m_movementSpeed = meshAABB.Size().Length() * 1.5f;
@@ -0,0 +1,70 @@
+#include "Frustum.h"
+
+#include <cmath>
+
+namespace engine
+{
+
+void Frustum::Build(const cd::Matrix4x4& matrix)
+{
+	// Matrix is stored in column major. Row i is (m[i], m[4 + i], m[8 + i], m[12 + i]).
+	const float* m = matrix.begin();
+	auto GetRow = [m](uint32_t index) -> cd::Vec4f
+	{
+		return cd::Vec4f(m[index], m[4 + index], m[8 + index], m[12 + index]);
+	};
+
+	const cd::Vec4f row0 = GetRow(0);
+	const cd::Vec4f row1 = GetRow(1);
+	const cd::Vec4f row2 = GetRow(2);
+	const cd::Vec4f row3 = GetRow(3);
+
+	m_planes[0] = row3 + row0; // Left
+	m_planes[1] = row3 - row0; // Right
+	m_planes[2] = row3 + row1; // Bottom
+	m_planes[3] = row3 - row1; // Top
+	m_planes[4] = row3 - row2; // Far
+
+	for (cd::Vec4f& plane : m_planes)
+	{
+		float length = std::sqrt(plane.x() * plane.x() + plane.y() * plane.y() + plane.z() * plane.z());
+		if (length > 0.0f)
+		{
+			plane /= length;
+		}
+	}
+}
+
+bool Frustum::Intersects(const cd::AABB& aabb) const
+{
+	const cd::Point& min = aabb.Min();
+	const cd::Point& max = aabb.Max();
+	for (const cd::Vec4f& plane : m_planes)
+	{
+		// Test the corner which is the farthest along the plane normal.
+		float x = plane.x() >= 0.0f ? max.x() : min.x();
+		float y = plane.y() >= 0.0f ? max.y() : min.y();
+		float z = plane.z() >= 0.0f ? max.z() : min.z();
+		if (plane.x() * x + plane.y() * y + plane.z() * z + plane.w() < 0.0f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool Frustum::Intersects(const cd::Point& center, float radius) const
+{
+	for (const cd::Vec4f& plane : m_planes)
+	{
+		if (plane.x() * center.x() + plane.y() * center.y() + plane.z() * center.z() + plane.w() < -radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Core/Types.h"
+#include "Math/Box.hpp"
+#include "Math/Matrix.hpp"
+
+#include <array>
+
+namespace engine
+{
+
+// Frustum is a set of planes extracted from a combined (projection * view * model) matrix.
+// Planes are stored as (normal, distance) so that a point is inside when dot(normal, point) + distance >= 0.
+// Near plane is skipped on purpose. It is always a conservative test for both NDC depth ranges.
+class Frustum final
+{
+public:
+	static constexpr uint32_t PlaneCount = 5U;
+
+public:
+	Frustum() = default;
+	explicit Frustum(const cd::Matrix4x4& matrix) { Build(matrix); }
+	Frustum(const Frustum&) = default;
+	Frustum& operator=(const Frustum&) = default;
+	Frustum(Frustum&&) = default;
+	Frustum& operator=(Frustum&&) = default;
+	~Frustum() = default;
+
+	void Build(const cd::Matrix4x4& matrix);
+
+	bool Intersects(const cd::AABB& aabb) const;
+	bool Intersects(const cd::Point& center, float radius) const;
+
+private:
+	std::array<cd::Vec4f, PlaneCount> m_planes;
+};
+
+}
@@ -23,6 +23,14 @@ void CameraComponent::BuildProjectMatrix()
 }
 
 cd::Ray CameraComponent::EmitRay(float screenX, float screenY, float width, float height) const
+{
+	cd::Vec3f origin;
+	cd::Vec3f direction;
+	EmitRay(screenX, screenY, width, height, origin, direction);
+	return cd::Ray(origin, direction);
+}
+
+void CameraComponent::EmitRay(float screenX, float screenY, float width, float height, cd::Vec3f& outOrigin, cd::Vec3f& outDirection) const
 {
 	cd::Matrix4x4 vpInverse = m_projectionMatrix * m_viewMatrix;
 	vpInverse = vpInverse.Inverse();
@@ -37,8 +45,8 @@ cd::Ray CameraComponent::EmitRay(float screenX, float screenY, float width, floa
 	far /= far.w();
 
 	cd::Vec4f direction = (far - near).Normalize();
-	return cd::Ray(cd::Vec3f(near.x(), near.y(), near.z()),
-		cd::Vec3f(direction.x(), direction.y(), direction.z()));
+	outOrigin = cd::Vec3f(near.x(), near.y(), near.z());
+	outDirection = cd::Vec3f(direction.x(), direction.y(), direction.z());
 }
 
 void CameraComponent::SetLookAt(const cd::Vec3f& lookAt, cd::Transform& transform)
@@ -78,4 +86,35 @@ void CameraComponent::FrameAll(const cd::AABB& aabb, cd::Transform& transform)
 	transform.SetTranslation(cd::MoveTemp(lookFrom));
 }
 
-}
\ No newline at end of file
+void ComponentSerializer<CameraComponent>::Write(SnapshotWriter& writer, const CameraComponent& component)
+{
+	writer.WriteValue(component.m_aspect);
+	writer.WriteValue(component.m_fov);
+	writer.WriteValue(component.m_nearPlane);
+	writer.WriteValue(component.m_farPlane);
+	writer.WriteValue(static_cast<uint8_t>(component.m_ndcDepth));
+	writer.WriteValue(component.m_exposure);
+	writer.WriteValue(component.m_gammaCorrection);
+	writer.WriteValue(static_cast<uint8_t>(component.m_toneMappingMode));
+}
+
+void ComponentSerializer<CameraComponent>::Read(SnapshotReader& reader, CameraComponent& component, uint32_t)
+{
+	uint8_t ndcDepth;
+	uint8_t toneMappingMode;
+	reader.ReadValue(component.m_aspect);
+	reader.ReadValue(component.m_fov);
+	reader.ReadValue(component.m_nearPlane);
+	reader.ReadValue(component.m_farPlane);
+	reader.ReadValue(ndcDepth);
+	reader.ReadValue(component.m_exposure);
+	reader.ReadValue(component.m_gammaCorrection);
+	reader.ReadValue(toneMappingMode);
+	component.m_ndcDepth = static_cast<cd::NDCDepth>(ndcDepth);
+	component.m_toneMappingMode = static_cast<cd::ToneMappingMode>(toneMappingMode);
+
+	component.BuildProjectMatrix();
+	component.Dirty();
+}
+
+}
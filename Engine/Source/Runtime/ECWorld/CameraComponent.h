@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/Types.h"
+#include "ECWorld/ComponentSerializer.h"
 #include "Math/Box.hpp"
 #include "Math/Ray.hpp"
 
@@ -37,6 +38,9 @@ namespace engine
 
 class CameraComponent final
 {
+public:
+	friend struct ComponentSerializer<CameraComponent>;
+
 public:
 	static constexpr StringCrc GetClassName()
 	{
@@ -53,6 +57,7 @@ public:
 	~CameraComponent() = default;
 
 	cd::Ray EmitRay(float screenX, float screenY, float width, float height) const;
+	void EmitRay(float screenX, float screenY, float width, float height, cd::Vec3f& outOrigin, cd::Vec3f& outDirection) const;
 
 	void SetAspect(float aspect) { m_aspect = aspect; m_isProjectionDirty = true; }
 	void SetAspect(uint16_t width, uint16_t height) { SetAspect(static_cast<float>(width) / static_cast<float>(height)); }
@@ -191,4 +196,16 @@ private:
 #endif
 };
 
-}
\ No newline at end of file
+// Stores inputs which are shared by editor and game builds. Matrices are built again after loading.
+template<>
+struct ComponentSerializer<CameraComponent>
+{
+	static constexpr bool IsSupported = true;
+	static constexpr bool IsTrivial = false;
+	static constexpr uint32_t Version = 1U;
+
+	static void Write(SnapshotWriter& writer, const CameraComponent& component);
+	static void Read(SnapshotReader& reader, CameraComponent& component, uint32_t version);
+};
+
+}
@@ -1,10 +1,9 @@
 #pragma once
 
 #include "Core/StringCrc.h"
+#include "ECWorld/ComponentSerializer.h"
 #include "Math/Box.hpp"
 
-#include <vector>
-
 namespace engine
 {
 
@@ -36,12 +35,8 @@ public:
 
 	void SetAABB(cd::AABB aabb) { m_aabb = cd::MoveTemp(aabb); }
 	const cd::AABB& GetAABB() const { return m_aabb; }
-	
-	uint16_t GetVertexBuffer() const { return m_aabbVBH; }
-	uint16_t GetIndexBuffer() const { return m_aabbIBH; }
 
 	void Reset();
-	void Build();
 
 #ifdef EDITOR_MODE
 	void SetEnableDebugDraw(bool enable) { m_enableDebugDraw = enable; }
@@ -53,14 +48,20 @@ private:
 	CollisonMeshType m_collisionType = CollisonMeshType::AABB;
 	cd::AABB m_aabb;
 
-	std::vector<std::byte> m_aabbVertexBuffer;
-	std::vector<std::byte> m_aabbIndexBuffer;
-	uint16_t m_aabbVBH = UINT16_MAX;
-	uint16_t m_aabbIBH = UINT16_MAX;
-
 #ifdef EDITOR_MODE
 	bool m_enableDebugDraw = false;
 #endif
 };
 
-}
\ No newline at end of file
+template<>
+struct ComponentSerializer<CollisionMeshComponent>
+{
+	static constexpr bool IsSupported = true;
+	static constexpr bool IsTrivial = false;
+	static constexpr uint32_t Version = 1U;
+
+	static void Write(SnapshotWriter& writer, const CollisionMeshComponent& component);
+	static void Read(SnapshotReader& reader, CollisionMeshComponent& component, uint32_t version);
+};
+
+}
@@ -0,0 +1,26 @@
+#include "ComponentSerializer.h"
+
+#include "ECWorld/World.h"
+
+namespace engine
+{
+
+Entity SnapshotReader::RemapEntity(Entity entity)
+{
+	if (INVALID_ENTITY == entity)
+	{
+		return INVALID_ENTITY;
+	}
+
+	auto itEntity = m_entityRemap.find(entity);
+	if (itEntity != m_entityRemap.end())
+	{
+		return itEntity->second;
+	}
+
+	Entity newEntity = m_pWorld->CreateEntity();
+	m_entityRemap.emplace(entity, newEntity);
+	return newEntity;
+}
+
+}
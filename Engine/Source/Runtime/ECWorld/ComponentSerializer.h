@@ -0,0 +1,143 @@
+#pragma once
+
+#include "ECWorld/Entity.h"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+namespace engine
+{
+
+class World;
+
+class SnapshotWriter final
+{
+public:
+	explicit SnapshotWriter(std::ostream& stream) : m_stream(stream) {}
+	SnapshotWriter(const SnapshotWriter&) = delete;
+	SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+	SnapshotWriter(SnapshotWriter&&) = delete;
+	SnapshotWriter& operator=(SnapshotWriter&&) = delete;
+	~SnapshotWriter() = default;
+
+	template<typename T>
+	void WriteValue(const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		WriteBytes(&value, sizeof(T));
+	}
+
+	void WriteBytes(const void* pData, size_t size) { m_stream.write(static_cast<const char*>(pData), static_cast<std::streamsize>(size)); }
+
+	void WriteString(std::string_view text)
+	{
+		WriteValue(static_cast<uint32_t>(text.size()));
+		WriteBytes(text.data(), text.size());
+	}
+
+	std::ostream& GetStream() { return m_stream; }
+	bool IsOk() const { return m_stream.good(); }
+
+private:
+	std::ostream& m_stream;
+};
+
+// Entities of a snapshot file are created again in the loading world on first use,
+// so references between components stay valid and never collide with existing entities.
+class SnapshotReader final
+{
+public:
+	explicit SnapshotReader(std::istream& stream, World* pWorld) : m_stream(stream), m_pWorld(pWorld) {}
+	SnapshotReader(const SnapshotReader&) = delete;
+	SnapshotReader& operator=(const SnapshotReader&) = delete;
+	SnapshotReader(SnapshotReader&&) = delete;
+	SnapshotReader& operator=(SnapshotReader&&) = delete;
+	~SnapshotReader() = default;
+
+	template<typename T>
+	void ReadValue(T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		ReadBytes(&value, sizeof(T));
+	}
+
+	void ReadBytes(void* pData, size_t size) { m_stream.read(static_cast<char*>(pData), static_cast<std::streamsize>(size)); }
+	void Skip(uint64_t size) { m_stream.ignore(static_cast<std::streamsize>(size)); }
+
+	void ReadString(std::string& text)
+	{
+		uint32_t size = 0U;
+		ReadValue(size);
+		text.resize(IsOk() ? size : 0U);
+		ReadBytes(text.data(), text.size());
+	}
+
+	Entity RemapEntity(Entity entity);
+
+	std::istream& GetStream() { return m_stream; }
+	bool IsOk() const { return m_stream.good(); }
+
+private:
+	std::istream& m_stream;
+	World* m_pWorld;
+	std::unordered_map<Entity, Entity> m_entityRemap;
+};
+
+// Components opt in to binary snapshots by specializing ComponentSerializer. Components which refer to
+// runtime resources don't, so they are only kept by in-memory snapshots and rebuilt by importers.
+// Custom serializers provide :
+//   static constexpr bool IsSupported = true;
+//   static constexpr bool IsTrivial = false;
+//   static constexpr uint32_t Version;
+//   static void Write(SnapshotWriter& writer, const Component& component);
+//   static void Read(SnapshotReader& reader, Component& component, uint32_t version);
+// Read gets the version of data in the file which is never newer than Version.
+template<typename Component>
+struct ComponentSerializer
+{
+	static constexpr bool IsSupported = false;
+	static constexpr bool IsTrivial = false;
+	static constexpr uint32_t Version = 0U;
+};
+
+// Writes the dense component array with one copy. Data is only read back when both Version and sizeof match,
+// so bump Version when the layout changes. Components referring to entities hide RemapEntities to fix them after reading.
+template<typename Component, uint32_t LayoutVersion>
+struct TrivialComponentSerializer
+{
+	static_assert(std::is_trivially_copyable_v<Component>);
+
+	static constexpr bool IsSupported = true;
+	static constexpr bool IsTrivial = true;
+	static constexpr uint32_t Version = LayoutVersion;
+
+	static void Write(SnapshotWriter& writer, const Component* pComponents, size_t count)
+	{
+		writer.WriteBytes(pComponents, count * sizeof(Component));
+	}
+
+	static void Read(SnapshotReader& reader, Component* pComponents, size_t count)
+	{
+		reader.ReadBytes(pComponents, count * sizeof(Component));
+	}
+
+	static void RemapEntities(SnapshotReader&, Component*, size_t) {}
+};
+
+// Components which own GPU resources created by renderers specialize it, so in-memory snapshots never share them with the live world.
+// Specializations provide :
+//   static constexpr bool IsSupported = true;
+//   static void Release(Component& component);	// Destroys resources and forgets handles.
+//   static void Detach(Component& component);	// Forgets handles without destroying so renderers create them again.
+template<typename Component>
+struct ComponentRuntimeResources
+{
+	static constexpr bool IsSupported = false;
+};
+
+}
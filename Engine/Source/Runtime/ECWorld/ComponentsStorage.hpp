@@ -1,10 +1,14 @@
 #pragma once
 
+#include "Base/Template.h"
+#include "ComponentSerializer.h"
 #include "Entity.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -15,6 +19,30 @@ class IComponentsStorage
 {
 public:
 	virtual ~IComponentsStorage() = default;
+
+	// In-memory snapshots copy components as they are. Call DetachRuntimeResources on copies which must not share
+	// runtime resources with the source storage.
+	virtual std::unique_ptr<IComponentsStorage> Clone() const = 0;
+	virtual void CopyFrom(const IComponentsStorage& other) = 0;
+	virtual void ReleaseRuntimeResources() = 0;
+	virtual void DetachRuntimeResources() = 0;
+
+	// Removes all components without releasing their runtime resources.
+	virtual void Clear() = 0;
+
+	virtual size_t GetCount() const = 0;
+
+	// Binary snapshots. Storages are skipped when their component type has no ComponentSerializer.
+	virtual bool IsSerializable() const = 0;
+	virtual bool CanDeserialize(uint32_t version, uint32_t componentSize) const = 0;
+	virtual uint32_t GetSerializerVersion() const = 0;
+	virtual uint32_t GetComponentSize() const = 0;
+
+	// Writes entities and then components in dense order.
+	virtual void Serialize(SnapshotWriter& writer) const = 0;
+
+	// Reads the next count components of a section. Entities are already remapped to the loading world.
+	virtual void Deserialize(SnapshotReader& reader, uint32_t version, const Entity* pEntities, size_t count) = 0;
 };
 
 // ComponentsStorage stores an array of Components in the same type and the entity which contains the component.
@@ -24,6 +52,9 @@ class ComponentsStorage : public IComponentsStorage
 public:
 	static_assert(!std::is_pointer_v<Component> && !std::is_reference_v<Component>);
 
+	using Serializer = ComponentSerializer<Component>;
+	using RuntimeResources = ComponentRuntimeResources<Component>;
+
 public:
 	ComponentsStorage() = default;
 	ComponentsStorage(const ComponentsStorage&) = delete;
@@ -32,11 +63,112 @@ public:
 	ComponentsStorage& operator=(ComponentsStorage&&) = default;
 	virtual ~ComponentsStorage() = default;
 
+	virtual std::unique_ptr<IComponentsStorage> Clone() const override
+	{
+		auto pStorage = std::make_unique<ComponentsStorage>();
+		pStorage->CopyFrom(*this);
+		return pStorage;
+	}
+
+	virtual void CopyFrom(const IComponentsStorage& other) override
+	{
+		const auto& otherStorage = static_cast<const ComponentsStorage&>(other);
+		m_entities = otherStorage.m_entities;
+		m_components = otherStorage.m_components;
+		m_entityToIndex = otherStorage.m_entityToIndex;
+		++m_version;
+	}
+
+	virtual void ReleaseRuntimeResources() override
+	{
+		if constexpr (RuntimeResources::IsSupported)
+		{
+			for (Component& component : m_components)
+			{
+				RuntimeResources::Release(component);
+			}
+		}
+	}
+
+	virtual void DetachRuntimeResources() override
+	{
+		if constexpr (RuntimeResources::IsSupported)
+		{
+			for (Component& component : m_components)
+			{
+				RuntimeResources::Detach(component);
+			}
+		}
+	}
+
+	virtual void Clear() override
+	{
+		m_entities.clear();
+		m_components.clear();
+		m_entityToIndex.clear();
+		++m_version;
+	}
+
+	virtual bool IsSerializable() const override { return Serializer::IsSupported; }
+
+	virtual bool CanDeserialize(uint32_t version, uint32_t componentSize) const override
+	{
+		if constexpr (Serializer::IsTrivial)
+		{
+			return version == Serializer::Version && componentSize == sizeof(Component);
+		}
+		else
+		{
+			return Serializer::IsSupported && version <= Serializer::Version;
+		}
+	}
+
+	virtual uint32_t GetSerializerVersion() const override { return Serializer::Version; }
+	virtual uint32_t GetComponentSize() const override { return static_cast<uint32_t>(sizeof(Component)); }
+
+	virtual void Serialize(SnapshotWriter& writer) const override
+	{
+		writer.WriteBytes(m_entities.data(), m_entities.size() * sizeof(Entity));
+		if constexpr (Serializer::IsTrivial)
+		{
+			Serializer::Write(writer, m_components.data(), m_components.size());
+		}
+		else if constexpr (Serializer::IsSupported)
+		{
+			for (const Component& component : m_components)
+			{
+				Serializer::Write(writer, component);
+			}
+		}
+	}
+
+	virtual void Deserialize(SnapshotReader& reader, uint32_t version, const Entity* pEntities, size_t count) override
+	{
+		size_t beginIndex = m_components.size();
+		for (size_t index = 0U; index < count; ++index)
+		{
+			CreateComponent(pEntities[index]);
+		}
+
+		if constexpr (Serializer::IsTrivial)
+		{
+			Serializer::Read(reader, &m_components[beginIndex], count);
+			Serializer::RemapEntities(reader, &m_components[beginIndex], count);
+		}
+		else if constexpr (Serializer::IsSupported)
+		{
+			for (size_t index = beginIndex; index < m_components.size(); ++index)
+			{
+				Serializer::Read(reader, m_components[index], version);
+			}
+		}
+	}
+
 	// Returns if ComponentStorage stores component for entity.
 	bool Contains(Entity entity) const { return m_entityToIndex.find(entity) != m_entityToIndex.end(); }
 
 	// Returns current active components count.
-	size_t GetCount() const { return m_entityToIndex.size(); }
+	virtual size_t GetCount() const override { return m_entityToIndex.size(); }
 
 	// Returns current components capcity.
 	size_t GetCapcity() const { assert(m_entities.size() == m_components.size()); return m_entities.size(); }
@@ -44,6 +176,13 @@ public:
 	// Need to check if it is still active.
 	const std::vector<Entity>& GetEntities() const { return m_entities; }
 
+	// Increases by one for every created or removed component and every MarkChanged call.
+	// Observers compare it with GetCount to tell pure creations from other changes.
+	uint64_t GetVersion() const { return m_version; }
+
+	// Components are modified in place so writers call it when observers should rebuild.
+	void MarkChanged() { ++m_version; }
+
 	// Get component by entity.
 	Component* GetComponent(Entity entity)
 	{
@@ -59,6 +198,7 @@ public:
 		m_entityToIndex[entity] = m_components.size();
 		m_entities.emplace_back(entity);
 		m_components.emplace_back();
+		++m_version;
 		return m_components.back();
 	}
 
@@ -83,12 +223,14 @@ public:
 		m_entities.pop_back();
 		m_components.pop_back();
 		m_entityToIndex.erase(entity);
+		++m_version;
 	}
 
 private:
 	std::vector<Entity> m_entities;
 	std::vector<Component> m_components;
 	std::unordered_map<Entity, size_t> m_entityToIndex;
+	uint64_t m_version = 0U;
 };
 
 }
\ No newline at end of file
@@ -3,6 +3,12 @@
 namespace engine
 {
 
+void ComponentSerializer<HierarchyComponent>::RemapEntities(SnapshotReader& reader, HierarchyComponent* pComponents, size_t count)
+{
+	for (size_t index = 0U; index < count; ++index)
+	{
+		pComponents[index].SetParentEntity(reader.RemapEntity(pComponents[index].GetParentEntity()));
+	}
+}
 
-
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/StringCrc.h"
+#include "ECWorld/ComponentSerializer.h"
 #include "ECWorld/Entity.h"
 
 namespace engine
@@ -30,4 +31,11 @@ private:
 	Entity m_parentEntity = INVALID_ENTITY;
 };
 
-}
\ No newline at end of file
+// Dense array is copied as it is and parent entities are remapped to the loading world afterwards.
+template<>
+struct ComponentSerializer<HierarchyComponent> : TrivialComponentSerializer<HierarchyComponent, 1U>
+{
+	static void RemapEntities(SnapshotReader& reader, HierarchyComponent* pComponents, size_t count);
+};
+
+}
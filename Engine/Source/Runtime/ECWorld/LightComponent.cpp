@@ -62,4 +62,54 @@ bool LightComponent::IsShadowMapTextureValid()
 	return bgfx::isValid(static_cast<bgfx::FrameBufferHandle>(m_shadowMapTexture));
 }
 
+void ComponentSerializer<LightComponent>::Write(SnapshotWriter& writer, const LightComponent& component)
+{
+	writer.WriteValue(component.m_lightUniformData);
+	writer.WriteValue(component.m_isCastShadow);
+	writer.WriteValue(component.m_isCastVolume);
+	writer.WriteValue(component.m_shadowMapSize);
+	writer.WriteValue(static_cast<uint8_t>(component.m_cascadePartitionMode));
+	writer.WriteValue(component.m_manualCascadeSplit);
+}
+
+void ComponentSerializer<LightComponent>::Read(SnapshotReader& reader, LightComponent& component, uint32_t)
+{
+	reader.ReadValue(component.m_lightUniformData);
+	reader.ReadValue(component.m_isCastShadow);
+	reader.ReadValue(component.m_isCastVolume);
+	reader.ReadValue(component.m_shadowMapSize);
+
+	uint8_t cascadePartitionMode;
+	reader.ReadValue(cascadePartitionMode);
+	component.m_cascadePartitionMode = static_cast<CascadePartitionMode>(cascadePartitionMode);
+	reader.ReadValue(component.m_manualCascadeSplit);
+
+	ComponentRuntimeResources<LightComponent>::Detach(component);
+}
+
+void ComponentRuntimeResources<LightComponent>::Release(LightComponent& component)
+{
+	if (component.IsShadowMapTextureValid())
+	{
+		component.ClearShadowMapTexture();
+	}
+
+	for (uint16_t shadowMapFB : component.m_shadowMapFBs)
+	{
+		if (bgfx::isValid(bgfx::FrameBufferHandle{ shadowMapFB }))
+		{
+			bgfx::destroy(bgfx::FrameBufferHandle{ shadowMapFB });
+		}
+	}
+
+	Detach(component);
+}
+
+void ComponentRuntimeResources<LightComponent>::Detach(LightComponent& component)
+{
+	component.m_shadowMapTexture = bgfx::kInvalidHandle;
+	component.m_lightViewProjMatrices.clear();
+	component.m_shadowMapFBs.clear();
+}
+
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/Types.h"
+#include "ECWorld/ComponentSerializer.h"
 #include "Rendering/LightUniforms.h"
 #include "Scene/LightType.h"
 
@@ -18,6 +19,10 @@ enum class CascadePartitionMode
 
 class LightComponent final
 {
+public:
+	friend struct ComponentSerializer<LightComponent>;
+	friend struct ComponentRuntimeResources<LightComponent>;
+
 public:
 	static constexpr StringCrc GetClassName()
 	{
@@ -154,7 +159,7 @@ private:
 	float m_computedCascadeSplit[4] = { 0.0 }; // computed split
 
 	// uniform
-	uint16_t m_shadowMapTexture;	// Texture Handle
+	uint16_t m_shadowMapTexture = UINT16_MAX;	// Texture Handle
 	std::vector<cd::Matrix4x4> m_lightViewProjMatrices;
 	std::vector<uint16_t> m_shadowMapFBs; // Framebuffer Handle
 
@@ -162,4 +167,25 @@ private:
 	// any non-U_Light member of LightComponent will destroy this layout. --2023/6/21
 };
 
-}
\ No newline at end of file
+// Shadow map handles are runtime resources so renderers create them again after loading.
+template<>
+struct ComponentSerializer<LightComponent>
+{
+	static constexpr bool IsSupported = true;
+	static constexpr bool IsTrivial = false;
+	static constexpr uint32_t Version = 1U;
+
+	static void Write(SnapshotWriter& writer, const LightComponent& component);
+	static void Read(SnapshotReader& reader, LightComponent& component, uint32_t version);
+};
+
+template<>
+struct ComponentRuntimeResources<LightComponent>
+{
+	static constexpr bool IsSupported = true;
+
+	static void Release(LightComponent& component);
+	static void Detach(LightComponent& component);
+};
+
+}
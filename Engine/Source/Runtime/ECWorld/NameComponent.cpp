@@ -11,4 +11,16 @@ void NameComponent::SetName(std::string name)
 	m_nameCrc = StringCrc(m_name);
 }
 
-}
\ No newline at end of file
+void ComponentSerializer<NameComponent>::Write(SnapshotWriter& writer, const NameComponent& component)
+{
+	writer.WriteString(component.GetName());
+}
+
+void ComponentSerializer<NameComponent>::Read(SnapshotReader& reader, NameComponent& component, uint32_t)
+{
+	std::string name;
+	reader.ReadString(name);
+	component.SetName(cd::MoveTemp(name));
+}
+
+}
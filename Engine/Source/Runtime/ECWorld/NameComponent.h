@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/StringCrc.h"
+#include "ECWorld/ComponentSerializer.h"
 
 #include <string>
 
@@ -40,4 +41,15 @@ private:
 	StringCrc m_nameCrc;
 };
 
-}
\ No newline at end of file
+template<>
+struct ComponentSerializer<NameComponent>
+{
+	static constexpr bool IsSupported = true;
+	static constexpr bool IsTrivial = false;
+	static constexpr uint32_t Version = 1U;
+
+	static void Write(SnapshotWriter& writer, const NameComponent& component);
+	static void Read(SnapshotReader& reader, NameComponent& component, uint32_t version);
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include "Log/Log.h"
 #include "Path/Path.h"
+#include "Profiling/Profiling.h"
 #include "U_BaseSlot.sh"
 #include "U_Terrain.sh"
 
@@ -20,6 +21,7 @@ SceneWorld::SceneWorld()
 	m_pSceneDatabase = std::make_unique<cd::SceneDatabase>();
 
 	m_pWorld = std::make_unique<engine::World>();
+	m_pSceneQuery = std::make_unique<engine::SceneQuery>();
 
 	// To add a new component : 2. Init component type here.
 	m_pAnimationComponentStorage = m_pWorld->Register<engine::AnimationComponent>();
@@ -287,9 +289,37 @@ void SceneWorld::InitDDGISDK()
 }
 #endif
 
-void SceneWorld::Update()
+void SceneWorld::Update(float deltaTime)
 {
+	CD_PROFILE_SCOPE("SceneWorld::Update");
+	if (SkyComponent* pSkyComponent = GetSkyComponent(GetSkyEntity()); pSkyComponent && pSkyComponent->GetTimeOfDayEnable())
+	{
+		pSkyComponent->UpdateTimeOfDay(deltaTime);
+	}
+
+	// Renderers read world matrices from RenderSnapshot so transforms edited on the main thread are built here.
+	for (Entity entity : GetTransformEntities())
+	{
+		GetTransformComponent(entity)->Build();
+	}
+
+	m_pSceneQuery->Update(this);
+}
+
+void SceneWorld::UpdateSceneDatabaseMemory()
+{
+	size_t size = 0U;
+	for (const cd::Mesh& mesh : m_pSceneDatabase->GetMeshes())
+	{
+		size += static_cast<size_t>(mesh.GetVertexCount()) * mesh.GetVertexFormat().GetStride();
+		size += static_cast<size_t>(mesh.GetPolygonCount()) * 3U * sizeof(uint32_t);
+	}
+	m_sceneDatabaseMemory.Set(size);
+}
+
 #ifdef ENABLE_DDGI
+void SceneWorld::UpdateDDGI()
+{
 	// Send request 30 times per second.
 	static auto startTime = std::chrono::steady_clock::now();
 	if (std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count() <= 33 * 1000 * 1000)
@@ -317,7 +347,7 @@ void SceneWorld::Update()
 		pDDGIComponent->SetDistanceRawData(curDecodeData->visDecodeData);
 		pDDGIComponent->SetIrradianceRawData(curDecodeData->irrDecodeData);
 	}
-#endif
 }
+#endif
 
 }
\ No newline at end of file
@@ -1,10 +1,12 @@
 #pragma once
 
+#include "Core/Memory/MemoryTracker.h"
 #include "ECWorld/AllComponentsHeader.h"
 #include "ECWorld/World.h"
 #include "Log/Log.h"
 #include "Material/MaterialType.h"
 #include "Math/Transform.hpp"
+#include "Physics/SceneQuery.h"
 #include "Scene/SceneDatabase.h"
 
 #include <memory>
@@ -22,6 +24,7 @@ private: \
 public: \
 	CD_FORCEINLINE const std::vector<engine::Entity>& Get##ComponentType##Entities() const { return m_p##ComponentType##ComponentStorage->GetEntities(); } \
 	CD_FORCEINLINE ComponentType##Component* Get##ComponentType##Component(engine::Entity entity) const { return m_p##ComponentType##ComponentStorage->GetComponent(entity); } \
+	CD_FORCEINLINE uint64_t Get##ComponentType##StorageVersion() const { return m_p##ComponentType##ComponentStorage->GetVersion(); } \
 	CD_FORCEINLINE void Delete##ComponentType##Component(engine::Entity entity) { m_p##ComponentType##ComponentStorage->RemoveComponent(entity); }
 
 class SceneWorld
@@ -56,6 +59,7 @@ public:
 	CD_FORCEINLINE cd::SceneDatabase* GetSceneDatabase() { return m_pSceneDatabase.get(); }
 	CD_FORCEINLINE engine::World* GetWorld() { return m_pWorld.get(); }
 	CD_FORCEINLINE const engine::World* GetWorld() const { return m_pWorld.get(); }
+	CD_FORCEINLINE engine::SceneQuery* GetSceneQuery() const { return m_pSceneQuery.get(); }
 
 	void SetSelectedEntity(engine::Entity entity);
 	CD_FORCEINLINE engine::Entity GetSelectedEntity() const { return m_selectedEntity; }
@@ -127,13 +131,22 @@ public:
 
 #ifdef ENABLE_DDGI
 	void InitDDGISDK();
+	// Writes DDGIComponent which is read by DDGIRenderer so call it on the thread which renders.
+	void UpdateDDGI();
 #endif
 
-	void Update();
+	// Runs on the simulation thread of FramePipeline. It builds transforms, updates SceneQuery and advances time of day,
+	// so other threads must read these states from RenderSnapshot and must not edit components meanwhile.
+	void Update(float deltaTime);
+
+	// SceneDatabase allocates inside AssetPipeline so its size is estimated from mesh data. Call it after the database changes.
+	void UpdateSceneDatabaseMemory();
 
 private:
 	std::unique_ptr<cd::SceneDatabase> m_pSceneDatabase;
+	TrackedMemorySize m_sceneDatabaseMemory{ MemoryTag::Scene };
 	std::unique_ptr<engine::World> m_pWorld;
+	std::unique_ptr<engine::SceneQuery> m_pSceneQuery;
 
 	std::unique_ptr<engine::MaterialType> m_pPBRMaterialType;
 	std::unique_ptr<engine::MaterialType> m_pAnimationMaterialType;
@@ -1,5 +1,7 @@
 #include "SkyComponent.h"
 
+#include <cmath>
+
 namespace engine
 {
 
@@ -23,6 +25,30 @@ void SkyComponent::SetSkyType(SkyType type)
 	} 
 }
 
+void SkyComponent::SetScatteringOrders(uint16_t orders)
+{
+	if (m_scatteringOrders == orders)
+	{
+		return;
+	}
+
+	m_scatteringOrders = orders;
+	RequestAtmospherePrecompute();
+}
+
+void SkyComponent::UpdateTimeOfDay(float deltaTime)
+{
+	m_timeOfDay = std::fmod(m_timeOfDay + m_timeOfDaySpeed * deltaTime, 24.0f);
+	if (m_timeOfDay < 0.0f)
+	{
+		m_timeOfDay += 24.0f;
+	}
+
+	// Sun rises at 6:00 from +X, reaches zenith at 12:00 and sets at 18:00 to -X.
+	float elevation = (m_timeOfDay - 6.0f) / 12.0f * cd::Math::PI;
+	m_sunDirection = cd::Direction(-std::cos(elevation), -std::sin(elevation), 0.0f);
+}
+
 void SkyComponent::SetSunDirection(cd::Direction dir)
 {
 	m_sunDirection = cd::MoveTemp(dir);
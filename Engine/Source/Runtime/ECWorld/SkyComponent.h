@@ -57,6 +57,29 @@ public:
 	float& GetShadowLength() { return m_shadowLength; }
 	const float& GetShadowLength() const { return m_shadowLength; }
 
+	// Scattering orders is baked into precomputed LUTs so that changing it triggers a new precompute.
+	void SetScatteringOrders(uint16_t orders);
+	uint16_t GetScatteringOrders() const { return m_scatteringOrders; }
+
+	// Renderer compares the version with its LUTs to start an incremental precompute.
+	void RequestAtmospherePrecompute() { ++m_atmosphereVersion; }
+	uint32_t GetAtmosphereVersion() const { return m_atmosphereVersion; }
+
+	// Time of day only drives sun direction which is evaluated per frame without touching LUTs.
+	void SetTimeOfDayEnable(bool enable) { m_isTimeOfDayEnable = enable; }
+	bool& GetTimeOfDayEnable() { return m_isTimeOfDayEnable; }
+	bool GetTimeOfDayEnable() const { return m_isTimeOfDayEnable; }
+
+	void SetTimeOfDay(float hours) { m_timeOfDay = hours; }
+	float& GetTimeOfDay() { return m_timeOfDay; }
+	float GetTimeOfDay() const { return m_timeOfDay; }
+
+	void SetTimeOfDaySpeed(float hoursPerSecond) { m_timeOfDaySpeed = hoursPerSecond; }
+	float& GetTimeOfDaySpeed() { return m_timeOfDaySpeed; }
+	float GetTimeOfDaySpeed() const { return m_timeOfDaySpeed; }
+
+	void UpdateTimeOfDay(float deltaTime);
+
 	void SetSunDirection(cd::Direction dir);
 	cd::Direction& GetSunDirection() { return m_sunDirection; }
 	const cd::Direction& GetSunDirection() const { return m_sunDirection; }
@@ -86,6 +109,13 @@ private:
 	float m_shadowLength = 0.1f;
 	cd::Direction m_sunDirection = cd::Direction(0.0f, -1.0f, 0.0f);
 
+	uint16_t m_scatteringOrders = 6U;
+	uint32_t m_atmosphereVersion = 0U;
+
+	bool m_isTimeOfDayEnable = false;
+	float m_timeOfDay = 12.0f;
+	float m_timeOfDaySpeed = 0.1f;
+
 	std::string m_irradianceTexturePath = DefaultIrradainceTexturePath;
 	std::string m_radianceTexturePath = DefaultRadianceTexturePath;
 	std::string m_pureGrayTexturePath = DefaultPureGrayTexturePath;
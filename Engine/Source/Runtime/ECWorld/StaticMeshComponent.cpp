@@ -2,12 +2,24 @@
 
 #include "Rendering/Resources/MeshResource.h"
 
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+// Screen height ratio below which the next coarser level is used.
+constexpr float LodScreenSizes[engine::MaxMeshLodCount - 1U] = { 0.5f, 0.25f, 0.125f };
+constexpr float LodHysteresis = 0.1f;
+
+}
+
 namespace engine
 {
 
 uint32_t StaticMeshComponent::GetStartVertex() const
 {
-	return 0U;
+	return m_pMeshResource->GetStartVertex();
 }
 
 uint32_t StaticMeshComponent::GetVertexCount() const
@@ -15,9 +27,9 @@ uint32_t StaticMeshComponent::GetVertexCount() const
 	return m_currentVertexCount;
 }
 
-uint32_t StaticMeshComponent::GetStartIndex() const
+uint32_t StaticMeshComponent::GetStartIndex(uint32_t polygonGroupIndex) const
 {
-	return 0U;
+	return m_pMeshResource->GetStartIndex(polygonGroupIndex) + m_pMeshResource->GetLod(polygonGroupIndex, m_currentLod).startIndex;
 }
 
 uint32_t StaticMeshComponent::GetPolygonCount() const
@@ -25,9 +37,43 @@ uint32_t StaticMeshComponent::GetPolygonCount() const
 	return m_currentPolygonCount;
 }
 
-uint32_t StaticMeshComponent::GetIndexCount() const
+uint32_t StaticMeshComponent::GetIndexCount(uint32_t polygonGroupIndex) const
 {
-	return UINT32_MAX;
+	return m_pMeshResource->GetLod(polygonGroupIndex, m_currentLod).indexCount;
+}
+
+void StaticMeshComponent::UpdateLod(const cd::AABB& worldAABB, const cd::Vec3f& cameraPosition, float fovDegrees)
+{
+	float radius = (worldAABB.Max() - worldAABB.Center()).Length();
+	float distance = (worldAABB.Center() - cameraPosition).Length();
+	float screenSize = 1.0f;
+	if (distance > radius)
+	{
+		screenSize = radius / (distance * std::tan(cd::Math::DegreeToRadian(fovDegrees) * 0.5f));
+	}
+	m_screenSize = screenSize;
+
+	uint32_t lodCount = 1U;
+	for (uint32_t polygonGroupIndex = 0U; polygonGroupIndex < m_pMeshResource->GetPolygonGroupCount(); ++polygonGroupIndex)
+	{
+		lodCount = std::max(lodCount, m_pMeshResource->GetLodCount(polygonGroupIndex));
+	}
+
+	if (lodCount <= 1U)
+	{
+		m_currentLod = 0U;
+		return;
+	}
+
+	m_currentLod = std::min(m_currentLod, lodCount - 1U);
+	while (m_currentLod > 0U && screenSize > LodScreenSizes[m_currentLod - 1U] * (1.0f + LodHysteresis))
+	{
+		--m_currentLod;
+	}
+	while (m_currentLod + 1U < lodCount && screenSize < LodScreenSizes[m_currentLod] * (1.0f - LodHysteresis))
+	{
+		++m_currentLod;
+	}
 }
 
 void StaticMeshComponent::SetMeshResource(const MeshResource* pMeshResource)
@@ -35,6 +81,7 @@ void StaticMeshComponent::SetMeshResource(const MeshResource* pMeshResource)
 	m_pMeshResource = pMeshResource;
 	m_currentVertexCount = m_pMeshResource->GetVertexCount();
 	m_currentPolygonCount = m_pMeshResource->GetPolygonCount();
+	m_currentLod = 0U;
 }
 
 }
\ No newline at end of file
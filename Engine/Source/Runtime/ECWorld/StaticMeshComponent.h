@@ -2,6 +2,7 @@
 
 #include "Core/StringCrc.h"
 #include "ECWorld/Entity.h"
+#include "Math/Box.hpp"
 #include "Scene/Mesh.h"
 
 #include <cstdint>
@@ -34,14 +35,23 @@ public:
 
 	uint32_t GetStartVertex() const;
 	uint32_t GetVertexCount() const;
-	uint32_t GetStartIndex() const;
+	uint32_t GetStartIndex(uint32_t polygonGroupIndex) const;
 	uint32_t GetPolygonCount() const;
-	uint32_t GetIndexCount() const;
+	uint32_t GetIndexCount(uint32_t polygonGroupIndex) const;
+
+	// Selects detail level by projected size of the world bounding sphere in screen height.
+	// Thresholds use hysteresis so that a mesh near a threshold doesn't switch level every frame.
+	void UpdateLod(const cd::AABB& worldAABB, const cd::Vec3f& cameraPosition, float fovDegrees);
+	uint32_t GetLod() const { return m_currentLod; }
+	// Projected diameter of the world bounding sphere relative to screen height, updated by UpdateLod.
+	float GetScreenSize() const { return m_screenSize; }
 
 private:
 	const MeshResource* m_pMeshResource = nullptr;
 	uint32_t m_currentVertexCount = UINT32_MAX;
 	uint32_t m_currentPolygonCount = UINT32_MAX;
+	uint32_t m_currentLod = 0U;
+	float m_screenSize = 1.0f;
 };
 
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "TerrainComponent.h"
 
+#include <algorithm>
+
 namespace engine
 {
 
@@ -7,75 +9,140 @@ void TerrainComponent::InitElevationRawData()
 {
     std::optional<std::vector<std::byte>> optMap = GenerateElevationMap(m_texWidth, m_texDepth, m_roughness, m_minHeight, m_maxHeight);//std::vector<std::byte>129U
     assert(optMap.has_value());
-    SetElevationRawData(optMap.value());
+    SetElevationRawData(cd::MoveTemp(optMap.value()));
 }
 
-void TerrainComponent::SetElevationRawDataAt(uint16_t x, uint16_t z, float data)
+void TerrainComponent::SetElevationRawData(std::vector<std::byte> data)
+{
+	m_elevationRawData = cd::MoveTemp(data);
+	assert(m_elevationRawData.size() == m_texWidth * m_texDepth * sizeof(float));
+
+	// Pyramid needs a square power of two quads heightmap which is the case of diamond-square output.
+	assert(m_texWidth == m_texDepth);
+	m_heightPyramid.Build(GetElevationData(), m_texWidth, 1U);
+	MarkDirty(0U, 0U, m_texWidth - 1U, m_texDepth - 1U);
+}
+
+void TerrainComponent::MarkDirty(uint16_t minX, uint16_t minZ, uint16_t maxX, uint16_t maxZ)
 {
-	std::byte* bytePtr = reinterpret_cast<std::byte*>(&data);
-	for (uint16_t i = 0U; i < sizeof(float); ++i)
+	if (m_dirtyRect.has_value())
 	{
-		m_elevationRawData[(z * m_texWidth + x) * sizeof(float) + i] = bytePtr[i];
+		uint16_t oldMaxX = m_dirtyRect->x + m_dirtyRect->width - 1U;
+		uint16_t oldMaxZ = m_dirtyRect->z + m_dirtyRect->depth - 1U;
+		minX = std::min(minX, m_dirtyRect->x);
+		minZ = std::min(minZ, m_dirtyRect->z);
+		maxX = std::max(maxX, oldMaxX);
+		maxZ = std::max(maxZ, oldMaxZ);
 	}
+
+	m_dirtyRect = DirtyRect{ minX, minZ, static_cast<uint16_t>(maxX - minX + 1U), static_cast<uint16_t>(maxZ - minZ + 1U) };
+}
+
+void TerrainComponent::SetElevationRawDataAt(uint16_t x, uint16_t z, float data)
+{
+	memcpy(&m_elevationRawData[(z * m_texWidth + x) * sizeof(float)], &data, sizeof(data));
 }
 
-float TerrainComponent::GetElevationRawDataAt(uint16_t x, uint16_t z)
+float TerrainComponent::GetElevationRawDataAt(uint16_t x, uint16_t z) const
 {
 	float data;
 	memcpy(&data, &m_elevationRawData[(z * m_texWidth + x) * sizeof(float)], sizeof(data));
 	return data;
 }
 
+void TerrainComponent::ReadElevationRect(const DirtyRect& rect, float* pOutData) const
+{
+	const float* pElevation = GetElevationData();
+	for (uint16_t rowZ = rect.z; rowZ < rect.z + rect.depth; ++rowZ)
+	{
+		memcpy(pOutData, pElevation + rowZ * m_texWidth + rect.x, rect.width * sizeof(float));
+		pOutData += rect.width;
+	}
+}
+
+void TerrainComponent::WriteElevationRect(const DirtyRect& rect, const float* pData)
+{
+	float* pElevation = reinterpret_cast<float*>(m_elevationRawData.data());
+	for (uint16_t rowZ = rect.z; rowZ < rect.z + rect.depth; ++rowZ)
+	{
+		memcpy(pElevation + rowZ * m_texWidth + rect.x, pData, rect.width * sizeof(float));
+		pData += rect.width;
+	}
+
+	const uint16_t maxX = rect.x + rect.width - 1U;
+	const uint16_t maxZ = rect.z + rect.depth - 1U;
+	MarkDirty(rect.x, rect.z, maxX, maxZ);
+	m_heightPyramid.Refresh(pElevation, rect.x, rect.z, maxX, maxZ);
+}
+
+std::optional<TerrainComponent::DirtyRect> TerrainComponent::GetBrushRect(uint16_t x, uint16_t z, int16_t brushSize) const
+{
+	// Clamp brush area to the heightmap once instead of testing every sample.
+	const uint16_t minX = static_cast<uint16_t>(std::max(x - brushSize, 0));
+	const uint16_t minZ = static_cast<uint16_t>(std::max(z - brushSize, 0));
+	const uint16_t maxX = static_cast<uint16_t>(std::min(x + brushSize, static_cast<int>(m_texWidth)));
+	const uint16_t maxZ = static_cast<uint16_t>(std::min(z + brushSize, static_cast<int>(m_texDepth)));
+	if (m_elevationRawData.empty() || minX >= maxX || minZ >= maxZ)
+	{
+		return std::nullopt;
+	}
+
+	return DirtyRect{ minX, minZ, static_cast<uint16_t>(maxX - minX), static_cast<uint16_t>(maxZ - minZ) };
+}
+
 void TerrainComponent::SmoothElevationRawDataAround(uint16_t x, uint16_t z, int16_t brushSize, float power)
 {
-	float sum = 0;
-	uint32_t count = 0;
-    int16_t area_z, area_x, brush_x, brush_z;
+	std::optional<DirtyRect> optBrushRect = GetBrushRect(x, z, brushSize);
+	if (!optBrushRect.has_value())
+	{
+		return;
+	}
 
-	for (area_z = -brushSize; area_z < brushSize; ++area_z)
+	const uint16_t minX = optBrushRect->x;
+	const uint16_t minZ = optBrushRect->z;
+	const uint16_t maxX = minX + optBrushRect->width;
+	const uint16_t maxZ = minZ + optBrushRect->depth;
+
+	float* pElevation = reinterpret_cast<float*>(m_elevationRawData.data());
+	float sum = 0.0f;
+	for (uint16_t brushZ = minZ; brushZ < maxZ; ++brushZ)
 	{
-		for (area_x = -brushSize; area_x < brushSize; ++area_x)
+		const float* pRow = pElevation + brushZ * m_texWidth;
+		for (uint16_t brushX = minX; brushX < maxX; ++brushX)
 		{
-			brush_x = x + area_x;
-			if (brush_x < 0 || static_cast<uint16_t>(brush_x) >= m_texWidth)
-			{
-				continue;
-			}
-			brush_z = z + area_z;
-			if (brush_z < 0 || static_cast<uint16_t>(brush_z) >= m_texDepth)
-			{
-				continue;
-			}
-			sum += GetElevationRawDataAt(brush_x, brush_z);
-			count++;
+			sum += pRow[brushX];
 		}
 	}
 
-	float average = sum / count;
-	for (area_z = -brushSize; area_z < brushSize; ++area_z)
+	float average = sum / static_cast<float>((maxX - minX) * (maxZ - minZ));
+	for (uint16_t brushZ = minZ; brushZ < maxZ; ++brushZ)
 	{
-		for (area_x = -brushSize; area_x < brushSize; ++area_x)
+		float* pRow = pElevation + brushZ * m_texWidth;
+		for (uint16_t brushX = minX; brushX < maxX; ++brushX)
 		{
-			brush_x = x + area_x;
-			if (brush_x < 0 || static_cast<uint16_t>(brush_x) >= m_texWidth)
-			{
-				continue;
-			}
-			brush_z = z + area_z;
-			if (brush_z < 0 || static_cast<uint16_t>(brush_z) >= m_texDepth)
-			{
-				continue;
-			}
 			/*float a2 = (float)(area_x * area_x);
 			float b2 = (float)(area_z * area_z);
 			float brushAttn = (1.0f - bx::sqrt(a2 + b2) / brushSize) * (1 - power);*/
-			float data = bx::lerp(GetElevationRawDataAt(brush_x, brush_z), average, 0.03f);//power + brushAttn);
-			SetElevationRawDataAt(brush_x, brush_z, data);
+			pRow[brushX] = bx::lerp(pRow[brushX], average, 0.03f);//power + brushAttn);
 		}
 	}
+
+	MarkDirty(minX, minZ, maxX - 1U, maxZ - 1U);
+	m_heightPyramid.Refresh(pElevation, minX, minZ, maxX - 1U, maxZ - 1U);
 }
 
-void TerrainComponent::ScreenSpaceSmooth(float screenSpaceX, float screenSpaceY, cd::Matrix4x4 invProjMtx, cd::Matrix4x4 invViewMtx, cd::Vec3f camPos)
+bool TerrainComponent::Raycast(const cd::Vec3f& origin, const cd::Vec3f& direction, float maxDistance, float& outDistance) const
+{
+	if (m_elevationRawData.empty())
+	{
+		return false;
+	}
+
+	return m_heightPyramid.Raycast(GetElevationData(), origin, direction, maxDistance, outDistance);
+}
+
+bool TerrainComponent::ScreenSpacePick(float screenSpaceX, float screenSpaceY, const cd::Matrix4x4& invProjMtx, const cd::Matrix4x4& invViewMtx, const cd::Vec3f& camPos,
+    uint16_t& outX, uint16_t& outZ) const
 {
     cd::Vec4f ray_clip;
     ray_clip[0] = screenSpaceX;
@@ -92,23 +159,28 @@ void TerrainComponent::ScreenSpaceSmooth(float screenSpaceX, float screenSpaceY,
     cd::Vec4f ray_world = invViewMtx * ray_eye;
     cd::Vec3f rayDir = ray_world.xyz().Normalize();
 
-    for (int i = 0; i < 1000; ++i)
+    // Same reach as the previous fixed step ray march.
+    constexpr float maxPickDistance = 1000.0f;
+    float hitDistance;
+    if (!Raycast(camPos, rayDir, maxPickDistance, hitDistance))
     {
-        camPos = camPos + rayDir;
-        uint32_t posX = static_cast<uint32_t>(camPos.x());
-        uint32_t posZ = static_cast<uint32_t>(camPos.z());
-        if (posX < 0U || posX >= 129U || posZ < 0U || posZ >= 129U)
-        {
-            continue;
-        }
-
-        float terrainY = GetElevationRawDataAt(posX, posZ);
-        if (camPos.y() < (terrainY))
-        {
-            SmoothElevationRawDataAround(posX, posZ, 10, 0.5f);
-            break;
-        }
+        return false;
     }
+
+    cd::Vec3f hitPosition = camPos + rayDir * hitDistance;
+    outX = static_cast<uint16_t>(std::clamp(hitPosition.x() + 0.5f, 0.0f, static_cast<float>(m_texWidth - 1U)));
+    outZ = static_cast<uint16_t>(std::clamp(hitPosition.z() + 0.5f, 0.0f, static_cast<float>(m_texDepth - 1U)));
+    return true;
 }
 
-}
\ No newline at end of file
+void TerrainComponent::ScreenSpaceSmooth(float screenSpaceX, float screenSpaceY, cd::Matrix4x4 invProjMtx, cd::Matrix4x4 invViewMtx, cd::Vec3f camPos)
+{
+    uint16_t posX;
+    uint16_t posZ;
+    if (ScreenSpacePick(screenSpaceX, screenSpaceY, invProjMtx, invViewMtx, camPos, posX, posZ))
+    {
+        SmoothElevationRawDataAround(posX, posZ, SmoothBrushSize, SmoothBrushPower);
+    }
+}
+
+}
@@ -4,11 +4,13 @@
 #include "ECWorld/Entity.h"
 #include "Math/Box.hpp"
 #include "Scene/Mesh.h"
+#include "Terrain/TerrainQuadTree.h"
 #include "Terrain/TerrainUtils.h"
 
 #include <cstdint>
 #include <vector>
 #include <optional>
+#include <string>
 #include <bgfx/bgfx.h>
 #include <bx/math.h>
 
@@ -26,6 +28,20 @@ public:
 		return className;
 	}
 
+public:
+	// Sample rect [x, x + width) * [z, z + depth) modified since last upload.
+	struct DirtyRect
+	{
+		uint16_t x;
+		uint16_t z;
+		uint16_t width;
+		uint16_t depth;
+	};
+
+	// Brush which ScreenSpaceSmooth applies.
+	static constexpr int16_t SmoothBrushSize = 10;
+	static constexpr float SmoothBrushPower = 0.5f;
+
 public:
 	TerrainComponent() = default;
 	TerrainComponent(const TerrainComponent&) = default;
@@ -45,17 +61,66 @@ public:
 	uint16_t GetTexDepth() const { return m_texDepth; }
 	
 	void InitElevationRawData();
-	void SetElevationRawData(std::vector<std::byte> data) { m_elevationRawData = data; }
+	void SetElevationRawData(std::vector<std::byte> data);
 	const std::byte* GetElevationRawData() const { return m_elevationRawData.data(); }
 	uint32_t GetElevationRawDataSize() const {return static_cast<uint32_t>(m_elevationRawData.size()); }
+	const float* GetElevationData() const { return reinterpret_cast<const float*>(m_elevationRawData.data()); }
+
+	// Edits accumulate into one dirty rect so that renderer only uploads the modified region.
+	void MarkDirty(uint16_t minX, uint16_t minZ, uint16_t maxX, uint16_t maxZ);
+	const std::optional<DirtyRect>& GetDirtyRect() const { return m_dirtyRect; }
+	void ClearDirtyRect() { m_dirtyRect.reset(); }
+
+	// Min/max height pyramid of the elevation data for hierarchical picking.
+	const TerrainQuadTree& GetHeightPyramid() const { return m_heightPyramid; }
+	bool Raycast(const cd::Vec3f& origin, const cd::Vec3f& direction, float maxDistance, float& outDistance) const;
 
 	void SetElevationRawDataAt(uint16_t x, uint16_t z, float data);
-	float GetElevationRawDataAt(uint16_t x, uint16_t z);
+	float GetElevationRawDataAt(uint16_t x, uint16_t z) const;
+
+	// Copies samples of rect row by row. Writing refreshes height pyramid and marks the rect dirty.
+	void ReadElevationRect(const DirtyRect& rect, float* pOutData) const;
+	void WriteElevationRect(const DirtyRect& rect, const float* pData);
 
+	// Samples which SmoothElevationRawDataAround modifies for the brush.
+	std::optional<DirtyRect> GetBrushRect(uint16_t x, uint16_t z, int16_t brushSize) const;
 	void SmoothElevationRawDataAround(uint16_t x, uint16_t z, int16_t brushSize, float power);
-	
+
+	// Returns the heightmap sample under screen position if the view ray hits terrain.
+	bool ScreenSpacePick(float screenSpaceX, float screenSpaceY, const cd::Matrix4x4& invProjMtx, const cd::Matrix4x4& invViewMtx, const cd::Vec3f& camPos,
+		uint16_t& outX, uint16_t& outZ) const;
 	void ScreenSpaceSmooth(float screenSpaceX, float screenSpaceY, cd::Matrix4x4 invProjMtx, cd::Matrix4x4 invViewMtx, cd::Vec3f camPos);
 
+	// Chunked terrain streams heightmap tiles from disk and renders them with CDLOD.
+	void SetChunked(bool chunked) { m_isChunked = chunked; }
+	bool IsChunked() const { return m_isChunked; }
+
+	void SetTileDirectory(std::string directory) { m_tileDirectory = cd::MoveTemp(directory); }
+	const std::string& GetTileDirectory() const { return m_tileDirectory; }
+
+	void SetTileSize(uint16_t tileSize) { m_tileSize = tileSize; }
+	uint16_t GetTileSize() const { return m_tileSize; }
+
+	void SetTileCount(uint16_t tileCountX, uint16_t tileCountZ) { m_tileCountX = tileCountX; m_tileCountZ = tileCountZ; }
+	uint16_t GetTileCountX() const { return m_tileCountX; }
+	uint16_t GetTileCountZ() const { return m_tileCountZ; }
+
+	void SetChunkSize(uint16_t chunkSize) { m_chunkSize = chunkSize; }
+	uint16_t GetChunkSize() const { return m_chunkSize; }
+
+	void SetLODDistance(float distance) { m_lodDistance = distance; }
+	float GetLODDistance() const { return m_lodDistance; }
+	float& GetLODDistance() { return m_lodDistance; }
+
+	// The coarsest level extends to the view distance so that terrain doesn't end at the last LOD range.
+	// Zero means the far plane of main camera.
+	void SetViewDistance(float distance) { m_viewDistance = distance; }
+	float GetViewDistance() const { return m_viewDistance; }
+	float& GetViewDistance() { return m_viewDistance; }
+
+	void SetMaxResidentTileCount(uint32_t count) { m_maxResidentTileCount = count; }
+	uint32_t GetMaxResidentTileCount() const { return m_maxResidentTileCount; }
+
 private:
 	// mesh
 	uint16_t m_meshWidth = 129U; // uint32_t is too big for width
@@ -73,6 +138,19 @@ private:
 
 	// height map output
 	std::vector<std::byte> m_elevationRawData;
+	std::optional<DirtyRect> m_dirtyRect;
+	TerrainQuadTree m_heightPyramid;
+
+	// chunked terrain
+	bool m_isChunked = false;
+	std::string m_tileDirectory;
+	uint16_t m_tileSize = 256U;
+	uint16_t m_tileCountX = 1U;
+	uint16_t m_tileCountZ = 1U;
+	uint16_t m_chunkSize = 32U;
+	float m_lodDistance = 32.0f;
+	float m_viewDistance = 0.0f;
+	uint32_t m_maxResidentTileCount = 64U;
 };
 
 }
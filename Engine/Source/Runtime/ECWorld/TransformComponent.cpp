@@ -8,6 +8,7 @@ void TransformComponent::Reset()
 	m_transform.Clear();
 	m_localToWorldMatrix.Clear();
 	m_isMatrixDirty = true;
+	++m_version;
 }
 
 void TransformComponent::Build()
@@ -16,10 +17,24 @@ void TransformComponent::Build()
 	{
 		m_localToWorldMatrix = m_transform.GetMatrix();
 		m_isMatrixDirty = false;
+		++m_version;
 	}
 }
 #ifdef EDITOR_MODE
 bool TransformComponent::m_doUseUniformScale = true;
 #endif
 
-}
\ No newline at end of file
+void ComponentSerializer<TransformComponent>::Write(SnapshotWriter& writer, const TransformComponent& component)
+{
+	writer.WriteValue(component.GetTransform());
+}
+
+void ComponentSerializer<TransformComponent>::Read(SnapshotReader& reader, TransformComponent& component, uint32_t)
+{
+	cd::Transform transform;
+	reader.ReadValue(transform);
+	component.SetTransform(cd::MoveTemp(transform));
+	component.Build();
+}
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/StringCrc.h"
+#include "ECWorld/ComponentSerializer.h"
 #include "Math/Transform.hpp"
 
 namespace engine
@@ -31,6 +32,9 @@ public:
 
 	void Dirty() const { m_isMatrixDirty = true; }
 
+	// Increased every time the world matrix is rebuilt so that caches can detect changes cheaply.
+	uint32_t GetVersion() const { return m_version; }
+
 	void Reset();
 	void Build();
 
@@ -49,6 +53,7 @@ private:
 
 	// Status
 	mutable bool m_isMatrixDirty;
+	uint32_t m_version = 0U;
 
 	// Output
 	cd::Matrix4x4 m_localToWorldMatrix;
@@ -59,4 +64,16 @@ private:
 #endif
 };
 
+// Only the local transform is stored. World matrix is built again after loading.
+template<>
+struct ComponentSerializer<TransformComponent>
+{
+	static constexpr bool IsSupported = true;
+	static constexpr bool IsTrivial = false;
+	static constexpr uint32_t Version = 1U;
+
+	static void Write(SnapshotWriter& writer, const TransformComponent& component);
+	static void Read(SnapshotReader& reader, TransformComponent& component, uint32_t version);
+};
+
 }
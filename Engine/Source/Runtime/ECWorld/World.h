@@ -7,6 +7,7 @@
 #include <atomic>
 #include <cassert>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace engine
@@ -58,6 +59,15 @@ public:
 		return pStorage->CreateComponent(entity);
 	}
 
+	// Type erased access for snapshots. Key is the class name crc of component.
+	const std::unordered_map<size_t, std::unique_ptr<IComponentsStorage>>& GetAllComponents() const { return m_componentsLib; }
+
+	IComponentsStorage* GetComponents(size_t componentNameCrc)
+	{
+		auto itStorage = m_componentsLib.find(componentNameCrc);
+		return itStorage == m_componentsLib.end() ? nullptr : itStorage->second.get();
+	}
+
 private:
 	std::unordered_map<size_t, std::unique_ptr<IComponentsStorage>> m_componentsLib;
 };
@@ -0,0 +1,286 @@
+#include "WorldSnapshot.h"
+
+#include "ECWorld/ComponentSerializer.h"
+#include "ECWorld/SceneWorld.h"
+#include "ECWorld/World.h"
+#include "Log/Log.h"
+
+#include <algorithm>
+
+namespace
+{
+
+constexpr uint32_t SnapshotMagic = 0x53574443U; // "CDWS"
+constexpr uint32_t SnapshotVersion = 1U;
+
+}
+
+namespace engine
+{
+
+WorldSnapshot::~WorldSnapshot() = default;
+
+void WorldSnapshot::Capture(const SceneWorld& sceneWorld)
+{
+	for (const auto& [componentNameCrc, pStorage] : sceneWorld.GetWorld()->GetAllComponents())
+	{
+		auto itStorage = m_storages.find(componentNameCrc);
+		if (itStorage != m_storages.end())
+		{
+			itStorage->second->CopyFrom(*pStorage);
+		}
+		else
+		{
+			itStorage = m_storages.emplace(componentNameCrc, pStorage->Clone()).first;
+		}
+		itStorage->second->DetachRuntimeResources();
+	}
+
+	m_selectedEntity = sceneWorld.GetSelectedEntity();
+	m_mainCameraEntity = sceneWorld.GetMainCameraEntity();
+	m_skyEntity = sceneWorld.GetSkyEntity();
+#ifdef ENABLE_DDGI
+	m_ddgiEntity = sceneWorld.GetDDGIEntity();
+#endif
+}
+
+void WorldSnapshot::Restore(SceneWorld& sceneWorld) const
+{
+	for (const auto& [componentNameCrc, pTargetStorage] : sceneWorld.GetWorld()->GetAllComponents())
+	{
+		// Captured copies don't share runtime resources so live ones are always released.
+		pTargetStorage->ReleaseRuntimeResources();
+
+		auto itStorage = m_storages.find(componentNameCrc);
+		if (itStorage != m_storages.end())
+		{
+			pTargetStorage->CopyFrom(*itStorage->second);
+		}
+		else
+		{
+			pTargetStorage->Clear();
+		}
+	}
+
+	sceneWorld.SetSelectedEntity(m_selectedEntity);
+	sceneWorld.SetMainCameraEntity(m_mainCameraEntity);
+	sceneWorld.SetSkyEntity(m_skyEntity);
+#ifdef ENABLE_DDGI
+	sceneWorld.SetDDGIEntity(m_ddgiEntity);
+#endif
+}
+
+bool WorldSnapshotWriter::Write(const SceneWorld& sceneWorld, const char* pFilePath)
+{
+	std::ofstream fout(pFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!fout.is_open())
+	{
+		CD_ENGINE_ERROR("Failed to write world snapshot to {0}", pFilePath);
+		return false;
+	}
+
+	// Sort sections so that the same world always produces the same file.
+	std::vector<std::pair<size_t, const IComponentsStorage*>> storages;
+	for (const auto& [componentNameCrc, pStorage] : sceneWorld.GetWorld()->GetAllComponents())
+	{
+		if (pStorage->IsSerializable())
+		{
+			storages.emplace_back(componentNameCrc, pStorage.get());
+		}
+	}
+	std::sort(storages.begin(), storages.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+	SnapshotWriter writer(fout);
+	writer.WriteValue(SnapshotMagic);
+	writer.WriteValue(SnapshotVersion);
+	writer.WriteValue(static_cast<uint32_t>(storages.size()));
+	writer.WriteValue(sceneWorld.GetMainCameraEntity());
+	writer.WriteValue(sceneWorld.GetSkyEntity());
+
+	size_t componentCount = 0U;
+	for (const auto& [componentNameCrc, pStorage] : storages)
+	{
+		writer.WriteValue(static_cast<uint64_t>(componentNameCrc));
+		writer.WriteValue(pStorage->GetSerializerVersion());
+		writer.WriteValue(pStorage->GetComponentSize());
+		writer.WriteValue(static_cast<uint64_t>(pStorage->GetCount()));
+
+		// Patch data size after writing components.
+		std::streampos dataSizePosition = fout.tellp();
+		writer.WriteValue(static_cast<uint64_t>(0U));
+		std::streampos dataBeginPosition = fout.tellp();
+		pStorage->Serialize(writer);
+		std::streampos dataEndPosition = fout.tellp();
+
+		fout.seekp(dataSizePosition);
+		writer.WriteValue(static_cast<uint64_t>(dataEndPosition - dataBeginPosition));
+		fout.seekp(dataEndPosition);
+
+		componentCount += pStorage->GetCount();
+	}
+
+	if (!writer.IsOk())
+	{
+		CD_ENGINE_ERROR("Failed to write world snapshot to {0}", pFilePath);
+		return false;
+	}
+
+	CD_ENGINE_INFO("Write {0} components in {1} storages to {2}", componentCount, storages.size(), pFilePath);
+	return true;
+}
+
+WorldSnapshotLoader::WorldSnapshotLoader(SceneWorld* pSceneWorld) :
+	m_pSceneWorld(pSceneWorld)
+{
+}
+
+WorldSnapshotLoader::~WorldSnapshotLoader() = default;
+
+bool WorldSnapshotLoader::Open(const char* pFilePath)
+{
+	m_fin.open(pFilePath, std::ios::in | std::ios::binary);
+	if (!m_fin.is_open())
+	{
+		Fail("file can't be opened");
+		return false;
+	}
+
+	m_pReader = std::make_unique<SnapshotReader>(m_fin, m_pSceneWorld->GetWorld());
+
+	uint32_t magic = 0U;
+	uint32_t version = 0U;
+	m_pReader->ReadValue(magic);
+	m_pReader->ReadValue(version);
+	m_pReader->ReadValue(m_sectionCount);
+	m_pReader->ReadValue(m_mainCameraEntity);
+	m_pReader->ReadValue(m_skyEntity);
+	if (!m_pReader->IsOk() || magic != SnapshotMagic)
+	{
+		Fail("file is not a world snapshot");
+		return false;
+	}
+
+	if (version != SnapshotVersion)
+	{
+		Fail("snapshot version is not supported");
+		return false;
+	}
+
+	return true;
+}
+
+bool WorldSnapshotLoader::Update(size_t componentBudget)
+{
+	while (!m_isFinished && !m_isFailed && componentBudget > 0U)
+	{
+		if (!m_pStorage)
+		{
+			if (m_loadedSectionCount == m_sectionCount)
+			{
+				Finish();
+				break;
+			}
+
+			if (!BeginSection())
+			{
+				break;
+			}
+			continue;
+		}
+
+		size_t count = std::min(componentBudget, m_sectionEntities.size() - m_sectionLoadedCount);
+		m_pStorage->Deserialize(*m_pReader, m_sectionVersion, &m_sectionEntities[m_sectionLoadedCount], count);
+		if (!m_pReader->IsOk())
+		{
+			Fail("component data is truncated");
+			break;
+		}
+
+		m_sectionLoadedCount += count;
+		componentBudget -= count;
+		if (m_sectionLoadedCount == m_sectionEntities.size())
+		{
+			m_pStorage = nullptr;
+			++m_loadedSectionCount;
+		}
+	}
+
+	return m_isFinished || m_isFailed;
+}
+
+bool WorldSnapshotLoader::BeginSection()
+{
+	uint64_t componentNameCrc = 0U;
+	uint32_t componentSize = 0U;
+	uint64_t count = 0U;
+	uint64_t dataSize = 0U;
+	m_pReader->ReadValue(componentNameCrc);
+	m_pReader->ReadValue(m_sectionVersion);
+	m_pReader->ReadValue(componentSize);
+	m_pReader->ReadValue(count);
+	m_pReader->ReadValue(dataSize);
+	if (!m_pReader->IsOk() || count * sizeof(Entity) > dataSize)
+	{
+		Fail("section header is corrupted");
+		return false;
+	}
+
+	IComponentsStorage* pStorage = m_pSceneWorld->GetWorld()->GetComponents(static_cast<size_t>(componentNameCrc));
+	if (!pStorage || !pStorage->CanDeserialize(m_sectionVersion, componentSize))
+	{
+		// Skip components which were removed or changed layout since the snapshot was written.
+		CD_ENGINE_WARN("Skip snapshot section {0} with version {1}", componentNameCrc, m_sectionVersion);
+		m_pReader->Skip(dataSize);
+		++m_loadedSectionCount;
+		return true;
+	}
+
+	m_sectionEntities.resize(static_cast<size_t>(count));
+	m_pReader->ReadBytes(m_sectionEntities.data(), m_sectionEntities.size() * sizeof(Entity));
+	for (Entity& entity : m_sectionEntities)
+	{
+		entity = m_pReader->RemapEntity(entity);
+	}
+	m_sectionLoadedCount = 0U;
+
+	if (m_sectionEntities.empty())
+	{
+		++m_loadedSectionCount;
+	}
+	else
+	{
+		m_pStorage = pStorage;
+	}
+
+	return true;
+}
+
+void WorldSnapshotLoader::Finish()
+{
+	m_isFinished = true;
+	m_fin.close();
+
+	// Keep special entities of the loading world when it already has them.
+	if (INVALID_ENTITY == m_pSceneWorld->GetMainCameraEntity() && m_mainCameraEntity != INVALID_ENTITY)
+	{
+		m_pSceneWorld->SetMainCameraEntity(m_pReader->RemapEntity(m_mainCameraEntity));
+	}
+
+	if (INVALID_ENTITY == m_pSceneWorld->GetSkyEntity() && m_skyEntity != INVALID_ENTITY)
+	{
+		m_pSceneWorld->SetSkyEntity(m_pReader->RemapEntity(m_skyEntity));
+	}
+
+	CD_ENGINE_INFO("Load {0} snapshot sections", m_loadedSectionCount);
+}
+
+void WorldSnapshotLoader::Fail(const char* pReason)
+{
+	m_isFailed = true;
+	m_pStorage = nullptr;
+	m_fin.close();
+
+	CD_ENGINE_ERROR("Failed to load world snapshot : {0}", pReason);
+}
+
+}
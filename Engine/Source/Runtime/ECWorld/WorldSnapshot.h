@@ -0,0 +1,112 @@
+#pragma once
+
+#include "ECWorld/Entity.h"
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace engine
+{
+
+class IComponentsStorage;
+class SceneWorld;
+class SnapshotReader;
+
+// In-memory copy of all component storages. Capture when entering play mode and restore when exiting
+// brings back the edited scene with the same entities, so selection and editor references stay valid.
+// Runtime resources which renderers create, such as shadow maps, are not kept. Restoring releases them from
+// the live world and restored components get new ones, so components created in play mode don't leak them.
+class WorldSnapshot final
+{
+public:
+	WorldSnapshot() = default;
+	WorldSnapshot(const WorldSnapshot&) = delete;
+	WorldSnapshot& operator=(const WorldSnapshot&) = delete;
+	WorldSnapshot(WorldSnapshot&&) = default;
+	WorldSnapshot& operator=(WorldSnapshot&&) = default;
+	~WorldSnapshot();
+
+	// Capturing again reuses memory of the last capture.
+	void Capture(const SceneWorld& sceneWorld);
+
+	// Storages registered after capturing are cleared.
+	void Restore(SceneWorld& sceneWorld) const;
+
+	bool IsEmpty() const { return m_storages.empty(); }
+	void Clear() { m_storages.clear(); }
+
+private:
+	std::unordered_map<size_t, std::unique_ptr<IComponentsStorage>> m_storages;
+	Entity m_selectedEntity = INVALID_ENTITY;
+	Entity m_mainCameraEntity = INVALID_ENTITY;
+	Entity m_skyEntity = INVALID_ENTITY;
+#ifdef ENABLE_DDGI
+	Entity m_ddgiEntity = INVALID_ENTITY;
+#endif
+};
+
+class WorldSnapshotWriter
+{
+public:
+	// Little endian binary of storages which have a ComponentSerializer :
+	// Header { uint32 magic = "CDWS", uint32 version, uint32 sectionCount, uint32 mainCameraEntity, uint32 skyEntity }
+	// Sections { uint64 componentNameCrc, uint32 serializerVersion, uint32 componentSize, uint64 count, uint64 dataSize,
+	//            uint32 entities[count], component data } * sectionCount
+	// dataSize counts bytes after the section header so loaders can skip unknown sections.
+	static bool Write(const SceneWorld& sceneWorld, const char* pFilePath);
+};
+
+// Loads a binary snapshot over multiple frames so big scenes don't stall the editor.
+// Entities are created again in the target world which means loading merges into the existing scene.
+class WorldSnapshotLoader final
+{
+public:
+	static constexpr size_t DefaultComponentBudget = 16384U;
+
+public:
+	explicit WorldSnapshotLoader(SceneWorld* pSceneWorld);
+	WorldSnapshotLoader(const WorldSnapshotLoader&) = delete;
+	WorldSnapshotLoader& operator=(const WorldSnapshotLoader&) = delete;
+	WorldSnapshotLoader(WorldSnapshotLoader&&) = delete;
+	WorldSnapshotLoader& operator=(WorldSnapshotLoader&&) = delete;
+	~WorldSnapshotLoader();
+
+	bool Open(const char* pFilePath);
+
+	// Reads at most componentBudget components. Returns true when loading finished or failed.
+	bool Update(size_t componentBudget = DefaultComponentBudget);
+
+	bool IsFinished() const { return m_isFinished; }
+	bool IsFailed() const { return m_isFailed; }
+	uint32_t GetLoadedSectionCount() const { return m_loadedSectionCount; }
+	uint32_t GetSectionCount() const { return m_sectionCount; }
+
+private:
+	bool BeginSection();
+	void Finish();
+	void Fail(const char* pReason);
+
+private:
+	SceneWorld* m_pSceneWorld;
+	std::ifstream m_fin;
+	std::unique_ptr<SnapshotReader> m_pReader;
+
+	uint32_t m_sectionCount = 0U;
+	uint32_t m_loadedSectionCount = 0U;
+	Entity m_mainCameraEntity = INVALID_ENTITY;
+	Entity m_skyEntity = INVALID_ENTITY;
+
+	// Section in progress.
+	IComponentsStorage* m_pStorage = nullptr;
+	uint32_t m_sectionVersion = 0U;
+	std::vector<Entity> m_sectionEntities;
+	size_t m_sectionLoadedCount = 0U;
+
+	bool m_isFinished = false;
+	bool m_isFailed = false;
+};
+
+}
@@ -1,8 +1,10 @@
 ﻿#include "ImGuiContextInstance.h"
 
+#include "Core/Memory/TrackedBxAllocator.h"
 #include "IconFont/IconsMaterialDesignIcons.h"
 #include "IconFont/MaterialDesign.inl"
 #include "ImGui/ImGuiBaseLayer.h"
+#include "Profiling/Profiling.h"
 #include "Window/Input.h"
 #include "Log/Log.h"
 
@@ -170,6 +172,19 @@ private:
 	engine::ImGuiContextInstance* pBackContext = nullptr;
 };
 
+// ImGui allocator is shared by all contexts.
+engine::TrackedBxAllocator s_imguiAllocator(engine::MemoryTag::ImGui);
+
+void* ImGuiAllocate(size_t size, void* pUserData)
+{
+	return static_cast<bx::AllocatorI*>(pUserData)->realloc(nullptr, size, 0U, __FILE__, __LINE__);
+}
+
+void ImGuiFree(void* pMemory, void* pUserData)
+{
+	static_cast<bx::AllocatorI*>(pUserData)->realloc(pMemory, 0U, 0U, __FILE__, __LINE__);
+}
+
 }
 
 namespace engine
@@ -177,6 +192,7 @@ namespace engine
 
 ImGuiContextInstance::ImGuiContextInstance(uint16_t width, uint16_t height, bool enableDock)
 {
+	ImGui::SetAllocatorFunctions(&ImGuiAllocate, &ImGuiFree, &s_imguiAllocator);
 	m_pImGuiContext = ImGui::CreateContext();
 	SwitchCurrentContext();
 
@@ -317,6 +333,7 @@ void ImGuiContextInstance::EndDockSpace()
 
 void ImGuiContextInstance::Update(float deltaTime)
 {
+	CD_PROFILE_SCOPE("ImGuiContextInstance::Update");
 	SwitchCurrentContext();
 
 	// It is necessary to pass correct deltaTime to ImGui underlaying framework because it will use the value to check
@@ -8,6 +8,8 @@
 
 #include <imgui/imgui.h>
 
+#include <cstring>
+
 namespace ImGuiUtils
 {
 
@@ -52,9 +54,37 @@ static cd::Matrix3x3 Rotate(float rad)
 	return matrixRot;
 }
 
+// Property widgets edit values in place. Listener is told about every edit with the bytes of value before it,
+// which lets editor record undo history without knowing about widgets.
+using PropertyEditListener = void(*)(void* pUserData, const void* pValue, const void* pOldValue, size_t size);
+inline PropertyEditListener s_propertyEditListener = nullptr;
+inline void* s_pPropertyEditListenerData = nullptr;
+
+inline void SetPropertyEditListener(PropertyEditListener listener, void* pUserData)
+{
+	s_propertyEditListener = listener;
+	s_pPropertyEditListenerData = pUserData;
+}
+
+template<typename T>
+static void NotifyPropertyEdit(const T& value, const T& oldValue)
+{
+	if (s_propertyEditListener)
+	{
+		s_propertyEditListener(s_pPropertyEditListenerData, &value, &oldValue, sizeof(T));
+	}
+}
+
 static bool ImGuiBoolProperty(const char* pName, bool& value)
 {
-	return ImGui::Checkbox(pName, &value);
+	bool oldValue = value;
+	if (ImGui::Checkbox(pName, &value))
+	{
+		NotifyPropertyEdit(value, oldValue);
+		return true;
+	}
+
+	return false;
 }
 
 static void Text(const char *pText, float fontScale = 1.0f)
@@ -71,6 +101,7 @@ template<typename EnumType>
 static bool ImGuiEnumProperty(const char* pName, EnumType& value)
 {
 	bool dirty = false;
+	EnumType oldValue = value;
 
 	ImGui::Columns(2);
 	ImGui::TextUnformatted(pName);
@@ -88,6 +119,7 @@ static bool ImGuiEnumProperty(const char* pName, EnumType& value)
 			{
 				value = enumValue;
 				dirty = true;
+				NotifyPropertyEdit(value, oldValue);
 			}
 
 			if (isSelected)
@@ -136,8 +168,10 @@ static bool ImGuiIntProperty(const char* pName, int& value, cd::Unit unit = cd::
 	ImGui::NextColumn();
 	ImGui::PushItemWidth(-1);
 
+	int oldValue = value;
 	if (ImGui::DragInt(pName, &value, speed, minValue, maxValue, "%d"))
 	{
+		NotifyPropertyEdit(value, oldValue);
 		dirty = true;
 	}
 
@@ -162,8 +196,10 @@ static bool ImGuiFloatProperty(const char* pName, float& value, cd::Unit unit =
 	metricName += cd::GetUnitName(unit);
 	float delta = maxValue - minValue;
 	float dragSpeed = (speed <= 0.0) ? (cd::Math::IsEqualToZero(delta) ? 1.0f : delta * 0.05f) : speed;
+	float oldValue = value;
 	if (ImGui::DragFloat(pName, &value, dragSpeed, minValue, maxValue, metricName.c_str()))
 	{
+		NotifyPropertyEdit(value, oldValue);
 		dirty = true;
 	}
 
@@ -178,6 +214,7 @@ template<typename T>
 static bool ImGuiVectorProperty(const char* pName, T& value, cd::Unit unit = cd::Unit::None, const T& minValue = {}, const T& maxValue = {}, bool isNormalized = false, float speed = -1.0f)
 {
 	bool dirty = false;
+	T oldValue = value;
 
 	if (isNormalized)
 	{
@@ -220,6 +257,11 @@ static bool ImGuiVectorProperty(const char* pName, T& value, cd::Unit unit = cd:
 		}
 	}
 
+	if (dirty)
+	{
+		NotifyPropertyEdit(value, oldValue);
+	}
+
 	ImGui::PopItemWidth();
 	ImGui::PopID();
 
@@ -230,6 +272,12 @@ static bool ImGuiTransformProperty(const char* pName, cd::Transform& value, cd::
 {
 	ImGui::PushID(pName);
 
+	// Sub widgets don't see rotation and scale changes so transform is reported as a whole at the end.
+	cd::Transform oldValue = value;
+	cd::Vec3f oldEular = inspectorEular;
+	PropertyEditListener listener = s_propertyEditListener;
+	s_propertyEditListener = nullptr;
+
 	bool dirty = false;
 	if (ImGuiVectorProperty("Translation", value.GetTranslation()))
 	{
@@ -317,6 +365,16 @@ static bool ImGuiTransformProperty(const char* pName, cd::Transform& value, cd::
 	ImGui::Columns(1);
 	ImGui::PopID();
 
+	s_propertyEditListener = listener;
+	if (dirty)
+	{
+		NotifyPropertyEdit(value, oldValue);
+		if (std::memcmp(&inspectorEular, &oldEular, sizeof(cd::Vec3f)) != 0)
+		{
+			NotifyPropertyEdit(inspectorEular, oldEular);
+		}
+	}
+
 	return dirty;
 }
 
@@ -329,6 +387,8 @@ static void ColorPickerProperty(const char* pName, T& color)
 		showMap[pName] = false;
 	}
 
+	T oldColor = color;
+
 	ImGui::PushID(pName);
 	ImGui::TextUnformatted(pName);
 	ImGui::SameLine();
@@ -376,6 +436,11 @@ static void ColorPickerProperty(const char* pName, T& color)
 	}
 	ImGui::Separator();
 	ImGui::PopID();
+
+	if (std::memcmp(&color, &oldColor, sizeof(T)) != 0)
+	{
+		NotifyPropertyEdit(color, oldColor);
+	}
 }
 
 }
\ No newline at end of file
@@ -1,5 +1,9 @@
 #include "DebugPanel.h"
 #include "ImGui/IconFont/IconsMaterialDesignIcons.h"
+#include "Rendering/RenderContext.h"
+#include "Rendering/Resources/ResourceContext.h"
+#include "Rendering/Resources/TextureResource.h"
+#include "Rendering/Resources/TextureStreamer.h"
 
 #include <bgfx/bgfx.h>
 #include <bx/string.h>
@@ -76,7 +80,7 @@ void DebugPanel::Init()
 
 void DebugPanel::Update()
 {
-	ImGui::SetNextWindowSize(ImVec2(350, 200.0f));
+	ImGui::SetNextWindowSize(ImVec2(350, 300.0f));
 
 	ImGui::Begin(GetName(), &m_isEnable);
 
@@ -84,6 +88,8 @@ void DebugPanel::Update()
 
 	ImGui::Separator();
 
+	ShowTextureStreaming();
+
 	ImGui::End();
 }
 
@@ -136,6 +142,46 @@ void DebugPanel::ShowProfiler()
 	
 		ImGui::Text("GPU mem: %s / %s", tmp0, tmp1);
 	}
+
+	const MeshLodStats& meshLodStats = GetRenderContext()->GetMeshLodStats();
+	ImGui::Text("Mesh LOD triangles: %llu, saved: %llu"
+		, static_cast<unsigned long long>(meshLodStats.submittedTriangleCount)
+		, static_cast<unsigned long long>(meshLodStats.savedTriangleCount)
+	);
+
+	GPUResourceStats gpuResourceStats = GetRenderContext()->GetGPUResourceRegistry()->GetStats();
+	uint32_t aliveCount = 0U;
+	for (uint32_t count : gpuResourceStats.aliveCounts)
+	{
+		aliveCount += count;
+	}
+	ImGui::Text("GPU resources: %u, pending destroy: %u", aliveCount, gpuResourceStats.pendingDestroyCount);
+}
+
+void DebugPanel::ShowTextureStreaming()
+{
+	const TextureStreamer* pTextureStreamer = GetRenderContext()->GetResourceContext()->GetTextureStreamer();
+	TextureStreamingStats stats = pTextureStreamer->GetStats();
+
+	char residentText[64];
+	bx::prettify(residentText, BX_COUNTOF(residentText), stats.residentBytes);
+	char requestedText[64];
+	bx::prettify(requestedText, BX_COUNTOF(requestedText), stats.requestedBytes);
+	char budgetText[64];
+	bx::prettify(budgetText, BX_COUNTOF(budgetText), stats.budgetBytes);
+	ImGui::Text("Texture resident: %s, requested: %s, budget: %s", residentText, requestedText, budgetText);
+
+	if (ImGui::TreeNode("Textures", "Textures (%u)", stats.textureCount))
+	{
+		for (const TextureResource* pTextureResource : pTextureStreamer->GetTextures())
+		{
+			bx::prettify(residentText, BX_COUNTOF(residentText), pTextureResource->GetResidentBytes());
+			bx::prettify(requestedText, BX_COUNTOF(requestedText), pTextureResource->GetRequestedBytes());
+			ImGui::Text("%u : mip %u/%u, resident %s, requested %s", static_cast<uint32_t>(pTextureResource->GetName().Value()),
+				pTextureResource->GetResidentMip(), pTextureResource->GetMipCount(), residentText, requestedText);
+		}
+		ImGui::TreePop();
+	}
 }
 
 }
\ No newline at end of file
@@ -14,6 +14,7 @@ public:
 
 private:
 	void ShowProfiler();
+	void ShowTextureStreaming();
 };
 
 }
\ No newline at end of file
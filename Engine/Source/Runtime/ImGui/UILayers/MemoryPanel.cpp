@@ -0,0 +1,128 @@
+#include "MemoryPanel.h"
+
+#include "Core/Memory/HeapAllocationCounter.h"
+#include "Core/Memory/MemoryTracker.h"
+
+#include <bx/string.h>
+#include <imgui/imgui.h>
+
+#include <cstdint>
+
+namespace
+{
+
+constexpr float BytesPerMB = 1024.0f * 1024.0f;
+
+void TextBytes(uint64_t bytes)
+{
+	char text[64];
+	bx::prettify(text, BX_COUNTOF(text), bytes);
+	ImGui::TextUnformatted(text);
+}
+
+}
+
+namespace engine
+{
+
+MemoryPanel::~MemoryPanel()
+{
+}
+
+void MemoryPanel::Init()
+{
+}
+
+void MemoryPanel::Update()
+{
+	constexpr auto flags = ImGuiWindowFlags_NoCollapse;
+	ImGui::Begin(GetName(), &m_isEnable, flags);
+
+	HeapAllocationStats heapStats = HeapAllocationCounter::GetStats();
+	ImGui::Text("Heap allocations: %llu", static_cast<unsigned long long>(heapStats.count));
+	ImGui::SameLine();
+	ImGui::TextUnformatted("Allocated:");
+	ImGui::SameLine();
+	TextBytes(heapStats.bytes);
+
+	ImGui::Separator();
+	ShowTagTable();
+
+	ImGui::Separator();
+	ShowExport();
+
+	ImGui::End();
+}
+
+void MemoryPanel::ShowTagTable()
+{
+	constexpr auto tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable;
+	if (!ImGui::BeginTable("##MemoryTags", 6, tableFlags))
+	{
+		return;
+	}
+
+	ImGui::TableSetupColumn("Tag");
+	ImGui::TableSetupColumn("Current");
+	ImGui::TableSetupColumn("Peak");
+	ImGui::TableSetupColumn("Live");
+	ImGui::TableSetupColumn("Total");
+	ImGui::TableSetupColumn("Budget MB");
+	ImGui::TableHeadersRow();
+
+	for (uint32_t tagIndex = 0U; tagIndex < static_cast<uint32_t>(MemoryTag::Count); ++tagIndex)
+	{
+		MemoryTag tag = static_cast<MemoryTag>(tagIndex);
+		MemoryTagStats stats = MemoryTracker::GetStats(tag);
+		bool isOverBudget = MemoryTracker::IsOverBudget(tag);
+
+		ImGui::PushID(static_cast<int>(tagIndex));
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		if (isOverBudget)
+		{
+			ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", MemoryTracker::GetTagName(tag));
+		}
+		else
+		{
+			ImGui::TextUnformatted(MemoryTracker::GetTagName(tag));
+		}
+		ImGui::TableNextColumn();
+		TextBytes(stats.currentBytes);
+		ImGui::TableNextColumn();
+		TextBytes(stats.peakBytes);
+		ImGui::TableNextColumn();
+		ImGui::Text("%llu", static_cast<unsigned long long>(stats.liveAllocationCount));
+		ImGui::TableNextColumn();
+		ImGui::Text("%llu", static_cast<unsigned long long>(stats.totalAllocationCount));
+		ImGui::TableNextColumn();
+		float budgetMB = static_cast<float>(stats.budgetBytes) / BytesPerMB;
+		ImGui::SetNextItemWidth(-1.0f);
+		if (ImGui::InputFloat("##Budget", &budgetMB, 0.0f, 0.0f, "%.1f", ImGuiInputTextFlags_EnterReturnsTrue))
+		{
+			MemoryTracker::SetBudget(tag, budgetMB > 0.0f ? static_cast<uint64_t>(budgetMB * BytesPerMB) : 0U);
+		}
+		ImGui::PopID();
+	}
+
+	ImGui::EndTable();
+
+	if (ImGui::Button("Reset peaks"))
+	{
+		for (uint32_t tagIndex = 0U; tagIndex < static_cast<uint32_t>(MemoryTag::Count); ++tagIndex)
+		{
+			MemoryTracker::ResetPeak(static_cast<MemoryTag>(tagIndex));
+		}
+	}
+}
+
+void MemoryPanel::ShowExport()
+{
+	ImGui::InputText("File", m_reportFilePath, sizeof(m_reportFilePath));
+	if (ImGui::Button("Export JSON"))
+	{
+		MemoryTracker::WriteReport(m_reportFilePath);
+	}
+}
+
+}
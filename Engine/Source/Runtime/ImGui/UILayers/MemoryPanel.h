@@ -0,0 +1,26 @@
+#pragma once
+
+#include "ImGui/ImGuiBaseLayer.h"
+
+namespace engine
+{
+
+// Per tag memory of MemoryTracker with budgets and export.
+class MemoryPanel : public engine::ImGuiBaseLayer
+{
+public:
+	using ImGuiBaseLayer::ImGuiBaseLayer;
+	virtual ~MemoryPanel();
+
+	virtual void Init() override;
+	virtual void Update() override;
+
+private:
+	void ShowTagTable();
+	void ShowExport();
+
+private:
+	char m_reportFilePath[256] = "MemoryReport.json";
+};
+
+}
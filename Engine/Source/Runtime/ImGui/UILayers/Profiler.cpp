@@ -1,5 +1,8 @@
 #include "Profiler.h"
 #include "ImGui/IconFont/IconsMaterialDesignIcons.h"
+#include "Profiling/ProfileCaptureWriter.h"
+#include "Profiling/ProfileRecorder.h"
+#include "Rendering/RenderContext.h"
 
 #include <bgfx/bgfx.h>
 #include <bx/string.h>
@@ -8,6 +11,8 @@
 #include <imgui/imgui.h>
 
 #include <algorithm>
+#include <string>
+#include <vector>
 
 namespace
 {
@@ -71,6 +76,8 @@ void Profiler::Update()
     static bool showFrameTime = true;
     static bool showViewStats = true;
     static bool showGPUMemory = true;
+    static bool showZones = true;
+    static bool showCounters = true;
 
     // title
     ImGui::Text("Stats");
@@ -211,6 +218,21 @@ void Profiler::Update()
         }
     }
 
+    if (showZones)
+    {
+        ImGui::Separator();
+        ShowZoneStats();
+    }
+
+    if (showCounters)
+    {
+        ImGui::Separator();
+        ShowCounterStats();
+    }
+
+    ImGui::Separator();
+    ShowCapture();
+
     // update after drawing so offset is the current value
     static float currentTime = 0.0f;
     static float oldTime = 0.0f;
@@ -234,9 +256,122 @@ void Profiler::Update()
         ImGui::Checkbox("Frame time", &showFrameTime);
         ImGui::Checkbox("View stats", &showViewStats);
         ImGui::Checkbox("GPU memory", &showGPUMemory);
+        ImGui::Checkbox("Zones", &showZones);
+        ImGui::Checkbox("Counters", &showCounters);
         ImGui::EndPopup();
     }
     ImGui::End();
 }
 
+void Profiler::ShowCapture()
+{
+    ProfileRecorder& recorder = ProfileRecorder::Get();
+
+    bool enableCPU = recorder.IsEnable();
+    if (ImGui::Checkbox("CPU zones", &enableCPU))
+    {
+        recorder.SetEnable(enableCPU);
+    }
+
+    ImGui::SameLine();
+    bool enableGPU = GetRenderContext()->IsGPUProfileEnable();
+    if (ImGui::Checkbox("GPU views", &enableGPU))
+    {
+        GetRenderContext()->SetGPUProfileEnable(enableGPU);
+    }
+
+    if (recorder.GetDroppedEventCount() > 0U)
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "Dropped events: %llu", static_cast<unsigned long long>(recorder.GetDroppedEventCount()));
+    }
+
+    ImGui::SetNextItemWidth(100.0f);
+    ImGui::InputInt("Frames", &m_captureFrameCount);
+    m_captureFrameCount = std::clamp(m_captureFrameCount, 1, 10000);
+    ImGui::SameLine();
+    if (recorder.IsCapturing())
+    {
+        ImGui::TextUnformatted("Capturing...");
+    }
+    else if (ImGui::Button("Capture"))
+    {
+        recorder.BeginCapture(static_cast<uint32_t>(m_captureFrameCount));
+    }
+
+    if (!recorder.HasCapture())
+    {
+        return;
+    }
+
+    const ProfileCapture& capture = recorder.GetCapture();
+    ImGui::Text("Captured %u frames, %u events", static_cast<uint32_t>(capture.frameBeginTimes.size()), static_cast<uint32_t>(capture.events.size()));
+    ImGui::InputText("File", m_captureFilePath, sizeof(m_captureFilePath));
+    if (ImGui::Button("Save JSON"))
+    {
+        ProfileCaptureWriter::WriteChromeTrace(capture, (std::string(m_captureFilePath) + ".json").c_str());
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Save Binary"))
+    {
+        ProfileCaptureWriter::WriteBinary(capture, (std::string(m_captureFilePath) + ".cdpc").c_str());
+    }
+}
+
+void Profiler::ShowZoneStats()
+{
+    ProfileRecorder& recorder = ProfileRecorder::Get();
+
+    // Group by thread and put expensive zones first.
+    std::vector<const ProfileZoneStats*> zoneStats;
+    for (const ProfileZoneStats& stats : recorder.GetZoneStats())
+    {
+        zoneStats.push_back(&stats);
+    }
+    std::sort(zoneStats.begin(), zoneStats.end(), [](const ProfileZoneStats* pLhs, const ProfileZoneStats* pRhs)
+    {
+        return pLhs->threadIndex != pRhs->threadIndex ? pLhs->threadIndex < pRhs->threadIndex : pLhs->averageTime > pRhs->averageTime;
+    });
+
+    ImGui::Text("Zones");
+    constexpr auto tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+    if (!ImGui::BeginTable("##ProfileZones", 5, tableFlags, ImVec2(0.0f, 300.0f)))
+    {
+        return;
+    }
+
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Thread");
+    ImGui::TableSetupColumn("Zone");
+    ImGui::TableSetupColumn("Last ms");
+    ImGui::TableSetupColumn("Avg ms");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableHeadersRow();
+
+    for (const ProfileZoneStats* pStats : zoneStats)
+    {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(recorder.GetThreadName(pStats->threadIndex));
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(pStats->pName);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", pStats->lastTime);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", pStats->averageTime);
+        ImGui::TableNextColumn();
+        ImGui::Text("%u", pStats->callCount);
+    }
+
+    ImGui::EndTable();
+}
+
+void Profiler::ShowCounterStats()
+{
+    ImGui::Text("Counters");
+    for (const ProfileCounterStats& stats : ProfileRecorder::Get().GetCounterStats())
+    {
+        ImGui::Text("%s: %.0f", stats.pName, stats.lastValue);
+    }
+}
+
 }
\ No newline at end of file
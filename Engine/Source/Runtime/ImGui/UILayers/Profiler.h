@@ -11,6 +11,15 @@ public:
 
 	virtual void Init() override;
 	virtual void Update() override;
+
+private:
+	void ShowCapture();
+	void ShowZoneStats();
+	void ShowCounterStats();
+
+private:
+	int m_captureFrameCount = 120;
+	char m_captureFilePath[256] = "ProfileCapture";
 };
 
 }
\ No newline at end of file
@@ -2,16 +2,240 @@
 
 #ifdef SPDLOG_ENABLE
 
+#include "LogRingBuffer.h"
+
+#include <spdlog/pattern_formatter.h>
 #include <spdlog/sinks/basic_file_sink.h>
-#include <spdlog/sinks/ostream_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+
+constexpr const char* RecordPattern = "[%T] [%n] [%l]: %v";
+constexpr auto FlushInterval = std::chrono::milliseconds(10);
+constexpr size_t MaxPendingRecordCount = 4096U;
+
+// Owns the ring buffer, the real sinks and the flusher thread. Sinks are only touched under the sink mutex
+// so they are single threaded versions.
+class LogBackend final
+{
+public:
+	LogBackend() = default;
+	LogBackend(const LogBackend&) = delete;
+	LogBackend& operator=(const LogBackend&) = delete;
+	LogBackend(LogBackend&&) = delete;
+	LogBackend& operator=(LogBackend&&) = delete;
+	~LogBackend() { Stop(); }
+
+	void Start()
+	{
+		m_consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_st>();
+		m_consoleSink->set_pattern("%^[%T] %n: %v%$");
+
+		m_fileSink = std::make_shared<spdlog::sinks::basic_file_sink_st>("CatDog.log", true);
+		m_fileSink->set_pattern(RecordPattern);
+
+		m_recordFormatter = std::make_unique<spdlog::pattern_formatter>(RecordPattern, spdlog::pattern_time_type::local, "");
+
+		m_isRunning.store(true, std::memory_order_release);
+		m_flushThread = std::thread([this]() { FlushLoop(); });
+	}
+
+	void Stop()
+	{
+		if (m_flushThread.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_wakeMutex);
+				m_isRunning.store(false, std::memory_order_release);
+			}
+			m_wakeCondition.notify_one();
+			m_flushThread.join();
+		}
+
+		// Producers which saw the backend running may push after the last flush of the flusher thread.
+		if (m_consoleSink)
+		{
+			Flush();
+		}
+	}
+
+	bool IsRunning() const { return m_isRunning.load(std::memory_order_acquire); }
+
+	void Push(const spdlog::details::log_msg& msg)
+	{
+		if (!IsRunning())
+		{
+			// Detached threads may still log after Stop. Messages which are left in the ring go first to keep the order.
+			if (m_consoleSink)
+			{
+				Flush();
+
+				std::lock_guard<std::mutex> lock(m_sinkMutex);
+				Write(msg);
+				m_fileSink->flush();
+			}
+			return;
+		}
+
+		// A full ring drops messages instead of stalling the frame, except errors which wait for the flusher.
+		// Errors are also flushed right away as the application may be about to die.
+		if (msg.level < spdlog::level::err)
+		{
+			if (!m_ringBuffer.TryPush(msg))
+			{
+				m_droppedCount.fetch_add(1U, std::memory_order_relaxed);
+			}
+			return;
+		}
+
+		while (!m_ringBuffer.TryPush(msg))
+		{
+			m_wakeCondition.notify_one();
+			std::this_thread::yield();
+		}
+		m_wakeCondition.notify_one();
+	}
+
+	void FetchRecords(std::vector<engine::LogRecord>& outRecords)
+	{
+		std::lock_guard<std::mutex> lock(m_recordMutex);
+		for (engine::LogRecord& record : m_pendingRecords)
+		{
+			outRecords.push_back(std::move(record));
+		}
+		m_pendingRecords.clear();
+	}
+
+	uint64_t GetDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+private:
+	void FlushLoop()
+	{
+		while (IsRunning())
+		{
+			if (0U == Flush())
+			{
+				std::unique_lock<std::mutex> lock(m_wakeMutex);
+				m_wakeCondition.wait_for(lock, FlushInterval);
+			}
+		}
+
+		// Messages which are pushed before Stop.
+		Flush();
+	}
+
+	uint32_t Flush()
+	{
+		std::lock_guard<std::mutex> sinkLock(m_sinkMutex);
+
+		std::vector<engine::LogRecord> records;
+		uint32_t count = m_ringBuffer.Drain([this, &records](const spdlog::details::log_msg& msg)
+		{
+			Write(msg);
+			records.push_back(CreateRecord(msg));
+		});
+
+		uint64_t droppedCount = GetDroppedCount();
+		if (droppedCount != m_reportedDroppedCount)
+		{
+			std::string text = std::format("{0} log messages are dropped as the log ring buffer is full.", droppedCount - m_reportedDroppedCount);
+			spdlog::details::log_msg msg(spdlog::source_loc{}, "ENGINE", spdlog::level::warn, text);
+			Write(msg);
+			records.push_back(CreateRecord(msg));
+			m_reportedDroppedCount = droppedCount;
+		}
+
+		if (records.empty())
+		{
+			return count;
+		}
+
+		m_fileSink->flush();
+
+		std::lock_guard<std::mutex> lock(m_recordMutex);
+		for (engine::LogRecord& record : records)
+		{
+			m_pendingRecords.push_back(std::move(record));
+		}
+		if (m_pendingRecords.size() > MaxPendingRecordCount)
+		{
+			m_pendingRecords.erase(m_pendingRecords.begin(), m_pendingRecords.end() - MaxPendingRecordCount);
+		}
+
+		return count;
+	}
+
+	void Write(const spdlog::details::log_msg& msg)
+	{
+		m_consoleSink->log(msg);
+		m_fileSink->log(msg);
+	}
+
+	engine::LogRecord CreateRecord(const spdlog::details::log_msg& msg)
+	{
+		spdlog::memory_buf_t formatted;
+		m_recordFormatter->format(msg, formatted);
+
+		engine::LogRecord record;
+		record.time = msg.time;
+		record.threadID = msg.thread_id;
+		record.level = msg.level;
+		record.loggerName.assign(msg.logger_name.data(), msg.logger_name.size());
+		record.pFileName = msg.source.filename;
+		record.line = msg.source.line;
+		record.message.assign(msg.payload.data(), msg.payload.size());
+		record.text.assign(formatted.data(), formatted.size());
+		return record;
+	}
+
+private:
+	engine::LogRingBuffer m_ringBuffer;
+	std::atomic<bool> m_isRunning = false;
+	std::thread m_flushThread;
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wakeCondition;
+	std::atomic<uint64_t> m_droppedCount = 0U;
+
+	// Guards sinks, formatter and draining the ring as the flusher thread and synchronous writes may overlap during Stop.
+	std::mutex m_sinkMutex;
+	std::shared_ptr<spdlog::sinks::sink> m_consoleSink;
+	std::shared_ptr<spdlog::sinks::sink> m_fileSink;
+	std::unique_ptr<spdlog::formatter> m_recordFormatter;
+	uint64_t m_reportedDroppedCount = 0U;
+
+	std::mutex m_recordMutex;
+	std::vector<engine::LogRecord> m_pendingRecords;
+};
+
+LogBackend& GetLogBackend()
+{
+	static LogBackend s_backend;
+	return s_backend;
+}
+
+// Only sink of the loggers. spdlog formats the payload on the calling thread and the sink just copies it into the ring.
+class RingBufferSink final : public spdlog::sinks::sink
+{
+public:
+	virtual void log(const spdlog::details::log_msg& msg) override { GetLogBackend().Push(msg); }
+	virtual void flush() override {}
+	virtual void set_pattern(const std::string&) override {}
+	virtual void set_formatter(std::unique_ptr<spdlog::formatter>) override {}
+};
+
+}
+
 namespace engine
 {
 
 std::shared_ptr<spdlog::logger> Log::s_engineLogger;
 std::shared_ptr<spdlog::logger> Log::s_applicationLogger;
-std::ostringstream Log::m_oss;
 
 std::shared_ptr<spdlog::logger>& Log::GetEngineLogger()
 {
@@ -23,39 +247,37 @@ std::shared_ptr<spdlog::logger>& Log::GetApplicationLogger()
 	return s_applicationLogger;
 }
 
-const std::ostringstream& Log::GetSpdOutput()
+void Log::FetchRecords(std::vector<LogRecord>& outRecords)
 {
-	return m_oss;
+	GetLogBackend().FetchRecords(outRecords);
 }
 
-void Log::ClearBuffer()
+uint64_t Log::GetDroppedCount()
 {
-	m_oss.str("");
+	return GetLogBackend().GetDroppedCount();
 }
 
-void Log::Init() {
-	auto consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-	consoleSink->set_pattern("%^[%T] %n: %v%$");
-
-	auto fileSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("CatDog.log", true);
-	fileSink->set_pattern("[%T] [%n] [%l]: %v");
-
-	auto ossSink = std::make_shared<spdlog::sinks::ostream_sink_mt>(m_oss);
-	ossSink->set_pattern("[%T] [%n] [%l]: %v");
+void Log::Init()
+{
+	GetLogBackend().Start();
 
-	std::vector<spdlog::sink_ptr> sinks{ consoleSink, fileSink, ossSink };
+	auto ringBufferSink = std::make_shared<RingBufferSink>();
 
-	s_engineLogger = std::make_shared<spdlog::logger>("ENGINE", sinks.begin(), sinks.end());
+	s_engineLogger = std::make_shared<spdlog::logger>("ENGINE", ringBufferSink);
 	spdlog::register_logger(s_engineLogger);
 	s_engineLogger->set_level(spdlog::level::trace);
-	s_engineLogger->flush_on(spdlog::level::trace);
 
-	s_applicationLogger = std::make_shared<spdlog::logger>("EDITOR", sinks.begin(), sinks.end());
+	s_applicationLogger = std::make_shared<spdlog::logger>("EDITOR", ringBufferSink);
 	spdlog::register_logger(s_applicationLogger);
 	s_applicationLogger->set_level(spdlog::level::trace);
-	s_applicationLogger->flush_on(spdlog::level::trace);
+}
+
+void Log::Shutdown()
+{
+	// Loggers stay valid so later messages are written synchronously.
+	GetLogBackend().Stop();
 }
 
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -1,5 +1,17 @@
 #pragma once
 
+// Levels below CD_LOG_ACTIVE_LEVEL are stripped at compile time, arguments included.
+#define CD_LOG_LEVEL_TRACE 0
+#define CD_LOG_LEVEL_INFO 1
+#define CD_LOG_LEVEL_WARN 2
+#define CD_LOG_LEVEL_ERROR 3
+#define CD_LOG_LEVEL_FATAL 4
+#define CD_LOG_LEVEL_OFF 5
+
+#ifndef CD_LOG_ACTIVE_LEVEL
+#define CD_LOG_ACTIVE_LEVEL CD_LOG_LEVEL_TRACE
+#endif
+
 #ifdef SPDLOG_ENABLE
 
 #include "Math/Quaternion.hpp"
@@ -7,48 +19,94 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/ostr.h>
 
-#include <sstream>
+#include <format>
+#include <ostream>
+#include <string>
+#include <vector>
 
 namespace engine
 {
 
+// Structured log entry handed to UI consumers. text is the message formatted as "[%T] [%n] [%l]: %v".
+struct LogRecord
+{
+	spdlog::log_clock::time_point time;
+	size_t threadID;
+	spdlog::level::level_enum level;
+	std::string loggerName;
+	const char* pFileName;
+	int line;
+	std::string message;
+	std::string text;
+};
+
+// Loggers format on the calling thread and push into a lock-free ring buffer.
+// A background thread drains it into console and file sinks and collects records for the editor.
 class Log
 {
 public:
 	static void Init();
+	static void Shutdown();
 	static std::shared_ptr<spdlog::logger>& GetEngineLogger();
 	static std::shared_ptr<spdlog::logger>& GetApplicationLogger();
 
-	static const std::ostringstream& GetSpdOutput();
-	static void ClearBuffer();
+	// Appends records flushed since the last call. Older records are discarded when nobody fetches them.
+	static void FetchRecords(std::vector<LogRecord>& outRecords);
+	static uint64_t GetDroppedCount();
 
 private:
 	static std::shared_ptr<spdlog::logger> s_engineLogger;
 	static std::shared_ptr<spdlog::logger> s_applicationLogger;
-
-	// Note that m_oss will be cleared after OutputLog::AddSpdLog be called.
-	static std::ostringstream m_oss;
 };
 
 }
 
+#define CD_LOG_CALL(logger, level, ...) (logger)->log(spdlog::source_loc{ __FILE__, __LINE__, SPDLOG_FUNCTION }, level, __VA_ARGS__)
+
 // Engine log macros.
-#define CD_ENGINE_TRACE(...) ::engine::Log::GetEngineLogger()->trace(__VA_ARGS__)
-#define CD_ENGINE_INFO(...)  ::engine::Log::GetEngineLogger()->info(__VA_ARGS__)
-#define CD_ENGINE_WARN(...)  ::engine::Log::GetEngineLogger()->warn(__VA_ARGS__)
-#define CD_ENGINE_ERROR(...) ::engine::Log::GetEngineLogger()->error(__VA_ARGS__)
-#define CD_ENGINE_FATAL(...) ::engine::Log::GetEngineLogger()->critical(__VA_ARGS__)
-
-// Application log macros.
-#define CD_TRACE(...) ::engine::Log::GetApplicationLogger()->trace(__VA_ARGS__)
-#define CD_INFO(...)  ::engine::Log::GetApplicationLogger()->info(__VA_ARGS__)
-#define CD_WARN(...)  ::engine::Log::GetApplicationLogger()->warn(__VA_ARGS__)
-#define CD_ERROR(...) ::engine::Log::GetApplicationLogger()->error(__VA_ARGS__)
-#define CD_FATAL(...) ::engine::Log::GetApplicationLogger()->critical(__VA_ARGS__)
+#if CD_LOG_ACTIVE_LEVEL <= CD_LOG_LEVEL_TRACE
+#define CD_ENGINE_TRACE(...) CD_LOG_CALL(::engine::Log::GetEngineLogger(), spdlog::level::trace, __VA_ARGS__)
+#define CD_TRACE(...) CD_LOG_CALL(::engine::Log::GetApplicationLogger(), spdlog::level::trace, __VA_ARGS__)
+#else
+#define CD_ENGINE_TRACE(...) (void)0
+#define CD_TRACE(...) (void)0
+#endif
+
+#if CD_LOG_ACTIVE_LEVEL <= CD_LOG_LEVEL_INFO
+#define CD_ENGINE_INFO(...) CD_LOG_CALL(::engine::Log::GetEngineLogger(), spdlog::level::info, __VA_ARGS__)
+#define CD_INFO(...) CD_LOG_CALL(::engine::Log::GetApplicationLogger(), spdlog::level::info, __VA_ARGS__)
+#else
+#define CD_ENGINE_INFO(...) (void)0
+#define CD_INFO(...) (void)0
+#endif
+
+#if CD_LOG_ACTIVE_LEVEL <= CD_LOG_LEVEL_WARN
+#define CD_ENGINE_WARN(...) CD_LOG_CALL(::engine::Log::GetEngineLogger(), spdlog::level::warn, __VA_ARGS__)
+#define CD_WARN(...) CD_LOG_CALL(::engine::Log::GetApplicationLogger(), spdlog::level::warn, __VA_ARGS__)
+#else
+#define CD_ENGINE_WARN(...) (void)0
+#define CD_WARN(...) (void)0
+#endif
+
+#if CD_LOG_ACTIVE_LEVEL <= CD_LOG_LEVEL_ERROR
+#define CD_ENGINE_ERROR(...) CD_LOG_CALL(::engine::Log::GetEngineLogger(), spdlog::level::err, __VA_ARGS__)
+#define CD_ERROR(...) CD_LOG_CALL(::engine::Log::GetApplicationLogger(), spdlog::level::err, __VA_ARGS__)
+#else
+#define CD_ENGINE_ERROR(...) (void)0
+#define CD_ERROR(...) (void)0
+#endif
+
+#if CD_LOG_ACTIVE_LEVEL <= CD_LOG_LEVEL_FATAL
+#define CD_ENGINE_FATAL(...) CD_LOG_CALL(::engine::Log::GetEngineLogger(), spdlog::level::critical, __VA_ARGS__)
+#define CD_FATAL(...) CD_LOG_CALL(::engine::Log::GetApplicationLogger(), spdlog::level::critical, __VA_ARGS__)
+#else
+#define CD_ENGINE_FATAL(...) (void)0
+#define CD_FATAL(...) (void)0
+#endif
 
 // Runtime assert.
-#define CD_ENGINE_ASSERT(x, ...) { if(!(x)) { ::engine::Log::GetEngineLogger()->error(__VA_ARGS__); } }
-#define CD_ASSERT(x, ...) { if(!(x)) { ::engine::Log::GetApplicationLogger()->error(__VA_ARGS__); } }
+#define CD_ENGINE_ASSERT(x, ...) { if(!(x)) { CD_ENGINE_ERROR(__VA_ARGS__); } }
+#define CD_ASSERT(x, ...) { if(!(x)) { CD_ERROR(__VA_ARGS__); } }
 
 inline std::ostream& operator<<(std::ostream& os, const cd::Vec2f& vec)
 {
@@ -72,12 +130,18 @@ inline std::ostream& operator<<(std::ostream& os, const cd::Quaternion& quaterni
 
 #else
 
+namespace engine
+{
+
 class Log
 {
 public:
 	static void Init() {}
+	static void Shutdown() {}
 };
 
+}
+
 #define CD_ENGINE_TRACE(...)
 #define CD_ENGINE_INFO(...) 
 #define CD_ENGINE_WARN(...) 
@@ -0,0 +1,74 @@
+#include "LogRingBuffer.h"
+
+#ifdef SPDLOG_ENABLE
+
+namespace engine
+{
+
+LogRingBuffer::LogRingBuffer()
+	: m_slots(std::make_unique<Slot[]>(SlotCount))
+{
+	for (uint32_t slotIndex = 0U; slotIndex < SlotCount; ++slotIndex)
+	{
+		m_slots[slotIndex].sequence.store(slotIndex, std::memory_order_relaxed);
+		m_slots[slotIndex].pLongText = nullptr;
+	}
+}
+
+LogRingBuffer::~LogRingBuffer()
+{
+	for (uint32_t slotIndex = 0U; slotIndex < SlotCount; ++slotIndex)
+	{
+		delete[] m_slots[slotIndex].pLongText;
+	}
+}
+
+bool LogRingBuffer::TryPush(const spdlog::details::log_msg& msg)
+{
+	uint64_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+	Slot* pSlot = nullptr;
+	while (true)
+	{
+		pSlot = &m_slots[position & (SlotCount - 1U)];
+		uint64_t sequence = pSlot->sequence.load(std::memory_order_acquire);
+		if (sequence == position)
+		{
+			if (m_enqueuePosition.compare_exchange_weak(position, position + 1U, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (sequence < position)
+		{
+			// Flusher hasn't released this slot yet.
+			return false;
+		}
+		else
+		{
+			position = m_enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	pSlot->time = msg.time;
+	pSlot->source = msg.source;
+	pSlot->loggerName = msg.logger_name;
+	pSlot->threadID = msg.thread_id;
+	pSlot->level = msg.level;
+	pSlot->length = static_cast<uint32_t>(msg.payload.size());
+	if (msg.payload.size() > InlineTextSize)
+	{
+		pSlot->pLongText = new char[msg.payload.size()];
+		std::memcpy(pSlot->pLongText, msg.payload.data(), msg.payload.size());
+	}
+	else
+	{
+		std::memcpy(pSlot->text, msg.payload.data(), msg.payload.size());
+	}
+	pSlot->sequence.store(position + 1U, std::memory_order_release);
+
+	return true;
+}
+
+}
+
+#endif
@@ -0,0 +1,89 @@
+#pragma once
+
+#ifdef SPDLOG_ENABLE
+
+#include <spdlog/details/log_msg.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace engine
+{
+
+// Bounded lock-free MPSC queue of log messages. Any thread pushes, only the log flusher thread drains.
+// Slots carry a sequence number so a producer claims a slot with one CAS and publishes it with one store.
+// Slots are about 256 bytes so the ring takes 1 MB.
+class LogRingBuffer final
+{
+public:
+	static constexpr uint32_t SlotCount = 4096U;
+	static constexpr uint32_t InlineTextSize = 176U;
+	static_assert((SlotCount & (SlotCount - 1U)) == 0U, "SlotCount must be power of two.");
+
+public:
+	LogRingBuffer();
+	LogRingBuffer(const LogRingBuffer&) = delete;
+	LogRingBuffer& operator=(const LogRingBuffer&) = delete;
+	LogRingBuffer(LogRingBuffer&&) = delete;
+	LogRingBuffer& operator=(LogRingBuffer&&) = delete;
+	~LogRingBuffer();
+
+	// Returns false when the ring is full.
+	bool TryPush(const spdlog::details::log_msg& msg);
+
+	// Calls func(const spdlog::details::log_msg&) for every published message in order and returns the count.
+	template<typename Func>
+	uint32_t Drain(Func&& func);
+
+private:
+	struct Slot
+	{
+		std::atomic<uint64_t> sequence;
+		spdlog::log_clock::time_point time;
+		spdlog::source_loc source;
+		spdlog::string_view_t loggerName;
+		size_t threadID;
+		spdlog::level::level_enum level;
+		uint32_t length;
+		// Messages longer than the inline text, e.g. shader compile errors, are copied to the heap.
+		char* pLongText;
+		char text[InlineTextSize];
+	};
+
+	std::unique_ptr<Slot[]> m_slots;
+	alignas(64) std::atomic<uint64_t> m_enqueuePosition = 0U;
+	alignas(64) uint64_t m_dequeuePosition = 0U;
+};
+
+template<typename Func>
+uint32_t LogRingBuffer::Drain(Func&& func)
+{
+	uint32_t count = 0U;
+	while (true)
+	{
+		Slot& slot = m_slots[m_dequeuePosition & (SlotCount - 1U)];
+		if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1U)
+		{
+			break;
+		}
+
+		const char* pText = slot.pLongText ? slot.pLongText : slot.text;
+		spdlog::details::log_msg msg(slot.time, slot.source, slot.loggerName, slot.level, spdlog::string_view_t(pText, slot.length));
+		msg.thread_id = slot.threadID;
+		func(static_cast<const spdlog::details::log_msg&>(msg));
+
+		delete[] slot.pLongText;
+		slot.pLongText = nullptr;
+		slot.sequence.store(m_dequeuePosition + SlotCount, std::memory_order_release);
+		++m_dequeuePosition;
+		++count;
+	}
+
+	return count;
+}
+
+}
+
+#endif
@@ -66,6 +66,7 @@ void ParticlePool::AllParticlesReset()
 	m_particles.resize(m_maxParticleCount);
 	m_freeParticleIndexes.clear();
 	m_freeParticleIndexes.reserve(m_maxParticleCount);
+	m_poolMemory.Set(m_particles.capacity() * sizeof(Particle) + m_freeParticleIndexes.capacity() * sizeof(int));
 }
 
 }
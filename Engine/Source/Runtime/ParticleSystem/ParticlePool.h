@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Base/Template.h"
+#include "Core/Memory/MemoryTracker.h"
 #include "Core/StringCrc.h"
 #include "Math/Vector.hpp"
 
@@ -36,6 +37,7 @@ private:
 	int m_currentParticleCount = 0;
 	std::vector<Particle> m_particles;
 	std::vector<int> m_freeParticleIndexes;
+	TrackedMemorySize m_poolMemory{ MemoryTag::Particle };
 };
 
 }
\ No newline at end of file
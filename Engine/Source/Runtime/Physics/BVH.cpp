@@ -0,0 +1,273 @@
+#include "BVH.h"
+
+#include "Base/Template.h"
+
+#include <array>
+#include <cassert>
+#include <limits>
+#include <numeric>
+
+namespace engine
+{
+
+namespace
+{
+
+float SurfaceArea(const cd::Vec3f& boxMin, const cd::Vec3f& boxMax)
+{
+	cd::Vec3f extent = boxMax - boxMin;
+	return 2.0f * (extent.x() * extent.y() + extent.y() * extent.z() + extent.z() * extent.x());
+}
+
+void ExpandBounds(cd::Vec3f& boxMin, cd::Vec3f& boxMax, const cd::Vec3f& otherMin, const cd::Vec3f& otherMax)
+{
+	for (uint32_t axis = 0U; axis < 3U; ++axis)
+	{
+		boxMin[axis] = std::min(boxMin[axis], otherMin[axis]);
+		boxMax[axis] = std::max(boxMax[axis], otherMax[axis]);
+	}
+}
+
+void ResetBounds(cd::Vec3f& boxMin, cd::Vec3f& boxMax)
+{
+	boxMin = cd::Vec3f(std::numeric_limits<float>::max());
+	boxMax = cd::Vec3f(std::numeric_limits<float>::lowest());
+}
+
+}
+
+void BVH::Build(std::vector<cd::AABB> primitiveBounds)
+{
+	Clear();
+
+	m_primitiveBounds = cd::MoveTemp(primitiveBounds);
+	uint32_t primitiveCount = GetPrimitiveCount();
+	if (0U == primitiveCount)
+	{
+		return;
+	}
+
+	m_primitiveIndices.resize(primitiveCount);
+	std::iota(m_primitiveIndices.begin(), m_primitiveIndices.end(), 0U);
+	m_primitiveLeaves.resize(primitiveCount, InvalidIndex);
+
+	std::vector<cd::Vec3f> centroids;
+	centroids.reserve(primitiveCount);
+	for (const cd::AABB& bounds : m_primitiveBounds)
+	{
+		centroids.push_back((bounds.Min() + bounds.Max()) * 0.5f);
+	}
+
+	m_nodes.reserve(primitiveCount * 2U - 1U);
+	Node& root = m_nodes.emplace_back();
+	root.parent = InvalidIndex;
+	BuildNode(0U, 0U, primitiveCount, 0U, centroids);
+}
+
+void BVH::Clear()
+{
+	m_nodes.clear();
+	m_primitiveIndices.clear();
+	m_primitiveLeaves.clear();
+	m_primitiveBounds.clear();
+}
+
+void BVH::BuildNode(uint32_t nodeIndex, uint32_t firstPrimitive, uint32_t primitiveCount, uint32_t depth, const std::vector<cd::Vec3f>& centroids)
+{
+	cd::Vec3f boundsMin;
+	cd::Vec3f boundsMax;
+	cd::Vec3f centroidMin;
+	cd::Vec3f centroidMax;
+	ResetBounds(boundsMin, boundsMax);
+	ResetBounds(centroidMin, centroidMax);
+	for (uint32_t index = firstPrimitive; index < firstPrimitive + primitiveCount; ++index)
+	{
+		uint32_t primitiveIndex = m_primitiveIndices[index];
+		const cd::AABB& bounds = m_primitiveBounds[primitiveIndex];
+		ExpandBounds(boundsMin, boundsMax, bounds.Min(), bounds.Max());
+		ExpandBounds(centroidMin, centroidMax, centroids[primitiveIndex], centroids[primitiveIndex]);
+	}
+
+	m_nodes[nodeIndex].boundsMin = boundsMin;
+	m_nodes[nodeIndex].boundsMax = boundsMax;
+
+	auto MakeLeaf = [&]()
+	{
+		Node& node = m_nodes[nodeIndex];
+		node.childOrFirstPrimitive = firstPrimitive;
+		node.primitiveCount = primitiveCount;
+		for (uint32_t index = firstPrimitive; index < firstPrimitive + primitiveCount; ++index)
+		{
+			m_primitiveLeaves[m_primitiveIndices[index]] = nodeIndex;
+		}
+	};
+
+	if (primitiveCount <= MaxLeafPrimitiveCount)
+	{
+		MakeLeaf();
+		return;
+	}
+
+	uint32_t* pFirst = m_primitiveIndices.data() + firstPrimitive;
+	uint32_t* pLast = pFirst + primitiveCount;
+	uint32_t* pMiddle = nullptr;
+
+	if (depth < MaxSAHDepth)
+	{
+		struct Bin
+		{
+			cd::Vec3f boundsMin;
+			cd::Vec3f boundsMax;
+			uint32_t count;
+		};
+
+		float bestCost = std::numeric_limits<float>::max();
+		uint32_t bestAxis = 3U;
+		uint32_t bestSplit = 0U;
+		for (uint32_t axis = 0U; axis < 3U; ++axis)
+		{
+			float extent = centroidMax[axis] - centroidMin[axis];
+			if (extent <= 1e-6f)
+			{
+				continue;
+			}
+
+			std::array<Bin, BinCount> bins;
+			for (Bin& bin : bins)
+			{
+				ResetBounds(bin.boundsMin, bin.boundsMax);
+				bin.count = 0U;
+			}
+
+			float binScale = static_cast<float>(BinCount) / extent;
+			for (const uint32_t* pIndex = pFirst; pIndex != pLast; ++pIndex)
+			{
+				uint32_t binIndex = std::min(BinCount - 1U, static_cast<uint32_t>((centroids[*pIndex][axis] - centroidMin[axis]) * binScale));
+				const cd::AABB& bounds = m_primitiveBounds[*pIndex];
+				ExpandBounds(bins[binIndex].boundsMin, bins[binIndex].boundsMax, bounds.Min(), bounds.Max());
+				++bins[binIndex].count;
+			}
+
+			// Sweep from right to left to get area and count of right parts, then from left to right to evaluate costs.
+			std::array<float, BinCount> rightAreas;
+			std::array<uint32_t, BinCount> rightCounts;
+			cd::Vec3f sweepMin;
+			cd::Vec3f sweepMax;
+			ResetBounds(sweepMin, sweepMax);
+			uint32_t sweepCount = 0U;
+			for (uint32_t binIndex = BinCount - 1U; binIndex > 0U; --binIndex)
+			{
+				ExpandBounds(sweepMin, sweepMax, bins[binIndex].boundsMin, bins[binIndex].boundsMax);
+				sweepCount += bins[binIndex].count;
+				rightAreas[binIndex] = sweepCount > 0U ? SurfaceArea(sweepMin, sweepMax) : 0.0f;
+				rightCounts[binIndex] = sweepCount;
+			}
+
+			ResetBounds(sweepMin, sweepMax);
+			sweepCount = 0U;
+			for (uint32_t split = 1U; split < BinCount; ++split)
+			{
+				ExpandBounds(sweepMin, sweepMax, bins[split - 1U].boundsMin, bins[split - 1U].boundsMax);
+				sweepCount += bins[split - 1U].count;
+				if (0U == sweepCount || 0U == rightCounts[split])
+				{
+					continue;
+				}
+
+				float cost = SurfaceArea(sweepMin, sweepMax) * sweepCount + rightAreas[split] * rightCounts[split];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = split;
+				}
+			}
+		}
+
+		if (bestAxis < 3U)
+		{
+			float binScale = static_cast<float>(BinCount) / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+			pMiddle = std::partition(pFirst, pLast, [&](uint32_t primitiveIndex)
+			{
+				uint32_t binIndex = std::min(BinCount - 1U, static_cast<uint32_t>((centroids[primitiveIndex][bestAxis] - centroidMin[bestAxis]) * binScale));
+				return binIndex < bestSplit;
+			});
+		}
+	}
+
+	// Fall back to median split along the longest centroid axis.
+	if (nullptr == pMiddle || pMiddle == pFirst || pMiddle == pLast)
+	{
+		cd::Vec3f extent = centroidMax - centroidMin;
+		uint32_t axis = extent.x() > extent.y() ? (extent.x() > extent.z() ? 0U : 2U) : (extent.y() > extent.z() ? 1U : 2U);
+		pMiddle = pFirst + primitiveCount / 2U;
+		std::nth_element(pFirst, pMiddle, pLast, [&centroids, axis](uint32_t lhs, uint32_t rhs)
+		{
+			return centroids[lhs][axis] < centroids[rhs][axis];
+		});
+	}
+
+	uint32_t leftCount = static_cast<uint32_t>(pMiddle - pFirst);
+	uint32_t leftIndex = static_cast<uint32_t>(m_nodes.size());
+	m_nodes.emplace_back().parent = nodeIndex;
+	m_nodes.emplace_back().parent = nodeIndex;
+	m_nodes[nodeIndex].childOrFirstPrimitive = leftIndex;
+	m_nodes[nodeIndex].primitiveCount = 0U;
+
+	BuildNode(leftIndex, firstPrimitive, leftCount, depth + 1U, centroids);
+	BuildNode(leftIndex + 1U, firstPrimitive + leftCount, primitiveCount - leftCount, depth + 1U, centroids);
+}
+
+void BVH::UpdateLeafBounds(Node& node) const
+{
+	ResetBounds(node.boundsMin, node.boundsMax);
+	for (uint32_t index = 0U; index < node.primitiveCount; ++index)
+	{
+		const cd::AABB& bounds = m_primitiveBounds[m_primitiveIndices[node.childOrFirstPrimitive + index]];
+		ExpandBounds(node.boundsMin, node.boundsMax, bounds.Min(), bounds.Max());
+	}
+}
+
+void BVH::UpdateInternalBounds(Node& node) const
+{
+	const Node& left = m_nodes[node.childOrFirstPrimitive];
+	const Node& right = m_nodes[node.childOrFirstPrimitive + 1U];
+	node.boundsMin = left.boundsMin;
+	node.boundsMax = left.boundsMax;
+	ExpandBounds(node.boundsMin, node.boundsMax, right.boundsMin, right.boundsMax);
+}
+
+void BVH::RefitPrimitive(uint32_t primitiveIndex, const cd::AABB& bounds)
+{
+	assert(primitiveIndex < GetPrimitiveCount());
+	m_primitiveBounds[primitiveIndex] = bounds;
+
+	uint32_t nodeIndex = m_primitiveLeaves[primitiveIndex];
+	UpdateLeafBounds(m_nodes[nodeIndex]);
+
+	nodeIndex = m_nodes[nodeIndex].parent;
+	while (nodeIndex != InvalidIndex)
+	{
+		UpdateInternalBounds(m_nodes[nodeIndex]);
+		nodeIndex = m_nodes[nodeIndex].parent;
+	}
+}
+
+void BVH::Refit()
+{
+	// Children are always stored after their parent so a reverse loop is bottom-up.
+	for (uint32_t nodeIndex = GetNodeCount(); nodeIndex > 0U; --nodeIndex)
+	{
+		Node& node = m_nodes[nodeIndex - 1U];
+		if (node.primitiveCount > 0U)
+		{
+			UpdateLeafBounds(node);
+		}
+		else
+		{
+			UpdateInternalBounds(node);
+		}
+	}
+}
+
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "Math/Box.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace engine
+{
+
+// BVH is a binary bounding volume hierarchy over primitive bounding boxes which is built by binned SAH.
+// Nodes are stored in a flat array. Two children of an internal node are adjacent and always stored after their parent.
+// When primitive bounds change, RefitPrimitive and Refit keep the topology and only update node bounds.
+class BVH final
+{
+public:
+	static constexpr uint32_t InvalidIndex = UINT32_MAX;
+	static constexpr uint32_t MaxLeafPrimitiveCount = 4U;
+	static constexpr uint32_t BinCount = 12U;
+	// Deeper nodes use median split so that traversal stack depth is bounded.
+	static constexpr uint32_t MaxSAHDepth = 64U;
+	static constexpr uint32_t MaxStackSize = 128U;
+
+	struct Node
+	{
+		cd::Vec3f boundsMin;
+		cd::Vec3f boundsMax;
+		// Internal node : index of left child and right child is the next one.
+		// Leaf node : index of first primitive in primitive index list.
+		uint32_t childOrFirstPrimitive;
+		// Zero for internal nodes.
+		uint32_t primitiveCount;
+		uint32_t parent;
+	};
+
+public:
+	BVH() = default;
+	BVH(const BVH&) = default;
+	BVH& operator=(const BVH&) = default;
+	BVH(BVH&&) = default;
+	BVH& operator=(BVH&&) = default;
+	~BVH() = default;
+
+	void Build(std::vector<cd::AABB> primitiveBounds);
+	void Clear();
+
+	// Update one primitive and its ancestors. Suitable when a few primitives changed.
+	void RefitPrimitive(uint32_t primitiveIndex, const cd::AABB& bounds);
+	// Update bounds without touching nodes. Call Refit after a batch of changes.
+	void SetPrimitiveBounds(uint32_t primitiveIndex, const cd::AABB& bounds) { m_primitiveBounds[primitiveIndex] = bounds; }
+	void Refit();
+
+	bool IsEmpty() const { return m_nodes.empty(); }
+	uint32_t GetPrimitiveCount() const { return static_cast<uint32_t>(m_primitiveBounds.size()); }
+	uint32_t GetNodeCount() const { return static_cast<uint32_t>(m_nodes.size()); }
+	const Node& GetNode(uint32_t nodeIndex) const { return m_nodes[nodeIndex]; }
+	const cd::AABB& GetPrimitiveBounds(uint32_t primitiveIndex) const { return m_primitiveBounds[primitiveIndex]; }
+
+	// Visit primitives whose bounds are hit by the ray in near to far order of node entry distance.
+	// primitiveRaycast(uint32_t primitiveIndex, float& inOutMaxDistance) should shrink max distance on a closer hit
+	// so that farther nodes are culled.
+	template<typename PrimitiveRaycast>
+	void Raycast(const cd::Vec3f& origin, const cd::Vec3f& direction, float& inOutMaxDistance, PrimitiveRaycast&& primitiveRaycast) const;
+
+	// Visit primitives whose bounds overlap the box.
+	template<typename PrimitiveVisitor>
+	void Overlap(const cd::Vec3f& boxMin, const cd::Vec3f& boxMax, PrimitiveVisitor&& primitiveVisitor) const;
+
+	// Slab test. Return the entry distance or a negative value when the box is missed.
+	static float RayBoxEntry(const cd::Vec3f& origin, const cd::Vec3f& inverseDirection, const cd::Vec3f& boxMin, const cd::Vec3f& boxMax, float maxDistance);
+
+private:
+	void BuildNode(uint32_t nodeIndex, uint32_t firstPrimitive, uint32_t primitiveCount, uint32_t depth, const std::vector<cd::Vec3f>& centroids);
+	void UpdateLeafBounds(Node& node) const;
+	void UpdateInternalBounds(Node& node) const;
+
+private:
+	std::vector<Node> m_nodes;
+	std::vector<uint32_t> m_primitiveIndices;
+	std::vector<uint32_t> m_primitiveLeaves;
+	std::vector<cd::AABB> m_primitiveBounds;
+};
+
+inline float BVH::RayBoxEntry(const cd::Vec3f& origin, const cd::Vec3f& inverseDirection, const cd::Vec3f& boxMin, const cd::Vec3f& boxMax, float maxDistance)
+{
+	float tMin = 0.0f;
+	float tMax = maxDistance;
+	for (uint32_t axis = 0U; axis < 3U; ++axis)
+	{
+		float t0 = (boxMin[axis] - origin[axis]) * inverseDirection[axis];
+		float t1 = (boxMax[axis] - origin[axis]) * inverseDirection[axis];
+		tMin = std::max(tMin, std::min(t0, t1));
+		tMax = std::min(tMax, std::max(t0, t1));
+	}
+
+	return tMin <= tMax ? tMin : -1.0f;
+}
+
+template<typename PrimitiveRaycast>
+void BVH::Raycast(const cd::Vec3f& origin, const cd::Vec3f& direction, float& inOutMaxDistance, PrimitiveRaycast&& primitiveRaycast) const
+{
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	// Avoid infinity * 0 in slab test when ray starts on a slab plane.
+	cd::Vec3f inverseDirection;
+	for (uint32_t axis = 0U; axis < 3U; ++axis)
+	{
+		float value = std::abs(direction[axis]) < 1e-12f ? std::copysign(1e-12f, direction[axis]) : direction[axis];
+		inverseDirection[axis] = 1.0f / value;
+	}
+
+	if (RayBoxEntry(origin, inverseDirection, m_nodes[0].boundsMin, m_nodes[0].boundsMax, inOutMaxDistance) < 0.0f)
+	{
+		return;
+	}
+
+	uint32_t stack[MaxStackSize];
+	uint32_t stackSize = 0U;
+	stack[stackSize++] = 0U;
+	while (stackSize > 0U)
+	{
+		const Node& node = m_nodes[stack[--stackSize]];
+		if (node.primitiveCount > 0U)
+		{
+			for (uint32_t index = 0U; index < node.primitiveCount; ++index)
+			{
+				primitiveRaycast(m_primitiveIndices[node.childOrFirstPrimitive + index], inOutMaxDistance);
+			}
+			continue;
+		}
+
+		const Node& left = m_nodes[node.childOrFirstPrimitive];
+		const Node& right = m_nodes[node.childOrFirstPrimitive + 1U];
+		float leftEntry = RayBoxEntry(origin, inverseDirection, left.boundsMin, left.boundsMax, inOutMaxDistance);
+		float rightEntry = RayBoxEntry(origin, inverseDirection, right.boundsMin, right.boundsMax, inOutMaxDistance);
+		uint32_t nearIndex = node.childOrFirstPrimitive;
+		uint32_t farIndex = node.childOrFirstPrimitive + 1U;
+		if (rightEntry >= 0.0f && (leftEntry < 0.0f || rightEntry < leftEntry))
+		{
+			std::swap(nearIndex, farIndex);
+			std::swap(leftEntry, rightEntry);
+		}
+
+		// Push far child first so that near child is popped first.
+		if (rightEntry >= 0.0f)
+		{
+			stack[stackSize++] = farIndex;
+		}
+		if (leftEntry >= 0.0f)
+		{
+			stack[stackSize++] = nearIndex;
+		}
+	}
+}
+
+template<typename PrimitiveVisitor>
+void BVH::Overlap(const cd::Vec3f& boxMin, const cd::Vec3f& boxMax, PrimitiveVisitor&& primitiveVisitor) const
+{
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	auto IsOverlapped = [&boxMin, &boxMax](const cd::Vec3f& otherMin, const cd::Vec3f& otherMax)
+	{
+		return boxMin.x() <= otherMax.x() && boxMax.x() >= otherMin.x() &&
+			boxMin.y() <= otherMax.y() && boxMax.y() >= otherMin.y() &&
+			boxMin.z() <= otherMax.z() && boxMax.z() >= otherMin.z();
+	};
+
+	uint32_t stack[MaxStackSize];
+	uint32_t stackSize = 0U;
+	stack[stackSize++] = 0U;
+	while (stackSize > 0U)
+	{
+		const Node& node = m_nodes[stack[--stackSize]];
+		if (!IsOverlapped(node.boundsMin, node.boundsMax))
+		{
+			continue;
+		}
+
+		if (node.primitiveCount > 0U)
+		{
+			for (uint32_t index = 0U; index < node.primitiveCount; ++index)
+			{
+				uint32_t primitiveIndex = m_primitiveIndices[node.childOrFirstPrimitive + index];
+				const cd::AABB& bounds = m_primitiveBounds[primitiveIndex];
+				if (IsOverlapped(bounds.Min(), bounds.Max()))
+				{
+					primitiveVisitor(primitiveIndex);
+				}
+			}
+			continue;
+		}
+
+		stack[stackSize++] = node.childOrFirstPrimitive;
+		stack[stackSize++] = node.childOrFirstPrimitive + 1U;
+	}
+}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Math/Vector.hpp"
+
+#include <cmath>
+
+namespace engine
+{
+
+// Moller-Trumbore ray triangle intersection. outDistance is in units of direction length.
+inline bool RayTriangle(const cd::Vec3f& origin, const cd::Vec3f& direction, const cd::Vec3f& v0, const cd::Vec3f& v1, const cd::Vec3f& v2, float& outDistance)
+{
+	cd::Vec3f edge1 = v1 - v0;
+	cd::Vec3f edge2 = v2 - v0;
+	cd::Vec3f p = direction.Cross(edge2);
+	float det = edge1.Dot(p);
+	if (std::abs(det) < 1e-8f)
+	{
+		return false;
+	}
+
+	float invDet = 1.0f / det;
+	cd::Vec3f s = origin - v0;
+	float u = s.Dot(p) * invDet;
+	if (u < 0.0f || u > 1.0f)
+	{
+		return false;
+	}
+
+	cd::Vec3f q = s.Cross(edge1);
+	float v = direction.Dot(q) * invDet;
+	if (v < 0.0f || u + v > 1.0f)
+	{
+		return false;
+	}
+
+	outDistance = edge2.Dot(q) * invDet;
+	return outDistance >= 0.0f;
+}
+
+}
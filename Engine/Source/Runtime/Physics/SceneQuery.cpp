@@ -0,0 +1,283 @@
+#include "SceneQuery.h"
+
+#include "ECWorld/SceneWorld.h"
+#include "Physics/RayIntersection.h"
+#include "Rendering/Resources/MeshResource.h"
+#include "Utilities/MeshUtils.hpp"
+
+#include <cassert>
+#include <unordered_set>
+
+namespace engine
+{
+
+void SceneQuery::Update(SceneWorld* pSceneWorld)
+{
+	const std::vector<Entity>& entities = pSceneWorld->GetCollisionMeshEntities();
+	if (!m_needRebuild)
+	{
+		m_needRebuild = entities.size() != m_entityToProxy.size();
+		for (size_t index = 0; index < entities.size() && !m_needRebuild; ++index)
+		{
+			m_needRebuild = m_entityToProxy.find(entities[index]) == m_entityToProxy.end();
+		}
+	}
+
+	if (m_needRebuild)
+	{
+		Rebuild(pSceneWorld);
+		return;
+	}
+
+	std::vector<std::pair<uint32_t, cd::AABB>> changedProxies;
+	for (uint32_t proxyIndex = 0U; proxyIndex < GetEntityCount(); ++proxyIndex)
+	{
+		EntityProxy& proxy = m_proxies[proxyIndex];
+		TransformComponent* pTransformComponent = pSceneWorld->GetTransformComponent(proxy.entity);
+		if (!pTransformComponent)
+		{
+			m_needRebuild = true;
+			continue;
+		}
+
+		StaticMeshComponent* pStaticMeshComponent = pSceneWorld->GetStaticMeshComponent(proxy.entity);
+		proxy.pMeshResource = pStaticMeshComponent ? pStaticMeshComponent->GetMeshResource() : nullptr;
+
+		pTransformComponent->Build();
+		if (pTransformComponent->GetVersion() == proxy.transformVersion)
+		{
+			continue;
+		}
+
+		proxy.transformVersion = pTransformComponent->GetVersion();
+		proxy.inverseWorldMatrix = pTransformComponent->GetWorldMatrix().Inverse();
+		cd::AABB worldAABB = pSceneWorld->GetCollisionMeshComponent(proxy.entity)->GetAABB();
+		changedProxies.emplace_back(proxyIndex, worldAABB.Transform(pTransformComponent->GetWorldMatrix()));
+	}
+
+	if (changedProxies.empty())
+	{
+		return;
+	}
+
+	m_refitCountSinceBuild += static_cast<uint32_t>(changedProxies.size());
+	if (m_refitCountSinceBuild > GetEntityCount())
+	{
+		Rebuild(pSceneWorld);
+		return;
+	}
+
+	// A full bottom-up refit is cheaper than walking up from many leaves.
+	if (changedProxies.size() * 8U > m_proxies.size())
+	{
+		for (const auto& [proxyIndex, worldAABB] : changedProxies)
+		{
+			m_entityBVH.SetPrimitiveBounds(proxyIndex, worldAABB);
+		}
+		m_entityBVH.Refit();
+	}
+	else
+	{
+		for (const auto& [proxyIndex, worldAABB] : changedProxies)
+		{
+			m_entityBVH.RefitPrimitive(proxyIndex, worldAABB);
+		}
+	}
+}
+
+void SceneQuery::Rebuild(SceneWorld* pSceneWorld)
+{
+	const std::vector<Entity>& entities = pSceneWorld->GetCollisionMeshEntities();
+
+	m_proxies.clear();
+	m_proxies.reserve(entities.size());
+	m_entityToProxy.clear();
+	m_entityToProxy.reserve(entities.size());
+
+	std::vector<cd::AABB> proxyBounds;
+	proxyBounds.reserve(entities.size());
+	for (Entity entity : entities)
+	{
+		TransformComponent* pTransformComponent = pSceneWorld->GetTransformComponent(entity);
+		CollisionMeshComponent* pCollisionMeshComponent = pSceneWorld->GetCollisionMeshComponent(entity);
+		if (!pTransformComponent || !pCollisionMeshComponent)
+		{
+			// Still record it so that the entity set can be compared in next update.
+			m_entityToProxy[entity] = BVH::InvalidIndex;
+			continue;
+		}
+
+		pTransformComponent->Build();
+		StaticMeshComponent* pStaticMeshComponent = pSceneWorld->GetStaticMeshComponent(entity);
+
+		EntityProxy& proxy = m_proxies.emplace_back();
+		proxy.entity = entity;
+		proxy.transformVersion = pTransformComponent->GetVersion();
+		proxy.pMeshResource = pStaticMeshComponent ? pStaticMeshComponent->GetMeshResource() : nullptr;
+		proxy.inverseWorldMatrix = pTransformComponent->GetWorldMatrix().Inverse();
+
+		cd::AABB worldAABB = pCollisionMeshComponent->GetAABB();
+		proxyBounds.push_back(worldAABB.Transform(pTransformComponent->GetWorldMatrix()));
+		m_entityToProxy[entity] = static_cast<uint32_t>(m_proxies.size() - 1);
+	}
+
+	m_entityBVH.Build(cd::MoveTemp(proxyBounds));
+	m_refitCountSinceBuild = 0U;
+	m_needRebuild = false;
+
+	// Release triangle data of meshes which are not referenced any more.
+	std::unordered_set<const MeshResource*> usedMeshResources;
+	for (const EntityProxy& proxy : m_proxies)
+	{
+		usedMeshResources.insert(proxy.pMeshResource);
+	}
+	std::erase_if(m_meshTriangles, [&usedMeshResources](const auto& item) { return !usedMeshResources.contains(item.first); });
+}
+
+const SceneQuery::MeshTriangles* SceneQuery::GetMeshTriangles(const MeshResource* pMeshResource) const
+{
+	auto itTriangles = m_meshTriangles.find(pMeshResource);
+	if (itTriangles != m_meshTriangles.end())
+	{
+		return itTriangles->second.get();
+	}
+
+	auto pTriangles = std::make_unique<MeshTriangles>();
+	if (const cd::Mesh* pMesh = pMeshResource->GetMeshAsset())
+	{
+		pTriangles->positions.reserve(pMesh->GetVertexCount());
+		for (uint32_t vertexIndex = 0U; vertexIndex < pMesh->GetVertexCount(); ++vertexIndex)
+		{
+			pTriangles->positions.push_back(pMesh->GetVertexPosition(vertexIndex));
+		}
+
+		// Reuse the same index generation as MeshResource which outputs triangle list indices in 16 or 32 bits.
+		const uint32_t indexSize = MeshResource::GetIndexSize(pMesh->GetVertexCount());
+		for (uint32_t polygonGroupIndex = 0U; polygonGroupIndex < pMesh->GetPolygonGroupCount(); ++polygonGroupIndex)
+		{
+			std::optional<cd::IndexBuffer> optIndexBuffer = cd::BuildIndexBufferesForPolygonGroup(*pMesh, polygonGroupIndex);
+			if (!optIndexBuffer.has_value())
+			{
+				continue;
+			}
+
+			size_t indexCount = optIndexBuffer->size() / indexSize;
+			indexCount -= indexCount % 3U;
+			if (sizeof(uint16_t) == indexSize)
+			{
+				const auto* pIndices = reinterpret_cast<const uint16_t*>(optIndexBuffer->data());
+				pTriangles->indices.insert(pTriangles->indices.end(), pIndices, pIndices + indexCount);
+			}
+			else
+			{
+				const auto* pIndices = reinterpret_cast<const uint32_t*>(optIndexBuffer->data());
+				pTriangles->indices.insert(pTriangles->indices.end(), pIndices, pIndices + indexCount);
+			}
+		}
+
+		uint32_t triangleCount = static_cast<uint32_t>(pTriangles->indices.size() / 3U);
+		std::vector<cd::AABB> triangleBounds;
+		triangleBounds.reserve(triangleCount);
+		for (uint32_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+		{
+			cd::Vec3f triangleMin(FLT_MAX);
+			cd::Vec3f triangleMax(-FLT_MAX);
+			for (uint32_t corner = 0U; corner < 3U; ++corner)
+			{
+				const cd::Vec3f& position = pTriangles->positions[pTriangles->indices[triangleIndex * 3U + corner]];
+				for (uint32_t axis = 0U; axis < 3U; ++axis)
+				{
+					triangleMin[axis] = std::min(triangleMin[axis], position[axis]);
+					triangleMax[axis] = std::max(triangleMax[axis], position[axis]);
+				}
+			}
+			triangleBounds.emplace_back(triangleMin, triangleMax);
+		}
+		pTriangles->bvh.Build(cd::MoveTemp(triangleBounds));
+	}
+
+	const MeshTriangles* pResult = pTriangles.get();
+	m_meshTriangles[pMeshResource] = cd::MoveTemp(pTriangles);
+	return pResult;
+}
+
+bool SceneQuery::Raycast(const cd::Vec3f& origin, const cd::Vec3f& direction, float maxDistance, RaycastHit& outHit) const
+{
+	RaycastHit hit;
+	float closestDistance = maxDistance;
+	m_entityBVH.Raycast(origin, direction, closestDistance, [&](uint32_t proxyIndex, float& inOutMaxDistance)
+	{
+		const EntityProxy& proxy = m_proxies[proxyIndex];
+		const MeshTriangles* pTriangles = proxy.pMeshResource ? GetMeshTriangles(proxy.pMeshResource) : nullptr;
+		if (!pTriangles || pTriangles->bvh.IsEmpty())
+		{
+			// No triangles to test so the bounding box is the collision shape.
+			const cd::AABB& bounds = m_entityBVH.GetPrimitiveBounds(proxyIndex);
+			cd::Vec3f inverseDirection;
+			for (uint32_t axis = 0U; axis < 3U; ++axis)
+			{
+				inverseDirection[axis] = 1.0f / (std::abs(direction[axis]) < 1e-12f ? std::copysign(1e-12f, direction[axis]) : direction[axis]);
+			}
+
+			float entryDistance = BVH::RayBoxEntry(origin, inverseDirection, bounds.Min(), bounds.Max(), inOutMaxDistance);
+			if (entryDistance >= 0.0f && entryDistance < inOutMaxDistance)
+			{
+				inOutMaxDistance = entryDistance;
+				hit.entity = proxy.entity;
+				hit.triangleIndex = UINT32_MAX;
+			}
+			return;
+		}
+
+		// Direction is not normalized in local space so the ray parameter keeps to be world distance.
+		cd::Vec4f localOrigin = proxy.inverseWorldMatrix * cd::Vec4f(origin.x(), origin.y(), origin.z(), 1.0f);
+		cd::Vec4f localDirection = proxy.inverseWorldMatrix * cd::Vec4f(direction.x(), direction.y(), direction.z(), 0.0f);
+		cd::Vec3f rayOrigin(localOrigin.x(), localOrigin.y(), localOrigin.z());
+		cd::Vec3f rayDirection(localDirection.x(), localDirection.y(), localDirection.z());
+
+		pTriangles->bvh.Raycast(rayOrigin, rayDirection, inOutMaxDistance, [&](uint32_t triangleIndex, float& inOutTriangleDistance)
+		{
+			const uint32_t* pIndices = &pTriangles->indices[triangleIndex * 3U];
+			float distance;
+			if (RayTriangle(rayOrigin, rayDirection, pTriangles->positions[pIndices[0]], pTriangles->positions[pIndices[1]], pTriangles->positions[pIndices[2]], distance) &&
+				distance < inOutTriangleDistance)
+			{
+				inOutTriangleDistance = distance;
+				hit.entity = proxy.entity;
+				hit.triangleIndex = triangleIndex;
+			}
+		});
+	});
+
+	if (INVALID_ENTITY == hit.entity)
+	{
+		return false;
+	}
+
+	hit.distance = closestDistance;
+	hit.position = origin + direction * closestDistance;
+	outHit = hit;
+	return true;
+}
+
+void SceneQuery::OverlapAABB(const cd::AABB& aabb, std::vector<Entity>& outEntities) const
+{
+	m_entityBVH.Overlap(aabb.Min(), aabb.Max(), [this, &outEntities](uint32_t proxyIndex)
+	{
+		outEntities.push_back(m_proxies[proxyIndex].entity);
+	});
+}
+
+bool SceneQuery::GetEntityWorldAABB(Entity entity, cd::AABB& outAABB) const
+{
+	auto itProxy = m_entityToProxy.find(entity);
+	if (itProxy == m_entityToProxy.end() || BVH::InvalidIndex == itProxy->second)
+	{
+		return false;
+	}
+
+	outAABB = m_entityBVH.GetPrimitiveBounds(itProxy->second);
+	return true;
+}
+
+}
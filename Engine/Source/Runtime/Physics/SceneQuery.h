@@ -0,0 +1,86 @@
+#pragma once
+
+#include "ECWorld/Entity.h"
+#include "Math/Box.hpp"
+#include "Math/Matrix.hpp"
+#include "Physics/BVH.h"
+
+#include <cfloat>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace engine
+{
+
+class MeshResource;
+class SceneWorld;
+
+struct RaycastHit
+{
+	Entity entity = INVALID_ENTITY;
+	// Index of triangle in the mesh which counts across all polygon groups. Invalid when only bounding box is hit.
+	uint32_t triangleIndex = UINT32_MAX;
+	float distance = FLT_MAX;
+	cd::Vec3f position;
+};
+
+// SceneQuery answers spatial queries about entities which have CollisionMeshComponent.
+// Entity world AABBs are stored in a SAH BVH which is refitted when transforms change and rebuilt when entities are added or removed.
+// Ray queries continue into a per mesh triangle BVH in local space to report the exact entity and triangle.
+class SceneQuery final
+{
+public:
+	SceneQuery() = default;
+	SceneQuery(const SceneQuery&) = delete;
+	SceneQuery& operator=(const SceneQuery&) = delete;
+	SceneQuery(SceneQuery&&) = delete;
+	SceneQuery& operator=(SceneQuery&&) = delete;
+	~SceneQuery() = default;
+
+	// Synchronize with scene entities. Called once per frame before queries.
+	void Update(SceneWorld* pSceneWorld);
+	void MarkDirty() { m_needRebuild = true; }
+
+	// direction should be normalized so that hit distance is in world units.
+	bool Raycast(const cd::Vec3f& origin, const cd::Vec3f& direction, float maxDistance, RaycastHit& outHit) const;
+	void OverlapAABB(const cd::AABB& aabb, std::vector<Entity>& outEntities) const;
+	bool GetEntityWorldAABB(Entity entity, cd::AABB& outAABB) const;
+
+	uint32_t GetEntityCount() const { return static_cast<uint32_t>(m_proxies.size()); }
+	const BVH& GetEntityBVH() const { return m_entityBVH; }
+
+private:
+	struct EntityProxy
+	{
+		Entity entity;
+		uint32_t transformVersion;
+		const MeshResource* pMeshResource;
+		cd::Matrix4x4 inverseWorldMatrix;
+	};
+
+	struct MeshTriangles
+	{
+		std::vector<cd::Vec3f> positions;
+		std::vector<uint32_t> indices;
+		BVH bvh;
+	};
+
+	void Rebuild(SceneWorld* pSceneWorld);
+	const MeshTriangles* GetMeshTriangles(const MeshResource* pMeshResource) const;
+
+private:
+	bool m_needRebuild = true;
+	// Refits make BVH quality worse. Rebuild after every proxy moved once on average.
+	uint32_t m_refitCountSinceBuild = 0U;
+
+	BVH m_entityBVH;
+	std::vector<EntityProxy> m_proxies;
+	std::unordered_map<Entity, uint32_t> m_entityToProxy;
+
+	// Query functions are const but triangle BVHs are built lazily at first hit.
+	mutable std::unordered_map<const MeshResource*, std::unique_ptr<MeshTriangles>> m_meshTriangles;
+};
+
+}
@@ -67,15 +67,15 @@ void Process::Run()
 
 	if (m_waitUntilFinished)
 	{
-		int processResult;
-		subprocess_join(m_pProcess.get(), &processResult);
-		CD_ENGINE_INFO("End process {0}", m_processName.c_str());
+		subprocess_join(m_pProcess.get(), &m_exitCode);
+		CD_ENGINE_INFO("End process {0} with exit code {1}", m_processName.c_str(), m_exitCode);
 	}
 }
 
 void Process::PrintSubProcessLog(OutputType outputType, subprocess_s* const pSubProcess, SubProcessReadLogFunction readMethod)
 {
-	static char processOutputData[65536] = { 0 };
+	// Processes can run in multiple worker threads so the buffer should not be shared.
+	thread_local char processOutputData[65536] = { 0 };
 	uint32_t processOutputDataIndex = 0U;
 	uint32_t processOutputDataReadBytes = 0U;
 
@@ -88,6 +88,8 @@ void Process::PrintSubProcessLog(OutputType outputType, subprocess_s* const pSub
 
 	if (processOutputDataIndex > 0U)
 	{
+		processOutputData[processOutputDataIndex] = '\0';
+
 		// Logs from child process's stdout maybe error info because many tool authors will use stdout to print rather than stderr.
 		if (OutputType::StdOut == outputType)
 		{
@@ -39,6 +39,9 @@ public:
 	void SetEnvironments(std::vector<std::string> environments) { m_environments = cd::MoveTemp(environments); }
 	void Run();
 
+	// Only valid after Run when the process is waited until finished.
+	int GetExitCode() const { return m_exitCode; }
+
 	engine::Delegate<void(uint32_t handle, std::span<const char> str)> m_onOutput;
 	engine::Delegate<void(uint32_t handle, std::span<const char> str)> m_onErrorOutput;
 
@@ -53,6 +56,7 @@ private:
 	std::vector<std::string> m_commandArguments;
 	std::vector<std::string> m_environments;
 	bool m_waitUntilFinished = false;
+	int m_exitCode = 0;
 
 	bool m_printChildProcessLog = false;
 	bool m_printChildProcessErrorLog = true;
@@ -91,6 +95,7 @@ public:
 	void SetCommandArguments(std::vector<std::string> arguments) {}
 	void SetEnvironments(std::vector<std::string> environments) {}
 	void Run() {}
+	int GetExitCode() const { return 0; }
 
 	engine::Delegate<void(uint32_t handle, std::span<const char> str)> m_onOutput;
 	engine::Delegate<void(uint32_t handle, std::span<const char> str)> m_onErrorOutput;
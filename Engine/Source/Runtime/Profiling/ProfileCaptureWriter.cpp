@@ -0,0 +1,201 @@
+#include "ProfileCaptureWriter.h"
+
+#include "Log/Log.h"
+#include "Profiling/ProfileRecorder.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+
+constexpr uint32_t BinaryCaptureVersion = 1U;
+
+void WriteJsonString(std::ofstream& fout, std::string_view text)
+{
+	fout << '"';
+	for (char c : text)
+	{
+		if ('"' == c || '\\' == c)
+		{
+			fout << '\\' << c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
+		{
+			char escaped[8];
+			std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+			fout << escaped;
+		}
+		else
+		{
+			fout << c;
+		}
+	}
+	fout << '"';
+}
+
+// Chrome trace uses microseconds.
+void WriteJsonTime(std::ofstream& fout, uint64_t time, uint64_t baseTime)
+{
+	uint64_t nanoseconds = time > baseTime ? time - baseTime : 0U;
+	char text[32];
+	std::snprintf(text, sizeof(text), "%" PRIu64 ".%03" PRIu64, nanoseconds / 1000U, nanoseconds % 1000U);
+	fout << text;
+}
+
+template<typename T>
+void WriteValue(std::ofstream& fout, const T& value)
+{
+	fout.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}
+
+namespace engine
+{
+
+bool ProfileCaptureWriter::WriteChromeTrace(const ProfileCapture& capture, const char* pFilePath)
+{
+	std::ofstream fout(pFilePath, std::ios::out | std::ios::trunc);
+	if (!fout.is_open())
+	{
+		CD_ENGINE_ERROR("Failed to write profile capture to {0}", pFilePath);
+		return false;
+	}
+
+	uint64_t baseTime = capture.frameBeginTimes.empty() ? 0U : capture.frameBeginTimes.front();
+
+	fout << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool isFirstEvent = true;
+	auto BeginEvent = [&fout, &isFirstEvent]()
+	{
+		fout << (isFirstEvent ? "{" : ",\n{");
+		isFirstEvent = false;
+	};
+
+	for (uint32_t threadIndex = 0U; threadIndex < capture.threadNames.size(); ++threadIndex)
+	{
+		BeginEvent();
+		fout << "\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadIndex << ",\"args\":{\"name\":";
+		WriteJsonString(fout, capture.threadNames[threadIndex]);
+		fout << "}}";
+	}
+
+	for (size_t frameIndex = 0U; frameIndex < capture.frameBeginTimes.size(); ++frameIndex)
+	{
+		BeginEvent();
+		fout << "\"name\":\"Frame " << frameIndex << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":";
+		WriteJsonTime(fout, capture.frameBeginTimes[frameIndex], baseTime);
+		fout << "}";
+	}
+
+	for (const ProfileEvent& event : capture.events)
+	{
+		BeginEvent();
+		fout << "\"name\":";
+		WriteJsonString(fout, event.pName);
+		fout << ",\"pid\":0,\"tid\":" << event.threadIndex << ",\"ts\":";
+		WriteJsonTime(fout, event.beginTime, baseTime);
+		if (ProfileEventType::Counter == event.type)
+		{
+			fout << ",\"ph\":\"C\",\"args\":{\"value\":" << event.value << "}}";
+		}
+		else
+		{
+			fout << ",\"ph\":\"X\",\"dur\":";
+			WriteJsonTime(fout, event.endTime, event.beginTime);
+			fout << (ProfileEventType::GPUZone == event.type ? ",\"cat\":\"GPU\"}" : ",\"cat\":\"CPU\"}");
+		}
+	}
+
+	fout << "\n]}\n";
+	fout.close();
+
+	CD_ENGINE_INFO("Write {0} profile events to {1}", capture.events.size(), pFilePath);
+	return true;
+}
+
+bool ProfileCaptureWriter::WriteBinary(const ProfileCapture& capture, const char* pFilePath)
+{
+	std::ofstream fout(pFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!fout.is_open())
+	{
+		CD_ENGINE_ERROR("Failed to write profile capture to {0}", pFilePath);
+		return false;
+	}
+
+	// Names are stored once and events refer to them by index.
+	std::vector<std::string_view> names;
+	std::unordered_map<std::string_view, uint32_t> nameIndexes;
+	auto GetNameIndex = [&names, &nameIndexes](std::string_view name)
+	{
+		auto itName = nameIndexes.find(name);
+		if (itName != nameIndexes.end())
+		{
+			return itName->second;
+		}
+
+		uint32_t nameIndex = static_cast<uint32_t>(names.size());
+		names.push_back(name);
+		nameIndexes.emplace(name, nameIndex);
+		return nameIndex;
+	};
+
+	std::vector<uint32_t> threadNameIndexes;
+	for (const std::string& threadName : capture.threadNames)
+	{
+		threadNameIndexes.push_back(GetNameIndex(threadName));
+	}
+
+	std::vector<uint32_t> eventNameIndexes;
+	eventNameIndexes.reserve(capture.events.size());
+	for (const ProfileEvent& event : capture.events)
+	{
+		eventNameIndexes.push_back(GetNameIndex(event.pName));
+	}
+
+	fout.write("CDPC", 4);
+	WriteValue(fout, BinaryCaptureVersion);
+	WriteValue(fout, static_cast<uint32_t>(names.size()));
+	WriteValue(fout, static_cast<uint32_t>(threadNameIndexes.size()));
+	WriteValue(fout, static_cast<uint32_t>(capture.frameBeginTimes.size()));
+	WriteValue(fout, static_cast<uint64_t>(capture.events.size()));
+
+	for (std::string_view name : names)
+	{
+		WriteValue(fout, static_cast<uint32_t>(name.size()));
+		fout.write(name.data(), static_cast<std::streamsize>(name.size()));
+	}
+
+	for (uint32_t nameIndex : threadNameIndexes)
+	{
+		WriteValue(fout, nameIndex);
+	}
+
+	for (uint64_t frameBeginTime : capture.frameBeginTimes)
+	{
+		WriteValue(fout, frameBeginTime);
+	}
+
+	for (size_t eventIndex = 0U; eventIndex < capture.events.size(); ++eventIndex)
+	{
+		const ProfileEvent& event = capture.events[eventIndex];
+		WriteValue(fout, event.beginTime);
+		WriteValue(fout, event.endTime);
+		WriteValue(fout, event.value);
+		WriteValue(fout, eventNameIndexes[eventIndex]);
+		WriteValue(fout, event.threadIndex);
+		WriteValue(fout, event.depth);
+		WriteValue(fout, static_cast<uint8_t>(event.type));
+	}
+
+	fout.close();
+
+	CD_ENGINE_INFO("Write {0} profile events to {1}", capture.events.size(), pFilePath);
+	return true;
+}
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace engine
+{
+
+struct ProfileCapture;
+
+class ProfileCaptureWriter
+{
+public:
+	// Chrome trace event format which can be opened by chrome://tracing or Perfetto.
+	static bool WriteChromeTrace(const ProfileCapture& capture, const char* pFilePath);
+
+	// Compact little endian binary :
+	// Header { char magic[4] = "CDPC", uint32 version, uint32 nameCount, uint32 threadCount, uint32 frameCount, uint64 eventCount }
+	// Names { uint32 length, char[length] } * nameCount
+	// Threads { uint32 nameIndex } * threadCount
+	// Frames { uint64 beginTime } * frameCount
+	// Events { uint64 beginTime, uint64 endTime, double value, uint32 nameIndex, uint32 threadIndex, uint16 depth, uint8 type } * eventCount
+	static bool WriteBinary(const ProfileCapture& capture, const char* pFilePath);
+};
+
+}
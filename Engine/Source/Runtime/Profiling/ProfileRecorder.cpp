@@ -0,0 +1,249 @@
+#include "ProfileRecorder.h"
+
+#include <cassert>
+#include <chrono>
+
+namespace engine
+{
+
+// Single producer single consumer ring. The owner thread pushes events and EndFrame drains them.
+class ProfileThreadBuffer final
+{
+public:
+	static constexpr uint64_t Capacity = 1U << 14;
+
+public:
+	ProfileThreadBuffer(uint32_t threadIndex, const char* pName)
+		: m_threadIndex(threadIndex)
+		, m_pName(pName)
+	{
+		m_events.resize(Capacity);
+	}
+
+	ProfileThreadBuffer(const ProfileThreadBuffer&) = delete;
+	ProfileThreadBuffer& operator=(const ProfileThreadBuffer&) = delete;
+	ProfileThreadBuffer(ProfileThreadBuffer&&) = delete;
+	ProfileThreadBuffer& operator=(ProfileThreadBuffer&&) = delete;
+	~ProfileThreadBuffer() = default;
+
+	uint32_t GetThreadIndex() const { return m_threadIndex; }
+	void SetName(const char* pName) { m_pName = pName; }
+	const char* GetName() const { return m_pName; }
+
+	uint16_t IncreaseDepth() { return m_depth++; }
+	void DecreaseDepth() { --m_depth; }
+
+	void Push(const ProfileEvent& event)
+	{
+		uint64_t head = m_head.load(std::memory_order_relaxed);
+		if (head - m_tail.load(std::memory_order_acquire) >= Capacity)
+		{
+			// Nobody drains in time. Drop the newest event instead of blocking the producer.
+			m_droppedEventCount.fetch_add(1U, std::memory_order_relaxed);
+			return;
+		}
+
+		ProfileEvent& slot = m_events[head & (Capacity - 1U)];
+		slot = event;
+		slot.threadIndex = m_threadIndex;
+		m_head.store(head + 1U, std::memory_order_release);
+	}
+
+	void Drain(std::vector<ProfileEvent>& outEvents)
+	{
+		uint64_t tail = m_tail.load(std::memory_order_relaxed);
+		uint64_t head = m_head.load(std::memory_order_acquire);
+		for (; tail != head; ++tail)
+		{
+			outEvents.push_back(m_events[tail & (Capacity - 1U)]);
+		}
+		m_tail.store(tail, std::memory_order_release);
+	}
+
+	uint64_t TakeDroppedEventCount() { return m_droppedEventCount.exchange(0U, std::memory_order_relaxed); }
+
+private:
+	uint32_t m_threadIndex;
+	const char* m_pName;
+	uint16_t m_depth = 0U;
+
+	std::vector<ProfileEvent> m_events;
+	alignas(64) std::atomic<uint64_t> m_head = 0U;
+	alignas(64) std::atomic<uint64_t> m_tail = 0U;
+	std::atomic<uint64_t> m_droppedEventCount = 0U;
+};
+
+namespace
+{
+
+thread_local ProfileThreadBuffer* t_pThreadBuffer = nullptr;
+
+constexpr float NanosecondsToMilliseconds = 1.0f / 1000000.0f;
+constexpr float AverageTimeWeight = 0.1f;
+
+}
+
+uint64_t ProfileRecorder::GetTimestamp()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+ProfileRecorder::ProfileRecorder()
+{
+	// Buffer 0 is the GPU timeline.
+	m_threadBuffers.push_back(std::make_unique<ProfileThreadBuffer>(GetGPUThreadIndex(), InternName("GPU")));
+	m_frameBeginTime = GetTimestamp();
+}
+
+ProfileRecorder::~ProfileRecorder() = default;
+
+const char* ProfileRecorder::InternName(std::string_view name)
+{
+	std::lock_guard<std::mutex> lock(m_nameMutex);
+	return m_names.emplace(name).first->c_str();
+}
+
+void ProfileRecorder::SetThreadName(const char* pName)
+{
+	const char* pInternedName = InternName(pName);
+	ProfileThreadBuffer* pThreadBuffer = GetThreadBuffer();
+	std::lock_guard<std::mutex> lock(m_threadBufferMutex);
+	pThreadBuffer->SetName(pInternedName);
+}
+
+const char* ProfileRecorder::GetThreadName(uint32_t threadIndex) const
+{
+	std::lock_guard<std::mutex> lock(m_threadBufferMutex);
+	return threadIndex < m_threadBuffers.size() ? m_threadBuffers[threadIndex]->GetName() : "";
+}
+
+ProfileThreadBuffer* ProfileRecorder::GetThreadBuffer()
+{
+	if (!t_pThreadBuffer)
+	{
+		std::lock_guard<std::mutex> lock(m_threadBufferMutex);
+		uint32_t threadIndex = static_cast<uint32_t>(m_threadBuffers.size());
+		const char* pName = InternName("Thread " + std::to_string(threadIndex));
+		t_pThreadBuffer = m_threadBuffers.emplace_back(std::make_unique<ProfileThreadBuffer>(threadIndex, pName)).get();
+	}
+
+	return t_pThreadBuffer;
+}
+
+uint16_t ProfileRecorder::BeginZone()
+{
+	return GetThreadBuffer()->IncreaseDepth();
+}
+
+void ProfileRecorder::EndZone(const char* pName, uint64_t beginTime, uint16_t depth)
+{
+	ProfileThreadBuffer* pThreadBuffer = GetThreadBuffer();
+	pThreadBuffer->DecreaseDepth();
+	pThreadBuffer->Push(ProfileEvent{ pName, beginTime, GetTimestamp(), 0.0, 0U, depth, ProfileEventType::Zone });
+}
+
+void ProfileRecorder::RecordCounter(const char* pName, double value)
+{
+	if (IsEnable())
+	{
+		uint64_t timestamp = GetTimestamp();
+		GetThreadBuffer()->Push(ProfileEvent{ pName, timestamp, timestamp, value, 0U, 0U, ProfileEventType::Counter });
+	}
+}
+
+void ProfileRecorder::RecordGPUZone(const char* pName, uint64_t beginTime, uint64_t endTime)
+{
+	if (IsEnable())
+	{
+		m_threadBuffers[GetGPUThreadIndex()]->Push(ProfileEvent{ pName, beginTime, endTime, 0.0, 0U, 0U, ProfileEventType::GPUZone });
+	}
+}
+
+void ProfileRecorder::EndFrame()
+{
+	uint64_t frameEndTime = GetTimestamp();
+
+	m_frameEvents.clear();
+	{
+		std::lock_guard<std::mutex> lock(m_threadBufferMutex);
+		for (std::unique_ptr<ProfileThreadBuffer>& pThreadBuffer : m_threadBuffers)
+		{
+			pThreadBuffer->Drain(m_frameEvents);
+			m_droppedEventCount += pThreadBuffer->TakeDroppedEventCount();
+		}
+	}
+
+	for (ProfileZoneStats& zoneStats : m_zoneStats)
+	{
+		zoneStats.callCount = 0U;
+		zoneStats.lastTime = 0.0f;
+	}
+
+	for (const ProfileEvent& event : m_frameEvents)
+	{
+		UpdateStats(event);
+	}
+
+	for (ProfileZoneStats& zoneStats : m_zoneStats)
+	{
+		zoneStats.averageTime += (zoneStats.lastTime - zoneStats.averageTime) * AverageTimeWeight;
+	}
+
+	if (m_captureFrameCount > 0U)
+	{
+		m_capture.frameBeginTimes.push_back(m_frameBeginTime);
+		m_capture.events.insert(m_capture.events.end(), m_frameEvents.begin(), m_frameEvents.end());
+
+		if (0U == --m_captureFrameCount)
+		{
+			std::lock_guard<std::mutex> lock(m_threadBufferMutex);
+			m_capture.threadNames.clear();
+			for (const std::unique_ptr<ProfileThreadBuffer>& pThreadBuffer : m_threadBuffers)
+			{
+				m_capture.threadNames.emplace_back(pThreadBuffer->GetName());
+			}
+		}
+	}
+
+	m_frameBeginTime = frameEndTime;
+	++m_frameIndex;
+}
+
+void ProfileRecorder::UpdateStats(const ProfileEvent& event)
+{
+	if (ProfileEventType::Counter == event.type)
+	{
+		auto itCounter = m_counterStatsIndexes.find(event.pName);
+		if (itCounter == m_counterStatsIndexes.end())
+		{
+			itCounter = m_counterStatsIndexes.emplace(event.pName, m_counterStats.size()).first;
+			m_counterStats.push_back(ProfileCounterStats{ event.pName, 0.0 });
+		}
+		m_counterStats[itCounter->second].lastValue = event.value;
+		return;
+	}
+
+	auto key = std::make_pair(event.pName, event.threadIndex);
+	auto itZone = m_zoneStatsIndexes.find(key);
+	if (itZone == m_zoneStatsIndexes.end())
+	{
+		itZone = m_zoneStatsIndexes.emplace(key, m_zoneStats.size()).first;
+		m_zoneStats.push_back(ProfileZoneStats{ event.pName, event.threadIndex, 0U, 0.0f, 0.0f });
+	}
+
+	ProfileZoneStats& zoneStats = m_zoneStats[itZone->second];
+	++zoneStats.callCount;
+	zoneStats.lastTime += static_cast<float>(event.endTime - event.beginTime) * NanosecondsToMilliseconds;
+}
+
+void ProfileRecorder::BeginCapture(uint32_t frameCount)
+{
+	assert(frameCount > 0U);
+	m_capture.threadNames.clear();
+	m_capture.frameBeginTimes.clear();
+	m_capture.events.clear();
+	m_captureFrameCount = frameCount;
+}
+
+}
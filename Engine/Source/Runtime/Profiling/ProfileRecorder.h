@@ -0,0 +1,177 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace engine
+{
+
+class ProfileThreadBuffer;
+
+enum class ProfileEventType : uint8_t
+{
+	Zone,
+	Counter,
+	GPUZone,
+};
+
+// Names are not copied so they should be string literals or come from ProfileRecorder::InternName.
+struct ProfileEvent
+{
+	const char* pName;
+	uint64_t beginTime;
+	uint64_t endTime;
+	double value;
+	uint32_t threadIndex;
+	uint16_t depth;
+	ProfileEventType type;
+};
+
+// Timings of one zone name on one thread. Times are in milliseconds.
+struct ProfileZoneStats
+{
+	const char* pName;
+	uint32_t threadIndex;
+	uint32_t callCount;
+	float lastTime;
+	float averageTime;
+};
+
+struct ProfileCounterStats
+{
+	const char* pName;
+	double lastValue;
+};
+
+// Events of captured frames. Timestamps are nanoseconds of steady clock.
+struct ProfileCapture
+{
+	std::vector<std::string> threadNames;
+	std::vector<uint64_t> frameBeginTimes;
+	std::vector<ProfileEvent> events;
+};
+
+// ProfileRecorder collects CPU zones, counters and GPU view timings without Tracy.
+// Every thread writes to its own ring buffer without locks. EndFrame drains all rings on the main thread,
+// updates live stats for Profiler panel and appends events to the capture when it is recording.
+class ProfileRecorder final
+{
+public:
+	static ProfileRecorder& Get()
+	{
+		static ProfileRecorder s_instance;
+		return s_instance;
+	}
+
+	static uint64_t GetTimestamp();
+
+public:
+	ProfileRecorder();
+	ProfileRecorder(const ProfileRecorder&) = delete;
+	ProfileRecorder& operator=(const ProfileRecorder&) = delete;
+	ProfileRecorder(ProfileRecorder&&) = delete;
+	ProfileRecorder& operator=(ProfileRecorder&&) = delete;
+	~ProfileRecorder();
+
+	void SetEnable(bool enable) { m_isEnable.store(enable, std::memory_order_relaxed); }
+	bool IsEnable() const { return m_isEnable.load(std::memory_order_relaxed); }
+
+	// Returns a name pointer which lives as long as ProfileRecorder.
+	const char* InternName(std::string_view name);
+	void SetThreadName(const char* pName);
+
+	// Zone depth is tracked per thread by ProfileScope.
+	uint16_t BeginZone();
+	void EndZone(const char* pName, uint64_t beginTime, uint16_t depth);
+	void RecordCounter(const char* pName, double value);
+	// GPU timings are recorded on the thread which calls bgfx API and shown as a separate GPU thread.
+	void RecordGPUZone(const char* pName, uint64_t beginTime, uint64_t endTime);
+
+	// Call once per frame on the main thread.
+	void EndFrame();
+	uint64_t GetFrameIndex() const { return m_frameIndex; }
+	uint64_t GetDroppedEventCount() const { return m_droppedEventCount; }
+
+	const std::vector<ProfileZoneStats>& GetZoneStats() const { return m_zoneStats; }
+	const std::vector<ProfileCounterStats>& GetCounterStats() const { return m_counterStats; }
+	const char* GetThreadName(uint32_t threadIndex) const;
+	uint32_t GetGPUThreadIndex() const { return 0U; }
+
+	// Records events of next frameCount frames.
+	void BeginCapture(uint32_t frameCount);
+	bool IsCapturing() const { return m_captureFrameCount > 0U; }
+	bool HasCapture() const { return !IsCapturing() && !m_capture.frameBeginTimes.empty(); }
+	const ProfileCapture& GetCapture() const { return m_capture; }
+
+private:
+	ProfileThreadBuffer* GetThreadBuffer();
+	void UpdateStats(const ProfileEvent& event);
+
+private:
+	std::atomic<bool> m_isEnable = true;
+
+	// Buffers are only added during running so pointers of them are stable.
+	mutable std::mutex m_threadBufferMutex;
+	std::vector<std::unique_ptr<ProfileThreadBuffer>> m_threadBuffers;
+
+	std::mutex m_nameMutex;
+	std::unordered_set<std::string> m_names;
+
+	uint64_t m_frameIndex = 0U;
+	uint64_t m_frameBeginTime = 0U;
+	uint64_t m_droppedEventCount = 0U;
+	std::vector<ProfileEvent> m_frameEvents;
+
+	std::map<std::pair<const char*, uint32_t>, size_t> m_zoneStatsIndexes;
+	std::vector<ProfileZoneStats> m_zoneStats;
+	std::unordered_map<const char*, size_t> m_counterStatsIndexes;
+	std::vector<ProfileCounterStats> m_counterStats;
+
+	uint32_t m_captureFrameCount = 0U;
+	ProfileCapture m_capture;
+};
+
+// Records a CPU zone from construction to destruction.
+class ProfileScope final
+{
+public:
+	explicit ProfileScope(const char* pName)
+		: m_pName(pName)
+	{
+		ProfileRecorder& recorder = ProfileRecorder::Get();
+		if (recorder.IsEnable())
+		{
+			m_depth = recorder.BeginZone();
+			m_beginTime = ProfileRecorder::GetTimestamp();
+		}
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+	ProfileScope(ProfileScope&&) = delete;
+	ProfileScope& operator=(ProfileScope&&) = delete;
+
+	~ProfileScope()
+	{
+		if (m_beginTime > 0U)
+		{
+			ProfileRecorder::Get().EndZone(m_pName, m_beginTime, m_depth);
+		}
+	}
+
+private:
+	const char* m_pName;
+	uint64_t m_beginTime = 0U;
+	uint16_t m_depth = 0U;
+};
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Profiling/ProfileRecorder.h"
+
+#ifdef TRACY_ENABLE
+#include <tracy/Tracy.hpp>
+#endif
+
+#define CD_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CD_PROFILE_CONCAT(a, b) CD_PROFILE_CONCAT_IMPL(a, b)
+
+// Engine profiling macros. ProfileRecorder always records so they also work where Tracy is compiled out.
+// CD_PROFILE_SCOPE needs a string literal. Use CD_PROFILE_SCOPE_DYNAMIC for names which are built at runtime.
+#ifdef TRACY_ENABLE
+#define CD_PROFILE_SCOPE(name) ZoneScopedN(name); ::engine::ProfileScope CD_PROFILE_CONCAT(cdProfileScope, __LINE__)(name)
+#define CD_PROFILE_SCOPE_DYNAMIC(pName) ZoneTransientN(CD_PROFILE_CONCAT(tracyProfileScope, __LINE__), pName, true); ::engine::ProfileScope CD_PROFILE_CONCAT(cdProfileScope, __LINE__)(pName)
+#define CD_PROFILE_COUNTER(name, value) TracyPlot(name, static_cast<double>(value)); ::engine::ProfileRecorder::Get().RecordCounter(name, static_cast<double>(value))
+#define CD_PROFILE_THREAD(name) tracy::SetThreadName(name); ::engine::ProfileRecorder::Get().SetThreadName(name)
+#define CD_PROFILE_FRAME() FrameMark; ::engine::ProfileRecorder::Get().EndFrame()
+#else
+#define CD_PROFILE_SCOPE(name) ::engine::ProfileScope CD_PROFILE_CONCAT(cdProfileScope, __LINE__)(name)
+#define CD_PROFILE_SCOPE_DYNAMIC(pName) ::engine::ProfileScope CD_PROFILE_CONCAT(cdProfileScope, __LINE__)(pName)
+#define CD_PROFILE_COUNTER(name, value) ::engine::ProfileRecorder::Get().RecordCounter(name, static_cast<double>(value))
+#define CD_PROFILE_THREAD(name) ::engine::ProfileRecorder::Get().SetThreadName(name)
+#define CD_PROFILE_FRAME() ::engine::ProfileRecorder::Get().EndFrame()
+#endif
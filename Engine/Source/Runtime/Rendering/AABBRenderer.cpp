@@ -3,24 +3,23 @@
 #include "Core/StringCrc.h"
 #include "ECWorld/SceneWorld.h"
 #include "ECWorld/StaticMeshComponent.h"
-#include "ECWorld/TransformComponent.h"
+#include "Rendering/DebugDraw.h"
 #include "Rendering/RenderContext.h"
-#include "Scene/Texture.h"
+#include "Rendering/RenderSnapshot.h"
 
 namespace engine
 {
 
 void AABBRenderer::Init()
 {
-	constexpr StringCrc programCrc = StringCrc("AABBProgram");
-	GetRenderContext()->RegisterShaderProgram(programCrc, { "vs_AABB", "fs_AABB" });
+	GetRenderContext()->GetDebugDraw()->Init(GetRenderContext());
 
-	bgfx::setViewName(GetViewID(), "AABBRenderer");
+	SetName("AABBRenderer");
 }
 
 void AABBRenderer::Warmup()
 {
-	GetRenderContext()->UploadShaderProgram("AABBProgram");
+	GetRenderContext()->GetDebugDraw()->Warmup();
 }
 
 void AABBRenderer::UpdateView(const float* pViewMatrix, const float* pProjectionMatrix)
@@ -31,29 +30,22 @@ void AABBRenderer::UpdateView(const float* pViewMatrix, const float* pProjection
 
 void AABBRenderer::Render(float deltaTime)
 {
-	for (Entity entity : m_pCurrentSceneWorld->GetCollisionMeshEntities())
+	// All boxes are instances of one unit box so that the whole pass is a single draw call.
+	// SceneQuery is updated by simulation meanwhile so boxes come from the snapshot.
+	// Entities deleted after the snapshot was captured are skipped by component checks.
+	DebugDraw* pDebugDraw = GetRenderContext()->GetDebugDraw();
+	for (const RenderSnapshotBox& box : GetRenderContext()->GetRenderSnapshot()->GetCollisionBoxes())
 	{
-		auto* pCollisionMesh = m_pCurrentSceneWorld->GetCollisionMeshComponent(entity);
-		if (!m_enableGlobalAABB && !pCollisionMesh->IsDebugDrawEnable())
+		auto* pCollisionMesh = m_pCurrentSceneWorld->GetCollisionMeshComponent(box.entity);
+		if (!pCollisionMesh || (!m_enableGlobalAABB && !pCollisionMesh->IsDebugDrawEnable()))
 		{
 			continue;
 		}
 
-		if (auto* pTransformComponent = m_pCurrentSceneWorld->GetTransformComponent(entity))
-		{
-			pTransformComponent->Build();
-			bgfx::setTransform(pTransformComponent->GetWorldMatrix().begin());
-		}
-
-		bgfx::setVertexBuffer(0, bgfx::VertexBufferHandle{ pCollisionMesh->GetVertexBuffer() });
-		bgfx::setIndexBuffer(bgfx::IndexBufferHandle{ pCollisionMesh->GetIndexBuffer() });
-
-		constexpr uint64_t state = BGFX_STATE_WRITE_MASK | BGFX_STATE_MSAA | BGFX_STATE_DEPTH_TEST_LESS |
-			BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA) | BGFX_STATE_PT_LINES;
-		bgfx::setState(state);
-
-		GetRenderContext()->Submit(GetViewID(), "AABBProgram");
+		pDebugDraw->DrawBox(box.worldAABB.Min(), box.worldAABB.Max(), cd::Vec4f(1.0f, 0.0f, 0.0f, 1.0f));
 	}
+
+	pDebugDraw->Flush(GetViewID());
 }
 
 }
\ No newline at end of file
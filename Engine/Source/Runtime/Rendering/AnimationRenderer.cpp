@@ -3,8 +3,8 @@
 #include "Core/StringCrc.h"
 #include "ECWorld/SceneWorld.h"
 #include "ECWorld/StaticMeshComponent.h"
-#include "ECWorld/TransformComponent.h"
 #include "Rendering/RenderContext.h"
+#include "Rendering/RenderSnapshot.h"
 #include "Scene/Texture.h"
 
 #include <cmath>
@@ -135,7 +135,7 @@ void CalculateBoneTransform(std::vector<cd::Matrix4x4>& boneMatrices, const cd::
 
 void AnimationRenderer::Init()
 {
-	bgfx::setViewName(GetViewID(), "AnimationRenderer");
+	SetName("AnimationRenderer");
 }
 
 void AnimationRenderer::Warmup()
@@ -177,6 +177,7 @@ void AnimationRenderer::Render(float deltaTime)
 	animationRunningTime += deltaTime;
 
 	const cd::SceneDatabase* pSceneDatabase = m_pCurrentSceneWorld->GetSceneDatabase();
+	const RenderSnapshot* pSnapshot = GetRenderContext()->GetRenderSnapshot();
 	for (Entity entity : m_pCurrentSceneWorld->GetAnimationEntities())
 	{
 		StaticMeshComponent* pMeshComponent = m_pCurrentSceneWorld->GetStaticMeshComponent(entity);
@@ -193,8 +194,12 @@ void AnimationRenderer::Render(float deltaTime)
 			continue;
 		}
 
-		TransformComponent* pTransformComponent = m_pCurrentSceneWorld->GetTransformComponent(entity);
-		bgfx::setTransform(pTransformComponent->GetWorldMatrix().begin());
+		const RenderSnapshotTransform* pTransform = pSnapshot->FindTransform(entity);
+		if (!pTransform)
+		{
+			continue;
+		}
+		bgfx::setTransform(pTransform->worldMatrix.begin());
 
 		AnimationComponent* pAnimationComponent = m_pCurrentSceneWorld->GetAnimationComponent(entity);
 
@@ -212,7 +217,7 @@ void AnimationRenderer::Render(float deltaTime)
 
 		const cd::Bone& rootBone = pSceneDatabase->GetBone(0);
 		details::CalculateBoneTransform(boneMatrices, pSceneDatabase, animationTime, rootBone,
-			cd::Matrix4x4::Identity(), pTransformComponent->GetWorldMatrix().Inverse());
+			cd::Matrix4x4::Identity(), pTransform->worldMatrix.Inverse());
 		bgfx::setUniform(bgfx::UniformHandle{pAnimationComponent->GetBoneMatrixsUniform()}, boneMatrices.data(), static_cast<uint16_t>(boneMatrices.size()));
 
 		constexpr uint64_t state = BGFX_STATE_WRITE_MASK | BGFX_STATE_CULL_CCW | BGFX_STATE_MSAA | BGFX_STATE_DEPTH_TEST_LESS;
@@ -44,7 +44,7 @@ void BlendShapeRenderer::Init()
 	GetRenderContext()->RegisterShaderProgram(BlendShapeFinalPosProgramCrc, { "cs_blendshape_final_pos" });
 	GetRenderContext()->RegisterShaderProgram(BlendShapeUpdatePosProgramCrc, { "cs_blendshape_update_pos" });
 
-	bgfx::setViewName(GetViewID(), "BlendShapeRenderer");
+	SetName("BlendShapeRenderer");
 }
 
 void BlendShapeRenderer::Warmup()
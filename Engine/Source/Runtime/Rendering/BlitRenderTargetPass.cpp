@@ -7,7 +7,7 @@ namespace engine
 
 void BlitRenderTargetPass::Init()
 {
-	bgfx::setViewName(GetViewID(), "BlitRenderTargetPass");
+	SetName("BlitRenderTargetPass");
 }
 
 BlitRenderTargetPass::~BlitRenderTargetPass()
@@ -25,7 +25,7 @@ void BloomRenderer::Init()
 	GetRenderContext()->RegisterShaderProgram(KawaseBlurProgramCrc, { "vs_fullscreen", "fs_kawaseblur" });
 	GetRenderContext()->RegisterShaderProgram(CombineProgramCrc, { "vs_fullscreen", "fs_bloom" });
 
-	bgfx::setViewName(GetViewID(), "BloomRenderer");
+	SetName("BloomRenderer");
 
 	AllocateViewIDs();
 }
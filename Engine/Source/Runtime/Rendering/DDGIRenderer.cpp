@@ -1,13 +1,12 @@
 #include "DDGIRenderer.h"
 
-#include "ECWorld/CameraComponent.h"
 #include "ECWorld/MaterialComponent.h"
 #include "ECWorld/SceneWorld.h"
 #include "ECWorld/StaticMeshComponent.h"
-#include "ECWorld/TransformComponent.h"
 #include "Material/ShaderSchema.h"
 #include "RenderContext.h"
 #include "Rendering/DDGIDefinition.h"
+#include "Rendering/RenderSnapshot.h"
 #include "Scene/Texture.h"
 #include "U_DDGI.sh"
 #include "U_IBL.sh"
@@ -135,7 +134,7 @@ void DDGIRenderer::Init()
 	m_pDDGIComponent = m_pCurrentSceneWorld->GetDDGIComponent(m_pCurrentSceneWorld->GetDDGIEntity());
 	assert(m_pDDGIComponent && "Unknown DDGI Component pointer!");
 
-	bgfx::setViewName(GetViewID(), "WorldRenderer");
+	SetName("DDGIRenderer");
 
 	GetRenderContext()->CreateUniform(distanceSampler, bgfx::UniformType::Sampler);
 	GetRenderContext()->CreateUniform(irradianceSampler, bgfx::UniformType::Sampler);
@@ -204,8 +203,8 @@ void DDGIRenderer::UpdateView(const float* pViewMatrix, const float* pProjection
 
 void DDGIRenderer::Render(float deltaTime)
 {
-	const engine::CameraComponent *pCameraComponent = m_pCurrentSceneWorld->GetCameraComponent(m_pCurrentSceneWorld->GetMainCameraEntity());
-	const engine::TransformComponent* pCameraTransformComponent = m_pCurrentSceneWorld->GetTransformComponent(m_pCurrentSceneWorld->GetMainCameraEntity());
+	const RenderSnapshot* pSnapshot = GetRenderContext()->GetRenderSnapshot();
+	const RenderSnapshotCamera& camera = pSnapshot->GetCamera();
 
 	for(Entity entity : m_pCurrentSceneWorld->GetMaterialEntities())
 	{
@@ -223,9 +222,9 @@ void DDGIRenderer::Render(float deltaTime)
 		}
 
 		// Transform
-		if(TransformComponent* pTransformComponent = m_pCurrentSceneWorld->GetTransformComponent(entity))
+		if(const RenderSnapshotTransform* pTransform = pSnapshot->FindTransform(entity))
 		{
-			bgfx::setTransform(pTransformComponent->GetWorldMatrix().Begin());
+			bgfx::setTransform(pTransform->worldMatrix.Begin());
 		}
 
 		// Mesh
@@ -250,9 +249,9 @@ void DDGIRenderer::Render(float deltaTime)
 		cd::Vec3f tmpAlbedoColor = cd::Vec3f(1.0f, 1.0f, 1.0f);
 		GetRenderContext()->FillUniform(StringCrc(albedoColor), tmpAlbedoColor.Begin(), 1);
 
-		GetRenderContext()->FillUniform(StringCrc(cameraPos), &pCameraTransformComponent->GetTransform().GetTranslation().x(), 1);
+		GetRenderContext()->FillUniform(StringCrc(cameraPos), &camera.position.x(), 1);
 
-		auto lightEntities = m_pCurrentSceneWorld->GetLightEntities();
+		const auto& lightEntities = m_pCurrentSceneWorld->GetLightEntities();
 		size_t lightEntityCount = lightEntities.size();
 		static cd::Vec4f lightInfoData(0.0f, LightUniform::LIGHT_STRIDE, 0.0f, 0.0f);
 		lightInfoData.x() = static_cast<float>(lightEntityCount);
@@ -0,0 +1,232 @@
+#include "DebugDraw.h"
+
+#include "Core/StringCrc.h"
+#include "Rendering/RenderContext.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace engine
+{
+
+namespace
+{
+
+constexpr const char* DebugInstanceProgram = "DebugDrawInstanceProgram";
+constexpr const char* DebugLineProgram = "DebugDrawLineProgram";
+
+}
+
+DebugDraw::~DebugDraw()
+{
+	if (bgfx::isValid(m_unitBoxVBH))
+	{
+		bgfx::destroy(m_unitBoxVBH);
+		bgfx::destroy(m_unitBoxIBH);
+	}
+
+	if (bgfx::isValid(m_unitSphereVBH))
+	{
+		bgfx::destroy(m_unitSphereVBH);
+		bgfx::destroy(m_unitSphereIBH);
+	}
+}
+
+void DebugDraw::Init(RenderContext* pRenderContext)
+{
+	if (m_pRenderContext)
+	{
+		return;
+	}
+	m_pRenderContext = pRenderContext;
+
+	m_pRenderContext->RegisterShaderProgram(StringCrc(DebugInstanceProgram), { "vs_debug_draw_instance", "fs_debug_draw" });
+	m_pRenderContext->RegisterShaderProgram(StringCrc(DebugLineProgram), { "vs_debug_draw_line", "fs_debug_draw" });
+
+	m_positionLayout.begin().add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float).end();
+	m_lineLayout.begin()
+		.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+		.add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Float)
+		.end();
+
+	// Unit box [0, 1]^3. Corner index bits are x, y, z so that edges connect corners which differ in one bit.
+	std::vector<float> boxVertices;
+	for (uint32_t corner = 0U; corner < 8U; ++corner)
+	{
+		boxVertices.push_back(static_cast<float>(corner & 1U));
+		boxVertices.push_back(static_cast<float>((corner >> 1U) & 1U));
+		boxVertices.push_back(static_cast<float>((corner >> 2U) & 1U));
+	}
+	constexpr uint16_t boxIndices[] =
+	{
+		0, 1, 2, 3, 4, 5, 6, 7,
+		0, 2, 1, 3, 4, 6, 5, 7,
+		0, 4, 1, 5, 2, 6, 3, 7,
+	};
+	m_unitBoxVBH = bgfx::createVertexBuffer(bgfx::copy(boxVertices.data(), static_cast<uint32_t>(boxVertices.size() * sizeof(float))), m_positionLayout);
+	m_unitBoxIBH = bgfx::createIndexBuffer(bgfx::copy(boxIndices, sizeof(boxIndices)));
+
+	// Unit sphere is presented by three great circles on XY, YZ and ZX planes.
+	std::vector<float> sphereVertices;
+	std::vector<uint16_t> sphereIndices;
+	for (uint32_t plane = 0U; plane < 3U; ++plane)
+	{
+		uint16_t baseVertex = static_cast<uint16_t>(plane * SphereSegmentCount);
+		for (uint32_t segment = 0U; segment < SphereSegmentCount; ++segment)
+		{
+			float angle = cd::Math::TWO_PI * static_cast<float>(segment) / static_cast<float>(SphereSegmentCount);
+			float position[3] = { 0.0f, 0.0f, 0.0f };
+			position[plane] = std::cos(angle);
+			position[(plane + 1U) % 3U] = std::sin(angle);
+			sphereVertices.insert(sphereVertices.end(), std::begin(position), std::end(position));
+
+			sphereIndices.push_back(baseVertex + static_cast<uint16_t>(segment));
+			sphereIndices.push_back(baseVertex + static_cast<uint16_t>((segment + 1U) % SphereSegmentCount));
+		}
+	}
+	m_unitSphereVBH = bgfx::createVertexBuffer(bgfx::copy(sphereVertices.data(), static_cast<uint32_t>(sphereVertices.size() * sizeof(float))), m_positionLayout);
+	m_unitSphereIBH = bgfx::createIndexBuffer(bgfx::copy(sphereIndices.data(), static_cast<uint32_t>(sphereIndices.size() * sizeof(uint16_t))));
+}
+
+void DebugDraw::Warmup()
+{
+	if (m_isWarmedUp)
+	{
+		return;
+	}
+	m_isWarmedUp = true;
+
+	m_pRenderContext->UploadShaderProgram(DebugInstanceProgram);
+	m_pRenderContext->UploadShaderProgram(DebugLineProgram);
+}
+
+void DebugDraw::DrawLine(const cd::Vec3f& from, const cd::Vec3f& to, const cd::Vec4f& color)
+{
+	m_lineVertices.push_back(LineVertex{ { from.x(), from.y(), from.z() }, { color.x(), color.y(), color.z(), color.w() } });
+	m_lineVertices.push_back(LineVertex{ { to.x(), to.y(), to.z() }, { color.x(), color.y(), color.z(), color.w() } });
+}
+
+void DebugDraw::DrawBox(const cd::Vec3f& boxMin, const cd::Vec3f& boxMax, const cd::Vec4f& color)
+{
+	cd::Vec3f size = boxMax - boxMin;
+	const float transform[16] =
+	{
+		size.x(), 0.0f, 0.0f, 0.0f,
+		0.0f, size.y(), 0.0f, 0.0f,
+		0.0f, 0.0f, size.z(), 0.0f,
+		boxMin.x(), boxMin.y(), boxMin.z(), 1.0f,
+	};
+	AddInstance(m_boxInstances, transform, color);
+}
+
+void DebugDraw::DrawBox(const cd::Matrix4x4& transform, const cd::Vec3f& boxMin, const cd::Vec3f& boxMax, const cd::Vec4f& color)
+{
+	// transform * translate(boxMin) * scale(boxMax - boxMin) in column major.
+	const float* m = transform.begin();
+	cd::Vec3f size = boxMax - boxMin;
+	float instanceTransform[16];
+	for (uint32_t row = 0U; row < 4U; ++row)
+	{
+		instanceTransform[row] = m[row] * size.x();
+		instanceTransform[4 + row] = m[4 + row] * size.y();
+		instanceTransform[8 + row] = m[8 + row] * size.z();
+		instanceTransform[12 + row] = m[row] * boxMin.x() + m[4 + row] * boxMin.y() + m[8 + row] * boxMin.z() + m[12 + row];
+	}
+	AddInstance(m_boxInstances, instanceTransform, color);
+}
+
+void DebugDraw::DrawSphere(const cd::Vec3f& center, float radius, const cd::Vec4f& color)
+{
+	const float transform[16] =
+	{
+		radius, 0.0f, 0.0f, 0.0f,
+		0.0f, radius, 0.0f, 0.0f,
+		0.0f, 0.0f, radius, 0.0f,
+		center.x(), center.y(), center.z(), 1.0f,
+	};
+	AddInstance(m_sphereInstances, transform, color);
+}
+
+void DebugDraw::AddInstance(std::vector<Instance>& instances, const float* pTransform, const cd::Vec4f& color)
+{
+	Instance& instance = instances.emplace_back();
+	std::memcpy(instance.transform, pTransform, sizeof(instance.transform));
+	instance.color[0] = color.x();
+	instance.color[1] = color.y();
+	instance.color[2] = color.z();
+	instance.color[3] = color.w();
+}
+
+void DebugDraw::Flush(uint16_t viewID, uint64_t state)
+{
+	if (m_pRenderContext)
+	{
+		FlushInstances(viewID, state, m_boxInstances, m_unitBoxVBH, m_unitBoxIBH);
+		FlushInstances(viewID, state, m_sphereInstances, m_unitSphereVBH, m_unitSphereIBH);
+		FlushLines(viewID, state);
+	}
+
+	Clear();
+}
+
+void DebugDraw::Clear()
+{
+	m_boxInstances.clear();
+	m_sphereInstances.clear();
+	m_lineVertices.clear();
+}
+
+void DebugDraw::FlushInstances(uint16_t viewID, uint64_t state, const std::vector<Instance>& instances, bgfx::VertexBufferHandle vbh, bgfx::IndexBufferHandle ibh)
+{
+	constexpr uint16_t instanceStride = static_cast<uint16_t>(sizeof(Instance));
+
+	uint32_t instanceOffset = 0U;
+	uint32_t instanceCount = static_cast<uint32_t>(instances.size());
+	while (instanceOffset < instanceCount)
+	{
+		// Split into multiple draw calls when transient instance buffer can not hold all of them.
+		uint32_t drawCount = bgfx::getAvailInstanceDataBuffer(instanceCount - instanceOffset, instanceStride);
+		if (0U == drawCount)
+		{
+			break;
+		}
+
+		bgfx::InstanceDataBuffer idb;
+		bgfx::allocInstanceDataBuffer(&idb, drawCount, instanceStride);
+		std::memcpy(idb.data, &instances[instanceOffset], drawCount * instanceStride);
+		instanceOffset += drawCount;
+
+		bgfx::setVertexBuffer(0, vbh);
+		bgfx::setIndexBuffer(ibh);
+		bgfx::setInstanceDataBuffer(&idb);
+		bgfx::setState(state);
+		m_pRenderContext->Submit(viewID, DebugInstanceProgram);
+	}
+}
+
+void DebugDraw::FlushLines(uint16_t viewID, uint64_t state)
+{
+	uint32_t vertexOffset = 0U;
+	uint32_t vertexCount = static_cast<uint32_t>(m_lineVertices.size());
+	while (vertexOffset < vertexCount)
+	{
+		// Keep line pairs together.
+		uint32_t drawCount = bgfx::getAvailTransientVertexBuffer(vertexCount - vertexOffset, m_lineLayout) & ~1U;
+		if (0U == drawCount)
+		{
+			break;
+		}
+
+		bgfx::TransientVertexBuffer tvb;
+		bgfx::allocTransientVertexBuffer(&tvb, drawCount, m_lineLayout);
+		std::memcpy(tvb.data, &m_lineVertices[vertexOffset], drawCount * sizeof(LineVertex));
+		vertexOffset += drawCount;
+
+		bgfx::setVertexBuffer(0, &tvb);
+		bgfx::setState(state);
+		m_pRenderContext->Submit(viewID, DebugLineProgram);
+	}
+}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Math/Box.hpp"
+#include "Math/Matrix.hpp"
+
+#include <bgfx/bgfx.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine
+{
+
+class RenderContext;
+
+// DebugDraw collects immediate mode debug geometry during a frame and submits it in a few batched draw calls.
+// Boxes and spheres are instances of one shared unit line mesh with per instance transform and color.
+// Lines are written into one transient vertex buffer. Anything not flushed is dropped at the end of frame.
+class DebugDraw final
+{
+public:
+	static constexpr uint32_t SphereSegmentCount = 32U;
+	static constexpr uint64_t DefaultState = BGFX_STATE_WRITE_MASK | BGFX_STATE_MSAA | BGFX_STATE_DEPTH_TEST_LESS |
+		BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA) | BGFX_STATE_PT_LINES;
+
+public:
+	DebugDraw() = default;
+	DebugDraw(const DebugDraw&) = delete;
+	DebugDraw& operator=(const DebugDraw&) = delete;
+	DebugDraw(DebugDraw&&) = delete;
+	DebugDraw& operator=(DebugDraw&&) = delete;
+	~DebugDraw();
+
+	// Safe to call from multiple renderers. Only the first call does the work.
+	void Init(RenderContext* pRenderContext);
+	void Warmup();
+
+	void DrawLine(const cd::Vec3f& from, const cd::Vec3f& to, const cd::Vec4f& color);
+	void DrawBox(const cd::Vec3f& boxMin, const cd::Vec3f& boxMax, const cd::Vec4f& color);
+	// Draw a local space box transformed by a matrix which is an oriented box in world space.
+	void DrawBox(const cd::Matrix4x4& transform, const cd::Vec3f& boxMin, const cd::Vec3f& boxMax, const cd::Vec4f& color);
+	void DrawSphere(const cd::Vec3f& center, float radius, const cd::Vec4f& color);
+
+	// Submit all queued geometry to the view and clear queues.
+	void Flush(uint16_t viewID, uint64_t state = DefaultState);
+	void Clear();
+
+	uint32_t GetQueuedInstanceCount() const { return static_cast<uint32_t>(m_boxInstances.size() + m_sphereInstances.size()); }
+	uint32_t GetQueuedLineCount() const { return static_cast<uint32_t>(m_lineVertices.size() / 2U); }
+
+private:
+	struct Instance
+	{
+		float transform[16];
+		float color[4];
+	};
+	static_assert(sizeof(Instance) == 80U, "Instance layout should match i_data0 - i_data4.");
+
+	struct LineVertex
+	{
+		float position[3];
+		float color[4];
+	};
+
+	void AddInstance(std::vector<Instance>& instances, const float* pTransform, const cd::Vec4f& color);
+	void FlushInstances(uint16_t viewID, uint64_t state, const std::vector<Instance>& instances, bgfx::VertexBufferHandle vbh, bgfx::IndexBufferHandle ibh);
+	void FlushLines(uint16_t viewID, uint64_t state);
+
+private:
+	RenderContext* m_pRenderContext = nullptr;
+	bool m_isWarmedUp = false;
+
+	bgfx::VertexLayout m_positionLayout;
+	bgfx::VertexLayout m_lineLayout;
+	bgfx::VertexBufferHandle m_unitBoxVBH = BGFX_INVALID_HANDLE;
+	bgfx::IndexBufferHandle m_unitBoxIBH = BGFX_INVALID_HANDLE;
+	bgfx::VertexBufferHandle m_unitSphereVBH = BGFX_INVALID_HANDLE;
+	bgfx::IndexBufferHandle m_unitSphereIBH = BGFX_INVALID_HANDLE;
+
+	std::vector<Instance> m_boxInstances;
+	std::vector<Instance> m_sphereInstances;
+	std::vector<LineVertex> m_lineVertices;
+};
+
+}
@@ -0,0 +1,129 @@
+#include "EncoderWorkerPool.h"
+
+#include "Log/Log.h"
+#include "Profiling/Profiling.h"
+
+#include <algorithm>
+
+namespace engine
+{
+
+EncoderWorkerPool::EncoderWorkerPool()
+{
+	// Encoder 0 belongs to the thread which owns bgfx. Single threaded bgfx only has that one.
+	uint32_t maxEncoderCount = bgfx::getCaps()->limits.maxEncoders;
+	uint32_t coreCount = std::max(std::thread::hardware_concurrency(), 1U);
+	uint32_t workerCount = std::min(coreCount, maxEncoderCount) - 1U;
+	for (uint32_t workerIndex = 0U; workerIndex < workerCount; ++workerIndex)
+	{
+		m_workerThreads.emplace_back(&EncoderWorkerPool::WorkerThreadMain, this);
+	}
+
+	CD_ENGINE_INFO("Encoder worker pool starts {0} workers.", workerCount);
+}
+
+EncoderWorkerPool::~EncoderWorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_workCondition.notify_all();
+
+	for (std::thread& workerThread : m_workerThreads)
+	{
+		workerThread.join();
+	}
+}
+
+void EncoderWorkerPool::Record(uint32_t itemCount, RecordFunction recordFunction, void* pContext)
+{
+	if (0U == itemCount)
+	{
+		return;
+	}
+
+	if (m_workerThreads.empty() || itemCount <= MinItemCountPerRange)
+	{
+		bgfx::Encoder* pEncoder = bgfx::begin();
+		recordFunction(pContext, pEncoder, 0U, itemCount);
+		bgfx::end(pEncoder);
+		return;
+	}
+
+	// A few ranges per thread so that threads finishing early can take more work.
+	uint32_t threadCount = GetWorkerCount() + 1U;
+	RecordJob job;
+	job.recordFunction = recordFunction;
+	job.pContext = pContext;
+	job.itemCount = itemCount;
+	job.rangeItemCount = std::max(MinItemCountPerRange, (itemCount + threadCount * 4U - 1U) / (threadCount * 4U));
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_job = job;
+		m_nextItemIndex.store(0U);
+		++m_jobIndex;
+	}
+	m_workCondition.notify_all();
+
+	bgfx::Encoder* pEncoder = bgfx::begin();
+	RecordRanges(pEncoder, job);
+	bgfx::end(pEncoder);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_doneCondition.wait(lock, [this]() { return 0U == m_activeWorkerCount; });
+	m_job = RecordJob{};
+}
+
+void EncoderWorkerPool::WorkerThreadMain()
+{
+	CD_PROFILE_THREAD("Encoder Worker");
+
+	uint32_t lastJobIndex = 0U;
+	while (true)
+	{
+		RecordJob job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_workCondition.wait(lock, [this, lastJobIndex]() { return m_stop || m_jobIndex.load() != lastJobIndex; });
+			if (m_stop)
+			{
+				return;
+			}
+
+			lastJobIndex = m_jobIndex.load();
+			job = m_job;
+			++m_activeWorkerCount;
+		}
+
+		// Don't hold an encoder when there is nothing left or the job is already replaced by the next one.
+		// bgfx::frame waits for all encoders to end.
+		if (m_jobIndex.load() == lastJobIndex && m_nextItemIndex.load() < job.itemCount)
+		{
+			if (bgfx::Encoder* pEncoder = bgfx::begin(true))
+			{
+				RecordRanges(pEncoder, job);
+				bgfx::end(pEncoder);
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			--m_activeWorkerCount;
+		}
+		m_doneCondition.notify_one();
+	}
+}
+
+void EncoderWorkerPool::RecordRanges(bgfx::Encoder* pEncoder, const RecordJob& job)
+{
+	CD_PROFILE_SCOPE("EncoderWorkerPool::RecordRanges");
+	uint32_t beginIndex = m_nextItemIndex.fetch_add(job.rangeItemCount);
+	while (beginIndex < job.itemCount)
+	{
+		job.recordFunction(job.pContext, pEncoder, beginIndex, std::min(beginIndex + job.rangeItemCount, job.itemCount));
+		beginIndex = m_nextItemIndex.fetch_add(job.rangeItemCount);
+	}
+}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <bgfx/bgfx.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine
+{
+
+// EncoderWorkerPool records draw calls into per-thread bgfx encoders in parallel.
+// Items are split into ranges which are recorded by worker threads and the calling thread at the same time.
+// bgfx sorts draw calls inside a view by sort keys so the order between ranges doesn't matter except for sequential views.
+// Record functions only touch their own items. Shared states should be prepared before recording.
+class EncoderWorkerPool final
+{
+public:
+	// Ranges smaller than it are not worth to wake up a worker.
+	static constexpr uint32_t MinItemCountPerRange = 64U;
+
+	using RecordFunction = void(*)(void* pContext, bgfx::Encoder* pEncoder, uint32_t beginIndex, uint32_t endIndex);
+
+public:
+	// Worker count is limited by cores and encoders supported by bgfx so create it after bgfx::init.
+	EncoderWorkerPool();
+	EncoderWorkerPool(const EncoderWorkerPool&) = delete;
+	EncoderWorkerPool& operator=(const EncoderWorkerPool&) = delete;
+	EncoderWorkerPool(EncoderWorkerPool&&) = delete;
+	EncoderWorkerPool& operator=(EncoderWorkerPool&&) = delete;
+	~EncoderWorkerPool();
+
+	uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_workerThreads.size()); }
+
+	// Call on the thread which owns bgfx. Returns after all items are recorded.
+	void Record(uint32_t itemCount, RecordFunction recordFunction, void* pContext);
+
+	// func is called as func(bgfx::Encoder* pEncoder, uint32_t beginIndex, uint32_t endIndex).
+	template<typename Func>
+	void Record(uint32_t itemCount, Func& func)
+	{
+		Record(itemCount, [](void* pContext, bgfx::Encoder* pEncoder, uint32_t beginIndex, uint32_t endIndex)
+		{
+			(*static_cast<Func*>(pContext))(pEncoder, beginIndex, endIndex);
+		}, &func);
+	}
+
+private:
+	struct RecordJob
+	{
+		RecordFunction recordFunction = nullptr;
+		void* pContext = nullptr;
+		uint32_t itemCount = 0U;
+		uint32_t rangeItemCount = 0U;
+	};
+
+	void WorkerThreadMain();
+	void RecordRanges(bgfx::Encoder* pEncoder, const RecordJob& job);
+
+private:
+	std::vector<std::thread> m_workerThreads;
+	std::mutex m_mutex;
+	std::condition_variable m_workCondition;
+	std::condition_variable m_doneCondition;
+	std::atomic<uint32_t> m_jobIndex = 0U;
+	uint32_t m_activeWorkerCount = 0U;
+	bool m_stop = false;
+
+	// Current job. Written under mutex before m_jobIndex changes and copied by workers under the same lock.
+	RecordJob m_job;
+	std::atomic<uint32_t> m_nextItemIndex = 0U;
+};
+
+}
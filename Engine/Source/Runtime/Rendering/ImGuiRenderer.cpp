@@ -13,7 +13,7 @@ void ImGuiRenderer::Init()
 	constexpr StringCrc programCrc = StringCrc("ImGuiProgram");
 	GetRenderContext()->RegisterShaderProgram(programCrc, { "vs_imgui", "fs_imgui" });
 
-	bgfx::setViewName(GetViewID(), "ImGuiRenderer");
+	SetName("ImGuiRenderer");
 }
 
 void ImGuiRenderer::Warmup()
@@ -5,6 +5,7 @@
 #include "Log/Log.h"
 #include "Math/Box.hpp"
 #include "Rendering/RenderContext.h"
+#include "Rendering/RenderSnapshot.h"
 #include "Rendering/Resources/MeshResource.h"
 #include "Scene/Mesh.h"
 #include "Scene/VertexFormat.h"
@@ -27,9 +28,10 @@ constexpr const char* ProgramComputeScatteringDensity    = "ProgramComputeScatte
 constexpr const char* ProgramComputeIndirectIrradiance   = "ProgramComputeIndirectIrradiance";
 constexpr const char* ProgramComputeMultipleScattering   = "ProgramComputeMultipleScattering";
 
-constexpr const char* TextureTransmittance               = "TextureTransmittance";
-constexpr const char* TextureIrradiance                  = "TextureIrradiance";
-constexpr const char* TextureScattering                  = "TextureScattering";
+// Final LUTs are double buffered.
+constexpr const char* TextureTransmittance[2]            = { "TextureTransmittance0", "TextureTransmittance1" };
+constexpr const char* TextureIrradiance[2]               = { "TextureIrradiance0", "TextureIrradiance1" };
+constexpr const char* TextureScattering[2]               = { "TextureScattering0", "TextureScattering1" };
 constexpr const char* TextureDeltaIrradiance             = "TextureDeltaIrradiance";
 constexpr const char* TextureDeltaRayleighScattering     = "TextureDeltaRayleighScattering";
 constexpr const char* TextureDeltaMieScattering          = "TextureDeltaMieScattering";
@@ -44,7 +46,21 @@ constexpr const char* NumScatteringOrders                = "u_numScatteringOrder
 constexpr uint64_t FlagTexture2D                         = BGFX_TEXTURE_COMPUTE_WRITE | BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP;
 constexpr uint64_t FlagTexture3D                         = BGFX_TEXTURE_COMPUTE_WRITE | BGFX_SAMPLER_UVW_CLAMP;
 constexpr uint64_t StateRendering                        = BGFX_STATE_WRITE_MASK | BGFX_STATE_CULL_CCW | BGFX_STATE_MSAA | BGFX_STATE_DEPTH_TEST_LEQUAL;
-constexpr uint16_t ScatteringOrders                      = 6;
+
+void CreateDeltaTextures()
+{
+	RenderContext* pRenderContext = Renderer::GetRenderContext();
+	pRenderContext->CreateTexture(TextureDeltaIrradiance, IRRADIANCE_TEXTURE_WIDTH, IRRADIANCE_TEXTURE_HEIGHT, 1,
+		bgfx::TextureFormat::RGBA32F, FlagTexture2D);
+	pRenderContext->CreateTexture(TextureDeltaRayleighScattering, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH,
+		bgfx::TextureFormat::RGBA32F, FlagTexture3D);
+	pRenderContext->CreateTexture(TextureDeltaMieScattering, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH,
+		bgfx::TextureFormat::RGBA32F, FlagTexture3D);
+	pRenderContext->CreateTexture(TextureDeltaScatteringDensity, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH,
+		bgfx::TextureFormat::RGBA32F, FlagTexture3D);
+	pRenderContext->CreateTexture(TextureDeltaMultipleScattering, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH,
+		bgfx::TextureFormat::RGBA32F, FlagTexture3D);
+}
 
 }
 
@@ -68,27 +84,20 @@ void PBRSkyRenderer::Init()
 	GetRenderContext()->RegisterShaderProgram(ProgramComputeIndirectIrradianceCrc, { "cs_ComputeIndirectIrradiance" });
 	GetRenderContext()->RegisterShaderProgram(ProgramComputeMultipleScatteringCrc, { "cs_ComputeMultipleScattering" });
 
-	bgfx::setViewName(GetViewID(), "PBRSkyRenderer");
+	SetName("PBRSkyRenderer");
 }
 
 void PBRSkyRenderer::Warmup()
 {
-	GetRenderContext()->CreateTexture(TextureTransmittance, TRANSMITTANCE_TEXTURE_WIDTH, TRANSMITTANCE_TEXTURE_HEIGHT, 1,
-		bgfx::TextureFormat::RGBA32F, FlagTexture2D);
-	GetRenderContext()->CreateTexture(TextureIrradiance, IRRADIANCE_TEXTURE_WIDTH, IRRADIANCE_TEXTURE_HEIGHT, 1,
-		bgfx::TextureFormat::RGBA32F, FlagTexture2D);
-	GetRenderContext()->CreateTexture(TextureDeltaIrradiance, IRRADIANCE_TEXTURE_WIDTH, IRRADIANCE_TEXTURE_HEIGHT, 1,
-		bgfx::TextureFormat::RGBA32F, FlagTexture2D);
-	GetRenderContext()->CreateTexture(TextureDeltaRayleighScattering, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH,
-		bgfx::TextureFormat::RGBA32F, FlagTexture3D);
-	GetRenderContext()->CreateTexture(TextureDeltaMieScattering, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH,
-		bgfx::TextureFormat::RGBA32F, FlagTexture3D);
-	GetRenderContext()->CreateTexture(TextureScattering, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH,
-		bgfx::TextureFormat::RGBA32F, FlagTexture3D);
-	GetRenderContext()->CreateTexture(TextureDeltaScatteringDensity, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH,
-		bgfx::TextureFormat::RGBA32F, FlagTexture3D);
-	GetRenderContext()->CreateTexture(TextureDeltaMultipleScattering, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH,
-		bgfx::TextureFormat::RGBA32F, FlagTexture3D);
+	for (uint32_t bufferIndex = 0U; bufferIndex < 2U; ++bufferIndex)
+	{
+		GetRenderContext()->CreateTexture(TextureTransmittance[bufferIndex], TRANSMITTANCE_TEXTURE_WIDTH, TRANSMITTANCE_TEXTURE_HEIGHT, 1,
+			bgfx::TextureFormat::RGBA32F, FlagTexture2D);
+		GetRenderContext()->CreateTexture(TextureIrradiance[bufferIndex], IRRADIANCE_TEXTURE_WIDTH, IRRADIANCE_TEXTURE_HEIGHT, 1,
+			bgfx::TextureFormat::RGBA32F, FlagTexture2D);
+		GetRenderContext()->CreateTexture(TextureScattering[bufferIndex], SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH,
+			bgfx::TextureFormat::RGBA32F, FlagTexture3D);
+	}
 
 	GetRenderContext()->CreateUniform(LightDir, bgfx::UniformType::Enum::Vec4, 1);
 	GetRenderContext()->CreateUniform(CameraPos, bgfx::UniformType::Enum::Vec4, 1);
@@ -134,14 +143,25 @@ void PBRSkyRenderer::Render(float deltaTime)
 		return;
 	}
 
-	if (!m_isPrecomputed)
+	SkyComponent* pSkyComponent = m_pCurrentSceneWorld->GetSkyComponent(m_pCurrentSceneWorld->GetSkyEntity());
+
+	// Restart precompute if atmosphere changes again before the current one finishes.
+	uint32_t atmosphereVersion = pSkyComponent->GetAtmosphereVersion();
+	bool isLUTOutdated = !m_hasValidLUT || atmosphereVersion != m_builtVersion;
+	if (isLUTOutdated && (!IsPrecomputing() || atmosphereVersion != m_precomputeVersion))
+	{
+		BeginPrecompute(atmosphereVersion, pSkyComponent->GetScatteringOrders());
+	}
+
+	// Nothing can be shown before the first LUTs so that the first precompute runs in one frame.
+	uint32_t dispatchBudget = m_hasValidLUT ? m_precomputeDispatchBudget : UINT32_MAX;
+	for (uint32_t dispatchIndex = 0U; dispatchIndex < dispatchBudget && IsPrecomputing(); ++dispatchIndex)
 	{
-		Precompute();
-		m_isPrecomputed = true;
+		ExecutePrecomputeStep();
 	}
 
 	StaticMeshComponent* pMeshComponent = m_pCurrentSceneWorld->GetStaticMeshComponent(m_pCurrentSceneWorld->GetSkyEntity());
-	if (!pMeshComponent)
+	if (!m_hasValidLUT || !pMeshComponent)
 	{
 		return;
 	}
@@ -153,20 +173,20 @@ void PBRSkyRenderer::Render(float deltaTime)
 		return;
 	}
 
-	bgfx::setImage(ATM_TRANSMITTANCE_SLOT, GetRenderContext()->GetTexture(StringCrc(TextureTransmittance)), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
-	bgfx::setImage(ATM_IRRADIANCE_SLOT, GetRenderContext()->GetTexture(StringCrc(TextureIrradiance)), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
-	bgfx::setImage(ATM_SCATTERING_SLOT, GetRenderContext()->GetTexture(StringCrc(TextureScattering)), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
+	bgfx::setImage(ATM_TRANSMITTANCE_SLOT, GetRenderContext()->GetTexture(pSkyComponent->GetATMTransmittanceCrc()), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
+	bgfx::setImage(ATM_IRRADIANCE_SLOT, GetRenderContext()->GetTexture(pSkyComponent->GetATMIrradianceCrc()), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
+	bgfx::setImage(ATM_SCATTERING_SLOT, GetRenderContext()->GetTexture(pSkyComponent->GetATMScatteringCrc()), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
 
 	constexpr StringCrc cameraPosCrc(CameraPos);
-	GetRenderContext()->FillUniform(cameraPosCrc, &(m_pCurrentSceneWorld->GetTransformComponent(m_pCurrentSceneWorld->GetMainCameraEntity())->GetTransform().GetTranslation().x()), 1);
-
-	auto skyComponent = m_pCurrentSceneWorld->GetSkyComponent(m_pCurrentSceneWorld->GetSkyEntity());
+	const RenderSnapshot* pSnapshot = GetRenderContext()->GetRenderSnapshot();
+	GetRenderContext()->FillUniform(cameraPosCrc, &(pSnapshot->GetCamera().position.x()), 1);
 
+	// Simulation advances time of day meanwhile so sun direction comes from the snapshot.
 	constexpr StringCrc LightDirCrc(LightDir);
-	GetRenderContext()->FillUniform(LightDirCrc, &(skyComponent->GetSunDirection().x()), 1);
+	GetRenderContext()->FillUniform(LightDirCrc, &(pSnapshot->GetSunDirection().x()), 1);
 
 	constexpr StringCrc HeightOffsetCrc(HeightOffset);
-	cd::Vec4f tmpHeightOffset = cd::Vec4f(skyComponent->GetHeightOffset(), 0.0f, 0.0f, 0.0f);
+	cd::Vec4f tmpHeightOffset = cd::Vec4f(pSkyComponent->GetHeightOffset(), 0.0f, 0.0f, 0.0f);
 	GetRenderContext()->FillUniform(HeightOffsetCrc, &(tmpHeightOffset.x()), 1);
 
 	bgfx::setState(StateRendering);
@@ -179,52 +199,66 @@ bool PBRSkyRenderer::IsEnable() const
 	return SkyType::AtmosphericScattering == m_pCurrentSceneWorld->GetSkyComponent(m_pCurrentSceneWorld->GetSkyEntity())->GetSkyType();
 }
 
-void PBRSkyRenderer::Precompute() const
+void PBRSkyRenderer::BeginPrecompute(uint32_t version, uint16_t scatteringOrders)
 {
-	constexpr StringCrc NumScatteringOrdersCrc(NumScatteringOrders);
+	CreateDeltaTextures();
 
-	constexpr StringCrc ProgramComputeTransmittanceCrc(ProgramComputeTransmittance);
-	constexpr StringCrc ProgramComputeDirectIrradianceCrc(ProgramComputeDirectIrradiance);
-	constexpr StringCrc ProgramComputeSingleScatteringCrc(ProgramComputeSingleScattering);
-	constexpr StringCrc ProgramComputeScatteringDensityCrc(ProgramComputeScatteringDensity);
-	constexpr StringCrc ProgramComputeIndirectIrradianceCrc(ProgramComputeIndirectIrradiance);
-	constexpr StringCrc ProgramComputeMultipleScatteringCrc(ProgramComputeMultipleScattering);
+	m_precomputeStage = PrecomputeStage::Transmittance;
+	m_precomputeOrder = 2U;
+	m_precomputeScatteringOrders = scatteringOrders;
+	m_precomputeVersion = version;
+}
+
+void PBRSkyRenderer::ExecutePrecomputeStep()
+{
+	constexpr StringCrc NumScatteringOrdersCrc(NumScatteringOrders);
 
-	constexpr StringCrc TextureTransmittanceCrc(TextureTransmittance);
 	constexpr StringCrc TextureDeltaRayleighScatteringCrc(TextureDeltaRayleighScattering);
 	constexpr StringCrc TextureDeltaMieScatteringCrc(TextureDeltaMieScattering);
 	constexpr StringCrc TextureDeltaMultipleScatteringCrc(TextureDeltaMultipleScattering);
 	constexpr StringCrc TextureDeltaIrradianceCrc(TextureDeltaIrradiance);
 	constexpr StringCrc TextureDeltaScatteringDensityCrc(TextureDeltaScatteringDensity);
-	constexpr StringCrc TextureIrradianceCrc(TextureIrradiance);
-	constexpr StringCrc TextureScatteringCrc(TextureScattering);
+
+	const uint32_t backBufferIndex = GetBackBufferIndex();
+	const StringCrc TextureTransmittanceCrc(TextureTransmittance[backBufferIndex]);
+	const StringCrc TextureIrradianceCrc(TextureIrradiance[backBufferIndex]);
+	const StringCrc TextureScatteringCrc(TextureScattering[backBufferIndex]);
 
 	// In compute shader stage, use texture slot 15 - 9 to read and slot 0 -2 to write.
 	const bgfx::ViewId viewId = static_cast<bgfx::ViewId>(GetViewID());
 
-	// Compute Transmittance.
-	bgfx::setImage(0, GetRenderContext()->GetTexture(TextureTransmittanceCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
-	GetRenderContext()->Dispatch(viewId, ProgramComputeTransmittance, TRANSMITTANCE_TEXTURE_WIDTH / 8U, TRANSMITTANCE_TEXTURE_HEIGHT / 8U, 1U);
-
-	// Compute direct Irradiance.
-	bgfx::setImage(ATM_TRANSMITTANCE_SLOT, GetRenderContext()->GetTexture(TextureTransmittanceCrc), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
-	bgfx::setImage(0, GetRenderContext()->GetTexture(TextureDeltaIrradianceCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
-	bgfx::setImage(1, GetRenderContext()->GetTexture(TextureIrradianceCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
-	GetRenderContext()->Dispatch(viewId, ProgramComputeDirectIrradiance, IRRADIANCE_TEXTURE_WIDTH / 8U, IRRADIANCE_TEXTURE_HEIGHT / 8U, 1U);
-
-	// Compute single Scattering.
-	bgfx::setImage(ATM_TRANSMITTANCE_SLOT, GetRenderContext()->GetTexture(TextureTransmittanceCrc), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
-	bgfx::setImage(0, GetRenderContext()->GetTexture(TextureDeltaRayleighScatteringCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
-	bgfx::setImage(1, GetRenderContext()->GetTexture(TextureDeltaMieScatteringCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
-	bgfx::setImage(2, GetRenderContext()->GetTexture(TextureScatteringCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
-	GetRenderContext()->Dispatch(viewId, ProgramComputeSingleScattering, SCATTERING_TEXTURE_WIDTH / 8U, SCATTERING_TEXTURE_HEIGHT / 8U, SCATTERING_TEXTURE_DEPTH / 8U);
-
-	// Compute multiple Scattering.
 	cd::Vec4f tmpOrder;
-	for (uint16_t order = 2; order <= ScatteringOrders; ++order)
+	switch (m_precomputeStage)
+	{
+	case PrecomputeStage::Transmittance:
+	{
+		bgfx::setImage(0, GetRenderContext()->GetTexture(TextureTransmittanceCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
+		GetRenderContext()->Dispatch(viewId, ProgramComputeTransmittance, TRANSMITTANCE_TEXTURE_WIDTH / 8U, TRANSMITTANCE_TEXTURE_HEIGHT / 8U, 1U);
+		m_precomputeStage = PrecomputeStage::DirectIrradiance;
+		break;
+	}
+	case PrecomputeStage::DirectIrradiance:
+	{
+		bgfx::setImage(ATM_TRANSMITTANCE_SLOT, GetRenderContext()->GetTexture(TextureTransmittanceCrc), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
+		bgfx::setImage(0, GetRenderContext()->GetTexture(TextureDeltaIrradianceCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
+		bgfx::setImage(1, GetRenderContext()->GetTexture(TextureIrradianceCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
+		GetRenderContext()->Dispatch(viewId, ProgramComputeDirectIrradiance, IRRADIANCE_TEXTURE_WIDTH / 8U, IRRADIANCE_TEXTURE_HEIGHT / 8U, 1U);
+		m_precomputeStage = PrecomputeStage::SingleScattering;
+		break;
+	}
+	case PrecomputeStage::SingleScattering:
+	{
+		bgfx::setImage(ATM_TRANSMITTANCE_SLOT, GetRenderContext()->GetTexture(TextureTransmittanceCrc), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
+		bgfx::setImage(0, GetRenderContext()->GetTexture(TextureDeltaRayleighScatteringCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
+		bgfx::setImage(1, GetRenderContext()->GetTexture(TextureDeltaMieScatteringCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
+		bgfx::setImage(2, GetRenderContext()->GetTexture(TextureScatteringCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
+		GetRenderContext()->Dispatch(viewId, ProgramComputeSingleScattering, SCATTERING_TEXTURE_WIDTH / 8U, SCATTERING_TEXTURE_HEIGHT / 8U, SCATTERING_TEXTURE_DEPTH / 8U);
+		m_precomputeStage = m_precomputeOrder <= m_precomputeScatteringOrders ? PrecomputeStage::ScatteringDensity : PrecomputeStage::Idle;
+		break;
+	}
+	case PrecomputeStage::ScatteringDensity:
 	{
-		// 1. Compute Scattering Density.
-		tmpOrder.x() = static_cast<float>(order);
+		tmpOrder.x() = static_cast<float>(m_precomputeOrder);
 		bgfx::setUniform(GetRenderContext()->GetUniform(NumScatteringOrdersCrc), &(tmpOrder.x()), 1);
 
 		bgfx::setImage(ATM_TRANSMITTANCE_SLOT, GetRenderContext()->GetTexture(TextureTransmittanceCrc), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
@@ -234,9 +268,12 @@ void PBRSkyRenderer::Precompute() const
 		bgfx::setImage(ATM_IRRADIANCE_SLOT, GetRenderContext()->GetTexture(TextureDeltaIrradianceCrc), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
 		bgfx::setImage(0, GetRenderContext()->GetTexture(TextureDeltaScatteringDensityCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
 		GetRenderContext()->Dispatch(viewId, ProgramComputeScatteringDensity, SCATTERING_TEXTURE_WIDTH / 8U, SCATTERING_TEXTURE_HEIGHT / 8U, SCATTERING_TEXTURE_DEPTH / 8U);
-
-		// 2. Compute indirect Irradiance.
-		tmpOrder.x() = static_cast<float>(order - 1);
+		m_precomputeStage = PrecomputeStage::IndirectIrradiance;
+		break;
+	}
+	case PrecomputeStage::IndirectIrradiance:
+	{
+		tmpOrder.x() = static_cast<float>(m_precomputeOrder - 1);
 		bgfx::setUniform(GetRenderContext()->GetUniform(NumScatteringOrdersCrc), &(tmpOrder.x()), 1);
 
 		bgfx::setImage(ATM_SINGLE_RAYLEIGH_SCATTERING_SLOT, GetRenderContext()->GetTexture(TextureDeltaRayleighScatteringCrc), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
@@ -245,28 +282,51 @@ void PBRSkyRenderer::Precompute() const
 		bgfx::setImage(0, GetRenderContext()->GetTexture(TextureDeltaIrradianceCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
 		bgfx::setImage(1, GetRenderContext()->GetTexture(TextureIrradianceCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
 		GetRenderContext()->Dispatch(viewId, ProgramComputeIndirectIrradiance, IRRADIANCE_TEXTURE_WIDTH / 8U, IRRADIANCE_TEXTURE_HEIGHT / 8U, 1U);
-
-		// 3. Compute multiple Scattering.
+		m_precomputeStage = PrecomputeStage::MultipleScattering;
+		break;
+	}
+	case PrecomputeStage::MultipleScattering:
+	{
 		bgfx::setImage(ATM_TRANSMITTANCE_SLOT, GetRenderContext()->GetTexture(TextureTransmittanceCrc), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
 		bgfx::setImage(ATM_SCATTERING_DENSITY, GetRenderContext()->GetTexture(TextureDeltaScatteringDensityCrc), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
 		bgfx::setImage(0, GetRenderContext()->GetTexture(TextureDeltaMultipleScatteringCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
 		bgfx::setImage(1, GetRenderContext()->GetTexture(TextureScatteringCrc), 0, bgfx::Access::Write, bgfx::TextureFormat::RGBA32F);
 		GetRenderContext()->Dispatch(viewId, ProgramComputeMultipleScattering, SCATTERING_TEXTURE_WIDTH / 8U, SCATTERING_TEXTURE_HEIGHT / 8U, SCATTERING_TEXTURE_DEPTH / 8U);
+
+		++m_precomputeOrder;
+		m_precomputeStage = m_precomputeOrder <= m_precomputeScatteringOrders ? PrecomputeStage::ScatteringDensity : PrecomputeStage::Idle;
+		break;
 	}
+	default:
+		break;
+	}
+
+	if (PrecomputeStage::Idle == m_precomputeStage)
+	{
+		FinishPrecompute();
+	}
+}
 
+void PBRSkyRenderer::FinishPrecompute()
+{
 	CD_ENGINE_TRACE("All compute shaders for precomputing atmospheric scattering texture dispatched.");
-	CD_ENGINE_INFO("Atmospheric scattering orders : {0}", ScatteringOrders);
-	
+	CD_ENGINE_INFO("Atmospheric scattering orders : {0}", m_precomputeScatteringOrders);
+
+	// Swap LUTs. bgfx executes views in order so that the sky pass of this frame already reads the new LUTs.
+	m_frontBufferIndex = GetBackBufferIndex();
+	m_hasValidLUT = true;
+	m_builtVersion = m_precomputeVersion;
+
 	auto skyComponent = m_pCurrentSceneWorld->GetSkyComponent(m_pCurrentSceneWorld->GetSkyEntity());
-	skyComponent->SetATMTransmittanceCrc(TextureTransmittanceCrc);
-	skyComponent->SetATMIrradianceCrc(TextureIrradianceCrc);
-	skyComponent->SetATMScatteringCrc(TextureScatteringCrc);
-
-	GetRenderContext()->DestoryTexture(TextureDeltaIrradianceCrc);
-	GetRenderContext()->DestoryTexture(TextureDeltaRayleighScatteringCrc);
-	GetRenderContext()->DestoryTexture(TextureDeltaMieScatteringCrc);
-	GetRenderContext()->DestoryTexture(TextureDeltaScatteringDensityCrc);
-	GetRenderContext()->DestoryTexture(TextureDeltaMultipleScatteringCrc);
+	skyComponent->SetATMTransmittanceCrc(StringCrc(TextureTransmittance[m_frontBufferIndex]));
+	skyComponent->SetATMIrradianceCrc(StringCrc(TextureIrradiance[m_frontBufferIndex]));
+	skyComponent->SetATMScatteringCrc(StringCrc(TextureScattering[m_frontBufferIndex]));
+
+	GetRenderContext()->DestoryTexture(StringCrc(TextureDeltaIrradiance));
+	GetRenderContext()->DestoryTexture(StringCrc(TextureDeltaRayleighScattering));
+	GetRenderContext()->DestoryTexture(StringCrc(TextureDeltaMieScattering));
+	GetRenderContext()->DestoryTexture(StringCrc(TextureDeltaScatteringDensity));
+	GetRenderContext()->DestoryTexture(StringCrc(TextureDeltaMultipleScattering));
 }
 
 }
\ No newline at end of file
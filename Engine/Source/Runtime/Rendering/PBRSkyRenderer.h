@@ -4,6 +4,8 @@
 
 #include "Core/StringCrc.h"
 
+#include <cstdint>
+
 namespace engine
 {
 
@@ -22,12 +24,41 @@ public:
 	
 	void SetSceneWorld(SceneWorld* pSceneWorld) { m_pCurrentSceneWorld = pSceneWorld; }
 
+	// Max compute dispatches per frame used by precompute when valid LUTs already exist.
+	void SetPrecomputeDispatchBudget(uint32_t budget) { m_precomputeDispatchBudget = budget; }
+	uint32_t GetPrecomputeDispatchBudget() const { return m_precomputeDispatchBudget; }
+	bool IsPrecomputing() const { return PrecomputeStage::Idle != m_precomputeStage; }
+
 private:
-	void Precompute() const;
+	enum class PrecomputeStage : uint8_t
+	{
+		Idle,
+		Transmittance,
+		DirectIrradiance,
+		SingleScattering,
+		ScatteringDensity,
+		IndirectIrradiance,
+		MultipleScattering,
+	};
+
+	// Precompute writes into the back LUTs step by step so that the front LUTs keep rendering without hitch.
+	void BeginPrecompute(uint32_t version, uint16_t scatteringOrders);
+	void ExecutePrecomputeStep();
+	void FinishPrecompute();
+	uint32_t GetBackBufferIndex() const { return m_hasValidLUT ? 1U - m_frontBufferIndex : m_frontBufferIndex; }
 
 private:
-	bool m_isPrecomputed = false;
 	SceneWorld* m_pCurrentSceneWorld = nullptr;
+
+	PrecomputeStage m_precomputeStage = PrecomputeStage::Idle;
+	uint16_t m_precomputeOrder = 2U;
+	uint16_t m_precomputeScatteringOrders = 0U;
+	uint32_t m_precomputeVersion = 0U;
+	uint32_t m_builtVersion = 0U;
+	uint32_t m_precomputeDispatchBudget = 2U;
+
+	uint32_t m_frontBufferIndex = 0U;
+	bool m_hasValidLUT = false;
 };
 
 }
\ No newline at end of file
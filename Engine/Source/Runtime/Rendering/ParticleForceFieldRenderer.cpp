@@ -2,8 +2,8 @@
 
 #include "ECWorld/CameraComponent.h"
 #include "ECWorld/SceneWorld.h"
-#include "ECWorld/TransformComponent.h"
 #include "Rendering/RenderContext.h"
+#include "Rendering/RenderSnapshot.h"
 
 namespace engine
 {
@@ -13,7 +13,7 @@ void ParticleForceFieldRenderer::Init()
 	constexpr StringCrc programCrc = StringCrc("ParticleForceFieldProgram");
 	GetRenderContext()->RegisterShaderProgram(programCrc, { "vs_particleforcefield", "fs_particleforcefield" });
 
-	bgfx::setViewName(GetViewID(), "ParticleForceFieldRenderer");
+	SetName("ParticleForceFieldRenderer");
 }
 
 void ParticleForceFieldRenderer::Warmup()
@@ -29,12 +29,12 @@ void ParticleForceFieldRenderer::UpdateView(const float* pViewMatrix, const floa
 
 void ParticleForceFieldRenderer::Render(float deltaTime)
 {
+	const RenderSnapshot* pSnapshot = GetRenderContext()->GetRenderSnapshot();
 	for (Entity entity : m_pCurrentSceneWorld->GetParticleForceFieldEntities())
 	{
-		if (auto* pTransformComponent = m_pCurrentSceneWorld->GetTransformComponent(entity))
+		if (const RenderSnapshotTransform* pTransform = pSnapshot->FindTransform(entity))
 		{
-			pTransformComponent->Build();
-			bgfx::setTransform(pTransformComponent->GetWorldMatrix().begin());
+			bgfx::setTransform(pTransform->worldMatrix.begin());
 		}
 		auto* pParticleForceFieldComponent = m_pCurrentSceneWorld->GetParticleForceFieldComponent(entity);
 		bgfx::setVertexBuffer(0, bgfx::VertexBufferHandle{ pParticleForceFieldComponent->GetVertexBufferHandle() });
@@ -3,8 +3,8 @@
 #include "ECWorld/CameraComponent.h"
 #include "ECWorld/SceneWorld.h"
 #include "ECWorld/ParticleForceFieldComponent.h"
-#include "ECWorld/TransformComponent.h"
 #include "Rendering/RenderContext.h"
+#include "Rendering/RenderSnapshot.h"
 
 namespace engine {
 
@@ -36,7 +36,7 @@ void ParticleRenderer::Init()
 	GetRenderContext()->RegisterShaderProgram(ParticleEmitterShapeProgramCrc, {"vs_particleEmitterShape", "fs_particleEmitterShape"});
 	GetRenderContext()->RegisterShaderProgram(WO_BillboardParticleProgramCrc, { "vs_wo_billboardparticle","fs_wo_billboardparticle" });
 
-	bgfx::setViewName(GetViewID(), "ParticleRenderer");
+	SetName("ParticleRenderer");
 }
 
 void ParticleRenderer::Warmup()
@@ -62,23 +62,34 @@ void ParticleRenderer::UpdateView(const float* pViewMatrix, const float* pProjec
 
 void ParticleRenderer::Render(float deltaTime)
 {
+	const RenderSnapshot* pSnapshot = GetRenderContext()->GetRenderSnapshot();
 	for (Entity entity : m_pCurrentSceneWorld->GetParticleForceFieldEntities())
 	{
+		const RenderSnapshotTransform* pForcefieldTransform = pSnapshot->FindTransform(entity);
+		if (!pForcefieldTransform)
+		{
+			continue;
+		}
+
 		ParticleForceFieldComponent* pForceFieldComponent = m_pCurrentSceneWorld->GetParticleForceFieldComponent(entity);
-		const cd::Transform& forcefieldTransform = m_pCurrentSceneWorld->GetTransformComponent(entity)->GetTransform();
+		const cd::Transform& forcefieldTransform = pForcefieldTransform->transform;
 		SetForceFieldRotationForce(pForceFieldComponent);
 		SetForceFieldRange(pForceFieldComponent,  forcefieldTransform.GetScale());
 	}
 
-	Entity pMainCameraEntity = m_pCurrentSceneWorld->GetMainCameraEntity();
+	const cd::Vec3f& cameraPosition = pSnapshot->GetCamera().position;
 	for (Entity entity : m_pCurrentSceneWorld->GetParticleEmitterEntities())
 	{
-		const cd::Transform& particleTransform = m_pCurrentSceneWorld->GetTransformComponent(entity)->GetTransform();
-		const cd::Quaternion& particleRotation = m_pCurrentSceneWorld->GetTransformComponent(entity)->GetTransform().GetRotation();
+		const RenderSnapshotTransform* pParticleTransform = pSnapshot->FindTransform(entity);
+		if (!pParticleTransform)
+		{
+			continue;
+		}
+
+		const cd::Transform& particleTransform = pParticleTransform->transform;
+		const cd::Quaternion& particleRotation = particleTransform.GetRotation();
 		ParticleEmitterComponent* pEmitterComponent = m_pCurrentSceneWorld->GetParticleEmitterComponent(entity);
 		
-		const cd::Transform& pMainCameraTransform = m_pCurrentSceneWorld->GetTransformComponent(pMainCameraEntity)->GetTransform();
-		//const cd::Quaternion& cameraRotation = pMainCameraTransform.GetRotation();
 		//Not include particle attribute
 		pEmitterComponent->GetParticlePool().SetParticleMaxCount(pEmitterComponent->GetSpawnCount());
 		pEmitterComponent->GetParticlePool().AllParticlesReset();
@@ -194,7 +205,7 @@ void ParticleRenderer::Render(float deltaTime)
 				else if (pEmitterComponent->GetRenderMode() == engine::ParticleRenderMode::Billboard)
 				{
 					auto up = particleTransform.GetRotation().ToMatrix3x3() * cd::Vec3f(0, 1, 0);
-					auto vec =  pMainCameraTransform.GetTranslation() - pEmitterComponent->GetParticlePool().GetParticle(ii).GetPos();
+					auto vec =  cameraPosition - pEmitterComponent->GetParticlePool().GetParticle(ii).GetPos();
 					auto right = up.Cross(vec);
 					float yaw = atan2f(right.z(), right.x());
 					float pitch = atan2f(vec.y(), sqrtf(vec.x() * vec.x() + vec.z() * vec.z())); 
@@ -231,7 +242,7 @@ void ParticleRenderer::Render(float deltaTime)
 		//bgfx::update(bgfx::DynamicIndexBufferHandle{pEmitterComponent->GetEmitterShapeIndexBufferHandle()}, 0, pParticleIndexBuffer);
 		constexpr StringCrc emitShapeRangeCrc(shapeRange);
 		bgfx::setUniform(GetRenderContext()->GetUniform(emitShapeRangeCrc), &pEmitterComponent->GetEmitterShapeRange(), 1);
-		bgfx::setTransform(m_pCurrentSceneWorld->GetTransformComponent(entity)->GetWorldMatrix().begin());
+		bgfx::setTransform(pParticleTransform->worldMatrix.begin());
 		bgfx::setVertexBuffer(1, bgfx::VertexBufferHandle{ pEmitterComponent->GetEmitterShapeVertexBufferHandle() });
 		bgfx::setIndexBuffer(bgfx::IndexBufferHandle{ pEmitterComponent->GetEmitterShapeIndexBufferHandle() });
 		bgfx::setState(state_lines);
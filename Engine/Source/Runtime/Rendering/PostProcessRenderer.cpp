@@ -17,7 +17,7 @@ void PostProcessRenderer::Init()
 {
 	GetRenderContext()->RegisterShaderProgram(PostProcessProgramCrc, { "vs_fullscreen", "fs_PBR_postProcessing" });
 
-	bgfx::setViewName(GetViewID(), "PostProcessRenderer");
+	SetName("PostProcessRenderer");
 }
 
 void PostProcessRenderer::Warmup()
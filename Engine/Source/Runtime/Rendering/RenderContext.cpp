@@ -1,9 +1,13 @@
 #include "RenderContext.h"
 
 #include "Base/Template.h"
+#include "Core/Memory/ScratchArena.h"
+#include "Core/Memory/TrackedBxAllocator.h"
 #include "Log/Log.h"
 #include "Path/Path.h"
+#include "Profiling/Profiling.h"
 #include "Renderer.h"
+#include "Rendering/DebugDraw.h"
 #include "Rendering/ShaderCollections.h"
 #include "Rendering/ShaderType.h"
 #include "Rendering/Utility/VertexLayoutUtility.h"
@@ -15,6 +19,7 @@
 #include <bx/allocator.h>
 
 #include <cassert>
+#include <cstring>
 //#include <format>
 #include <fstream>
 #include <memory>
@@ -24,7 +29,14 @@ namespace
 
 static bx::AllocatorI* GetResourceAllocator()
 {
-	static bx::DefaultAllocator s_allocator;
+	static engine::TrackedBxAllocator s_allocator(engine::MemoryTag::Texture);
+	return &s_allocator;
+}
+
+// bgfx keeps using its allocator until shutdown so it must outlive RenderContext.
+static bx::AllocatorI* GetBgfxAllocator()
+{
+	static engine::TrackedBxAllocator s_allocator(engine::MemoryTag::Bgfx);
 	return &s_allocator;
 }
 
@@ -35,6 +47,17 @@ static void imageReleaseCb(void* _ptr, void* _userData)
 	bimg::imageFree(imageContainer);
 }
 
+// Programs and shader variants are keyed by name + features combine.
+// Concatenate in scratch memory as lookups happen per draw call.
+engine::StringCrc GetCombinedNameCrc(std::string_view name, std::string_view featuresCombine)
+{
+	engine::ScratchScope scratchScope;
+	char* pFullName = scratchScope.AllocateArray<char>(name.size() + featuresCombine.size());
+	std::memcpy(pFullName, name.data(), name.size());
+	std::memcpy(pFullName + name.size(), featuresCombine.data(), featuresCombine.size());
+	return engine::StringCrc{ pFullName, name.size() + featuresCombine.size() };
+}
+
 std::tuple<std::string_view, std::string_view, std::string_view> IdentifyShaderTypes(const std::set<std::string>& shaders)
 {
 	assert(shaders.size() <= 2);
@@ -63,6 +86,37 @@ std::tuple<std::string_view, std::string_view, std::string_view> IdentifyShaderT
 	return shadersTuple;
 }
 
+// Caches own one reference of the handle. Replacing or erasing a name releases its old handle.
+template<typename T>
+void SetCachedHandle(engine::GPUResourceRegistry& registry, std::unordered_map<engine::StringCrc, engine::GPUHandle<T>>& caches, engine::StringCrc nameCrc, T bgfxHandle)
+{
+	engine::GPUHandle<T> handle = registry.Register(bgfxHandle);
+	auto itCache = caches.find(nameCrc);
+	if (itCache != caches.end())
+	{
+		registry.Release(itCache->second);
+	}
+	caches[nameCrc] = handle;
+}
+
+template<typename T>
+T GetCachedHandle(const engine::GPUResourceRegistry& registry, const std::unordered_map<engine::StringCrc, engine::GPUHandle<T>>& caches, engine::StringCrc nameCrc)
+{
+	auto itCache = caches.find(nameCrc);
+	return itCache != caches.end() ? registry.Get(itCache->second) : T{ bgfx::kInvalidHandle };
+}
+
+template<typename T>
+void ReleaseCachedHandle(engine::GPUResourceRegistry& registry, std::unordered_map<engine::StringCrc, engine::GPUHandle<T>>& caches, engine::StringCrc nameCrc)
+{
+	auto itCache = caches.find(nameCrc);
+	if (itCache != caches.end())
+	{
+		registry.Release(itCache->second);
+		caches.erase(itCache);
+	}
+}
+
 }
 
 namespace engine
@@ -70,6 +124,9 @@ namespace engine
 
 RenderContext::~RenderContext()
 {
+	// Resources still referenced or waiting for deferred destruction must go before bgfx.
+	m_pEncoderWorkerPool.reset();
+	m_pGPUResourceRegistry.reset();
 	bgfx::shutdown();
 }
 
@@ -117,34 +174,29 @@ void RenderContext::Init(GraphicsBackend backend, void* hwnd)
 	}
 
 	initDesc.platformData.nwh = hwnd;
+	initDesc.allocator = GetBgfxAllocator();
 	bgfx::init(initDesc);
+
+	m_pGPUResourceRegistry = std::make_unique<GPUResourceRegistry>();
+	m_pEncoderWorkerPool = std::make_unique<EncoderWorkerPool>();
+	m_pFrameAllocator = std::make_unique<FrameAllocator>();
+	m_pDebugDraw = std::make_unique<DebugDraw>();
 }
 
 void RenderContext::Shutdown()
 {
-	for (auto it : m_shaderHandles)
-	{
-		bgfx::destroy(bgfx::ShaderHandle{ it.second });
-	}
+	m_pDebugDraw.reset();
 
-	for (auto it : m_shaderProgramHandles)
-	{
-		bgfx::destroy(bgfx::ProgramHandle{ it.second });
-	}
-	
-	for (auto it : m_textureHandleCaches)
-	{
-		bgfx::destroy(bgfx::TextureHandle{ it.second });
-	}
-
-	for (auto it : m_uniformHandleCaches)
-	{
-		bgfx::destroy(bgfx::UniformHandle{ it.second });
-	}
+	m_shaderHandles.clear();
+	m_shaderProgramHandles.clear();
+	m_textureHandleCaches.clear();
+	m_uniformHandleCaches.clear();
+	m_pGPUResourceRegistry->DestroyAll();
 }
 
 void RenderContext::BeginFrame()
 {
+	m_pFrameAllocator->BeginFrame();
 }
 
 void RenderContext::Submit(uint16_t viewID, const std::string& programName, const std::string& featuresCombine)
@@ -153,17 +205,84 @@ void RenderContext::Submit(uint16_t viewID, const std::string& programName, cons
 	bgfx::submit(viewID, GetShaderProgramHandle(programName, featuresCombine));
 }
 
+void RenderContext::Submit(bgfx::Encoder* pEncoder, uint16_t viewID, const std::string& programName, const std::string& featuresCombine)
+{
+	assert(bgfx::isValid(GetShaderProgramHandle(programName, featuresCombine)));
+	pEncoder->submit(viewID, GetShaderProgramHandle(programName, featuresCombine));
+}
+
 void RenderContext::Dispatch(uint16_t viewID, const std::string& programName, uint32_t numX, uint32_t numY, uint32_t numZ)
 {
 	assert(bgfx::isValid(GetShaderProgramHandle(programName)));
 	bgfx::dispatch(viewID, GetShaderProgramHandle(programName), numX, numY, numZ);
 }
 
+void RenderContext::AddMeshLodStats(uint32_t submittedTriangleCount, uint32_t savedTriangleCount)
+{
+	m_submittedTriangleCount.fetch_add(submittedTriangleCount, std::memory_order_relaxed);
+	m_savedTriangleCount.fetch_add(savedTriangleCount, std::memory_order_relaxed);
+}
+
 void RenderContext::EndFrame()
 {
+	// Debug geometry which is not flushed by any renderer this frame is dropped.
+	m_pDebugDraw->Clear();
+
+	m_lastFrameMeshLodStats.submittedTriangleCount = m_submittedTriangleCount.exchange(0U);
+	m_lastFrameMeshLodStats.savedTriangleCount = m_savedTriangleCount.exchange(0U);
+
+	// Destroy resources released at least DestroyLatencyFrameCount frames ago.
+	m_pGPUResourceRegistry->Update();
+
 	// Advance to next frame. Rendering thread will be kicked to
 	// process submitted rendering primitives.
-	bgfx::frame();
+	{
+		CD_PROFILE_SCOPE("bgfx::frame");
+		bgfx::frame();
+	}
+
+	CD_PROFILE_COUNTER("Submitted triangles", m_lastFrameMeshLodStats.submittedTriangleCount);
+	CD_PROFILE_COUNTER("Saved triangles", m_lastFrameMeshLodStats.savedTriangleCount);
+
+	const bgfx::Stats* pStats = bgfx::getStats();
+	CD_PROFILE_COUNTER("Draw calls", pStats->numDraw);
+	CD_PROFILE_COUNTER("Frame arena bytes", m_pFrameAllocator->GetArena().GetUsedSize());
+	if (m_isGPUProfileEnable && pStats->gpuTimerFreq > 0)
+	{
+		// Stats describe the frame which bgfx just finished. GPU clock is not synchronized with CPU clock
+		// so GPU zones are placed to end at current time on CPU timeline.
+		ProfileRecorder& recorder = ProfileRecorder::Get();
+		uint64_t frameEndTime = ProfileRecorder::GetTimestamp();
+		double toNanoseconds = 1000000000.0 / static_cast<double>(pStats->gpuTimerFreq);
+		for (uint16_t viewIndex = 0; viewIndex < pStats->numViews; ++viewIndex)
+		{
+			const bgfx::ViewStats& viewStats = pStats->viewStats[viewIndex];
+			if (viewStats.gpuTimeEnd <= viewStats.gpuTimeBegin || viewStats.gpuTimeEnd > pStats->gpuTimeEnd)
+			{
+				continue;
+			}
+
+			auto beginOffset = static_cast<uint64_t>(static_cast<double>(pStats->gpuTimeEnd - viewStats.gpuTimeBegin) * toNanoseconds);
+			auto endOffset = static_cast<uint64_t>(static_cast<double>(pStats->gpuTimeEnd - viewStats.gpuTimeEnd) * toNanoseconds);
+			// Views are renamed when renderers are created again after resetting view count.
+			const char* pZoneName = viewStats.view < MaxViewCount ? m_gpuZoneNames[viewStats.view] : nullptr;
+			if (!pZoneName || 0 != std::strcmp(pZoneName, viewStats.name))
+			{
+				pZoneName = recorder.InternName(viewStats.name);
+				if (viewStats.view < MaxViewCount)
+				{
+					m_gpuZoneNames[viewStats.view] = pZoneName;
+				}
+			}
+			recorder.RecordGPUZone(pZoneName, frameEndTime - beginOffset, frameEndTime - endOffset);
+		}
+	}
+}
+
+void RenderContext::SetGPUProfileEnable(bool enable)
+{
+	m_isGPUProfileEnable = enable;
+	bgfx::setDebug(enable ? BGFX_DEBUG_PROFILER : BGFX_DEBUG_NONE);
 }
 
 void RenderContext::OnResize(uint16_t width, uint16_t height)
@@ -193,7 +312,7 @@ bool RenderContext::CheckShaderProgram(Entity entity, const std::string& program
 {
 	assert(m_pShaderCollections->IsProgramValid(StringCrc{ programName }));
 
-	if (m_shaderProgramHandles.find(StringCrc{ programName + featuresCombine }) == m_shaderProgramHandles.end())
+	if (m_shaderProgramHandles.find(GetCombinedNameCrc(programName, featuresCombine)) == m_shaderProgramHandles.end())
 	{
 		// It only represents that we do not hold the shader program GPU handle, 
 		// whether the shader is compiled or not is unknown.
@@ -261,11 +380,11 @@ void RenderContext::UploadShaderProgram(const std::string& programName, const st
 
 void RenderContext::DestroyShaderProgram(const std::string& programName, const std::string& featuresCombine)
 {
-	DestoryProgram(StringCrc{ programName + featuresCombine });
+	DestoryProgram(GetCombinedNameCrc(programName, featuresCombine));
 
 	auto [vsName, fsName, csName] = IdentifyShaderTypes(m_pShaderCollections->GetShaders(StringCrc{ programName }));
 	StringCrc vsCrc{ vsName.data() };
-	StringCrc fsCrc{ fsName.data() + featuresCombine };
+	StringCrc fsCrc = GetCombinedNameCrc(fsName, featuresCombine);
 	StringCrc csCrc{ csName.data() };
 
 	DestoryShader(vsCrc);
@@ -333,6 +452,7 @@ const RenderContext::ShaderBlob& RenderContext::AddShaderBlob(StringCrc shaderNa
 	{
 		return *(it->second);
 	}
+	m_shaderBlobMemory.Set(m_shaderBlobMemory.Get() + blob.capacity());
 	m_shaderBlobs[shaderNameCrc] = std::make_unique<ShaderBlob>(cd::MoveTemp(blob));
 	return *m_shaderBlobs.at(shaderNameCrc);
 }
@@ -350,18 +470,12 @@ bool RenderContext::IsShaderProgramValid(const std::string& programName, const s
 
 void RenderContext::SetShaderProgramHandle(const std::string& programName, bgfx::ProgramHandle handle, const std::string& featuresCombine)
 {
-	m_shaderProgramHandles[StringCrc{ programName + featuresCombine }] = handle.idx;
+	SetCachedHandle(*m_pGPUResourceRegistry, m_shaderProgramHandles, GetCombinedNameCrc(programName, featuresCombine), handle);
 }
 
 bgfx::ProgramHandle RenderContext::GetShaderProgramHandle(const std::string& programName, const std::string& featuresCombine) const
 {
-	const auto& it = m_shaderProgramHandles.find(StringCrc{ programName + featuresCombine });
-	if (it != m_shaderProgramHandles.end())
-	{
-		return { it->second };
-	}
-
-	return { bgfx::kInvalidHandle };
+	return GetCachedHandle(*m_pGPUResourceRegistry, m_shaderProgramHandles, GetCombinedNameCrc(programName, featuresCombine));
 }
 
 RenderTarget* RenderContext::CreateRenderTarget(StringCrc resourceCrc, uint16_t width, uint16_t height, std::vector<AttachmentDescriptor> attachmentDescs)
@@ -390,11 +504,11 @@ RenderTarget* RenderContext::CreateRenderTarget(StringCrc resourceCrc, std::uniq
 
 bgfx::ShaderHandle RenderContext::CreateShader(const char* pShaderName, const std::string& combine)
 {
-	StringCrc shaderNameCrc{ pShaderName + combine };
+	StringCrc shaderNameCrc = GetCombinedNameCrc(pShaderName, combine);
 	auto itShaderCache = m_shaderHandles.find(shaderNameCrc);
 	if(itShaderCache != m_shaderHandles.end())
 	{
-		return { itShaderCache->second };
+		return m_pGPUResourceRegistry->Get(itShaderCache->second);
 	}
 
 	std::string shaderFileFullPath = Path::GetShaderOutputPath(pShaderName, combine);
@@ -404,7 +518,7 @@ bgfx::ShaderHandle RenderContext::CreateShader(const char* pShaderName, const st
 	if(bgfx::isValid(shaderHandle))
 	{
 		bgfx::setName(shaderHandle, pShaderName);
-		m_shaderHandles[shaderNameCrc] = shaderHandle.idx;
+		SetCachedHandle(*m_pGPUResourceRegistry, m_shaderHandles, shaderNameCrc, shaderHandle);
 	}
 
 	return shaderHandle;
@@ -416,13 +530,13 @@ bgfx::ProgramHandle RenderContext::CreateProgram(const std::string& programName,
 	auto itProgram = m_shaderProgramHandles.find(programNameCrc);
 	if (itProgram != m_shaderProgramHandles.end())
 	{
-		return { itProgram->second };
+		return m_pGPUResourceRegistry->Get(itProgram->second);
 	}
 
 	bgfx::ProgramHandle programHandle = bgfx::createProgram(CreateShader(csName.c_str()));
 	if (bgfx::isValid(programHandle))
 	{
-		m_shaderProgramHandles[programNameCrc] = programHandle.idx;
+		SetCachedHandle(*m_pGPUResourceRegistry, m_shaderProgramHandles, programNameCrc, programHandle);
 	}
 
 	return programHandle;
@@ -430,12 +544,12 @@ bgfx::ProgramHandle RenderContext::CreateProgram(const std::string& programName,
 
 bgfx::ProgramHandle RenderContext::CreateProgram(const std::string& programName, const std::string& vsName, const std::string& fsName, const std::string& featuresCombine)
 {
-	StringCrc fullProgramNameCrc = StringCrc{ programName + featuresCombine };
+	StringCrc fullProgramNameCrc = GetCombinedNameCrc(programName, featuresCombine);
 
 	const auto& it = m_shaderProgramHandles.find(fullProgramNameCrc);
 	if (it != m_shaderProgramHandles.end())
 	{
-		return { it->second };
+		return m_pGPUResourceRegistry->Get(it->second);
 	}
 
 	// BGFX will return a valid ProgramHandle with valid VSHandle and invalid FSHandle.
@@ -450,14 +564,14 @@ bgfx::ProgramHandle RenderContext::CreateProgram(const std::string& programName,
 	bgfx::ShaderHandle fsHandle = CreateShader(fsName.c_str(), featuresCombine);
 	if (!bgfx::isValid(fsHandle))
 	{
-		DestoryShader(StringCrc{ fsName + featuresCombine });
+		DestoryShader(GetCombinedNameCrc(fsName, featuresCombine));
 		return bgfx::ProgramHandle{ bgfx::kInvalidHandle };
 	}
 	
 	bgfx::ProgramHandle programHandle = bgfx::createProgram(vsHandle, fsHandle);
 	if (bgfx::isValid(programHandle))
 	{
-		m_shaderProgramHandles[fullProgramNameCrc] = programHandle.idx;
+		SetCachedHandle(*m_pGPUResourceRegistry, m_shaderProgramHandles, fullProgramNameCrc, programHandle);
 	}
 
 	return programHandle;
@@ -469,7 +583,7 @@ bgfx::TextureHandle RenderContext::CreateTexture(const char* pFilePath, uint64_t
 	auto itTextureCache = m_textureHandleCaches.find(filePathCrc);
 	if (itTextureCache != m_textureHandleCaches.end())
 	{
-		return { itTextureCache->second };
+		return m_pGPUResourceRegistry->Get(itTextureCache->second);
 	}
 
 	//std::string textureFileFullPath = std::format("{}{}", CDPROJECT_RESOURCES_ROOT_PATH, pShaderName);
@@ -539,7 +653,7 @@ bgfx::TextureHandle RenderContext::CreateTexture(const char* pFilePath, uint64_t
 	if (bgfx::isValid(handle))
 	{
 		bgfx::setName(handle, pFilePath);
-		m_textureHandleCaches[filePathCrc] = handle.idx;
+		SetCachedHandle(*m_pGPUResourceRegistry, m_textureHandleCaches, filePathCrc, handle);
 	}
 
 	return handle;
@@ -551,7 +665,7 @@ bgfx::TextureHandle RenderContext::CreateTexture(const char* pName, uint16_t wid
 	auto itTextureCache = m_textureHandleCaches.find(textureNameCrc);
 	if(itTextureCache != m_textureHandleCaches.end())
 	{
-		return { itTextureCache->second };
+		return m_pGPUResourceRegistry->Get(itTextureCache->second);
 	}
 
 	const bgfx::Memory* mem = nullptr;
@@ -574,7 +688,7 @@ bgfx::TextureHandle RenderContext::CreateTexture(const char* pName, uint16_t wid
 	if(bgfx::isValid(texture))
 	{
 		bgfx::setName(texture, pName);
-		m_textureHandleCaches[textureNameCrc] = texture.idx;
+		SetCachedHandle(*m_pGPUResourceRegistry, m_textureHandleCaches, textureNameCrc, texture);
 	}
 	else
 	{
@@ -584,7 +698,7 @@ bgfx::TextureHandle RenderContext::CreateTexture(const char* pName, uint16_t wid
 	return texture;
 }
 
-bgfx::TextureHandle RenderContext::UpdateTexture(const char* pName, uint16_t layer, uint8_t mip, uint16_t x, uint16_t y, uint16_t z, uint16_t width, uint16_t height, uint16_t depth, const void* data, uint32_t size)
+bgfx::TextureHandle RenderContext::UpdateTexture(const char* pName, uint16_t layer, uint8_t mip, uint16_t x, uint16_t y, uint16_t z, uint16_t width, uint16_t height, uint16_t depth, const void* data, uint32_t size, uint16_t pitch)
 {
 	bgfx::TextureHandle handle = BGFX_INVALID_HANDLE;
 	const bgfx::Memory* mem = nullptr;
@@ -602,14 +716,14 @@ bgfx::TextureHandle RenderContext::UpdateTexture(const char* pName, uint16_t lay
 		mem = bgfx::makeRef(data, size);
 	}
 
-	handle = { itTextureCache->second };
+	handle = m_pGPUResourceRegistry->Get(itTextureCache->second);
 	if (depth > 1)
 	{
 		bgfx::updateTexture3D(handle, mip, x, y, z, width, height, depth, mem);
 	}
 	else
 	{
-		bgfx::updateTexture2D(handle, layer, mip, x, y, width, height, mem);
+		bgfx::updateTexture2D(handle, layer, mip, x, y, width, height, mem, pitch);
 	}
 
 	return handle;
@@ -621,13 +735,13 @@ bgfx::UniformHandle RenderContext::CreateUniform(const char* pName, bgfx::Unifor
 	auto itUniformCache = m_uniformHandleCaches.find(uniformNameCrc);
 	if (itUniformCache != m_uniformHandleCaches.end())
 	{
-		return { itUniformCache->second };
+		return m_pGPUResourceRegistry->Get(itUniformCache->second);
 	}
 
 	bgfx::UniformHandle uniformHandle = bgfx::createUniform(pName, uniformType, number);
 	if(bgfx::isValid(uniformHandle))
 	{
-		m_uniformHandleCaches[uniformNameCrc] = uniformHandle.idx;
+		SetCachedHandle(*m_pGPUResourceRegistry, m_uniformHandleCaches, uniformNameCrc, uniformHandle);
 	}
 
 	return uniformHandle;
@@ -668,12 +782,12 @@ void RenderContext::SetVertexLayout(StringCrc resourceCrc, bgfx::VertexLayout ve
 
 void RenderContext::SetTexture(StringCrc resourceCrc, bgfx::TextureHandle textureHandle)
 {
-	m_textureHandleCaches[resourceCrc] = textureHandle.idx;
+	SetCachedHandle(*m_pGPUResourceRegistry, m_textureHandleCaches, resourceCrc, textureHandle);
 }
 
 void RenderContext::SetUniform(StringCrc resourceCrc, bgfx::UniformHandle uniformreHandle)
 {
-	m_uniformHandleCaches[resourceCrc] = uniformreHandle.idx;
+	SetCachedHandle(*m_pGPUResourceRegistry, m_uniformHandleCaches, resourceCrc, uniformreHandle);
 }
 
 void RenderContext::FillUniform(StringCrc resourceCrc, const void *pData, uint16_t vec4Count) const
@@ -681,6 +795,11 @@ void RenderContext::FillUniform(StringCrc resourceCrc, const void *pData, uint16
 	bgfx::setUniform(GetUniform(resourceCrc), pData, vec4Count);
 }
 
+void RenderContext::FillUniform(bgfx::Encoder* pEncoder, StringCrc resourceCrc, const void* pData, uint16_t vec4Count) const
+{
+	pEncoder->setUniform(GetUniform(resourceCrc), pData, vec4Count);
+}
+
 RenderTarget* RenderContext::GetRenderTarget(StringCrc resourceCrc) const
 {
 	auto itResource = m_renderTargetCaches.find(resourceCrc);
@@ -706,35 +825,17 @@ const bgfx::VertexLayout& RenderContext::GetVertexAttributeLayouts(StringCrc res
 
 bgfx::ShaderHandle RenderContext::GetShader(StringCrc resourceCrc) const
 {
-	auto itResource = m_shaderHandles.find(resourceCrc);
-	if (itResource != m_shaderHandles.end())
-	{
-		return { itResource->second };
-	}
-
-	return bgfx::ShaderHandle{ bgfx::kInvalidHandle };
+	return GetCachedHandle(*m_pGPUResourceRegistry, m_shaderHandles, resourceCrc);
 }
 
 bgfx::TextureHandle RenderContext::GetTexture(StringCrc resourceCrc) const
 {
-	auto itResource = m_textureHandleCaches.find(resourceCrc);
-	if (itResource != m_textureHandleCaches.end())
-	{
-		return { itResource->second };
-	}
-
-	return bgfx::TextureHandle{ bgfx::kInvalidHandle };
+	return GetCachedHandle(*m_pGPUResourceRegistry, m_textureHandleCaches, resourceCrc);
 }
 
 bgfx::UniformHandle RenderContext::GetUniform(StringCrc resourceCrc) const
 {
-	auto itResource = m_uniformHandleCaches.find(resourceCrc);
-	if (itResource != m_uniformHandleCaches.end())
-	{
-		return { itResource->second };
-	}
-
-	return bgfx::UniformHandle{ bgfx::kInvalidHandle };
+	return GetCachedHandle(*m_pGPUResourceRegistry, m_uniformHandleCaches, resourceCrc);
 }
 
 void RenderContext::DestoryRenderTarget(StringCrc resourceCrc)
@@ -744,49 +845,30 @@ void RenderContext::DestoryRenderTarget(StringCrc resourceCrc)
 
 void RenderContext::DestoryTexture(StringCrc resourceCrc)
 {
-	auto it = m_textureHandleCaches.find(resourceCrc);
-	if (it != m_textureHandleCaches.end())
-	{
-		assert(bgfx::isValid(bgfx::TextureHandle{ it->second }));
-		bgfx::destroy(bgfx::TextureHandle{ it->second });
-		m_textureHandleCaches.erase(it);
-	}
+	ReleaseCachedHandle(*m_pGPUResourceRegistry, m_textureHandleCaches, resourceCrc);
 }
 
 void RenderContext::DestoryUniform(StringCrc resourceCrc)
 {
-	auto it = m_uniformHandleCaches.find(resourceCrc);
-	if (it != m_uniformHandleCaches.end())
-	{
-		assert(bgfx::isValid(bgfx::UniformHandle{ it->second }));
-		bgfx::destroy(bgfx::UniformHandle{ it->second });
-		m_uniformHandleCaches.erase(it);
-	}
+	ReleaseCachedHandle(*m_pGPUResourceRegistry, m_uniformHandleCaches, resourceCrc);
 }
 
 void RenderContext::DestoryShader(StringCrc resourceCrc)
 {
-	auto it = m_shaderHandles.find(resourceCrc);
-	if (it != m_shaderHandles.end())
-	{
-		assert(bgfx::isValid(bgfx::ShaderHandle{ it->second }));
-		bgfx::destroy(bgfx::ShaderHandle{ it->second });
-		m_shaderHandles.erase(it);
-	}
+	ReleaseCachedHandle(*m_pGPUResourceRegistry, m_shaderHandles, resourceCrc);
 
 	// Erase shader blob anyway.
-	m_shaderBlobs.erase(resourceCrc);
+	auto itBlob = m_shaderBlobs.find(resourceCrc);
+	if (itBlob != m_shaderBlobs.end())
+	{
+		m_shaderBlobMemory.Set(m_shaderBlobMemory.Get() - itBlob->second->capacity());
+		m_shaderBlobs.erase(itBlob);
+	}
 }
 
 void RenderContext::DestoryProgram(StringCrc resourceCrc)
 {
-	auto it = m_shaderProgramHandles.find(resourceCrc);
-	if (it != m_shaderProgramHandles.end())
-	{
-		assert(bgfx::isValid(bgfx::ProgramHandle{ it->second }));
-		bgfx::destroy(bgfx::ProgramHandle{ it->second });
-		m_shaderProgramHandles.erase(it);
-	}
+	ReleaseCachedHandle(*m_pGPUResourceRegistry, m_shaderProgramHandles, resourceCrc);
 }
 
 }
\ No newline at end of file
@@ -1,8 +1,12 @@
 #pragma once
 
+#include "Core/Memory/FrameAllocator.h"
+#include "Core/Memory/MemoryTracker.h"
 #include "Core/StringCrc.h"
 #include "Graphics/GraphicsBackend.h"
 #include "Math/Matrix.hpp"
+#include "Rendering/EncoderWorkerPool.h"
+#include "Rendering/Resources/GPUResourceRegistry.h"
 #include "Rendering/ShaderCompileInfo.h"
 #include "RenderTarget.h"
 #include "Scene/VertexAttribute.h"
@@ -10,6 +14,8 @@
 
 #include <bgfx/bgfx.h>
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -21,13 +27,22 @@ namespace engine
 {
 
 class Camera;
+class DebugDraw;
 class Renderer;
+class RenderSnapshot;
 class ResourceContext;
 class ShaderCollections;
 
 static constexpr uint8_t MaxViewCount = 255;
 static constexpr uint8_t MaxRenderTargetCount = 255;
 
+struct MeshLodStats
+{
+	uint64_t submittedTriangleCount = 0U;
+	// Triangles which would be submitted in addition if all meshes used their original detail level.
+	uint64_t savedTriangleCount = 0U;
+};
+
 // In current design, RenderContext needs to be a singleton.
 // The reason is that it binds to bgfx graphics initialization which should only happen once.
 class RenderContext
@@ -47,6 +62,7 @@ public:
 	void OnResize(uint16_t width, uint16_t height);
 	void BeginFrame();
 	void Submit(uint16_t viewID, const std::string& programName, const std::string& featuresCombine = "");
+	void Submit(bgfx::Encoder* pEncoder, uint16_t viewID, const std::string& programName, const std::string& featuresCombine = "");
 	void Dispatch(uint16_t viewID, const std::string& programName, uint32_t numX, uint32_t numY, uint32_t numZ);
 	void EndFrame();
 	void Shutdown();
@@ -54,6 +70,31 @@ public:
 	void SetResourceContext(ResourceContext* pContext) { m_pResourceContext = pContext; }
 	ResourceContext* GetResourceContext() const { return m_pResourceContext; }
 
+	DebugDraw* GetDebugDraw() const { return m_pDebugDraw.get(); }
+
+	// Scene states captured by simulation for the frame being rendered. Renderers read it instead of components.
+	void SetRenderSnapshot(const RenderSnapshot* pSnapshot) { m_pRenderSnapshot = pSnapshot; }
+	const RenderSnapshot* GetRenderSnapshot() const { return m_pRenderSnapshot; }
+
+	// Owns GPU resources by reference counts and destroys released ones a few frames later.
+	// Resources cached by name in RenderContext are registered here too, so Destory* apis only release their references.
+	GPUResourceRegistry* GetGPUResourceRegistry() const { return m_pGPUResourceRegistry.get(); }
+
+	// Records draw calls into per-thread encoders. Renderers use encoder versions of Submit and FillUniform inside it.
+	EncoderWorkerPool* GetEncoderWorkerPool() const { return m_pEncoderWorkerPool.get(); }
+
+	// Transient memory for render data of current frame. Worker threads should use ScratchArena instead.
+	FrameAllocator* GetFrameAllocator() const { return m_pFrameAllocator.get(); }
+
+	// Accumulated by mesh draw calls in current frame which may come from encoder worker threads.
+	// Stats of last frame are kept for display.
+	void AddMeshLodStats(uint32_t submittedTriangleCount, uint32_t savedTriangleCount);
+	const MeshLodStats& GetMeshLodStats() const { return m_lastFrameMeshLodStats; }
+
+	// Enables bgfx timer queries per view. EndFrame sends GPU time of every view to ProfileRecorder.
+	void SetGPUProfileEnable(bool enable);
+	bool IsGPUProfileEnable() const { return m_isGPUProfileEnable; }
+
 	uint16_t GetBackBufferWidth() const { return m_backBufferWidth; }
 	uint16_t GetBackBufferHeight() const { return m_backBufferHeight; }
 	void SetBackBufferSize(uint16_t width, uint16_t height) { m_backBufferWidth = width; m_backBufferHeight = height; }
@@ -117,7 +158,7 @@ public:
 
 	bgfx::TextureHandle CreateTexture(const char* filePath, uint64_t flags = 0UL);
 	bgfx::TextureHandle CreateTexture(const char* pName, uint16_t width, uint16_t height, uint16_t depth, bgfx::TextureFormat::Enum format, uint64_t flags = 0UL, const void* data = nullptr, uint32_t size = 0);
-	bgfx::TextureHandle UpdateTexture(const char* pName, uint16_t layer, uint8_t mip, uint16_t x, uint16_t y, uint16_t z, uint16_t width, uint16_t height, uint16_t depth, const void* data = nullptr, uint32_t size = 0);
+	bgfx::TextureHandle UpdateTexture(const char* pName, uint16_t layer, uint8_t mip, uint16_t x, uint16_t y, uint16_t z, uint16_t width, uint16_t height, uint16_t depth, const void* data = nullptr, uint32_t size = 0, uint16_t pitch = UINT16_MAX);
 	
 	bgfx::UniformHandle CreateUniform(const char* pName, bgfx::UniformType::Enum uniformType, uint16_t number = 1);
 
@@ -127,6 +168,7 @@ public:
 	void SetTexture(StringCrc resourceCrc, bgfx::TextureHandle textureHandle);
 	void SetUniform(StringCrc resourceCrc, bgfx::UniformHandle uniformreHandle);
 	void FillUniform(StringCrc resourceCrc, const void *pData, uint16_t vec4Count = 1) const;
+	void FillUniform(bgfx::Encoder* pEncoder, StringCrc resourceCrc, const void* pData, uint16_t vec4Count = 1) const;
 
 	RenderTarget* GetRenderTarget(StringCrc resourceCrc) const;
 	const bgfx::VertexLayout& GetVertexAttributeLayouts(StringCrc resourceCrc) const;
@@ -142,6 +184,18 @@ public:
 
 private:
 	ResourceContext* m_pResourceContext = nullptr;
+	std::unique_ptr<DebugDraw> m_pDebugDraw;
+	const RenderSnapshot* m_pRenderSnapshot = nullptr;
+	std::unique_ptr<GPUResourceRegistry> m_pGPUResourceRegistry;
+	std::unique_ptr<EncoderWorkerPool> m_pEncoderWorkerPool;
+	std::unique_ptr<FrameAllocator> m_pFrameAllocator;
+	std::atomic<uint64_t> m_submittedTriangleCount = 0U;
+	std::atomic<uint64_t> m_savedTriangleCount = 0U;
+	MeshLodStats m_lastFrameMeshLodStats;
+	bool m_isGPUProfileEnable = false;
+
+	// Interned names of GPU zones by view id, so profiling doesn't intern every view name every frame.
+	std::array<const char*, MaxViewCount> m_gpuZoneNames{};
 
 	uint8_t m_currentViewCount = 0;
 	uint16_t m_backBufferWidth;
@@ -149,18 +203,19 @@ private:
 
 	std::unordered_map<StringCrc, std::unique_ptr<RenderTarget>> m_renderTargetCaches;
 	std::unordered_map<StringCrc, bgfx::VertexLayout> m_vertexLayoutCaches;
-	std::unordered_map<StringCrc, uint16_t> m_textureHandleCaches;
-	std::unordered_map<StringCrc, uint16_t> m_uniformHandleCaches;
+	std::unordered_map<StringCrc, GPUHandle<bgfx::TextureHandle>> m_textureHandleCaches;
+	std::unordered_map<StringCrc, GPUHandle<bgfx::UniformHandle>> m_uniformHandleCaches;
 
 	ShaderCollections* m_pShaderCollections = nullptr;
 
 	// Key : StringCrc(Program name), Value : Shader program handle
-	std::unordered_map<StringCrc, uint16_t> m_shaderProgramHandles;
+	std::unordered_map<StringCrc, GPUHandle<bgfx::ProgramHandle>> m_shaderProgramHandles;
 
 	// Key : StringCrc(Shader name), Value : Shader handle
-	std::unordered_map<StringCrc, uint16_t> m_shaderHandles;
+	std::unordered_map<StringCrc, GPUHandle<bgfx::ShaderHandle>> m_shaderHandles;
 	// Key : StringCrc(Shader name), Value : Shader binary data
 	std::unordered_map<StringCrc, std::unique_ptr<ShaderBlob>> m_shaderBlobs;
+	TrackedMemorySize m_shaderBlobMemory{ MemoryTag::Shader };
 
 	std::set<ShaderCompileInfo> m_shaderCompileInfos;
 	std::set<StringCrc> m_modifiedProgramNameCrcs;
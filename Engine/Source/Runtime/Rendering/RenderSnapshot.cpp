@@ -0,0 +1,99 @@
+#include "RenderSnapshot.h"
+
+#include "ECWorld/CameraComponent.h"
+#include "ECWorld/CollisionMeshComponent.h"
+#include "ECWorld/SceneWorld.h"
+#include "ECWorld/SkyComponent.h"
+#include "ECWorld/StaticMeshComponent.h"
+#include "ECWorld/TransformComponent.h"
+#include "Physics/SceneQuery.h"
+#include "Profiling/Profiling.h"
+
+#include <algorithm>
+
+namespace engine
+{
+
+void RenderSnapshot::Capture(const SceneWorld& sceneWorld, uint64_t frameIndex)
+{
+	CD_PROFILE_SCOPE("RenderSnapshot::Capture");
+	m_frameIndex = frameIndex;
+
+	CaptureCamera(sceneWorld);
+
+	if (const SkyComponent* pSkyComponent = sceneWorld.GetSkyComponent(sceneWorld.GetSkyEntity()))
+	{
+		m_sunDirection = pSkyComponent->GetSunDirection();
+	}
+
+	m_transforms.clear();
+	for (Entity entity : sceneWorld.GetTransformEntities())
+	{
+		const TransformComponent* pTransformComponent = sceneWorld.GetTransformComponent(entity);
+		m_transforms.push_back(RenderSnapshotTransform{ entity, pTransformComponent->GetTransform(), pTransformComponent->GetWorldMatrix() });
+	}
+	std::sort(m_transforms.begin(), m_transforms.end(), [](const RenderSnapshotTransform& lhs, const RenderSnapshotTransform& rhs)
+	{
+		return lhs.entity < rhs.entity;
+	});
+
+	m_items.clear();
+	for (Entity entity : sceneWorld.GetMaterialEntities())
+	{
+		if (!sceneWorld.GetStaticMeshComponent(entity))
+		{
+			continue;
+		}
+
+		RenderSnapshotItem& item = m_items.emplace_back();
+		item.entity = entity;
+		const RenderSnapshotTransform* pTransform = FindTransform(entity);
+		item.worldMatrix = pTransform ? pTransform->worldMatrix : cd::Matrix4x4::Identity();
+		item.hasWorldAABB = sceneWorld.GetSceneQuery()->GetEntityWorldAABB(entity, item.worldAABB);
+	}
+
+	// Entities without transforms are not in SceneQuery so they keep local boxes.
+	m_collisionBoxes.clear();
+	for (Entity entity : sceneWorld.GetCollisionMeshEntities())
+	{
+		RenderSnapshotBox& box = m_collisionBoxes.emplace_back();
+		box.entity = entity;
+		box.worldAABB = sceneWorld.GetCollisionMeshComponent(entity)->GetAABB();
+		sceneWorld.GetSceneQuery()->GetEntityWorldAABB(entity, box.worldAABB);
+	}
+}
+
+void RenderSnapshot::CaptureCamera(const SceneWorld& sceneWorld)
+{
+	Entity mainCameraEntity = sceneWorld.GetMainCameraEntity();
+	if (const CameraComponent* pCameraComponent = sceneWorld.GetCameraComponent(mainCameraEntity))
+	{
+		m_camera.viewMatrix = pCameraComponent->GetViewMatrix();
+		m_camera.projectionMatrix = pCameraComponent->GetProjectionMatrix();
+		m_camera.nearPlane = pCameraComponent->GetNearPlane();
+		m_camera.farPlane = pCameraComponent->GetFarPlane();
+		m_camera.fov = pCameraComponent->GetFov();
+	}
+
+	if (const TransformComponent* pCameraTransformComponent = sceneWorld.GetTransformComponent(mainCameraEntity))
+	{
+		m_camera.position = pCameraTransformComponent->GetTransform().GetTranslation();
+	}
+}
+
+const RenderSnapshotTransform* RenderSnapshot::FindTransform(Entity entity) const
+{
+	auto itTransform = std::lower_bound(m_transforms.begin(), m_transforms.end(), entity, [](const RenderSnapshotTransform& transform, Entity entity)
+	{
+		return transform.entity < entity;
+	});
+
+	if (itTransform == m_transforms.end() || itTransform->entity != entity)
+	{
+		return nullptr;
+	}
+
+	return &(*itTransform);
+}
+
+}
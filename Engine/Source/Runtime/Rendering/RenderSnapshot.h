@@ -0,0 +1,88 @@
+#pragma once
+
+#include "ECWorld/Entity.h"
+#include "Math/Box.hpp"
+#include "Math/Matrix.hpp"
+#include "Math/Transform.hpp"
+#include "Math/Vector.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace engine
+{
+
+class SceneWorld;
+
+struct RenderSnapshotCamera
+{
+	cd::Matrix4x4 viewMatrix = cd::Matrix4x4::Identity();
+	cd::Matrix4x4 projectionMatrix = cd::Matrix4x4::Identity();
+	cd::Vec3f position = cd::Vec3f::Zero();
+	float nearPlane = 0.1f;
+	float farPlane = 1000.0f;
+	float fov = 45.0f;
+};
+
+struct RenderSnapshotItem
+{
+	Entity entity;
+	cd::Matrix4x4 worldMatrix;
+	cd::AABB worldAABB;
+	bool hasWorldAABB;
+};
+
+struct RenderSnapshotTransform
+{
+	Entity entity;
+	cd::Transform transform;
+	cd::Matrix4x4 worldMatrix;
+};
+
+struct RenderSnapshotBox
+{
+	Entity entity;
+	cd::AABB worldAABB;
+};
+
+// Copy of scene states which renderers need for one frame.
+// Simulation captures frame N while frame N - 1 is rendered. Simulation builds world matrices, SceneQuery bounds
+// and time of day, so renderers only read them from here. Other component data is only edited on the main thread
+// and can be read from components directly.
+class RenderSnapshot final
+{
+public:
+	RenderSnapshot() = default;
+	RenderSnapshot(const RenderSnapshot&) = delete;
+	RenderSnapshot& operator=(const RenderSnapshot&) = delete;
+	RenderSnapshot(RenderSnapshot&&) = delete;
+	RenderSnapshot& operator=(RenderSnapshot&&) = delete;
+	~RenderSnapshot() = default;
+
+	// Items are material entities which have static meshes. Memory of items is reused between captures.
+	void Capture(const SceneWorld& sceneWorld, uint64_t frameIndex);
+
+	// Camera is captured again before rendering so that camera input of the frame doesn't wait for simulation.
+	void CaptureCamera(const SceneWorld& sceneWorld);
+
+	// 0 means nothing is captured yet.
+	uint64_t GetFrameIndex() const { return m_frameIndex; }
+	const RenderSnapshotCamera& GetCamera() const { return m_camera; }
+	const std::vector<RenderSnapshotItem>& GetItems() const { return m_items; }
+	const std::vector<RenderSnapshotBox>& GetCollisionBoxes() const { return m_collisionBoxes; }
+	const cd::Direction& GetSunDirection() const { return m_sunDirection; }
+
+	// Returns nullptr for entities which are created after capturing.
+	const RenderSnapshotTransform* FindTransform(Entity entity) const;
+
+private:
+	uint64_t m_frameIndex = 0U;
+	RenderSnapshotCamera m_camera;
+	cd::Direction m_sunDirection = cd::Direction(0.0f, -1.0f, 0.0f);
+	std::vector<RenderSnapshotItem> m_items;
+	// Sorted by entity.
+	std::vector<RenderSnapshotTransform> m_transforms;
+	std::vector<RenderSnapshotBox> m_collisionBoxes;
+};
+
+}
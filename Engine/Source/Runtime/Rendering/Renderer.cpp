@@ -28,6 +28,12 @@ RenderContext* Renderer::GetRenderContext()
 	return m_pRenderContext;
 }
 
+void Renderer::SetName(const char* pName)
+{
+	m_pName = pName;
+	bgfx::setViewName(m_viewID, pName);
+}
+
 void Renderer::UpdateViewRenderTarget()
 {
 	if (m_pRenderTarget)
@@ -142,16 +148,40 @@ void Renderer::ScreenSpaceQuad(const RenderTarget* pRenderTarget, bool _originBo
 }
 
 void Renderer::SubmitStaticMeshDrawCall(StaticMeshComponent* pMeshComponent, uint16_t viewID, const std::string& programName, const std::string& featuresCombine)
+{
+	// On the thread which owns bgfx, bgfx::begin returns the encoder behind global bgfx apis.
+	SubmitStaticMeshDrawCall(bgfx::begin(), pMeshComponent, viewID, programName, featuresCombine);
+}
+
+void Renderer::SubmitStaticMeshDrawCall(bgfx::Encoder* pEncoder, StaticMeshComponent* pMeshComponent, uint16_t viewID, const std::string& programName, const std::string& featuresCombine)
 {
 	const MeshResource* pMeshResource = pMeshComponent->GetMeshResource();
 	assert(ResourceStatus::Ready == pMeshResource->GetStatus() || ResourceStatus::Optimized == pMeshResource->GetStatus());
-	bgfx::setVertexBuffer(0, bgfx::VertexBufferHandle{ pMeshResource->GetVertexBufferHandle() }, pMeshComponent->GetStartVertex(), pMeshComponent->GetVertexCount());
+	// Meshes in arena share large dynamic buffers so consecutive draw calls keep the same buffer bindings.
+	const bool isInMeshArena = pMeshResource->IsInMeshArena();
 	for (uint32_t indexBufferIndex = 0U, indexBufferCount = pMeshResource->GetIndexBufferCount(); indexBufferIndex < indexBufferCount; ++indexBufferIndex)
 	{
-		bgfx::setIndexBuffer(bgfx::IndexBufferHandle{ pMeshResource->GetIndexBufferHandle(indexBufferIndex) }, pMeshComponent->GetStartIndex(), pMeshComponent->GetIndexCount());
+		if (isInMeshArena)
+		{
+			pEncoder->setVertexBuffer(0, bgfx::DynamicVertexBufferHandle{ pMeshResource->GetVertexBufferHandle() }, pMeshComponent->GetStartVertex(), pMeshComponent->GetVertexCount());
+			pEncoder->setIndexBuffer(bgfx::DynamicIndexBufferHandle{ pMeshResource->GetIndexBufferHandle(indexBufferIndex) }, pMeshComponent->GetStartIndex(indexBufferIndex), pMeshComponent->GetIndexCount(indexBufferIndex));
+		}
+		else
+		{
+			pEncoder->setVertexBuffer(0, bgfx::VertexBufferHandle{ pMeshResource->GetVertexBufferHandle() }, pMeshComponent->GetStartVertex(), pMeshComponent->GetVertexCount());
+			pEncoder->setIndexBuffer(bgfx::IndexBufferHandle{ pMeshResource->GetIndexBufferHandle(indexBufferIndex) }, pMeshComponent->GetStartIndex(indexBufferIndex), pMeshComponent->GetIndexCount(indexBufferIndex));
+		}
+
+		// Polygon groups without generated levels use the whole index buffer which has no count here.
+		uint32_t lodIndexCount = pMeshComponent->GetIndexCount(indexBufferIndex);
+		if (lodIndexCount != UINT32_MAX)
+		{
+			uint32_t originalIndexCount = pMeshResource->GetLod(indexBufferIndex, 0U).indexCount;
+			GetRenderContext()->AddMeshLodStats(lodIndexCount / 3U, (originalIndexCount - lodIndexCount) / 3U);
+		}
 
 		// TODO : Submit interface requires runtime string construction which may hurt performance.
-		GetRenderContext()->Submit(viewID, programName, featuresCombine);
+		GetRenderContext()->Submit(pEncoder, viewID, programName, featuresCombine);
 	}
 }
 
@@ -3,6 +3,13 @@
 #include <cstdint>
 #include <string>
 
+namespace bgfx
+{
+
+struct Encoder;
+
+}
+
 namespace engine
 {
 
@@ -33,6 +40,10 @@ public:
 	virtual void Render(float deltaTime) = 0;
 
 	uint16_t GetViewID() const { return m_viewID; }
+
+	// Name of the main view which bgfx view stats and profiler zones show. It should be a string literal.
+	void SetName(const char* pName);
+	const char* GetName() const { return m_pName; }
 	
 	void UpdateViewRenderTarget();
 	void SetRenderTarget(RenderTarget* pRenderTarget) { m_pRenderTarget = pRenderTarget; }
@@ -42,12 +53,15 @@ public:
 	virtual bool IsEnable() const { return m_isEnable; }
 
 	void SubmitStaticMeshDrawCall(StaticMeshComponent* pMeshComponent, uint16_t viewID, const std::string& programName, const std::string& featuresCombine = "");
+	// Thread safe version for EncoderWorkerPool. Draw states such as transform should be set on the same encoder.
+	void SubmitStaticMeshDrawCall(bgfx::Encoder* pEncoder, StaticMeshComponent* pMeshComponent, uint16_t viewID, const std::string& programName, const std::string& featuresCombine = "");
 
 public:
 	static void ScreenSpaceQuad(const RenderTarget* pRenderTarget, bool _originBottomLeft = false, float _width = 1.0f, float _height = 1.0f);
 
 protected:
 	uint16_t m_viewID = 0;
+	const char* m_pName = "Renderer";
 	RenderTarget* m_pRenderTarget = nullptr;
 	bool m_isEnable = true;
 };
@@ -0,0 +1,191 @@
+#include "GPUResourceRegistry.h"
+
+#include "Log/Log.h"
+
+#include <cassert>
+
+namespace engine
+{
+
+GPUResourceRegistry::~GPUResourceRegistry()
+{
+	DestroyAll();
+}
+
+void GPUResourceRegistry::Update()
+{
+	std::lock_guard<std::shared_mutex> lock(m_mutex);
+	++m_frameIndex;
+
+	// Entries are queued in frame order.
+	while (!m_pendingDestroys.empty() && m_pendingDestroys.front().frame <= m_frameIndex)
+	{
+		const PendingDestroy& pendingDestroy = m_pendingDestroys.front();
+		DestroyBGFXHandle(pendingDestroy.type, pendingDestroy.bgfxIndex);
+		m_pendingDestroys.pop_front();
+		++m_destroyedCount;
+	}
+}
+
+void GPUResourceRegistry::DestroyAll()
+{
+	std::lock_guard<std::shared_mutex> lock(m_mutex);
+	for (const PendingDestroy& pendingDestroy : m_pendingDestroys)
+	{
+		DestroyBGFXHandle(pendingDestroy.type, pendingDestroy.bgfxIndex);
+	}
+	m_destroyedCount += m_pendingDestroys.size();
+	m_pendingDestroys.clear();
+
+	for (uint16_t slotIndex = 0U; slotIndex < m_slots.size(); ++slotIndex)
+	{
+		Slot& slot = m_slots[slotIndex];
+		if (slot.refCount > 0U)
+		{
+			DestroyBGFXHandle(slot.type, slot.bgfxIndex);
+			slot.refCount = 0U;
+			++slot.generation;
+			m_freeSlots.push_back(slotIndex);
+			++m_destroyedCount;
+		}
+	}
+	m_bgfxHandleSlots.clear();
+}
+
+GPUResourceStats GPUResourceRegistry::GetStats() const
+{
+	std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+	GPUResourceStats stats;
+	for (const Slot& slot : m_slots)
+	{
+		if (slot.refCount > 0U)
+		{
+			++stats.aliveCounts[static_cast<size_t>(slot.type)];
+		}
+	}
+	stats.pendingDestroyCount = static_cast<uint32_t>(m_pendingDestroys.size());
+	stats.destroyedCount = m_destroyedCount;
+
+	return stats;
+}
+
+void GPUResourceRegistry::DestroyBGFXHandle(GPUResourceType type, uint16_t bgfxIndex)
+{
+	switch (type)
+	{
+	case GPUResourceType::VertexBuffer:
+		bgfx::destroy(bgfx::VertexBufferHandle{ bgfxIndex });
+		break;
+	case GPUResourceType::IndexBuffer:
+		bgfx::destroy(bgfx::IndexBufferHandle{ bgfxIndex });
+		break;
+	case GPUResourceType::DynamicVertexBuffer:
+		bgfx::destroy(bgfx::DynamicVertexBufferHandle{ bgfxIndex });
+		break;
+	case GPUResourceType::DynamicIndexBuffer:
+		bgfx::destroy(bgfx::DynamicIndexBufferHandle{ bgfxIndex });
+		break;
+	case GPUResourceType::Texture:
+		bgfx::destroy(bgfx::TextureHandle{ bgfxIndex });
+		break;
+	case GPUResourceType::Shader:
+		bgfx::destroy(bgfx::ShaderHandle{ bgfxIndex });
+		break;
+	case GPUResourceType::Program:
+		bgfx::destroy(bgfx::ProgramHandle{ bgfxIndex });
+		break;
+	case GPUResourceType::Uniform:
+		bgfx::destroy(bgfx::UniformHandle{ bgfxIndex });
+		break;
+	case GPUResourceType::FrameBuffer:
+		bgfx::destroy(bgfx::FrameBufferHandle{ bgfxIndex });
+		break;
+	default:
+		assert(false && "Unknown GPU resource type.");
+		break;
+	}
+}
+
+void GPUResourceRegistry::RegisterImpl(GPUResourceType type, uint16_t bgfxIndex, uint16_t& outIndex, uint16_t& outGeneration)
+{
+	std::lock_guard<std::shared_mutex> lock(m_mutex);
+
+	uint32_t bgfxHandleKey = GetBGFXHandleKey(type, bgfxIndex);
+	auto itSlot = m_bgfxHandleSlots.find(bgfxHandleKey);
+	if (itSlot != m_bgfxHandleSlots.end())
+	{
+		Slot& slot = m_slots[itSlot->second];
+		++slot.refCount;
+		outIndex = itSlot->second;
+		outGeneration = slot.generation;
+		return;
+	}
+
+	uint16_t slotIndex;
+	if (m_freeSlots.empty())
+	{
+		assert(m_slots.size() < UINT16_MAX && "Overflow the max count of GPU resources.");
+		slotIndex = static_cast<uint16_t>(m_slots.size());
+		m_slots.emplace_back();
+	}
+	else
+	{
+		slotIndex = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+
+	Slot& slot = m_slots[slotIndex];
+	slot.refCount = 1U;
+	slot.bgfxIndex = bgfxIndex;
+	slot.type = type;
+	m_bgfxHandleSlots[bgfxHandleKey] = slotIndex;
+
+	outIndex = slotIndex;
+	outGeneration = slot.generation;
+}
+
+uint16_t GPUResourceRegistry::GetImpl(GPUResourceType type, uint16_t index, uint16_t generation) const
+{
+	std::shared_lock<std::shared_mutex> lock(m_mutex);
+	return IsAlive(type, index, generation) ? m_slots[index].bgfxIndex : bgfx::kInvalidHandle;
+}
+
+void GPUResourceRegistry::AddRefImpl(GPUResourceType type, uint16_t index, uint16_t generation)
+{
+	std::lock_guard<std::shared_mutex> lock(m_mutex);
+	if (IsAlive(type, index, generation))
+	{
+		++m_slots[index].refCount;
+	}
+}
+
+void GPUResourceRegistry::ReleaseImpl(GPUResourceType type, uint16_t index, uint16_t generation)
+{
+	std::lock_guard<std::shared_mutex> lock(m_mutex);
+	if (!IsAlive(type, index, generation))
+	{
+		CD_ENGINE_WARN("Release a stale GPU resource handle.");
+		return;
+	}
+
+	Slot& slot = m_slots[index];
+	if (--slot.refCount > 0U)
+	{
+		return;
+	}
+
+	// Slot is reused immediately. Only the bgfx handle waits for frames in flight.
+	m_pendingDestroys.push_back(PendingDestroy{ slot.type, slot.bgfxIndex, m_frameIndex + DestroyLatencyFrameCount });
+	m_bgfxHandleSlots.erase(GetBGFXHandleKey(slot.type, slot.bgfxIndex));
+	slot.bgfxIndex = bgfx::kInvalidHandle;
+	++slot.generation;
+	m_freeSlots.push_back(index);
+}
+
+bool GPUResourceRegistry::IsAlive(GPUResourceType type, uint16_t index, uint16_t generation) const
+{
+	return index < m_slots.size() && m_slots[index].refCount > 0U && m_slots[index].generation == generation && m_slots[index].type == type;
+}
+
+}
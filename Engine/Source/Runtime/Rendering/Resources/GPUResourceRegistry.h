@@ -0,0 +1,178 @@
+#pragma once
+
+#include <bgfx/bgfx.h>
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace engine
+{
+
+enum class GPUResourceType : uint8_t
+{
+	VertexBuffer,
+	IndexBuffer,
+	DynamicVertexBuffer,
+	DynamicIndexBuffer,
+	Texture,
+	Shader,
+	Program,
+	Uniform,
+	FrameBuffer,
+
+	Count,
+};
+
+template<typename T>
+constexpr GPUResourceType GetGPUResourceType()
+{
+	if constexpr (std::is_same_v<T, bgfx::VertexBufferHandle>)
+	{
+		return GPUResourceType::VertexBuffer;
+	}
+	else if constexpr (std::is_same_v<T, bgfx::IndexBufferHandle>)
+	{
+		return GPUResourceType::IndexBuffer;
+	}
+	else if constexpr (std::is_same_v<T, bgfx::DynamicVertexBufferHandle>)
+	{
+		return GPUResourceType::DynamicVertexBuffer;
+	}
+	else if constexpr (std::is_same_v<T, bgfx::DynamicIndexBufferHandle>)
+	{
+		return GPUResourceType::DynamicIndexBuffer;
+	}
+	else if constexpr (std::is_same_v<T, bgfx::TextureHandle>)
+	{
+		return GPUResourceType::Texture;
+	}
+	else if constexpr (std::is_same_v<T, bgfx::ShaderHandle>)
+	{
+		return GPUResourceType::Shader;
+	}
+	else if constexpr (std::is_same_v<T, bgfx::ProgramHandle>)
+	{
+		return GPUResourceType::Program;
+	}
+	else if constexpr (std::is_same_v<T, bgfx::UniformHandle>)
+	{
+		return GPUResourceType::Uniform;
+	}
+	else
+	{
+		static_assert(std::is_same_v<T, bgfx::FrameBufferHandle>, "Unsupported bgfx handle type.");
+		return GPUResourceType::FrameBuffer;
+	}
+}
+
+// Generational handle of a GPU resource. Index addresses a slot of GPUResourceRegistry and
+// generation tells if the slot was reused by another resource after this handle was released.
+template<typename T>
+struct GPUHandle
+{
+	uint16_t index = UINT16_MAX;
+	uint16_t generation = 0U;
+
+	bool IsValid() const { return index != UINT16_MAX; }
+};
+
+struct GPUResourceStats
+{
+	uint32_t aliveCounts[static_cast<size_t>(GPUResourceType::Count)] = {};
+	uint32_t pendingDestroyCount = 0U;
+	uint64_t destroyedCount = 0U;
+};
+
+// GPUResourceRegistry owns bgfx handles by reference counts.
+// Releasing the last reference invalidates all handles to the slot at once but the bgfx handle is destroyed
+// a few frames later in Update, so draw calls which were recorded before the release never refer to a destroyed resource.
+// Release is thread safe. Get only takes a shared lock so that encoder worker threads can resolve handles together.
+// Register and AddRef are also guarded but are expected on the thread which owns bgfx.
+class GPUResourceRegistry final
+{
+public:
+	static constexpr uint32_t DestroyLatencyFrameCount = 2U;
+
+public:
+	GPUResourceRegistry() = default;
+	GPUResourceRegistry(const GPUResourceRegistry&) = delete;
+	GPUResourceRegistry& operator=(const GPUResourceRegistry&) = delete;
+	GPUResourceRegistry(GPUResourceRegistry&&) = delete;
+	GPUResourceRegistry& operator=(GPUResourceRegistry&&) = delete;
+	~GPUResourceRegistry();
+
+	// Takes ownership with one reference. Registering a bgfx handle which is already alive adds a reference to its slot.
+	template<typename T>
+	GPUHandle<T> Register(T bgfxHandle)
+	{
+		GPUHandle<T> handle;
+		if (bgfx::isValid(bgfxHandle))
+		{
+			RegisterImpl(GetGPUResourceType<T>(), bgfxHandle.idx, handle.index, handle.generation);
+		}
+		return handle;
+	}
+
+	// Returns an invalid bgfx handle if the handle is released.
+	template<typename T>
+	T Get(GPUHandle<T> handle) const
+	{
+		return T{ GetImpl(GetGPUResourceType<T>(), handle.index, handle.generation) };
+	}
+
+	template<typename T>
+	void AddRef(GPUHandle<T> handle) { AddRefImpl(GetGPUResourceType<T>(), handle.index, handle.generation); }
+
+	template<typename T>
+	void Release(GPUHandle<T> handle) { ReleaseImpl(GetGPUResourceType<T>(), handle.index, handle.generation); }
+
+	// Call once per frame on the thread which owns bgfx.
+	void Update();
+
+	// Destroys alive and pending resources immediately. Only for shutdown before bgfx itself shuts down.
+	void DestroyAll();
+
+	GPUResourceStats GetStats() const;
+
+private:
+	struct Slot
+	{
+		uint32_t refCount = 0U;
+		uint16_t bgfxIndex = bgfx::kInvalidHandle;
+		uint16_t generation = 0U;
+		GPUResourceType type = GPUResourceType::Count;
+	};
+
+	struct PendingDestroy
+	{
+		GPUResourceType type;
+		uint16_t bgfxIndex;
+		uint64_t frame;
+	};
+
+	static uint32_t GetBGFXHandleKey(GPUResourceType type, uint16_t bgfxIndex) { return (static_cast<uint32_t>(type) << 16U) | bgfxIndex; }
+	static void DestroyBGFXHandle(GPUResourceType type, uint16_t bgfxIndex);
+
+	void RegisterImpl(GPUResourceType type, uint16_t bgfxIndex, uint16_t& outIndex, uint16_t& outGeneration);
+	uint16_t GetImpl(GPUResourceType type, uint16_t index, uint16_t generation) const;
+	void AddRefImpl(GPUResourceType type, uint16_t index, uint16_t generation);
+	void ReleaseImpl(GPUResourceType type, uint16_t index, uint16_t generation);
+	bool IsAlive(GPUResourceType type, uint16_t index, uint16_t generation) const;
+
+private:
+	mutable std::shared_mutex m_mutex;
+	std::vector<Slot> m_slots;
+	std::vector<uint16_t> m_freeSlots;
+	// Key : bgfx handle type and index, Value : slot index
+	std::unordered_map<uint32_t, uint16_t> m_bgfxHandleSlots;
+	std::deque<PendingDestroy> m_pendingDestroys;
+	uint64_t m_frameIndex = 0U;
+	uint64_t m_destroyedCount = 0U;
+};
+
+}
@@ -5,6 +5,8 @@
 namespace engine
 {
 
+class GPUResourceRegistry;
+
 enum class ResourceStatus
 {
 	Loading, // Wait to assign asset pointer
@@ -42,8 +44,13 @@ public:
 	ResourceStatus GetStatus() const { return m_status; }
 	void SetStatus(ResourceStatus status) { m_status = status; }
 
+	// GPU handles of the resource are owned by the registry and released instead of destroyed.
+	GPUResourceRegistry* GetGPUResourceRegistry() const { return m_pGPUResourceRegistry; }
+	void SetGPUResourceRegistry(GPUResourceRegistry* pGPUResourceRegistry) { m_pGPUResourceRegistry = pGPUResourceRegistry; }
+
 private:
 	StringCrc m_nameCrc;
+	GPUResourceRegistry* m_pGPUResourceRegistry = nullptr;
 	ResourceStatus m_status = ResourceStatus::Loading;
 };
 
@@ -0,0 +1,280 @@
+#include "MeshArena.h"
+
+#include "Log/Log.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace engine
+{
+
+MeshArena::~MeshArena()
+{
+	for (const Pool& pool : m_pools)
+	{
+		for (const Page& page : pool.pages)
+		{
+			if (pool.isIndex)
+			{
+				bgfx::destroy(bgfx::DynamicIndexBufferHandle{ page.bufferHandle });
+			}
+			else
+			{
+				bgfx::destroy(bgfx::DynamicVertexBufferHandle{ page.bufferHandle });
+			}
+		}
+	}
+}
+
+MeshArena::BlockID MeshArena::AllocateVertices(const bgfx::VertexLayout& vertexLayout, std::span<const std::byte> vertexBuffer)
+{
+	return Allocate(GetPoolIndex(false, vertexLayout.getStride(), &vertexLayout), vertexBuffer);
+}
+
+MeshArena::BlockID MeshArena::AllocateIndices(uint32_t indexSize, std::span<const std::byte> indexBuffer)
+{
+	assert(sizeof(uint16_t) == indexSize || sizeof(uint32_t) == indexSize);
+	return Allocate(GetPoolIndex(true, indexSize, nullptr), indexBuffer);
+}
+
+void MeshArena::Free(BlockID blockID)
+{
+	Block& block = m_blocks[blockID];
+	assert(block.isValid);
+
+	// Keep free ranges sorted by offset and merge neighbors.
+	std::vector<Range>& freeRanges = m_pools[block.poolIndex].pages[block.pageIndex].freeRanges;
+	auto itRange = std::lower_bound(freeRanges.begin(), freeRanges.end(), block.offset,
+		[](const Range& range, uint32_t offset) { return range.offset < offset; });
+	itRange = freeRanges.insert(itRange, Range{ block.offset, block.count });
+	if (itRange + 1 != freeRanges.end() && itRange->offset + itRange->count == (itRange + 1)->offset)
+	{
+		itRange->count += (itRange + 1)->count;
+		freeRanges.erase(itRange + 1);
+	}
+	if (itRange != freeRanges.begin() && (itRange - 1)->offset + (itRange - 1)->count == itRange->offset)
+	{
+		(itRange - 1)->count += itRange->count;
+		freeRanges.erase(itRange);
+	}
+
+	block.isValid = false;
+	m_freeBlockIDs.push_back(blockID);
+}
+
+uint16_t MeshArena::GetBufferHandle(BlockID blockID) const
+{
+	const Block& block = m_blocks[blockID];
+	return m_pools[block.poolIndex].pages[block.pageIndex].bufferHandle;
+}
+
+uint32_t MeshArena::GetOffset(BlockID blockID) const
+{
+	return m_blocks[blockID].offset;
+}
+
+uint32_t MeshArena::GetCount(BlockID blockID) const
+{
+	return m_blocks[blockID].count;
+}
+
+void MeshArena::Defragment()
+{
+	for (uint32_t poolIndex = 0U; poolIndex < m_pools.size(); ++poolIndex)
+	{
+		const Pool& pool = m_pools[poolIndex];
+		for (uint32_t pageIndex = 0U; pageIndex < pool.pages.size(); ++pageIndex)
+		{
+			if (pool.pages[pageIndex].freeRanges.size() > MaxFreeRangeCount)
+			{
+				DefragmentPage(poolIndex, pageIndex);
+				return;
+			}
+		}
+	}
+}
+
+MeshArenaStats MeshArena::GetStats() const
+{
+	MeshArenaStats stats;
+	for (const Pool& pool : m_pools)
+	{
+		for (const Page& page : pool.pages)
+		{
+			uint32_t freeCount = 0U;
+			for (const Range& range : page.freeRanges)
+			{
+				freeCount += range.count;
+			}
+
+			++stats.pageCount;
+			stats.capacityBytes += static_cast<uint64_t>(page.capacity) * pool.elementSize;
+			stats.usedBytes += static_cast<uint64_t>(page.capacity - freeCount) * pool.elementSize;
+			stats.freeRangeCount += static_cast<uint32_t>(page.freeRanges.size());
+		}
+	}
+	stats.blockCount = static_cast<uint32_t>(m_blocks.size() - m_freeBlockIDs.size());
+
+	return stats;
+}
+
+uint32_t MeshArena::GetPoolIndex(bool isIndex, uint32_t elementSize, const bgfx::VertexLayout* pVertexLayout)
+{
+	for (uint32_t poolIndex = 0U; poolIndex < m_pools.size(); ++poolIndex)
+	{
+		const Pool& pool = m_pools[poolIndex];
+		if (pool.isIndex == isIndex && pool.elementSize == elementSize &&
+			(isIndex || pool.vertexLayout.m_hash == pVertexLayout->m_hash))
+		{
+			return poolIndex;
+		}
+	}
+
+	Pool& pool = m_pools.emplace_back();
+	pool.isIndex = isIndex;
+	pool.elementSize = elementSize;
+	if (pVertexLayout)
+	{
+		pool.vertexLayout = *pVertexLayout;
+	}
+
+	return static_cast<uint32_t>(m_pools.size() - 1);
+}
+
+MeshArena::BlockID MeshArena::Allocate(uint32_t poolIndex, std::span<const std::byte> data)
+{
+	Pool& pool = m_pools[poolIndex];
+	assert(!data.empty() && data.size() % pool.elementSize == 0U);
+	const uint32_t count = static_cast<uint32_t>(data.size() / pool.elementSize);
+
+	// First fit in existing pages, otherwise open a new page which is large enough.
+	uint32_t pageIndex = 0U;
+	std::vector<Range>::iterator itRange;
+	for (; pageIndex < pool.pages.size(); ++pageIndex)
+	{
+		std::vector<Range>& freeRanges = pool.pages[pageIndex].freeRanges;
+		itRange = std::find_if(freeRanges.begin(), freeRanges.end(), [count](const Range& range) { return range.count >= count; });
+		if (itRange != freeRanges.end())
+		{
+			break;
+		}
+	}
+
+	if (pageIndex == pool.pages.size())
+	{
+		uint32_t pageCapacity = (pool.isIndex ? IndexPageBytes : VertexPageBytes) / pool.elementSize;
+		CreatePage(pool, std::max(pageCapacity, count));
+		itRange = pool.pages.back().freeRanges.begin();
+	}
+
+	Page& page = pool.pages[pageIndex];
+	const uint32_t offset = itRange->offset;
+	itRange->offset += count;
+	itRange->count -= count;
+	if (0U == itRange->count)
+	{
+		page.freeRanges.erase(itRange);
+	}
+
+	std::memcpy(page.data.data() + static_cast<size_t>(offset) * pool.elementSize, data.data(), data.size());
+	const bgfx::Memory* pMemory = bgfx::copy(data.data(), static_cast<uint32_t>(data.size()));
+	if (pool.isIndex)
+	{
+		bgfx::update(bgfx::DynamicIndexBufferHandle{ page.bufferHandle }, offset, pMemory);
+	}
+	else
+	{
+		bgfx::update(bgfx::DynamicVertexBufferHandle{ page.bufferHandle }, offset, pMemory);
+	}
+
+	BlockID blockID;
+	if (m_freeBlockIDs.empty())
+	{
+		blockID = static_cast<BlockID>(m_blocks.size());
+		m_blocks.emplace_back();
+	}
+	else
+	{
+		blockID = m_freeBlockIDs.back();
+		m_freeBlockIDs.pop_back();
+	}
+	m_blocks[blockID] = Block{ poolIndex, pageIndex, offset, count, true };
+
+	return blockID;
+}
+
+void MeshArena::CreatePage(Pool& pool, uint32_t capacity)
+{
+	Page& page = pool.pages.emplace_back();
+	page.capacity = capacity;
+	page.freeRanges.push_back(Range{ 0U, capacity });
+	page.data.resize(static_cast<size_t>(capacity) * pool.elementSize);
+	if (pool.isIndex)
+	{
+		bgfx::DynamicIndexBufferHandle handle = bgfx::createDynamicIndexBuffer(capacity, sizeof(uint32_t) == pool.elementSize ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE);
+		assert(bgfx::isValid(handle));
+		page.bufferHandle = handle.idx;
+	}
+	else
+	{
+		bgfx::DynamicVertexBufferHandle handle = bgfx::createDynamicVertexBuffer(capacity, pool.vertexLayout);
+		assert(bgfx::isValid(handle));
+		page.bufferHandle = handle.idx;
+	}
+
+	CD_ENGINE_INFO("Mesh arena creates {0} page with {1} bytes.", pool.isIndex ? "index" : "vertex", page.data.size());
+}
+
+void MeshArena::DefragmentPage(uint32_t poolIndex, uint32_t pageIndex)
+{
+	Pool& pool = m_pools[poolIndex];
+	Page& page = pool.pages[pageIndex];
+
+	std::vector<BlockID> pageBlockIDs;
+	for (BlockID blockID = 0U; blockID < m_blocks.size(); ++blockID)
+	{
+		const Block& block = m_blocks[blockID];
+		if (block.isValid && block.poolIndex == poolIndex && block.pageIndex == pageIndex)
+		{
+			pageBlockIDs.push_back(blockID);
+		}
+	}
+	std::sort(pageBlockIDs.begin(), pageBlockIDs.end(), [this](BlockID lhs, BlockID rhs) { return m_blocks[lhs].offset < m_blocks[rhs].offset; });
+
+	// Slide blocks towards the beginning in offset order so that moves never overlap a block not moved yet.
+	uint32_t usedCount = 0U;
+	for (BlockID blockID : pageBlockIDs)
+	{
+		Block& block = m_blocks[blockID];
+		if (block.offset != usedCount)
+		{
+			std::memmove(page.data.data() + static_cast<size_t>(usedCount) * pool.elementSize,
+				page.data.data() + static_cast<size_t>(block.offset) * pool.elementSize,
+				static_cast<size_t>(block.count) * pool.elementSize);
+			block.offset = usedCount;
+		}
+		usedCount += block.count;
+	}
+
+	page.freeRanges.clear();
+	if (usedCount < page.capacity)
+	{
+		page.freeRanges.push_back(Range{ usedCount, page.capacity - usedCount });
+	}
+
+	if (usedCount > 0U)
+	{
+		const bgfx::Memory* pMemory = bgfx::copy(page.data.data(), usedCount * pool.elementSize);
+		if (pool.isIndex)
+		{
+			bgfx::update(bgfx::DynamicIndexBufferHandle{ page.bufferHandle }, 0U, pMemory);
+		}
+		else
+		{
+			bgfx::update(bgfx::DynamicVertexBufferHandle{ page.bufferHandle }, 0U, pMemory);
+		}
+	}
+}
+
+}
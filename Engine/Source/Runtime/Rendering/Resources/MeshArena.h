@@ -0,0 +1,102 @@
+#pragma once
+
+#include <bgfx/bgfx.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine
+{
+
+struct MeshArenaStats
+{
+	uint32_t pageCount = 0U;
+	uint32_t blockCount = 0U;
+	uint64_t capacityBytes = 0U;
+	uint64_t usedBytes = 0U;
+	uint32_t freeRangeCount = 0U;
+};
+
+// MeshArena suballocates static mesh vertex and index streams from a few large dynamic buffers.
+// Vertex pages are grouped by vertex layout and index pages by index size so that meshes in the same page share one buffer binding.
+// Blocks are referenced by id instead of offset because defragmentation moves them. Query offsets when submitting draw calls.
+// bgfx buffers can't be read back so every page keeps a CPU copy to re-upload moved blocks.
+class MeshArena final
+{
+public:
+	using BlockID = uint32_t;
+	static constexpr BlockID InvalidBlockID = UINT32_MAX;
+
+	static constexpr uint32_t VertexPageBytes = 32U * 1024U * 1024U;
+	static constexpr uint32_t IndexPageBytes = 16U * 1024U * 1024U;
+	// Pages with more free ranges than it are compacted.
+	static constexpr uint32_t MaxFreeRangeCount = 8U;
+
+public:
+	MeshArena() = default;
+	MeshArena(const MeshArena&) = delete;
+	MeshArena& operator=(const MeshArena&) = delete;
+	MeshArena(MeshArena&&) = delete;
+	MeshArena& operator=(MeshArena&&) = delete;
+	~MeshArena();
+
+	BlockID AllocateVertices(const bgfx::VertexLayout& vertexLayout, std::span<const std::byte> vertexBuffer);
+	BlockID AllocateIndices(uint32_t indexSize, std::span<const std::byte> indexBuffer);
+	void Free(BlockID blockID);
+
+	// Buffer handle is bgfx::DynamicVertexBufferHandle or bgfx::DynamicIndexBufferHandle based on the block type.
+	uint16_t GetBufferHandle(BlockID blockID) const;
+	// Offset and count are in vertices or indices.
+	uint32_t GetOffset(BlockID blockID) const;
+	uint32_t GetCount(BlockID blockID) const;
+
+	// Compacts at most one fragmented page so that upload cost per frame is bounded.
+	void Defragment();
+
+	MeshArenaStats GetStats() const;
+
+private:
+	struct Range
+	{
+		uint32_t offset;
+		uint32_t count;
+	};
+
+	struct Page
+	{
+		uint16_t bufferHandle = UINT16_MAX;
+		uint32_t capacity = 0U;
+		std::vector<Range> freeRanges;
+		std::vector<std::byte> data;
+	};
+
+	struct Pool
+	{
+		bool isIndex = false;
+		uint32_t elementSize = 0U;
+		bgfx::VertexLayout vertexLayout;
+		std::vector<Page> pages;
+	};
+
+	struct Block
+	{
+		uint32_t poolIndex;
+		uint32_t pageIndex;
+		uint32_t offset;
+		uint32_t count;
+		bool isValid;
+	};
+
+	uint32_t GetPoolIndex(bool isIndex, uint32_t elementSize, const bgfx::VertexLayout* pVertexLayout);
+	BlockID Allocate(uint32_t poolIndex, std::span<const std::byte> data);
+	void CreatePage(Pool& pool, uint32_t capacity);
+	void DefragmentPage(uint32_t poolIndex, uint32_t pageIndex);
+
+private:
+	std::vector<Pool> m_pools;
+	std::vector<Block> m_blocks;
+	std::vector<BlockID> m_freeBlockIDs;
+};
+
+}
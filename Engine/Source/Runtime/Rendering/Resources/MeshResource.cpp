@@ -1,20 +1,25 @@
 #include "MeshResource.h"
 
+#include "GPUResourceRegistry.h"
 #include "Log/Log.h"
+#include "MeshArena.h"
 #include "Rendering/Utility/VertexLayoutUtility.h"
+#include "Resources/CookedScene.h"
 #include "Utilities/MeshUtils.hpp"
 
+#include <algorithm>
+
 namespace details
 {
 
-uint16_t SubmitVertexBuffer(const engine::MeshResource::VertexBuffer& vertexBuffer, const cd::VertexFormat& vertexFormat)
+bgfx::VertexBufferHandle SubmitVertexBuffer(std::span<const std::byte> vertexBuffer, const cd::VertexFormat& vertexFormat, engine::VertexLayoutVariant layoutVariant)
 {
 	bgfx::VertexLayout vertexLayout;
-	engine::VertexLayoutUtility::CreateVertexLayout(vertexLayout, vertexFormat.GetVertexAttributeLayouts());
+	engine::VertexLayoutUtility::CreateVertexLayout(vertexLayout, vertexFormat.GetVertexAttributeLayouts(), layoutVariant);
 	const bgfx::Memory* pVertexBufferRef = bgfx::makeRef(vertexBuffer.data(), static_cast<uint32_t>(vertexBuffer.size()));
 	bgfx::VertexBufferHandle vertexBufferHandle = bgfx::createVertexBuffer(pVertexBufferRef, vertexLayout);
 	assert(bgfx::isValid(vertexBufferHandle));
-	return vertexBufferHandle.idx;
+	return vertexBufferHandle;
 }
 
 enum class IndexBufferType
@@ -24,7 +29,7 @@ enum class IndexBufferType
 };
 
 template<IndexBufferType IBT = IndexBufferType::Static>
-uint16_t SubmitIndexBuffer(const engine::MeshResource::IndexBuffer& indexBuffer, bool useU16Index = false)
+uint16_t SubmitIndexBuffer(std::span<const std::byte> indexBuffer, bool useU16Index = false)
 {
 	const bgfx::Memory* pIndexBufferRef = bgfx::makeRef(indexBuffer.data(), static_cast<uint32_t>(indexBuffer.size()));
 	if constexpr (IndexBufferType::Static == IBT)
@@ -54,19 +59,48 @@ MeshResource::MeshResource() = default;
 
 MeshResource::~MeshResource()
 {
-	// Collect garbage intermediatly.
+	// Collect garbage intermediatly. GPU buffers are released to the registry which destroys them after frames in flight.
 	SetStatus(ResourceStatus::Garbage);
 	Update();
 }
 
 uint16_t MeshResource::GetVertexBufferHandle() const
 {
-	return m_vertexBufferHandle;
+	return m_pMeshArena ? m_pMeshArena->GetBufferHandle(m_vertexBlockID) : GetGPUResourceRegistry()->Get(m_vertexBufferHandle).idx;
+}
+
+uint32_t MeshResource::GetStartVertex() const
+{
+	// Blocks may move after arena defragmentation so don't cache offsets.
+	return m_pMeshArena ? m_pMeshArena->GetOffset(m_vertexBlockID) : 0U;
 }
 
 uint16_t MeshResource::GetIndexBufferHandle(uint32_t index) const
 {
-	return m_indexBufferHandles[index];
+	return m_pMeshArena ? m_pMeshArena->GetBufferHandle(m_indexBlockIDs[index]) : GetGPUResourceRegistry()->Get(m_indexBufferHandles[index]).idx;
+}
+
+uint32_t MeshResource::GetStartIndex(uint32_t index) const
+{
+	return m_pMeshArena ? m_pMeshArena->GetOffset(m_indexBlockIDs[index]) : 0U;
+}
+
+uint32_t MeshResource::GetLodCount(uint32_t polygonGroupIndex) const
+{
+	return polygonGroupIndex < m_lods.size() ? static_cast<uint32_t>(m_lods[polygonGroupIndex].size()) : 1U;
+}
+
+MeshLod MeshResource::GetLod(uint32_t polygonGroupIndex, uint32_t lodIndex) const
+{
+	if (polygonGroupIndex >= m_lods.size() || m_lods[polygonGroupIndex].empty())
+	{
+		// A block in arena doesn't extend to the end of its buffer.
+		bool hasIndexBlock = m_pMeshArena && polygonGroupIndex < m_indexBlockIDs.size();
+		return MeshLod{ 0U, hasIndexBlock ? m_pMeshArena->GetCount(m_indexBlockIDs[polygonGroupIndex]) : UINT32_MAX };
+	}
+
+	const std::vector<MeshLod>& lods = m_lods[polygonGroupIndex];
+	return lods[std::min(lodIndex, static_cast<uint32_t>(lods.size()) - 1U)];
 }
 
 void MeshResource::SetMeshAsset(const cd::Mesh* pMeshAsset)
@@ -74,6 +108,14 @@ void MeshResource::SetMeshAsset(const cd::Mesh* pMeshAsset)
 	m_pMeshAsset = pMeshAsset;
 }
 
+void MeshResource::SetCookedMesh(const CookedScene* pCookedScene, uint32_t meshIndex)
+{
+	m_pCookedScene = pCookedScene;
+	m_cookedMeshIndex = meshIndex;
+	m_currentVertexFormat = CookedScene::GetVertexFormat(pCookedScene->GetMesh(meshIndex));
+	m_isQuantized = pCookedScene->GetMesh(meshIndex).flags & CookedSceneFormat::QuantizedAttributes;
+}
+
 void MeshResource::UpdateVertexFormat(const cd::VertexFormat& vertexFormat)
 {
 	// Set mesh asset at first so that MeshResource can analyze if it is suitable.
@@ -108,7 +150,25 @@ void MeshResource::Update()
 	{
 	case ResourceStatus::Loading:
 	{
-		if (m_pMeshAsset)
+		if (m_pCookedScene)
+		{
+			const CookedSceneFormat::Mesh& cookedMesh = m_pCookedScene->GetMesh(m_cookedMeshIndex);
+			m_vertexCount = cookedMesh.vertexCount;
+			m_polygonCount = cookedMesh.polygonCount;
+			m_polygonGroupCount = cookedMesh.polygonGroupCount;
+			m_lods.resize(m_polygonGroupCount);
+			for (uint32_t polygonGroupIndex = 0U; polygonGroupIndex < m_polygonGroupCount; ++polygonGroupIndex)
+			{
+				const CookedSceneFormat::PolygonGroup& polygonGroup = m_pCookedScene->GetPolygonGroup(cookedMesh, polygonGroupIndex);
+				m_lods[polygonGroupIndex].clear();
+				for (uint32_t lodIndex = 0U; lodIndex < std::min(polygonGroup.lodCount, CookedSceneFormat::MaxLodCount); ++lodIndex)
+				{
+					m_lods[polygonGroupIndex].push_back(MeshLod{ polygonGroup.lods[lodIndex].startIndex, polygonGroup.lods[lodIndex].indexCount });
+				}
+			}
+			SetStatus(ResourceStatus::Loaded);
+		}
+		else if (m_pMeshAsset)
 		{
 			m_vertexCount = m_pMeshAsset->GetVertexCount();
 			m_polygonCount = m_pMeshAsset->GetPolygonCount();
@@ -127,8 +187,14 @@ void MeshResource::Update()
 	}
 	case ResourceStatus::Building:
 	{
-		BuildVertexBuffer();
-		BuildIndexBuffer();
+		// Cooked streams are already in GPU layout.
+		if (!m_pCookedScene)
+		{
+			BuildVertexBuffer();
+			BuildIndexBuffer();
+			OptimizeMeshData();
+			UpdateCPUMemory();
+		}
 		SetStatus(ResourceStatus::Built);
 		break;
 	}
@@ -196,7 +262,8 @@ bool MeshResource::BuildIndexBuffer()
 	assert(m_pMeshAsset && m_polygonCount > 0U && m_polygonGroupCount > 0U);
 
 	// IndexBuffer seems not necessary to rebuild many times so we only rebuild it when detect empty data.
-	if (!m_indexBuffers.empty())
+	// Optimization remaps indices together with the vertex buffer so they are always rebuilt together.
+	if (!m_indexBuffers.empty() && !m_optimizeOptions.IsEnabled())
 	{
 		bool rebuild = false;
 		for (const auto& indexBuffer : m_indexBuffers)
@@ -233,72 +300,147 @@ bool MeshResource::BuildIndexBuffer()
 	return result;
 }
 
+void MeshResource::OptimizeMeshData()
+{
+	m_isQuantized = false;
+	m_lods.clear();
+	if (!m_optimizeOptions.IsEnabled() || m_vertexBuffer.empty() || m_indexBuffers.size() != m_polygonGroupCount)
+	{
+		return;
+	}
+
+	m_optimizeStats = MeshOptimizer::Optimize(m_optimizeOptions, m_vertexBuffer, m_currentVertexFormat, m_vertexCount, m_indexBuffers, m_lods);
+	m_isQuantized = m_optimizeStats.quantizedMeshCount > 0U;
+	CD_ENGINE_INFO("Optimized mesh {0} : vertex buffer {1} -> {2} bytes, vertex shader invocations {3} -> {4}.",
+		m_pMeshAsset->GetName(), m_optimizeStats.vertexBufferBytesBefore, m_optimizeStats.vertexBufferBytesAfter,
+		m_optimizeStats.vertexShaderInvocationsBefore, m_optimizeStats.vertexShaderInvocationsAfter);
+}
+
 void MeshResource::SubmitVertexBuffer()
 {
-	if (m_vertexBufferHandle != UINT16_MAX)
+	if (m_vertexBufferHandle.IsValid() || m_vertexBlockID != MeshArena::InvalidBlockID)
+	{
+		return;
+	}
+
+	// Mapped file keeps alive as long as the cooked scene so it is safe to reference without a copy.
+	std::span<const std::byte> vertexBuffer = m_pCookedScene ? m_pCookedScene->GetVertexData(m_pCookedScene->GetMesh(m_cookedMeshIndex)) : std::span<const std::byte>(m_vertexBuffer);
+	const VertexLayoutVariant layoutVariant = m_isQuantized ? VertexLayoutVariant::Quantized : VertexLayoutVariant::Full;
+	if (m_pMeshArena)
 	{
+		bgfx::VertexLayout vertexLayout;
+		VertexLayoutUtility::CreateVertexLayout(vertexLayout, m_currentVertexFormat.GetVertexAttributeLayouts(), layoutVariant);
+		m_vertexBlockID = m_pMeshArena->AllocateVertices(vertexLayout, vertexBuffer);
 		return;
 	}
 
-	m_vertexBufferHandle = details::SubmitVertexBuffer(m_vertexBuffer, m_currentVertexFormat);
+	m_vertexBufferHandle = GetGPUResourceRegistry()->Register(details::SubmitVertexBuffer(vertexBuffer, m_currentVertexFormat, layoutVariant));
 }
 
 void MeshResource::SubmitIndexBuffer()
 {
-	if (!m_indexBufferHandles.empty())
+	if (m_pCookedScene)
 	{
-		bool submit = false;
-		for (uint16_t indexBufferHandle : m_indexBufferHandles)
+		const CookedSceneFormat::Mesh& cookedMesh = m_pCookedScene->GetMesh(m_cookedMeshIndex);
+		m_indexBufferHandles.resize(cookedMesh.polygonGroupCount);
+		for (uint32_t polygonGroupIndex = 0U; polygonGroupIndex < cookedMesh.polygonGroupCount; ++polygonGroupIndex)
 		{
-			if (indexBufferHandle == UINT16_MAX)
-			{
-				submit = true;
-				break;
-			}
-		}
-
-		if (!submit)
-		{
-			return;
+			const CookedSceneFormat::PolygonGroup& polygonGroup = m_pCookedScene->GetPolygonGroup(cookedMesh, polygonGroupIndex);
+			SubmitIndexBuffer(polygonGroupIndex, m_pCookedScene->GetIndexData(polygonGroup), polygonGroup.indexSize);
 		}
+		return;
 	}
 
 	size_t indexBufferCount = m_indexBuffers.size();
 	assert(indexBufferCount > 0);
-	m_indexBufferHandles.resize(indexBufferCount, UINT16_MAX);
+	m_indexBufferHandles.resize(indexBufferCount);
 
-	const bool useU16Index = m_vertexCount <= static_cast<uint32_t>(std::numeric_limits<uint16_t>::max()) + 1U;
+	const uint32_t indexSize = GetIndexSize(m_vertexCount);
 	for (size_t bufferIndex = 0; bufferIndex < indexBufferCount; ++bufferIndex)
 	{
 		const auto& indexBuffer = m_indexBuffers[bufferIndex];
 		assert(!indexBuffer.empty());
-		m_indexBufferHandles[bufferIndex] = details::SubmitIndexBuffer(indexBuffer, useU16Index);
+		SubmitIndexBuffer(static_cast<uint32_t>(bufferIndex), indexBuffer, indexSize);
+	}
+}
+
+void MeshResource::SubmitIndexBuffer(uint32_t polygonGroupIndex, std::span<const std::byte> indexBuffer, uint32_t indexSize)
+{
+	if (m_pMeshArena)
+	{
+		m_indexBlockIDs.resize(m_indexBufferHandles.size(), MeshArena::InvalidBlockID);
+		if (MeshArena::InvalidBlockID == m_indexBlockIDs[polygonGroupIndex])
+		{
+			m_indexBlockIDs[polygonGroupIndex] = m_pMeshArena->AllocateIndices(indexSize, indexBuffer);
+		}
+		return;
+	}
+
+	if (!m_indexBufferHandles[polygonGroupIndex].IsValid())
+	{
+		bgfx::IndexBufferHandle indexBufferHandle{ details::SubmitIndexBuffer(indexBuffer, sizeof(uint16_t) == indexSize) };
+		m_indexBufferHandles[polygonGroupIndex] = GetGPUResourceRegistry()->Register(indexBufferHandle);
 	}
 }
 
 void MeshResource::FreeMeshData()
 {
 	m_vertexBuffer.clear();
+	m_vertexBuffer.shrink_to_fit();
 	m_indexBuffers.clear();
+	UpdateCPUMemory();
+}
+
+void MeshResource::UpdateCPUMemory()
+{
+	size_t size = m_vertexBuffer.capacity();
+	for (const auto& indexBuffer : m_indexBuffers)
+	{
+		size += indexBuffer.capacity();
+	}
+	m_cpuMemory.Set(size);
 }
 
 void MeshResource::DestroyVertexBufferHandle()
 {
-	if (m_vertexBufferHandle != UINT16_MAX)
+	if (m_pMeshArena)
+	{
+		if (m_vertexBlockID != MeshArena::InvalidBlockID)
+		{
+			m_pMeshArena->Free(m_vertexBlockID);
+			m_vertexBlockID = MeshArena::InvalidBlockID;
+		}
+		return;
+	}
+
+	if (m_vertexBufferHandle.IsValid())
 	{
-		bgfx::destroy(bgfx::VertexBufferHandle{ m_vertexBufferHandle });
-		m_vertexBufferHandle = UINT16_MAX;
+		GetGPUResourceRegistry()->Release(m_vertexBufferHandle);
+		m_vertexBufferHandle = {};
 	}
 }
 
 void MeshResource::DestroyIndexBufferHandle()
 {
-	for (uint16_t indexBufferHandle : m_indexBufferHandles)
+	if (m_pMeshArena)
+	{
+		for (uint32_t indexBlockID : m_indexBlockIDs)
+		{
+			if (indexBlockID != MeshArena::InvalidBlockID)
+			{
+				m_pMeshArena->Free(indexBlockID);
+			}
+		}
+		m_indexBlockIDs.clear();
+		m_indexBufferHandles.clear();
+		return;
+	}
+
+	for (GPUHandle<bgfx::IndexBufferHandle> indexBufferHandle : m_indexBufferHandles)
 	{
-		if (indexBufferHandle != UINT16_MAX)
+		if (indexBufferHandle.IsValid())
 		{
-			bgfx::destroy(bgfx::IndexBufferHandle{ indexBufferHandle });
-			indexBufferHandle = UINT16_MAX;
+			GetGPUResourceRegistry()->Release(indexBufferHandle);
 		}
 	}
 
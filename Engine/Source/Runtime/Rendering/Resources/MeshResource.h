@@ -1,8 +1,12 @@
 #pragma once
 
+#include "Core/Memory/MemoryTracker.h"
+#include "GPUResourceRegistry.h"
 #include "IResource.h"
+#include "Rendering/Utility/MeshOptimizer.h"
 #include "Scene/VertexFormat.h"
 
+#include <span>
 #include <vector>
 
 namespace cd
@@ -15,12 +19,22 @@ class Mesh;
 namespace engine
 {
 
+class CookedScene;
+class MeshArena;
+
 class MeshResource : public IResource
 {
 public:
 	using VertexBuffer = std::vector<std::byte>;
 	using IndexBuffer = std::vector<std::byte>;
 
+public:
+	// Index buffers built by MeshUtils use 16 bits indices when all vertices can be addressed.
+	static constexpr uint32_t GetIndexSize(uint32_t vertexCount)
+	{
+		return vertexCount <= static_cast<uint32_t>(UINT16_MAX) + 1U ? sizeof(uint16_t) : sizeof(uint32_t);
+	}
+
 public:
 	MeshResource();
 	MeshResource(const MeshResource&) = default;
@@ -34,43 +48,80 @@ public:
 
 	const cd::Mesh* GetMeshAsset() const { return m_pMeshAsset; }
 	void SetMeshAsset(const cd::Mesh* pMeshAsset);
+
+	// Use prebuilt vertex and index streams inside a mapped cooked scene instead of building from mesh asset.
+	// Vertex format is fixed at cook time so UpdateVertexFormat is not needed.
+	void SetCookedMesh(const CookedScene* pCookedScene, uint32_t meshIndex);
+	const CookedScene* GetCookedScene() const { return m_pCookedScene; }
 	
 	void UpdateVertexFormat(const cd::VertexFormat& vertexFormat);
+
+	// Suballocate GPU buffers from a shared arena instead of creating own buffers. Set before submitting to GPU.
+	// Buffer handles are dynamic buffer handles and draw calls need start vertex/index offsets.
+	void SetMeshArena(MeshArena* pMeshArena) { m_pMeshArena = pMeshArena; }
+	bool IsInMeshArena() const { return m_pMeshArena != nullptr; }
+
+	// Optional steps to run after building CPU buffers. Need to reset the resource to apply changes.
+	void SetOptimizeOptions(const MeshOptimizeOptions& options) { m_optimizeOptions = options; }
+	const MeshOptimizeOptions& GetOptimizeOptions() const { return m_optimizeOptions; }
+	const MeshOptimizeStats& GetOptimizeStats() const { return m_optimizeStats; }
+	bool IsQuantized() const { return m_isQuantized; }
+
+	// Detail levels generated by MeshOptimizer. A polygon group without generated levels has only one level.
+	uint32_t GetLodCount(uint32_t polygonGroupIndex) const;
+	// lodIndex is clamped to the coarsest level. indexCount is UINT32_MAX when the whole index buffer is used.
+	// startIndex is relative to GetStartIndex of the polygon group.
+	MeshLod GetLod(uint32_t polygonGroupIndex, uint32_t lodIndex) const;
 	
 	uint32_t GetVertexCount() const { return m_vertexCount; }
 	uint32_t GetPolygonCount() const { return m_polygonCount; }
 	uint32_t GetPolygonGroupCount() const { return m_polygonGroupCount; }
 	uint16_t GetVertexBufferHandle() const;
+	uint32_t GetStartVertex() const;
 	uint32_t GetIndexBufferCount() const { return static_cast<uint32_t>(m_indexBufferHandles.size()); }
 	uint16_t GetIndexBufferHandle(uint32_t index) const;
+	uint32_t GetStartIndex(uint32_t index) const;
 
 private:
 	bool BuildVertexBuffer();
 	bool BuildIndexBuffer();
+	void OptimizeMeshData();
 	void SubmitVertexBuffer();
 	void SubmitIndexBuffer();
+	void SubmitIndexBuffer(uint32_t polygonGroupIndex, std::span<const std::byte> indexBuffer, uint32_t indexSize);
 	void FreeMeshData();
+	void UpdateCPUMemory();
 	void DestroyVertexBufferHandle();
 	void DestroyIndexBufferHandle();
 
 private:
 	// Asset
 	const cd::Mesh* m_pMeshAsset = nullptr;
+	const CookedScene* m_pCookedScene = nullptr;
+	uint32_t m_cookedMeshIndex = 0U;
 	uint32_t m_vertexCount = 0U;
 	uint32_t m_polygonCount = 0U;
 	uint32_t m_polygonGroupCount = 0U;
 
 	// Runtime
 	cd::VertexFormat m_currentVertexFormat;
+	MeshOptimizeOptions m_optimizeOptions;
+	MeshOptimizeStats m_optimizeStats;
+	bool m_isQuantized = false;
+	std::vector<std::vector<MeshLod>> m_lods;
 
 	// CPU
 	VertexBuffer m_vertexBuffer;
 	std::vector<IndexBuffer> m_indexBuffers;
+	TrackedMemorySize m_cpuMemory{ MemoryTag::Mesh };
 	uint32_t m_recycleCount = 0;
 
 	// GPU
-	uint16_t m_vertexBufferHandle = UINT16_MAX;
-	std::vector<uint16_t> m_indexBufferHandles;
+	GPUHandle<bgfx::VertexBufferHandle> m_vertexBufferHandle;
+	std::vector<GPUHandle<bgfx::IndexBufferHandle>> m_indexBufferHandles;
+	MeshArena* m_pMeshArena = nullptr;
+	uint32_t m_vertexBlockID = UINT32_MAX;
+	std::vector<uint32_t> m_indexBlockIDs;
 };
 
 }
\ No newline at end of file
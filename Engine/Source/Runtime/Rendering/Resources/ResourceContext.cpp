@@ -1,22 +1,41 @@
 #include "ResourceContext.h"
 
 #include "Base/NameOf.h"
+#include "Base/Template.h"
+#include "MeshArena.h"
 #include "MeshResource.h"
+#include "Profiling/Profiling.h"
+#include "Resources/CookedScene.h"
 #include "TextureResource.h"
+#include "TextureStreamer.h"
 
 namespace engine
 {
 
+ResourceContext::ResourceContext(GPUResourceRegistry* pGPUResourceRegistry)
+	: m_pGPUResourceRegistry(pGPUResourceRegistry)
+	, m_pMeshArena(std::make_unique<MeshArena>())
+	, m_pTextureStreamer(std::make_unique<TextureStreamer>())
+{
+}
+
 ResourceContext::~ResourceContext()
 {
+	// Destroy resources before unmapping the cooked data they refer to.
+	m_resources.clear();
+	m_cookedScenes.clear();
 }
 
 void ResourceContext::Update()
 {
+	CD_PROFILE_SCOPE("ResourceContext::Update");
 	for (auto& [_, resource] : m_resources)
 	{
 		resource->Update();
 	}
+
+	m_pMeshArena->Defragment();
+	m_pTextureStreamer->Update();
 }
 
 StringCrc ResourceContext::GetResourceCrc(ResourceType resourceType, StringCrc nameCrc)
@@ -46,6 +65,26 @@ TextureResource* ResourceContext::GetTextureResource(StringCrc nameCrc)
 	return static_cast<TextureResource*>(GetResourceImpl<ResourceType::Texture>(nameCrc));
 }
 
+CookedScene* ResourceContext::AddCookedScene(const char* pFilePath)
+{
+	StringCrc fileCrc(pFilePath);
+	auto itCookedScene = m_cookedScenes.find(fileCrc);
+	if (itCookedScene != m_cookedScenes.end())
+	{
+		return itCookedScene->second.get();
+	}
+
+	auto pCookedScene = std::make_unique<CookedScene>();
+	if (!pCookedScene->Open(pFilePath))
+	{
+		return nullptr;
+	}
+
+	CookedScene* pResult = pCookedScene.get();
+	m_cookedScenes[fileCrc] = cd::MoveTemp(pCookedScene);
+	return pResult;
+}
+
 template<ResourceType RT>
 IResource* ResourceContext::AddResourceImpl(StringCrc nameCrc)
 {
@@ -62,11 +101,14 @@ IResource* ResourceContext::AddResourceImpl(StringCrc nameCrc)
 	}
 	else if constexpr (ResourceType::Texture == RT)
 	{
-		m_resources[resourceCrc] = std::make_unique<TextureResource>();
+		auto pTextureResource = std::make_unique<TextureResource>();
+		m_pTextureStreamer->AddTexture(pTextureResource.get());
+		m_resources[resourceCrc] = cd::MoveTemp(pTextureResource);
 	}
 
 	auto* pResource = m_resources[resourceCrc].get();
 	pResource->SetName(nameCrc);
+	pResource->SetGPUResourceRegistry(m_pGPUResourceRegistry);
 	return pResource;
 }
 
@@ -9,14 +9,18 @@ namespace engine
 {
 
 enum class ResourceType;
+class CookedScene;
+class GPUResourceRegistry;
 class IResource;
+class MeshArena;
 class MeshResource;
 class TextureResource;
+class TextureStreamer;
 
 class ResourceContext
 {
 public:
-	ResourceContext() = default;
+	explicit ResourceContext(GPUResourceRegistry* pGPUResourceRegistry);
 	ResourceContext(const ResourceContext&) = delete;
 	ResourceContext& operator=(const ResourceContext&) = delete;
 	ResourceContext(ResourceContext&&) = delete;
@@ -32,6 +36,15 @@ public:
 	MeshResource* GetMeshResource(StringCrc nameCrc);
 	TextureResource* GetTextureResource(StringCrc nameCrc);
 
+	// Shared GPU buffers for static meshes. Mesh resources opt in by MeshResource::SetMeshArena.
+	MeshArena* GetMeshArena() const { return m_pMeshArena.get(); }
+
+	// Decides resident mips of all texture resources under a memory budget.
+	TextureStreamer* GetTextureStreamer() const { return m_pTextureStreamer.get(); }
+
+	// Cooked scenes are kept mapped until ResourceContext destructs because mesh resources refer to their data.
+	CookedScene* AddCookedScene(const char* pFilePath);
+
 private:
 	template<ResourceType RT>
 	IResource* AddResourceImpl(StringCrc nameCrc);
@@ -40,7 +53,11 @@ private:
 	IResource* GetResourceImpl(StringCrc nameCrc);
 
 private:
+	GPUResourceRegistry* m_pGPUResourceRegistry;
+	std::unique_ptr<MeshArena> m_pMeshArena;
+	std::unique_ptr<TextureStreamer> m_pTextureStreamer;
 	std::map<StringCrc, std::unique_ptr<IResource>> m_resources;
+	std::map<StringCrc, std::unique_ptr<CookedScene>> m_cookedScenes;
 };
 
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "TextureResource.h"
 
+#include "Core/Memory/TrackedBxAllocator.h"
+#include "GPUResourceRegistry.h"
 #include "Log/Log.h"
 #include "Resources/ResourceLoader.h"
 #include "Scene/Texture.h"
@@ -8,14 +10,20 @@
 #include <bimg/decode.h>
 #include <bx/allocator.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <format>
 
 namespace details
 {
 
+// Textures start with mips not larger than this size and stream in more detailed mips on request.
+constexpr uint32_t InitialResidentSize = 64U;
+
 static bx::AllocatorI* GetResourceAllocator()
 {
-	static bx::DefaultAllocator s_allocator;
+	static engine::TrackedBxAllocator s_allocator(engine::MemoryTag::Texture);
 	return &s_allocator;
 }
 
@@ -55,7 +63,7 @@ TextureResource::TextureResource() = default;
 
 TextureResource::~TextureResource()
 {
-	// Collect garbage intermediatly.
+	// Collect garbage intermediatly. Texture is released to the registry which destroys it after frames in flight.
 	SetStatus(ResourceStatus::Garbage);
 	Update();
 }
@@ -93,6 +101,7 @@ void TextureResource::Update()
 			// TODO : build texture
 			//m_textureRawData = engine::ResourceLoader::LoadFile(m_pTextureAsset->GetPath());
 			m_textureRawData = engine::ResourceLoader::LoadFile(m_ddsFilePath.c_str());
+			m_rawDataMemory.Set(m_textureRawData.capacity());
 			SetStatus(ResourceStatus::Loaded);
 		}
 		break;
@@ -116,7 +125,8 @@ void TextureResource::Update()
 		if (m_textureImageData != nullptr)
 		{
 			BuildSamplerHandle();
-			BuildTextureHandle();
+			BuildMipInfo();
+			BuildTextureHandle(m_targetMip);
 			m_recycleCount = 0U;
 			SetStatus(ResourceStatus::Ready);
 		}
@@ -124,6 +134,13 @@ void TextureResource::Update()
 	}
 	case ResourceStatus::Ready:
 	{
+		if (m_targetMip != m_residentMip)
+		{
+			BuildTextureHandle(m_targetMip);
+			m_recycleCount = 0U;
+			break;
+		}
+
 		// Release CPU data later to save memory.
 		constexpr uint32_t recycleDelayFrames = 30U;
 		if (m_recycleCount++ >= recycleDelayFrames)
@@ -135,6 +152,18 @@ void TextureResource::Update()
 		}
 		break;
 	}
+	case ResourceStatus::Optimized:
+	{
+		// CPU data is released so reload the file to rebuild texture in target mips.
+		// Current texture keeps valid until the new one is created.
+		if (m_targetMip != m_residentMip && ReloadTextureData())
+		{
+			BuildTextureHandle(m_targetMip);
+			m_recycleCount = 0U;
+			SetStatus(ResourceStatus::Ready);
+		}
+		break;
+	}
 	case ResourceStatus::Garbage:
 	{
 		DestroySamplerHandle();
@@ -148,6 +177,46 @@ void TextureResource::Update()
 	}
 }
 
+void TextureResource::SetTargetMip(uint32_t mip)
+{
+	m_targetMip = m_mipBytes.empty() ? 0U : std::min(mip, GetMipCount() - 1U);
+}
+
+uint64_t TextureResource::GetMipChainBytes(uint32_t firstMip) const
+{
+	uint64_t bytes = 0U;
+	for (uint32_t mip = firstMip; mip < m_mipBytes.size(); ++mip)
+	{
+		bytes += m_mipBytes[mip];
+	}
+
+	return bytes;
+}
+
+void TextureResource::RequestScreenSize(float screenPixels)
+{
+	if (!IsStreamable())
+	{
+		return;
+	}
+
+	// One texel per pixel is enough so skip mips which are larger than the surface on screen.
+	float texelCount = static_cast<float>(std::max(m_width, m_height));
+	uint32_t mip = 0U;
+	if (screenPixels < texelCount)
+	{
+		mip = static_cast<uint32_t>(std::floor(std::log2(texelCount / std::max(screenPixels, 1.0f))));
+	}
+	m_frameRequestedMip = std::min(m_frameRequestedMip, std::min(mip, GetMipCount() - 1U));
+}
+
+uint32_t TextureResource::ConsumeFrameRequestedMip()
+{
+	uint32_t requestedMip = m_frameRequestedMip;
+	m_frameRequestedMip = UINT32_MAX;
+	return requestedMip;
+}
+
 void TextureResource::Reset()
 {
 	DestroySamplerHandle();
@@ -203,19 +272,98 @@ void TextureResource::BuildSamplerHandle()
 	assert(m_samplerHandle != UINT16_MAX);
 }
 
-void TextureResource::BuildTextureHandle()
+void TextureResource::BuildMipInfo()
 {
-	assert(m_textureHandle == UINT16_MAX);
 	auto* pImageContainer = reinterpret_cast<bimg::ImageContainer*>(m_textureImageData);
-	const bgfx::Memory* pImageContent = bgfx::makeRef(pImageContainer->m_data, pImageContainer->m_size);
-	m_textureHandle = details::BGFXCreateTexture(pImageContainer->m_width, pImageContainer->m_height, pImageContainer->m_depth, false, pImageContainer->m_numMips > 1,
-		1, static_cast<bgfx::TextureFormat::Enum>(pImageContainer->m_format), GetTextureFlags(), pImageContent).idx;
-	assert(m_textureHandle != UINT16_MAX);
+	m_width = pImageContainer->m_width;
+	m_height = pImageContainer->m_height;
+	m_mipBytes.clear();
+
+	// Only plain 2D textures stream. Others keep all mips resident.
+	if (pImageContainer->m_cubeMap || pImageContainer->m_depth > 1 || pImageContainer->m_numLayers > 1 || pImageContainer->m_numMips <= 1)
+	{
+		m_mipBytes.push_back(pImageContainer->m_size);
+		m_residentMip = m_targetMip = m_requestedMip = 0U;
+		return;
+	}
+
+	for (uint8_t mip = 0; mip < pImageContainer->m_numMips; ++mip)
+	{
+		bimg::ImageMip imageMip;
+		bimg::imageGetRawData(*pImageContainer, 0, mip, pImageContainer->m_data, pImageContainer->m_size, imageMip);
+		m_mipBytes.push_back(imageMip.m_size);
+	}
+
+	uint32_t initialMip = 0U;
+	while (initialMip + 1U < GetMipCount() && (std::max(m_width, m_height) >> initialMip) > details::InitialResidentSize)
+	{
+		++initialMip;
+	}
+	m_targetMip = m_requestedMip = initialMip;
+	m_residentMip = UINT32_MAX;
+}
+
+bool TextureResource::ReloadTextureData()
+{
+	if (!m_textureImageData)
+	{
+		m_textureRawData = engine::ResourceLoader::LoadFile(m_ddsFilePath.c_str());
+		m_rawDataMemory.Set(m_textureRawData.capacity());
+		if (m_textureRawData.empty())
+		{
+			return false;
+		}
+		m_textureImageData = bimg::imageParse(details::GetResourceAllocator(), m_textureRawData.data(), static_cast<uint32_t>(m_textureRawData.size()));
+	}
+
+	return m_textureImageData != nullptr;
+}
+
+void TextureResource::BuildTextureHandle(uint32_t firstMip)
+{
+	auto* pImageContainer = reinterpret_cast<bimg::ImageContainer*>(m_textureImageData);
+	GPUHandle<bgfx::TextureHandle> oldTextureHandle = m_textureHandle;
+	if (!IsStreamable())
+	{
+		assert(!m_textureHandle.IsValid());
+		const bgfx::Memory* pImageContent = bgfx::makeRef(pImageContainer->m_data, pImageContainer->m_size);
+		m_textureHandle = GetGPUResourceRegistry()->Register(details::BGFXCreateTexture(pImageContainer->m_width, pImageContainer->m_height, pImageContainer->m_depth, false, pImageContainer->m_numMips > 1,
+			1, static_cast<bgfx::TextureFormat::Enum>(pImageContainer->m_format), GetTextureFlags(), pImageContent));
+		assert(m_textureHandle.IsValid());
+		m_residentMip = 0U;
+		return;
+	}
+
+	// Copy mip chain from firstMip as the memory outlives CPU data when texture is rebuilt by streaming.
+	const bgfx::Memory* pImageContent = bgfx::alloc(static_cast<uint32_t>(GetMipChainBytes(firstMip)));
+	uint8_t* pDestination = pImageContent->data;
+	for (uint32_t mip = firstMip; mip < GetMipCount(); ++mip)
+	{
+		bimg::ImageMip imageMip;
+		bimg::imageGetRawData(*pImageContainer, 0, static_cast<uint8_t>(mip), pImageContainer->m_data, pImageContainer->m_size, imageMip);
+		std::memcpy(pDestination, imageMip.m_data, imageMip.m_size);
+		pDestination += imageMip.m_size;
+	}
+
+	uint16_t width = static_cast<uint16_t>(std::max(m_width >> firstMip, 1U));
+	uint16_t height = static_cast<uint16_t>(std::max(m_height >> firstMip, 1U));
+	m_textureHandle = GetGPUResourceRegistry()->Register(details::BGFXCreateTexture(width, height, 1, false, firstMip + 1U < GetMipCount(),
+		1, static_cast<bgfx::TextureFormat::Enum>(pImageContainer->m_format), GetTextureFlags(), pImageContent));
+	assert(m_textureHandle.IsValid());
+	m_residentMip = firstMip;
+
+	// Old texture is destroyed after frames in flight which may still sample it.
+	if (oldTextureHandle.IsValid())
+	{
+		GetGPUResourceRegistry()->Release(oldTextureHandle);
+	}
 }
 
 void TextureResource::FreeTextureData()
 {
 	m_textureRawData.clear();
+	m_textureRawData.shrink_to_fit();
+	m_rawDataMemory.Set(0U);
 
 	if (m_textureImageData)
 	{
@@ -236,10 +384,10 @@ void TextureResource::DestroySamplerHandle()
 
 void TextureResource::DestroyTextureHandle()
 {
-	if (m_textureHandle != UINT16_MAX)
+	if (m_textureHandle.IsValid())
 	{
-		bgfx::destroy(bgfx::TextureHandle{ m_textureHandle });
-		m_textureHandle = UINT16_MAX;
+		GetGPUResourceRegistry()->Release(m_textureHandle);
+		m_textureHandle = {};
 	}
 }
 
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "Core/Memory/MemoryTracker.h"
+#include "GPUResourceRegistry.h"
 #include "IResource.h"
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -43,13 +46,33 @@ public:
 	void SetTextureAsset(const cd::Texture* pTextureAsset);
 
 	uint16_t GetSamplerHandle() const { return m_samplerHandle; }
-	uint16_t GetTextureHandle() const { return m_textureHandle; }
+	uint16_t GetTextureHandle() const { return GetGPUResourceRegistry()->Get(m_textureHandle).idx; }
+
+	// Mip streaming. Mip 0 is the most detailed level and a texture keeps mips from the resident mip to the smallest one.
+	// TextureStreamer decides target mip by requests and memory budget, and Update recreates GPU texture to apply it.
+	bool IsStreamable() const { return m_mipBytes.size() > 1U; }
+	uint32_t GetMipCount() const { return static_cast<uint32_t>(m_mipBytes.size()); }
+	uint32_t GetResidentMip() const { return m_residentMip; }
+	uint32_t GetTargetMip() const { return m_targetMip; }
+	void SetTargetMip(uint32_t mip);
+	uint32_t GetRequestedMip() const { return m_requestedMip; }
+	void SetRequestedMip(uint32_t mip) { m_requestedMip = mip; }
+	uint64_t GetMipChainBytes(uint32_t firstMip) const;
+	uint64_t GetResidentBytes() const { return GetMipChainBytes(m_residentMip); }
+	uint64_t GetRequestedBytes() const { return GetMipChainBytes(m_requestedMip); }
+
+	// Usage feedback from draw submission. screenPixels is the size in pixels of the surface which samples the texture.
+	void RequestScreenSize(float screenPixels);
+	// Returns the most detailed mip requested since last call or UINT32_MAX if the texture was not used.
+	uint32_t ConsumeFrameRequestedMip();
 
 private:
 	uint64_t GetTextureFlags() const;
 
 	void BuildSamplerHandle();
-	void BuildTextureHandle();
+	void BuildTextureHandle(uint32_t firstMip);
+	void BuildMipInfo();
+	bool ReloadTextureData();
 
 	void FreeTextureData();
 
@@ -67,12 +90,23 @@ private:
 
 	// CPU
 	TextureRawData m_textureRawData;
+	TrackedMemorySize m_rawDataMemory{ MemoryTag::Texture };
 	void* m_textureImageData = nullptr;
 	uint32_t m_recycleCount = 0;
 
+	// Streaming
+	uint32_t m_width = 0U;
+	uint32_t m_height = 0U;
+	std::vector<uint64_t> m_mipBytes;
+	uint32_t m_residentMip = 0U;
+	uint32_t m_targetMip = 0U;
+	uint32_t m_requestedMip = 0U;
+	uint32_t m_frameRequestedMip = UINT32_MAX;
+
 	// GPU
+	// bgfx shares uniforms by name with its own reference counts so samplers are not registered.
 	uint16_t m_samplerHandle = UINT16_MAX;
-	uint16_t m_textureHandle = UINT16_MAX;
+	GPUHandle<bgfx::TextureHandle> m_textureHandle;
 };
 
 }
\ No newline at end of file
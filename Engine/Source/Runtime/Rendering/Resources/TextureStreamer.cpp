@@ -0,0 +1,150 @@
+#include "TextureStreamer.h"
+
+#include "TextureResource.h"
+
+#include <algorithm>
+
+namespace engine
+{
+
+void TextureStreamer::AddTexture(TextureResource* pTextureResource)
+{
+	m_textures.push_back(pTextureResource);
+	m_textureStates.emplace_back();
+}
+
+void TextureStreamer::Update()
+{
+	++m_frameIndex;
+
+	uint64_t residentBytes = 0U;
+	std::vector<size_t> streamInTextureIndexes;
+	for (size_t textureIndex = 0; textureIndex < m_textures.size(); ++textureIndex)
+	{
+		TextureResource* pTextureResource = m_textures[textureIndex];
+		uint32_t requestedMip = pTextureResource->ConsumeFrameRequestedMip();
+		if (!pTextureResource->IsStreamable())
+		{
+			residentBytes += pTextureResource->GetResidentBytes();
+			continue;
+		}
+
+		// Unused textures keep their last request so that they stay sharp until memory is needed.
+		if (requestedMip != UINT32_MAX)
+		{
+			m_textureStates[textureIndex].lastUsedFrame = m_frameIndex;
+			pTextureResource->SetRequestedMip(requestedMip);
+		}
+
+		residentBytes += pTextureResource->GetMipChainBytes(pTextureResource->GetTargetMip());
+		if (pTextureResource->GetRequestedMip() < pTextureResource->GetTargetMip())
+		{
+			streamInTextureIndexes.push_back(textureIndex);
+		}
+	}
+
+	// Budget may be lowered at runtime.
+	while (residentBytes > m_budgetBytes && EvictLeastRecentlyUsed(residentBytes, nullptr))
+	{
+	}
+
+	std::sort(streamInTextureIndexes.begin(), streamInTextureIndexes.end(), [this](size_t lhs, size_t rhs)
+	{
+		return m_textureStates[lhs].lastUsedFrame > m_textureStates[rhs].lastUsedFrame;
+	});
+
+	uint32_t streamInCount = 0U;
+	for (size_t textureIndex : streamInTextureIndexes)
+	{
+		if (streamInCount >= MaxStreamInPerFrame)
+		{
+			break;
+		}
+
+		// One mip per step spreads upload cost and lets the budget stop at any level.
+		TextureResource* pTextureResource = m_textures[textureIndex];
+		uint32_t targetMip = pTextureResource->GetTargetMip() - 1U;
+		uint64_t extraBytes = pTextureResource->GetMipChainBytes(targetMip) - pTextureResource->GetMipChainBytes(targetMip + 1U);
+		while (residentBytes + extraBytes > m_budgetBytes && EvictLeastRecentlyUsed(residentBytes, pTextureResource))
+		{
+		}
+
+		if (residentBytes + extraBytes > m_budgetBytes)
+		{
+			break;
+		}
+
+		pTextureResource->SetTargetMip(targetMip);
+		residentBytes += extraBytes;
+		++streamInCount;
+	}
+}
+
+TextureStreamingStats TextureStreamer::GetStats() const
+{
+	TextureStreamingStats stats;
+	stats.textureCount = static_cast<uint32_t>(m_textures.size());
+	stats.budgetBytes = m_budgetBytes;
+	for (const TextureResource* pTextureResource : m_textures)
+	{
+		stats.residentBytes += pTextureResource->GetResidentBytes();
+		stats.requestedBytes += pTextureResource->GetRequestedBytes();
+	}
+
+	return stats;
+}
+
+bool TextureStreamer::EvictLeastRecentlyUsed(uint64_t& residentBytes, const TextureResource* pExcludeTexture)
+{
+	// Prefer textures which have more detail than requested, then the least recently used ones.
+	// Textures used in current frame only give up mips which are not requested.
+	size_t evictTextureIndex = m_textures.size();
+	for (size_t textureIndex = 0; textureIndex < m_textures.size(); ++textureIndex)
+	{
+		const TextureResource* pTextureResource = m_textures[textureIndex];
+		if (pTextureResource == pExcludeTexture || !pTextureResource->IsStreamable() ||
+			pTextureResource->GetTargetMip() + 1U >= pTextureResource->GetMipCount())
+		{
+			continue;
+		}
+
+		bool hasSurplusMip = pTextureResource->GetTargetMip() < pTextureResource->GetRequestedMip();
+		if (!hasSurplusMip && m_textureStates[textureIndex].lastUsedFrame == m_frameIndex)
+		{
+			continue;
+		}
+
+		if (evictTextureIndex == m_textures.size())
+		{
+			evictTextureIndex = textureIndex;
+			continue;
+		}
+
+		const TextureResource* pEvictTexture = m_textures[evictTextureIndex];
+		bool evictHasSurplusMip = pEvictTexture->GetTargetMip() < pEvictTexture->GetRequestedMip();
+		if (hasSurplusMip != evictHasSurplusMip)
+		{
+			if (hasSurplusMip)
+			{
+				evictTextureIndex = textureIndex;
+			}
+		}
+		else if (m_textureStates[textureIndex].lastUsedFrame < m_textureStates[evictTextureIndex].lastUsedFrame)
+		{
+			evictTextureIndex = textureIndex;
+		}
+	}
+
+	if (evictTextureIndex == m_textures.size())
+	{
+		return false;
+	}
+
+	TextureResource* pEvictTexture = m_textures[evictTextureIndex];
+	uint32_t targetMip = pEvictTexture->GetTargetMip();
+	residentBytes -= pEvictTexture->GetMipChainBytes(targetMip) - pEvictTexture->GetMipChainBytes(targetMip + 1U);
+	pEvictTexture->SetTargetMip(targetMip + 1U);
+	return true;
+}
+
+}
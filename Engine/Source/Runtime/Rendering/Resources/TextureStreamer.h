@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace engine
+{
+
+class TextureResource;
+
+struct TextureStreamingStats
+{
+	uint32_t textureCount = 0U;
+	uint64_t residentBytes = 0U;
+	uint64_t requestedBytes = 0U;
+	uint64_t budgetBytes = 0U;
+};
+
+// TextureStreamer decides which mips of textures stay resident on GPU.
+// Textures start with small mips. Usage feedback from draw submission requests more detailed mips, which stream in
+// while resident memory fits the budget. Least recently used textures drop their most detailed mips to make room.
+class TextureStreamer final
+{
+public:
+	static constexpr uint64_t DefaultBudgetBytes = 512U * 1024U * 1024U;
+	// Rebuilding a texture reloads and uploads its mips so bound the work per frame.
+	static constexpr uint32_t MaxStreamInPerFrame = 2U;
+
+public:
+	TextureStreamer() = default;
+	TextureStreamer(const TextureStreamer&) = delete;
+	TextureStreamer& operator=(const TextureStreamer&) = delete;
+	TextureStreamer(TextureStreamer&&) = delete;
+	TextureStreamer& operator=(TextureStreamer&&) = delete;
+	~TextureStreamer() = default;
+
+	void AddTexture(TextureResource* pTextureResource);
+
+	void SetBudgetBytes(uint64_t budgetBytes) { m_budgetBytes = budgetBytes; }
+	uint64_t GetBudgetBytes() const { return m_budgetBytes; }
+
+	// Collects requests of last frame and updates target mips of textures.
+	void Update();
+
+	TextureStreamingStats GetStats() const;
+	const std::vector<TextureResource*>& GetTextures() const { return m_textures; }
+
+private:
+	bool EvictLeastRecentlyUsed(uint64_t& residentBytes, const TextureResource* pExcludeTexture);
+
+private:
+	struct TextureState
+	{
+		uint64_t lastUsedFrame = 0U;
+	};
+
+	uint64_t m_budgetBytes = DefaultBudgetBytes;
+	uint64_t m_frameIndex = 0U;
+	std::vector<TextureResource*> m_textures;
+	std::vector<TextureState> m_textureStates;
+};
+
+}
@@ -8,7 +8,9 @@
 #include "LightUniforms.h"
 #include "Material/ShaderSchema.h"
 #include "Math/Transform.hpp"
+#include "Physics/SceneQuery.h"
 #include "Rendering/RenderContext.h"
+#include "Rendering/RenderSnapshot.h"
 #include "Rendering/Resources/MeshResource.h"
 
 #include <string>
@@ -33,6 +35,15 @@ constexpr uint64_t defaultRenderingState = BGFX_STATE_WRITE_RGB | BGFX_STATE_WRI
 constexpr uint64_t depthBufferFlags = BGFX_TEXTURE_RT | BGFX_SAMPLER_COMPARE_LEQUAL;
 constexpr uint64_t linearDepthBufferFlags = BGFX_TEXTURE_RT | BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP;
 
+// One shadow map view to draw all casters into. Views are set up serially and then recorded in parallel.
+struct ShadowPass
+{
+	uint16_t viewId;
+	// Point lights write linear depth and need light position per draw call.
+	bool isLinearDepth;
+	cd::Vec4f lightPosAndFarPlane;
+};
+
 }
 
 void ShadowMapRenderer::Init()
@@ -42,6 +53,7 @@ void ShadowMapRenderer::Init()
 	constexpr StringCrc linearshadowMapProgramCrc = StringCrc("LinearShadowMapProgram");
 	GetRenderContext()->RegisterShaderProgram(linearshadowMapProgramCrc, { "vs_shadowMap", "fs_shadowMap_linear" });
 
+	SetName("ShadowMapRenderer");
 	for (int lightIndex = 0; lightIndex < shadowLightMaxNum; lightIndex++)
 	{
 		for (int mapId = 0; mapId < shadowTexturePassMaxNum; mapId++)
@@ -67,17 +79,50 @@ void ShadowMapRenderer::UpdateView(const float* pViewMatrix, const float* pProje
 void ShadowMapRenderer::Render(float deltaTime)
 {
 	// TODO : Remove it. If every renderer need to submit camera related uniform, it should be done not inside Renderer class.
-	const cd::Transform& cameraTransform = m_pCurrentSceneWorld->GetTransformComponent(m_pCurrentSceneWorld->GetMainCameraEntity())->GetTransform();
+	const RenderSnapshot* pSnapshot = GetRenderContext()->GetRenderSnapshot();
+	const RenderSnapshotCamera& camera = pSnapshot->GetCamera();
+
+	// Shadow casters use detail levels selected from main camera so that shadows match visible meshes.
+	// It runs before WorldRenderer in the frame so levels are updated here once for all light views.
+	// Casters gathered here are shared by all light views too.
+	m_shadowCasterItemIndexes.clear();
+	const std::vector<RenderSnapshotItem>& snapshotItems = pSnapshot->GetItems();
+	for (uint32_t itemIndex = 0U; itemIndex < snapshotItems.size(); ++itemIndex)
+	{
+		const RenderSnapshotItem& item = snapshotItems[itemIndex];
+		Entity entity = item.entity;
+
+		// No mesh attached?
+		StaticMeshComponent* pMeshComponent = m_pCurrentSceneWorld->GetStaticMeshComponent(entity);
+		if (!pMeshComponent)
+		{
+			continue;
+		}
+
+		const MeshResource* pMeshResource = pMeshComponent->GetMeshResource();
+		if (ResourceStatus::Ready != pMeshResource->GetStatus() &&
+			ResourceStatus::Optimized != pMeshResource->GetStatus())
+		{
+			continue;
+		}
+
+		if (item.hasWorldAABB)
+		{
+			pMeshComponent->UpdateLod(item.worldAABB, camera.position, camera.fov);
+		}
+
+		m_shadowCasterItemIndexes.push_back(itemIndex);
+	}
 
 	// Submit uniform values : light settings
-	auto lightEntities = m_pCurrentSceneWorld->GetLightEntities();
+	const auto& lightEntities = m_pCurrentSceneWorld->GetLightEntities();
 
 	if (!lightEntities.empty())
 	{
 		// camera 
 		CameraComponent* pMainCameraComponent = m_pCurrentSceneWorld->GetCameraComponent(m_pCurrentSceneWorld->GetMainCameraEntity());
-		const cd::Matrix4x4 camView = pMainCameraComponent->GetViewMatrix();
-		const cd::Matrix4x4 camProj = pMainCameraComponent->GetProjectionMatrix();
+		const cd::Matrix4x4 camView = camera.viewMatrix;
+		const cd::Matrix4x4 camProj = camera.projectionMatrix;
 		const cd::Matrix4x4 invCamViewProj = (camProj * camView).Inverse();
 		bool ndcDepthMinusOneToOne = cd::NDCDepth::MinusOneToOne == pMainCameraComponent->GetNDCDepth();
 
@@ -88,6 +133,9 @@ void ShadowMapRenderer::Render(float deltaTime)
 			return worldPos.xyz() / worldPos.w();
 		};
 
+		ShadowPass shadowPasses[shadowLightMaxNum * shadowTexturePassMaxNum];
+		uint32_t shadowPassCount = 0U;
+
 		uint16_t shadowNum = 0U;
 		for (auto lightEntity : lightEntities)
 		{
@@ -134,8 +182,8 @@ void ShadowMapRenderer::Render(float deltaTime)
 					if (CascadePartitionMode::PSSM == cascadePatitionMode){}
 						lambda = 0.5;// TODO : user edit
 
-					float nearClip = pMainCameraComponent->GetNearPlane();
-					float farClip = pMainCameraComponent->GetFarPlane();
+					float nearClip = camera.nearPlane;
+					float farClip = camera.farPlane;
 					float clipRange = farClip - nearClip;
 
 					float minZ = nearClip + MinDistance * clipRange;
@@ -156,19 +204,13 @@ void ShadowMapRenderer::Render(float deltaTime)
 
 				// Compute the frustum according to ndc depth of different graphic backends
 				cd::Direction lightDirection = lightComponent->GetDirection();
-				std::vector<cd::Point> frustumCorners = ndcDepthMinusOneToOne ? 
-					std::vector<cd::Point>{		 // Depth [-1, 1]
-						UnProject(cd::Vec4f(-1, -1,  -1, 1)),	UnProject(cd::Vec4f(-1, -1, 1, 1)),	// lower-left near and far 
-						UnProject(cd::Vec4f(-1,  1,  -1, 1)),	UnProject(cd::Vec4f(-1,  1, 1, 1)),	// upper-left near and far 
-						UnProject(cd::Vec4f( 1, -1,  -1, 1)),	UnProject(cd::Vec4f( 1, -1, 1, 1)),	//	lower-right near and far 
-						UnProject(cd::Vec4f( 1,  1,  -1, 1)),	UnProject(cd::Vec4f( 1,  1, 1, 1))		// upper-right near and far
-					} :
-					std::vector<cd::Point>{		// Depth [0, 1]
-						UnProject(cd::Vec4f(-1, -1,  0, 1)),	UnProject(cd::Vec4f(-1, -1, 1, 1)),	// lower-left near and far 
-						UnProject(cd::Vec4f(-1,  1,  0, 1)),	UnProject(cd::Vec4f(-1,  1, 1, 1)),	// upper-left near and far 
-						UnProject(cd::Vec4f( 1, -1,  0, 1)),	UnProject(cd::Vec4f( 1, -1, 1, 1)),	//	lower-right near and far 
-						UnProject(cd::Vec4f( 1,  1,  0, 1)),	UnProject(cd::Vec4f( 1,  1, 1, 1))		// upper-right near and far
-					};
+				const float ndcNear = ndcDepthMinusOneToOne ? -1.0f : 0.0f;
+				const cd::Point frustumCorners[8] = {
+					UnProject(cd::Vec4f(-1.0f, -1.0f, ndcNear, 1.0f)),	UnProject(cd::Vec4f(-1.0f, -1.0f, 1.0f, 1.0f)),	// lower-left near and far 
+					UnProject(cd::Vec4f(-1.0f,  1.0f, ndcNear, 1.0f)),	UnProject(cd::Vec4f(-1.0f,  1.0f, 1.0f, 1.0f)),	// upper-left near and far 
+					UnProject(cd::Vec4f( 1.0f, -1.0f, ndcNear, 1.0f)),	UnProject(cd::Vec4f( 1.0f, -1.0f, 1.0f, 1.0f)),	//	lower-right near and far 
+					UnProject(cd::Vec4f( 1.0f,  1.0f, ndcNear, 1.0f)),	UnProject(cd::Vec4f( 1.0f,  1.0f, 1.0f, 1.0f))		// upper-right near and far
+				};
 
 				// Set cascade split dividing values for choosing cascade level in world renderer
 				lightComponent->SetComputedCascadeSplit(&CascadeSplits[0]);
@@ -217,8 +259,6 @@ void ShadowMapRenderer::Render(float deltaTime)
 						0, ndcDepthMinusOneToOne);
 
 					// Settings
-					bgfx::setState(defaultRenderingState);
-
 					uint16_t viewId = m_renderPassID[shadowNum * shadowTexturePassMaxNum + cascadeIndex];
 					bgfx::setViewRect(viewId, 0, 0, lightComponent->GetShadowMapSize(), lightComponent->GetShadowMapSize());
 					bgfx::setViewFrameBuffer(viewId, static_cast<bgfx::FrameBufferHandle>(lightComponent->GetShadowMapFBs().at(cascadeIndex)));
@@ -230,36 +270,7 @@ void ShadowMapRenderer::Render(float deltaTime)
 					lightComponent->AddLightViewProjMatrix(lightCSMViewProj);
 
 					// Submit draw call (TODO : one pass MRT 
-					for (Entity entity : m_pCurrentSceneWorld->GetMaterialEntities())
-					{
-						// No mesh attached?
-						StaticMeshComponent* pMeshComponent = m_pCurrentSceneWorld->GetStaticMeshComponent(entity);
-						if (!pMeshComponent)
-						{
-							continue;
-						}
-						const MeshResource* pMeshResource = pMeshComponent->GetMeshResource();
-						if (ResourceStatus::Ready != pMeshResource->GetStatus() &&
-							ResourceStatus::Optimized != pMeshResource->GetStatus())
-						{
-							continue;
-						}
-
-						BlendShapeComponent* pBlendShapeComponent = m_pCurrentSceneWorld->GetBlendShapeComponent(entity);
-						if (pBlendShapeComponent)
-						{
-							continue;
-						}
-
-						// Transform
-						if (TransformComponent* pTransformComponent = m_pCurrentSceneWorld->GetTransformComponent(entity))
-						{
-							bgfx::setTransform(pTransformComponent->GetWorldMatrix().begin());
-						}
-
-						// Mesh
-						SubmitStaticMeshDrawCall(pMeshComponent, viewId, "ShadowMapProgram");
-					}
+					shadowPasses[shadowPassCount++] = ShadowPass{ viewId, false, cd::Vec4f::Zero() };
 				}
 			}
 			break;
@@ -297,8 +308,6 @@ void ShadowMapRenderer::Render(float deltaTime)
 				};
 				cd::Matrix4x4 lightProjection = cd::Matrix4x4::Perspective(90.0f, 1.0f, 0.01f, range, ndcDepthMinusOneToOne);
 
-				// Settings
-				bgfx::setState(defaultRenderingState);
 				// 6 faces
 				for (uint16_t i = 0U; i < 6U; ++i)
 				{
@@ -309,35 +318,10 @@ void ShadowMapRenderer::Render(float deltaTime)
 					bgfx::setViewClear(viewId, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH, 0xffffffff, 1.0f, 0);
 					bgfx::setViewTransform(viewId, lightView[i].begin(), lightProjection.begin());
 
-					constexpr StringCrc lightPosAndFarPlaneCrc(lightPosAndFarPlane);
+					// Submit draw call
 					cd::Vec4f lightPosAndFarPlaneData = cd::Vec4f(lightComponent->GetPosition().x(), lightComponent->GetPosition().y(),
 						lightComponent->GetPosition().z(), lightComponent->GetRange());
-					GetRenderContext()->FillUniform(lightPosAndFarPlaneCrc, &lightPosAndFarPlaneData, 1);
-
-					// Submit draw call
-					for (Entity entity : m_pCurrentSceneWorld->GetMaterialEntities())
-					{
-						// No mesh attached?
-						StaticMeshComponent* pMeshComponent = m_pCurrentSceneWorld->GetStaticMeshComponent(entity);
-						if (!pMeshComponent)
-						{
-							continue;
-						}
-						const MeshResource* pMeshResource = pMeshComponent->GetMeshResource();
-						if (ResourceStatus::Ready != pMeshResource->GetStatus() &&
-							ResourceStatus::Optimized != pMeshResource->GetStatus())
-						{
-							continue;
-						}
-
-						// Transform
-						if (TransformComponent* pTransformComponent = m_pCurrentSceneWorld->GetTransformComponent(entity))
-						{
-							bgfx::setTransform(pTransformComponent->GetWorldMatrix().begin());
-						}
-
-						SubmitStaticMeshDrawCall(pMeshComponent, viewId, "LinearShadowMapProgram");
-					}
+					shadowPasses[shadowPassCount++] = ShadowPass{ viewId, true, lightPosAndFarPlaneData };
 				}
 			}
 			break;
@@ -361,8 +345,6 @@ void ShadowMapRenderer::Render(float deltaTime)
 				cd::Matrix4x4 lightProjection = cd::Matrix4x4::Perspective(2.0f*lightComponent->GetInnerAndOuter().y(), 1.0f, 0.1f, range, ndcDepthMinusOneToOne);
 
 				// Settings
-				uint64_t state = defaultRenderingState;
-				bgfx::setState(state);
 				uint16_t viewId = m_renderPassID[shadowNum * shadowTexturePassMaxNum + 0];
 				bgfx::setViewRect(viewId, 0, 0, lightComponent->GetShadowMapSize(), lightComponent->GetShadowMapSize());
 				bgfx::setViewFrameBuffer(viewId, static_cast<bgfx::FrameBufferHandle>(lightComponent->GetShadowMapFBs().at(0)));
@@ -375,36 +357,7 @@ void ShadowMapRenderer::Render(float deltaTime)
 				lightComponent->AddLightViewProjMatrix(lightCSMViewProj);
 
 				// Submit draw call
-				for (Entity entity : m_pCurrentSceneWorld->GetMaterialEntities())
-				{
-					// No mesh attached?
-					StaticMeshComponent* pMeshComponent = m_pCurrentSceneWorld->GetStaticMeshComponent(entity);
-					if (!pMeshComponent)
-					{
-						continue;
-					}
-					const MeshResource* pMeshResource = pMeshComponent->GetMeshResource();
-					if (ResourceStatus::Ready != pMeshResource->GetStatus() &&
-						ResourceStatus::Optimized != pMeshResource->GetStatus())
-					{
-						continue;
-					}
-
-					BlendShapeComponent* pBlendShapeComponent = m_pCurrentSceneWorld->GetBlendShapeComponent(entity);
-					if (pBlendShapeComponent)
-					{
-						continue;
-					}
-
-					// Transform
-					if (TransformComponent* pTransformComponent = m_pCurrentSceneWorld->GetTransformComponent(entity))
-					{
-						bgfx::setTransform(pTransformComponent->GetWorldMatrix().begin());
-					}
-
-					// Mesh
-					SubmitStaticMeshDrawCall(pMeshComponent, viewId, "ShadowMapProgram");
-				}
+				shadowPasses[shadowPassCount++] = ShadowPass{ viewId, false, cd::Vec4f::Zero() };
 			}
 			break;
 			}
@@ -415,6 +368,40 @@ void ShadowMapRenderer::Render(float deltaTime)
 				break;
 			}
 		}
+
+		// Record all cascades and faces at the same time. Items are flattened as pass * caster count + caster.
+		uint32_t casterCount = static_cast<uint32_t>(m_shadowCasterItemIndexes.size());
+		auto recordDrawCalls = [this, &shadowPasses, &snapshotItems, casterCount](bgfx::Encoder* pEncoder, uint32_t beginIndex, uint32_t endIndex)
+		{
+			for (uint32_t drawIndex = beginIndex; drawIndex < endIndex; ++drawIndex)
+			{
+				const ShadowPass& shadowPass = shadowPasses[drawIndex / casterCount];
+				const RenderSnapshotItem& item = snapshotItems[m_shadowCasterItemIndexes[drawIndex % casterCount]];
+				Entity entity = item.entity;
+
+				// Blend shape meshes are not supported by depth only programs yet.
+				if (!shadowPass.isLinearDepth && m_pCurrentSceneWorld->GetBlendShapeComponent(entity))
+				{
+					continue;
+				}
+
+				// Settings
+				pEncoder->setState(defaultRenderingState);
+				if (shadowPass.isLinearDepth)
+				{
+					constexpr StringCrc lightPosAndFarPlaneCrc(lightPosAndFarPlane);
+					GetRenderContext()->FillUniform(pEncoder, lightPosAndFarPlaneCrc, &shadowPass.lightPosAndFarPlane, 1);
+				}
+
+				// Transform
+				pEncoder->setTransform(item.worldMatrix.begin());
+
+				// Mesh
+				SubmitStaticMeshDrawCall(pEncoder, m_pCurrentSceneWorld->GetStaticMeshComponent(entity), shadowPass.viewId,
+					shadowPass.isLinearDepth ? "LinearShadowMapProgram" : "ShadowMapProgram");
+			}
+		};
+		GetRenderContext()->GetEncoderWorkerPool()->Record(shadowPassCount * casterCount, recordDrawCalls);
 	}
 }
 
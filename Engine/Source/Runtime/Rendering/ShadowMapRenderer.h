@@ -2,6 +2,9 @@
 
 #include "Renderer.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace engine
 {
 namespace 
@@ -27,6 +30,8 @@ public:
 private:
 	SceneWorld* m_pCurrentSceneWorld = nullptr;
 	uint16_t m_renderPassID[18];
+	// Indexes of snapshot items with ready meshes in current frame. Kept to reuse memory.
+	std::vector<uint32_t> m_shadowCasterItemIndexes;
 };
 
 }
\ No newline at end of file
@@ -1,10 +1,10 @@
 #include "SkeletonRenderer.h"
 
-#include "Core/StringCrc.h"
 #include "ECWorld/SceneWorld.h"
 #include "ECWorld/TransformComponent.h"
+#include "Log/Log.h"
+#include "Rendering/DebugDraw.h"
 #include "Rendering/RenderContext.h"
-#include "Rendering/Utility/VertexLayoutUtility.h"
 
 namespace engine
 {
@@ -12,10 +12,6 @@ namespace engine
 namespace details
 {
 
-constexpr uint32_t posDataSize = cd::Point::Size * sizeof(cd::Point::ValueType);
-
-constexpr size_t indexTypeSize = sizeof(uint16_t);
-
 cd::Vec3f CalculateBoneTranslate(const cd::Bone& bone, cd::Vec3f& translate, const cd::SceneDatabase* pSceneDatabase)
 {
 	const cd::Bone& parentBone = pSceneDatabase->GetBone(bone.GetParentID().Data());
@@ -27,28 +23,22 @@ cd::Vec3f CalculateBoneTranslate(const cd::Bone& bone, cd::Vec3f& translate, con
 	return translate;
 }
 
-void TraverseBone(const cd::Bone& bone, const cd::SceneDatabase* pSceneDatabase, std::byte* currentDataPtr,
-	std::byte* currentIndexPtr, uint32_t& vertexOffset, uint32_t& indexOffset)
+void TraverseBone(const cd::Bone& bone, const cd::SceneDatabase* pSceneDatabase, std::vector<cd::Vec3f>& bonePositions, std::vector<uint32_t>& boneLines)
 {
-	constexpr uint32_t posDataSize = cd::Point::Size * sizeof(cd::Point::ValueType);
 	for (auto& child : bone.GetChildIDs())
 	{
 		const cd::Bone& currBone = pSceneDatabase->GetBone(child.Data());
-		const cd::Bone& parent = pSceneDatabase->GetBone(currBone.GetParentID().Data());
 		cd::Vec3f translate = currBone.GetOffset().GetTranslation();
 
 		//const cd::Vec3f position = details::CalculateBoneTranslate(currBone, translate, pSceneDatabase);
 
-		uint16_t parentID = currBone.GetParentID().Data();
-		uint16_t currBoneID = currBone.GetID().Data();
-		std::memcpy(&currentDataPtr[vertexOffset], translate.begin(), posDataSize);
-		vertexOffset += posDataSize;
-		std::memcpy(&currentIndexPtr[indexOffset], &parentID, indexTypeSize);
-		indexOffset += static_cast<uint32_t>(indexTypeSize);
-		std::memcpy(&currentIndexPtr[indexOffset], &currBoneID, indexTypeSize);
-		indexOffset += static_cast<uint32_t>(indexTypeSize);
+		uint32_t parentID = currBone.GetParentID().Data();
+		uint32_t currBoneID = currBone.GetID().Data();
+		bonePositions[currBoneID] = translate;
+		boneLines.push_back(parentID);
+		boneLines.push_back(currBoneID);
 
-		TraverseBone(currBone, pSceneDatabase, currentDataPtr, currentIndexPtr, vertexOffset, indexOffset);
+		TraverseBone(currBone, pSceneDatabase, bonePositions, boneLines);
 	}
 }
 
@@ -56,15 +46,14 @@ void TraverseBone(const cd::Bone& bone, const cd::SceneDatabase* pSceneDatabase,
 
 void SkeletonRenderer::Init()
 {
-	constexpr StringCrc programCrc = StringCrc("SkeletonProgram");
-	GetRenderContext()->RegisterShaderProgram(programCrc, {"vs_AABB", "fs_AABB"});
+	GetRenderContext()->GetDebugDraw()->Init(GetRenderContext());
 
-	bgfx::setViewName(GetViewID(), "SkeletonRenderer");
+	SetName("SkeletonRenderer");
 }
 
 void SkeletonRenderer::Warmup()
 {
-	GetRenderContext()->UploadShaderProgram("SkeletonProgram");
+	GetRenderContext()->GetDebugDraw()->Warmup();
 }
 
 void SkeletonRenderer::UpdateView(const float* pViewMatrix, const float* pProjectionMatrix)
@@ -75,10 +64,12 @@ void SkeletonRenderer::UpdateView(const float* pViewMatrix, const float* pProjec
 
 void SkeletonRenderer::Build()
 {
-	const cd::SceneDatabase* pSceneDatabase = m_pCurrentSceneWorld->GetSceneDatabase();
+	m_bonePositions.clear();
+	m_boneLines.clear();
 
-	const uint32_t vertexCount = pSceneDatabase->GetBoneCount();
-	if (0 == vertexCount)
+	const cd::SceneDatabase* pSceneDatabase = m_pCurrentSceneWorld->GetSceneDatabase();
+	const uint32_t boneCount = pSceneDatabase->GetBoneCount();
+	if (0 == boneCount)
 	{
 		return;
 	}
@@ -90,54 +81,42 @@ void SkeletonRenderer::Build()
 		return;
 	}
 
-	bgfx::setTransform(cd::Matrix4x4::Identity().begin());
-	cd::VertexFormat vertexFormat;
-	vertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Position, cd::AttributeValueType::Float, 3);
-
-	constexpr size_t indexTypeSize = sizeof(uint16_t);
-	m_indexBuffer.resize((vertexCount - 1) * 2 * indexTypeSize);
-	m_vertexBuffer.resize(vertexCount * vertexFormat.GetStride());
-	uint32_t currentVertexOffset = 0U;
-	uint32_t currentIndexOffset = 0U;
-	std::byte* pCurrentVertexBuffer = m_vertexBuffer.data();
-	const cd::Point& position = firstBone.GetTransform().GetTranslation();
-	std::memcpy(&pCurrentVertexBuffer[currentVertexOffset], position.begin(), details::posDataSize);
-	currentVertexOffset += details::posDataSize;
-
-	details::TraverseBone(firstBone, pSceneDatabase, m_vertexBuffer.data(), m_indexBuffer.data(), currentVertexOffset, currentIndexOffset);
-	bgfx::VertexLayout vertexLayout;
-	VertexLayoutUtility::CreateVertexLayout(vertexLayout, vertexFormat.GetVertexAttributeLayouts());
-	m_boneVBH = bgfx::createVertexBuffer(bgfx::makeRef(m_vertexBuffer.data(), static_cast<uint32_t>(m_vertexBuffer.size())), vertexLayout).idx;
-	m_boneIBH = bgfx::createIndexBuffer(bgfx::makeRef(m_indexBuffer.data(), static_cast<uint32_t>(m_indexBuffer.size())), 0U).idx;
-
+	m_bonePositions.resize(boneCount);
+	m_boneLines.reserve((boneCount - 1) * 2);
+	m_bonePositions[0] = firstBone.GetTransform().GetTranslation();
+	details::TraverseBone(firstBone, pSceneDatabase, m_bonePositions, m_boneLines);
 }
 
 void SkeletonRenderer::Render(float delataTime)
 {
+	bool hasAnimation = false;
 	for (Entity entity : m_pCurrentSceneWorld->GetAnimationEntities())
 	{
-		auto pAnimationComponent = m_pCurrentSceneWorld->GetAnimationComponent(entity);
-		if (!pAnimationComponent)
-		{
-			continue;
-		}
-		if (!hasBuilt)
+		if (m_pCurrentSceneWorld->GetAnimationComponent(entity))
 		{
-			Build();
-			hasBuilt = true;
+			hasAnimation = true;
+			break;
 		}
+	}
 
-		bgfx::setVertexBuffer(0, bgfx::VertexBufferHandle{ m_boneVBH });
-		bgfx::setIndexBuffer(bgfx::IndexBufferHandle{ m_boneIBH });
-
-		constexpr uint64_t state = BGFX_STATE_WRITE_MASK | BGFX_STATE_MSAA | BGFX_STATE_DEPTH_TEST_LESS |
-			BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_INV_SRC_ALPHA) | BGFX_STATE_PT_LINES;
+	if (!hasAnimation)
+	{
+		return;
+	}
 
-		bgfx::setState(state);
+	if (!hasBuilt)
+	{
+		Build();
+		hasBuilt = true;
+	}
 
-		GetRenderContext()->Submit(GetViewID(), "SkeletonProgram");
+	// Bones share one transient line batch instead of one static buffer per skeleton.
+	DebugDraw* pDebugDraw = GetRenderContext()->GetDebugDraw();
+	for (size_t index = 0; index + 1 < m_boneLines.size(); index += 2)
+	{
+		pDebugDraw->DrawLine(m_bonePositions[m_boneLines[index]], m_bonePositions[m_boneLines[index + 1]], cd::Vec4f(1.0f, 1.0f, 1.0f, 1.0f));
 	}
-	
+	pDebugDraw->Flush(GetViewID());
 }
 
 }
\ No newline at end of file
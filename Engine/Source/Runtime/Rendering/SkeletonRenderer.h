@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Renderer.h"
+
+#include "Math/Vector.hpp"
+
 #include <vector>
 
 namespace engine
@@ -22,10 +25,9 @@ public:
 
 private:
 	SceneWorld* m_pCurrentSceneWorld = nullptr;
-	std::vector<std::byte> m_vertexBuffer;
-	std::vector<std::byte> m_indexBuffer;
-	uint16_t m_boneVBH = UINT16_MAX;
-	uint16_t m_boneIBH = UINT16_MAX;
+	// Bone positions indexed by bone ID and bone lines as pairs of parent ID and child ID.
+	std::vector<cd::Vec3f> m_bonePositions;
+	std::vector<uint32_t> m_boneLines;
 
 	bool hasBuilt = false;
 };
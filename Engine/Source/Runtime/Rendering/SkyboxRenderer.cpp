@@ -25,7 +25,7 @@ void SkyboxRenderer::Init()
 	constexpr StringCrc programCrc = StringCrc(skyboxProgram);
 	GetRenderContext()->RegisterShaderProgram(programCrc, {"vs_skybox", "fs_skybox"});
 
-	bgfx::setViewName(GetViewID(), "SkyboxRenderer");
+	SetName("SkyboxRenderer");
 }
 
 void SkyboxRenderer::Warmup()
@@ -1,20 +1,24 @@
 #include "TerrainRenderer.h"
 
-#include "ECWorld/CameraComponent.h"
+#include "Display/Frustum.h"
 #include "ECWorld/MaterialComponent.h"
 #include "ECWorld/SceneWorld.h"
 #include "ECWorld/SkyComponent.h"
 #include "ECWorld/StaticMeshComponent.h"
-#include "ECWorld/TransformComponent.h"
 #include "LightUniforms.h"
 #include "Material/ShaderSchema.h"
 #include "Math/Transform.hpp"
 #include "Rendering/RenderContext.h"
+#include "Rendering/RenderSnapshot.h"
 #include "Rendering/Resources/MeshResource.h"
 #include "Scene/Texture.h"
+#include "Terrain/TerrainTileStreamer.h"
 #include "U_IBL.sh"
 #include "U_Terrain.sh"
 
+#include <algorithm>
+#include <cmath>
+
 namespace engine
 {
 
@@ -46,17 +50,26 @@ constexpr const char* albedoUVOffsetAndScale = "u_albedoUVOffsetAndScale";
 constexpr const char* alphaCutOff = "u_alphaCutOff";
 constexpr const char* emissiveColor = "u_emissiveColor";
 
+constexpr const char* terrainChunkParams = "u_terrainChunkParams";
+constexpr const char* terrainTileParams = "u_terrainTileParams";
+constexpr const char* terrainMorphParams = "u_terrainMorphParams";
+
 constexpr const char* lightCountAndStride = "u_lightCountAndStride";
 constexpr const char* lightParams = "u_lightParams";
 
 constexpr uint64_t samplerFlags = BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP | BGFX_SAMPLER_W_CLAMP;
+// Morph to the next coarser level in the last part of every lod range.
+constexpr float terrainMorphStartRatio = 0.66f;
+
 constexpr uint64_t defaultRenderingState = BGFX_STATE_WRITE_MASK | BGFX_STATE_MSAA | BGFX_STATE_DEPTH_TEST_LESS;
 
 }
 
+TerrainRenderer::~TerrainRenderer() = default;
+
 void TerrainRenderer::Init()
 {
-	bgfx::setViewName(GetViewID(), "TerrainRenderer");
+	SetName("TerrainRenderer");
 }
 
 void TerrainRenderer::Warmup()
@@ -86,6 +99,10 @@ void TerrainRenderer::Warmup()
 	GetRenderContext()->CreateUniform(albedoUVOffsetAndScale, bgfx::UniformType::Vec4, 1);
 	GetRenderContext()->CreateUniform(alphaCutOff, bgfx::UniformType::Vec4, 1);
 
+	GetRenderContext()->CreateUniform(terrainChunkParams, bgfx::UniformType::Vec4, 1);
+	GetRenderContext()->CreateUniform(terrainTileParams, bgfx::UniformType::Vec4, 1);
+	GetRenderContext()->CreateUniform(terrainMorphParams, bgfx::UniformType::Vec4, 1);
+
 	GetRenderContext()->CreateUniform(lightCountAndStride, bgfx::UniformType::Vec4, 1);
 	GetRenderContext()->CreateUniform(lightParams, bgfx::UniformType::Vec4, LightUniform::VEC4_COUNT);
 
@@ -100,11 +117,6 @@ void TerrainRenderer::UpdateView(const float* pViewMatrix, const float* pProject
 
 void TerrainRenderer::Render(float deltaTime)
 {
-	// TODO : Remove it. If every renderer need to submit camera related uniform, it should be done not inside Renderer class.
-	const CameraComponent* pMainCameraComponent = m_pCurrentSceneWorld->GetCameraComponent(m_pCurrentSceneWorld->GetMainCameraEntity());
-	const cd::Transform& cameraTransform = m_pCurrentSceneWorld->GetTransformComponent(m_pCurrentSceneWorld->GetMainCameraEntity())->GetTransform();
-	SkyComponent* pSkyComponent = m_pCurrentSceneWorld->GetSkyComponent(m_pCurrentSceneWorld->GetSkyEntity());
-
 	for (Entity entity : m_pCurrentSceneWorld->GetTerrainEntities())
 	{		
 		MaterialComponent* pMaterialComponent = m_pCurrentSceneWorld->GetMaterialComponent(entity);
@@ -131,101 +143,257 @@ void TerrainRenderer::Render(float deltaTime)
 			continue;
 		}
 
-		// Transform
-		if (TransformComponent* pTransformComponent = m_pCurrentSceneWorld->GetTransformComponent(entity))
+		TerrainComponent* pTerrainComponent = m_pCurrentSceneWorld->GetTerrainComponent(entity);
+		if (pTerrainComponent->IsChunked())
 		{
-			bgfx::setTransform(pTransformComponent->GetWorldMatrix().begin());
+			RenderChunkedTerrain(entity, pTerrainComponent, pMeshComponent, pMaterialComponent);
+			continue;
 		}
 
-		// Material
-		bgfx::setTexture(TERRAIN_TOP_ALBEDO_MAP_SLOT,
-			GetRenderContext()->GetUniform(StringCrc(snowSampler)),
-			GetRenderContext()->GetTexture(StringCrc(snowTexture)));
-
-		bgfx::setTexture(TERRAIN_MEDIUM_ALBEDO_MAP_SLOT,
-			GetRenderContext()->GetUniform(StringCrc(rockSampler)),
-			GetRenderContext()->GetTexture(StringCrc(rockTexture)));
+		SetCommonUniformsAndTextures(entity, pMaterialComponent);
 
-		bgfx::setTexture(TERRAIN_BOTTOM_ALBEDO_MAP_SLOT,
-			GetRenderContext()->GetUniform(StringCrc(grassSampler)),
-			GetRenderContext()->GetTexture(StringCrc(grassTexture)));
+		// Only upload the region modified by brush. The shared elevation texture is fully refreshed when another terrain was uploaded before.
+		if (m_lastUploadedTerrainEntity != entity)
+		{
+			pTerrainComponent->MarkDirty(0U, 0U, pTerrainComponent->GetTexWidth() - 1U, pTerrainComponent->GetTexDepth() - 1U);
+			m_lastUploadedTerrainEntity = entity;
+		}
 
-		TerrainComponent* pTerrainComponent = m_pCurrentSceneWorld->GetTerrainComponent(entity);
-		GetRenderContext()->UpdateTexture(elevationTexture, 0, 0, 0, 0, 0, pTerrainComponent->GetTexWidth(), pTerrainComponent->GetTexDepth(),
-			1, pTerrainComponent->GetElevationRawData(), pTerrainComponent->GetElevationRawDataSize());
+		if (const auto& optDirtyRect = pTerrainComponent->GetDirtyRect(); optDirtyRect.has_value())
+		{
+			const TerrainComponent::DirtyRect& dirtyRect = optDirtyRect.value();
+			const uint16_t pitch = pTerrainComponent->GetTexWidth() * sizeof(float);
+			const std::byte* pDirtyData = pTerrainComponent->GetElevationRawData() + dirtyRect.z * pitch + dirtyRect.x * sizeof(float);
+			const uint32_t dirtySize = (dirtyRect.depth - 1U) * pitch + dirtyRect.width * sizeof(float);
+			GetRenderContext()->UpdateTexture(elevationTexture, 0, 0, dirtyRect.x, dirtyRect.z, 0, dirtyRect.width, dirtyRect.depth,
+				1, pDirtyData, dirtySize, pitch);
+			pTerrainComponent->ClearDirtyRect();
+		}
 
 		bgfx::setTexture(TERRAIN_ELEVATION_MAP_SLOT,
 			GetRenderContext()->GetUniform(StringCrc(elevationSampler)),
 			GetRenderContext()->GetTexture(StringCrc(elevationTexture)));
 
-		// Sky
-		SkyType crtSkyType = pSkyComponent->GetSkyType();
-		if (crtSkyType == SkyType::SkyBox)
-		{
-			constexpr StringCrc irrSamplerCrc(cubeIrradianceSampler);
-			GetRenderContext()->CreateTexture(pSkyComponent->GetIrradianceTexturePath().c_str(), samplerFlags);
-			bgfx::setTexture(IBL_IRRADIANCE_SLOT,
-				GetRenderContext()->GetUniform(irrSamplerCrc),
-				GetRenderContext()->GetTexture(StringCrc(pSkyComponent->GetIrradianceTexturePath())));
-
-			constexpr StringCrc radSamplerCrc(cubeRadianceSampler);
-			GetRenderContext()->CreateTexture(pSkyComponent->GetRadianceTexturePath().c_str(), samplerFlags);
-			bgfx::setTexture(IBL_RADIANCE_SLOT,
-				GetRenderContext()->GetUniform(radSamplerCrc),
-				GetRenderContext()->GetTexture(StringCrc(pSkyComponent->GetRadianceTexturePath())));
-
-			constexpr StringCrc lutsamplerCrc(lutSampler);
-			constexpr StringCrc luttextureCrc(lutTexture);
-			bgfx::setTexture(BRDF_LUT_SLOT, GetRenderContext()->GetUniform(lutsamplerCrc), GetRenderContext()->GetTexture(luttextureCrc));
-		}
+		// The whole terrain is one chunk without morph.
+		constexpr StringCrc terrainChunkParamsCrc(terrainChunkParams);
+		cd::Vec4f chunkParamsData(0.0f, 0.0f, 1.0f, 0.0f);
+		GetRenderContext()->FillUniform(terrainChunkParamsCrc, chunkParamsData.begin(), 1);
 
-		// Submit uniform values : camera settings
-		constexpr StringCrc cameraPosCrc(cameraPos);
-		GetRenderContext()->FillUniform(cameraPosCrc, &cameraTransform.GetTranslation().x(), 1);
-
-		constexpr StringCrc cameraNearFarPlaneCrc(cameraNearFarPlane);
-		float cameraNearFarPlanedata[2] { pMainCameraComponent->GetNearPlane(), pMainCameraComponent->GetFarPlane() };
-		GetRenderContext()->FillUniform(cameraNearFarPlaneCrc, cameraNearFarPlanedata, 1);
-
-		// Submit  uniform values : material settings
-		constexpr StringCrc albedoColorCrc(albedoColor);
-		GetRenderContext()->FillUniform(albedoColorCrc, pMaterialComponent->GetFactor<cd::Vec3f>(cd::MaterialPropertyGroup::BaseColor), 1);
-
-		cd::Vec4f metallicRoughnessFactorData(
-			*(pMaterialComponent->GetFactor<float>(cd::MaterialPropertyGroup::Metallic)),
-			*(pMaterialComponent->GetFactor<float>(cd::MaterialPropertyGroup::Roughness)),
-			1.0f, 1.0f);
-		constexpr StringCrc mrFactorCrc(metallicRoughnessFactor);
-		GetRenderContext()->FillUniform(mrFactorCrc, metallicRoughnessFactorData.begin(), 1);
-
-		constexpr StringCrc emissiveColorCrc(emissiveColor);
-		GetRenderContext()->FillUniform(emissiveColorCrc, pMaterialComponent->GetFactor<cd::Vec4f>(cd::MaterialPropertyGroup::Emissive), 1);
-
-		// Submit  uniform values : light settings
-		auto lightEntities = m_pCurrentSceneWorld->GetLightEntities();
-		size_t lightEntityCount = lightEntities.size();
-		constexpr engine::StringCrc lightCountAndStrideCrc(lightCountAndStride);
-		static cd::Vec4f lightInfoData(0, LightUniform::LIGHT_STRIDE, 0.0f, 0.0f);
-		lightInfoData.x() = static_cast<float>(lightEntityCount);
-		GetRenderContext()->FillUniform(lightCountAndStrideCrc, lightInfoData.begin(), 1);
-		if (lightEntityCount > 0)
-		{
-			// Light component storage has continus memory address and layout.
-			float* pLightDataBegin = reinterpret_cast<float*>(m_pCurrentSceneWorld->GetLightComponent(lightEntities[0]));
-			constexpr engine::StringCrc lightParamsCrc(lightParams);
-			GetRenderContext()->FillUniform(lightParamsCrc, pLightDataBegin, static_cast<uint16_t>(lightEntityCount * LightUniform::LIGHT_STRIDE));
-		}
+		constexpr StringCrc terrainTileParamsCrc(terrainTileParams);
+		float texSize = static_cast<float>(pTerrainComponent->GetTexWidth());
+		cd::Vec4f tileParamsData(0.0f, 0.0f, texSize, 1.0f / texSize);
+		GetRenderContext()->FillUniform(terrainTileParamsCrc, tileParamsData.begin(), 1);
+
+		constexpr StringCrc terrainMorphParamsCrc(terrainMorphParams);
+		cd::Vec4f morphParamsData(0.0f, 0.0f, 0.0f, 0.0f);
+		GetRenderContext()->FillUniform(terrainMorphParamsCrc, morphParamsData.begin(), 1);
+
+		SubmitStaticMeshDrawCall(pMeshComponent, GetViewID(), pMaterialComponent->GetShaderProgramName());
+	}
+}
+
+TerrainTileStreamer* TerrainRenderer::GetOrCreateTileStreamer(Entity entity, const TerrainComponent* pTerrainComponent)
+{
+	auto itStreamer = m_tileStreamers.find(entity);
+	if (itStreamer != m_tileStreamers.end() &&
+		itStreamer->second->GetDirectory() == pTerrainComponent->GetTileDirectory() &&
+		itStreamer->second->GetTileSize() == pTerrainComponent->GetTileSize())
+	{
+		return itStreamer->second.get();
+	}
+
+	auto pStreamer = std::make_unique<TerrainTileStreamer>(pTerrainComponent->GetTileDirectory(), pTerrainComponent->GetTileSize(),
+		pTerrainComponent->GetChunkSize(), pTerrainComponent->GetMaxResidentTileCount());
+	TerrainTileStreamer* pResult = pStreamer.get();
+	m_tileStreamers[entity] = cd::MoveTemp(pStreamer);
+	return pResult;
+}
 
-		uint64_t state = defaultRenderingState;
-		if (!pMaterialComponent->GetTwoSided())
+void TerrainRenderer::RenderChunkedTerrain(Entity entity, TerrainComponent* pTerrainComponent, StaticMeshComponent* pMeshComponent, MaterialComponent* pMaterialComponent)
+{
+	TerrainTileStreamer* pStreamer = GetOrCreateTileStreamer(entity, pTerrainComponent);
+	pStreamer->SetMaxResidentTileCount(pTerrainComponent->GetMaxResidentTileCount());
+	pStreamer->Update();
+
+	const uint16_t tileSize = pTerrainComponent->GetTileSize();
+	const uint16_t chunkSize = pTerrainComponent->GetChunkSize();
+	assert(tileSize % chunkSize == 0U);
+
+	// Level 0 covers distance [0, lodDistance] and every coarser level doubles the range.
+	uint16_t levelCount = 1U;
+	for (uint16_t nodeSize = chunkSize; nodeSize < tileSize; nodeSize *= 2U)
+	{
+		++levelCount;
+	}
+	m_lodRanges.resize(levelCount);
+	float lodRange = pTerrainComponent->GetLODDistance();
+	for (float& range : m_lodRanges)
+	{
+		range = lodRange;
+		lodRange *= 2.0f;
+	}
+
+	// Select in terrain local space. Note that lod ranges are measured in local units.
+	const RenderSnapshot* pSnapshot = GetRenderContext()->GetRenderSnapshot();
+	const RenderSnapshotCamera& camera = pSnapshot->GetCamera();
+	cd::Matrix4x4 worldMatrix = cd::Matrix4x4::Identity();
+	if (const RenderSnapshotTransform* pTransform = pSnapshot->FindTransform(entity))
+	{
+		worldMatrix = pTransform->worldMatrix;
+	}
+	const cd::Vec3f& cameraPosition = camera.position;
+	cd::Vec3f localCameraPos = (worldMatrix.Inverse() * cd::Vec4f(cameraPosition.x(), cameraPosition.y(), cameraPosition.z(), 1.0f)).xyz();
+	Frustum frustum(camera.projectionMatrix * camera.viewMatrix * worldMatrix);
+
+	// Tiles are streamed and drawn up to the view distance. Coarsest level covers everything beyond finer ranges.
+	const float viewDistance = pTerrainComponent->GetViewDistance() > 0.0f ? pTerrainComponent->GetViewDistance() : camera.farPlane;
+	m_lodRanges.back() = std::max(m_lodRanges.back(), viewDistance);
+	const float streamDistance = m_lodRanges.back();
+	const float texSize = static_cast<float>(tileSize + 1U);
+
+	constexpr StringCrc elevationSamplerCrc(elevationSampler);
+	constexpr StringCrc terrainChunkParamsCrc(terrainChunkParams);
+	constexpr StringCrc terrainTileParamsCrc(terrainTileParams);
+	constexpr StringCrc terrainMorphParamsCrc(terrainMorphParams);
+
+	for (uint16_t tileZ = 0U; tileZ < pTerrainComponent->GetTileCountZ(); ++tileZ)
+	{
+		for (uint16_t tileX = 0U; tileX < pTerrainComponent->GetTileCountX(); ++tileX)
 		{
-			state |= BGFX_STATE_CULL_CCW;
+			const float tileOriginX = static_cast<float>(tileX * tileSize);
+			const float tileOriginZ = static_cast<float>(tileZ * tileSize);
+			float dx = std::max(std::max(tileOriginX - localCameraPos.x(), localCameraPos.x() - tileOriginX - tileSize), 0.0f);
+			float dz = std::max(std::max(tileOriginZ - localCameraPos.z(), localCameraPos.z() - tileOriginZ - tileSize), 0.0f);
+			float tileDistance = std::sqrt(dx * dx + dz * dz);
+			if (tileDistance > streamDistance)
+			{
+				continue;
+			}
+
+			TerrainTile* pTile = pStreamer->GetResidentTile(tileX, tileZ);
+			if (!pTile)
+			{
+				pStreamer->RequestTile(tileX, tileZ, tileDistance);
+				continue;
+			}
+
+			m_selectedNodes.clear();
+			pTile->quadTree.Select(localCameraPos, &frustum, m_lodRanges, tileOriginX, tileOriginZ, m_selectedNodes);
+
+			for (const TerrainQuadTree::SelectedNode& node : m_selectedNodes)
+			{
+				SetCommonUniformsAndTextures(entity, pMaterialComponent);
+
+				bgfx::setTexture(TERRAIN_ELEVATION_MAP_SLOT, GetRenderContext()->GetUniform(elevationSamplerCrc), pTile->texture);
+
+				cd::Vec4f chunkParamsData(static_cast<float>(node.x), static_cast<float>(node.z), static_cast<float>(node.size) / chunkSize, 0.0f);
+				GetRenderContext()->FillUniform(terrainChunkParamsCrc, chunkParamsData.begin(), 1);
+
+				cd::Vec4f tileParamsData(tileOriginX, tileOriginZ, texSize, 1.0f / texSize);
+				GetRenderContext()->FillUniform(terrainTileParamsCrc, tileParamsData.begin(), 1);
+
+				float morphEnd = m_lodRanges[node.lodLevel];
+				float previousRange = node.lodLevel > 0U ? m_lodRanges[node.lodLevel - 1U] : 0.0f;
+				cd::Vec4f morphParamsData(previousRange + (morphEnd - previousRange) * terrainMorphStartRatio, morphEnd, static_cast<float>(chunkSize), 0.0f);
+				GetRenderContext()->FillUniform(terrainMorphParamsCrc, morphParamsData.begin(), 1);
+
+				SubmitStaticMeshDrawCall(pMeshComponent, GetViewID(), pMaterialComponent->GetShaderProgramName());
+			}
 		}
+	}
+}
 
-		bgfx::setState(state);
+void TerrainRenderer::SetCommonUniformsAndTextures(Entity entity, MaterialComponent* pMaterialComponent)
+{
+	// TODO : Remove it. If every renderer need to submit camera related uniform, it should be done not inside Renderer class.
+	const RenderSnapshot* pSnapshot = GetRenderContext()->GetRenderSnapshot();
+	const RenderSnapshotCamera& camera = pSnapshot->GetCamera();
+	SkyComponent* pSkyComponent = m_pCurrentSceneWorld->GetSkyComponent(m_pCurrentSceneWorld->GetSkyEntity());
 
-		SubmitStaticMeshDrawCall(pMeshComponent, GetViewID(), pMaterialComponent->GetShaderProgramName());
+	// Transform
+	if (const RenderSnapshotTransform* pTransform = pSnapshot->FindTransform(entity))
+	{
+		bgfx::setTransform(pTransform->worldMatrix.begin());
+	}
+
+	// Material
+	bgfx::setTexture(TERRAIN_TOP_ALBEDO_MAP_SLOT,
+		GetRenderContext()->GetUniform(StringCrc(snowSampler)),
+		GetRenderContext()->GetTexture(StringCrc(snowTexture)));
+
+	bgfx::setTexture(TERRAIN_MEDIUM_ALBEDO_MAP_SLOT,
+		GetRenderContext()->GetUniform(StringCrc(rockSampler)),
+		GetRenderContext()->GetTexture(StringCrc(rockTexture)));
+
+	bgfx::setTexture(TERRAIN_BOTTOM_ALBEDO_MAP_SLOT,
+		GetRenderContext()->GetUniform(StringCrc(grassSampler)),
+		GetRenderContext()->GetTexture(StringCrc(grassTexture)));
+
+	// Sky
+	SkyType crtSkyType = pSkyComponent->GetSkyType();
+	if (crtSkyType == SkyType::SkyBox)
+	{
+		constexpr StringCrc irrSamplerCrc(cubeIrradianceSampler);
+		GetRenderContext()->CreateTexture(pSkyComponent->GetIrradianceTexturePath().c_str(), samplerFlags);
+		bgfx::setTexture(IBL_IRRADIANCE_SLOT,
+			GetRenderContext()->GetUniform(irrSamplerCrc),
+			GetRenderContext()->GetTexture(StringCrc(pSkyComponent->GetIrradianceTexturePath())));
+
+		constexpr StringCrc radSamplerCrc(cubeRadianceSampler);
+		GetRenderContext()->CreateTexture(pSkyComponent->GetRadianceTexturePath().c_str(), samplerFlags);
+		bgfx::setTexture(IBL_RADIANCE_SLOT,
+			GetRenderContext()->GetUniform(radSamplerCrc),
+			GetRenderContext()->GetTexture(StringCrc(pSkyComponent->GetRadianceTexturePath())));
+
+		constexpr StringCrc lutsamplerCrc(lutSampler);
+		constexpr StringCrc luttextureCrc(lutTexture);
+		bgfx::setTexture(BRDF_LUT_SLOT, GetRenderContext()->GetUniform(lutsamplerCrc), GetRenderContext()->GetTexture(luttextureCrc));
+	}
+
+	// Submit uniform values : camera settings
+	constexpr StringCrc cameraPosCrc(cameraPos);
+	GetRenderContext()->FillUniform(cameraPosCrc, &camera.position.x(), 1);
+
+	constexpr StringCrc cameraNearFarPlaneCrc(cameraNearFarPlane);
+	float cameraNearFarPlanedata[2] { camera.nearPlane, camera.farPlane };
+	GetRenderContext()->FillUniform(cameraNearFarPlaneCrc, cameraNearFarPlanedata, 1);
+
+	// Submit  uniform values : material settings
+	constexpr StringCrc albedoColorCrc(albedoColor);
+	GetRenderContext()->FillUniform(albedoColorCrc, pMaterialComponent->GetFactor<cd::Vec3f>(cd::MaterialPropertyGroup::BaseColor), 1);
+
+	cd::Vec4f metallicRoughnessFactorData(
+		*(pMaterialComponent->GetFactor<float>(cd::MaterialPropertyGroup::Metallic)),
+		*(pMaterialComponent->GetFactor<float>(cd::MaterialPropertyGroup::Roughness)),
+		1.0f, 1.0f);
+	constexpr StringCrc mrFactorCrc(metallicRoughnessFactor);
+	GetRenderContext()->FillUniform(mrFactorCrc, metallicRoughnessFactorData.begin(), 1);
+
+	constexpr StringCrc emissiveColorCrc(emissiveColor);
+	GetRenderContext()->FillUniform(emissiveColorCrc, pMaterialComponent->GetFactor<cd::Vec4f>(cd::MaterialPropertyGroup::Emissive), 1);
+
+	// Submit  uniform values : light settings
+	const auto& lightEntities = m_pCurrentSceneWorld->GetLightEntities();
+	size_t lightEntityCount = lightEntities.size();
+	constexpr engine::StringCrc lightCountAndStrideCrc(lightCountAndStride);
+	static cd::Vec4f lightInfoData(0, LightUniform::LIGHT_STRIDE, 0.0f, 0.0f);
+	lightInfoData.x() = static_cast<float>(lightEntityCount);
+	GetRenderContext()->FillUniform(lightCountAndStrideCrc, lightInfoData.begin(), 1);
+	if (lightEntityCount > 0)
+	{
+		// Light component storage has continus memory address and layout.
+		float* pLightDataBegin = reinterpret_cast<float*>(m_pCurrentSceneWorld->GetLightComponent(lightEntities[0]));
+		constexpr engine::StringCrc lightParamsCrc(lightParams);
+		GetRenderContext()->FillUniform(lightParamsCrc, pLightDataBegin, static_cast<uint16_t>(lightEntityCount * LightUniform::LIGHT_STRIDE));
 	}
+
+	uint64_t state = defaultRenderingState;
+	if (!pMaterialComponent->GetTwoSided())
+	{
+		state |= BGFX_STATE_CULL_CCW;
+	}
+
+	bgfx::setState(state);
 }
 
 }
\ No newline at end of file
@@ -1,16 +1,27 @@
 #pragma once
 
+#include "ECWorld/Entity.h"
 #include "Renderer.h"
+#include "Terrain/TerrainQuadTree.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace engine
 {
 
+class MaterialComponent;
 class SceneWorld;
+class StaticMeshComponent;
+class TerrainComponent;
+class TerrainTileStreamer;
 
 class TerrainRenderer final : public Renderer
 {
 public:
 	using Renderer::Renderer;
+	virtual ~TerrainRenderer();
 
 	virtual void Init() override;
 	virtual void Warmup() override;
@@ -19,8 +30,19 @@ public:
 
 	void SetSceneWorld(SceneWorld* pSceneWorld) { m_pCurrentSceneWorld = pSceneWorld; }
 
+private:
+	// bgfx discards all bindings after submit so that they need to be set again for every chunk.
+	void SetCommonUniformsAndTextures(Entity entity, MaterialComponent* pMaterialComponent);
+	void RenderChunkedTerrain(Entity entity, TerrainComponent* pTerrainComponent, StaticMeshComponent* pMeshComponent, MaterialComponent* pMaterialComponent);
+	TerrainTileStreamer* GetOrCreateTileStreamer(Entity entity, const TerrainComponent* pTerrainComponent);
+
 private:
 	SceneWorld* m_pCurrentSceneWorld = nullptr;
+	Entity m_lastUploadedTerrainEntity = INVALID_ENTITY;
+
+	std::unordered_map<Entity, std::unique_ptr<TerrainTileStreamer>> m_tileStreamers;
+	std::vector<float> m_lodRanges;
+	std::vector<TerrainQuadTree::SelectedNode> m_selectedNodes;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,449 @@
+#include "MeshOptimizer.h"
+
+#include "Base/Template.h"
+#include "Log/Log.h"
+#include "Rendering/Resources/MeshResource.h"
+#include "Rendering/Utility/MeshSimplifier.h"
+#include "Rendering/Utility/VertexLayoutUtility.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+
+constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+std::vector<uint32_t> ReadIndices(std::span<const std::byte> indexBuffer, uint32_t indexSize)
+{
+	std::vector<uint32_t> indices(indexBuffer.size() / indexSize);
+	if (sizeof(uint16_t) == indexSize)
+	{
+		const auto* pIndices = reinterpret_cast<const uint16_t*>(indexBuffer.data());
+		std::copy(pIndices, pIndices + indices.size(), indices.begin());
+	}
+	else
+	{
+		std::memcpy(indices.data(), indexBuffer.data(), indices.size() * sizeof(uint32_t));
+	}
+
+	return indices;
+}
+
+void WriteIndices(std::span<std::byte> indexBuffer, uint32_t indexSize, const std::vector<uint32_t>& indices)
+{
+	assert(indexBuffer.size() == indices.size() * indexSize);
+	if (sizeof(uint16_t) == indexSize)
+	{
+		auto* pIndices = reinterpret_cast<uint16_t*>(indexBuffer.data());
+		for (size_t index = 0; index < indices.size(); ++index)
+		{
+			pIndices[index] = static_cast<uint16_t>(indices[index]);
+		}
+	}
+	else
+	{
+		std::memcpy(indexBuffer.data(), indices.data(), indices.size() * sizeof(uint32_t));
+	}
+}
+
+// Scoring constants from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation".
+constexpr uint32_t ForsythCacheSize = 32U;
+constexpr float CacheDecayPower = 1.5f;
+constexpr float LastTriangleScore = 0.75f;
+constexpr float ValenceBoostScale = 2.0f;
+constexpr float ValenceBoostPower = 0.5f;
+
+float ComputeVertexScore(uint32_t cachePosition, uint32_t remainingTriangleCount)
+{
+	if (0U == remainingTriangleCount)
+	{
+		// No triangle needs this vertex.
+		return -1.0f;
+	}
+
+	float score = 0.0f;
+	if (cachePosition < 3U)
+	{
+		// Vertices used by the last triangle get a fixed score so that strips are not preferred.
+		score = LastTriangleScore;
+	}
+	else if (cachePosition < ForsythCacheSize)
+	{
+		constexpr float scaler = 1.0f / static_cast<float>(ForsythCacheSize - 3U);
+		score = std::pow(1.0f - static_cast<float>(cachePosition - 3U) * scaler, CacheDecayPower);
+	}
+
+	// Boost vertices with few triangles left so that they are finished earlier.
+	score += ValenceBoostScale * std::pow(static_cast<float>(remainingTriangleCount), -ValenceBoostPower);
+	return score;
+}
+
+}
+
+namespace engine
+{
+
+MeshOptimizeStats& MeshOptimizeStats::operator+=(const MeshOptimizeStats& other)
+{
+	vertexBufferBytesBefore += other.vertexBufferBytesBefore;
+	vertexBufferBytesAfter += other.vertexBufferBytesAfter;
+	vertexShaderInvocationsBefore += other.vertexShaderInvocationsBefore;
+	vertexShaderInvocationsAfter += other.vertexShaderInvocationsAfter;
+	quantizedMeshCount += other.quantizedMeshCount;
+	return *this;
+}
+
+uint64_t MeshOptimizer::AnalyzeVertexCache(std::span<const std::byte> indexBuffer, uint32_t indexSize, uint32_t vertexCount, uint32_t cacheSize)
+{
+	// A vertex is still in the FIFO cache if less than cacheSize vertices are transformed after it.
+	std::vector<uint32_t> timestamps(vertexCount, 0U);
+	uint32_t timestamp = cacheSize + 1U;
+	uint64_t invocationCount = 0U;
+	for (uint32_t vertexIndex : ReadIndices(indexBuffer, indexSize))
+	{
+		assert(vertexIndex < vertexCount);
+		if (timestamp - timestamps[vertexIndex] > cacheSize)
+		{
+			timestamps[vertexIndex] = timestamp++;
+			++invocationCount;
+		}
+	}
+
+	return invocationCount;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::span<std::byte> indexBuffer, uint32_t indexSize, uint32_t vertexCount)
+{
+	std::vector<uint32_t> indices = ReadIndices(indexBuffer, indexSize);
+	uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3U);
+	if (triangleCount < 2U)
+	{
+		return;
+	}
+
+	// Build vertex to triangle adjacency. Each vertex owns a slice in adjacentTriangles which shrinks when triangles are emitted.
+	std::vector<uint32_t> remainingTriangleCounts(vertexCount, 0U);
+	for (uint32_t index = 0U; index < triangleCount * 3U; ++index)
+	{
+		++remainingTriangleCounts[indices[index]];
+	}
+
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1U, 0U);
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		adjacencyOffsets[vertexIndex + 1U] = adjacencyOffsets[vertexIndex] + remainingTriangleCounts[vertexIndex];
+	}
+
+	std::vector<uint32_t> adjacentTriangles(adjacencyOffsets[vertexCount]);
+	{
+		std::vector<uint32_t> fillCounts(vertexCount, 0U);
+		for (uint32_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+		{
+			for (uint32_t corner = 0U; corner < 3U; ++corner)
+			{
+				uint32_t vertexIndex = indices[triangleIndex * 3U + corner];
+				adjacentTriangles[adjacencyOffsets[vertexIndex] + fillCounts[vertexIndex]++] = triangleIndex;
+			}
+		}
+	}
+
+	std::vector<uint32_t> cachePositions(vertexCount, InvalidIndex);
+	std::vector<float> vertexScores(vertexCount);
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		vertexScores[vertexIndex] = ComputeVertexScore(InvalidIndex, remainingTriangleCounts[vertexIndex]);
+	}
+
+	std::vector<float> triangleScores(triangleCount);
+	std::vector<bool> emittedTriangles(triangleCount, false);
+	for (uint32_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		triangleScores[triangleIndex] = vertexScores[indices[triangleIndex * 3U]] +
+			vertexScores[indices[triangleIndex * 3U + 1U]] + vertexScores[indices[triangleIndex * 3U + 2U]];
+	}
+
+	std::vector<uint32_t> optimizedIndices;
+	optimizedIndices.reserve(triangleCount * 3U);
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> newCache;
+	std::vector<uint32_t> evictedVertices;
+	cache.reserve(ForsythCacheSize + 3U);
+	newCache.reserve(ForsythCacheSize + 3U);
+
+	uint32_t bestTriangle = static_cast<uint32_t>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+	uint32_t scanCursor = 0U;
+	for (uint32_t emittedCount = 0U; emittedCount < triangleCount; ++emittedCount)
+	{
+		if (InvalidIndex == bestTriangle)
+		{
+			// No candidate around cached vertices. Continue from the next triangle which is not emitted.
+			while (emittedTriangles[scanCursor])
+			{
+				++scanCursor;
+			}
+			bestTriangle = scanCursor;
+		}
+
+		emittedTriangles[bestTriangle] = true;
+		newCache.clear();
+		for (uint32_t corner = 0U; corner < 3U; ++corner)
+		{
+			uint32_t vertexIndex = indices[bestTriangle * 3U + corner];
+			optimizedIndices.push_back(vertexIndex);
+			newCache.push_back(vertexIndex);
+
+			// Remove the emitted triangle from vertex adjacency.
+			uint32_t* pAdjacency = &adjacentTriangles[adjacencyOffsets[vertexIndex]];
+			uint32_t& remainingCount = remainingTriangleCounts[vertexIndex];
+			for (uint32_t adjacencyIndex = 0U; adjacencyIndex < remainingCount; ++adjacencyIndex)
+			{
+				if (pAdjacency[adjacencyIndex] == bestTriangle)
+				{
+					std::swap(pAdjacency[adjacencyIndex], pAdjacency[remainingCount - 1U]);
+					--remainingCount;
+					break;
+				}
+			}
+		}
+
+		// Emitted vertices move to the front of LRU cache.
+		for (uint32_t vertexIndex : cache)
+		{
+			if (std::find(newCache.begin(), newCache.begin() + 3, vertexIndex) == newCache.begin() + 3)
+			{
+				newCache.push_back(vertexIndex);
+			}
+		}
+
+		// Vertices pushed out of cache lose their cache score.
+		evictedVertices.clear();
+		for (uint32_t cacheIndex = ForsythCacheSize; cacheIndex < static_cast<uint32_t>(newCache.size()); ++cacheIndex)
+		{
+			cachePositions[newCache[cacheIndex]] = InvalidIndex;
+			evictedVertices.push_back(newCache[cacheIndex]);
+		}
+		newCache.resize(std::min(static_cast<uint32_t>(newCache.size()), ForsythCacheSize));
+		std::swap(cache, newCache);
+
+		for (uint32_t cacheIndex = 0U; cacheIndex < static_cast<uint32_t>(cache.size()); ++cacheIndex)
+		{
+			cachePositions[cache[cacheIndex]] = cacheIndex;
+		}
+
+		// Update scores of vertices which are in or just evicted from cache, and their remaining triangles.
+		auto UpdateVertexScore = [&](uint32_t vertexIndex)
+		{
+			float newScore = ComputeVertexScore(cachePositions[vertexIndex], remainingTriangleCounts[vertexIndex]);
+			float deltaScore = newScore - vertexScores[vertexIndex];
+			vertexScores[vertexIndex] = newScore;
+
+			const uint32_t* pAdjacency = &adjacentTriangles[adjacencyOffsets[vertexIndex]];
+			for (uint32_t adjacencyIndex = 0U; adjacencyIndex < remainingTriangleCounts[vertexIndex]; ++adjacencyIndex)
+			{
+				triangleScores[pAdjacency[adjacencyIndex]] += deltaScore;
+			}
+		};
+
+		for (uint32_t vertexIndex : evictedVertices)
+		{
+			UpdateVertexScore(vertexIndex);
+		}
+		for (uint32_t vertexIndex : cache)
+		{
+			UpdateVertexScore(vertexIndex);
+		}
+
+		// Next triangle is the best one which shares a vertex in cache.
+		bestTriangle = InvalidIndex;
+		float bestScore = -1.0f;
+		for (uint32_t vertexIndex : cache)
+		{
+			const uint32_t* pAdjacency = &adjacentTriangles[adjacencyOffsets[vertexIndex]];
+			for (uint32_t adjacencyIndex = 0U; adjacencyIndex < remainingTriangleCounts[vertexIndex]; ++adjacencyIndex)
+			{
+				uint32_t triangleIndex = pAdjacency[adjacencyIndex];
+				if (triangleScores[triangleIndex] > bestScore)
+				{
+					bestScore = triangleScores[triangleIndex];
+					bestTriangle = triangleIndex;
+				}
+			}
+		}
+	}
+
+	// Keep trailing indices which don't form a triangle.
+	optimizedIndices.insert(optimizedIndices.end(), indices.begin() + triangleCount * 3U, indices.end());
+	WriteIndices(indexBuffer, indexSize, optimizedIndices);
+}
+
+void MeshOptimizer::OptimizeVertexFetch(std::vector<std::byte>& vertexBuffer, uint32_t vertexStride, std::vector<std::vector<std::byte>>& indexBuffers, uint32_t indexSize)
+{
+	uint32_t vertexCount = static_cast<uint32_t>(vertexBuffer.size() / vertexStride);
+	std::vector<uint32_t> remap(vertexCount, InvalidIndex);
+	uint32_t nextVertexIndex = 0U;
+
+	std::vector<std::vector<uint32_t>> allIndices;
+	allIndices.reserve(indexBuffers.size());
+	for (const auto& indexBuffer : indexBuffers)
+	{
+		std::vector<uint32_t>& indices = allIndices.emplace_back(ReadIndices(indexBuffer, indexSize));
+		for (uint32_t& vertexIndex : indices)
+		{
+			assert(vertexIndex < vertexCount);
+			if (InvalidIndex == remap[vertexIndex])
+			{
+				remap[vertexIndex] = nextVertexIndex++;
+			}
+			vertexIndex = remap[vertexIndex];
+		}
+	}
+
+	for (uint32_t& newVertexIndex : remap)
+	{
+		if (InvalidIndex == newVertexIndex)
+		{
+			newVertexIndex = nextVertexIndex++;
+		}
+	}
+
+	std::vector<std::byte> optimizedVertexBuffer(vertexBuffer.size());
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		std::memcpy(&optimizedVertexBuffer[remap[vertexIndex] * vertexStride], &vertexBuffer[vertexIndex * vertexStride], vertexStride);
+	}
+	vertexBuffer = cd::MoveTemp(optimizedVertexBuffer);
+
+	for (size_t bufferIndex = 0; bufferIndex < indexBuffers.size(); ++bufferIndex)
+	{
+		WriteIndices(indexBuffers[bufferIndex], indexSize, allIndices[bufferIndex]);
+	}
+}
+
+bool MeshOptimizer::QuantizeVertexBuffer(std::vector<std::byte>& vertexBuffer, const cd::VertexFormat& vertexFormat, uint32_t vertexCount)
+{
+	bgfx::VertexLayout fullLayout;
+	bgfx::VertexLayout quantizedLayout;
+	VertexLayoutUtility::CreateVertexLayout(fullLayout, vertexFormat.GetVertexAttributeLayouts(), VertexLayoutVariant::Full);
+	VertexLayoutUtility::CreateVertexLayout(quantizedLayout, vertexFormat.GetVertexAttributeLayouts(), VertexLayoutVariant::Quantized);
+	if (fullLayout.getSize(vertexCount) != vertexBuffer.size())
+	{
+		CD_ENGINE_ERROR("Vertex buffer size doesn't match its vertex format.");
+		return false;
+	}
+
+	// bgfx converts attributes by layout so that quantization matches what GPU decodes.
+	std::vector<std::byte> quantizedVertexBuffer(quantizedLayout.getSize(vertexCount));
+	bgfx::vertexConvert(quantizedLayout, quantizedVertexBuffer.data(), fullLayout, vertexBuffer.data(), vertexCount);
+	vertexBuffer = cd::MoveTemp(quantizedVertexBuffer);
+	return true;
+}
+
+void MeshOptimizer::GenerateLods(const std::vector<std::byte>& vertexBuffer, const cd::VertexFormat& vertexFormat, uint32_t vertexCount,
+	std::vector<std::vector<std::byte>>& indexBuffers, uint32_t lodCount, float maxError, std::vector<std::vector<MeshLod>>& outLods)
+{
+	// Stop when simplification can't remove enough triangles as the level wouldn't save anything.
+	constexpr float LodReduction = 0.5f;
+	constexpr float MinLodReduction = 0.9f;
+
+	bgfx::VertexLayout fullLayout;
+	VertexLayoutUtility::CreateVertexLayout(fullLayout, vertexFormat.GetVertexAttributeLayouts(), VertexLayoutVariant::Full);
+	const std::byte* pPositions = vertexBuffer.data() + fullLayout.getOffset(bgfx::Attrib::Position);
+	const uint32_t indexSize = MeshResource::GetIndexSize(vertexCount);
+
+	outLods.clear();
+	outLods.resize(indexBuffers.size());
+	for (size_t polygonGroupIndex = 0; polygonGroupIndex < indexBuffers.size(); ++polygonGroupIndex)
+	{
+		std::vector<std::byte>& indexBuffer = indexBuffers[polygonGroupIndex];
+		std::vector<MeshLod>& lods = outLods[polygonGroupIndex];
+
+		std::vector<uint32_t> lodIndices = ReadIndices(indexBuffer, indexSize);
+		std::vector<uint32_t> allIndices = lodIndices;
+		lods.push_back(MeshLod{ 0U, static_cast<uint32_t>(lodIndices.size()) });
+		for (uint32_t lodIndex = 1U; lodIndex < std::min(lodCount, MaxMeshLodCount); ++lodIndex)
+		{
+			uint32_t previousIndexCount = static_cast<uint32_t>(lodIndices.size());
+			uint32_t targetIndexCount = static_cast<uint32_t>(static_cast<float>(previousIndexCount / 3U) * LodReduction) * 3U;
+			lodIndices = MeshSimplifier::Simplify(pPositions, fullLayout.getStride(), vertexCount, lodIndices, targetIndexCount, maxError);
+			if (lodIndices.empty() || static_cast<float>(lodIndices.size()) > static_cast<float>(previousIndexCount) * MinLodReduction)
+			{
+				break;
+			}
+
+			lods.push_back(MeshLod{ static_cast<uint32_t>(allIndices.size()), static_cast<uint32_t>(lodIndices.size()) });
+			allIndices.insert(allIndices.end(), lodIndices.begin(), lodIndices.end());
+		}
+
+		if (lods.size() > 1U)
+		{
+			indexBuffer.resize(allIndices.size() * indexSize);
+			WriteIndices(indexBuffer, indexSize, allIndices);
+		}
+	}
+}
+
+MeshOptimizeStats MeshOptimizer::Optimize(const MeshOptimizeOptions& options, std::vector<std::byte>& vertexBuffer, const cd::VertexFormat& vertexFormat,
+	uint32_t vertexCount, std::vector<std::vector<std::byte>>& indexBuffers, std::vector<std::vector<MeshLod>>& outLods)
+{
+	const uint32_t indexSize = MeshResource::GetIndexSize(vertexCount);
+
+	MeshOptimizeStats stats;
+	stats.vertexBufferBytesBefore = vertexBuffer.size();
+	for (const auto& indexBuffer : indexBuffers)
+	{
+		stats.vertexShaderInvocationsBefore += AnalyzeVertexCache(indexBuffer, indexSize, vertexCount);
+	}
+
+	if (options.lodCount > 1U)
+	{
+		GenerateLods(vertexBuffer, vertexFormat, vertexCount, indexBuffers, options.lodCount, options.lodMaxError, outLods);
+	}
+	else
+	{
+		outLods.clear();
+		for (const auto& indexBuffer : indexBuffers)
+		{
+			outLods.push_back({ MeshLod{ 0U, static_cast<uint32_t>(indexBuffer.size() / indexSize) } });
+		}
+	}
+
+	if (options.optimizeVertexCache)
+	{
+		for (size_t polygonGroupIndex = 0; polygonGroupIndex < indexBuffers.size(); ++polygonGroupIndex)
+		{
+			// Every detail level is a separate triangle list so optimize them one by one.
+			for (const MeshLod& lod : outLods[polygonGroupIndex])
+			{
+				std::span<std::byte> lodIndexBuffer(indexBuffers[polygonGroupIndex].data() + lod.startIndex * indexSize, lod.indexCount * indexSize);
+				OptimizeVertexCache(lodIndexBuffer, indexSize, vertexCount);
+			}
+		}
+	}
+
+	// Fetch optimization should run after vertex cache optimization as it follows the final index order.
+	if (options.optimizeVertexFetch)
+	{
+		OptimizeVertexFetch(vertexBuffer, vertexFormat.GetStride(), indexBuffers, indexSize);
+	}
+
+	if (options.quantizeAttributes && QuantizeVertexBuffer(vertexBuffer, vertexFormat, vertexCount))
+	{
+		stats.quantizedMeshCount = 1U;
+	}
+
+	// Only the original detail level is comparable with the input.
+	stats.vertexBufferBytesAfter = vertexBuffer.size();
+	for (size_t polygonGroupIndex = 0; polygonGroupIndex < indexBuffers.size(); ++polygonGroupIndex)
+	{
+		const MeshLod& lod = outLods[polygonGroupIndex].front();
+		std::span<const std::byte> lodIndexBuffer(indexBuffers[polygonGroupIndex].data() + lod.startIndex * indexSize, lod.indexCount * indexSize);
+		stats.vertexShaderInvocationsAfter += AnalyzeVertexCache(lodIndexBuffer, indexSize, vertexCount);
+	}
+
+	return stats;
+}
+
+}
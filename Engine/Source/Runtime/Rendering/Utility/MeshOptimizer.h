@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Scene/VertexFormat.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine
+{
+
+static constexpr uint32_t MaxMeshLodCount = 4U;
+
+struct MeshOptimizeOptions
+{
+	// Reorder triangles to reuse post-transform vertex cache.
+	bool optimizeVertexCache = false;
+	// Reorder vertices by first use in index buffers to improve vertex fetch locality.
+	bool optimizeVertexFetch = false;
+	// Store normal/tangent/bitangent as normalized int16 and UV as half float.
+	bool quantizeAttributes = false;
+	// Number of detail levels including the original one. Each level halves triangle count of the previous one.
+	uint32_t lodCount = 1U;
+	// Allowed simplification error relative to the mesh extent.
+	float lodMaxError = 0.02f;
+
+	bool IsEnabled() const { return optimizeVertexCache || optimizeVertexFetch || quantizeAttributes || lodCount > 1U; }
+	static MeshOptimizeOptions All() { return MeshOptimizeOptions{ true, true, true, MaxMeshLodCount }; }
+};
+
+// Index range of one detail level in a polygon group's index buffer. Levels are stored from fine to coarse.
+struct MeshLod
+{
+	uint32_t startIndex;
+	uint32_t indexCount;
+};
+
+struct MeshOptimizeStats
+{
+	uint64_t vertexBufferBytesBefore = 0U;
+	uint64_t vertexBufferBytesAfter = 0U;
+	// Estimated vertex shader invocations by simulating a FIFO post-transform cache.
+	uint64_t vertexShaderInvocationsBefore = 0U;
+	uint64_t vertexShaderInvocationsAfter = 0U;
+	// Meshes whose vertex buffer is converted to the quantized layout. A mesh stays in full precision if conversion fails.
+	uint32_t quantizedMeshCount = 0U;
+
+	MeshOptimizeStats& operator+=(const MeshOptimizeStats& other);
+};
+
+// MeshOptimizer works on vertex/index buffers which are built by MeshUtils.
+// Indices are 16 bits or 32 bits decided by MeshResource::GetIndexSize.
+class MeshOptimizer
+{
+public:
+	static constexpr uint32_t SimulatedCacheSize = 16U;
+
+	// Returns vertex shader invocations of a triangle list with a FIFO cache.
+	static uint64_t AnalyzeVertexCache(std::span<const std::byte> indexBuffer, uint32_t indexSize, uint32_t vertexCount, uint32_t cacheSize = SimulatedCacheSize);
+
+	// Reorders triangles in place by Tom Forsyth's linear-speed vertex cache optimization.
+	static void OptimizeVertexCache(std::span<std::byte> indexBuffer, uint32_t indexSize, uint32_t vertexCount);
+
+	// Reorders vertices in the order they are first referenced by all polygon groups and remaps indices.
+	// Vertices which are not referenced are kept at the end so that vertex count doesn't change.
+	static void OptimizeVertexFetch(std::vector<std::byte>& vertexBuffer, uint32_t vertexStride, std::vector<std::vector<std::byte>>& indexBuffers, uint32_t indexSize);
+
+	// Converts a vertex buffer in full precision format to the quantized layout variant.
+	static bool QuantizeVertexBuffer(std::vector<std::byte>& vertexBuffer, const cd::VertexFormat& vertexFormat, uint32_t vertexCount);
+
+	// Appends simplified detail levels to every index buffer and outputs their index ranges per polygon group.
+	static void GenerateLods(const std::vector<std::byte>& vertexBuffer, const cd::VertexFormat& vertexFormat, uint32_t vertexCount,
+		std::vector<std::vector<std::byte>>& indexBuffers, uint32_t lodCount, float maxError, std::vector<std::vector<MeshLod>>& outLods);
+
+	// Runs enabled steps in order : lod generation, vertex cache, vertex fetch, quantization.
+	// outLods always gets one range per polygon group for the original detail level.
+	static MeshOptimizeStats Optimize(const MeshOptimizeOptions& options, std::vector<std::byte>& vertexBuffer, const cd::VertexFormat& vertexFormat,
+		uint32_t vertexCount, std::vector<std::vector<std::byte>>& indexBuffers, std::vector<std::vector<MeshLod>>& outLods);
+};
+
+}
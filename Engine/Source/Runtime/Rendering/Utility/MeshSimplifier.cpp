@@ -0,0 +1,307 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+
+namespace
+{
+
+struct Vec3
+{
+	double x;
+	double y;
+	double z;
+
+	Vec3 operator-(const Vec3& other) const { return Vec3{ x - other.x, y - other.y, z - other.z }; }
+	double Dot(const Vec3& other) const { return x * other.x + y * other.y + z * other.z; }
+	Vec3 Cross(const Vec3& other) const { return Vec3{ y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x }; }
+	double Length() const { return std::sqrt(Dot(*this)); }
+};
+
+// Symmetric 4x4 matrix of plane equation (a, b, c, d) outer products.
+struct Quadric
+{
+	double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+	double b2 = 0.0, bc = 0.0, bd = 0.0;
+	double c2 = 0.0, cd = 0.0;
+	double d2 = 0.0;
+
+	void AddPlane(double a, double b, double c, double d)
+	{
+		a2 += a * a; ab += a * b; ac += a * c; ad += a * d;
+		b2 += b * b; bc += b * c; bd += b * d;
+		c2 += c * c; cd += c * d;
+		d2 += d * d;
+	}
+
+	Quadric& operator+=(const Quadric& other)
+	{
+		a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+		b2 += other.b2; bc += other.bc; bd += other.bd;
+		c2 += other.c2; cd += other.cd;
+		d2 += other.d2;
+		return *this;
+	}
+
+	// Sum of squared distances from p to all accumulated planes.
+	double Evaluate(const Vec3& p) const
+	{
+		return a2 * p.x * p.x + 2.0 * ab * p.x * p.y + 2.0 * ac * p.x * p.z + 2.0 * ad * p.x +
+			b2 * p.y * p.y + 2.0 * bc * p.y * p.z + 2.0 * bd * p.y +
+			c2 * p.z * p.z + 2.0 * cd * p.z +
+			d2;
+	}
+};
+
+struct Collapse
+{
+	double cost;
+	uint32_t from;
+	uint32_t to;
+
+	bool operator>(const Collapse& other) const { return cost > other.cost; }
+};
+
+uint64_t GetEdgeKey(uint32_t v0, uint32_t v1)
+{
+	return v0 < v1 ? (static_cast<uint64_t>(v0) << 32U) | v1 : (static_cast<uint64_t>(v1) << 32U) | v0;
+}
+
+}
+
+namespace engine
+{
+
+std::vector<uint32_t> MeshSimplifier::Simplify(const std::byte* pPositions, uint32_t positionStride, uint32_t vertexCount,
+	const std::vector<uint32_t>& indices, uint32_t targetIndexCount, float maxError)
+{
+	uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3U);
+	if (triangleCount * 3U <= targetIndexCount)
+	{
+		return indices;
+	}
+
+	std::vector<Vec3> positions(vertexCount);
+	Vec3 minPosition{ DBL_MAX, DBL_MAX, DBL_MAX };
+	Vec3 maxPosition{ -DBL_MAX, -DBL_MAX, -DBL_MAX };
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		float position[3];
+		std::memcpy(position, pPositions + static_cast<size_t>(vertexIndex) * positionStride, sizeof(position));
+		positions[vertexIndex] = Vec3{ position[0], position[1], position[2] };
+		minPosition = Vec3{ std::min(minPosition.x, positions[vertexIndex].x), std::min(minPosition.y, positions[vertexIndex].y), std::min(minPosition.z, positions[vertexIndex].z) };
+		maxPosition = Vec3{ std::max(maxPosition.x, positions[vertexIndex].x), std::max(maxPosition.y, positions[vertexIndex].y), std::max(maxPosition.z, positions[vertexIndex].z) };
+	}
+	const double maxCost = std::pow(static_cast<double>(maxError) * (maxPosition - minPosition).Length(), 2.0);
+
+	// Plane quadrics per vertex and vertex to triangle adjacency.
+	std::vector<Quadric> quadrics(vertexCount);
+	std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+	std::unordered_map<uint64_t, uint32_t> edgeUseCounts;
+	edgeUseCounts.reserve(triangleCount * 3U);
+	for (uint32_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		const uint32_t* pTriangle = &indices[triangleIndex * 3U];
+		const Vec3& p0 = positions[pTriangle[0]];
+		Vec3 normal = (positions[pTriangle[1]] - p0).Cross(positions[pTriangle[2]] - p0);
+		double length = normal.Length();
+		if (length > 0.0)
+		{
+			normal = Vec3{ normal.x / length, normal.y / length, normal.z / length };
+			for (uint32_t corner = 0U; corner < 3U; ++corner)
+			{
+				quadrics[pTriangle[corner]].AddPlane(normal.x, normal.y, normal.z, -normal.Dot(p0));
+			}
+		}
+
+		for (uint32_t corner = 0U; corner < 3U; ++corner)
+		{
+			vertexTriangles[pTriangle[corner]].push_back(triangleIndex);
+			++edgeUseCounts[GetEdgeKey(pTriangle[corner], pTriangle[(corner + 1U) % 3U])];
+		}
+	}
+
+	// Lock vertices on open or non-manifold edges.
+	std::vector<bool> lockedVertices(vertexCount, false);
+	for (const auto& [edgeKey, useCount] : edgeUseCounts)
+	{
+		if (useCount != 2U)
+		{
+			lockedVertices[static_cast<uint32_t>(edgeKey >> 32U)] = true;
+			lockedVertices[static_cast<uint32_t>(edgeKey & UINT32_MAX)] = true;
+		}
+	}
+
+	// Collapsed vertex points to the vertex it merges into.
+	std::vector<uint32_t> remap(vertexCount);
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		remap[vertexIndex] = vertexIndex;
+	}
+	auto FindVertex = [&remap](uint32_t vertexIndex)
+	{
+		while (remap[vertexIndex] != vertexIndex)
+		{
+			remap[vertexIndex] = remap[remap[vertexIndex]];
+			vertexIndex = remap[vertexIndex];
+		}
+		return vertexIndex;
+	};
+
+	auto ComputeCollapseCost = [&quadrics, &positions](uint32_t from, uint32_t to)
+	{
+		Quadric quadric = quadrics[from];
+		quadric += quadrics[to];
+		return quadric.Evaluate(positions[to]);
+	};
+
+	std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> collapses;
+	for (const auto& [edgeKey, useCount] : edgeUseCounts)
+	{
+		uint32_t v0 = static_cast<uint32_t>(edgeKey >> 32U);
+		uint32_t v1 = static_cast<uint32_t>(edgeKey & UINT32_MAX);
+		if (!lockedVertices[v0])
+		{
+			collapses.push(Collapse{ ComputeCollapseCost(v0, v1), v0, v1 });
+		}
+		if (!lockedVertices[v1])
+		{
+			collapses.push(Collapse{ ComputeCollapseCost(v1, v0), v1, v0 });
+		}
+	}
+
+	std::vector<bool> removedTriangles(triangleCount, false);
+	uint32_t remainingTriangleCount = triangleCount;
+	while (remainingTriangleCount * 3U > targetIndexCount && !collapses.empty())
+	{
+		Collapse collapse = collapses.top();
+		collapses.pop();
+
+		uint32_t from = FindVertex(collapse.from);
+		uint32_t to = FindVertex(collapse.to);
+		if (from != collapse.from || from == to || lockedVertices[from])
+		{
+			// Source vertex is already collapsed. Its edges are evaluated from the surviving vertex.
+			continue;
+		}
+
+		// Costs only grow after merging quadrics so re-queue stale entries with the current cost.
+		double cost = ComputeCollapseCost(from, to);
+		if (cost > collapse.cost * (1.0 + 1e-6) + DBL_EPSILON)
+		{
+			collapses.push(Collapse{ cost, from, to });
+			continue;
+		}
+
+		if (cost > maxCost)
+		{
+			break;
+		}
+
+		// Reject collapses which flip triangle orientation.
+		bool flipped = false;
+		for (uint32_t triangleIndex : vertexTriangles[from])
+		{
+			if (removedTriangles[triangleIndex])
+			{
+				continue;
+			}
+
+			uint32_t v[3] = { FindVertex(indices[triangleIndex * 3U]), FindVertex(indices[triangleIndex * 3U + 1U]), FindVertex(indices[triangleIndex * 3U + 2U]) };
+			if (v[0] == to || v[1] == to || v[2] == to)
+			{
+				// Becomes degenerated after collapse.
+				continue;
+			}
+
+			Vec3 oldNormal = (positions[v[1]] - positions[v[0]]).Cross(positions[v[2]] - positions[v[0]]);
+			for (uint32_t& vertex : v)
+			{
+				vertex = vertex == from ? to : vertex;
+			}
+			Vec3 newNormal = (positions[v[1]] - positions[v[0]]).Cross(positions[v[2]] - positions[v[0]]);
+			if (oldNormal.Dot(newNormal) <= 0.0)
+			{
+				flipped = true;
+				break;
+			}
+		}
+		if (flipped)
+		{
+			continue;
+		}
+
+		remap[from] = to;
+		quadrics[to] += quadrics[from];
+		for (uint32_t triangleIndex : vertexTriangles[from])
+		{
+			if (removedTriangles[triangleIndex])
+			{
+				continue;
+			}
+
+			uint32_t v0 = FindVertex(indices[triangleIndex * 3U]);
+			uint32_t v1 = FindVertex(indices[triangleIndex * 3U + 1U]);
+			uint32_t v2 = FindVertex(indices[triangleIndex * 3U + 2U]);
+			if (v0 == v1 || v1 == v2 || v2 == v0)
+			{
+				removedTriangles[triangleIndex] = true;
+				--remainingTriangleCount;
+			}
+			else
+			{
+				vertexTriangles[to].push_back(triangleIndex);
+			}
+		}
+		vertexTriangles[from].clear();
+
+		// Neighbors of the merged vertex get new candidates with updated quadric.
+		for (uint32_t triangleIndex : vertexTriangles[to])
+		{
+			if (removedTriangles[triangleIndex])
+			{
+				continue;
+			}
+
+			for (uint32_t corner = 0U; corner < 3U; ++corner)
+			{
+				uint32_t neighbor = FindVertex(indices[triangleIndex * 3U + corner]);
+				if (neighbor == to)
+				{
+					continue;
+				}
+
+				if (!lockedVertices[to])
+				{
+					collapses.push(Collapse{ ComputeCollapseCost(to, neighbor), to, neighbor });
+				}
+				if (!lockedVertices[neighbor])
+				{
+					collapses.push(Collapse{ ComputeCollapseCost(neighbor, to), neighbor, to });
+				}
+			}
+		}
+	}
+
+	std::vector<uint32_t> simplifiedIndices;
+	simplifiedIndices.reserve(remainingTriangleCount * 3U);
+	for (uint32_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		if (!removedTriangles[triangleIndex])
+		{
+			simplifiedIndices.push_back(FindVertex(indices[triangleIndex * 3U]));
+			simplifiedIndices.push_back(FindVertex(indices[triangleIndex * 3U + 1U]));
+			simplifiedIndices.push_back(FindVertex(indices[triangleIndex * 3U + 2U]));
+		}
+	}
+
+	return simplifiedIndices;
+}
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine
+{
+
+// MeshSimplifier reduces triangle count of an indexed triangle list by quadric error metric edge collapses (Garland and Heckbert).
+// Vertices only collapse onto existing vertices so that simplified index buffers share the original vertex buffer.
+// Border vertices, which include UV and normal seams in split vertex buffers, are locked to avoid cracks.
+class MeshSimplifier
+{
+public:
+	// pPositions points to the first position, positionStride is the byte distance between two vertices.
+	// maxError is the allowed distance to original surface relative to the mesh extent.
+	static std::vector<uint32_t> Simplify(const std::byte* pPositions, uint32_t positionStride, uint32_t vertexCount,
+		const std::vector<uint32_t>& indices, uint32_t targetIndexCount, float maxError);
+};
+
+}
@@ -28,7 +28,7 @@ constexpr bgfx::Attrib::Enum AllAttribUVTypes[] = {
 	bgfx::Attrib::Enum::TexCoord7
 };
 
-void ConvertVertexLayout(const cd::VertexAttributeLayout& vertexAttributeLayout, bgfx::VertexLayout& outVertexLayout)
+void ConvertVertexLayout(const cd::VertexAttributeLayout& vertexAttributeLayout, bgfx::VertexLayout& outVertexLayout, engine::VertexLayoutVariant variant = engine::VertexLayoutVariant::Full)
 {
 	bgfx::Attrib::Enum vertexAttribute = bgfx::Attrib::Enum::Count;
 	bgfx::AttribType::Enum vertexAttributeValue = bgfx::AttribType::Enum::Count;
@@ -102,7 +102,29 @@ void ConvertVertexLayout(const cd::VertexAttributeLayout& vertexAttributeLayout,
 
 	assert(vertexAttribute != bgfx::Attrib::Enum::Count);
 	assert(vertexAttributeValue != bgfx::AttribType::Enum::Count);
-	outVertexLayout.add(vertexAttribute, vertexAttributeLayout.attributeCount, vertexAttributeValue, normalized);
+
+	uint8_t attributeCount = vertexAttributeLayout.attributeCount;
+	if (engine::VertexLayoutVariant::Quantized == variant && cd::AttributeValueType::Float == vertexAttributeLayout.attributeValueType)
+	{
+		switch (vertexAttributeLayout.vertexAttributeType)
+		{
+		case cd::VertexAttributeType::Normal:
+		case cd::VertexAttributeType::Tangent:
+		case cd::VertexAttributeType::Bitangent:
+			// Pad to 4 components to keep attributes 4 bytes aligned.
+			vertexAttributeValue = bgfx::AttribType::Enum::Int16;
+			attributeCount = 4U;
+			normalized = true;
+			break;
+		case cd::VertexAttributeType::UV:
+			vertexAttributeValue = bgfx::AttribType::Enum::Half;
+			break;
+		default:
+			break;
+		}
+	}
+
+	outVertexLayout.add(vertexAttribute, attributeCount, vertexAttributeValue, normalized);
 }
 
 }
@@ -128,6 +150,17 @@ void VertexLayoutUtility::CreateVertexLayout(bgfx::VertexLayout& outVertexLayout
 	outVertexLayout.end();
 }
 
+// static
+void VertexLayoutUtility::CreateVertexLayout(bgfx::VertexLayout& outVertexLayout, const std::vector<cd::VertexAttributeLayout>& vertexAttributes, VertexLayoutVariant variant)
+{
+	outVertexLayout.begin();
+	for (const cd::VertexAttributeLayout& vertexAttributeLayout : vertexAttributes)
+	{
+		ConvertVertexLayout(vertexAttributeLayout, outVertexLayout, variant);
+	}
+	outVertexLayout.end();
+}
+
 // static
 void VertexLayoutUtility::CreateVertexLayout(bgfx::VertexLayout& outVertexLayout, const cd::VertexAttributeLayout& vertexAttribute, bool debugPrint /* = false */)
 {
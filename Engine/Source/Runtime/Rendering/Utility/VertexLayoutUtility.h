@@ -9,11 +9,23 @@
 namespace engine
 {
 
+enum class VertexLayoutVariant
+{
+	// Attributes are stored as cd::VertexFormat describes.
+	Full,
+	// Normal/Tangent/Bitangent are normalized int16x4 and UV is half float. Position and others keep full precision.
+	// Shaders don't need to change as inputs are converted to float by hardware.
+	Quantized,
+};
+
 class VertexLayoutUtility
 {
 public:
 	static void CreateVertexLayout(bgfx::VertexLayout& outVertexLayout, const std::vector<cd::VertexAttributeLayout>& vertexAttributes, bool debugPrint = false);
 	static void CreateVertexLayout(bgfx::VertexLayout& outVertexLayout, const cd::VertexAttributeLayout& vertexAttribute, bool debugPrint = false);
+
+	// bgfx shares vertex layouts with the same hash so meshes in the same variant reuse one layout.
+	static void CreateVertexLayout(bgfx::VertexLayout& outVertexLayout, const std::vector<cd::VertexAttributeLayout>& vertexAttributes, VertexLayoutVariant variant);
 };
 
 }
\ No newline at end of file
@@ -3,8 +3,8 @@
 #include "Core/StringCrc.h"
 #include "ECWorld/SceneWorld.h"
 #include "ECWorld/StaticMeshComponent.h"
-#include "ECWorld/TransformComponent.h"
 #include "Rendering/RenderContext.h"
+#include "Rendering/RenderSnapshot.h"
 #include "Rendering/Resources/MeshResource.h"
 #include "Scene/Texture.h"
 
@@ -16,7 +16,7 @@ void WhiteModelRenderer::Init()
 	constexpr StringCrc programCrc = StringCrc("WhiteModelProgram");
 	GetRenderContext()->RegisterShaderProgram(programCrc, { "vs_whiteModel", "fs_whiteModel" });
 
-	bgfx::setViewName(GetViewID(), "WhiteModelRenderer");
+	SetName("WhiteModelRenderer");
 }
 
 void WhiteModelRenderer::Warmup()
@@ -32,6 +32,7 @@ void WhiteModelRenderer::UpdateView(const float* pViewMatrix, const float* pProj
 
 void WhiteModelRenderer::Render(float deltaTime)
 {
+	const RenderSnapshot* pSnapshot = GetRenderContext()->GetRenderSnapshot();
 	for (Entity entity : m_pCurrentSceneWorld->GetStaticMeshEntities())
 	{
 		if (m_pCurrentSceneWorld->GetSkyEntity() == entity)
@@ -58,10 +59,9 @@ void WhiteModelRenderer::Render(float deltaTime)
 			continue;
 		}
 
-		if (TransformComponent* pTransformComponent = m_pCurrentSceneWorld->GetTransformComponent(entity))
+		if (const RenderSnapshotTransform* pTransform = pSnapshot->FindTransform(entity))
 		{
-			pTransformComponent->Build();
-			bgfx::setTransform(pTransformComponent->GetWorldMatrix().begin());
+			bgfx::setTransform(pTransform->worldMatrix.begin());
 		}
 
 		constexpr uint64_t state = BGFX_STATE_WRITE_MASK | BGFX_STATE_MSAA | BGFX_STATE_DEPTH_TEST_LESS |
@@ -3,8 +3,8 @@
 #include "Core/StringCrc.h"
 #include "ECWorld/SceneWorld.h"
 #include "ECWorld/StaticMeshComponent.h"
-#include "ECWorld/TransformComponent.h"
 #include "Rendering/RenderContext.h"
+#include "Rendering/RenderSnapshot.h"
 #include "Rendering/Resources/MeshResource.h"
 #include "Scene/Texture.h"
 
@@ -18,7 +18,7 @@ void WireframeRenderer::Init()
 	constexpr StringCrc programCrc = StringCrc("WireframeLineProgram");
 	GetRenderContext()->RegisterShaderProgram(programCrc, { "vs_wireframe_line", "fs_wireframe_line" });
 
-	bgfx::setViewName(GetViewID(), "WireframeRenderer");
+	SetName("WireframeRenderer");
 }
 
 void WireframeRenderer::Warmup()
@@ -34,6 +34,7 @@ void WireframeRenderer::UpdateView(const float* pViewMatrix, const float* pProje
 
 void WireframeRenderer::Render(float deltaTime)
 {
+	const RenderSnapshot* pSnapshot = GetRenderContext()->GetRenderSnapshot();
 	for (Entity entity : m_pCurrentSceneWorld->GetStaticMeshEntities())
 	{
 		if (!m_enableGlobalWireframe && m_pCurrentSceneWorld->GetSelectedEntity() != entity)
@@ -65,10 +66,9 @@ void WireframeRenderer::Render(float deltaTime)
 			continue;
 		}
 
-		if (TransformComponent* pTransformComponent = m_pCurrentSceneWorld->GetTransformComponent(entity))
+		if (const RenderSnapshotTransform* pTransform = pSnapshot->FindTransform(entity))
 		{
-			pTransformComponent->Build();
-			bgfx::setTransform(pTransformComponent->GetWorldMatrix().begin());
+			bgfx::setTransform(pTransform->worldMatrix.begin());
 		}
 
 		constexpr uint64_t state = BGFX_STATE_WRITE_MASK | BGFX_STATE_MSAA | BGFX_STATE_DEPTH_TEST_LEQUAL |
@@ -1,15 +1,15 @@
 #include "WorldRenderer.h"
 
-#include "ECWorld/CameraComponent.h"
+#include "Core/Memory/ArenaAllocator.h"
 #include "ECWorld/MaterialComponent.h"
 #include "ECWorld/SceneWorld.h"
 #include "ECWorld/SkyComponent.h"
 #include "ECWorld/StaticMeshComponent.h"
-#include "ECWorld/TransformComponent.h"
 #include "LightUniforms.h"
 #include "Material/ShaderSchema.h"
 #include "Math/Transform.hpp"
 #include "Rendering/RenderContext.h"
+#include "Rendering/RenderSnapshot.h"
 #include "Rendering/Resources/MeshResource.h"
 #include "Rendering/Resources/TextureResource.h"
 #include "Scene/Texture.h"
@@ -17,6 +17,9 @@
 #include "U_AtmophericScattering.sh"
 #include "U_Shadow.sh"
 
+#include <algorithm>
+#include <cmath>
+
 namespace engine
 {
 
@@ -60,9 +63,28 @@ constexpr uint64_t blitDstTextureFlags = BGFX_TEXTURE_BLIT_DST | BGFX_SAMPLER_U_
 
 }
 
+struct WorldRenderer::FrameData
+{
+	explicit FrameData(LinearArena& arena)
+		: lightViewProjsData(ArenaAllocator<cd::Matrix4x4>(arena))
+	{
+	}
+
+	const RenderSnapshotCamera* pCamera = nullptr;
+	const SkyComponent* pSkyComponent = nullptr;
+	cd::Direction sunDirection;
+	bgfx::TextureHandle irradianceTexture = BGFX_INVALID_HANDLE;
+	bgfx::TextureHandle radianceTexture = BGFX_INVALID_HANDLE;
+
+	cd::Vec4f lightInfoData;
+	float lightData[4 * 7 * 3] = { 0 };
+	ArenaVector<cd::Matrix4x4> lightViewProjsData;
+	uint16_t lightViewProjCount = 0U;
+};
+
 void WorldRenderer::Init()
 {
-	bgfx::setViewName(GetViewID(), "WorldRenderer");
+	SetName("WorldRenderer");
 }
 
 void WorldRenderer::Warmup()
@@ -108,11 +130,11 @@ void WorldRenderer::UpdateView(const float* pViewMatrix, const float* pProjectio
 void WorldRenderer::Render(float deltaTime)
 {
 	// TODO : Remove it. If every renderer need to submit camera related uniform, it should be done not inside Renderer class.
-	const CameraComponent* pMainCameraComponent = m_pCurrentSceneWorld->GetCameraComponent(m_pCurrentSceneWorld->GetMainCameraEntity());
-	const cd::Transform& cameraTransform = m_pCurrentSceneWorld->GetTransformComponent(m_pCurrentSceneWorld->GetMainCameraEntity())->GetTransform();
+	const RenderSnapshot* pSnapshot = GetRenderContext()->GetRenderSnapshot();
+	const RenderSnapshotCamera& camera = pSnapshot->GetCamera();
 	SkyComponent* pSkyComponent = m_pCurrentSceneWorld->GetSkyComponent(m_pCurrentSceneWorld->GetSkyEntity());
 
-	auto lightEntities = m_pCurrentSceneWorld->GetLightEntities();
+	const auto& lightEntities = m_pCurrentSceneWorld->GetLightEntities();
 	size_t lightEntityCount = lightEntities.size();
 
 	// Blit RTV to SRV to update light shadow map
@@ -174,8 +196,52 @@ void WorldRenderer::Render(float deltaTime)
 		}
 	}
 
-	for (Entity entity : m_pCurrentSceneWorld->GetMaterialEntities())
+	// Per-frame values which used to be rebuilt for every draw call.
+	FrameData frameData(GetRenderContext()->GetFrameAllocator()->GetArena());
+	frameData.pCamera = &camera;
+	frameData.pSkyComponent = pSkyComponent;
+	frameData.sunDirection = pSnapshot->GetSunDirection();
+
+	if (SkyType::SkyBox == pSkyComponent->GetSkyType())
+	{
+		// Create a new TextureHandle each frame if the skybox texture path has been updated,
+		// otherwise RenderContext::CreateTexture will skip it automatically.
+		GetRenderContext()->CreateTexture(pSkyComponent->GetIrradianceTexturePath().c_str(), samplerFlags);
+		GetRenderContext()->CreateTexture(pSkyComponent->GetRadianceTexturePath().c_str(), samplerFlags);
+		frameData.irradianceTexture = GetRenderContext()->GetTexture(StringCrc(pSkyComponent->GetIrradianceTexturePath()));
+		frameData.radianceTexture = GetRenderContext()->GetTexture(StringCrc(pSkyComponent->GetRadianceTexturePath()));
+	}
+
+	frameData.lightInfoData = cd::Vec4f(static_cast<float>(lightEntityCount), LightUniform::LIGHT_STRIDE, 0.0f, 0.0f);
+	uint16_t totalLightViewProjOffset = 0U;
+	for (uint16_t i = 0U; i < lightEntityCount; ++i)
 	{
+		LightComponent* lightComponent = m_pCurrentSceneWorld->GetLightComponent(lightEntities[i]);
+		if (cd::LightType::Directional == lightComponent->GetType())
+		{
+			lightComponent->SetLightViewProjOffset(totalLightViewProjOffset);
+			totalLightViewProjOffset += 4;
+		}
+		else if (cd::LightType::Spot == lightComponent->GetType())
+		{
+			lightComponent->SetLightViewProjOffset(totalLightViewProjOffset);
+			totalLightViewProjOffset++;
+		}
+		memcpy(&frameData.lightData[4 * 7 * i], lightComponent->GetLightUniformData(), sizeof(U_Light));
+
+		const std::vector<cd::Matrix4x4>& lightViewProjs = lightComponent->GetLightViewProjMatrix();
+		frameData.lightViewProjsData.insert(frameData.lightViewProjsData.end(), lightViewProjs.begin(), lightViewProjs.end());
+	}
+	frameData.lightViewProjCount = totalLightViewProjOffset;
+
+	// Gather drawable entities serially. LOD selection and mip streaming feedback write to shared resources.
+	// Entities deleted after the snapshot was captured are skipped by component checks.
+	m_drawItemIndexes.clear();
+	const std::vector<RenderSnapshotItem>& snapshotItems = pSnapshot->GetItems();
+	for (uint32_t itemIndex = 0U; itemIndex < snapshotItems.size(); ++itemIndex)
+	{
+		const RenderSnapshotItem& item = snapshotItems[itemIndex];
+		Entity entity = item.entity;
 		MaterialComponent* pMaterialComponent = m_pCurrentSceneWorld->GetMaterialComponent(entity);
 		if (!pMaterialComponent ||
 			pMaterialComponent->GetMaterialType() != m_pCurrentSceneWorld->GetPBRMaterialType() ||
@@ -200,205 +266,204 @@ void WorldRenderer::Render(float deltaTime)
 			continue;
 		}
 
-		// SkinMesh
-		if(m_pCurrentSceneWorld->GetAnimationComponent(entity))
+		if (item.hasWorldAABB)
 		{
-			continue;
+			pMeshComponent->UpdateLod(item.worldAABB, camera.position, camera.fov);
 		}
 
-		// Transform
-		if (TransformComponent* pTransformComponent = m_pCurrentSceneWorld->GetTransformComponent(entity))
+		// SkinMesh
+		if(m_pCurrentSceneWorld->GetAnimationComponent(entity))
 		{
-			bgfx::setTransform(pTransformComponent->GetWorldMatrix().begin());
+			continue;
 		}
 
-		// Material
-		// TODO : need to check if one texture binds twice to different slot. Or will get bgfx assert about duplicated uniform set.
-		// So please have a research about same texture handle binds to different slots multiple times.
-		// The factor is to build slot -> texture handle maps before update.
-		bool textureSlotBindTable[32] = { false };
+		// Mip streaming feedback. UV scale repeats the texture across the surface.
 		for (const auto& [textureType, propertyGroup] : pMaterialComponent->GetPropertyGroups())
 		{
-			const MaterialComponent::TextureInfo& textureInfo = propertyGroup.textureInfo;
-			if (textureSlotBindTable[textureInfo.slot])
+			TextureResource* pTextureResource = propertyGroup.textureInfo.pTextureResource;
+			if (propertyGroup.useTexture && pTextureResource &&
+				(pTextureResource->GetStatus() == ResourceStatus::Ready || pTextureResource->GetStatus() == ResourceStatus::Optimized))
 			{
-				// already bind.
-				continue;
+				float uvScale = std::max(std::abs(propertyGroup.textureInfo.GetUVScale().x()), std::abs(propertyGroup.textureInfo.GetUVScale().y()));
+				pTextureResource->RequestScreenSize(pMeshComponent->GetScreenSize() * static_cast<float>(GetRenderContext()->GetBackBufferHeight()) * std::max(uvScale, 1.0f));
 			}
-
-			TextureResource* pTextureResource = textureInfo.pTextureResource;
-			if (!propertyGroup.useTexture ||
-				pTextureResource == nullptr ||
-				(pTextureResource->GetStatus() != ResourceStatus::Ready && pTextureResource->GetStatus() != ResourceStatus::Optimized))
-			{
-				continue;
-			}
-
-			if (cd::MaterialTextureType::BaseColor == textureType)
-			{
-				constexpr StringCrc albedoUVOffsetAndScaleCrc(albedoUVOffsetAndScale);
-				cd::Vec4f uvOffsetAndScaleData(textureInfo.GetUVOffset().x(), textureInfo.GetUVOffset().y(),
-					textureInfo.GetUVScale().x(), textureInfo.GetUVScale().y());
-				GetRenderContext()->FillUniform(albedoUVOffsetAndScaleCrc, &uvOffsetAndScaleData, 1);
-			}
-
-			textureSlotBindTable[textureInfo.slot] = true;
-			bgfx::setTexture(textureInfo.slot, bgfx::UniformHandle{ pTextureResource->GetSamplerHandle() }, bgfx::TextureHandle{ pTextureResource->GetTextureHandle() });
 		}
 
-		// Sky
-		SkyType crtSkyType = pSkyComponent->GetSkyType();
-		if (SkyType::SkyBox == crtSkyType)
-		{
-			// Create a new TextureHandle each frame if the skybox texture path has been updated,
-			// otherwise RenderContext::CreateTexture will skip it automatically.
-
-			constexpr StringCrc irrSamplerCrc(cubeIrradianceSampler);
-			GetRenderContext()->CreateTexture(pSkyComponent->GetIrradianceTexturePath().c_str(), samplerFlags);
-			bgfx::setTexture(IBL_IRRADIANCE_SLOT,
-				GetRenderContext()->GetUniform(irrSamplerCrc),
-				GetRenderContext()->GetTexture(StringCrc(pSkyComponent->GetIrradianceTexturePath())));
-
-			constexpr StringCrc radSamplerCrc(cubeRadianceSampler);
-			GetRenderContext()->CreateTexture(pSkyComponent->GetRadianceTexturePath().c_str(), samplerFlags);
-			bgfx::setTexture(IBL_RADIANCE_SLOT,
-				GetRenderContext()->GetUniform(radSamplerCrc),
-				GetRenderContext()->GetTexture(StringCrc(pSkyComponent->GetRadianceTexturePath())));
-
-			constexpr StringCrc lutsamplerCrc(lutSampler);
-			constexpr StringCrc luttextureCrc(lutTexture);
-			bgfx::setTexture(BRDF_LUT_SLOT, GetRenderContext()->GetUniform(lutsamplerCrc), GetRenderContext()->GetTexture(luttextureCrc));
-		}
-		else if (SkyType::AtmosphericScattering == crtSkyType)
-		{
-			bgfx::setImage(ATM_TRANSMITTANCE_SLOT, GetRenderContext()->GetTexture(pSkyComponent->GetATMTransmittanceCrc()), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
-			bgfx::setImage(ATM_IRRADIANCE_SLOT, GetRenderContext()->GetTexture(pSkyComponent->GetATMIrradianceCrc()), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
-			bgfx::setImage(ATM_SCATTERING_SLOT, GetRenderContext()->GetTexture(pSkyComponent->GetATMScatteringCrc()), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
-
-			constexpr StringCrc LightDirCrc(LightDir);
-			GetRenderContext()->FillUniform(LightDirCrc, &(pSkyComponent->GetSunDirection().x()), 1);
-
-			constexpr StringCrc HeightOffsetAndshadowLengthCrc(HeightOffsetAndshadowLength);
-			cd::Vec4f tmpHeightOffsetAndshadowLength = cd::Vec4f(pSkyComponent->GetHeightOffset(), pSkyComponent->GetShadowLength(), 0.0f, 0.0f);
-			GetRenderContext()->FillUniform(HeightOffsetAndshadowLengthCrc, &(tmpHeightOffsetAndshadowLength.x()), 1);
-		}
+		m_drawItemIndexes.push_back(itemIndex);
+	}
 
-		// Submit uniform values : camera settings
-		constexpr StringCrc cameraPosCrc(cameraPos);
-		GetRenderContext()->FillUniform(cameraPosCrc, &cameraTransform.GetTranslation().x(), 1);
-
-		constexpr StringCrc cameraNearFarPlaneCrc(cameraNearFarPlane);
-		float cameraNearFarPlanedata[2]{ pMainCameraComponent->GetNearPlane(), pMainCameraComponent->GetFarPlane() };
-		GetRenderContext()->FillUniform(cameraNearFarPlaneCrc, cameraNearFarPlanedata, 1);
-
-		// Submit uniform values : material settings
-		constexpr StringCrc albedoColorCrc(albedoColor);
-		GetRenderContext()->FillUniform(albedoColorCrc, pMaterialComponent->GetFactor<cd::Vec3f>(cd::MaterialPropertyGroup::BaseColor), 1);
-
-		cd::Vec4f metallicRoughnessFactorData(
-			*(pMaterialComponent->GetFactor<float>(cd::MaterialPropertyGroup::Metallic)),
-			*(pMaterialComponent->GetFactor<float>(cd::MaterialPropertyGroup::Roughness)),
-			1.0f, 1.0f);
-		constexpr StringCrc mrFactorCrc(metallicRoughnessFactor);
-		GetRenderContext()->FillUniform(mrFactorCrc, metallicRoughnessFactorData.begin(), 1);
-
-		constexpr StringCrc emissiveColorCrc(emissiveColorAndFactor);
-		GetRenderContext()->FillUniform(emissiveColorCrc, pMaterialComponent->GetFactor<cd::Vec4f>(cd::MaterialPropertyGroup::Emissive), 1);
-
-		// Submit light data
-		constexpr engine::StringCrc lightCountAndStrideCrc(lightCountAndStride);
-		static cd::Vec4f lightInfoData(0, LightUniform::LIGHT_STRIDE, 0.0f, 0.0f);
-		lightInfoData.x() = static_cast<float>(lightEntityCount);
-		GetRenderContext()->FillUniform(lightCountAndStrideCrc, lightInfoData.begin(), 1);
-		int totalLightViewProjOffset = 0;
-		float lightData[4 *7 * 3] = { 0 };
-		for (uint16_t i = 0U; i < lightEntityCount; ++i)
+	// Record draw calls in parallel. Each one only reads components of its own entity and frameData.
+	auto recordDrawCalls = [this, &frameData, &snapshotItems](bgfx::Encoder* pEncoder, uint32_t beginIndex, uint32_t endIndex)
+	{
+		for (uint32_t drawIndex = beginIndex; drawIndex < endIndex; ++drawIndex)
 		{
-			LightComponent* lightComponent = m_pCurrentSceneWorld->GetLightComponent(lightEntities[i]);
-			if (cd::LightType::Directional == lightComponent->GetType())
-			{
-				lightComponent->SetLightViewProjOffset(totalLightViewProjOffset);
-				totalLightViewProjOffset += 4;
-			}
-			else if (cd::LightType::Spot == lightComponent->GetType())
-			{
-				lightComponent->SetLightViewProjOffset(totalLightViewProjOffset);
-				totalLightViewProjOffset++;
-			}
-			memcpy(&lightData[4 * 7 * i], lightComponent->GetLightUniformData(), sizeof(U_Light));
+			SubmitEntityDrawCall(pEncoder, frameData, snapshotItems[m_drawItemIndexes[drawIndex]]);
 		}
-		constexpr engine::StringCrc lightParamsCrc(lightParams);
-		GetRenderContext()->FillUniform(lightParamsCrc, lightData, static_cast<uint16_t>(lightEntityCount * LightUniform::LIGHT_STRIDE));
+	};
+	GetRenderContext()->GetEncoderWorkerPool()->Record(static_cast<uint32_t>(m_drawItemIndexes.size()), recordDrawCalls);
+}
 
-		// Submit light view&projection transform
-		std::vector<cd::Matrix4x4> lightViewProjsData;
-		for (uint16_t i = 0U; i < lightEntityCount; ++i)
+void WorldRenderer::SubmitEntityDrawCall(bgfx::Encoder* pEncoder, const FrameData& frameData, const RenderSnapshotItem& item)
+{
+	Entity entity = item.entity;
+	MaterialComponent* pMaterialComponent = m_pCurrentSceneWorld->GetMaterialComponent(entity);
+	StaticMeshComponent* pMeshComponent = m_pCurrentSceneWorld->GetStaticMeshComponent(entity);
+	const SkyComponent* pSkyComponent = frameData.pSkyComponent;
+
+	// Transform
+	pEncoder->setTransform(item.worldMatrix.begin());
+
+	// Material
+	// TODO : need to check if one texture binds twice to different slot. Or will get bgfx assert about duplicated uniform set.
+	// So please have a research about same texture handle binds to different slots multiple times.
+	// The factor is to build slot -> texture handle maps before update.
+	bool textureSlotBindTable[32] = { false };
+	for (const auto& [textureType, propertyGroup] : pMaterialComponent->GetPropertyGroups())
+	{
+		const MaterialComponent::TextureInfo& textureInfo = propertyGroup.textureInfo;
+		if (textureSlotBindTable[textureInfo.slot])
 		{
-			LightComponent* lightComponent = m_pCurrentSceneWorld->GetLightComponent(lightEntities[i]);
-			const std::vector<cd::Matrix4x4>& lightViewProjs = lightComponent->GetLightViewProjMatrix();
-			for (auto lightViewProj : lightViewProjs)
-			{
-				lightViewProjsData.push_back(lightViewProj);
-			}
+			// already bind.
+			continue;
 		}
-		constexpr engine::StringCrc lightViewProjsCrc(lightViewProjs);
-		GetRenderContext()->FillUniform(lightViewProjsCrc, lightViewProjsData.data(), totalLightViewProjOffset);
 
-		// Submit shadow map and settings of each light
-		constexpr StringCrc shadowMapSamplerCrcs[3] = { StringCrc(cubeShadowMapSamplers[0]), StringCrc(cubeShadowMapSamplers[1]), StringCrc(cubeShadowMapSamplers[2]) };
-		for (int lightIndex = 0; lightIndex < lightEntityCount; lightIndex++)
+		TextureResource* pTextureResource = textureInfo.pTextureResource;
+		if (!propertyGroup.useTexture ||
+			pTextureResource == nullptr ||
+			(pTextureResource->GetStatus() != ResourceStatus::Ready && pTextureResource->GetStatus() != ResourceStatus::Optimized))
 		{
-			auto lightComponent = m_pCurrentSceneWorld->GetLightComponent(lightEntities[lightIndex]);
-			cd::LightType lightType = lightComponent->GetType();
-			if (cd::LightType::Directional == lightType)
-			{
-				bgfx::TextureHandle blitDstShadowMapTexture = static_cast<bgfx::TextureHandle>(lightComponent->GetShadowMapTexture());
-				bgfx::setTexture(SHADOW_MAP_CUBE_FIRST_SLOT+lightIndex, GetRenderContext()->GetUniform(shadowMapSamplerCrcs[lightIndex]), blitDstShadowMapTexture);
-				// TODO : manual 
-				constexpr StringCrc clipFrustumDepthCrc(clipFrustumDepth);
-				GetRenderContext()->FillUniform(clipFrustumDepthCrc, lightComponent->GetComputedCascadeSplit(), 1);
-			}
-			else if (cd::LightType::Point == lightType)
-			{
-				bgfx::TextureHandle blitDstShadowMapTexture = static_cast<bgfx::TextureHandle>(lightComponent->GetShadowMapTexture());
-				bgfx::setTexture(SHADOW_MAP_CUBE_FIRST_SLOT+lightIndex, GetRenderContext()->GetUniform(shadowMapSamplerCrcs[lightIndex]), blitDstShadowMapTexture);
-			}
-			else if (cd::LightType::Spot == lightType)
-			{
-				// Blit RTV(FrameBuffer Texture) to SRV(Texture)
-				bgfx::TextureHandle blitDstShadowMapTexture = static_cast<bgfx::TextureHandle>(lightComponent->GetShadowMapTexture());
-				bgfx::setTexture(SHADOW_MAP_CUBE_FIRST_SLOT+lightIndex, GetRenderContext()->GetUniform(shadowMapSamplerCrcs[lightIndex]), blitDstShadowMapTexture);
-			}
+			continue;
 		}
 
-		uint64_t state = defaultRenderingState;
-		if (!pMaterialComponent->GetTwoSided())
+		if (cd::MaterialTextureType::BaseColor == textureType)
 		{
-			state |= BGFX_STATE_CULL_CCW;
+			constexpr StringCrc albedoUVOffsetAndScaleCrc(albedoUVOffsetAndScale);
+			cd::Vec4f uvOffsetAndScaleData(textureInfo.GetUVOffset().x(), textureInfo.GetUVOffset().y(),
+				textureInfo.GetUVScale().x(), textureInfo.GetUVScale().y());
+			GetRenderContext()->FillUniform(pEncoder, albedoUVOffsetAndScaleCrc, &uvOffsetAndScaleData, 1);
 		}
 
-		if (cd::BlendMode::Mask == pMaterialComponent->GetBlendMode())
-		{
-			constexpr StringCrc alphaCutOffCrc(alphaCutOff);
-			GetRenderContext()->FillUniform(alphaCutOffCrc, &pMaterialComponent->GetAlphaCutOff(), 1);
-		}
+		textureSlotBindTable[textureInfo.slot] = true;
+		pEncoder->setTexture(textureInfo.slot, bgfx::UniformHandle{ pTextureResource->GetSamplerHandle() }, bgfx::TextureHandle{ pTextureResource->GetTextureHandle() });
+	}
+
+	// Sky
+	SkyType crtSkyType = pSkyComponent->GetSkyType();
+	if (SkyType::SkyBox == crtSkyType)
+	{
+		constexpr StringCrc irrSamplerCrc(cubeIrradianceSampler);
+		pEncoder->setTexture(IBL_IRRADIANCE_SLOT, GetRenderContext()->GetUniform(irrSamplerCrc), frameData.irradianceTexture);
+
+		constexpr StringCrc radSamplerCrc(cubeRadianceSampler);
+		pEncoder->setTexture(IBL_RADIANCE_SLOT, GetRenderContext()->GetUniform(radSamplerCrc), frameData.radianceTexture);
+
+		constexpr StringCrc lutsamplerCrc(lutSampler);
+		constexpr StringCrc luttextureCrc(lutTexture);
+		pEncoder->setTexture(BRDF_LUT_SLOT, GetRenderContext()->GetUniform(lutsamplerCrc), GetRenderContext()->GetTexture(luttextureCrc));
+	}
+	else if (SkyType::AtmosphericScattering == crtSkyType)
+	{
+		pEncoder->setImage(ATM_TRANSMITTANCE_SLOT, GetRenderContext()->GetTexture(pSkyComponent->GetATMTransmittanceCrc()), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
+		pEncoder->setImage(ATM_IRRADIANCE_SLOT, GetRenderContext()->GetTexture(pSkyComponent->GetATMIrradianceCrc()), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
+		pEncoder->setImage(ATM_SCATTERING_SLOT, GetRenderContext()->GetTexture(pSkyComponent->GetATMScatteringCrc()), 0, bgfx::Access::Read, bgfx::TextureFormat::RGBA32F);
+
+		constexpr StringCrc LightDirCrc(LightDir);
+		GetRenderContext()->FillUniform(pEncoder, LightDirCrc, &(frameData.sunDirection.x()), 1);
+
+		constexpr StringCrc HeightOffsetAndshadowLengthCrc(HeightOffsetAndshadowLength);
+		cd::Vec4f tmpHeightOffsetAndshadowLength = cd::Vec4f(pSkyComponent->GetHeightOffset(), pSkyComponent->GetShadowLength(), 0.0f, 0.0f);
+		GetRenderContext()->FillUniform(pEncoder, HeightOffsetAndshadowLengthCrc, &(tmpHeightOffsetAndshadowLength.x()), 1);
+	}
+
+	// Submit uniform values : camera settings
+	constexpr StringCrc cameraPosCrc(cameraPos);
+	GetRenderContext()->FillUniform(pEncoder, cameraPosCrc, &frameData.pCamera->position.x(), 1);
+
+	constexpr StringCrc cameraNearFarPlaneCrc(cameraNearFarPlane);
+	float cameraNearFarPlanedata[2]{ frameData.pCamera->nearPlane, frameData.pCamera->farPlane };
+	GetRenderContext()->FillUniform(pEncoder, cameraNearFarPlaneCrc, cameraNearFarPlanedata, 1);
+
+	// Submit uniform values : material settings
+	constexpr StringCrc albedoColorCrc(albedoColor);
+	GetRenderContext()->FillUniform(pEncoder, albedoColorCrc, pMaterialComponent->GetFactor<cd::Vec3f>(cd::MaterialPropertyGroup::BaseColor), 1);
+
+	cd::Vec4f metallicRoughnessFactorData(
+		*(pMaterialComponent->GetFactor<float>(cd::MaterialPropertyGroup::Metallic)),
+		*(pMaterialComponent->GetFactor<float>(cd::MaterialPropertyGroup::Roughness)),
+		1.0f, 1.0f);
+	constexpr StringCrc mrFactorCrc(metallicRoughnessFactor);
+	GetRenderContext()->FillUniform(pEncoder, mrFactorCrc, metallicRoughnessFactorData.begin(), 1);
+
+	constexpr StringCrc emissiveColorCrc(emissiveColorAndFactor);
+	GetRenderContext()->FillUniform(pEncoder, emissiveColorCrc, pMaterialComponent->GetFactor<cd::Vec4f>(cd::MaterialPropertyGroup::Emissive), 1);
+
+	// Submit light data
+	constexpr engine::StringCrc lightCountAndStrideCrc(lightCountAndStride);
+	GetRenderContext()->FillUniform(pEncoder, lightCountAndStrideCrc, frameData.lightInfoData.begin(), 1);
 
-		bgfx::setState(state);
+	uint16_t lightEntityCount = static_cast<uint16_t>(frameData.lightInfoData.x());
+	constexpr engine::StringCrc lightParamsCrc(lightParams);
+	GetRenderContext()->FillUniform(pEncoder, lightParamsCrc, frameData.lightData, static_cast<uint16_t>(lightEntityCount * LightUniform::LIGHT_STRIDE));
 
-		// Mesh
-		if (BlendShapeComponent* pBlendShapeComponent = m_pCurrentSceneWorld->GetBlendShapeComponent(entity))
+	// Submit light view&projection transform
+	constexpr engine::StringCrc lightViewProjsCrc(lightViewProjs);
+	GetRenderContext()->FillUniform(pEncoder, lightViewProjsCrc, frameData.lightViewProjsData.data(), frameData.lightViewProjCount);
+
+	// Submit shadow map and settings of each light
+	constexpr StringCrc shadowMapSamplerCrcs[3] = { StringCrc(cubeShadowMapSamplers[0]), StringCrc(cubeShadowMapSamplers[1]), StringCrc(cubeShadowMapSamplers[2]) };
+	const auto& lightEntities = m_pCurrentSceneWorld->GetLightEntities();
+	for (int lightIndex = 0; lightIndex < lightEntityCount; lightIndex++)
+	{
+		auto lightComponent = m_pCurrentSceneWorld->GetLightComponent(lightEntities[lightIndex]);
+		cd::LightType lightType = lightComponent->GetType();
+		if (cd::LightType::Directional == lightType)
+		{
+			bgfx::TextureHandle blitDstShadowMapTexture = static_cast<bgfx::TextureHandle>(lightComponent->GetShadowMapTexture());
+			pEncoder->setTexture(SHADOW_MAP_CUBE_FIRST_SLOT+lightIndex, GetRenderContext()->GetUniform(shadowMapSamplerCrcs[lightIndex]), blitDstShadowMapTexture);
+			// TODO : manual 
+			constexpr StringCrc clipFrustumDepthCrc(clipFrustumDepth);
+			GetRenderContext()->FillUniform(pEncoder, clipFrustumDepthCrc, lightComponent->GetComputedCascadeSplit(), 1);
+		}
+		else if (cd::LightType::Point == lightType)
 		{
-			bgfx::setVertexBuffer(0, bgfx::DynamicVertexBufferHandle{ pBlendShapeComponent->GetFinalMorphAffectedVB() });
-			bgfx::setVertexBuffer(1, bgfx::VertexBufferHandle{ pBlendShapeComponent->GetNonMorphAffectedVB() });
-			// TODO : BlendShape + multiple index buffers.
-			bgfx::setIndexBuffer(bgfx::IndexBufferHandle{ pMeshComponent->GetMeshResource()->GetIndexBufferHandle(0U) });
-			GetRenderContext()->Submit(GetViewID(), pMaterialComponent->GetShaderProgramName(), pMaterialComponent->GetFeaturesCombine());
+			bgfx::TextureHandle blitDstShadowMapTexture = static_cast<bgfx::TextureHandle>(lightComponent->GetShadowMapTexture());
+			pEncoder->setTexture(SHADOW_MAP_CUBE_FIRST_SLOT+lightIndex, GetRenderContext()->GetUniform(shadowMapSamplerCrcs[lightIndex]), blitDstShadowMapTexture);
 		}
-		else
+		else if (cd::LightType::Spot == lightType)
 		{
-			SubmitStaticMeshDrawCall(pMeshComponent, GetViewID(), pMaterialComponent->GetShaderProgramName(), pMaterialComponent->GetFeaturesCombine());
+			// Blit RTV(FrameBuffer Texture) to SRV(Texture)
+			bgfx::TextureHandle blitDstShadowMapTexture = static_cast<bgfx::TextureHandle>(lightComponent->GetShadowMapTexture());
+			pEncoder->setTexture(SHADOW_MAP_CUBE_FIRST_SLOT+lightIndex, GetRenderContext()->GetUniform(shadowMapSamplerCrcs[lightIndex]), blitDstShadowMapTexture);
 		}
 	}
+
+	uint64_t state = defaultRenderingState;
+	if (!pMaterialComponent->GetTwoSided())
+	{
+		state |= BGFX_STATE_CULL_CCW;
+	}
+
+	if (cd::BlendMode::Mask == pMaterialComponent->GetBlendMode())
+	{
+		constexpr StringCrc alphaCutOffCrc(alphaCutOff);
+		GetRenderContext()->FillUniform(pEncoder, alphaCutOffCrc, &pMaterialComponent->GetAlphaCutOff(), 1);
+	}
+
+	pEncoder->setState(state);
+
+	// Mesh
+	if (BlendShapeComponent* pBlendShapeComponent = m_pCurrentSceneWorld->GetBlendShapeComponent(entity))
+	{
+		pEncoder->setVertexBuffer(0, bgfx::DynamicVertexBufferHandle{ pBlendShapeComponent->GetFinalMorphAffectedVB() });
+		pEncoder->setVertexBuffer(1, bgfx::VertexBufferHandle{ pBlendShapeComponent->GetNonMorphAffectedVB() });
+		// TODO : BlendShape + multiple index buffers.
+		pEncoder->setIndexBuffer(bgfx::IndexBufferHandle{ pMeshComponent->GetMeshResource()->GetIndexBufferHandle(0U) });
+		GetRenderContext()->Submit(pEncoder, GetViewID(), pMaterialComponent->GetShaderProgramName(), pMaterialComponent->GetFeaturesCombine());
+	}
+	else
+	{
+		SubmitStaticMeshDrawCall(pEncoder, pMeshComponent, GetViewID(), pMaterialComponent->GetShaderProgramName(), pMaterialComponent->GetFeaturesCombine());
+	}
 }
 
 }
\ No newline at end of file
@@ -2,10 +2,14 @@
 
 #include "Renderer.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace engine
 {
 
 class SceneWorld;
+struct RenderSnapshotItem;
 
 class WorldRenderer final : public Renderer
 {
@@ -19,8 +23,16 @@ public:
 
 	void SetSceneWorld(SceneWorld* pSceneWorld) { m_pCurrentSceneWorld = pSceneWorld; }
 
+private:
+	// Per-frame values shared by all draw calls. They are prepared before recording in parallel.
+	struct FrameData;
+
+	void SubmitEntityDrawCall(bgfx::Encoder* pEncoder, const FrameData& frameData, const RenderSnapshotItem& item);
+
 private:
 	SceneWorld* m_pCurrentSceneWorld = nullptr;
+	// Indexes of snapshot items passed resource checks in current frame. Kept to reuse memory.
+	std::vector<uint32_t> m_drawItemIndexes;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "CookedScene.h"
+
+#include "Log/Log.h"
+
+#include <cassert>
+
+namespace engine
+{
+
+bool CookedScene::Open(const char* pFilePath)
+{
+	m_pHeader = nullptr;
+	if (!m_file.Open(pFilePath))
+	{
+		CD_ENGINE_ERROR("Failed to map cooked scene {0}.", pFilePath);
+		return false;
+	}
+
+	if (m_file.GetSize() < sizeof(CookedSceneFormat::Header))
+	{
+		CD_ENGINE_ERROR("Cooked scene {0} is too small.", pFilePath);
+		m_file.Close();
+		return false;
+	}
+
+	const auto* pHeader = reinterpret_cast<const CookedSceneFormat::Header*>(m_file.GetData());
+	if (pHeader->magic != CookedSceneFormat::Magic || pHeader->version != CookedSceneFormat::Version || pHeader->fileSize != m_file.GetSize())
+	{
+		CD_ENGINE_ERROR("Cooked scene {0} has an unsupported header or is truncated.", pFilePath);
+		m_file.Close();
+		return false;
+	}
+
+	// Only ranges are validated here. Records are trusted as the file is produced by our cooker.
+	for (const CookedSceneFormat::Section& section : pHeader->sections)
+	{
+		if (section.offset % CookedSceneFormat::Alignment != 0U || section.offset > m_file.GetSize() || section.size > m_file.GetSize() - section.offset)
+		{
+			CD_ENGINE_ERROR("Cooked scene {0} has an invalid section range.", pFilePath);
+			m_file.Close();
+			return false;
+		}
+	}
+
+	m_pHeader = pHeader;
+	return true;
+}
+
+uint32_t CookedScene::GetSectionCount(CookedSceneFormat::SectionType sectionType) const
+{
+	return m_pHeader ? m_pHeader->sections[static_cast<size_t>(sectionType)].count : 0U;
+}
+
+const std::byte* CookedScene::GetSectionData(CookedSceneFormat::SectionType sectionType) const
+{
+	assert(m_pHeader);
+	return m_file.GetData() + m_pHeader->sections[static_cast<size_t>(sectionType)].offset;
+}
+
+const CookedSceneFormat::Mesh& CookedScene::GetMesh(uint32_t index) const
+{
+	assert(index < GetMeshCount());
+	return reinterpret_cast<const CookedSceneFormat::Mesh*>(GetSectionData(CookedSceneFormat::SectionType::Meshes))[index];
+}
+
+const CookedSceneFormat::PolygonGroup& CookedScene::GetPolygonGroup(const CookedSceneFormat::Mesh& mesh, uint32_t index) const
+{
+	assert(index < mesh.polygonGroupCount);
+	return reinterpret_cast<const CookedSceneFormat::PolygonGroup*>(GetSectionData(CookedSceneFormat::SectionType::PolygonGroups))[mesh.firstPolygonGroup + index];
+}
+
+const CookedSceneFormat::Material& CookedScene::GetMaterial(uint32_t index) const
+{
+	assert(index < GetMaterialCount());
+	return reinterpret_cast<const CookedSceneFormat::Material*>(GetSectionData(CookedSceneFormat::SectionType::Materials))[index];
+}
+
+std::string_view CookedScene::GetString(uint32_t offset) const
+{
+	if (CookedSceneFormat::InvalidIndex == offset)
+	{
+		return {};
+	}
+
+	// Strings are stored null terminated.
+	return std::string_view(reinterpret_cast<const char*>(GetSectionData(CookedSceneFormat::SectionType::Strings) + offset));
+}
+
+std::span<const std::byte> CookedScene::GetVertexData(const CookedSceneFormat::Mesh& mesh) const
+{
+	return { GetSectionData(CookedSceneFormat::SectionType::VertexData) + mesh.vertexDataOffset, static_cast<size_t>(mesh.vertexDataSize) };
+}
+
+std::span<const std::byte> CookedScene::GetIndexData(const CookedSceneFormat::PolygonGroup& polygonGroup) const
+{
+	return { GetSectionData(CookedSceneFormat::SectionType::IndexData) + polygonGroup.indexDataOffset, static_cast<size_t>(polygonGroup.indexDataSize) };
+}
+
+cd::VertexFormat CookedScene::GetVertexFormat(const CookedSceneFormat::Mesh& mesh)
+{
+	cd::VertexFormat vertexFormat;
+	for (uint32_t attributeIndex = 0U; attributeIndex < mesh.vertexAttributeCount; ++attributeIndex)
+	{
+		const CookedSceneFormat::VertexAttribute& attribute = mesh.vertexAttributes[attributeIndex];
+		vertexFormat.AddVertexAttributeLayout(static_cast<cd::VertexAttributeType>(attribute.attributeType),
+			static_cast<cd::AttributeValueType>(attribute.valueType), attribute.count);
+	}
+
+	return vertexFormat;
+}
+
+cd::AABB CookedScene::GetAABB(const CookedSceneFormat::Mesh& mesh)
+{
+	return cd::AABB(cd::Point(mesh.aabbMin[0], mesh.aabbMin[1], mesh.aabbMin[2]), cd::Point(mesh.aabbMax[0], mesh.aabbMax[1], mesh.aabbMax[2]));
+}
+
+}
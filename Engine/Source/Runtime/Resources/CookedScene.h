@@ -0,0 +1,185 @@
+#pragma once
+
+#include "Math/Box.hpp"
+#include "Resources/MappedFile.h"
+#include "Scene/MaterialTextureType.h"
+#include "Scene/VertexFormat.h"
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace engine
+{
+
+// Cooked scene package is a flat binary file which can be memory mapped and used in place.
+// All references are offsets relative to the beginning of their section so that no pointer needs relocation.
+// Sections and vertex/index streams are aligned so that they can be passed to GPU API directly.
+namespace CookedSceneFormat
+{
+
+constexpr uint32_t Magic = 0x53434443; // "CDCS"
+constexpr uint32_t Version = 3U;
+constexpr uint64_t Alignment = 16U;
+constexpr uint32_t MaxVertexAttributeCount = 8U;
+constexpr uint32_t MaxTextureCount = 16U;
+constexpr uint32_t MaxLodCount = 4U;
+constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+enum class SectionType : uint32_t
+{
+	Strings,
+	Meshes,
+	PolygonGroups,
+	Materials,
+	VertexData,
+	IndexData,
+	Count,
+};
+
+struct Section
+{
+	uint64_t offset;
+	uint64_t size;
+	uint32_t count;
+	uint32_t reserved;
+};
+
+struct Header
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t fileSize;
+	Section sections[static_cast<size_t>(SectionType::Count)];
+};
+
+struct VertexAttribute
+{
+	uint8_t attributeType;
+	uint8_t valueType;
+	uint8_t count;
+	uint8_t reserved;
+};
+
+struct Mesh
+{
+	uint32_t nameOffset;
+	uint32_t materialIndex;
+	uint32_t vertexCount;
+	uint32_t polygonCount;
+	uint32_t firstPolygonGroup;
+	uint32_t polygonGroupCount;
+	uint32_t vertexStride;
+	uint32_t vertexAttributeCount;
+	VertexAttribute vertexAttributes[MaxVertexAttributeCount];
+	uint64_t vertexDataOffset;
+	uint64_t vertexDataSize;
+	float aabbMin[3];
+	float aabbMax[3];
+	uint32_t flags;
+	uint32_t reserved;
+};
+
+struct Lod
+{
+	uint32_t startIndex;
+	uint32_t indexCount;
+};
+
+struct PolygonGroup
+{
+	uint64_t indexDataOffset;
+	uint64_t indexDataSize;
+	uint32_t indexCount;
+	uint32_t indexSize;
+	// Detail levels inside the index data from fine to coarse.
+	uint32_t lodCount;
+	uint32_t reserved;
+	Lod lods[MaxLodCount];
+};
+
+struct Texture
+{
+	// Path of built texture file. InvalidIndex if material doesn't use this texture type.
+	uint32_t pathOffset;
+	float uvOffset[2];
+	float uvScale[2];
+	uint8_t uMapMode;
+	uint8_t vMapMode;
+	uint8_t reserved[2];
+};
+
+struct Material
+{
+	uint32_t nameOffset;
+	uint32_t flags;
+	int32_t blendMode;
+	float alphaCutOff;
+	float occlusionFactor;
+	float roughnessFactor;
+	float metallicFactor;
+	uint32_t reserved;
+	Texture textures[MaxTextureCount];
+};
+
+enum MeshFlags : uint32_t
+{
+	// Vertex data uses VertexLayoutVariant::Quantized.
+	QuantizedAttributes = 1 << 0,
+};
+
+enum MaterialFlags : uint32_t
+{
+	HasOcclusionFactor = 1 << 0,
+	HasRoughnessFactor = 1 << 1,
+	HasMetallicFactor = 1 << 2,
+	HasBlendMode = 1 << 3,
+	TwoSided = 1 << 4,
+	HasTwoSided = 1 << 5,
+};
+
+static_assert(sizeof(Header) % Alignment == 0U);
+static_assert(sizeof(Mesh) % 8U == 0U);
+static_assert(sizeof(PolygonGroup) % 8U == 0U);
+
+}
+
+// CookedScene is the runtime view of a cooked scene package which keeps the file mapped during its lifetime.
+// Vertex and index streams are referenced directly by MeshResource so it must outlive these resources.
+class CookedScene final
+{
+public:
+	CookedScene() = default;
+	CookedScene(const CookedScene&) = delete;
+	CookedScene& operator=(const CookedScene&) = delete;
+	CookedScene(CookedScene&&) = delete;
+	CookedScene& operator=(CookedScene&&) = delete;
+	~CookedScene() = default;
+
+	// Maps the file and validates header and section ranges. Nothing is deserialized.
+	bool Open(const char* pFilePath);
+	bool IsOpen() const { return m_pHeader != nullptr; }
+
+	uint32_t GetMeshCount() const { return GetSectionCount(CookedSceneFormat::SectionType::Meshes); }
+	const CookedSceneFormat::Mesh& GetMesh(uint32_t index) const;
+	const CookedSceneFormat::PolygonGroup& GetPolygonGroup(const CookedSceneFormat::Mesh& mesh, uint32_t index) const;
+	uint32_t GetMaterialCount() const { return GetSectionCount(CookedSceneFormat::SectionType::Materials); }
+	const CookedSceneFormat::Material& GetMaterial(uint32_t index) const;
+
+	std::string_view GetString(uint32_t offset) const;
+	std::span<const std::byte> GetVertexData(const CookedSceneFormat::Mesh& mesh) const;
+	std::span<const std::byte> GetIndexData(const CookedSceneFormat::PolygonGroup& polygonGroup) const;
+
+	static cd::VertexFormat GetVertexFormat(const CookedSceneFormat::Mesh& mesh);
+	static cd::AABB GetAABB(const CookedSceneFormat::Mesh& mesh);
+
+private:
+	uint32_t GetSectionCount(CookedSceneFormat::SectionType sectionType) const;
+	const std::byte* GetSectionData(CookedSceneFormat::SectionType sectionType) const;
+
+private:
+	MappedFile m_file;
+	const CookedSceneFormat::Header* m_pHeader = nullptr;
+};
+
+}
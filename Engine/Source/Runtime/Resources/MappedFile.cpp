@@ -0,0 +1,111 @@
+#include "MappedFile.h"
+
+#if CD_PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine
+{
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const char* pFilePath)
+{
+	Close();
+
+#if CD_PLATFORM_WINDOWS
+	HANDLE fileHandle = ::CreateFileA(pFilePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (INVALID_HANDLE_VALUE == fileHandle)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!::GetFileSizeEx(fileHandle, &fileSize) || 0 == fileSize.QuadPart)
+	{
+		::CloseHandle(fileHandle);
+		return false;
+	}
+
+	HANDLE mappingHandle = ::CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (nullptr == mappingHandle)
+	{
+		::CloseHandle(fileHandle);
+		return false;
+	}
+
+	void* pData = ::MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (nullptr == pData)
+	{
+		::CloseHandle(mappingHandle);
+		::CloseHandle(fileHandle);
+		return false;
+	}
+
+	m_fileHandle = fileHandle;
+	m_mappingHandle = mappingHandle;
+	m_pData = static_cast<const std::byte*>(pData);
+	m_size = static_cast<uint64_t>(fileSize.QuadPart);
+#else
+	int fileDescriptor = ::open(pFilePath, O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat;
+	if (::fstat(fileDescriptor, &fileStat) != 0 || 0 == fileStat.st_size)
+	{
+		::close(fileDescriptor);
+		return false;
+	}
+
+	void* pData = ::mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	if (MAP_FAILED == pData)
+	{
+		::close(fileDescriptor);
+		return false;
+	}
+
+	m_fileDescriptor = fileDescriptor;
+	m_pData = static_cast<const std::byte*>(pData);
+	m_size = static_cast<uint64_t>(fileStat.st_size);
+#endif
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (!m_pData)
+	{
+		return;
+	}
+
+#if CD_PLATFORM_WINDOWS
+	::UnmapViewOfFile(m_pData);
+	::CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+	::CloseHandle(static_cast<HANDLE>(m_fileHandle));
+	m_mappingHandle = nullptr;
+	m_fileHandle = nullptr;
+#else
+	::munmap(const_cast<std::byte*>(m_pData), static_cast<size_t>(m_size));
+	::close(m_fileDescriptor);
+	m_fileDescriptor = -1;
+#endif
+
+	m_pData = nullptr;
+	m_size = 0U;
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace engine
+{
+
+// MappedFile maps a whole file into memory as read only so that data can be used in place without copying.
+// Pages are loaded by OS on first access.
+class MappedFile final
+{
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&&) = delete;
+	MappedFile& operator=(MappedFile&&) = delete;
+	~MappedFile();
+
+	bool Open(const char* pFilePath);
+	void Close();
+
+	bool IsOpen() const { return m_pData != nullptr; }
+	const std::byte* GetData() const { return m_pData; }
+	uint64_t GetSize() const { return m_size; }
+	std::span<const std::byte> GetSpan() const { return { m_pData, static_cast<size_t>(m_size) }; }
+
+private:
+	const std::byte* m_pData = nullptr;
+	uint64_t m_size = 0U;
+
+#if CD_PLATFORM_WINDOWS
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+#else
+	int m_fileDescriptor = -1;
+#endif
+};
+
+}
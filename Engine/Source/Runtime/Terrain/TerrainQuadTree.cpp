@@ -0,0 +1,345 @@
+#include "TerrainQuadTree.h"
+
+#include "Display/Frustum.h"
+#include "Physics/RayIntersection.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace engine
+{
+
+namespace
+{
+
+// Slab test. Return the entry distance or a negative value when the box is missed.
+float RayBoxEntry(const cd::Vec3f& origin, const cd::Vec3f& direction, const float* boxMin, const float* boxMax, float maxDistance)
+{
+	float tMin = 0.0f;
+	float tMax = maxDistance;
+	for (uint32_t axis = 0U; axis < 3U; ++axis)
+	{
+		if (std::abs(direction[axis]) < 1e-8f)
+		{
+			if (origin[axis] < boxMin[axis] || origin[axis] > boxMax[axis])
+			{
+				return -1.0f;
+			}
+			continue;
+		}
+
+		float invDirection = 1.0f / direction[axis];
+		float t0 = (boxMin[axis] - origin[axis]) * invDirection;
+		float t1 = (boxMax[axis] - origin[axis]) * invDirection;
+		if (t0 > t1)
+		{
+			std::swap(t0, t1);
+		}
+
+		tMin = std::max(tMin, t0);
+		tMax = std::min(tMax, t1);
+		if (tMin > tMax)
+		{
+			return -1.0f;
+		}
+	}
+
+	return tMin;
+}
+
+}
+
+void TerrainQuadTree::Build(const float* heights, uint16_t sampleCount, uint16_t leafSize)
+{
+	assert(sampleCount > 1U && leafSize > 0U);
+	m_tileSize = sampleCount - 1U;
+	m_leafSize = leafSize;
+	assert(m_tileSize % m_leafSize == 0U);
+
+	m_levels.clear();
+	uint16_t nodeCount = m_tileSize / m_leafSize;
+	while (true)
+	{
+		Level& level = m_levels.emplace_back();
+		level.nodeCount = nodeCount;
+		level.minHeights.resize(nodeCount * nodeCount);
+		level.maxHeights.resize(nodeCount * nodeCount);
+		if (nodeCount <= 1U)
+		{
+			break;
+		}
+
+		assert(nodeCount % 2U == 0U);
+		nodeCount /= 2U;
+	}
+
+	Refresh(heights, 0U, 0U, m_tileSize, m_tileSize);
+}
+
+void TerrainQuadTree::Refresh(const float* heights, uint16_t x0, uint16_t z0, uint16_t x1, uint16_t z1)
+{
+	if (m_levels.empty())
+	{
+		return;
+	}
+
+	// A leaf node owns samples [start, start + leafSize] so that neighbor nodes share border samples.
+	auto ToNodeRange = [](uint16_t begin, uint16_t end, uint16_t nodeSize, uint16_t nodeCount, uint16_t& outBegin, uint16_t& outEnd)
+	{
+		outBegin = begin > 0U ? static_cast<uint16_t>((begin - 1U) / nodeSize) : 0U;
+		outEnd = std::min(static_cast<uint16_t>(end / nodeSize), static_cast<uint16_t>(nodeCount - 1U));
+	};
+
+	uint16_t beginX, endX, beginZ, endZ;
+	ToNodeRange(x0, x1, m_leafSize, m_levels[0].nodeCount, beginX, endX);
+	ToNodeRange(z0, z1, m_leafSize, m_levels[0].nodeCount, beginZ, endZ);
+	for (uint16_t nodeZ = beginZ; nodeZ <= endZ; ++nodeZ)
+	{
+		for (uint16_t nodeX = beginX; nodeX <= endX; ++nodeX)
+		{
+			BuildLeafNode(heights, nodeX, nodeZ);
+		}
+	}
+
+	for (uint16_t lodLevel = 1U; lodLevel < GetLevelCount(); ++lodLevel)
+	{
+		beginX /= 2U;
+		endX /= 2U;
+		beginZ /= 2U;
+		endZ /= 2U;
+		for (uint16_t nodeZ = beginZ; nodeZ <= endZ; ++nodeZ)
+		{
+			for (uint16_t nodeX = beginX; nodeX <= endX; ++nodeX)
+			{
+				BuildParentNode(lodLevel, nodeX, nodeZ);
+			}
+		}
+	}
+}
+
+void TerrainQuadTree::BuildLeafNode(const float* heights, uint16_t nodeX, uint16_t nodeZ)
+{
+	const uint32_t sampleCount = m_tileSize + 1U;
+	const uint32_t startX = nodeX * m_leafSize;
+	const uint32_t startZ = nodeZ * m_leafSize;
+
+	float minHeight = std::numeric_limits<float>::max();
+	float maxHeight = std::numeric_limits<float>::lowest();
+	for (uint32_t z = startZ; z <= startZ + m_leafSize; ++z)
+	{
+		const float* pRow = heights + z * sampleCount;
+		for (uint32_t x = startX; x <= startX + m_leafSize; ++x)
+		{
+			minHeight = std::min(minHeight, pRow[x]);
+			maxHeight = std::max(maxHeight, pRow[x]);
+		}
+	}
+
+	Level& level = m_levels[0];
+	level.minHeights[nodeZ * level.nodeCount + nodeX] = minHeight;
+	level.maxHeights[nodeZ * level.nodeCount + nodeX] = maxHeight;
+}
+
+void TerrainQuadTree::BuildParentNode(uint16_t lodLevel, uint16_t nodeX, uint16_t nodeZ)
+{
+	const Level& childLevel = m_levels[lodLevel - 1U];
+	float minHeight = std::numeric_limits<float>::max();
+	float maxHeight = std::numeric_limits<float>::lowest();
+	for (uint16_t childZ = nodeZ * 2U; childZ < nodeZ * 2U + 2U; ++childZ)
+	{
+		for (uint16_t childX = nodeX * 2U; childX < nodeX * 2U + 2U; ++childX)
+		{
+			minHeight = std::min(minHeight, childLevel.minHeights[childZ * childLevel.nodeCount + childX]);
+			maxHeight = std::max(maxHeight, childLevel.maxHeights[childZ * childLevel.nodeCount + childX]);
+		}
+	}
+
+	Level& level = m_levels[lodLevel];
+	level.minHeights[nodeZ * level.nodeCount + nodeX] = minHeight;
+	level.maxHeights[nodeZ * level.nodeCount + nodeX] = maxHeight;
+}
+
+float TerrainQuadTree::GetMinHeight() const
+{
+	return m_levels.empty() ? 0.0f : m_levels.back().minHeights[0];
+}
+
+float TerrainQuadTree::GetMaxHeight() const
+{
+	return m_levels.empty() ? 0.0f : m_levels.back().maxHeights[0];
+}
+
+void TerrainQuadTree::GetNodeMinMax(uint16_t lodLevel, uint16_t nodeX, uint16_t nodeZ, float& outMin, float& outMax) const
+{
+	const Level& level = m_levels[lodLevel];
+	outMin = level.minHeights[nodeZ * level.nodeCount + nodeX];
+	outMax = level.maxHeights[nodeZ * level.nodeCount + nodeX];
+}
+
+void TerrainQuadTree::Select(const cd::Vec3f& localCameraPos, const Frustum* pFrustum, const std::vector<float>& lodRanges,
+	float tileOriginX, float tileOriginZ, std::vector<SelectedNode>& outNodes) const
+{
+	if (m_levels.empty())
+	{
+		return;
+	}
+
+	assert(lodRanges.size() >= m_levels.size());
+	SelectNode(GetLevelCount() - 1U, 0U, 0U, localCameraPos, pFrustum, lodRanges, tileOriginX, tileOriginZ, outNodes);
+}
+
+bool TerrainQuadTree::IsNodeInRange(uint16_t lodLevel, uint16_t nodeX, uint16_t nodeZ, const cd::Vec3f& localCameraPos, float range,
+	float tileOriginX, float tileOriginZ) const
+{
+	float minHeight, maxHeight;
+	GetNodeMinMax(lodLevel, nodeX, nodeZ, minHeight, maxHeight);
+
+	const float nodeSize = static_cast<float>(m_leafSize << lodLevel);
+	const float minX = tileOriginX + nodeX * nodeSize;
+	const float minZ = tileOriginZ + nodeZ * nodeSize;
+
+	// Squared distance from camera to the node box.
+	auto AxisDistance = [](float value, float min, float max)
+	{
+		return value < min ? min - value : (value > max ? value - max : 0.0f);
+	};
+	const float dx = AxisDistance(localCameraPos.x(), minX, minX + nodeSize);
+	const float dy = AxisDistance(localCameraPos.y(), minHeight, maxHeight);
+	const float dz = AxisDistance(localCameraPos.z(), minZ, minZ + nodeSize);
+	return dx * dx + dy * dy + dz * dz <= range * range;
+}
+
+bool TerrainQuadTree::SelectNode(uint16_t lodLevel, uint16_t nodeX, uint16_t nodeZ, const cd::Vec3f& localCameraPos, const Frustum* pFrustum,
+	const std::vector<float>& lodRanges, float tileOriginX, float tileOriginZ, std::vector<SelectedNode>& outNodes) const
+{
+	if (!IsNodeInRange(lodLevel, nodeX, nodeZ, localCameraPos, lodRanges[lodLevel], tileOriginX, tileOriginZ))
+	{
+		return false;
+	}
+
+	// Add a node when it is visible. Return true for culled nodes as they are handled.
+	auto AddNode = [&](uint16_t level, uint16_t x, uint16_t z)
+	{
+		float minHeight, maxHeight;
+		GetNodeMinMax(level, x, z, minHeight, maxHeight);
+
+		const uint16_t nodeSize = m_leafSize << level;
+		if (pFrustum)
+		{
+			const float minX = tileOriginX + x * nodeSize;
+			const float minZ = tileOriginZ + z * nodeSize;
+			cd::AABB nodeAABB(cd::Point(minX, minHeight, minZ), cd::Point(minX + nodeSize, maxHeight, minZ + nodeSize));
+			if (!pFrustum->Intersects(nodeAABB))
+			{
+				return;
+			}
+		}
+
+		outNodes.push_back(SelectedNode{ static_cast<uint16_t>(x * nodeSize), static_cast<uint16_t>(z * nodeSize), nodeSize, level, minHeight, maxHeight });
+	};
+
+	if (0U == lodLevel || !IsNodeInRange(lodLevel, nodeX, nodeZ, localCameraPos, lodRanges[lodLevel - 1U], tileOriginX, tileOriginZ))
+	{
+		AddNode(lodLevel, nodeX, nodeZ);
+		return true;
+	}
+
+	for (uint16_t childZ = nodeZ * 2U; childZ < nodeZ * 2U + 2U; ++childZ)
+	{
+		for (uint16_t childX = nodeX * 2U; childX < nodeX * 2U + 2U; ++childX)
+		{
+			if (!SelectNode(lodLevel - 1U, childX, childZ, localCameraPos, pFrustum, lodRanges, tileOriginX, tileOriginZ, outNodes))
+			{
+				// Child is out of its own range so it is drawn fully morphed to this coarser level.
+				AddNode(lodLevel - 1U, childX, childZ);
+			}
+		}
+	}
+
+	return true;
+}
+
+bool TerrainQuadTree::Raycast(const float* heights, const cd::Vec3f& origin, const cd::Vec3f& direction, float maxDistance, float& outDistance) const
+{
+	if (m_levels.empty())
+	{
+		return false;
+	}
+
+	float distance = maxDistance;
+	RaycastNode(heights, GetLevelCount() - 1U, 0U, 0U, origin, direction, distance);
+	if (distance >= maxDistance)
+	{
+		return false;
+	}
+
+	outDistance = distance;
+	return true;
+}
+
+void TerrainQuadTree::RaycastNode(const float* heights, uint16_t lodLevel, uint16_t nodeX, uint16_t nodeZ, const cd::Vec3f& origin, const cd::Vec3f& direction, float& inOutDistance) const
+{
+	const uint16_t nodeSize = m_leafSize << lodLevel;
+	if (0U == lodLevel)
+	{
+		const uint32_t sampleCount = m_tileSize + 1U;
+		for (uint32_t z = nodeZ * nodeSize; z < (nodeZ + 1U) * nodeSize; ++z)
+		{
+			for (uint32_t x = nodeX * nodeSize; x < (nodeX + 1U) * nodeSize; ++x)
+			{
+				cd::Vec3f topLeft(static_cast<float>(x), heights[z * sampleCount + x], static_cast<float>(z));
+				cd::Vec3f topRight(static_cast<float>(x + 1U), heights[z * sampleCount + x + 1U], static_cast<float>(z));
+				cd::Vec3f bottomLeft(static_cast<float>(x), heights[(z + 1U) * sampleCount + x], static_cast<float>(z + 1U));
+				cd::Vec3f bottomRight(static_cast<float>(x + 1U), heights[(z + 1U) * sampleCount + x + 1U], static_cast<float>(z + 1U));
+
+				float distance;
+				if (RayTriangle(origin, direction, topLeft, bottomLeft, bottomRight, distance) && distance < inOutDistance)
+				{
+					inOutDistance = distance;
+				}
+				if (RayTriangle(origin, direction, topLeft, bottomRight, topRight, distance) && distance < inOutDistance)
+				{
+					inOutDistance = distance;
+				}
+			}
+		}
+		return;
+	}
+
+	// Visit children from near to far so that far children are usually rejected by the current closest distance.
+	std::array<std::pair<float, uint32_t>, 4> children;
+	uint32_t childCount = 0U;
+	const uint16_t childSize = nodeSize / 2U;
+	for (uint16_t childZ = nodeZ * 2U; childZ < nodeZ * 2U + 2U; ++childZ)
+	{
+		for (uint16_t childX = nodeX * 2U; childX < nodeX * 2U + 2U; ++childX)
+		{
+			float minHeight, maxHeight;
+			GetNodeMinMax(lodLevel - 1U, childX, childZ, minHeight, maxHeight);
+			float boxMin[3] = { static_cast<float>(childX * childSize), minHeight, static_cast<float>(childZ * childSize) };
+			float boxMax[3] = { static_cast<float>((childX + 1U) * childSize), maxHeight, static_cast<float>((childZ + 1U) * childSize) };
+			float entry = RayBoxEntry(origin, direction, boxMin, boxMax, inOutDistance);
+			if (entry >= 0.0f)
+			{
+				children[childCount++] = std::make_pair(entry, (static_cast<uint32_t>(childX) << 16) | childZ);
+			}
+		}
+	}
+
+	std::sort(children.begin(), children.begin() + childCount);
+	for (uint32_t childIndex = 0U; childIndex < childCount; ++childIndex)
+	{
+		if (children[childIndex].first >= inOutDistance)
+		{
+			break;
+		}
+
+		uint32_t childKey = children[childIndex].second;
+		RaycastNode(heights, lodLevel - 1U, static_cast<uint16_t>(childKey >> 16), static_cast<uint16_t>(childKey & 0xFFFF), origin, direction, inOutDistance);
+	}
+}
+
+}
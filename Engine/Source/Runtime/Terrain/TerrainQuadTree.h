@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Math/Vector.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace engine
+{
+
+class Frustum;
+
+// TerrainQuadTree stores min/max heights of an implicit quad tree over one square heightmap tile.
+// Level 0 is the finest level whose node covers leafSize * leafSize quads.
+// Selection follows CDLOD : nodes are picked by camera distance against per level LOD ranges
+// and the vertex shader morphs each node to the next coarser level inside its morph area.
+class TerrainQuadTree final
+{
+public:
+	struct SelectedNode
+	{
+		uint16_t x;
+		uint16_t z;
+		uint16_t size;
+		uint16_t lodLevel;
+		float minHeight;
+		float maxHeight;
+	};
+
+public:
+	TerrainQuadTree() = default;
+	TerrainQuadTree(const TerrainQuadTree&) = default;
+	TerrainQuadTree& operator=(const TerrainQuadTree&) = default;
+	TerrainQuadTree(TerrainQuadTree&&) = default;
+	TerrainQuadTree& operator=(TerrainQuadTree&&) = default;
+	~TerrainQuadTree() = default;
+
+	// heights contains sampleCount * sampleCount samples which means (tileSize + 1) ^ 2.
+	void Build(const float* heights, uint16_t sampleCount, uint16_t leafSize);
+
+	// Recompute min/max heights of nodes overlapping the sample rect [x0, x1] * [z0, z1].
+	void Refresh(const float* heights, uint16_t x0, uint16_t z0, uint16_t x1, uint16_t z1);
+
+	// localCameraPos and frustum are both in the terrain local space. Tile origin is added to node positions.
+	// lodRanges[i] is the maximum distance to select a node at level i.
+	void Select(const cd::Vec3f& localCameraPos, const Frustum* pFrustum, const std::vector<float>& lodRanges,
+		float tileOriginX, float tileOriginZ, std::vector<SelectedNode>& outNodes) const;
+
+	// Hierarchical ray cast against the heightfield in tile space. Nodes whose min/max box is missed are skipped
+	// so that the cost grows with log(tileSize) instead of the ray length.
+	bool Raycast(const float* heights, const cd::Vec3f& origin, const cd::Vec3f& direction, float maxDistance, float& outDistance) const;
+
+	uint16_t GetLevelCount() const { return static_cast<uint16_t>(m_levels.size()); }
+	uint16_t GetLeafSize() const { return m_leafSize; }
+	uint16_t GetTileSize() const { return m_tileSize; }
+	float GetMinHeight() const;
+	float GetMaxHeight() const;
+	void GetNodeMinMax(uint16_t lodLevel, uint16_t nodeX, uint16_t nodeZ, float& outMin, float& outMax) const;
+
+private:
+	struct Level
+	{
+		uint16_t nodeCount;
+		std::vector<float> minHeights;
+		std::vector<float> maxHeights;
+	};
+
+	void BuildLeafNode(const float* heights, uint16_t nodeX, uint16_t nodeZ);
+	void BuildParentNode(uint16_t lodLevel, uint16_t nodeX, uint16_t nodeZ);
+
+	// Return false when node is out of its lod range so that the parent should cover the area.
+	bool SelectNode(uint16_t lodLevel, uint16_t nodeX, uint16_t nodeZ, const cd::Vec3f& localCameraPos, const Frustum* pFrustum,
+		const std::vector<float>& lodRanges, float tileOriginX, float tileOriginZ, std::vector<SelectedNode>& outNodes) const;
+	void RaycastNode(const float* heights, uint16_t lodLevel, uint16_t nodeX, uint16_t nodeZ, const cd::Vec3f& origin, const cd::Vec3f& direction, float& inOutDistance) const;
+	bool IsNodeInRange(uint16_t lodLevel, uint16_t nodeX, uint16_t nodeZ, const cd::Vec3f& localCameraPos, float range,
+		float tileOriginX, float tileOriginZ) const;
+
+private:
+	uint16_t m_tileSize = 0U;
+	uint16_t m_leafSize = 0U;
+	std::vector<Level> m_levels;
+};
+
+}
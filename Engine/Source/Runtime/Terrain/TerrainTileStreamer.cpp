@@ -0,0 +1,227 @@
+#include "TerrainTileStreamer.h"
+
+#include "Log/Log.h"
+#include "Path/Path.h"
+#include "Resources/ResourceLoader.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace engine
+{
+
+std::string TerrainTileStreamer::GetTileFilePath(const std::string& directory, uint16_t x, uint16_t z)
+{
+	return Path::Join(directory, "tile_" + std::to_string(x) + "_" + std::to_string(z) + ".r32");
+}
+
+bool TerrainTileStreamer::SaveTile(const std::string& directory, uint16_t x, uint16_t z, const float* heights, uint32_t sampleCount)
+{
+	std::filesystem::create_directories(directory);
+
+	std::ofstream fout(GetTileFilePath(directory, x, z), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!fout.is_open())
+	{
+		return false;
+	}
+
+	fout.write(reinterpret_cast<const char*>(heights), sampleCount * sampleCount * sizeof(float));
+	fout.close();
+	return true;
+}
+
+TerrainTileStreamer::TerrainTileStreamer(std::string directory, uint16_t tileSize, uint16_t leafSize, uint32_t maxResidentTileCount)
+	: m_directory(cd::MoveTemp(directory))
+	, m_tileSize(tileSize)
+	, m_leafSize(leafSize)
+	, m_maxResidentTileCount(maxResidentTileCount)
+{
+	m_loadThread = std::thread(&TerrainTileStreamer::LoadThreadMain, this);
+}
+
+TerrainTileStreamer::~TerrainTileStreamer()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_condition.notify_all();
+
+	if (m_loadThread.joinable())
+	{
+		m_loadThread.join();
+	}
+
+	for (auto& [_, pTile] : m_residentTiles)
+	{
+		if (bgfx::isValid(pTile->texture))
+		{
+			bgfx::destroy(pTile->texture);
+		}
+	}
+}
+
+uint32_t TerrainTileStreamer::GetPendingTileCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return static_cast<uint32_t>(m_pendingRequests.size() + m_loadingKeys.size() + m_loadedTiles.size());
+}
+
+void TerrainTileStreamer::RequestTile(uint16_t x, uint16_t z, float priority)
+{
+	uint32_t key = GetTileKey(x, z);
+	if (m_residentTiles.find(key) != m_residentTiles.end())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (std::find(m_loadingKeys.begin(), m_loadingKeys.end(), key) != m_loadingKeys.end())
+		{
+			return;
+		}
+
+		auto itLoaded = std::find_if(m_loadedTiles.begin(), m_loadedTiles.end(),
+			[key](const std::unique_ptr<TerrainTile>& pTile) { return GetTileKey(pTile->x, pTile->z) == key; });
+		if (itLoaded != m_loadedTiles.end())
+		{
+			return;
+		}
+
+		auto itRequest = std::find_if(m_pendingRequests.begin(), m_pendingRequests.end(),
+			[key](const TileRequest& request) { return request.key == key; });
+		if (itRequest != m_pendingRequests.end())
+		{
+			itRequest->priority = priority;
+			itRequest->frame = m_currentFrame;
+			return;
+		}
+
+		m_pendingRequests.push_back(TileRequest{ key, priority, m_currentFrame });
+	}
+	m_condition.notify_one();
+}
+
+TerrainTile* TerrainTileStreamer::GetResidentTile(uint16_t x, uint16_t z)
+{
+	auto it = m_residentTiles.find(GetTileKey(x, z));
+	if (it == m_residentTiles.end())
+	{
+		return nullptr;
+	}
+
+	it->second->lastUsedFrame = m_currentFrame;
+	return it->second.get();
+}
+
+void TerrainTileStreamer::Update()
+{
+	++m_currentFrame;
+
+	std::vector<std::unique_ptr<TerrainTile>> loadedTiles;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		loadedTiles.swap(m_loadedTiles);
+
+		// Requests which are not refreshed in last frame are not wanted any more.
+		m_pendingRequests.erase(std::remove_if(m_pendingRequests.begin(), m_pendingRequests.end(),
+			[this](const TileRequest& request) { return request.frame + 1U < m_currentFrame; }), m_pendingRequests.end());
+	}
+
+	const uint16_t sampleCount = m_tileSize + 1U;
+	for (std::unique_ptr<TerrainTile>& pTile : loadedTiles)
+	{
+		const uint32_t dataSize = static_cast<uint32_t>(pTile->heights.size() * sizeof(float));
+		pTile->texture = bgfx::createTexture2D(sampleCount, sampleCount, false, 1, bgfx::TextureFormat::R32F,
+			BGFX_SAMPLER_UVW_CLAMP, bgfx::copy(pTile->heights.data(), dataSize));
+		pTile->lastUsedFrame = m_currentFrame;
+		m_residentTiles[GetTileKey(pTile->x, pTile->z)] = cd::MoveTemp(pTile);
+	}
+
+	if (m_residentTiles.size() <= m_maxResidentTileCount)
+	{
+		return;
+	}
+
+	// Evict least recently used tiles. Tiles used in current frame are kept even if budget is exceeded.
+	std::vector<std::pair<uint32_t, uint32_t>> candidates;
+	for (const auto& [key, pTile] : m_residentTiles)
+	{
+		if (pTile->lastUsedFrame + 1U < m_currentFrame)
+		{
+			candidates.emplace_back(pTile->lastUsedFrame, key);
+		}
+	}
+	std::sort(candidates.begin(), candidates.end());
+
+	size_t evictCount = std::min(candidates.size(), m_residentTiles.size() - m_maxResidentTileCount);
+	for (size_t index = 0; index < evictCount; ++index)
+	{
+		auto it = m_residentTiles.find(candidates[index].second);
+		if (bgfx::isValid(it->second->texture))
+		{
+			bgfx::destroy(it->second->texture);
+		}
+		m_residentTiles.erase(it);
+	}
+}
+
+void TerrainTileStreamer::LoadThreadMain()
+{
+	while (true)
+	{
+		uint32_t key;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_stop || !m_pendingRequests.empty(); });
+			if (m_stop)
+			{
+				return;
+			}
+
+			auto itRequest = std::min_element(m_pendingRequests.begin(), m_pendingRequests.end(),
+				[](const TileRequest& lhs, const TileRequest& rhs) { return lhs.priority < rhs.priority; });
+			key = itRequest->key;
+			m_pendingRequests.erase(itRequest);
+			m_loadingKeys.push_back(key);
+		}
+
+		std::unique_ptr<TerrainTile> pTile = LoadTile(key);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_loadingKeys.erase(std::find(m_loadingKeys.begin(), m_loadingKeys.end(), key));
+			m_loadedTiles.push_back(cd::MoveTemp(pTile));
+		}
+	}
+}
+
+std::unique_ptr<TerrainTile> TerrainTileStreamer::LoadTile(uint32_t key) const
+{
+	auto pTile = std::make_unique<TerrainTile>();
+	pTile->x = static_cast<uint16_t>(key >> 16);
+	pTile->z = static_cast<uint16_t>(key & 0xFFFF);
+
+	const uint32_t sampleCount = m_tileSize + 1U;
+	pTile->heights.resize(sampleCount * sampleCount, 0.0f);
+
+	std::string filePath = GetTileFilePath(m_directory, pTile->x, pTile->z);
+	std::vector<std::byte> fileData = ResourceLoader::LoadFile(filePath.c_str());
+	if (fileData.size() == pTile->heights.size() * sizeof(float))
+	{
+		std::memcpy(pTile->heights.data(), fileData.data(), fileData.size());
+	}
+	else
+	{
+		CD_ENGINE_WARN("Terrain tile {0} is missing or has unexpected size. Use a flat tile instead.", filePath);
+	}
+
+	pTile->quadTree.Build(pTile->heights.data(), static_cast<uint16_t>(sampleCount), m_leafSize);
+	return pTile;
+}
+
+}
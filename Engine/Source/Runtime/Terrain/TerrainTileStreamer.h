@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Terrain/TerrainQuadTree.h"
+
+#include <bgfx/bgfx.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace engine
+{
+
+struct TerrainTile
+{
+	uint16_t x;
+	uint16_t z;
+	std::vector<float> heights;
+	TerrainQuadTree quadTree;
+	bgfx::TextureHandle texture = BGFX_INVALID_HANDLE;
+	uint32_t lastUsedFrame = 0U;
+};
+
+// TerrainTileStreamer loads heightmap tiles from disk in a background thread and keeps a bounded set of them resident.
+// A tile file stores (tileSize + 1) ^ 2 float32 samples so that neighbor tiles share border samples.
+// Requests are served by priority which is usually the distance to camera. Textures are created and destroyed in Update.
+class TerrainTileStreamer final
+{
+public:
+	static std::string GetTileFilePath(const std::string& directory, uint16_t x, uint16_t z);
+	static bool SaveTile(const std::string& directory, uint16_t x, uint16_t z, const float* heights, uint32_t sampleCount);
+
+public:
+	TerrainTileStreamer() = delete;
+	explicit TerrainTileStreamer(std::string directory, uint16_t tileSize, uint16_t leafSize, uint32_t maxResidentTileCount);
+	TerrainTileStreamer(const TerrainTileStreamer&) = delete;
+	TerrainTileStreamer& operator=(const TerrainTileStreamer&) = delete;
+	TerrainTileStreamer(TerrainTileStreamer&&) = delete;
+	TerrainTileStreamer& operator=(TerrainTileStreamer&&) = delete;
+	~TerrainTileStreamer();
+
+	// Called from the render thread at the beginning of a frame to commit loaded tiles and evict unused tiles.
+	void Update();
+
+	void RequestTile(uint16_t x, uint16_t z, float priority);
+	TerrainTile* GetResidentTile(uint16_t x, uint16_t z);
+
+	const std::string& GetDirectory() const { return m_directory; }
+	uint16_t GetTileSize() const { return m_tileSize; }
+	void SetMaxResidentTileCount(uint32_t count) { m_maxResidentTileCount = count; }
+	uint32_t GetResidentTileCount() const { return static_cast<uint32_t>(m_residentTiles.size()); }
+	uint32_t GetPendingTileCount() const;
+
+private:
+	struct TileRequest
+	{
+		uint32_t key;
+		float priority;
+		uint32_t frame;
+	};
+
+	static uint32_t GetTileKey(uint16_t x, uint16_t z) { return (static_cast<uint32_t>(x) << 16) | z; }
+
+	void LoadThreadMain();
+	std::unique_ptr<TerrainTile> LoadTile(uint32_t key) const;
+
+private:
+	std::string m_directory;
+	uint16_t m_tileSize;
+	uint16_t m_leafSize;
+	uint32_t m_maxResidentTileCount;
+	uint32_t m_currentFrame = 0U;
+
+	// Main thread only.
+	std::unordered_map<uint32_t, std::unique_ptr<TerrainTile>> m_residentTiles;
+
+	// Shared with the load thread.
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::vector<TileRequest> m_pendingRequests;
+	std::vector<uint32_t> m_loadingKeys;
+	std::vector<std::unique_ptr<TerrainTile>> m_loadedTiles;
+	bool m_stop = false;
+
+	std::thread m_loadThread;
+};
+
+}
@@ -1,8 +1,70 @@
 #include "TerrainUtils.h"
 
+#include "Terrain/TerrainTileStreamer.h"
+
 namespace engine
 {
 
+namespace
+{
+
+std::optional<cd::Mesh> BuildTerrainMesh(const std::vector<cd::Point>& positions, std::vector<cd::Polygon> polygons, const cd::VertexFormat& vertexFormat, uint16_t width, uint16_t depth)
+{
+    cd::Mesh mesh;
+    uint32_t vertexCount = static_cast<uint32_t>(positions.size());
+    mesh.Init(vertexCount);
+    for (uint32_t i = 0U; i < vertexCount; ++i)
+    {
+        mesh.SetVertexPosition(i, positions[i]);
+    }
+
+    mesh.SetPolygonGroupCount(1);
+    auto& polygonGroup = mesh.GetPolygonGroup(0);
+    polygonGroup = cd::MoveTemp(polygons);
+
+    cd::VertexFormat meshVertexFormat;
+    meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Position, cd::GetAttributeValueType<cd::Point::ValueType>(), cd::Point::Size);
+
+    if (vertexFormat.Contains(cd::VertexAttributeType::Normal))
+    {
+        mesh.ComputeVertexNormals();
+        meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Normal, cd::GetAttributeValueType<cd::Direction::ValueType>(), cd::Direction::Size);
+    }
+
+    if (vertexFormat.Contains(cd::VertexAttributeType::UV))
+    {
+        mesh.SetVertexUVSetCount(1);
+        for (uint32_t vertexIndex = 0U; vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
+        {
+            const auto& position = mesh.GetVertexPosition(vertexIndex);
+            mesh.SetVertexUV(0U, vertexIndex, cd::UV(position.x() / 4.0f, position.z() / 4.0f));
+        }
+
+        meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::UV, cd::GetAttributeValueType<cd::UV::ValueType>(), cd::UV::Size);
+    }
+
+    if (vertexFormat.Contains(cd::VertexAttributeType::Tangent) || vertexFormat.Contains(cd::VertexAttributeType::Bitangent))
+    {
+        mesh.ComputeVertexTangents();
+        meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Tangent, cd::GetAttributeValueType<cd::Direction::ValueType>(), cd::Direction::Size);
+        meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Bitangent, cd::GetAttributeValueType<cd::Direction::ValueType>(), cd::Direction::Size);
+    }
+
+    // Use VertexColor0 to present braycentric coordinates.
+    if (vertexFormat.Contains(cd::VertexAttributeType::Color))
+    {
+        mesh.SetVertexColorSetCount(1U);
+        meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Color, cd::GetAttributeValueType<cd::Vec4f::ValueType>(), cd::Vec4f::Size);
+    }
+
+    mesh.SetVertexFormat(MoveTemp(meshVertexFormat));
+    mesh.SetAABB(cd::AABB(cd::Point(0.0f), cd::Point(width, 0, depth)));
+
+    return mesh;
+}
+
+}
+
 std::optional<cd::Mesh> GenerateTerrainMesh(uint16_t width, uint16_t depth, const cd::VertexFormat& vertexFormat) 
 {
     assert(vertexFormat.Contains(cd::VertexAttributeType::Position));
@@ -58,58 +120,39 @@ std::optional<cd::Mesh> GenerateTerrainMesh(uint16_t width, uint16_t depth, cons
         }
     }
 
-    cd::Mesh mesh;
-    uint32_t vertexCount = static_cast<uint32_t>(positions.size());
-    mesh.Init(vertexCount);
-    for (uint32_t i = 0U; i < vertexCount; ++i)
-    {
-        mesh.SetVertexPosition(i, positions[i]);
-    }
-
-    uint32_t polygonCount = static_cast<uint32_t>(polygons.size());
-    mesh.SetPolygonGroupCount(1);
-    auto& polygonGroup = mesh.GetPolygonGroup(0);
-    polygonGroup = cd::MoveTemp(polygons);
-
-    cd::VertexFormat meshVertexFormat;
-    meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Position, cd::GetAttributeValueType<cd::Point::ValueType>(), cd::Point::Size);
+    return BuildTerrainMesh(positions, cd::MoveTemp(polygons), vertexFormat, width, depth);
+}
 
-    if (vertexFormat.Contains(cd::VertexAttributeType::Normal))
-    {
-        mesh.ComputeVertexNormals();
-        meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Normal, cd::GetAttributeValueType<cd::Direction::ValueType>(), cd::Direction::Size);
-    }
+std::optional<cd::Mesh> GenerateTerrainChunkMesh(uint16_t gridSize, const cd::VertexFormat& vertexFormat)
+{
+    assert(vertexFormat.Contains(cd::VertexAttributeType::Position));
+    assert(gridSize % 2U == 0U);
 
-    if (vertexFormat.Contains(cd::VertexAttributeType::UV))
-    {
-        mesh.SetVertexUVSetCount(1);
-        for (uint32_t vertexIndex = 0U; vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
-        {
-            const auto& position = mesh.GetVertexPosition(vertexIndex);
-            mesh.SetVertexUV(0U, vertexIndex, cd::UV(position.x() / 4.0f, position.z() / 4.0f));
+    // Regular grid with a consistent diagonal so that odd vertices can be morphed onto the coarser grid in CDLOD.
+    const uint16_t sampleCount = gridSize + 1U;
+    std::vector<cd::Point> positions;
+    positions.reserve(sampleCount * sampleCount);
+    for (uint16_t z = 0U; z < sampleCount; z++) {
+        for (uint16_t x = 0U; x < sampleCount; x++) {
+            positions.push_back(cd::Point(x, 0, z));
         }
-
-        meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::UV, cd::GetAttributeValueType<cd::UV::ValueType>(), cd::UV::Size);
-    }
-
-    if (vertexFormat.Contains(cd::VertexAttributeType::Tangent) || vertexFormat.Contains(cd::VertexAttributeType::Bitangent))
-    {
-        mesh.ComputeVertexTangents();
-        meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Tangent, cd::GetAttributeValueType<cd::Direction::ValueType>(), cd::Direction::Size);
-        meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Bitangent, cd::GetAttributeValueType<cd::Direction::ValueType>(), cd::Direction::Size);
     }
 
-    // Use VertexColor0 to present braycentric coordinates.
-    if (vertexFormat.Contains(cd::VertexAttributeType::Color))
-    {
-        mesh.SetVertexColorSetCount(1U);
-        meshVertexFormat.AddVertexAttributeLayout(cd::VertexAttributeType::Color, cd::GetAttributeValueType<cd::Vec4f::ValueType>(), cd::Vec4f::Size);
+    std::vector<cd::Polygon> polygons;
+    polygons.reserve(gridSize * gridSize * 2);
+    for (uint16_t z = 0U; z < gridSize; z++) {
+        for (uint16_t x = 0U; x < gridSize; x++) {
+            uint32_t IndexTopLeft = z * sampleCount + x;
+            uint32_t IndexTopRight = IndexTopLeft + 1;
+            uint32_t IndexBottomLeft = IndexTopLeft + sampleCount;
+            uint32_t IndexBottomRight = IndexBottomLeft + 1;
+
+            polygons.push_back(cd::Polygon{IndexTopLeft, IndexBottomLeft, IndexBottomRight});
+            polygons.push_back(cd::Polygon{IndexTopLeft, IndexBottomRight, IndexTopRight});
+        }
     }
 
-    mesh.SetVertexFormat(MoveTemp(meshVertexFormat));
-    mesh.SetAABB(cd::AABB(cd::Point(0.0f), cd::Point(width, 0, depth)));
-
-    return mesh;
+    return BuildTerrainMesh(positions, cd::MoveTemp(polygons), vertexFormat, gridSize, gridSize);
 }
 
 uint16_t CalcNextPowerOfTwo(uint16_t x)
@@ -234,4 +277,30 @@ std::optional<std::vector<std::byte>> GenerateElevationMap(uint16_t terrainWidth
     return outElevationMap;
 }
 
+bool WriteElevationTiles(const float* heights, uint16_t width, uint16_t depth, uint16_t tileSize, const std::string& directory)
+{
+    assert((width - 1) % tileSize == 0 && (depth - 1) % tileSize == 0);
+
+    const uint16_t sampleCount = tileSize + 1U;
+    std::vector<float> tileHeights(sampleCount * sampleCount);
+    for (uint16_t tileZ = 0U; tileZ < (depth - 1) / tileSize; ++tileZ)
+    {
+        for (uint16_t tileX = 0U; tileX < (width - 1) / tileSize; ++tileX)
+        {
+            for (uint16_t z = 0U; z < sampleCount; ++z)
+            {
+                const float* pSource = heights + (tileZ * tileSize + z) * width + tileX * tileSize;
+                std::copy(pSource, pSource + sampleCount, tileHeights.begin() + z * sampleCount);
+            }
+
+            if (!TerrainTileStreamer::SaveTile(directory, tileX, tileZ, tileHeights.data(), sampleCount))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 }
\ No newline at end of file
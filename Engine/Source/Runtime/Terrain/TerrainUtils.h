@@ -1,8 +1,11 @@
+#pragma once
+
 #include "Scene/VertexFormat.h"
 #include "Scene/Mesh.h"
 
 #include <cassert>
 #include <optional>
+#include <string>
 
 namespace engine
 {
@@ -10,4 +13,10 @@ namespace engine
 std::optional<cd::Mesh> GenerateTerrainMesh(uint16_t width, uint16_t depth, const cd::VertexFormat& vertexFormat);
 std::optional<std::vector<std::byte>> GenerateElevationMap(uint16_t terrainWidth, uint16_t terrainDepth, float roughness, float minHeight, float maxHeight);
 
+// Regular grid mesh used by all chunks of a CDLOD terrain. It has (gridSize + 1) ^ 2 vertices.
+std::optional<cd::Mesh> GenerateTerrainChunkMesh(uint16_t gridSize, const cd::VertexFormat& vertexFormat);
+
+// Split a width * depth heightmap into tiles of (tileSize + 1) ^ 2 samples which can be streamed by TerrainTileStreamer.
+bool WriteElevationTiles(const float* heights, uint16_t width, uint16_t depth, uint16_t tileSize, const std::string& directory);
+
 }
\ No newline at end of file
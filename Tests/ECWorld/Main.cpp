@@ -3,14 +3,24 @@
 #include "ECWorld/LightComponent.h"
 #include "ECWorld/MaterialComponent.h"
 #include "ECWorld/HierarchyComponent.h"
+#include "ECWorld/NameComponent.h"
+#include "ECWorld/SceneWorld.h"
 #include "ECWorld/World.h"
+#include "ECWorld/WorldSnapshot.h"
 #include "ECWorld/StaticMeshComponent.h"
+#include "ECWorld/TerrainComponent.h"
 #include "ECWorld/TransformComponent.h"
+#include "Undo/UndoJournal.h"
 #include "Utilities/PerformanceProfiler.h"
 
 #include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
 #include <random>
 #include <set>
+#include <string>
+#include <vector>
 
 namespace
 {
@@ -184,6 +194,364 @@ void Test_RemoveEntityComponentsByOrder(Factory& factory, const std::vector<Enti
 	printf("\n[Success] Test_RemoveEntityComponentsByOrder\n");
 }
 
+Entity CreateSnapshotEntity(SceneWorld& sceneWorld, const char* pName, const cd::Point& translation, Entity parentEntity)
+{
+	World* pWorld = sceneWorld.GetWorld();
+	Entity entity = pWorld->CreateEntity();
+	pWorld->CreateComponent<NameComponent>(entity).SetName(pName);
+	pWorld->CreateComponent<HierarchyComponent>(entity).SetParentEntity(parentEntity);
+
+	auto& transformComponent = pWorld->CreateComponent<TransformComponent>(entity);
+	transformComponent.SetTransform(cd::Transform::Identity());
+	transformComponent.GetTransform().SetTranslation(translation);
+	transformComponent.Build();
+	return entity;
+}
+
+bool IsTranslation(const TransformComponent* pTransformComponent, const cd::Point& translation)
+{
+	const cd::Vec3f& value = pTransformComponent->GetTransform().GetTranslation();
+	return value.x() == translation.x() && value.y() == translation.y() && value.z() == translation.z();
+}
+
+Entity FindEntityByName(const SceneWorld& sceneWorld, const char* pName)
+{
+	for (Entity entity : sceneWorld.GetNameEntities())
+	{
+		if (0 == std::strcmp(sceneWorld.GetNameComponent(entity)->GetName(), pName))
+		{
+			return entity;
+		}
+	}
+
+	return INVALID_ENTITY;
+}
+
+// Registered by play mode systems after capturing.
+struct PlayModeComponent
+{
+	static constexpr StringCrc GetClassName()
+	{
+		constexpr StringCrc className("PlayModeComponent");
+		return className;
+	}
+};
+
+void Test_WorldSnapshotCaptureRestore()
+{
+	cdtools::PerformanceProfiler perf("Test_WorldSnapshotCaptureRestore");
+
+	SceneWorld sceneWorld;
+	Entity rootEntity = CreateSnapshotEntity(sceneWorld, "Root", cd::Point(0.0f), INVALID_ENTITY);
+	Entity childEntity = CreateSnapshotEntity(sceneWorld, "Child", cd::Point(1.0f, 2.0f, 3.0f), rootEntity);
+	sceneWorld.GetWorld()->CreateComponent<CameraComponent>(rootEntity).SetFov(60.0f);
+	sceneWorld.SetMainCameraEntity(rootEntity);
+	sceneWorld.SetSelectedEntity(childEntity);
+
+	// Renderers created a shadow map before capturing.
+	LightComponent& lightComponent = sceneWorld.GetWorld()->CreateComponent<LightComponent>(childEntity);
+	lightComponent.SetShadowMapTexture(1U);
+
+	WorldSnapshot snapshot;
+	snapshot.Capture(sceneWorld);
+	assert(!snapshot.IsEmpty());
+
+	// bgfx isn't initialized in tests so live handle is dropped by hand instead of by restoring.
+	sceneWorld.GetLightComponent(childEntity)->SetShadowMapTexture(UINT16_MAX);
+
+	// Play mode moves, removes and creates components.
+	sceneWorld.GetTransformComponent(childEntity)->GetTransform().SetTranslation(cd::Point(10.0f));
+	sceneWorld.GetCameraComponent(rootEntity)->SetFov(90.0f);
+	sceneWorld.DeleteNameComponent(childEntity);
+	Entity playEntity = CreateSnapshotEntity(sceneWorld, "Play", cd::Point(5.0f), rootEntity);
+	sceneWorld.SetSelectedEntity(playEntity);
+	sceneWorld.GetWorld()->Register<PlayModeComponent>()->CreateComponent(playEntity);
+
+	snapshot.Restore(sceneWorld);
+
+	assert(sceneWorld.GetNameEntities().size() == 2U);
+	assert(sceneWorld.GetTransformEntities().size() == 2U);
+	assert(!sceneWorld.GetTransformComponent(playEntity));
+	assert(0 == std::strcmp(sceneWorld.GetNameComponent(childEntity)->GetName(), "Child"));
+	assert(IsTranslation(sceneWorld.GetTransformComponent(childEntity), cd::Point(1.0f, 2.0f, 3.0f)));
+	assert(sceneWorld.GetHierarchyComponent(childEntity)->GetParentEntity() == rootEntity);
+	assert(sceneWorld.GetCameraComponent(rootEntity)->GetFov() == 60.0f);
+	assert(sceneWorld.GetMainCameraEntity() == rootEntity);
+	assert(sceneWorld.GetSelectedEntity() == childEntity);
+	assert(!sceneWorld.GetLightComponent(childEntity)->IsShadowMapTextureValid());
+	assert(sceneWorld.GetWorld()->GetComponents<PlayModeComponent>()->GetCount() == 0U);
+
+	printf("\n[Success] Test_WorldSnapshotCaptureRestore\n");
+}
+
+void Test_WorldSnapshotWriteLoad()
+{
+	cdtools::PerformanceProfiler perf("Test_WorldSnapshotWriteLoad");
+
+	constexpr int childCount = 1000;
+	const std::string filePath = (std::filesystem::temp_directory_path() / "Test_WorldSnapshotWriteLoad.cdws").string();
+
+	SceneWorld sourceSceneWorld;
+	Entity rootEntity = CreateSnapshotEntity(sourceSceneWorld, "Root", cd::Point(0.0f), INVALID_ENTITY);
+	sourceSceneWorld.GetWorld()->CreateComponent<CameraComponent>(rootEntity).SetFov(60.0f);
+	sourceSceneWorld.SetMainCameraEntity(rootEntity);
+	for (int i = 0; i < childCount; ++i)
+	{
+		CreateSnapshotEntity(sourceSceneWorld, ("Child" + std::to_string(i)).c_str(), cd::Point(static_cast<float>(i)), rootEntity);
+	}
+	bool isWritten = WorldSnapshotWriter::Write(sourceSceneWorld, filePath.c_str());
+	assert(isWritten);
+
+	// Entities which exist before loading must not collide with loaded ones.
+	SceneWorld targetSceneWorld;
+	Entity existingEntity = CreateSnapshotEntity(targetSceneWorld, "Existing", cd::Point(-1.0f), INVALID_ENTITY);
+
+	WorldSnapshotLoader loader(&targetSceneWorld);
+	bool isOpened = loader.Open(filePath.c_str());
+	assert(isOpened);
+
+	// Small budget makes sections load over multiple updates.
+	uint32_t updateCount = 0U;
+	while (!loader.Update(64U))
+	{
+		++updateCount;
+	}
+	assert(updateCount > 1U);
+	assert(loader.IsFinished() && !loader.IsFailed());
+	assert(loader.GetLoadedSectionCount() == loader.GetSectionCount());
+	std::filesystem::remove(filePath);
+
+	assert(targetSceneWorld.GetNameEntities().size() == childCount + 2U);
+	assert(targetSceneWorld.GetTransformEntities().size() == childCount + 2U);
+	assert(FindEntityByName(targetSceneWorld, "Existing") == existingEntity);
+
+	Entity loadedRootEntity = FindEntityByName(targetSceneWorld, "Root");
+	assert(loadedRootEntity != INVALID_ENTITY && loadedRootEntity != existingEntity);
+	assert(targetSceneWorld.GetMainCameraEntity() == loadedRootEntity);
+	assert(targetSceneWorld.GetCameraComponent(loadedRootEntity)->GetFov() == 60.0f);
+	for (int i = 0; i < childCount; ++i)
+	{
+		Entity loadedChildEntity = FindEntityByName(targetSceneWorld, ("Child" + std::to_string(i)).c_str());
+		assert(loadedChildEntity != INVALID_ENTITY);
+		assert(targetSceneWorld.GetHierarchyComponent(loadedChildEntity)->GetParentEntity() == loadedRootEntity);
+		assert(IsTranslation(targetSceneWorld.GetTransformComponent(loadedChildEntity), cd::Point(static_cast<float>(i))));
+	}
+
+	printf("\n[Success] Test_WorldSnapshotWriteLoad\n");
+}
+
+void CreateUndoTerrain(SceneWorld& sceneWorld, Entity entity)
+{
+	// Height pyramid needs a power of two quads heightmap.
+	constexpr uint16_t terrainSize = 17U;
+	auto& terrainComponent = sceneWorld.GetWorld()->CreateComponent<TerrainComponent>(entity);
+	terrainComponent.SetTexWidth(terrainSize);
+	terrainComponent.SetTexDepth(terrainSize);
+	terrainComponent.SetElevationRawData(std::vector<std::byte>(terrainSize * terrainSize * sizeof(float)));
+}
+
+void WriteTerrainRect(TerrainComponent* pTerrainComponent, const TerrainComponent::DirtyRect& rect, float height)
+{
+	std::vector<float> heights(static_cast<size_t>(rect.width) * rect.depth, height);
+	pTerrainComponent->WriteElevationRect(rect, heights.data());
+}
+
+bool IsInRect(const TerrainComponent::DirtyRect& rect, uint16_t x, uint16_t z)
+{
+	return x >= rect.x && x < rect.x + rect.width && z >= rect.z && z < rect.z + rect.depth;
+}
+
+void RecordFov(editor::UndoJournal& journal, SceneWorld& sceneWorld, Entity entity, float fov)
+{
+	CameraComponent* pCameraComponent = sceneWorld.GetCameraComponent(entity);
+	float oldFov = pCameraComponent->GetFov();
+	pCameraComponent->GetFov() = fov;
+	journal.RecordValue(entity, *pCameraComponent, pCameraComponent->GetFov(), oldFov);
+}
+
+struct UndoState
+{
+	float fov;
+	float translationX;
+	float height;
+};
+
+UndoState GetUndoState(SceneWorld& sceneWorld, Entity entity)
+{
+	return UndoState{ sceneWorld.GetCameraComponent(entity)->GetFov(),
+		sceneWorld.GetTransformComponent(entity)->GetTransform().GetTranslation().x(),
+		sceneWorld.GetTerrainComponent(entity)->GetElevationRawDataAt(0U, 0U) };
+}
+
+bool IsUndoState(const UndoState& lhs, const UndoState& rhs)
+{
+	return lhs.fov == rhs.fov && lhs.translationX == rhs.translationX && lhs.height == rhs.height;
+}
+
+void Test_UndoJournalWrapAround()
+{
+	cdtools::PerformanceProfiler perf("Test_UndoJournalWrapAround");
+
+	SceneWorld sceneWorld;
+	Entity entity = CreateSnapshotEntity(sceneWorld, "Undo", cd::Point(0.0f), INVALID_ENTITY);
+	sceneWorld.GetWorld()->CreateComponent<CameraComponent>(entity).SetFov(0.0f);
+	CreateUndoTerrain(sceneWorld, entity);
+
+	// Float, transform and terrain rect records in different sizes make the ring buffer wrap around at different offsets.
+	constexpr size_t stepCount = 300U;
+	editor::UndoJournal journal(4096U);
+	std::vector<UndoState> states{ GetUndoState(sceneWorld, entity) };
+	for (size_t stepIndex = 0U; stepIndex < stepCount; ++stepIndex)
+	{
+		const float value = static_cast<float>(stepIndex + 1U);
+		if (0U == stepIndex % 3U)
+		{
+			RecordFov(journal, sceneWorld, entity, value);
+		}
+		else if (1U == stepIndex % 3U)
+		{
+			TransformComponent* pTransformComponent = sceneWorld.GetTransformComponent(entity);
+			cd::Transform oldTransform = pTransformComponent->GetTransform();
+			pTransformComponent->GetTransform().SetTranslation(cd::Point(value, 0.0f, 0.0f));
+			journal.RecordValue(entity, *pTransformComponent, pTransformComponent->GetTransform(), oldTransform);
+		}
+		else
+		{
+			TerrainComponent* pTerrainComponent = sceneWorld.GetTerrainComponent(entity);
+			const uint16_t rectSize = static_cast<uint16_t>(1U + stepIndex % 8U);
+			TerrainComponent::DirtyRect rect{ 0U, 0U, rectSize, rectSize };
+			std::vector<float> oldHeights(static_cast<size_t>(rectSize) * rectSize);
+			pTerrainComponent->ReadElevationRect(rect, oldHeights.data());
+			WriteTerrainRect(pTerrainComponent, rect, value);
+
+			std::vector<float> newHeights(oldHeights.size());
+			pTerrainComponent->ReadElevationRect(rect, newHeights.data());
+			journal.RecordTerrainRect(entity, rect, oldHeights.data(), newHeights.data());
+		}
+
+		states.push_back(GetUndoState(sceneWorld, entity));
+		assert(journal.GetUsedSize() <= journal.GetCapacity());
+	}
+
+	size_t undoCount = 0U;
+	while (journal.CanUndo())
+	{
+		journal.Undo(sceneWorld);
+		++undoCount;
+		assert(IsUndoState(GetUndoState(sceneWorld, entity), states[stepCount - undoCount]));
+	}
+
+	// Oldest steps are evicted so history stops before the first edit.
+	assert(undoCount > 0U && undoCount < stepCount);
+
+	for (size_t redoIndex = undoCount; redoIndex > 0U; --redoIndex)
+	{
+		assert(journal.CanRedo());
+		journal.Redo(sceneWorld);
+		assert(IsUndoState(GetUndoState(sceneWorld, entity), states[stepCount - redoIndex + 1U]));
+	}
+	assert(!journal.CanRedo());
+
+	printf("\n[Success] Test_UndoJournalWrapAround\n");
+}
+
+void Test_UndoJournalEvictedStep()
+{
+	cdtools::PerformanceProfiler perf("Test_UndoJournalEvictedStep");
+
+	SceneWorld sceneWorld;
+	Entity entity = CreateSnapshotEntity(sceneWorld, "Undo", cd::Point(0.0f), INVALID_ENTITY);
+	CameraComponent& cameraComponent = sceneWorld.GetWorld()->CreateComponent<CameraComponent>(entity);
+	cameraComponent.SetFov(1.0f);
+
+	size_t recordSize;
+	{
+		editor::UndoJournal journal;
+		RecordFov(journal, sceneWorld, entity, 2.0f);
+		recordSize = journal.GetUsedSize();
+		journal.Undo(sceneWorld);
+	}
+
+	// Two records fit so the third one evicts the first step and wraps around to the beginning.
+	editor::UndoJournal journal(recordSize * 2U + recordSize / 2U);
+	RecordFov(journal, sceneWorld, entity, 2.0f);
+	RecordFov(journal, sceneWorld, entity, 3.0f);
+	RecordFov(journal, sceneWorld, entity, 4.0f);
+	assert(journal.GetUsedSize() == recordSize * 2U);
+
+	journal.Undo(sceneWorld);
+	assert(cameraComponent.GetFov() == 3.0f);
+	journal.Undo(sceneWorld);
+	assert(cameraComponent.GetFov() == 2.0f);
+	assert(!journal.CanUndo());
+	journal.Undo(sceneWorld);
+	assert(cameraComponent.GetFov() == 2.0f);
+
+	journal.Redo(sceneWorld);
+	journal.Redo(sceneWorld);
+	assert(cameraComponent.GetFov() == 4.0f);
+	assert(!journal.CanRedo());
+
+	// New edit after undoing drops the redo record in the wrapped part.
+	journal.Undo(sceneWorld);
+	RecordFov(journal, sceneWorld, entity, 5.0f);
+	assert(!journal.CanRedo());
+	journal.Undo(sceneWorld);
+	assert(cameraComponent.GetFov() == 3.0f);
+	journal.Undo(sceneWorld);
+	assert(cameraComponent.GetFov() == 2.0f);
+	assert(!journal.CanUndo());
+
+	printf("\n[Success] Test_UndoJournalEvictedStep\n");
+}
+
+void Test_TerrainStrokeUnion()
+{
+	cdtools::PerformanceProfiler perf("Test_TerrainStrokeUnion");
+
+	SceneWorld sceneWorld;
+	Entity entity = sceneWorld.GetWorld()->CreateEntity();
+	CreateUndoTerrain(sceneWorld, entity);
+	TerrainComponent* pTerrainComponent = sceneWorld.GetTerrainComponent(entity);
+
+	// Second rect overlaps samples which the first one modified already.
+	const TerrainComponent::DirtyRect firstRect{ 2U, 2U, 3U, 3U };
+	const TerrainComponent::DirtyRect secondRect{ 4U, 3U, 4U, 4U };
+	editor::UndoJournal journal;
+	editor::TerrainStroke stroke;
+	stroke.Extend(entity, *pTerrainComponent, firstRect);
+	WriteTerrainRect(pTerrainComponent, firstRect, 1.0f);
+	stroke.Extend(entity, *pTerrainComponent, secondRect);
+	WriteTerrainRect(pTerrainComponent, secondRect, 2.0f);
+	stroke.Extend(entity, *pTerrainComponent, firstRect);
+	stroke.Commit(journal, sceneWorld);
+	assert(!stroke.IsActive());
+
+	// Record only covers the union rect instead of the whole heightmap.
+	assert(journal.GetUsedSize() < 2U * pTerrainComponent->GetElevationRawDataSize());
+
+	journal.Undo(sceneWorld);
+	for (uint16_t z = 0U; z < pTerrainComponent->GetTexDepth(); ++z)
+	{
+		for (uint16_t x = 0U; x < pTerrainComponent->GetTexWidth(); ++x)
+		{
+			assert(pTerrainComponent->GetElevationRawDataAt(x, z) == 0.0f);
+		}
+	}
+
+	journal.Redo(sceneWorld);
+	for (uint16_t z = 0U; z < pTerrainComponent->GetTexDepth(); ++z)
+	{
+		for (uint16_t x = 0U; x < pTerrainComponent->GetTexWidth(); ++x)
+		{
+			float height = IsInRect(secondRect, x, z) ? 2.0f : (IsInRect(firstRect, x, z) ? 1.0f : 0.0f);
+			assert(pTerrainComponent->GetElevationRawDataAt(x, z) == height);
+		}
+	}
+
+	printf("\n[Success] Test_TerrainStrokeUnion\n");
+}
+
 }
 
 int main()
@@ -196,5 +564,12 @@ int main()
 	Test_RemoveEntityComponentsRandly(factory, meshEntites);
 	Test_RemoveEntityComponentsByOrder(factory, meshEntites);
 
+	Test_WorldSnapshotCaptureRestore();
+	Test_WorldSnapshotWriteLoad();
+
+	Test_UndoJournalWrapAround();
+	Test_UndoJournalEvictedStep();
+	Test_TerrainStrokeUnion();
+
 	return 0;
 }
\ No newline at end of file